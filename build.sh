@@ -36,27 +36,39 @@ fi
 CXX=g++
 CXXFLAGS="-O2 -Wall -pthread"  # -O2 instead of -O3 for faster compilation
 INCLUDES="-I../../include -I. -Isrc"
-LIBS="../../lib/librgbmatrix.a -lrt -lm -lcurl"
+LIBS="../../lib/librgbmatrix.a -lrt -lm -lcurl -ljpeg -lpng"
+
+# ALSA capture for --audio alsa:<device>, when the headers are installed
+if [ -f /usr/include/alsa/asoundlib.h ]; then
+    CXXFLAGS="$CXXFLAGS -DHAVE_ALSA"
+    LIBS="$LIBS -lasound"
+fi
 
 # Source files (clean architecture structure)
-SOURCES="src/application/main.cc src/application/main_app.cpp src/presentation/controllers/db_meter_app.cpp src/presentation/controllers/db_color_calculator.cpp src/presentation/controllers/youtube_app.cpp src/infrastructure/network/youtube_api.cpp src/presentation/controllers/spotify_app.cpp src/infrastructure/network/spotify_api.cpp src/presentation/displays/db_display.cpp src/presentation/displays/youtube_display.cpp src/presentation/displays/spotify_display.cpp src/presentation/displays/text_display.cpp src/infrastructure/display/border_renderer.cpp src/infrastructure/input/input_handler.cpp src/shared/utils/blink_manager.cpp src/infrastructure/config/config.cpp src/infrastructure/config/arg_parser.cpp src/shared/utils/color_utils.cpp src/shared/utils/rotating_text.cpp src/shared/network/network_handler.cpp"
+SOURCES="src/application/main.cc src/application/main_app.cpp src/presentation/controllers/db_meter_app.cpp src/presentation/controllers/db_color_calculator.cpp src/presentation/controllers/youtube_app.cpp src/infrastructure/network/youtube_api.cpp src/presentation/controllers/spotify_app.cpp src/infrastructure/network/spotify_api.cpp src/presentation/displays/db_display.cpp src/presentation/displays/youtube_display.cpp src/presentation/displays/spotify_display.cpp src/presentation/displays/text_display.cpp src/infrastructure/display/border_renderer.cpp src/infrastructure/input/input_handler.cpp src/infrastructure/input/line_assembler.cpp src/infrastructure/input/control_socket.cpp src/infrastructure/input/key_decoder.cpp src/infrastructure/input/terminal_input.cpp src/infrastructure/input/line_editor.cpp src/shared/utils/blink_manager.cpp src/infrastructure/config/config.cpp src/infrastructure/config/arg_parser.cpp src/shared/utils/color_utils.cpp src/shared/utils/rotating_text.cpp src/shared/network/network_handler.cpp src/shared/network/fetch_scheduler.cpp src/shared/network/buffer_pool.cpp src/shared/network/network_stats.cpp src/shared/utils/json_scanner.cpp src/infrastructure/storage/timeseries_store.cpp src/infrastructure/network/websub_receiver.cpp src/shared/utils/sha1.cpp src/shared/utils/file_utils.cpp src/infrastructure/image/image_decoder.cpp src/infrastructure/image/image_resampler.cpp src/infrastructure/image/album_art_cache.cpp src/infrastructure/network/stats_hub_protocol.cpp src/infrastructure/network/stats_hub_server.cpp src/infrastructure/network/stats_hub_api_fetcher.cpp src/infrastructure/network/stats_hub_client.cpp src/infrastructure/network/db_sample_protocol.cpp src/infrastructure/network/db_sample_receiver.cpp src/infrastructure/audio/pcm_source.cpp src/infrastructure/audio/audio_level_source.cpp src/shared/dsp/level_kernels.cpp src/shared/dsp/biquad_cascade.cpp src/shared/dsp/frequency_weighting.cpp src/shared/dsp/level_integrator.cpp src/shared/dsp/level_ballistics.cpp src/shared/dsp/multi_channel_meter.cpp src/shared/dsp/peak_hold.cpp src/shared/dsp/noise_dosimeter.cpp src/infrastructure/storage/exposure_log.cpp src/infrastructure/storage/exposure_logger.cpp src/shared/dsp/fft.cpp src/shared/dsp/spectrum_analyzer.cpp src/infrastructure/display/memory_canvas.cpp src/infrastructure/display/spectrum_renderer.cpp src/presentation/displays/spectrum_display.cpp src/presentation/controllers/spectrum_app.cpp src/shared/dsp/level_history.cpp src/presentation/displays/db_history_graph.cpp src/infrastructure/storage/db_trace.cpp src/shared/dsp/beat_tracker.cpp src/infrastructure/network/mqtt_protocol.cpp src/infrastructure/network/mqtt_client.cpp src/presentation/controllers/text_app.cpp src/infrastructure/storage/file_data_source.cpp src/infrastructure/network/dmx_protocol.cpp src/infrastructure/network/dmx_receiver.cpp src/infrastructure/display/dmx_renderer.cpp src/presentation/displays/dmx_display.cpp src/presentation/controllers/dmx_app.cpp src/infrastructure/display/matrix_factory.cpp src/infrastructure/storage/animation_file.cpp src/presentation/displays/animation_display.cpp src/presentation/controllers/animation_app.cpp src/shared/utils/sync_clock.cpp src/infrastructure/network/sync_protocol.cpp src/infrastructure/network/sync_node.cpp"
 
 # Output executable
 TARGET="led_matrix_apps"
 
+# Display daemon for frames from other processes
+DAEMON_SOURCES="src/application/daemon_main.cc src/application/display_daemon.cpp src/infrastructure/display/matrix_factory.cpp src/infrastructure/display/shared_frame_buffer.cpp"
+DAEMON_TARGET="led_matrix_daemon"
+
 echo -e "${BOLD}${CYAN}🔨 Building LED Matrix Applications...${NC}"
 echo -e "${BLUE}📁 Sources:${NC} $SOURCES"
 echo ""
 
 # Compile the application
 echo -e "${YELLOW}⚙️  Compiling...${NC}"
-$CXX $CXXFLAGS $INCLUDES -o $TARGET $SOURCES $LIBS
+$CXX $CXXFLAGS $INCLUDES -o $TARGET $SOURCES $LIBS && \
+    $CXX $CXXFLAGS $INCLUDES -o $DAEMON_TARGET $DAEMON_SOURCES $LIBS
 
 # Check if compilation was successful
 if [ $? -eq 0 ]; then
     echo ""
     echo -e "${GREEN}${BOLD}✅ Build successful!${NC}"
     echo -e "${GREEN}📦 Executable:${NC} ${BOLD}$TARGET${NC}"
+    echo -e "${GREEN}📦 Display daemon:${NC} ${BOLD}$DAEMON_TARGET${NC}"
     
     if [ "$RUN_AFTER_BUILD" = true ]; then
         echo ""
@@ -0,0 +1,89 @@
+// Display daemon: owns the matrix and shows frames that other processes
+// publish through the shared frame buffer (see SharedFrameBuffer).
+//
+//   sudo ./led_matrix_daemon -b 8 --group video
+//   tools/frame_producer --fps 60
+
+#include "display_daemon.h"
+#include "infrastructure/config/config.h"
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <grp.h>
+
+namespace {
+
+struct Options {
+    int brightness;
+    std::string segment;
+    std::string group;      // Producers' group; empty = the sudo user's
+
+    Options() : brightness(Config::DEFAULT_BRIGHTNESS), segment(SharedFrameBuffer::DEFAULT_NAME) {}
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n\n";
+    std::cout << "  -b, --brightness <1-10>   Panel brightness (default: " << Config::DEFAULT_BRIGHTNESS << ")\n";
+    std::cout << "  --shm <name>              Shared memory segment (default: " << SharedFrameBuffer::DEFAULT_NAME << ")\n";
+    std::cout << "  --group <name>            Group allowed to publish frames (default: the user running sudo)\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if ((strcmp(argv[i], "-b") == 0 || strcmp(argv[i], "--brightness") == 0) && hasValue) {
+            options.brightness = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--shm") == 0 && hasValue) {
+            options.segment = argv[++i];
+        } else if (strcmp(argv[i], "--group") == 0 && hasValue) {
+            options.group = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return options.brightness >= Config::MIN_BRIGHTNESS && options.brightness <= Config::MAX_BRIGHTNESS &&
+           options.segment.size() > 1 && options.segment[0] == '/' && options.segment.find('/', 1) == std::string::npos;
+}
+
+// Group the segment is shared with: --group, else the group of whoever ran
+// sudo, else our own
+bool resolveGroup(const std::string& name, gid_t& group) {
+    if (!name.empty()) {
+        struct group* entry = getgrnam(name.c_str());
+        if (!entry) {
+            return false;
+        }
+        group = entry->gr_gid;
+        return true;
+    }
+    const char* sudoGid = getenv("SUDO_GID");
+    group = sudoGid ? (gid_t)std::strtoul(sudoGid, nullptr, 10) : (gid_t)-1;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    gid_t group;
+    if (!resolveGroup(options.group, group)) {
+        std::cerr << "\033[0;31m❌ Unknown group: " << options.group << "\033[0m" << std::endl;
+        return 1;
+    }
+
+    DisplayDaemon daemon(options.segment, options.brightness, group);
+    if (!daemon.initialize()) {
+        std::cerr << "\033[0;31m❌ Failed to initialize the display daemon\033[0m" << std::endl;
+        return 1;
+    }
+
+    daemon.run();
+    daemon.cleanup();
+
+    return 0;
+}
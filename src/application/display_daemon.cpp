@@ -0,0 +1,145 @@
+#include "display_daemon.h"
+#include "infrastructure/display/matrix_factory.h"
+#include "shared/utils/monotonic_clock.h"
+#include <iostream>
+#include <signal.h>
+
+static volatile sig_atomic_t interrupt_received = 0;
+static volatile sig_atomic_t report_requested = 0;
+
+static void InterruptHandler(int signo) {
+    interrupt_received = 1;
+}
+
+static void ReportHandler(int signo) {
+    report_requested = 1;
+}
+
+DisplayDaemon::DisplayDaemon(const std::string& segmentName, int brightnessLevel, gid_t producerGroup)
+    : matrix_(nullptr), offscreen_(nullptr), frames_(nullptr),
+      segmentName_(segmentName), brightnessLevel_(brightnessLevel), producerGroup_(producerGroup),
+      producer_(0), nextProducerCheckMs_(0),
+      publishedBefore_(0), shown_(0), latencySumUs_(0), latencyWorstUs_(0) {
+}
+
+DisplayDaemon::~DisplayDaemon() {
+    cleanup();
+}
+
+bool DisplayDaemon::initialize() {
+    signal(SIGTERM, InterruptHandler);
+    signal(SIGINT, InterruptHandler);
+    signal(SIGUSR1, ReportHandler);
+
+    // The segment comes first: creating the matrix may drop root
+    RGBMatrix::Options options;
+    RuntimeOptions runtimeOpt;
+    MatrixFactory::setupOptions(options, runtimeOpt, brightnessLevel_);
+    frames_ = new SharedFrameBuffer(segmentName_);
+    if (!frames_->create(options.cols * options.chain_length, options.rows * options.parallel, producerGroup_)) {
+        std::cerr << "\033[0;31m❌ Could not create the frame buffer: " << frames_->getLastError() << "\033[0m" << std::endl;
+        return false;
+    }
+    publishedBefore_ = frames_->getPublishedCount();
+
+    matrix_ = MatrixFactory::create(brightnessLevel_);
+    if (!matrix_) {
+        std::cerr << "\033[0;31m❌ Could not initialize matrix\033[0m" << std::endl;
+        return false;
+    }
+    offscreen_ = matrix_->CreateFrameCanvas();
+
+    std::cout << "\033[1;36m🖼️  Display daemon on /dev/shm" << segmentName_ << " ("
+              << frames_->getWidth() << "x" << frames_->getHeight() << " RGB, 3 slots)\033[0m" << std::endl;
+    std::cout << "\033[0;33m💡 Brightness:\033[0m " << brightnessLevel_ << "/10 (" << (brightnessLevel_ * 10) << "%)" << std::endl;
+    std::cout << "\033[0;32m💡 Send SIGUSR1 for frame statistics, Ctrl+C to stop\033[0m" << std::endl;
+    return true;
+}
+
+void DisplayDaemon::run() {
+    if (!frames_ || !matrix_) {
+        std::cerr << "\033[0;31m❌ Daemon not initialized\033[0m" << std::endl;
+        return;
+    }
+
+    while (!interrupt_received) {
+        // Read the doorbell first so a publish after acquire() still wakes us
+        uint32_t doorbell = frames_->getDoorbell();
+        const uint8_t* pixels = frames_->acquire();
+        if (pixels) {
+            showFrame(pixels);
+        } else {
+            frames_->waitForFrame(doorbell, WAIT_MS);
+        }
+
+        checkProducer(MonotonicClock::nowMs());
+        if (report_requested) {
+            report_requested = 0;
+            printReport();
+        }
+    }
+
+    printReport();
+}
+
+void DisplayDaemon::cleanup() {
+    if (matrix_) {
+        matrix_->Clear();
+        delete matrix_;
+        matrix_ = nullptr;
+        offscreen_ = nullptr;
+    }
+
+    // The segment stays in /dev/shm so the producer survives a daemon restart
+    if (frames_) {
+        delete frames_;
+        frames_ = nullptr;
+    }
+}
+
+void DisplayDaemon::showFrame(const uint8_t* pixels) {
+    int width = frames_->getWidth();
+    int height = frames_->getHeight();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++, pixels += 3) {
+            offscreen_->SetPixel(x, y, pixels[0], pixels[1], pixels[2]);
+        }
+    }
+    offscreen_ = matrix_->SwapOnVSync(offscreen_);
+
+    long long latencyUs = MonotonicClock::nowUs() - frames_->getFrameTimeUs();
+    shown_++;
+    latencySumUs_ += latencyUs;
+    if (latencyUs > latencyWorstUs_) {
+        latencyWorstUs_ = latencyUs;
+    }
+}
+
+void DisplayDaemon::checkProducer(long long nowMs) {
+    if (nowMs < nextProducerCheckMs_) {
+        return;
+    }
+    nextProducerCheckMs_ = nowMs + PRODUCER_CHECK_MS;
+
+    pid_t producer = frames_->getProducerPid();
+    if (producer == producer_) {
+        return;
+    }
+    if (producer) {
+        std::cout << "\033[0;32m🔌 Producer " << producer << " attached\033[0m" << std::endl;
+    } else {
+        std::cout << "\033[0;33m🔌 Producer " << producer_ << " went away, keeping the last frame\033[0m" << std::endl;
+    }
+    producer_ = producer;
+}
+
+void DisplayDaemon::printReport() {
+    frames_->printReport(std::cout);
+    unsigned long published = frames_->getPublishedCount() - publishedBefore_;
+    unsigned long acquired = frames_->getAcquiredCount();
+    std::cout << "  skipped:  " << (published > acquired ? published - acquired : 0) << " (newer frame arrived before vsync)" << std::endl;
+    if (shown_ > 0) {
+        std::cout << "  latency:  " << (latencySumUs_ / (long long)shown_) << " µs average, "
+                  << latencyWorstUs_ << " µs worst (publish to swap)" << std::endl;
+    }
+}
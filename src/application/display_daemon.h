@@ -0,0 +1,63 @@
+#ifndef DISPLAY_DAEMON_H
+#define DISPLAY_DAEMON_H
+
+#include "led-matrix.h"
+#include "infrastructure/display/shared_frame_buffer.h"
+#include <string>
+#include <sys/types.h>
+
+using namespace rgb_matrix;
+
+// Long-lived owner of the panel for frames rendered by other processes.
+//
+// Creates the shared frame buffer before the matrix (which may drop root
+// afterwards), then sleeps on its doorbell. Each frame published by the
+// producer is drawn onto the offscreen canvas and swapped in on vsync;
+// frames published while a swap is pending are skipped in favour of the
+// newest one. When the producer exits or crashes the last frame stays up
+// until the next producer attaches, and the matrix is never re-initialized.
+class DisplayDaemon {
+public:
+    DisplayDaemon(const std::string& segmentName, int brightnessLevel, gid_t producerGroup = (gid_t)-1);
+    ~DisplayDaemon();
+
+    // Daemon lifecycle
+    bool initialize();
+    void run();
+    void cleanup();
+
+    static const int WAIT_MS = 200;            // Longest sleep between checks for a signal
+    static const int PRODUCER_CHECK_MS = 1000;
+
+private:
+    // Components
+    RGBMatrix* matrix_;
+    FrameCanvas* offscreen_;
+    SharedFrameBuffer* frames_;
+
+    // Settings
+    std::string segmentName_;
+    int brightnessLevel_;
+    gid_t producerGroup_;
+
+    // State
+    pid_t producer_;
+    long long nextProducerCheckMs_;
+
+    // Statistics
+    unsigned long publishedBefore_;   // Published into a reused segment before we started
+    unsigned long shown_;
+    long long latencySumUs_;
+    long long latencyWorstUs_;
+
+    // Helper methods
+    void showFrame(const uint8_t* pixels);
+    void checkProducer(long long nowMs);
+    void printReport();
+
+    // Disable copy constructor and assignment operator
+    DisplayDaemon(const DisplayDaemon&) = delete;
+    DisplayDaemon& operator=(const DisplayDaemon&) = delete;
+};
+
+#endif // DISPLAY_DAEMON_H
@@ -1,6 +1,11 @@
 #include "main_app.h"
 #include "infrastructure/input/input_handler.h"
+#include "infrastructure/display/matrix_factory.h"
+#include "shared/utils/monotonic_clock.h"
+#include "shared/network/buffer_pool.h"
 #include <iostream>
+#include <cstdlib>
+#include <cstring>
 #include <signal.h>
 #include <unistd.h>
 
@@ -10,8 +15,15 @@ static void InterruptHandler(int signo) {
 }
 
 MainApp::MainApp(int argc, char** argv) 
-    : matrix_(nullptr), argParser_(nullptr), inputHandler_(nullptr), 
-      dbMeterApp_(nullptr), youtubeApp_(nullptr), spotifyApp_(nullptr),
+    : matrix_(nullptr), argParser_(nullptr), inputHandler_(nullptr), terminalInput_(nullptr),
+      lineEditor_(nullptr), controlSocket_(nullptr),
+      fetchScheduler_(nullptr),
+      statsStore_(nullptr), webSubReceiver_(nullptr), hubFetcher_(nullptr), hubServer_(nullptr), hubClient_(nullptr),
+      sampleRing_(nullptr), sampleReceiver_(nullptr), audioSource_(nullptr),
+      exposureLogger_(nullptr), traceWriter_(nullptr), mqttClient_(nullptr), fileSource_(nullptr),
+      syncClock_(nullptr), syncNode_(nullptr),
+      dbMeterApp_(nullptr), youtubeApp_(nullptr), spotifyApp_(nullptr), spectrumApp_(nullptr), textApp_(nullptr),
+      dmxApp_(nullptr), animationApp_(nullptr),
       isRunning_(false), currentApp_(""), brightnessLevel_(5) {
     
     // Parse command line arguments
@@ -35,25 +47,159 @@ bool MainApp::initialize() {
     signal(SIGTERM, InterruptHandler);
     signal(SIGINT, InterruptHandler);
     
-    // Create matrix options
-    RGBMatrix::Options matrix_options;
-    RuntimeOptions runtime_opt;
-    setupMatrixOptions(matrix_options, runtime_opt);
+    // Create shared background fetch scheduler (owns all data sources)
+    fetchScheduler_ = new FetchScheduler();
+    fetchScheduler_->start();
+    
+    // Optional stats hub (server and/or client)
+    if (!initializeHub()) {
+        return false;
+    }
+    
+    if (argParser_->isHubOnly()) {
+        // Headless hub: no matrix, no apps
+        isRunning_ = true;
+        return true;
+    }
     
     // Create matrix
-    matrix_ = CreateMatrixFromOptions(matrix_options, runtime_opt);
+    matrix_ = MatrixFactory::create(brightnessLevel_);
     if (!matrix_) {
         std::cerr << "\033[0;31m❌ Could not initialize matrix\033[0m" << std::endl;
         return false;
     }
     
-    // Create shared input handler
-    inputHandler_ = new InputHandler();
+    // Keystrokes straight from the terminal; piped stdin and --line-input
+    // read whole lines
+    if (!argParser_->isLineInput()) {
+        terminalInput_ = new TerminalInput();
+        if (terminalInput_->enable()) {
+            lineEditor_ = new LineEditor(std::cout);
+        } else {
+            if (!terminalInput_->getLastError().empty()) {
+                std::cerr << "\033[0;33m⚠️  Keystroke input unavailable (" << terminalInput_->getLastError() << "), reading lines\033[0m" << std::endl;
+            }
+            delete terminalInput_;
+            terminalInput_ = nullptr;
+        }
+    }
+    if (!terminalInput_) {
+        inputHandler_ = new InputHandler();
+    }
+    
+    // Optional control socket for scripts and high-rate dB feeds
+    if (!argParser_->getControlSocketPath().empty()) {
+        controlSocket_ = new ControlSocket(argParser_->getControlSocketPath());
+        if (!controlSocket_->open()) {
+            std::cerr << "\033[0;31m❌ Control socket disabled: " << controlSocket_->getLastError() << "\033[0m" << std::endl;
+        }
+    }
+    
+    // Create history store for fetched statistics
+    statsStore_ = new TimeSeriesStore(Config::METRICS_DIRECTORY);
+    
+    // Optional sync with other displays; blinking and text rotation run on its clock
+    if (!initializeSync()) {
+        return false;
+    }
     
     // Create feature apps (but don't initialize them yet)
     dbMeterApp_ = new DbMeterApp(matrix_, brightnessLevel_);
-    youtubeApp_ = new YoutubeApp(matrix_, brightnessLevel_);
-    spotifyApp_ = new SpotifyApp(matrix_, brightnessLevel_);
+    dbMeterApp_->setBlinkClock(syncClock_);
+    youtubeApp_ = new YoutubeApp(matrix_, brightnessLevel_, fetchScheduler_, statsStore_);
+    spotifyApp_ = new SpotifyApp(matrix_, brightnessLevel_, fetchScheduler_, statsStore_);
+    spectrumApp_ = new SpectrumApp(matrix_, brightnessLevel_);
+    textApp_ = new TextApp(matrix_, brightnessLevel_, syncClock_);
+    dmxApp_ = new DmxApp(matrix_, brightnessLevel_);
+    animationApp_ = new AnimationApp(matrix_, brightnessLevel_);
+    animationApp_->setFile(argParser_->getAnimationFile());
+    
+    if (hubClient_) {
+        youtubeApp_->setHubClient(hubClient_);
+        spotifyApp_->setHubClient(hubClient_);
+    }
+    
+    // Meter ballistics for every dB source
+    LevelBallistics::Mode timeWeighting;
+    if (!LevelBallistics::parse(argParser_->getTimeWeighting(), timeWeighting)) {
+        std::cerr << "\033[0;31m❌ Unknown time weighting: " << argParser_->getTimeWeighting() << " (use fast, slow or impulse)\033[0m" << std::endl;
+        return false;
+    }
+    dbMeterApp_->setTimeWeighting(timeWeighting);
+    
+    const std::vector<std::string>& thresholds = argParser_->getChannelThresholds();
+    for (size_t i = 0; i < thresholds.size(); i++) {
+        DbColorCalculator::Thresholds parsed;
+        if (!DbColorCalculator::parseThresholds(thresholds[i], parsed)) {
+            std::cerr << "\033[0;31m❌ Invalid thresholds for channel " << i << ": " << thresholds[i] << " (use yellow/orange/red, e.g. 80/90/95)\033[0m" << std::endl;
+            return false;
+        }
+        dbMeterApp_->setChannelThresholds((int)i, parsed);
+    }
+    
+    // Universe layout for the dmx app; the default first universe depends on the protocol
+    DmxProtocol::Protocol dmxProtocol;
+    if (!DmxProtocol::parseProtocol(argParser_->getDmxProtocol().c_str(), dmxProtocol)) {
+        std::cerr << "\033[0;31m❌ Unknown DMX protocol: " << argParser_->getDmxProtocol() << " (use artnet or sacn)\033[0m" << std::endl;
+        return false;
+    }
+    DmxRenderer::Layout dmxLayout;
+    dmxLayout.firstUniverse = DmxProtocol::defaultFirstUniverse(dmxProtocol);
+    bool validLayout = argParser_->getDmxLayout().empty() || DmxRenderer::parseLayout(argParser_->getDmxLayout(), dmxLayout);
+    int pixels = matrix_->width() * matrix_->height();
+    int lastUniverse = dmxLayout.firstUniverse + DmxRenderer::countUniverses(matrix_->width(), matrix_->height(), dmxLayout) - 1;
+    int maxUniverse = dmxProtocol == DmxProtocol::ART_NET ? DmxProtocol::MAX_ART_NET_UNIVERSE : DmxProtocol::MAX_SACN_UNIVERSE;
+    if (!validLayout || dmxLayout.firstUniverse < DmxProtocol::defaultFirstUniverse(dmxProtocol) || lastUniverse > maxUniverse ||
+        dmxLayout.pixelsPerUniverse * DmxRenderer::MAX_UNIVERSES < pixels) {
+        std::cerr << "\033[0;31m❌ Invalid DMX layout: " << argParser_->getDmxLayout() << " (use first[/pixels][/snake], e.g. 1/170)\033[0m" << std::endl;
+        return false;
+    }
+    dmxApp_->configure(dmxProtocol, dmxLayout);
+    
+    // Optional high-rate dB feed (UDP or audio input)
+    if (!initializeSampleInput()) {
+        return false;
+    }
+    
+    // Optional MQTT subscriptions for dB values and text
+    if (!initializeMqtt()) {
+        return false;
+    }
+    
+    // Optional data file, reloaded whenever it's rewritten
+    if (!initializeDataFile()) {
+        return false;
+    }
+    
+    // Optional noise exposure log, written off the render thread
+    if (!argParser_->getExposureLogDirectory().empty()) {
+        exposureLogger_ = new ExposureLogger(argParser_->getExposureLogDirectory());
+        exposureLogger_->start();
+        dbMeterApp_->setExposureLogger(exposureLogger_);
+    }
+    
+    // Optional dB trace of every reading, for replay with tools/db_trace_replay
+    if (!argParser_->getTraceFile().empty()) {
+        traceWriter_ = new DbTraceWriter();
+        if (!traceWriter_->open(argParser_->getTraceFile(), MonotonicClock::nowMs())) {
+            std::cerr << "\033[0;31m❌ " << traceWriter_->getLastError() << "\033[0m" << std::endl;
+            return false;
+        }
+        dbMeterApp_->setTraceWriter(traceWriter_);
+        std::cout << "\033[0;32m📼 Recording dB trace to " << argParser_->getTraceFile() << "\033[0m" << std::endl;
+    }
+    
+    // Optional WebSub push mode for YouTube
+    if (!argParser_->getWebSubCallback().empty()) {
+        std::string hub = argParser_->getWebSubHub().empty() ? WebSubReceiver::DEFAULT_HUB_URL
+                                                             : argParser_->getWebSubHub();
+        webSubReceiver_ = new WebSubReceiver(argParser_->getWebSubCallback(), argParser_->getWebSubPort(), hub);
+        if (webSubReceiver_->start()) {
+            youtubeApp_->setPushReceiver(webSubReceiver_);
+        } else {
+            std::cerr << "\033[0;31m❌ WebSub disabled: " << webSubReceiver_->getLastError() << "\033[0m" << std::endl;
+        }
+    }
     
     isRunning_ = true;
     printMainMenu();
@@ -61,65 +207,322 @@ bool MainApp::initialize() {
     return true;
 }
 
+bool MainApp::initializeHub() {
+    int listenPort = argParser_->getHubListenPort();
+    if (listenPort > 0) {
+        hubFetcher_ = new StatsHubApiFetcher();
+        StatsHubApiFetcher* fetcher = hubFetcher_;
+        hubServer_ = new StatsHubServer(listenPort, fetchScheduler_,
+            [fetcher](const std::string& channel) { return fetcher->fetchYouTube(channel); },
+            [fetcher](const std::string& artistId) { return fetcher->fetchSpotify(artistId); });
+        
+        const std::vector<std::string>& channels = argParser_->getHubYouTubeChannels();
+        for (size_t i = 0; i < channels.size(); i++) {
+            hubServer_->addYouTubeChannel(channels[i]);
+        }
+        const std::vector<std::string>& artists = argParser_->getHubSpotifyArtists();
+        for (size_t i = 0; i < artists.size(); i++) {
+            hubServer_->addSpotifyArtist(artists[i]);
+        }
+        
+        if (!hubServer_->start()) {
+            std::cerr << "\033[0;31m❌ Stats hub failed: " << hubServer_->getLastError() << "\033[0m" << std::endl;
+            return false;
+        }
+    }
+    
+    if (argParser_->isHubOnly()) {
+        if (!hubServer_) {
+            std::cerr << "\033[0;31m❌ --hub-only requires --hub-listen <port>\033[0m" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    
+    // A display running the hub also reads through it, so its own apps
+    // don't fetch separately
+    std::string address = argParser_->getHubConnect();
+    if (address.empty() && hubServer_) {
+        address = "127.0.0.1:" + std::to_string(listenPort);
+    }
+    
+    if (!address.empty()) {
+        std::string host;
+        int port = 0;
+        if (!StatsHubClient::parseAddress(address, host, port)) {
+            std::cerr << "\033[0;31m❌ Invalid hub address: " << address << "\033[0m" << std::endl;
+            return false;
+        }
+        hubClient_ = new StatsHubClient(host, port);
+        hubClient_->start();
+    }
+    
+    return true;
+}
+
+bool MainApp::initializeMqtt() {
+    const std::vector<std::string>& dbTopics = argParser_->getMqttDbTopics();
+    const std::vector<std::string>& textTopics = argParser_->getMqttTextTopics();
+    if (argParser_->getMqttBroker().empty()) {
+        if (!dbTopics.empty() || !textTopics.empty()) {
+            std::cerr << "\033[0;33m⚠️  --mqtt-db and --mqtt-text need --mqtt <host:port>\033[0m" << std::endl;
+        }
+        return true;
+    }
+    
+    std::string host;
+    int port = 0;
+    if (!MqttClient::parseAddress(argParser_->getMqttBroker(), host, port)) {
+        std::cerr << "\033[0;31m❌ Invalid MQTT broker address: " << argParser_->getMqttBroker() << "\033[0m" << std::endl;
+        return false;
+    }
+    
+    // One session per display; a second client with the same ID would take it over
+    char hostname[64] = "display";
+    gethostname(hostname, sizeof(hostname) - 1);
+    mqttClient_ = new MqttClient(host, port, std::string("led-matrix-") + hostname);
+    
+    const char* username = std::getenv("MQTT_USERNAME");
+    const char* password = std::getenv("MQTT_PASSWORD");
+    if (username) {
+        mqttClient_->setCredentials(username, password ? password : "");
+    }
+    
+    // "topic@channel" feeds one meter channel
+    for (size_t i = 0; i < dbTopics.size(); i++) {
+        std::string topic = dbTopics[i];
+        int channel = 0;
+        size_t at = topic.rfind('@');
+        if (at != std::string::npos) {
+            channel = std::atoi(topic.c_str() + at + 1);
+            topic.erase(at);
+        }
+        if (channel < 0 || channel >= MultiChannelMeter::MAX_CHANNELS ||
+            !mqttClient_->subscribe(topic, [this, channel](const MqttClient::Message& message) {
+                applyLevelText(message.payload, message.payloadSize, channel);
+            })) {
+            std::cerr << "\033[0;31m❌ Invalid --mqtt-db topic: " << dbTopics[i] << "\033[0m" << std::endl;
+            return false;
+        }
+    }
+    for (size_t i = 0; i < textTopics.size(); i++) {
+        if (!mqttClient_->subscribe(textTopics[i], [this](const MqttClient::Message& message) {
+                textApp_->setText(message.topic, message.topicSize, message.payload, message.payloadSize);
+            })) {
+            std::cerr << "\033[0;31m❌ Invalid --mqtt-text topic: " << textTopics[i] << "\033[0m" << std::endl;
+            return false;
+        }
+    }
+    
+    mqttClient_->start();
+    std::cout << "\033[0;32m📡 MQTT: " << dbTopics.size() << " dB and " << textTopics.size() << " text topics on " << host << ":" << port << "\033[0m" << std::endl;
+    return true;
+}
+
+bool MainApp::initializeDataFile() {
+    if (argParser_->getDataFile().empty()) {
+        return true;
+    }
+    
+    fileSource_ = new FileDataSource(argParser_->getDataFile(), [this](const StringRef& key, const StringRef& value) {
+        handleFileValue(key, value);
+    });
+    if (!fileSource_->start()) {
+        std::cerr << "\033[0;31m❌ Data file disabled: " << fileSource_->getLastError() << "\033[0m" << std::endl;
+        return true;
+    }
+    std::cout << "\033[0;32m📄 Watching " << argParser_->getDataFile() << " for values\033[0m" << std::endl;
+    return true;
+}
+
+bool MainApp::initializeSync() {
+    int leadPort = argParser_->getSyncLeadPort();
+    const std::string& leader = argParser_->getSyncFollow();
+    if (leadPort <= 0 && leader.empty()) {
+        return true;
+    }
+    if (leadPort > 0 && !leader.empty()) {
+        std::cerr << "\033[0;31m❌ Use either --sync-lead or --sync-follow, not both\033[0m" << std::endl;
+        return false;
+    }
+    
+    std::string host;
+    int port = leadPort;
+    if (!leader.empty() && !SyncNode::parseAddress(leader, host, port)) {
+        std::cerr << "\033[0;31m❌ Invalid sync leader address: " << leader << "\033[0m" << std::endl;
+        return false;
+    }
+    
+    // The leader's report names followers by host
+    char hostname[64] = "display";
+    gethostname(hostname, sizeof(hostname) - 1);
+    syncClock_ = new SyncClock(Config::SYNC_TICK_MS);
+    syncNode_ = new SyncNode(leadPort > 0 ? SyncNode::LEADER : SyncNode::FOLLOWER, host, port, hostname, syncClock_);
+    if (!syncNode_->start()) {
+        std::cerr << "\033[0;31m❌ Sync disabled: " << syncNode_->getLastError() << "\033[0m" << std::endl;
+        delete syncNode_;
+        syncNode_ = nullptr;
+        delete syncClock_;
+        syncClock_ = nullptr;
+    }
+    return true;
+}
+
+void MainApp::handleFileValue(const StringRef& key, const StringRef& value) {
+    // "db" is channel 0, "db1".."dbN" the others; any other key is a text
+    if (key.size >= 2 && key.size <= 4 && std::memcmp(key.data, "db", 2) == 0) {
+        int channel = 0;
+        for (size_t i = 2; i < key.size; i++) {
+            if (key.data[i] < '0' || key.data[i] > '9') {
+                return;
+            }
+            channel = channel * 10 + (key.data[i] - '0');
+        }
+        if (channel < MultiChannelMeter::MAX_CHANNELS) {
+            applyLevelText(value.data, value.size, channel);
+        }
+    } else if (!key.empty()) {
+        textApp_->setText(key.data, key.size, value.data, value.size);
+    }
+}
+
+void MainApp::applyLevelText(const char* payload, size_t payloadSize, int channel) {
+    // Plain numbers ("72.5"); the payload isn't NUL-terminated
+    char text[32];
+    size_t size = payloadSize < sizeof(text) - 1 ? payloadSize : sizeof(text) - 1;
+    std::memcpy(text, payload, size);
+    text[size] = '\0';
+    
+    char* end = nullptr;
+    double value = std::strtod(text, &end);
+    while (end != text && (*end == ' ' || *end == '\r' || *end == '\n' || *end == '\t')) {
+        end++;
+    }
+    if (end == text || *end != '\0' || value < Config::MIN_DB_VALUE || value > Config::MAX_DB_VALUE) {
+        return;
+    }
+    dbMeterApp_->updateValue((int)(value + 0.5), channel);
+}
+
+bool MainApp::initializeSampleInput() {
+    bool useUdp = argParser_->getSamplePort() > 0;
+    bool useAudio = !argParser_->getAudioSpec().empty();
+    if (argParser_->isBeatBorder() && !useAudio) {
+        std::cerr << "\033[0;33m⚠️  --beat-border needs --audio; the border will blink as usual\033[0m" << std::endl;
+    }
+    if (!useUdp && !useAudio) {
+        return true;
+    }
+    if (useUdp && useAudio) {
+        // The ring has a single producer
+        std::cerr << "\033[0;31m❌ Use either --sample-port or --audio, not both\033[0m" << std::endl;
+        return false;
+    }
+    
+    // Producer thread -> lock-free ring -> render loop
+    sampleRing_ = new DbSampleRing(Config::SAMPLE_RING_CAPACITY);
+    
+    if (useUdp) {
+        sampleReceiver_ = new DbSampleReceiver(argParser_->getSamplePort(), sampleRing_);
+        if (!sampleReceiver_->start()) {
+            std::cerr << "\033[0;31m❌ Sample receiver disabled: " << sampleReceiver_->getLastError() << "\033[0m" << std::endl;
+            return true;
+        }
+    } else {
+        audioSource_ = new AudioLevelSource(argParser_->getAudioSpec(), argParser_->getAudioSampleRate(),
+                                            argParser_->getAudioChannels(), sampleRing_);
+        audioSource_->setWindowMs(argParser_->getAudioWindowMs());
+        audioSource_->setCalibrationDb(argParser_->getAudioCalibrationDb());
+        
+        FrequencyWeighting::Type weighting;
+        if (!FrequencyWeighting::parse(argParser_->getAudioWeighting(), weighting)) {
+            std::cerr << "\033[0;31m❌ Unknown weighting: " << argParser_->getAudioWeighting() << " (use A, C or Z)\033[0m" << std::endl;
+            return false;
+        }
+        audioSource_->setWeighting(weighting);
+        
+        // Audio is time-weighted per PCM sample, ahead of the display
+        LevelBallistics::Mode timeWeighting = LevelBallistics::MODE_FAST;
+        LevelBallistics::parse(argParser_->getTimeWeighting(), timeWeighting);  // Validated in initialize()
+        audioSource_->setTimeWeighting(timeWeighting);
+        audioSource_->setBeatTrackingEnabled(argParser_->isBeatBorder());
+        if (!audioSource_->start()) {
+            std::cerr << "\033[0;31m❌ Audio input disabled: " << audioSource_->getLastError() << "\033[0m" << std::endl;
+            return true;
+        }
+        dbMeterApp_->setTimeWeighting(timeWeighting, true);
+        spectrumApp_->setAudioSource(audioSource_);
+    }
+    
+    dbMeterApp_->setSampleRing(sampleRing_);
+    return true;
+}
+
+void MainApp::runHubOnly() {
+    std::cout << "\033[1;36m📡 Running as headless stats hub (Ctrl+C to stop)\033[0m" << std::endl;
+    
+    while (!interrupt_received) {
+        usleep(100000); // 100ms
+    }
+    
+    std::cout << "\n\033[0;33m📊 Hub served " << hubServer_->getFetchCount() << " upstream fetches as "
+              << hubServer_->getPublishCount() << " client updates, dropped "
+              << hubServer_->getDroppedClientCount() << " stalled clients\033[0m" << std::endl;
+}
+
 void MainApp::run() {
     if (!isRunning_) {
         std::cerr << "\033[0;31m❌ Application not initialized\033[0m" << std::endl;
         return;
     }
     
+    if (argParser_->isHubOnly()) {
+        runHubOnly();
+        return;
+    }
+    
     while (!interrupt_received && isRunning_) {
-        // Check for new input
-        if (inputHandler_->hasInput()) {
-            if (currentApp_.empty()) {
-                // No app active - treat as command
-                std::string command = inputHandler_->readStringValue();
-                
-                if (command == "quit" || command == "exit" || command == "q") {
-                    break;
-                }
-                
-                handleCommand(command);
-            } else {
-                // App is active - check if it's a command first
-                std::string input = inputHandler_->readStringValue();
-                
-                if (input == "back" || input == "b") {
-                    // Return to main menu
-                    currentApp_ = "";
-                    std::cout << "\n\033[0;32m🔙 Returned to main menu\033[0m" << std::endl;
-                    printMainMenu();
-                } else {
-                    // Handle input for active app
-                    if (currentApp_ == "db") {
-                        // Try to parse as numeric input for DB meter
-                        try {
-                            int newValue = std::stoi(input);
-                            if (inputHandler_->isValidIntValue(newValue, 0, 120)) {
-                                dbMeterApp_->updateValue(newValue);
-                            }
-                        } catch (const std::invalid_argument&) {
-                            // Invalid input, ignore
-                        }
-                    } else if (currentApp_ == "youtube") {
-                        // Handle YouTube app input (channel ID or commands)
-                        if (input.length() == 1) {
-                            // Single character input - handle as keyboard input
-                            youtubeApp_->handleKeyboardInput(input[0]);
-                        } else {
-                            // Multi-character input - treat as channel ID
-                            youtubeApp_->setChannelId(input);
-                        }
-                    } else if (currentApp_ == "spotify") {
-                        // Handle Spotify app input (artist ID or commands)
-                        if (input.length() == 1) {
-                            // Single character input - handle as keyboard input
-                            spotifyApp_->handleKeyboardInput(input[0]);
-                        } else {
-                            // Multi-character input - treat as artist ID
-                            spotifyApp_->setArtistId(input);
-                        }
-                    }
-                }
+        // Drain keys or complete stdin lines (never blocks on a partial line)
+        bool quit = false;
+        if (terminalInput_) {
+            quit = !handleKeys();
+        }
+        while (!quit && inputHandler_ && inputHandler_->hasInput()) {
+            quit = !handleInputLine(inputHandler_->readStringValue());
+        }
+        
+        // Drain the control socket the same way
+        if (!quit && controlSocket_ && controlSocket_->isOpen()) {
+            controlLines_.clear();
+            controlSocket_->poll(controlLines_);
+            for (size_t i = 0; i < controlLines_.size() && !quit; i++) {
+                quit = !handleInputLine(controlLines_[i]);
+            }
+        }
+        
+        if (quit) {
+            break;
+        }
+        
+        // MQTT messages land in the meter and text app before they draw
+        if (mqttClient_) {
+            mqttClient_->poll();
+        }
+        if (fileSource_) {
+            fileSource_->poll();
+        }
+        
+        // Reduce samples that arrived since the last frame (keeps the
+        // meter current even while another app is showing)
+        dbMeterApp_->ingestSamples();
+        if (audioSource_) {
+            LevelMetrics metrics;
+            if (audioSource_->getMetrics(metrics)) {
+                dbMeterApp_->setLevelMetrics(metrics);
+            }
+            BeatState beat;
+            if (audioSource_->getBeatState(beat)) {
+                dbMeterApp_->setBeatState(beat);
             }
         }
         
@@ -130,23 +533,290 @@ void MainApp::run() {
             youtubeApp_->update();
         } else if (currentApp_ == "spotify") {
             spotifyApp_->update();
+        } else if (currentApp_ == "spectrum") {
+            spectrumApp_->update();
+        } else if (currentApp_ == "text") {
+            textApp_->update();
+        } else if (currentApp_ == "dmx") {
+            dmxApp_->update();
+        } else if (currentApp_ == "anim") {
+            animationApp_->update();
+        }
+        
+        // The leader compares every display's frame of the same tick
+        if (syncNode_ && !currentApp_.empty()) {
+            syncNode_->frameShown();
         }
         
-        // Small delay
-        usleep(10000); // 10ms
+        // Small delay, or until the next shared tick in sync; keys cut it
+        // short and are handled as they arrive
+        if (!waitForFrame(10)) { // 10ms
+            break;
+        }
     }
     
     std::cout << "\n\033[0;31m⚠️  Received CTRL-C. Exiting.\033[0m" << std::endl;
 }
 
+bool MainApp::handleInputLine(const std::string& line) {
+    // "set <dB>" feeds the meter whichever app is showing
+    if (line.compare(0, 4, "set ") == 0) {
+        handleValueUpdate(line.substr(4));
+        return true;
+    }
+    
+    if (currentApp_.empty()) {
+        // No app active - treat as command
+        if (line == "quit" || line == "exit" || line == "q") {
+            return false;
+        }
+        handleCommand(line);
+    } else if (line == "netstats" || line == "ingest" || line == "dose" || line == "mqtt" || line == "file" || line == "dmxstats" ||
+               line == "animstats" || line == "syncstats" || line == "resync") {
+        handleCommand(line);
+    } else if (line == "back" || line == "b") {
+        // Return to main menu
+        cleanupCurrentApp();
+        currentApp_ = "";
+        std::cout << "\n\033[0;32m🔙 Returned to main menu\033[0m" << std::endl;
+        printMainMenu();
+    } else if (currentApp_ == "db") {
+        // Page and reset keys for audio levels, otherwise numeric input
+        if (line == "p") {
+            dbMeterApp_->nextPage();
+        } else if (line == "r" && audioSource_) {
+            audioSource_->resetMetrics();
+            std::cout << "\033[0;32m🔄 Leq/Lmax/Lpeak reset\033[0m" << std::endl;
+        } else {
+            handleValueUpdate(line);
+        }
+    } else if (currentApp_ == "youtube") {
+        // Handle YouTube app input (channel ID or commands)
+        if (line.length() == 1) {
+            // Single character input - handle as keyboard input
+            youtubeApp_->handleKeyboardInput(line[0]);
+        } else {
+            // Multi-character input - treat as channel ID
+            youtubeApp_->setChannelId(line);
+        }
+    } else if (currentApp_ == "spotify") {
+        // Handle Spotify app input (artist ID or commands)
+        if (line.length() == 1) {
+            // Single character input - handle as keyboard input
+            spotifyApp_->handleKeyboardInput(line[0]);
+        } else {
+            // Multi-character input - treat as artist ID
+            spotifyApp_->setArtistId(line);
+        }
+    }
+    
+    return true;
+}
+
+bool MainApp::handleKeys() {
+    keyEvents_.clear();
+    terminalInput_->poll(keyEvents_);
+    for (size_t i = 0; i < keyEvents_.size(); i++) {
+        if (!handleKey(keyEvents_[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MainApp::handleKey(const KeyEvent& key) {
+    // Escape leaves the current app, like "back"
+    if (key.type == KeyEvent::ESCAPE) {
+        lineEditor_->clear();
+        return currentApp_.empty() || handleInputLine("back");
+    }
+    
+    // YouTube and Spotify edit their IDs key by key
+    if (currentApp_ == "youtube" || currentApp_ == "spotify") {
+        sendKeyToApp(key);
+        return true;
+    }
+    
+    // Arrows page through the audio level readouts
+    if (currentApp_ == "db" && (key.type == KeyEvent::LEFT || key.type == KeyEvent::RIGHT)) {
+        dbMeterApp_->nextPage();
+        return true;
+    }
+    
+    // Everything else is typed into a command line
+    editedLines_.clear();
+    lineEditor_->handleKey(key, editedLines_);
+    for (size_t i = 0; i < editedLines_.size(); i++) {
+        if (!handleInputLine(editedLines_[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MainApp::sendKeyToApp(const KeyEvent& key) {
+    char c;
+    switch (key.type) {
+        case KeyEvent::CHARACTER:
+            c = key.character;
+            break;
+        case KeyEvent::ENTER:
+            c = '\n';
+            break;
+        case KeyEvent::BACKSPACE:
+            c = 127;
+            break;
+        case KeyEvent::PASTE: {
+            // A pasted ID replaces the one being typed and is fetched at once
+            std::string id = key.text.substr(0, key.text.find_first_of("\r\n"));
+            if (id.empty()) {
+                return;
+            }
+            if (currentApp_ == "youtube") {
+                youtubeApp_->setChannelId(id);
+            } else {
+                spotifyApp_->setArtistId(id);
+            }
+            return;
+        }
+        default:
+            return;
+    }
+    
+    if (currentApp_ == "youtube") {
+        youtubeApp_->handleKeyboardInput(c);
+    } else {
+        spotifyApp_->handleKeyboardInput(c);
+    }
+}
+
+bool MainApp::waitForFrame(int delayMs) {
+    // Displays in sync all draw when their shared tick starts
+    long long deadlineUs = syncClock_ ? syncClock_->nextTick() : MonotonicClock::nowUs() + delayMs * 1000LL;
+    
+    // Keys are waited for in whole milliseconds; the rest is slept
+    long long remainingUs = deadlineUs - MonotonicClock::nowUs();
+    while (remainingUs > 0 && !interrupt_received) {
+        if (terminalInput_ && remainingUs >= 1000) {
+            if (terminalInput_->wait((int)(remainingUs / 1000)) && !handleKeys()) {
+                return false;
+            }
+        } else {
+            usleep((useconds_t)remainingUs);
+        }
+        remainingUs = deadlineUs - MonotonicClock::nowUs();
+    }
+    return true;
+}
+
+bool MainApp::handleValueUpdate(const std::string& line) {
+    // strtol instead of stoi: no exceptions on the hot path of a fast feed
+    const char* begin = line.c_str();
+    char* end = nullptr;
+    long value = std::strtol(begin, &end, 10);
+    if (end == begin || (*end != '\0' && *end != ' ')) {
+        return false;
+    }
+    if (value < Config::MIN_DB_VALUE || value > Config::MAX_DB_VALUE) {
+        return false;
+    }
+    
+    // Optional channel after the value ("85 2")
+    long channel = 0;
+    if (*end == ' ') {
+        const char* channelBegin = end + 1;
+        channel = std::strtol(channelBegin, &end, 10);
+        if (end == channelBegin || *end != '\0') {
+            return false;
+        }
+        if (channel < 0 || channel >= MultiChannelMeter::MAX_CHANNELS) {
+            return false;
+        }
+    }
+    dbMeterApp_->updateValue(static_cast<int>(value), static_cast<int>(channel));
+    return true;
+}
+
 void MainApp::cleanup() {
     cleanupCurrentApp();
     
+    // Stop hub updates before the apps that receive them go away
+    if (hubClient_) {
+        hubClient_->stop();
+    }
+    
+    // Stop background fetches before the apps that own the jobs go away
+    if (fetchScheduler_) {
+        fetchScheduler_->stop();
+    }
+    
+    if (hubServer_) {
+        hubServer_->stop();
+    }
+    
+    if (webSubReceiver_) {
+        webSubReceiver_->stop();
+    }
+    
+    if (sampleReceiver_) {
+        sampleReceiver_->stop();
+        delete sampleReceiver_;
+        sampleReceiver_ = nullptr;
+    }
+    
+    if (audioSource_) {
+        audioSource_->stop();
+        delete audioSource_;
+        audioSource_ = nullptr;
+    }
+    
+    // Its callbacks feed the apps deleted below
+    if (mqttClient_) {
+        mqttClient_->stop();
+        delete mqttClient_;
+        mqttClient_ = nullptr;
+    }
+    
+    if (fileSource_) {
+        fileSource_->stop();
+        delete fileSource_;
+        fileSource_ = nullptr;
+    }
+    
+    if (syncNode_) {
+        syncNode_->stop();
+        delete syncNode_;
+        syncNode_ = nullptr;
+    }
+    
+    // Writes out the pending seconds
+    if (exposureLogger_) {
+        exposureLogger_->stop();
+    }
+    
+    if (controlSocket_) {
+        controlSocket_->close();
+        delete controlSocket_;
+        controlSocket_ = nullptr;
+    }
+    
     if (inputHandler_) {
         delete inputHandler_;
         inputHandler_ = nullptr;
     }
     
+    // Give the shell its terminal back
+    if (terminalInput_) {
+        terminalInput_->restore();
+        delete terminalInput_;
+        terminalInput_ = nullptr;
+    }
+    
+    if (lineEditor_) {
+        delete lineEditor_;
+        lineEditor_ = nullptr;
+    }
+    
     if (dbMeterApp_) {
         delete dbMeterApp_;
         dbMeterApp_ = nullptr;
@@ -162,6 +832,77 @@ void MainApp::cleanup() {
         spotifyApp_ = nullptr;
     }
     
+    if (spectrumApp_) {
+        delete spectrumApp_;
+        spectrumApp_ = nullptr;
+    }
+    
+    if (textApp_) {
+        delete textApp_;
+        textApp_ = nullptr;
+    }
+    
+    if (dmxApp_) {
+        delete dmxApp_;
+        dmxApp_ = nullptr;
+    }
+    
+    if (animationApp_) {
+        delete animationApp_;
+        animationApp_ = nullptr;
+    }
+    
+    // The meter and text app blink and rotate on it
+    if (syncClock_) {
+        delete syncClock_;
+        syncClock_ = nullptr;
+    }
+    
+    if (sampleRing_) {
+        delete sampleRing_;
+        sampleRing_ = nullptr;
+    }
+    
+    if (exposureLogger_) {
+        delete exposureLogger_;
+        exposureLogger_ = nullptr;
+    }
+    
+    if (traceWriter_) {
+        delete traceWriter_;
+        traceWriter_ = nullptr;
+    }
+    
+    if (hubClient_) {
+        delete hubClient_;
+        hubClient_ = nullptr;
+    }
+    
+    if (hubServer_) {
+        delete hubServer_;
+        hubServer_ = nullptr;
+    }
+    
+    if (hubFetcher_) {
+        delete hubFetcher_;
+        hubFetcher_ = nullptr;
+    }
+    
+    if (fetchScheduler_) {
+        delete fetchScheduler_;
+        fetchScheduler_ = nullptr;
+    }
+    
+    if (statsStore_) {
+        delete statsStore_;
+        statsStore_ = nullptr;
+    }
+    
+    if (webSubReceiver_) {
+        delete webSubReceiver_;
+        webSubReceiver_ = nullptr;
+    }
+    
     if (argParser_) {
         delete argParser_;
         argParser_ = nullptr;
@@ -176,21 +917,6 @@ void MainApp::cleanup() {
     isRunning_ = false;
 }
 
-void MainApp::setupMatrixOptions(RGBMatrix::Options& options, RuntimeOptions& runtime_opt) {
-    // Configure matrix to match your working setup
-    options.rows = 48;                    // --led-rows=48
-    options.cols = 96;                    // --led-cols=96
-    options.chain_length = 1;
-    options.parallel = 1;
-    options.hardware_mapping = "regular";
-    options.brightness = brightnessLevel_ * 10; // Convert 1-10 to 10-100
-    options.disable_hardware_pulsing = true;   // --led-no-hardware-pulse
-    options.pwm_bits = 11;                // --led-pwm-bits=11
-    options.pwm_lsb_nanoseconds = 110;    // --led-pwm-lsb-nanoseconds 130
-    
-    runtime_opt.gpio_slowdown = 4;        // --led-slowdown-gpio=4
-}
-
 void MainApp::printMainMenu() {
     std::cout << "\033[1;36m🎮 LED Matrix Applications\033[0m" << std::endl;
     std::cout << "\033[0;33m💡 Brightness:\033[0m " << brightnessLevel_ << "/10 (" << (brightnessLevel_ * 10) << "%)" << std::endl;
@@ -199,6 +925,20 @@ void MainApp::printMainMenu() {
     std::cout << "  \033[0;34mdb\033[0m        - dB Level Meter" << std::endl;
     std::cout << "  \033[0;34myoutube\033[0m   - YouTube Subscriber Counter" << std::endl;
     std::cout << "  \033[0;34mspotify\033[0m   - Spotify Artist Statistics" << std::endl;
+    std::cout << "  \033[0;34mspectrum\033[0m  - Spectrum Analyzer (audio input)" << std::endl;
+    std::cout << "  \033[0;34mtext\033[0m      - Text from MQTT topics or the data file" << std::endl;
+    std::cout << "  \033[0;34mdmx\033[0m       - Pixels from a lighting desk (Art-Net/sACN)" << std::endl;
+    std::cout << "  \033[0;34manim\033[0m      - Pre-rendered animation (--animation)" << std::endl;
+    std::cout << "  \033[0;34mnetstats\033[0m  - Network timing per endpoint" << std::endl;
+    std::cout << "  \033[0;34mset <dB> [channel]\033[0m  - Update the dB meter value (0-120)" << std::endl;
+    std::cout << "  \033[0;34mingest\033[0m    - dB sample feed statistics (UDP or audio)" << std::endl;
+    std::cout << "  \033[0;34mdose\033[0m      - Noise dose today (OSHA/NIOSH) from the exposure log" << std::endl;
+    std::cout << "  \033[0;34mmqtt\033[0m      - MQTT connection and message counts" << std::endl;
+    std::cout << "  \033[0;34mfile\033[0m      - Data file loads and errors" << std::endl;
+    std::cout << "  \033[0;34mdmxstats\033[0m  - DMX packet and frame counts" << std::endl;
+    std::cout << "  \033[0;34manimstats\033[0m - Animation frames shown, skipped and late" << std::endl;
+    std::cout << "  \033[0;34msyncstats\033[0m - Clock offset and frame skew between displays in sync" << std::endl;
+    std::cout << "  \033[0;34mresync\033[0m    - Restart blinking and text rotation on every display (leader)" << std::endl;
     std::cout << "  \033[0;34mquit\033[0m      - Exit application" << std::endl;
     std::cout << std::endl;
     std::cout << "\033[0;32m💡 Type an app name to switch to it:\033[0m" << std::endl;
@@ -211,13 +951,69 @@ void MainApp::handleCommand(const std::string& command) {
         switchToApp("youtube");
     } else if (command == "spotify" || command == "sp") {
         switchToApp("spotify");
+    } else if (command == "spectrum" || command == "fft") {
+        switchToApp("spectrum");
+    } else if (command == "text") {
+        switchToApp("text");
+    } else if (command == "dmx") {
+        switchToApp("dmx");
+    } else if (command == "dmxstats") {
+        dmxApp_->printReport(std::cout);
+    } else if (command == "anim") {
+        switchToApp("anim");
+    } else if (command == "animstats") {
+        animationApp_->printReport(std::cout);
+    } else if (command == "syncstats" || command == "resync") {
+        if (!syncNode_) {
+            std::cout << "\033[0;33m💡 Start with --sync-lead <port> or --sync-follow <host:port> to run in step with other displays\033[0m" << std::endl;
+        } else if (command == "syncstats") {
+            syncNode_->printReport(std::cout);
+        } else if (syncNode_->getRole() == SyncNode::LEADER) {
+            syncNode_->beginEpoch();
+        } else {
+            std::cout << "\033[0;33m💡 Only the leader starts epochs\033[0m" << std::endl;
+        }
+    } else if (command == "netstats") {
+        NetworkStats::shared().printReport(std::cout);
+        // Stays put once every response fits in a recycled buffer
+        std::cout << "   response buffer growths " << BufferPool::getBufferGrowthCount() << std::endl;
+        if (webSubReceiver_) {
+            std::cout << "   WebSub notifications " << webSubReceiver_->getNotificationCount() << ", ignored "
+                      << webSubReceiver_->getRejectedCount() << " (unsigned or badly signed)" << std::endl;
+        }
+    } else if (command == "ingest") {
+        if (sampleReceiver_) {
+            sampleReceiver_->printReport(std::cout);
+        } else if (audioSource_) {
+            audioSource_->printReport(std::cout);
+        } else {
+            std::cout << "\033[0;33m💡 Start with --sample-port <port> or --audio <source> to feed the dB meter\033[0m" << std::endl;
+        }
+    } else if (command == "dose") {
+        if (exposureLogger_) {
+            exposureLogger_->printReport(std::cout);
+        } else {
+            std::cout << "\033[0;33m💡 Start with --exposure-log <dir> to log exposure and track noise dose\033[0m" << std::endl;
+        }
+    } else if (command == "mqtt") {
+        if (mqttClient_) {
+            mqttClient_->printReport(std::cout);
+        } else {
+            std::cout << "\033[0;33m💡 Start with --mqtt <host:port> and --mqtt-db/--mqtt-text <topics>\033[0m" << std::endl;
+        }
+    } else if (command == "file") {
+        if (fileSource_) {
+            fileSource_->printReport(std::cout);
+        } else {
+            std::cout << "\033[0;33m💡 Start with --data-file <file> to load values from a file\033[0m" << std::endl;
+        }
     } else if (command == "back" || command == "menu") {
         cleanupCurrentApp();
         currentApp_ = "";
         printMainMenu();
     } else {
         std::cout << "\033[0;31m❌ Unknown command: " << command << "\033[0m" << std::endl;
-        std::cout << "\033[0;32m💡 Available commands: db, youtube, spotify, back, quit\033[0m" << std::endl;
+        std::cout << "\033[0;32m💡 Available commands: db, youtube, spotify, spectrum, text, dmx, anim, netstats, ingest, dose, mqtt, file, dmxstats, animstats, syncstats, resync, set <dB>, back, quit\033[0m" << std::endl;
     }
 }
 
@@ -233,16 +1029,46 @@ void MainApp::switchToApp(const std::string& appName) {
         }
     } else if (appName == "youtube") {
         std::cout << "\033[1;36m📺 Switching to YouTube Counter...\033[0m" << std::endl;
+        if (terminalInput_) {
+            std::cout << "\033[0;32m💡 Type or paste a channel ID, Enter to fetch, r to refresh, Esc for the menu\033[0m" << std::endl;
+        }
         if (!youtubeApp_->initialize()) {
             std::cerr << "\033[0;31m❌ Failed to initialize YouTube Counter app\033[0m" << std::endl;
             currentApp_ = "";
         }
     } else if (appName == "spotify") {
         std::cout << "\033[1;36m🎵 Switching to Spotify Counter...\033[0m" << std::endl;
+        if (terminalInput_) {
+            std::cout << "\033[0;32m💡 Type or paste an artist ID, Enter to fetch, r to refresh, Esc for the menu\033[0m" << std::endl;
+        }
         if (!spotifyApp_->initialize()) {
             std::cerr << "\033[0;31m❌ Failed to initialize Spotify Counter app\033[0m" << std::endl;
             currentApp_ = "";
         }
+    } else if (appName == "spectrum") {
+        std::cout << "\033[1;36m📊 Switching to Spectrum Analyzer...\033[0m" << std::endl;
+        if (!spectrumApp_->initialize()) {
+            std::cerr << "\033[0;31m❌ Failed to initialize Spectrum Analyzer app\033[0m" << std::endl;
+            currentApp_ = "";
+        }
+    } else if (appName == "text") {
+        std::cout << "\033[1;36m💬 Switching to Text...\033[0m" << std::endl;
+        if (!textApp_->initialize()) {
+            std::cerr << "\033[0;31m❌ Failed to initialize Text app\033[0m" << std::endl;
+            currentApp_ = "";
+        }
+    } else if (appName == "dmx") {
+        std::cout << "\033[1;36m💡 Switching to DMX...\033[0m" << std::endl;
+        if (!dmxApp_->initialize()) {
+            std::cerr << "\033[0;31m❌ Failed to initialize DMX app\033[0m" << std::endl;
+            currentApp_ = "";
+        }
+    } else if (appName == "anim") {
+        std::cout << "\033[1;36m🎞️  Switching to Animation...\033[0m" << std::endl;
+        if (!animationApp_->initialize()) {
+            std::cerr << "\033[0;31m❌ Failed to initialize Animation app\033[0m" << std::endl;
+            currentApp_ = "";
+        }
     } else {
         std::cout << "\033[0;31m❌ Unknown app: " << appName << "\033[0m" << std::endl;
     }
@@ -252,8 +1078,20 @@ void MainApp::cleanupCurrentApp() {
     if (currentApp_ == "db") {
         // Cleanup dB meter app if needed
     } else if (currentApp_ == "youtube") {
-        // Cleanup YouTube app if needed
+        // Stops polling the channel nobody is looking at
+        youtubeApp_->cleanup();
     } else if (currentApp_ == "spotify") {
-        // Cleanup Spotify app if needed
+        spotifyApp_->cleanup();
+    } else if (currentApp_ == "spectrum") {
+        // Stop computing spectra nobody is looking at
+        spectrumApp_->cleanup();
+    } else if (currentApp_ == "text") {
+        textApp_->cleanup();
+    } else if (currentApp_ == "dmx") {
+        // Frees the UDP port
+        dmxApp_->cleanup();
+    } else if (currentApp_ == "anim") {
+        // Leaves a blank canvas up, so the next app never draws over a preloaded frame
+        animationApp_->cleanup();
     }
 }
@@ -5,10 +5,31 @@
 #include "graphics.h"
 #include "infrastructure/config/arg_parser.h"
 #include "infrastructure/input/input_handler.h"
+#include "infrastructure/input/control_socket.h"
+#include "infrastructure/input/terminal_input.h"
+#include "infrastructure/input/line_editor.h"
 #include "presentation/controllers/db_meter_app.h"
 #include "presentation/controllers/youtube_app.h"
 #include "presentation/controllers/spotify_app.h"
+#include "presentation/controllers/spectrum_app.h"
+#include "presentation/controllers/text_app.h"
+#include "presentation/controllers/dmx_app.h"
+#include "presentation/controllers/animation_app.h"
+#include "shared/network/fetch_scheduler.h"
+#include "infrastructure/storage/timeseries_store.h"
+#include "infrastructure/storage/exposure_logger.h"
+#include "infrastructure/storage/db_trace.h"
+#include "infrastructure/network/websub_receiver.h"
+#include "infrastructure/network/stats_hub_server.h"
+#include "infrastructure/network/stats_hub_api_fetcher.h"
+#include "infrastructure/network/stats_hub_client.h"
+#include "infrastructure/network/db_sample_receiver.h"
+#include "infrastructure/network/mqtt_client.h"
+#include "infrastructure/network/sync_node.h"
+#include "infrastructure/storage/file_data_source.h"
+#include "infrastructure/audio/audio_level_source.h"
 #include <string>
+#include <vector>
 
 using namespace rgb_matrix;
 
@@ -27,20 +48,58 @@ private:
     RGBMatrix* matrix_;
     ArgParser* argParser_;
     InputHandler* inputHandler_;
+    TerminalInput* terminalInput_;
+    LineEditor* lineEditor_;
+    ControlSocket* controlSocket_;
+    FetchScheduler* fetchScheduler_;
+    TimeSeriesStore* statsStore_;
+    WebSubReceiver* webSubReceiver_;
+    StatsHubApiFetcher* hubFetcher_;
+    StatsHubServer* hubServer_;
+    StatsHubClient* hubClient_;
+    DbSampleRing* sampleRing_;
+    DbSampleReceiver* sampleReceiver_;
+    AudioLevelSource* audioSource_;
+    ExposureLogger* exposureLogger_;
+    DbTraceWriter* traceWriter_;
+    MqttClient* mqttClient_;
+    FileDataSource* fileSource_;
+    SyncClock* syncClock_;
+    SyncNode* syncNode_;
     
     // Feature apps
     DbMeterApp* dbMeterApp_;
     YoutubeApp* youtubeApp_;
     SpotifyApp* spotifyApp_;
+    SpectrumApp* spectrumApp_;
+    TextApp* textApp_;
+    DmxApp* dmxApp_;
+    AnimationApp* animationApp_;
     
     // State
     bool isRunning_;
     std::string currentApp_;
     int brightnessLevel_;
+    std::vector<std::string> controlLines_;  // Reused between polls
+    std::vector<KeyEvent> keyEvents_;        // Reused between polls
+    std::vector<std::string> editedLines_;   // Lines finished in the line editor
     
     // Helper methods
-    void setupMatrixOptions(RGBMatrix::Options& options, RuntimeOptions& runtimeOpt);
+    bool initializeHub();
+    bool initializeSampleInput();
+    bool initializeMqtt();
+    bool initializeDataFile();
+    bool initializeSync();
+    void handleFileValue(const StringRef& key, const StringRef& value);
+    void applyLevelText(const char* payload, size_t payloadSize, int channel);
+    void runHubOnly();
     void printMainMenu();
+    bool handleInputLine(const std::string& line);
+    bool handleKeys();
+    bool handleKey(const KeyEvent& key);
+    void sendKeyToApp(const KeyEvent& key);
+    bool waitForFrame(int delayMs);
+    bool handleValueUpdate(const std::string& line);
     void handleCommand(const std::string& command);
     void switchToApp(const std::string& appName);
     void cleanupCurrentApp();
@@ -0,0 +1,326 @@
+#include "audio_level_source.h"
+#include "shared/dsp/level_kernels.h"
+#include "infrastructure/config/config.h"
+#include "shared/utils/monotonic_clock.h"
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+
+namespace {
+
+long long threadCpuNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+} // namespace
+
+AudioLevelSource::AudioLevelSource(const std::string& spec, int rawSampleRate, int rawChannels, DbSampleRing* ring)
+    : source_(spec, rawSampleRate, rawChannels), ring_(ring),
+      windowMs_(Config::DEFAULT_AUDIO_WINDOW_MS), calibrationDb_(Config::DEFAULT_AUDIO_CALIBRATION_DB),
+      weighting_(FrequencyWeighting::WEIGHTING_A), timeWeighting_(LevelBallistics::MODE_FAST), running_(false), ended_(false), startedAtMs_(0),
+      windowFrames_(1), windowFill_(0),
+      spectrum_(SpectrumAnalyzer::DEFAULT_FFT_SIZE, Config::SPECTRUM_COLUMNS), spectrumEnabled_(false),
+      beatEnabled_(false), frameCount_(0), windowCount_(0), cpuNs_(0), resetRequested_(false), hasMetrics_(false), spectrumSequence_(0) {
+    std::memset(windowSum_, 0, sizeof(windowSum_));
+    std::memset(windowMax_, 0, sizeof(windowMax_));
+    std::memset(spectrumColumns_, 0, sizeof(spectrumColumns_));
+    std::memset(publishedSpectrum_, 0, sizeof(publishedSpectrum_));
+}
+
+AudioLevelSource::~AudioLevelSource() {
+    stop();
+}
+
+void AudioLevelSource::setWindowMs(int windowMs) {
+    if (windowMs > 0) {
+        windowMs_ = windowMs;
+    }
+}
+
+void AudioLevelSource::setCalibrationDb(double calibrationDb) {
+    calibrationDb_ = calibrationDb;
+}
+
+void AudioLevelSource::setWeighting(FrequencyWeighting::Type weighting) {
+    weighting_ = weighting;
+}
+
+void AudioLevelSource::setTimeWeighting(LevelBallistics::Mode mode) {
+    timeWeighting_ = mode;
+}
+
+bool AudioLevelSource::getMetrics(LevelMetrics& out) const {
+    std::lock_guard<std::mutex> lock(metricsMutex_);
+    out = metrics_;
+    return hasMetrics_;
+}
+
+void AudioLevelSource::resetMetrics() {
+    // The integrator belongs to the capture thread; it resets at the next block
+    resetRequested_ = true;
+}
+
+void AudioLevelSource::setSpectrumEnabled(bool enabled) {
+    spectrumEnabled_ = enabled;
+}
+
+unsigned long AudioLevelSource::getSpectrum(float* columnsDb) const {
+    std::lock_guard<std::mutex> lock(spectrumMutex_);
+    std::memcpy(columnsDb, publishedSpectrum_, sizeof(publishedSpectrum_));
+    return spectrumSequence_;
+}
+
+void AudioLevelSource::setBeatTrackingEnabled(bool enabled) {
+    beatEnabled_ = enabled;
+}
+
+bool AudioLevelSource::getBeatState(BeatState& out) const {
+    std::lock_guard<std::mutex> lock(beatMutex_);
+    out = beatState_;
+    return beatState_.beats > 0;
+}
+
+bool AudioLevelSource::start() {
+    if (running_) {
+        return true;
+    }
+    if (!ring_) {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        lastError_ = "No sample ring";
+        return false;
+    }
+    if (!source_.open()) {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        lastError_ = source_.getLastError();
+        return false;
+    }
+
+    windowFrames_ = (size_t)source_.getSampleRate() * windowMs_ / 1000;
+    if (windowFrames_ == 0) {
+        windowFrames_ = 1;
+    }
+    windowFill_ = 0;
+    std::memset(windowSum_, 0, sizeof(windowSum_));
+    std::memset(windowMax_, 0, sizeof(windowMax_));
+
+    double sampleRate = source_.getSampleRate();
+    for (int c = 0; c < source_.getChannels(); c++) {
+        FrequencyWeighting::design(weighting_, sampleRate, weightingFilters_[c]);
+        ballistics_[c].setMode(timeWeighting_);
+        ballistics_[c].prepare(sampleRate);
+        ballistics_[c].reset();
+    }
+    FrequencyWeighting::design(FrequencyWeighting::WEIGHTING_C, sampleRate, peakFilter_);
+    integrator_.reset();
+    spectrum_.prepare(sampleRate, Config::SPECTRUM_RATE);
+    spectrum_.setCalibrationDb(calibrationDb_);
+    beatTracker_.prepare(sampleRate);
+
+    ended_ = false;
+    startedAtMs_ = MonotonicClock::nowMs();
+    running_ = true;
+    captureThread_ = std::thread(&AudioLevelSource::captureLoop, this);
+
+    std::cout << "🎤 Audio input " << source_.getSpec() << ": " << source_.getSampleRate() << " Hz, "
+              << source_.getChannels() << " ch, " << windowMs_ << " ms windows, "
+              << FrequencyWeighting::letter(weighting_) << "-weighted, time weighting "
+              << LevelBallistics::letter(timeWeighting_) << std::endl;
+    return true;
+}
+
+void AudioLevelSource::stop() {
+    if (!running_) {
+        return;
+    }
+
+    // The capture thread wakes at least every PcmSource read timeout
+    running_ = false;
+    if (captureThread_.joinable()) {
+        captureThread_.join();
+    }
+    source_.close();
+}
+
+void AudioLevelSource::captureLoop() {
+    long long cpuStart = threadCpuNs();
+    long long pacingStartMs = MonotonicClock::nowMs();
+    unsigned long long pacedFrames = 0;
+
+    while (running_) {
+        long frames = source_.readFrames(pcm_, BLOCK_FRAMES);
+        if (frames < 0) {
+            std::string error = source_.getLastError();
+            {
+                std::lock_guard<std::mutex> lock(errorMutex_);
+                lastError_ = error;
+            }
+            ended_ = true;
+            std::cout << "🎤 Audio input stopped: " << error << std::endl;
+            break;
+        }
+        if (frames == 0) {
+            continue;
+        }
+
+        if (resetRequested_.exchange(false)) {
+            integrator_.reset();
+        }
+        processBlock((size_t)frames);
+        frameCount_.fetch_add((unsigned long long)frames, std::memory_order_relaxed);
+        cpuNs_.store(threadCpuNs() - cpuStart, std::memory_order_relaxed);
+
+        // Files arrive instantly; release them at the rate they were recorded
+        if (!source_.isRealtime()) {
+            pacedFrames += (unsigned long long)frames;
+            long long dueMs = pacingStartMs + (long long)(pacedFrames * 1000 / source_.getSampleRate());
+            long long waitMs = dueMs - MonotonicClock::nowMs();
+            if (waitMs > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(waitMs));
+            }
+        }
+    }
+}
+
+void AudioLevelSource::processBlock(size_t frames) {
+    int channels = source_.getChannels();
+    size_t offset = 0;
+
+    // Split the block at window boundaries
+    while (offset < frames) {
+        size_t segment = windowFrames_ - windowFill_;
+        if (segment > frames - offset) {
+            segment = frames - offset;
+        }
+
+        const int16_t* pcm = pcm_ + offset * channels;
+        for (int c = 0; c < channels; c++) {
+            LevelKernels::deinterleaveToFloat(pcm, segment, channels, c, plane_);
+
+            if (c == 0 && spectrumEnabled_.load(std::memory_order_relaxed) &&
+                spectrum_.process(plane_, segment, spectrumColumns_) > 0) {
+                std::lock_guard<std::mutex> lock(spectrumMutex_);
+                std::memcpy(publishedSpectrum_, spectrumColumns_, sizeof(publishedSpectrum_));
+                spectrumSequence_++;
+            }
+            if (c == 0 && beatEnabled_.load(std::memory_order_relaxed) &&
+                beatTracker_.process(plane_, segment) > 0) {
+                publishBeat(frames - offset - segment);
+            }
+
+            const float* level = plane_;
+            if (weightingFilters_[c].getSectionCount() > 0) {
+                weightingFilters_[c].process(plane_, weighted_, segment);
+                level = weighted_;
+            }
+            windowSum_[c] += LevelKernels::sumSquares(level, segment);
+            double timeWeighted = ballistics_[c].processBlock(level, segment);
+            if (timeWeighted > windowMax_[c]) {
+                windowMax_[c] = timeWeighted;
+            }
+
+            if (c == 0) {
+                // Lpeak is C-weighted whatever the display weighting is
+                if (weighting_ != FrequencyWeighting::WEIGHTING_C) {
+                    peakFilter_.process(plane_, plane_, segment);
+                    level = plane_;
+                }
+                integrator_.addPeak(LevelKernels::peakAbs(level, segment));
+            }
+        }
+
+        offset += segment;
+        windowFill_ += segment;
+        if (windowFill_ == windowFrames_) {
+            emitWindow();
+        }
+    }
+}
+
+void AudioLevelSource::emitWindow() {
+    int channels = source_.getChannels();
+    integrator_.addWindow(windowSum_[0] / windowFrames_, (double)windowFrames_ / source_.getSampleRate());
+    integrator_.addTimeWeighted(windowMax_[0]);
+
+    for (int c = 0; c < channels; c++) {
+        double db = LevelKernels::meanSquareToDb(windowMax_[c], calibrationDb_);
+        long centiDb = (long)(db * 100.0 + 0.5);
+        if (centiDb > Config::MAX_DB_VALUE * 100) {
+            centiDb = Config::MAX_DB_VALUE * 100;
+        }
+        levels_[c] = DbSample((uint16_t)centiDb, (uint8_t)c);
+        windowSum_[c] = 0.0;
+        windowMax_[c] = 0.0;
+    }
+
+    ring_->pushBatch(levels_, (size_t)channels);
+    windowFill_ = 0;
+    windowCount_.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(metricsMutex_);
+    integrator_.getMetrics(calibrationDb_, metrics_);
+    metrics_.weighting = FrequencyWeighting::letter(weighting_);
+    metrics_.timeWeighting = LevelBallistics::letter(timeWeighting_);
+    hasMetrics_ = true;
+}
+
+void AudioLevelSource::publishBeat(size_t framesAfter) {
+    // The block has just been read, so its last frame is about now
+    unsigned long long ago = beatTracker_.getSamplesSinceBeat() + framesAfter;
+    long long agoMs = (long long)(ago * 1000 / (unsigned long long)source_.getSampleRate());
+
+    std::lock_guard<std::mutex> lock(beatMutex_);
+    beatState_.lastBeatMs = MonotonicClock::nowMs() - agoMs;
+    beatState_.bpm = beatTracker_.getTempoBpm();
+    beatState_.confidence = beatTracker_.getConfidence();
+    beatState_.beats = beatTracker_.getBeatCount();
+}
+
+std::string AudioLevelSource::getLastError() const {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    return lastError_;
+}
+
+void AudioLevelSource::printReport(std::ostream& out) const {
+    double seconds = (MonotonicClock::nowMs() - startedAtMs_) / 1000.0;
+    double cpuSeconds = cpuNs_.load() / 1e9;
+
+    out << "\033[1;36m🎤 Audio input " << source_.getSpec() << "\033[0m" << std::endl;
+    out << "  format:   " << source_.getSampleRate() << " Hz, " << source_.getChannels() << " ch, "
+        << windowMs_ << " ms windows, " << FrequencyWeighting::letter(weighting_)
+        << "-weighted, time weighting " << LevelBallistics::letter(timeWeighting_) << ", calibration " << calibrationDb_ << " dB" << std::endl;
+    out << "  progress: " << frameCount_.load() << " frames, " << windowCount_.load() << " windows"
+        << (ended_ ? " (input ended)" : "") << std::endl;
+    if (seconds > 0) {
+        out << "  cpu:      " << (100.0 * cpuSeconds / seconds) << "% of one core" << std::endl;
+    }
+    out << "  ring:     " << ring_->getDroppedCount() << " levels dropped when full" << std::endl;
+
+    LevelMetrics metrics;
+    if (getMetrics(metrics)) {
+        char w = metrics.weighting;
+        out.setf(std::ios::fixed);
+        out.precision(1);
+        out << "  levels:   L" << w << "eq 1m " << metrics.leq1m << ", 15m " << metrics.leq15m
+            << ", 1h " << metrics.leq1h << ", L" << w << metrics.timeWeighting << "max " << metrics.lmax
+            << ", LCpeak " << metrics.lpeak << " dB" << std::endl;
+        out.unsetf(std::ios::fixed);
+        out.precision(6);
+    }
+
+    BeatState beat;
+    if (beatEnabled_ && getBeatState(beat)) {
+        out << "  beat:     " << beat.beats << " beats, ";
+        if (beat.bpm > 0.0) {
+            out.setf(std::ios::fixed);
+            out.precision(1);
+            out << "tempo " << beat.bpm << " BPM (confidence " << beat.confidence << ")" << std::endl;
+            out.unsetf(std::ios::fixed);
+            out.precision(6);
+        } else {
+            out << "no steady tempo" << std::endl;
+        }
+    }
+}
@@ -0,0 +1,135 @@
+#ifndef AUDIO_LEVEL_SOURCE_H
+#define AUDIO_LEVEL_SOURCE_H
+
+#include "infrastructure/audio/pcm_source.h"
+#include "shared/utils/db_sample.h"
+#include "shared/dsp/biquad_cascade.h"
+#include "shared/dsp/frequency_weighting.h"
+#include "shared/dsp/level_integrator.h"
+#include "shared/dsp/level_ballistics.h"
+#include "shared/dsp/spectrum_analyzer.h"
+#include "shared/dsp/beat_tracker.h"
+#include "infrastructure/config/config.h"
+#include <ostream>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
+
+// Turns PCM input into dB SPL readings for the dB meter.
+//
+// A capture thread reads blocks from a PcmSource, applies the frequency
+// weighting and the Fast/Slow/Impulse time weighting sample by sample, and
+// pushes one DbSample per channel and window into the ring (owned by the
+// caller), exactly like the UDP receiver does. Each sample carries the
+// highest time-weighted level of its window, so the display needs no
+// smoothing of its own. dB SPL = 10*log10(mean square) + calibration, where
+// the calibration is the SPL that a full-scale RMS signal (0 dBFS)
+// represents. Channel 0 also feeds Leq/Lmax/Lpeak integrators whose latest
+// values are published once per window, and, while enabled, the spectrum
+// analyzer (unweighted, Config::SPECTRUM_RATE spectra per second) and the
+// beat tracker. Buffers are fixed, so the loop never allocates; regular
+// files are paced to real time.
+class AudioLevelSource {
+public:
+    AudioLevelSource(const std::string& spec, int rawSampleRate, int rawChannels, DbSampleRing* ring);
+    ~AudioLevelSource();
+
+    // Configuration (before start)
+    void setWindowMs(int windowMs);
+    void setCalibrationDb(double calibrationDb);
+    void setWeighting(FrequencyWeighting::Type weighting);
+    void setTimeWeighting(LevelBallistics::Mode mode);
+
+    // Lifecycle
+    bool start();
+    void stop();
+
+    // Integrated levels of channel 0; false until the first window
+    bool getMetrics(LevelMetrics& out) const;
+    void resetMetrics();
+
+    // Spectrum of channel 0 for the spectrum app; only computed while
+    // enabled. getSpectrum copies the latest Config::SPECTRUM_COLUMNS band
+    // levels and returns their sequence number (0 before the first).
+    void setSpectrumEnabled(bool enabled);
+    unsigned long getSpectrum(float* columnsDb) const;
+
+    // Beats of channel 0 for --beat-border; only tracked while enabled.
+    // getBeatState copies the latest beat and returns false before the
+    // first.
+    void setBeatTrackingEnabled(bool enabled);
+    bool getBeatState(BeatState& out) const;
+
+    // Diagnostics
+    void printReport(std::ostream& out) const;
+    std::string getLastError() const;
+
+    static const size_t BLOCK_FRAMES = 1024;
+
+private:
+    PcmSource source_;
+    DbSampleRing* ring_;
+    int windowMs_;
+    double calibrationDb_;
+    FrequencyWeighting::Type weighting_;
+    LevelBallistics::Mode timeWeighting_;
+    std::string lastError_;  // Also set by the capture thread when input ends
+    mutable std::mutex errorMutex_;
+
+    std::thread captureThread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> ended_;
+    long long startedAtMs_;
+
+    // Capture thread state
+    int16_t pcm_[BLOCK_FRAMES * PcmSource::MAX_CHANNELS];
+    float plane_[BLOCK_FRAMES];
+    float weighted_[BLOCK_FRAMES];
+    BiquadCascade weightingFilters_[PcmSource::MAX_CHANNELS];
+    BiquadCascade peakFilter_;  // C weighting for Lpeak
+    LevelBallistics ballistics_[PcmSource::MAX_CHANNELS];
+    LevelIntegrator integrator_;
+    double windowSum_[PcmSource::MAX_CHANNELS];
+    double windowMax_[PcmSource::MAX_CHANNELS];  // Highest time-weighted mean square
+    size_t windowFrames_;
+    size_t windowFill_;
+    DbSample levels_[PcmSource::MAX_CHANNELS];
+    SpectrumAnalyzer spectrum_;
+    float spectrumColumns_[Config::SPECTRUM_COLUMNS];
+    std::atomic<bool> spectrumEnabled_;
+    BeatTracker beatTracker_;
+    std::atomic<bool> beatEnabled_;
+
+    std::atomic<unsigned long long> frameCount_;
+    std::atomic<unsigned long> windowCount_;
+    std::atomic<long long> cpuNs_;
+    std::atomic<bool> resetRequested_;
+
+    // Published integrator results
+    mutable std::mutex metricsMutex_;
+    LevelMetrics metrics_;
+    bool hasMetrics_;
+
+    // Published spectrum
+    mutable std::mutex spectrumMutex_;
+    float publishedSpectrum_[Config::SPECTRUM_COLUMNS];
+    unsigned long spectrumSequence_;
+
+    // Published beat
+    mutable std::mutex beatMutex_;
+    BeatState beatState_;
+
+    // Helper methods
+    void captureLoop();
+    void processBlock(size_t frames);
+    void emitWindow();
+    void publishBeat(size_t framesAfter);
+
+    // Disable copy constructor and assignment operator
+    AudioLevelSource(const AudioLevelSource&) = delete;
+    AudioLevelSource& operator=(const AudioLevelSource&) = delete;
+};
+
+#endif // AUDIO_LEVEL_SOURCE_H
@@ -0,0 +1,268 @@
+#include "pcm_source.h"
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+
+#ifdef HAVE_ALSA
+#include <alsa/asoundlib.h>
+#endif
+
+namespace {
+
+const int READ_TIMEOUT_MS = 200;
+
+uint32_t readLittleEndian(const uint8_t* p, int bytes) {
+    uint32_t value = 0;
+    for (int i = bytes - 1; i >= 0; i--) {
+        value = (value << 8) | p[i];
+    }
+    return value;
+}
+
+} // namespace
+
+PcmSource::PcmSource(const std::string& spec, int rawSampleRate, int rawChannels)
+    : spec_(spec), sampleRate_(rawSampleRate), channels_(rawChannels), realtime_(false),
+      fd_(-1), alsaHandle_(nullptr), pendingSize_(0) {
+}
+
+PcmSource::~PcmSource() {
+    close();
+}
+
+bool PcmSource::open() {
+    close();
+    if (channels_ < 1 || channels_ > MAX_CHANNELS || sampleRate_ <= 0) {
+        lastError_ = "Unsupported format: " + std::to_string(sampleRate_) + " Hz, " +
+                     std::to_string(channels_) + " channels";
+        return false;
+    }
+
+    if (spec_.compare(0, 5, "alsa:") == 0) {
+        return openAlsa(spec_.substr(5));
+    }
+    return openFile();
+}
+
+void PcmSource::close() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+#ifdef HAVE_ALSA
+    if (alsaHandle_) {
+        snd_pcm_close(static_cast<snd_pcm_t*>(alsaHandle_));
+        alsaHandle_ = nullptr;
+    }
+#endif
+    pendingSize_ = 0;
+}
+
+bool PcmSource::isOpen() const {
+    return fd_ >= 0 || alsaHandle_ != nullptr;
+}
+
+bool PcmSource::openFile() {
+    fd_ = ::open(spec_.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        lastError_ = "Cannot open " + spec_ + ": " + std::strerror(errno);
+        return false;
+    }
+
+    struct stat info;
+    realtime_ = fstat(fd_, &info) == 0 && !S_ISREG(info.st_mode);
+
+    // WAV files carry their own format; anything else is raw s16le and the
+    // probed bytes are the first samples
+    uint8_t magic[4];
+    if (!readExact(magic, sizeof(magic))) {
+        close();
+        return false;
+    }
+    if (std::memcmp(magic, "RIFF", 4) != 0) {
+        std::memcpy(pending_, magic, sizeof(magic));
+        pendingSize_ = sizeof(magic);
+        return true;
+    }
+
+    if (!parseWavHeader()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool PcmSource::parseWavHeader() {
+    // "RIFF" was consumed; the rest is read sequentially so pipes work too
+    uint8_t header[8];
+    if (!readExact(header, 8) || std::memcmp(header + 4, "WAVE", 4) != 0) {
+        lastError_ = spec_ + " is not a WAV file";
+        return false;
+    }
+
+    bool haveFormat = false;
+    while (readExact(header, 8)) {
+        uint32_t size = readLittleEndian(header + 4, 4);
+        size_t padded = (size_t)size + (size & 1);
+
+        if (std::memcmp(header, "fmt ", 4) == 0) {
+            uint8_t format[16];
+            if (size < sizeof(format) || !readExact(format, sizeof(format)) ||
+                !skipBytes(padded - sizeof(format))) {
+                lastError_ = "Truncated WAV format chunk";
+                return false;
+            }
+            uint32_t tag = readLittleEndian(format, 2);
+            int bits = (int)readLittleEndian(format + 14, 2);
+            channels_ = (int)readLittleEndian(format + 2, 2);
+            sampleRate_ = (int)readLittleEndian(format + 4, 4);
+            if ((tag != 1 && tag != 0xFFFE) || bits != 16 || channels_ < 1 ||
+                channels_ > MAX_CHANNELS || sampleRate_ <= 0) {
+                lastError_ = "Only 16-bit PCM WAV with 1-" + std::to_string(MAX_CHANNELS) + " channels is supported";
+                return false;
+            }
+            haveFormat = true;
+        } else if (std::memcmp(header, "data", 4) == 0) {
+            if (!haveFormat) {
+                lastError_ = "WAV data chunk before format chunk";
+                return false;
+            }
+            return true;
+        } else if (!skipBytes(padded)) {
+            break;
+        }
+    }
+
+    lastError_ = spec_ + " has no WAV data chunk";
+    return false;
+}
+
+bool PcmSource::readExact(uint8_t* out, size_t size) {
+    size_t have = 0;
+    while (have < size) {
+        ssize_t n = read(fd_, out + have, size - have);
+        if (n > 0) {
+            have += (size_t)n;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            lastError_ = n == 0 ? spec_ + " ended early" : std::string("read: ") + std::strerror(errno);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PcmSource::skipBytes(size_t size) {
+    uint8_t scratch[256];
+    while (size > 0) {
+        size_t chunk = size < sizeof(scratch) ? size : sizeof(scratch);
+        if (!readExact(scratch, chunk)) {
+            return false;
+        }
+        size -= chunk;
+    }
+    return true;
+}
+
+long PcmSource::readFrames(int16_t* out, size_t maxFrames) {
+#ifdef HAVE_ALSA
+    if (alsaHandle_) {
+        snd_pcm_t* pcm = static_cast<snd_pcm_t*>(alsaHandle_);
+        int ready = snd_pcm_wait(pcm, READ_TIMEOUT_MS);
+        if (ready == 0) {
+            return 0;
+        }
+        snd_pcm_sframes_t frames = ready > 0 ? snd_pcm_readi(pcm, out, maxFrames) : ready;
+        if (frames < 0) {
+            // Overruns happen if the capture thread is starved; recover and go on
+            int err = snd_pcm_recover(pcm, (int)frames, 1);
+            if (err < 0) {
+                lastError_ = std::string("ALSA: ") + snd_strerror(err);
+                return -1;
+            }
+            return 0;
+        }
+        return (long)frames;
+    }
+#endif
+    if (fd_ < 0 || maxFrames == 0) {
+        return -1;
+    }
+
+    size_t frameBytes = (size_t)channels_ * 2;
+    uint8_t* dst = reinterpret_cast<uint8_t*>(out);
+    size_t capacity = maxFrames * frameBytes;
+    size_t have = pendingSize_ < capacity ? pendingSize_ : capacity;
+    std::memcpy(dst, pending_, have);
+    pendingSize_ = 0;
+
+    // Wait briefly so the caller can notice a stop request on an idle pipe
+    while (have < frameBytes) {
+        struct pollfd pfd;
+        pfd.fd = fd_;
+        pfd.events = POLLIN;
+        int ready = poll(&pfd, 1, READ_TIMEOUT_MS);
+        if (ready == 0) {
+            break;
+        }
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            lastError_ = std::string("poll: ") + std::strerror(errno);
+            return -1;
+        }
+
+        ssize_t n = read(fd_, dst + have, capacity - have);
+        if (n == 0) {
+            lastError_ = "End of input";
+            return -1;
+        }
+        if (n < 0) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            lastError_ = std::string("read: ") + std::strerror(errno);
+            return -1;
+        }
+        have += (size_t)n;
+    }
+
+    // Keep a trailing partial frame for the next call (16-bit little-endian
+    // hosts only, which covers the Pi and x86)
+    size_t frames = have / frameBytes;
+    pendingSize_ = have - frames * frameBytes;
+    std::memcpy(pending_, dst + frames * frameBytes, pendingSize_);
+    return (long)frames;
+}
+
+bool PcmSource::openAlsa(const std::string& device) {
+#ifdef HAVE_ALSA
+    snd_pcm_t* pcm = nullptr;
+    int err = snd_pcm_open(&pcm, device.c_str(), SND_PCM_STREAM_CAPTURE, 0);
+    if (err < 0) {
+        lastError_ = "Cannot open ALSA device " + device + ": " + snd_strerror(err);
+        return false;
+    }
+
+    // 100 ms of device buffering absorbs scheduling hiccups on the Pi
+    err = snd_pcm_set_params(pcm, SND_PCM_FORMAT_S16_LE, SND_PCM_ACCESS_RW_INTERLEAVED,
+                             (unsigned int)channels_, (unsigned int)sampleRate_, 1, 100000);
+    if (err < 0) {
+        lastError_ = "Cannot configure ALSA device " + device + ": " + snd_strerror(err);
+        snd_pcm_close(pcm);
+        return false;
+    }
+
+    alsaHandle_ = pcm;
+    realtime_ = true;
+    return true;
+#else
+    lastError_ = "Built without ALSA support (rebuild with ALSA=1), cannot open " + device;
+    return false;
+#endif
+}
@@ -0,0 +1,64 @@
+#ifndef PCM_SOURCE_H
+#define PCM_SOURCE_H
+
+#include <string>
+#include <stddef.h>
+#include <stdint.h>
+
+// Interleaved 16-bit PCM input from one of:
+//
+//   "alsa:<device>"  ALSA capture, e.g. "alsa:hw:1,0" (needs HAVE_ALSA)
+//   "-"              stdin, e.g. `arecord -f S16_LE ... | led_matrix_apps --audio -`
+//   <path>           WAV file or FIFO, or headerless s16le if it has no RIFF header
+//
+// Raw input has no header, so its rate and channel count come from the
+// constructor. Devices and pipes deliver audio in real time; regular files
+// don't, and the caller paces them (see isRealtime()).
+class PcmSource {
+public:
+    PcmSource(const std::string& spec, int rawSampleRate, int rawChannels);
+    ~PcmSource();
+
+    bool open();
+    void close();
+    bool isOpen() const;
+
+    // Reads up to maxFrames whole frames into `out` (maxFrames * channels
+    // samples). Returns the frame count, 0 at end of input, -1 on error.
+    long readFrames(int16_t* out, size_t maxFrames);
+
+    int getSampleRate() const { return sampleRate_; }
+    int getChannels() const { return channels_; }
+    bool isRealtime() const { return realtime_; }
+    const std::string& getSpec() const { return spec_; }
+    std::string getLastError() const { return lastError_; }
+
+    static const int MAX_CHANNELS = 8;
+
+private:
+    std::string spec_;
+    int sampleRate_;
+    int channels_;
+    bool realtime_;
+    int fd_;
+    void* alsaHandle_;  // snd_pcm_t*, only with HAVE_ALSA
+    std::string lastError_;
+
+    // Bytes read past the last whole frame (pipes may split frames) or
+    // probed while looking for a WAV header
+    uint8_t pending_[4 * MAX_CHANNELS];
+    size_t pendingSize_;
+
+    // Helper methods
+    bool openFile();
+    bool openAlsa(const std::string& device);
+    bool parseWavHeader();
+    bool readExact(uint8_t* out, size_t size);
+    bool skipBytes(size_t size);
+
+    // Disable copy constructor and assignment operator
+    PcmSource(const PcmSource&) = delete;
+    PcmSource& operator=(const PcmSource&) = delete;
+};
+
+#endif // PCM_SOURCE_H
@@ -4,7 +4,12 @@
 #include <cstring>
 
 ArgParser::ArgParser(int argc, char* argv[]) 
-    : brightness_(Config::DEFAULT_BRIGHTNESS), showHelp_(false) {
+    : brightness_(Config::DEFAULT_BRIGHTNESS), showHelp_(false),
+      websubPort_(Config::DEFAULT_WEBSUB_PORT), hubListenPort_(0), hubOnly_(false),
+      samplePort_(0), audioSampleRate_(Config::DEFAULT_AUDIO_SAMPLE_RATE), audioChannels_(1),
+      audioWindowMs_(Config::DEFAULT_AUDIO_WINDOW_MS), audioCalibrationDb_(Config::DEFAULT_AUDIO_CALIBRATION_DB),
+      audioWeighting_("A"), timeWeighting_("fast"), beatBorder_(false), lineInput_(false), dmxProtocol_("artnet"),
+      syncLeadPort_(0) {
     parseArguments(argc, argv);
 }
 
@@ -24,6 +29,180 @@ void ArgParser::parseArguments(int argc, char* argv[]) {
             } else {
                 std::cerr << "Missing brightness value after -b" << std::endl;
             }
+        } else if (strcmp(argv[i], "--websub-callback") == 0) {
+            if (i + 1 < argc) {
+                websubCallback_ = argv[++i];
+            } else {
+                std::cerr << "Missing URL after --websub-callback" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--websub-port") == 0) {
+            if (i + 1 < argc) {
+                websubPort_ = std::atoi(argv[++i]);
+            } else {
+                std::cerr << "Missing port after --websub-port" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--websub-hub") == 0) {
+            if (i + 1 < argc) {
+                websubHub_ = argv[++i];
+            } else {
+                std::cerr << "Missing URL after --websub-hub" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--hub-listen") == 0) {
+            if (i + 1 < argc) {
+                hubListenPort_ = std::atoi(argv[++i]);
+            } else {
+                std::cerr << "Missing port after --hub-listen" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--hub-connect") == 0) {
+            if (i + 1 < argc) {
+                hubConnect_ = argv[++i];
+            } else {
+                std::cerr << "Missing address after --hub-connect" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--hub-youtube") == 0) {
+            if (i + 1 < argc) {
+                hubYouTubeChannels_ = splitList(argv[++i]);
+            } else {
+                std::cerr << "Missing channel list after --hub-youtube" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--hub-spotify") == 0) {
+            if (i + 1 < argc) {
+                hubSpotifyArtists_ = splitList(argv[++i]);
+            } else {
+                std::cerr << "Missing artist list after --hub-spotify" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--hub-only") == 0) {
+            hubOnly_ = true;
+        } else if (strcmp(argv[i], "--control-socket") == 0) {
+            if (i + 1 < argc) {
+                controlSocketPath_ = argv[++i];
+            } else {
+                std::cerr << "Missing path after --control-socket" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--sample-port") == 0) {
+            if (i + 1 < argc) {
+                samplePort_ = std::atoi(argv[++i]);
+            } else {
+                std::cerr << "Missing port after --sample-port" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--audio") == 0) {
+            if (i + 1 < argc) {
+                audioSpec_ = argv[++i];
+            } else {
+                std::cerr << "Missing source after --audio" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--audio-rate") == 0) {
+            if (i + 1 < argc) {
+                audioSampleRate_ = std::atoi(argv[++i]);
+            } else {
+                std::cerr << "Missing sample rate after --audio-rate" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--audio-channels") == 0) {
+            if (i + 1 < argc) {
+                audioChannels_ = std::atoi(argv[++i]);
+            } else {
+                std::cerr << "Missing channel count after --audio-channels" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--audio-window") == 0) {
+            if (i + 1 < argc) {
+                audioWindowMs_ = std::atoi(argv[++i]);
+            } else {
+                std::cerr << "Missing milliseconds after --audio-window" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--audio-calibration") == 0) {
+            if (i + 1 < argc) {
+                audioCalibrationDb_ = std::atof(argv[++i]);
+            } else {
+                std::cerr << "Missing dB value after --audio-calibration" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--audio-weighting") == 0) {
+            if (i + 1 < argc) {
+                audioWeighting_ = argv[++i];
+            } else {
+                std::cerr << "Missing A, C or Z after --audio-weighting" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--time-weighting") == 0) {
+            if (i + 1 < argc) {
+                timeWeighting_ = argv[++i];
+            } else {
+                std::cerr << "Missing fast, slow or impulse after --time-weighting" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--channel-thresholds") == 0) {
+            if (i + 1 < argc) {
+                channelThresholds_ = splitList(argv[++i]);
+            } else {
+                std::cerr << "Missing threshold list after --channel-thresholds" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--exposure-log") == 0) {
+            if (i + 1 < argc) {
+                exposureLogDirectory_ = argv[++i];
+            } else {
+                std::cerr << "Missing directory after --exposure-log" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--record-trace") == 0) {
+            if (i + 1 < argc) {
+                traceFile_ = argv[++i];
+            } else {
+                std::cerr << "Missing file after --record-trace" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--beat-border") == 0) {
+            beatBorder_ = true;
+        } else if (strcmp(argv[i], "--line-input") == 0) {
+            lineInput_ = true;
+        } else if (strcmp(argv[i], "--mqtt") == 0) {
+            if (i + 1 < argc) {
+                mqttBroker_ = argv[++i];
+            } else {
+                std::cerr << "Missing broker address after --mqtt" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--mqtt-db") == 0) {
+            if (i + 1 < argc) {
+                mqttDbTopics_ = splitList(argv[++i]);
+            } else {
+                std::cerr << "Missing topic list after --mqtt-db" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--mqtt-text") == 0) {
+            if (i + 1 < argc) {
+                mqttTextTopics_ = splitList(argv[++i]);
+            } else {
+                std::cerr << "Missing topic list after --mqtt-text" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--data-file") == 0) {
+            if (i + 1 < argc) {
+                dataFile_ = argv[++i];
+            } else {
+                std::cerr << "Missing file after --data-file" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--dmx") == 0) {
+            if (i + 1 < argc) {
+                dmxProtocol_ = argv[++i];
+            } else {
+                std::cerr << "Missing protocol after --dmx" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--dmx-layout") == 0) {
+            if (i + 1 < argc) {
+                dmxLayout_ = argv[++i];
+            } else {
+                std::cerr << "Missing layout after --dmx-layout" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--animation") == 0) {
+            if (i + 1 < argc) {
+                animationFile_ = argv[++i];
+            } else {
+                std::cerr << "Missing file after --animation" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--sync-lead") == 0) {
+            if (i + 1 < argc) {
+                syncLeadPort_ = std::atoi(argv[++i]);
+            } else {
+                std::cerr << "Missing port after --sync-lead" << std::endl;
+            }
+        } else if (strcmp(argv[i], "--sync-follow") == 0) {
+            if (i + 1 < argc) {
+                syncFollow_ = argv[++i];
+            } else {
+                std::cerr << "Missing address after --sync-follow" << std::endl;
+            }
         } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
             showHelp_ = true;
         } else {
@@ -32,6 +211,20 @@ void ArgParser::parseArguments(int argc, char* argv[]) {
     }
 }
 
+std::vector<std::string> ArgParser::splitList(const std::string& list) {
+    std::vector<std::string> items;
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos) end = list.size();
+        if (end > start) {
+            items.push_back(list.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+    return items;
+}
+
 bool ArgParser::isValidBrightness(int brightness) const {
     return brightness >= Config::MIN_BRIGHTNESS && brightness <= Config::MAX_BRIGHTNESS;
 }
@@ -42,14 +235,63 @@ void ArgParser::printHelp(const char* programName) const {
     std::cout << "Options:\n";
     std::cout << "  -b, --brightness <1-10>  Set brightness level (1=10%, 10=100%)\n";
     std::cout << "                           Default: " << Config::DEFAULT_BRIGHTNESS << " (50%)\n";
+    std::cout << "  --websub-callback <url>  Public URL of this device's WebSub receiver;\n";
+    std::cout << "                           enables push updates for YouTube (polls every 6h)\n";
+    std::cout << "  --websub-port <port>     Port for the WebSub receiver (default: " << Config::DEFAULT_WEBSUB_PORT << ")\n";
+    std::cout << "  --websub-hub <url>       WebSub hub to subscribe with (default: Google's hub)\n";
+    std::cout << "  --hub-listen <port>      Run a stats hub that fetches for a fleet of displays\n";
+    std::cout << "  --hub-youtube <ids>      Comma-separated YouTube channels the hub always fetches\n";
+    std::cout << "  --hub-spotify <ids>      Comma-separated Spotify artists the hub always fetches\n";
+    std::cout << "  --hub-only               Run only the hub (no matrix, no apps)\n";
+    std::cout << "  --hub-connect <host:port> Get YouTube/Spotify stats from a hub instead of the APIs\n";
+    std::cout << "  --control-socket <path>  Accept commands and dB values on a UNIX socket\n";
+    std::cout << "  --sample-port <port>     Receive high-rate binary dB samples over UDP (e.g. 7406)\n";
+    std::cout << "  --audio <source>         Measure dB SPL from audio: alsa:<device>, a WAV file,\n";
+    std::cout << "                           a FIFO, or raw s16le PCM\n";
+    std::cout << "  --audio-rate <hz>        Sample rate for raw PCM and ALSA (default: " << Config::DEFAULT_AUDIO_SAMPLE_RATE << ")\n";
+    std::cout << "  --audio-channels <n>     Channels for raw PCM and ALSA (default: 1)\n";
+    std::cout << "  --audio-window <ms>      RMS window per reading (default: " << Config::DEFAULT_AUDIO_WINDOW_MS << ")\n";
+    std::cout << "  --audio-calibration <dB> dB SPL of a full-scale RMS signal (default: " << Config::DEFAULT_AUDIO_CALIBRATION_DB << ")\n";
+    std::cout << "  --audio-weighting <A|C|Z> Frequency weighting for levels and Leq (default: A)\n";
+    std::cout << "  --time-weighting <mode>  Meter ballistics: fast, slow or impulse (default: fast)\n";
+    std::cout << "  --channel-thresholds <list> Yellow/orange/red dB per channel, comma-separated\n";
+    std::cout << "                           (e.g. 80/90/95,70/80/85; default: 80/90/95)\n";
+    std::cout << "  --exposure-log <dir>     Log per-second Leq/max/min to daily files and track\n";
+    std::cout << "                           OSHA/NIOSH noise dose ('dose' command)\n";
+    std::cout << "  --record-trace <file>    Record every dB reading for tools/db_trace_replay\n";
+    std::cout << "  --beat-border            Pulse the dB meter's border on the beats of --audio\n";
+    std::cout << "  --line-input             Read whole lines from the terminal instead of keystrokes\n";
+    std::cout << "  --mqtt <host:port>       Subscribe to an MQTT broker (port 1883 by default;\n";
+    std::cout << "                           MQTT_USERNAME/MQTT_PASSWORD for login)\n";
+    std::cout << "  --mqtt-db <topics>       Topics carrying dB values, comma-separated; topic@N\n";
+    std::cout << "                           feeds meter channel N (wildcards + and # allowed)\n";
+    std::cout << "  --mqtt-text <topics>     Topics whose text the 'text' app shows, comma-separated\n";
+    std::cout << "  --data-file <file>       Reload a JSON or key,value file whenever it's written:\n";
+    std::cout << "                           db/dbN keys feed the meter, other keys the 'text' app\n";
+    std::cout << "  --dmx <artnet|sacn>      Protocol of the 'dmx' app (default: artnet)\n";
+    std::cout << "  --dmx-layout <layout>    first[/pixels per universe][/snake] (default: 0/170 for\n";
+    std::cout << "                           Art-Net, 1/170 for sACN)\n";
+    std::cout << "  --animation <file>       Animation the 'anim' app plays (tools/animation_render)\n";
+    std::cout << "  --sync-lead <port>       Keep other displays in step with this one (e.g. 7407)\n";
+    std::cout << "  --sync-follow <host:port> Blink, rotate texts and swap frames in step with a leader\n";
     std::cout << "  -h, --help              Show this help message\n\n";
     std::cout << "Examples:\n";
     std::cout << "  " << programName << "              # Run with default brightness (50%)\n";
     std::cout << "  " << programName << " -b 8         # Run with 80% brightness\n";
     std::cout << "  " << programName << " -b 1         # Run with 10% brightness (dim)\n";
-    std::cout << "  " << programName << " -b 10        # Run with 100% brightness (bright)\n\n";
+    std::cout << "  " << programName << " -b 10        # Run with 100% brightness (bright)\n";
+    std::cout << "  " << programName << " --hub-listen 7405 --hub-only --hub-youtube @chan  # Headless hub\n";
+    std::cout << "  " << programName << " --hub-connect hub.local:7405  # Display fed by the hub\n";
+    std::cout << "  " << programName << " --control-socket /tmp/ledmatrix.sock  # Scriptable control\n";
+    std::cout << "  " << programName << " --audio alsa:hw:1,0 --audio-calibration 117.5  # Live microphone\n";
+    std::cout << "  " << programName << " --mqtt broker.local --mqtt-db noise/hall@0,noise/stage@1  # Building sensors\n";
+    std::cout << "  " << programName << " --data-file /run/display/values.json  # Values from a script\n";
+    std::cout << "  " << programName << " --dmx sacn --dmx-layout 1/96  # Lighting desk, one row per universe\n";
+    std::cout << "  " << programName << " --animation idle.anim  # Pre-rendered idle screen ('anim')\n";
+    std::cout << "  " << programName << " --sync-follow hall-left.local:7407  # Same room as the leader\n\n";
     std::cout << "Controls:\n";
     std::cout << "  Enter dB values (0-120) and press Enter to update display\n";
+    std::cout << "  'set <dB> [channel]' updates the meter from any app (e.g. via the control socket)\n";
     std::cout << "  Press Ctrl+C to exit\n\n";
     std::cout << "Display Features:\n";
     std::cout << "  - Text shows current dB value\n";
@@ -3,6 +3,7 @@
 
 #include "config.h"
 #include <string>
+#include <vector>
 
 class ArgParser {
 public:
@@ -11,6 +12,37 @@ public:
     // Getters
     int getBrightness() const { return brightness_; }
     bool hasHelp() const { return showHelp_; }
+    const std::string& getWebSubCallback() const { return websubCallback_; }
+    int getWebSubPort() const { return websubPort_; }
+    const std::string& getWebSubHub() const { return websubHub_; }
+    int getHubListenPort() const { return hubListenPort_; }
+    const std::string& getHubConnect() const { return hubConnect_; }
+    const std::vector<std::string>& getHubYouTubeChannels() const { return hubYouTubeChannels_; }
+    const std::vector<std::string>& getHubSpotifyArtists() const { return hubSpotifyArtists_; }
+    bool isHubOnly() const { return hubOnly_; }
+    const std::string& getControlSocketPath() const { return controlSocketPath_; }
+    int getSamplePort() const { return samplePort_; }
+    const std::string& getAudioSpec() const { return audioSpec_; }
+    int getAudioSampleRate() const { return audioSampleRate_; }
+    int getAudioChannels() const { return audioChannels_; }
+    int getAudioWindowMs() const { return audioWindowMs_; }
+    double getAudioCalibrationDb() const { return audioCalibrationDb_; }
+    const std::string& getAudioWeighting() const { return audioWeighting_; }
+    const std::string& getTimeWeighting() const { return timeWeighting_; }
+    const std::vector<std::string>& getChannelThresholds() const { return channelThresholds_; }
+    const std::string& getExposureLogDirectory() const { return exposureLogDirectory_; }
+    const std::string& getTraceFile() const { return traceFile_; }
+    bool isBeatBorder() const { return beatBorder_; }
+    bool isLineInput() const { return lineInput_; }
+    const std::string& getMqttBroker() const { return mqttBroker_; }
+    const std::vector<std::string>& getMqttDbTopics() const { return mqttDbTopics_; }
+    const std::vector<std::string>& getMqttTextTopics() const { return mqttTextTopics_; }
+    const std::string& getDataFile() const { return dataFile_; }
+    const std::string& getDmxProtocol() const { return dmxProtocol_; }
+    const std::string& getDmxLayout() const { return dmxLayout_; }
+    const std::string& getAnimationFile() const { return animationFile_; }
+    int getSyncLeadPort() const { return syncLeadPort_; }
+    const std::string& getSyncFollow() const { return syncFollow_; }
     
     // Display help
     void printHelp(const char* programName) const;
@@ -18,8 +50,40 @@ public:
 private:
     int brightness_;
     bool showHelp_;
+    std::string websubCallback_;
+    int websubPort_;
+    std::string websubHub_;
+    int hubListenPort_;
+    std::string hubConnect_;
+    std::vector<std::string> hubYouTubeChannels_;
+    std::vector<std::string> hubSpotifyArtists_;
+    bool hubOnly_;
+    std::string controlSocketPath_;
+    int samplePort_;
+    std::string audioSpec_;
+    int audioSampleRate_;
+    int audioChannels_;
+    int audioWindowMs_;
+    double audioCalibrationDb_;
+    std::string audioWeighting_;
+    std::string timeWeighting_;
+    std::vector<std::string> channelThresholds_;
+    std::string exposureLogDirectory_;
+    std::string traceFile_;
+    bool beatBorder_;
+    bool lineInput_;
+    std::string mqttBroker_;
+    std::vector<std::string> mqttDbTopics_;
+    std::vector<std::string> mqttTextTopics_;
+    std::string dataFile_;
+    std::string dmxProtocol_;
+    std::string dmxLayout_;
+    std::string animationFile_;
+    int syncLeadPort_;
+    std::string syncFollow_;
     
     void parseArguments(int argc, char* argv[]);
+    static std::vector<std::string> splitList(const std::string& list);
     bool isValidBrightness(int brightness) const;
 };
 
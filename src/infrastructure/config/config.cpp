@@ -1,5 +1,9 @@
 #include "config.h"
 
+// Storage paths
+const std::string Config::METRICS_DIRECTORY = "./data/metrics";
+const std::string Config::ARTWORK_DIRECTORY = "./data/artwork";
+
 // Font paths
 const std::string Config::LARGE_FONT_PATH = "../../fonts/7x13.bdf";
 // const std::string Config::LARGE_FONT_PATH = "../../fonts/texgyre-27.bdf";
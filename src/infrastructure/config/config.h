@@ -10,6 +10,31 @@ public:
     static const int MIN_BRIGHTNESS = 1;      // 10% brightness
     static const int MAX_BRIGHTNESS = 10;     // 100% brightness
     static const int DEFAULT_DB_VALUE = 60;
+    static const int SAMPLE_RING_CAPACITY = 65536;  // Queued dB samples between frames
+    
+    // Audio input
+    static const int DEFAULT_AUDIO_SAMPLE_RATE = 48000;   // Raw PCM / ALSA capture
+    static const int DEFAULT_AUDIO_WINDOW_MS = 50;        // RMS window per reading
+    static const int DEFAULT_AUDIO_CALIBRATION_DB = 120;  // dB SPL of a 0 dBFS RMS signal
+    static const int DB_PAGE_INTERVAL_MS = 4000;          // Live/Leq/Lmax/Lpeak page rotation
+    static const int PEAK_HOLD_MS = 1500;                 // Peak marker holds before falling
+    static const int PEAK_DECAY_DB_PER_SECOND = 20;       // Peak marker fall rate
+    static const int DB_HISTORY_COLUMNS = 96;             // Slices kept for the history graph
+    static const int DB_HISTORY_SLICE_MS = 250;           // One graph column per slice
+    static const int DB_HISTORY_FLOOR_DB = 40;            // Level at the graph's bottom row
+    static const int DB_HISTORY_MIN_ROWS = 4;             // Smaller graphs are not shown
+    static const int SPECTRUM_COLUMNS = 96;               // One log-frequency band per panel column
+    static const int SPECTRUM_RATE = 60;                  // Spectra per second from audio input
+    static const int SPECTRUM_FLOOR_DB = 20;              // Band level at the bottom row
+    static const int SPECTRUM_RANGE_DB = 70;              // Band levels shown above the floor
+    static const int SPECTRUM_FALL_DB_PER_SECOND = 60;    // Bars fall no faster than this
+    static const int BEAT_PULSE_MS = 150;                 // Border fade time constant after a beat
+    static const int BEAT_PULSE_FLOOR_PERCENT = 20;       // Border intensity between beats
+    static const int BEAT_TIMEOUT_MS = 2000;              // Back to blinking when beats stop
+    static const int TEXT_TOPICS = 8;                     // MQTT text topics the text app rotates through
+    static const int TEXT_MAX_LENGTH = 128;               // Longer MQTT texts are cut
+    static const int TEXT_ROTATION_MS = 3000;             // Time per topic in the text app
+    static const int SYNC_TICK_MS = 16;                   // Shared frame tick of displays in sync
     static const int MIN_DB_VALUE = 0;
     static const int MAX_DB_VALUE = 120;
     
@@ -19,6 +44,12 @@ public:
     static const int PROGRESS_BAR_HEIGHT = 2; // height of progress bar
     static const int BORDER_THICKNESS = 4;    // border thickness
     static const int PADDING = 4;             // padding from edges
+    static const int ARTWORK_ICON_SIZE = 16;  // artwork icon edge (pixels)
+    static const int ARTWORK_COLOR_BITS = 5;  // bits per channel after dithering
+    
+    // Storage paths
+    static const std::string METRICS_DIRECTORY;
+    static const std::string ARTWORK_DIRECTORY;
     
     // Font paths
     static const std::string LARGE_FONT_PATH;
@@ -68,6 +99,16 @@ public:
     static const int BLINK_DURATION_SLOW = 500000;
     static const int BLINK_DURATION_MEDIUM = 250000;
     static const int BLINK_DURATION_FAST = 100000;
+    
+    // Background refresh timing (milliseconds)
+    static const int YOUTUBE_REFRESH_INTERVAL_MS = 300000;  // 5 minutes
+    static const int SPOTIFY_REFRESH_INTERVAL_MS = 600000;  // 10 minutes
+    static const int REFRESH_JITTER_MS = 30000;             // +/- 30 seconds
+    static const int YOUTUBE_PUSH_FALLBACK_INTERVAL_MS = 21600000; // 6 hours with WebSub push
+    static const int DEFAULT_WEBSUB_PORT = 8085;
+    
+    // Trend window for "change over last 24h" (seconds)
+    static const int TREND_WINDOW_SECONDS = 86400;
 };
 
 #endif // CONFIG_H
@@ -0,0 +1,69 @@
+#include "dmx_renderer.h"
+#include <cstdlib>
+
+DmxRenderer::DmxRenderer(int width, int height, const Layout& layout)
+    : width_(width), height_(height), layout_(layout), universeCount_(countUniverses(width, height, layout)) {
+    setBrightness(255);
+}
+
+int DmxRenderer::countUniverses(int width, int height, const Layout& layout) {
+    int count = (width * height + layout.pixelsPerUniverse - 1) / layout.pixelsPerUniverse;
+    return count < MAX_UNIVERSES ? count : MAX_UNIVERSES;
+}
+
+bool DmxRenderer::parseLayout(const std::string& spec, Layout& out) {
+    Layout layout = out;
+    const char* p = spec.c_str();
+    char* end = nullptr;
+
+    layout.firstUniverse = (int)std::strtol(p, &end, 10);
+    if (end == p || layout.firstUniverse < 0) {
+        return false;
+    }
+    p = end;
+    if (*p == '/' && p[1] >= '0' && p[1] <= '9') {
+        layout.pixelsPerUniverse = (int)std::strtol(p + 1, &end, 10);
+        p = end;
+    }
+    if (*p == '/') {
+        if (std::string(p + 1) != "snake") {
+            return false;
+        }
+        layout.snake = true;
+        p += 6;
+    }
+    if (*p != '\0' || layout.pixelsPerUniverse < 1 || layout.pixelsPerUniverse > MAX_PIXELS_PER_UNIVERSE) {
+        return false;
+    }
+    out = layout;
+    return true;
+}
+
+void DmxRenderer::setBrightness(int brightnessScale) {
+    for (int i = 0; i < 256; i++) {
+        scale_[i] = (uint8_t)((i * brightnessScale) / 255);
+    }
+}
+
+void DmxRenderer::drawUniverse(Canvas* canvas, int index, const uint8_t* slots, size_t size) const {
+    int first = index * layout_.pixelsPerUniverse;
+    int count = (int)(size / 3);
+    if (count > layout_.pixelsPerUniverse) {
+        count = layout_.pixelsPerUniverse;
+    }
+    if (count > width_ * height_ - first) {
+        count = width_ * height_ - first;
+    }
+
+    // Walk the rows instead of dividing per pixel
+    int x = first % width_;
+    int y = first / width_;
+    for (int i = 0; i < count; i++, slots += 3) {
+        int column = layout_.snake && (y & 1) ? width_ - 1 - x : x;
+        canvas->SetPixel(column, y, scale_[slots[0]], scale_[slots[1]], scale_[slots[2]]);
+        if (++x == width_) {
+            x = 0;
+            y++;
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef DMX_RENDERER_H
+#define DMX_RENDERER_H
+
+#include "led-matrix.h"
+#include <string>
+#include <stddef.h>
+#include <stdint.h>
+
+using namespace rgb_matrix;
+
+// Maps DMX universes onto the pixels of a Canvas, three slots (R, G, B) per
+// pixel. Pixels are numbered row by row from the top left, and universe
+// `firstUniverse + n` carries pixels n * pixelsPerUniverse onwards. With
+// `snake`, every second row runs right to left, like a serpentine-wired
+// LED strip. Slots are written straight from the packet to the canvas
+// through a brightness table; nothing is buffered here.
+class DmxRenderer {
+public:
+    struct Layout {
+        int firstUniverse;
+        int pixelsPerUniverse;   // At most 170 (510 slots)
+        bool snake;
+
+        Layout() : firstUniverse(0), pixelsPerUniverse(MAX_PIXELS_PER_UNIVERSE), snake(false) {}
+    };
+
+    DmxRenderer(int width, int height, const Layout& layout);
+
+    // "<first>[/<pixels per universe>][/snake]", e.g. "1/170/snake" or "0/96"
+    static bool parseLayout(const std::string& spec, Layout& out);
+
+    // Universes needed to cover a canvas, at most MAX_UNIVERSES
+    static int countUniverses(int width, int height, const Layout& layout);
+    int getUniverseCount() const { return universeCount_; }
+    const Layout& getLayout() const { return layout_; }
+
+    // brightnessScale is 0-255
+    void setBrightness(int brightnessScale);
+
+    // Draw one universe's slots; short universes leave the rest untouched
+    void drawUniverse(Canvas* canvas, int index, const uint8_t* slots, size_t size) const;
+
+    static const int MAX_PIXELS_PER_UNIVERSE = 170;
+    static const int MAX_UNIVERSES = 64;
+
+private:
+    int width_;
+    int height_;
+    Layout layout_;
+    int universeCount_;
+    uint8_t scale_[256];
+};
+
+#endif // DMX_RENDERER_H
@@ -0,0 +1,23 @@
+#include "matrix_factory.h"
+
+RGBMatrix* MatrixFactory::create(int brightnessLevel) {
+    RGBMatrix::Options options;
+    RuntimeOptions runtimeOpt;
+    setupOptions(options, runtimeOpt, brightnessLevel);
+    return CreateMatrixFromOptions(options, runtimeOpt);
+}
+
+void MatrixFactory::setupOptions(RGBMatrix::Options& options, RuntimeOptions& runtime_opt, int brightnessLevel) {
+    // Configure matrix to match your working setup
+    options.rows = 48;                    // --led-rows=48
+    options.cols = 96;                    // --led-cols=96
+    options.chain_length = 1;
+    options.parallel = 1;
+    options.hardware_mapping = "regular";
+    options.brightness = brightnessLevel * 10; // Convert 1-10 to 10-100
+    options.disable_hardware_pulsing = true;   // --led-no-hardware-pulse
+    options.pwm_bits = 11;                // --led-pwm-bits=11
+    options.pwm_lsb_nanoseconds = 110;    // --led-pwm-lsb-nanoseconds 130
+    
+    runtime_opt.gpio_slowdown = 4;        // --led-slowdown-gpio=4
+}
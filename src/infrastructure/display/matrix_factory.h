@@ -0,0 +1,18 @@
+#ifndef MATRIX_FACTORY_H
+#define MATRIX_FACTORY_H
+
+#include "led-matrix.h"
+
+using namespace rgb_matrix;
+
+// Creates the RGBMatrix for the panel this project drives, so the apps and
+// the display daemon agree on the hardware settings.
+class MatrixFactory {
+public:
+    // brightnessLevel is 1-10; nullptr if the matrix can't be initialized
+    static RGBMatrix* create(int brightnessLevel);
+
+    static void setupOptions(RGBMatrix::Options& options, RuntimeOptions& runtimeOpt, int brightnessLevel);
+};
+
+#endif // MATRIX_FACTORY_H
@@ -0,0 +1,57 @@
+#include "memory_canvas.h"
+#include <cstdio>
+#include <cstring>
+
+MemoryCanvas::MemoryCanvas(int width, int height)
+    : width_(width), height_(height), pixels_((size_t)width * height * 3, 0) {
+}
+
+void MemoryCanvas::SetPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue) {
+    if (x < 0 || y < 0 || x >= width_ || y >= height_) {
+        return;
+    }
+    uint8_t* pixel = &pixels_[((size_t)y * width_ + x) * 3];
+    pixel[0] = red;
+    pixel[1] = green;
+    pixel[2] = blue;
+}
+
+void MemoryCanvas::Clear() {
+    std::memset(&pixels_[0], 0, pixels_.size());
+}
+
+void MemoryCanvas::Fill(uint8_t red, uint8_t green, uint8_t blue) {
+    for (size_t i = 0; i < pixels_.size(); i += 3) {
+        pixels_[i] = red;
+        pixels_[i + 1] = green;
+        pixels_[i + 2] = blue;
+    }
+}
+
+bool MemoryCanvas::writePpm(const std::string& path, int scale) const {
+    if (scale < 1) {
+        scale = 1;
+    }
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    fprintf(file, "P6\n%d %d\n255\n", width_ * scale, height_ * scale);
+    std::vector<uint8_t> row((size_t)width_ * scale * 3);
+    for (int y = 0; y < height_; y++) {
+        for (int x = 0; x < width_; x++) {
+            const uint8_t* pixel = getPixel(x, y);
+            for (int s = 0; s < scale; s++) {
+                std::memcpy(&row[((size_t)x * scale + s) * 3], pixel, 3);
+            }
+        }
+        for (int s = 0; s < scale; s++) {
+            fwrite(&row[0], 1, row.size(), file);
+        }
+    }
+
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
@@ -0,0 +1,36 @@
+#ifndef MEMORY_CANVAS_H
+#define MEMORY_CANVAS_H
+
+#include "led-matrix.h"
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+using namespace rgb_matrix;
+
+// Canvas backed by an RGB byte array instead of a panel, so renderers that
+// draw on a Canvas can run headless (tools, checks on a desktop machine).
+// Out-of-range pixels are ignored like on the matrix.
+class MemoryCanvas : public Canvas {
+public:
+    MemoryCanvas(int width, int height);
+
+    virtual int width() const { return width_; }
+    virtual int height() const { return height_; }
+    virtual void SetPixel(int x, int y, uint8_t red, uint8_t green, uint8_t blue);
+    virtual void Clear();
+    virtual void Fill(uint8_t red, uint8_t green, uint8_t blue);
+
+    // Packed RGB, row by row from the top
+    const uint8_t* getPixel(int x, int y) const { return &pixels_[((size_t)y * width_ + x) * 3]; }
+
+    // Binary PPM (P6), scaled up by `scale` pixels per LED
+    bool writePpm(const std::string& path, int scale = 1) const;
+
+private:
+    int width_;
+    int height_;
+    std::vector<uint8_t> pixels_;
+};
+
+#endif // MEMORY_CANVAS_H
@@ -0,0 +1,329 @@
+#include "shared_frame_buffer.h"
+#include "shared/utils/monotonic_clock.h"
+#include <atomic>
+#include <climits>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+const char* const SharedFrameBuffer::DEFAULT_NAME = "/led-matrix-frames";
+
+namespace {
+
+// State word: front slot, middle slot, back slot (two bits each) and
+// whether the middle slot holds a frame the daemon hasn't taken yet
+const uint32_t FRESH = 0x40;
+const uint32_t INITIAL_STATE = 0 | (1 << 2) | (2 << 4);
+
+unsigned frontOf(uint32_t state) { return state & 3; }
+unsigned middleOf(uint32_t state) { return (state >> 2) & 3; }
+unsigned backOf(uint32_t state) { return (state >> 4) & 3; }
+
+// Front, middle and back are three different slots and nothing else is set
+bool isValidState(uint32_t state) {
+    unsigned front = frontOf(state);
+    unsigned middle = middleOf(state);
+    unsigned back = backOf(state);
+    return (state & ~(FRESH | 0x3F)) == 0 && front < (unsigned)SharedFrameBuffer::SLOTS &&
+           middle < (unsigned)SharedFrameBuffer::SLOTS && back < (unsigned)SharedFrameBuffer::SLOTS &&
+           front != middle && middle != back && front != back;
+}
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex words must be plain 32-bit integers");
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "shared memory atomics must be lock-free");
+
+} // namespace
+
+struct SharedFrameBuffer::Header {
+    std::atomic<uint32_t> magic;        // Written last by create()
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    std::atomic<uint32_t> state;
+    std::atomic<uint32_t> doorbell;     // Futex word, bumped by every publish
+    std::atomic<uint32_t> published;
+    std::atomic<int32_t> producerPid;
+    long long frameTimeUs[SLOTS];       // Publish time of each slot's frame
+};
+
+SharedFrameBuffer::SharedFrameBuffer(const std::string& name)
+    : name_(name), fd_(-1), mapping_(MAP_FAILED), mappingSize_(0), header_(nullptr), slots_(nullptr),
+      width_(0), height_(0), frameSize_(0), producer_(false), acquired_(0), stateResets_(0) {
+}
+
+SharedFrameBuffer::~SharedFrameBuffer() {
+    close();
+}
+
+bool SharedFrameBuffer::create(int width, int height, gid_t group) {
+    close();
+    if (width <= 0 || height <= 0) {
+        return fail("bad frame size");
+    }
+    frameSize_ = (size_t)width * height * 3;
+    size_t size = HEADER_SIZE + SLOTS * frameSize_;
+
+    fd_ = shm_open(name_.c_str(), O_RDWR | O_CREAT, SEGMENT_MODE);
+    if (fd_ < 0) {
+        return fail("shm_open " + name_ + ": " + strerror(errno));
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) == 0 && st.st_uid == geteuid() && (size_t)st.st_size == size && map(size)) {
+        if (header_->magic.load(std::memory_order_acquire) == MAGIC && header_->version == VERSION &&
+            (int)header_->width == width && (int)header_->height == height) {
+            // A restarted daemon picks up where the last one stopped, but
+            // not with a segment an older daemon left open to everyone
+            if (!restrictAccess(group)) {
+                return false;
+            }
+            uint32_t state = header_->state.load(std::memory_order_relaxed);
+            if (!isValidState(state)) {
+                header_->state.compare_exchange_strong(state, INITIAL_STATE, std::memory_order_relaxed);
+            }
+            width_ = width;
+            height_ = height;
+            return true;
+        }
+        munmap(mapping_, mappingSize_);
+        mapping_ = MAP_FAILED;
+        header_ = nullptr;
+        slots_ = nullptr;
+    }
+
+    // Replace the segment rather than resize it under an attached producer,
+    // which then sees isOrphaned(); one someone else created is replaced too
+    shm_unlink(name_.c_str());
+    ::close(fd_);
+    fd_ = shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL, SEGMENT_MODE);
+    if (fd_ < 0) {
+        return fail("shm_open " + name_ + ": " + strerror(errno));
+    }
+    if (!restrictAccess(group)) {
+        return false;
+    }
+    if (ftruncate(fd_, (off_t)size) != 0) {
+        return fail(std::string("ftruncate: ") + strerror(errno));
+    }
+    if (!map(size)) {
+        close();
+        return false;
+    }
+
+    header_->version = VERSION;
+    header_->width = (uint32_t)width;
+    header_->height = (uint32_t)height;
+    header_->state.store(INITIAL_STATE, std::memory_order_relaxed);
+    header_->doorbell.store(0, std::memory_order_relaxed);
+    header_->published.store(0, std::memory_order_relaxed);
+    header_->producerPid.store(0, std::memory_order_relaxed);
+    header_->magic.store(MAGIC, std::memory_order_release);
+    width_ = width;
+    height_ = height;
+    return true;
+}
+
+bool SharedFrameBuffer::attach() {
+    close();
+    fd_ = shm_open(name_.c_str(), O_RDWR, 0);
+    if (fd_ < 0) {
+        return fail(errno == ENOENT ? "no display daemon has created " + name_ : "shm_open " + name_ + ": " + strerror(errno));
+    }
+    if (flock(fd_, LOCK_EX | LOCK_NB) != 0) {
+        return fail(errno == EWOULDBLOCK ? "another producer is attached" : std::string("flock: ") + strerror(errno));
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0 || (size_t)st.st_size <= HEADER_SIZE || !map((size_t)st.st_size)) {
+        return fail("segment is not ready");
+    }
+    if (header_->magic.load(std::memory_order_acquire) != MAGIC || header_->version != VERSION) {
+        return fail("segment is not ready or from another version");
+    }
+    frameSize_ = (size_t)header_->width * header_->height * 3;
+    if (HEADER_SIZE + SLOTS * frameSize_ != mappingSize_) {
+        return fail("segment size does not match its frame size");
+    }
+
+    width_ = (int)header_->width;
+    height_ = (int)header_->height;
+    producer_ = true;
+    header_->producerPid.store((int32_t)getpid(), std::memory_order_relaxed);
+    return true;
+}
+
+void SharedFrameBuffer::close() {
+    if (header_ && producer_) {
+        int32_t self = (int32_t)getpid();
+        header_->producerPid.compare_exchange_strong(self, 0);
+    }
+    if (mapping_ != MAP_FAILED) {
+        munmap(mapping_, mappingSize_);
+        mapping_ = MAP_FAILED;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);   // Also drops the producer lock
+        fd_ = -1;
+    }
+    header_ = nullptr;
+    slots_ = nullptr;
+    producer_ = false;
+}
+
+uint8_t* SharedFrameBuffer::getBackBuffer() {
+    if (!header_) {
+        return nullptr;
+    }
+    // Only the producer moves the back slot, so it can't change under us
+    return slot(backOf(header_->state.load(std::memory_order_relaxed)));
+}
+
+void SharedFrameBuffer::publish() {
+    if (!header_) {
+        return;
+    }
+    uint32_t state = header_->state.load(std::memory_order_relaxed);
+    header_->frameTimeUs[backOf(state)] = MonotonicClock::nowUs();
+
+    uint32_t next;
+    do {
+        next = frontOf(state) | (backOf(state) << 2) | (middleOf(state) << 4) | FRESH;
+    } while (!header_->state.compare_exchange_weak(state, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    header_->published.fetch_add(1, std::memory_order_relaxed);
+    header_->doorbell.fetch_add(1, std::memory_order_release);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&header_->doorbell), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+bool SharedFrameBuffer::isOrphaned() const {
+    struct stat st;
+    return fd_ >= 0 && fstat(fd_, &st) == 0 && st.st_nlink == 0;
+}
+
+const uint8_t* SharedFrameBuffer::acquire() {
+    if (!header_) {
+        return nullptr;
+    }
+    uint32_t state = header_->state.load(std::memory_order_relaxed);
+    uint32_t next;
+    do {
+        if (!isValidState(state)) {
+            // Written by a broken producer; indexing slots with it would read
+            // outside the segment. Start over from a known layout.
+            header_->state.compare_exchange_strong(state, INITIAL_STATE, std::memory_order_relaxed);
+            stateResets_++;
+            return nullptr;
+        }
+        if (!(state & FRESH)) {
+            return nullptr;
+        }
+        next = middleOf(state) | (frontOf(state) << 2) | (backOf(state) << 4);
+    } while (!header_->state.compare_exchange_weak(state, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    acquired_++;
+    return slot(middleOf(state));
+}
+
+uint32_t SharedFrameBuffer::getDoorbell() const {
+    return header_ ? header_->doorbell.load(std::memory_order_acquire) : 0;
+}
+
+bool SharedFrameBuffer::waitForFrame(uint32_t seen, int timeoutMs) const {
+    if (!header_) {
+        return false;
+    }
+    if (header_->doorbell.load(std::memory_order_acquire) == seen) {
+        struct timespec timeout;
+        timeout.tv_sec = timeoutMs / 1000;
+        timeout.tv_nsec = (long)(timeoutMs % 1000) * 1000000L;
+        // Returns at once if a publish got in first (EAGAIN)
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&header_->doorbell), FUTEX_WAIT, seen, &timeout, nullptr, 0);
+    }
+    return header_->doorbell.load(std::memory_order_acquire) != seen;
+}
+
+long long SharedFrameBuffer::getFrameTimeUs() const {
+    // Only the daemon moves the front slot, but a producer can scribble on it
+    if (!header_) {
+        return 0;
+    }
+    unsigned front = frontOf(header_->state.load(std::memory_order_relaxed));
+    return front < (unsigned)SLOTS ? header_->frameTimeUs[front] : 0;
+}
+
+pid_t SharedFrameBuffer::getProducerPid() const {
+    if (!header_) {
+        return 0;
+    }
+    pid_t pid = (pid_t)header_->producerPid.load(std::memory_order_relaxed);
+    if (pid > 0 && (kill(pid, 0) == 0 || errno == EPERM)) {
+        return pid;
+    }
+    return 0;
+}
+
+unsigned long SharedFrameBuffer::getPublishedCount() const {
+    return header_ ? header_->published.load(std::memory_order_relaxed) : 0;
+}
+
+void SharedFrameBuffer::printReport(std::ostream& out) const {
+    out << "\033[1;36m🖼️  Frames in /dev/shm" << name_ << " (" << width_ << "x" << height_ << ")\033[0m" << std::endl;
+    if (!header_) {
+        out << "  not open" << (lastError_.empty() ? "" : ": " + lastError_) << std::endl;
+        return;
+    }
+    pid_t producer = getProducerPid();
+    out << "  producer: ";
+    if (producer) {
+        out << "pid " << producer << std::endl;
+    } else {
+        out << "none" << std::endl;
+    }
+    unsigned long published = getPublishedCount();
+    out << "  frames:   " << published << " published";
+    if (!producer_) {
+        out << ", " << acquired_ << " shown";
+    }
+    out << std::endl;
+    if (stateResets_ > 0) {
+        out << "  resets:   " << stateResets_ << " (producer wrote a bad state word)" << std::endl;
+    }
+}
+
+bool SharedFrameBuffer::map(size_t size) {
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        lastError_ = std::string("mmap: ") + strerror(errno);
+        return false;
+    }
+    mapping_ = mapping;
+    mappingSize_ = size;
+    header_ = static_cast<Header*>(mapping);
+    slots_ = static_cast<uint8_t*>(mapping) + HEADER_SIZE;
+    return true;
+}
+
+bool SharedFrameBuffer::restrictAccess(gid_t group) {
+    // shm_open's mode is subject to the umask, so set it explicitly
+    if (group != (gid_t)-1 && fchown(fd_, (uid_t)-1, group) != 0) {
+        return fail("chown " + name_ + " to group " + std::to_string(group) + ": " + strerror(errno));
+    }
+    if (fchmod(fd_, SEGMENT_MODE) != 0) {
+        return fail("chmod " + name_ + ": " + strerror(errno));
+    }
+    return true;
+}
+
+bool SharedFrameBuffer::fail(const std::string& reason) {
+    lastError_ = reason;
+    close();
+    return false;
+}
@@ -0,0 +1,112 @@
+#ifndef SHARED_FRAME_BUFFER_H
+#define SHARED_FRAME_BUFFER_H
+
+#include <ostream>
+#include <string>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+// Frames handed from a content process to the display daemon through a
+// POSIX shared memory segment (/dev/shm/<name>).
+//
+// The segment holds a small header and three frame slots of packed RGB,
+// row by row from the top left (width * height * 3 bytes, like
+// MemoryCanvas). The slots form a triple buffer: the producer draws into
+// its back slot and publish() swaps it with the middle slot, the daemon's
+// acquire() swaps the middle slot with its front slot when a new frame is
+// waiting. Both swaps are a compare-and-swap on one state word, so neither
+// side ever waits for the other, a slow daemon just skips to the newest
+// frame, and a producer that dies halfway through a frame leaves nothing
+// half-drawn behind: only published slots are ever read. Frames are drawn
+// in place, nothing is copied on the way to the daemon.
+//
+// Each publish also bumps a futex word (the doorbell) and wakes the daemon,
+// which sleeps in waitForFrame() while there is nothing new.
+//
+// The daemon create()s the segment, reusing one of the same size so
+// attached producers carry on across daemon restarts. Producers attach();
+// an flock() on the segment keeps it to one producer at a time and is
+// released by the kernel when the producer exits or crashes.
+//
+// The segment is readable and writable by its owner and group only
+// (SEGMENT_MODE); producers run as a member of the group create() is given.
+// The daemon doesn't trust anything a producer can write: a state word that
+// doesn't name three different slots is reset to the initial layout.
+class SharedFrameBuffer {
+public:
+    explicit SharedFrameBuffer(const std::string& name = DEFAULT_NAME);
+    ~SharedFrameBuffer();
+
+    // Daemon side: create the segment, or reuse a matching one, and give it
+    // to `group` (-1 keeps the daemon's own group)
+    bool create(int width, int height, gid_t group = (gid_t)-1);
+    // Producer side: attach to the daemon's segment
+    bool attach();
+    void close();
+
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    size_t getFrameSize() const { return frameSize_; }
+
+    // Producer: draw the next frame here, then publish() it
+    uint8_t* getBackBuffer();
+    void publish();
+    // True once the daemon replaced the segment (different size); attach again
+    bool isOrphaned() const;
+
+    // Daemon: the newest published frame if there is one it hasn't seen,
+    // otherwise nullptr. Stays valid until the next acquire().
+    const uint8_t* acquire();
+    // Doorbell value; read it before acquire() and pass it to waitForFrame()
+    uint32_t getDoorbell() const;
+    // Sleep until a frame is published after `seen` or the timeout passes
+    bool waitForFrame(uint32_t seen, int timeoutMs) const;
+    // Publish time of the acquired frame (MonotonicClock microseconds)
+    long long getFrameTimeUs() const;
+    // Pid of the attached producer, 0 when there is none alive
+    pid_t getProducerPid() const;
+
+    unsigned long getPublishedCount() const;
+    unsigned long getAcquiredCount() const { return acquired_; }
+    unsigned long getStateResetCount() const { return stateResets_; }
+    std::string getLastError() const { return lastError_; }
+    void printReport(std::ostream& out) const;
+
+    static const char* const DEFAULT_NAME;
+    static const uint32_t MAGIC = 0x4246544c;   // "LTFB"
+    static const uint32_t VERSION = 1;
+    static const size_t HEADER_SIZE = 4096;     // Slots start page aligned
+    static const int SLOTS = 3;
+    static const mode_t SEGMENT_MODE = 0660;
+
+private:
+    struct Header;
+
+    std::string name_;
+    int fd_;
+    void* mapping_;
+    size_t mappingSize_;
+    Header* header_;
+    uint8_t* slots_;
+    int width_;
+    int height_;
+    size_t frameSize_;
+    bool producer_;
+
+    unsigned long acquired_;
+    unsigned long stateResets_;   // Bad state words found by acquire()
+    std::string lastError_;
+
+    // Helper methods
+    bool map(size_t size);
+    bool restrictAccess(gid_t group);
+    bool fail(const std::string& reason);
+    uint8_t* slot(unsigned index) const { return slots_ + index * frameSize_; }
+
+    // Disable copy constructor and assignment operator
+    SharedFrameBuffer(const SharedFrameBuffer&) = delete;
+    SharedFrameBuffer& operator=(const SharedFrameBuffer&) = delete;
+};
+
+#endif // SHARED_FRAME_BUFFER_H
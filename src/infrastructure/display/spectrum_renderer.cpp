@@ -0,0 +1,103 @@
+#include "spectrum_renderer.h"
+
+namespace {
+
+const int MAX_ROWS = 256;
+
+int scale(int color, int brightnessScale) {
+    return (color * brightnessScale) / 255;
+}
+
+} // namespace
+
+SpectrumRenderer::SpectrumRenderer(int columns)
+    : columns_(columns), floorDb_(Config::SPECTRUM_FLOOR_DB), rangeDb_(Config::SPECTRUM_RANGE_DB),
+      bars_(columns, 0.0f), peaks_(columns, PeakHold(Config::PEAK_HOLD_MS, Config::PEAK_DECAY_DB_PER_SECOND)),
+      lastUpdateMs_(-1) {
+}
+
+void SpectrumRenderer::setRange(double floorDb, double rangeDb) {
+    if (rangeDb > 0.0) {
+        floorDb_ = floorDb;
+        rangeDb_ = rangeDb;
+    }
+}
+
+void SpectrumRenderer::update(const float* columnsDb, long long nowMs) {
+    double fall = lastUpdateMs_ < 0 ? 0.0 : (nowMs - lastUpdateMs_) * Config::SPECTRUM_FALL_DB_PER_SECOND / 1000.0;
+    lastUpdateMs_ = nowMs;
+
+    for (int c = 0; c < columns_; c++) {
+        float fallen = bars_[c] - (float)fall;
+        bars_[c] = columnsDb[c] > fallen ? columnsDb[c] : fallen;
+        peaks_[c].update(bars_[c], nowMs);
+    }
+}
+
+void SpectrumRenderer::reset() {
+    for (int c = 0; c < columns_; c++) {
+        bars_[c] = 0.0f;
+        peaks_[c].reset();
+    }
+    lastUpdateMs_ = -1;
+}
+
+int SpectrumRenderer::levelToRows(double db, int rows) const {
+    int filled = (int)((db - floorDb_) * rows / rangeDb_ + 0.5);
+    if (filled < 0) return 0;
+    if (filled > rows) return rows;
+    return filled;
+}
+
+void SpectrumRenderer::draw(Canvas* canvas, int brightnessScale) const {
+    int rows = canvas->height();
+    if (rows > MAX_ROWS) {
+        rows = MAX_ROWS;
+    }
+    int columnWidth = canvas->width() / columns_;
+    if (columnWidth < 1) {
+        columnWidth = 1;
+    }
+    int offsetX = (canvas->width() - columnWidth * columns_) / 2;
+
+    // Row colors from the bottom: green -> yellow -> red
+    ColorUtils::Color rowColors[MAX_ROWS];
+    for (int r = 0; r < rows; r++) {
+        float t = rows > 1 ? (float)r / (rows - 1) : 0.0f;
+        int red, green, blue;
+        if (t < 0.5f) {
+            ColorUtils::blendColors(Config::Colors::GREEN_R, Config::Colors::GREEN_G, Config::Colors::GREEN_B,
+                                    Config::Colors::YELLOW_R, Config::Colors::YELLOW_G, Config::Colors::YELLOW_B,
+                                    t * 2.0f, red, green, blue);
+        } else {
+            ColorUtils::blendColors(Config::Colors::YELLOW_R, Config::Colors::YELLOW_G, Config::Colors::YELLOW_B,
+                                    Config::Colors::RED_R, Config::Colors::RED_G, Config::Colors::RED_B,
+                                    (t - 0.5f) * 2.0f, red, green, blue);
+        }
+        rowColors[r] = ColorUtils::Color(scale(red, brightnessScale), scale(green, brightnessScale),
+                                         scale(blue, brightnessScale));
+    }
+
+    int markerR = scale(Config::Colors::TEXT_R, brightnessScale);
+    int markerG = scale(Config::Colors::TEXT_G, brightnessScale);
+    int markerB = scale(Config::Colors::TEXT_B, brightnessScale);
+
+    for (int c = 0; c < columns_; c++) {
+        int x0 = offsetX + c * columnWidth;
+        int filled = levelToRows(bars_[c], rows);
+        for (int r = 0; r < filled; r++) {
+            const ColorUtils::Color& color = rowColors[r];
+            for (int x = x0; x < x0 + columnWidth; x++) {
+                canvas->SetPixel(x, rows - 1 - r, color.r, color.g, color.b);
+            }
+        }
+
+        // The marker lights the top row of the held level
+        int peakRows = levelToRows(peaks_[c].getValue(lastUpdateMs_), rows);
+        if (peakRows > 0) {
+            for (int x = x0; x < x0 + columnWidth; x++) {
+                canvas->SetPixel(x, rows - peakRows, markerR, markerG, markerB);
+            }
+        }
+    }
+}
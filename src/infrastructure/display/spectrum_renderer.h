@@ -0,0 +1,43 @@
+#ifndef SPECTRUM_RENDERER_H
+#define SPECTRUM_RENDERER_H
+
+#include "led-matrix.h"
+#include "infrastructure/config/config.h"
+#include "shared/utils/color_utils.h"
+#include "shared/dsp/peak_hold.h"
+#include <vector>
+
+using namespace rgb_matrix;
+
+// Draws spectrum band levels as one vertical bar per column on any Canvas,
+// the matrix's offscreen canvas or a MemoryCanvas. Bars rise at once and
+// fall at a limited rate. A peak marker per column holds, then falls
+// (PeakHold). Bar pixels shade from green through yellow to red with
+// height.
+class SpectrumRenderer {
+public:
+    explicit SpectrumRenderer(int columns = Config::SPECTRUM_COLUMNS);
+
+    // Band level at the bottom row and the span up to the top row
+    void setRange(double floorDb, double rangeDb);
+
+    // New band levels (one per column) at monotonic time nowMs
+    void update(const float* columnsDb, long long nowMs);
+    void reset();
+
+    // Columns share the canvas width evenly; brightnessScale is 0-255
+    void draw(Canvas* canvas, int brightnessScale) const;
+
+private:
+    int columns_;
+    double floorDb_;
+    double rangeDb_;
+    std::vector<float> bars_;
+    std::vector<PeakHold> peaks_;
+    long long lastUpdateMs_;
+
+    // Helper methods
+    int levelToRows(double db, int rows) const;
+};
+
+#endif // SPECTRUM_RENDERER_H
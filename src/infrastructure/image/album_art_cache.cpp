@@ -0,0 +1,152 @@
+#include "album_art_cache.h"
+#include "infrastructure/image/image_decoder.h"
+#include "infrastructure/image/image_resampler.h"
+#include "shared/network/buffer_pool.h"
+#include "shared/utils/file_utils.h"
+#include <iostream>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <sys/stat.h>
+
+AlbumArtCache::AlbumArtCache(const std::string& directory, int iconSize, int colorBits)
+    : directory_(directory), iconSize_(iconSize), colorBits_(colorBits), decodeCount_(0) {
+    networkHandler_.setTimeout(10);
+}
+
+AlbumArtCache::~AlbumArtCache() {
+}
+
+bool AlbumArtCache::getIcon(const std::string& url, RgbImage& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (url.empty()) {
+        lastError_ = "No image URL";
+        return false;
+    }
+    
+    std::map<std::string, RgbImage>::const_iterator it = memoryCache_.find(url);
+    if (it != memoryCache_.end()) {
+        out = it->second;
+        return true;
+    }
+    
+    RgbImage icon;
+    std::string path = iconPath(url);
+    if (!loadIconFile(path, icon)) {
+        // Cache miss - download and decode once, then keep the result
+        if (!buildIcon(url, icon)) {
+            return false;
+        }
+        if (!saveIconFile(path, icon)) {
+            std::cerr << "⚠️  Could not cache icon: " << lastError_ << std::endl;
+        }
+    }
+    
+    memoryCache_[url] = icon;
+    out = icon;
+    return true;
+}
+
+bool AlbumArtCache::isCached(const std::string& url) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (memoryCache_.find(url) != memoryCache_.end()) {
+        return true;
+    }
+    
+    struct stat info;
+    return stat(iconPath(url).c_str(), &info) == 0;
+}
+
+unsigned long AlbumArtCache::getDecodeCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return decodeCount_;
+}
+
+std::string AlbumArtCache::getLastError() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lastError_;
+}
+
+bool AlbumArtCache::buildIcon(const std::string& url, RgbImage& out) {
+    BufferPool::Buffer buffer = BufferPool::shared().acquire();
+    if (!networkHandler_.get(url, buffer.str())) {
+        lastError_ = "Image download failed: " + networkHandler_.getLastError();
+        return false;
+    }
+    
+    RgbImage decoded;
+    std::string error;
+    if (!ImageDecoder::decode(buffer.str(), iconSize_, decoded, error)) {
+        lastError_ = error;
+        return false;
+    }
+    decodeCount_++;
+    buffer.release();
+    
+    if (!ImageResampler::resampleArea(decoded, iconSize_, iconSize_, out)) {
+        lastError_ = "Image resample failed";
+        return false;
+    }
+    ImageResampler::quantizeDither(out, colorBits_);
+    
+    std::cout << "🖼️  Decoded artwork " << decoded.width << "x" << decoded.height
+              << " -> " << iconSize_ << "x" << iconSize_ << " icon" << std::endl;
+    return true;
+}
+
+bool AlbumArtCache::loadIconFile(const std::string& path, RgbImage& out) {
+    std::string data;
+    if (!FileUtils::readFile(path, data) || data.size() < sizeof(IconHeader)) {
+        return false;
+    }
+    
+    IconHeader header;
+    memcpy(&header, data.data(), sizeof(header));
+    size_t pixelBytes = (size_t)header.width * header.height * 3;
+    if (memcmp(header.magic, "ICN1", 4) != 0 || header.width != iconSize_ ||
+        header.height != iconSize_ || data.size() != sizeof(header) + pixelBytes) {
+        return false; // Stale or foreign file - rebuild it
+    }
+    
+    out.resize(header.width, header.height);
+    memcpy(&out.pixels[0], data.data() + sizeof(header), pixelBytes);
+    return true;
+}
+
+bool AlbumArtCache::saveIconFile(const std::string& path, const RgbImage& icon) {
+    if (!FileUtils::makeDirectories(directory_)) {
+        lastError_ = "Cannot create directory " + directory_ + ": " + std::strerror(errno);
+        return false;
+    }
+    
+    IconHeader header;
+    memcpy(header.magic, "ICN1", 4);
+    header.width = (uint16_t)icon.width;
+    header.height = (uint16_t)icon.height;
+    
+    std::string data(reinterpret_cast<const char*>(&header), sizeof(header));
+    data.append(reinterpret_cast<const char*>(&icon.pixels[0]), icon.pixels.size());
+    
+    if (!FileUtils::writeFileAtomic(path, data)) {
+        lastError_ = "Cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+std::string AlbumArtCache::iconPath(const std::string& url) const {
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.icon", (unsigned long long)hashUrl(url));
+    return directory_ + "/" + name;
+}
+
+uint64_t AlbumArtCache::hashUrl(const std::string& url) {
+    // FNV-1a, 64-bit
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < url.size(); i++) {
+        hash ^= (unsigned char)url[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
@@ -0,0 +1,59 @@
+#ifndef ALBUM_ART_CACHE_H
+#define ALBUM_ART_CACHE_H
+
+#include "infrastructure/image/rgb_image.h"
+#include "shared/network/network_handler.h"
+#include <string>
+#include <map>
+#include <mutex>
+#include <stdint.h>
+
+// Fetches artwork by URL and turns it into a small, dithered panel icon.
+//
+// Finished icons are written to `directory` as raw RGB files named after a
+// hash of the URL, so each image is downloaded and decoded exactly once, even
+// across restarts. Later lookups come from memory or from the icon file.
+// Any URL curl understands works, including file:// and a local test server.
+class AlbumArtCache {
+public:
+    AlbumArtCache(const std::string& directory, int iconSize, int colorBits);
+    ~AlbumArtCache();
+    
+    // Blocks on download/decode on a cache miss, so call it from a
+    // background thread (e.g. a fetch job).
+    bool getIcon(const std::string& url, RgbImage& out);
+    
+    // Cache state
+    bool isCached(const std::string& url);
+    unsigned long getDecodeCount() const;
+    std::string getLastError() const;
+    
+private:
+    struct IconHeader {
+        char magic[4];     // "ICN1"
+        uint16_t width;
+        uint16_t height;
+    };
+    
+    std::string directory_;
+    int iconSize_;
+    int colorBits_;
+    std::map<std::string, RgbImage> memoryCache_;
+    NetworkHandler networkHandler_;
+    unsigned long decodeCount_;
+    std::string lastError_;
+    mutable std::mutex mutex_;
+    
+    // Helper methods (called with mutex_ held)
+    bool buildIcon(const std::string& url, RgbImage& out);
+    bool loadIconFile(const std::string& path, RgbImage& out);
+    bool saveIconFile(const std::string& path, const RgbImage& icon);
+    std::string iconPath(const std::string& url) const;
+    static uint64_t hashUrl(const std::string& url);
+    
+    // Disable copy constructor and assignment operator
+    AlbumArtCache(const AlbumArtCache&) = delete;
+    AlbumArtCache& operator=(const AlbumArtCache&) = delete;
+};
+
+#endif // ALBUM_ART_CACHE_H
@@ -0,0 +1,122 @@
+#include "image_decoder.h"
+#include <cstdio>
+#include <csetjmp>
+#include <cstring>
+#include <jpeglib.h>
+#include <png.h>
+
+namespace {
+
+// libjpeg reports fatal errors through a callback that must not return
+struct JpegErrorManager {
+    jpeg_error_mgr base;
+    jmp_buf jumpBuffer;
+    char message[JMSG_LENGTH_MAX];
+};
+
+void jpegErrorExit(j_common_ptr cinfo) {
+    JpegErrorManager* manager = reinterpret_cast<JpegErrorManager*>(cinfo->err);
+    (*cinfo->err->format_message)(cinfo, manager->message);
+    longjmp(manager->jumpBuffer, 1);
+}
+
+void jpegOutputMessage(j_common_ptr) {
+    // Warnings about slightly corrupt files are not worth printing
+}
+
+} // namespace
+
+bool ImageDecoder::decode(const std::string& data, int minSize, RgbImage& out, std::string& error) {
+    if (isJpeg(data)) {
+        return decodeJpeg(data, minSize, out, error);
+    }
+    if (isPng(data)) {
+        return decodePng(data, out, error);
+    }
+    
+    error = "Unsupported image format";
+    return false;
+}
+
+bool ImageDecoder::isJpeg(const std::string& data) {
+    return data.size() >= 3 &&
+           (unsigned char)data[0] == 0xFF && (unsigned char)data[1] == 0xD8 && (unsigned char)data[2] == 0xFF;
+}
+
+bool ImageDecoder::isPng(const std::string& data) {
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    if (data.size() < sizeof(signature)) return false;
+    for (size_t i = 0; i < sizeof(signature); i++) {
+        if ((unsigned char)data[i] != signature[i]) return false;
+    }
+    return true;
+}
+
+bool ImageDecoder::decodeJpeg(const std::string& data, int minSize, RgbImage& out, std::string& error) {
+    jpeg_decompress_struct cinfo;
+    JpegErrorManager errorManager;
+    
+    cinfo.err = jpeg_std_error(&errorManager.base);
+    errorManager.base.error_exit = jpegErrorExit;
+    errorManager.base.output_message = jpegOutputMessage;
+    errorManager.message[0] = '\0';
+    
+    if (setjmp(errorManager.jumpBuffer)) {
+        error = std::string("JPEG decode failed: ") + errorManager.message;
+        jpeg_destroy_decompress(&cinfo);
+        return false;
+    }
+    
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, (unsigned char*)data.data(), (unsigned long)data.size());
+    jpeg_read_header(&cinfo, TRUE);
+    
+    // Let the IDCT do most of the downscaling (1/2, 1/4 or 1/8)
+    unsigned int smallestEdge = cinfo.image_width < cinfo.image_height ? cinfo.image_width : cinfo.image_height;
+    unsigned int denom = 1;
+    while (denom < 8 && minSize > 0 && smallestEdge / (denom * 2) >= (unsigned int)minSize) {
+        denom *= 2;
+    }
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = denom;
+    cinfo.out_color_space = JCS_RGB;
+    cinfo.dct_method = JDCT_IFAST;
+    
+    jpeg_start_decompress(&cinfo);
+    
+    out.resize(cinfo.output_width, cinfo.output_height);
+    size_t rowStride = (size_t)cinfo.output_width * 3;
+    while (cinfo.output_scanline < cinfo.output_height) {
+        JSAMPROW row = &out.pixels[cinfo.output_scanline * rowStride];
+        jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+    
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    return true;
+}
+
+bool ImageDecoder::decodePng(const std::string& data, RgbImage& out, std::string& error) {
+    png_image image;
+    memset(&image, 0, sizeof(image));
+    image.version = PNG_IMAGE_VERSION;
+    
+    if (!png_image_begin_read_from_memory(&image, data.data(), data.size())) {
+        error = std::string("PNG decode failed: ") + image.message;
+        return false;
+    }
+    
+    // Composite any transparency onto black, which is what the panel shows
+    image.format = PNG_FORMAT_RGB;
+    png_color background = { 0, 0, 0 };
+    
+    out.resize(image.width, image.height);
+    if (!png_image_finish_read(&image, &background, &out.pixels[0], 0, nullptr)) {
+        error = std::string("PNG decode failed: ") + image.message;
+        png_image_free(&image);
+        out = RgbImage();
+        return false;
+    }
+    
+    return true;
+}
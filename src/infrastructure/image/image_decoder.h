@@ -0,0 +1,24 @@
+#ifndef IMAGE_DECODER_H
+#define IMAGE_DECODER_H
+
+#include "infrastructure/image/rgb_image.h"
+#include <string>
+
+// Decodes JPEG and PNG data (detected from the magic bytes) into RGB.
+// JPEGs are decoded with DCT scaling so a large cover is never expanded to
+// full size when only a small icon is needed.
+class ImageDecoder {
+public:
+    // Decode `data` into `out`. minSize is the smallest edge the caller still
+    // needs; JPEG decoding may scale down by up to 8x while staying above it.
+    static bool decode(const std::string& data, int minSize, RgbImage& out, std::string& error);
+    
+    static bool isJpeg(const std::string& data);
+    static bool isPng(const std::string& data);
+    
+private:
+    static bool decodeJpeg(const std::string& data, int minSize, RgbImage& out, std::string& error);
+    static bool decodePng(const std::string& data, RgbImage& out, std::string& error);
+};
+
+#endif // IMAGE_DECODER_H
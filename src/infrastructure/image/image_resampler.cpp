@@ -0,0 +1,164 @@
+#include "image_resampler.h"
+#include <algorithm>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+bool ImageResampler::resampleArea(const RgbImage& src, int width, int height, RgbImage& out) {
+    if (src.empty() || width <= 0 || height <= 0) {
+        return false;
+    }
+    
+    std::vector<Span> rows;
+    std::vector<Span> columns;
+    computeSpans(src.height, height, rows);
+    computeSpans(src.width, width, columns);
+    
+    out.resize(width, height);
+    
+    size_t rowBytes = (size_t)src.width * 3;
+    std::vector<uint32_t> acc(rowBytes);
+    
+    for (int y = 0; y < height; y++) {
+        // Vertical pass: weighted sum of the covered source rows
+        const Span& rowSpan = rows[y];
+        std::fill(acc.begin(), acc.end(), 0);
+        for (size_t i = 0; i < rowSpan.weights.size(); i++) {
+            const uint8_t* row = &src.pixels[(size_t)(rowSpan.first + i) * rowBytes];
+            accumulateRow(row, rowSpan.weights[i], &acc[0], rowBytes);
+        }
+        
+        // Horizontal pass over the accumulated row
+        uint8_t* dst = &out.pixels[(size_t)y * width * 3];
+        for (int x = 0; x < width; x++) {
+            const Span& columnSpan = columns[x];
+            uint64_t r = 0, g = 0, b = 0;
+            for (size_t i = 0; i < columnSpan.weights.size(); i++) {
+                const uint32_t* px = &acc[(size_t)(columnSpan.first + i) * 3];
+                uint64_t weight = columnSpan.weights[i];
+                r += px[0] * weight;
+                g += px[1] * weight;
+                b += px[2] * weight;
+            }
+            
+            // Both passes carry WEIGHT_BITS of scale; round on the way out
+            const int shift = 2 * WEIGHT_BITS;
+            const uint64_t half = (uint64_t)1 << (shift - 1);
+            dst[x * 3 + 0] = (uint8_t)std::min<uint64_t>(255, (r + half) >> shift);
+            dst[x * 3 + 1] = (uint8_t)std::min<uint64_t>(255, (g + half) >> shift);
+            dst[x * 3 + 2] = (uint8_t)std::min<uint64_t>(255, (b + half) >> shift);
+        }
+    }
+    
+    return true;
+}
+
+void ImageResampler::accumulateRow(const uint8_t* row, uint32_t weight, uint32_t* acc, size_t count) {
+    // acc[i] += row[i] * weight, 16 bytes per step. Weights fit in 16 bits,
+    // so one widening 16x16->32 multiply covers each lane.
+    size_t i = 0;
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    const uint16_t w = (uint16_t)weight;
+    for (; i + 16 <= count; i += 16) {
+        uint8x16_t bytes = vld1q_u8(row + i);
+        uint16x8_t low = vmovl_u8(vget_low_u8(bytes));
+        uint16x8_t high = vmovl_u8(vget_high_u8(bytes));
+        vst1q_u32(acc + i,      vmlal_n_u16(vld1q_u32(acc + i),      vget_low_u16(low),   w));
+        vst1q_u32(acc + i + 4,  vmlal_n_u16(vld1q_u32(acc + i + 4),  vget_high_u16(low),  w));
+        vst1q_u32(acc + i + 8,  vmlal_n_u16(vld1q_u32(acc + i + 8),  vget_low_u16(high),  w));
+        vst1q_u32(acc + i + 12, vmlal_n_u16(vld1q_u32(acc + i + 12), vget_high_u16(high), w));
+    }
+#elif defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i w = _mm_set1_epi16((short)weight);
+    for (; i + 16 <= count; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+        __m128i halves[2] = { _mm_unpacklo_epi8(bytes, zero), _mm_unpackhi_epi8(bytes, zero) };
+        for (int h = 0; h < 2; h++) {
+            // Full 32-bit products from the low and high 16-bit halves
+            __m128i productLow = _mm_mullo_epi16(halves[h], w);
+            __m128i productHigh = _mm_mulhi_epu16(halves[h], w);
+            __m128i* out = reinterpret_cast<__m128i*>(acc + i + h * 8);
+            _mm_storeu_si128(out, _mm_add_epi32(_mm_loadu_si128(out), _mm_unpacklo_epi16(productLow, productHigh)));
+            _mm_storeu_si128(out + 1, _mm_add_epi32(_mm_loadu_si128(out + 1), _mm_unpackhi_epi16(productLow, productHigh)));
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        acc[i] += row[i] * weight;
+    }
+}
+
+void ImageResampler::computeSpans(int srcSize, int dstSize, std::vector<Span>& spans) {
+    // Work in units of 1/dstSize of a source pixel so every boundary is an
+    // integer: destination i covers [i * srcSize, (i + 1) * srcSize).
+    const uint32_t one = 1u << WEIGHT_BITS;
+    spans.resize(dstSize);
+    
+    for (int i = 0; i < dstSize; i++) {
+        long long start = (long long)i * srcSize;
+        long long end = start + srcSize;
+        int first = (int)(start / dstSize);
+        int last = (int)((end - 1) / dstSize);
+        
+        Span& span = spans[i];
+        span.first = first;
+        span.weights.clear();
+        
+        uint32_t total = 0;
+        for (int s = first; s <= last; s++) {
+            long long lo = std::max(start, (long long)s * dstSize);
+            long long hi = std::min(end, (long long)(s + 1) * dstSize);
+            uint32_t weight = (uint32_t)(((hi - lo) * one) / srcSize);
+            span.weights.push_back(weight);
+            total += weight;
+        }
+        
+        // Give the rounding remainder to the largest tap so weights sum to 1.0
+        size_t largest = 0;
+        for (size_t k = 1; k < span.weights.size(); k++) {
+            if (span.weights[k] > span.weights[largest]) largest = k;
+        }
+        span.weights[largest] += one - total;
+    }
+}
+
+void ImageResampler::quantizeDither(RgbImage& image, int bitsPerChannel) {
+    if (image.empty() || bitsPerChannel >= 8 || bitsPerChannel <= 0) {
+        return;
+    }
+    
+    const int levels = (1 << bitsPerChannel) - 1;
+    const int rowValues = image.width * 3;
+    
+    // Error rows in 1/16 units (Floyd-Steinberg weights are 7, 3, 5, 1)
+    std::vector<int> current(rowValues + 6, 0);
+    std::vector<int> next(rowValues + 6, 0);
+    
+    for (int y = 0; y < image.height; y++) {
+        uint8_t* row = &image.pixels[(size_t)y * rowValues];
+        std::fill(next.begin(), next.end(), 0);
+        
+        for (int x = 0; x < image.width; x++) {
+            for (int c = 0; c < 3; c++) {
+                int index = x * 3 + c;
+                int value = row[index] + (current[index + 3] + 8) / 16;
+                value = std::max(0, std::min(255, value));
+                
+                int quantized = ((value * levels + 127) / 255) * 255 / levels;
+                row[index] = (uint8_t)quantized;
+                
+                int err = value - quantized;
+                current[index + 6] += err * 7;  // Right
+                next[index] += err * 3;         // Below left
+                next[index + 3] += err * 5;     // Below
+                next[index + 6] += err * 1;     // Below right
+            }
+        }
+        
+        current.swap(next);
+    }
+}
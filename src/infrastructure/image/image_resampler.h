@@ -0,0 +1,37 @@
+#ifndef IMAGE_RESAMPLER_H
+#define IMAGE_RESAMPLER_H
+
+#include "infrastructure/image/rgb_image.h"
+#include <vector>
+#include <stdint.h>
+
+// Turns decoded artwork into a panel icon: area (box) resampling followed by
+// colour quantization with Floyd-Steinberg dithering.
+//
+// The resampler is separable. The vertical pass accumulates whole source
+// rows into a 32-bit fixed-point row buffer with a single weight per row,
+// a widening multiply-add over contiguous bytes done with NEON on the Pi and
+// SSE2 on x86 (scalar elsewhere). The horizontal pass only touches the much
+// smaller accumulated rows.
+class ImageResampler {
+public:
+    // Average every source pixel covered by each destination pixel
+    static bool resampleArea(const RgbImage& src, int width, int height, RgbImage& out);
+    
+    // Reduce each channel to `bitsPerChannel` bits, diffusing the error
+    static void quantizeDither(RgbImage& image, int bitsPerChannel);
+    
+    // Fixed-point scale of the weights (1.0 must fit in 16 bits)
+    static const int WEIGHT_BITS = 15;
+    
+private:
+    struct Span {
+        int first;                     // First source index covered
+        std::vector<uint32_t> weights; // Fixed-point coverage of each index
+    };
+    
+    static void computeSpans(int srcSize, int dstSize, std::vector<Span>& spans);
+    static void accumulateRow(const uint8_t* row, uint32_t weight, uint32_t* acc, size_t count);
+};
+
+#endif // IMAGE_RESAMPLER_H
@@ -0,0 +1,27 @@
+#ifndef RGB_IMAGE_H
+#define RGB_IMAGE_H
+
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+// Packed 8-bit RGB image (3 bytes per pixel, rows stored top to bottom)
+struct RgbImage {
+    int width;
+    int height;
+    std::vector<uint8_t> pixels;
+    
+    RgbImage() : width(0), height(0) {}
+    
+    void resize(int w, int h) {
+        width = w;
+        height = h;
+        pixels.assign((size_t)w * h * 3, 0);
+    }
+    
+    bool empty() const { return width <= 0 || height <= 0 || pixels.empty(); }
+    
+    const uint8_t* at(int x, int y) const { return &pixels[((size_t)y * width + x) * 3]; }
+};
+
+#endif // RGB_IMAGE_H
@@ -0,0 +1,137 @@
+#include "control_socket.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+namespace {
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+} // namespace
+
+ControlSocket::ControlSocket(const std::string& path) : path_(path), listenFd_(-1) {
+}
+
+ControlSocket::~ControlSocket() {
+    close();
+}
+
+bool ControlSocket::open() {
+    if (listenFd_ >= 0) {
+        return true;
+    }
+    
+    struct sockaddr_un addr;
+    if (path_.empty() || path_.size() >= sizeof(addr.sun_path)) {
+        lastError_ = "Invalid control socket path: " + path_;
+        return false;
+    }
+    
+    listenFd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        lastError_ = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+    
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path_.c_str(), sizeof(addr.sun_path) - 1);
+    
+    // Remove a stale socket left by a previous run
+    unlink(path_.c_str());
+    
+    if (bind(listenFd_, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(listenFd_, 64) != 0 || !setNonBlocking(listenFd_)) {
+        lastError_ = "Cannot listen on " + path_ + ": " + std::strerror(errno);
+        ::close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+    chmod(path_.c_str(), 0660);
+    
+    std::cout << "🎛️  Control socket listening on " << path_ << std::endl;
+    return true;
+}
+
+void ControlSocket::close() {
+    for (std::map<int, LineAssembler>::const_iterator it = clients_.begin(); it != clients_.end(); ++it) {
+        ::close(it->first);
+    }
+    clients_.clear();
+    
+    if (listenFd_ >= 0) {
+        ::close(listenFd_);
+        listenFd_ = -1;
+        unlink(path_.c_str());
+    }
+}
+
+size_t ControlSocket::poll(std::vector<std::string>& lines, size_t maxLines) {
+    if (listenFd_ < 0) {
+        return 0;
+    }
+    
+    acceptClients();
+    
+    size_t added = 0;
+    std::map<int, LineAssembler>::iterator it = clients_.begin();
+    while (it != clients_.end()) {
+        bool closed = readClient(it->first, it->second);
+        
+        std::string line;
+        while (added < maxLines && it->second.nextLine(line)) {
+            lines.push_back(line);
+            added++;
+        }
+        
+        // Keep the connection until its buffered lines are drained
+        if (closed && !it->second.hasLine()) {
+            ::close(it->first);
+            clients_.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+    return added;
+}
+
+void ControlSocket::acceptClients() {
+    int fd;
+    while ((fd = accept(listenFd_, nullptr, nullptr)) >= 0) {
+        if (clients_.size() >= MAX_CLIENTS || !setNonBlocking(fd)) {
+            ::close(fd);
+            continue;
+        }
+        clients_[fd];
+    }
+}
+
+bool ControlSocket::readClient(int fd, LineAssembler& assembler) {
+    // Bounded read so one flooding client cannot stall a frame
+    char buffer[4096];
+    size_t total = 0;
+    while (total < MAX_READ_PER_CLIENT) {
+        ssize_t got = read(fd, buffer, sizeof(buffer));
+        if (got > 0) {
+            assembler.append(buffer, (size_t)got);
+            total += (size_t)got;
+            continue;
+        }
+        if (got == 0) {
+            return true; // Peer closed
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        return errno != EAGAIN && errno != EWOULDBLOCK;
+    }
+    return false;
+}
@@ -0,0 +1,50 @@
+#ifndef CONTROL_SOCKET_H
+#define CONTROL_SOCKET_H
+
+#include "infrastructure/input/line_assembler.h"
+#include <string>
+#include <vector>
+#include <map>
+
+// UNIX-domain control socket accepting the same line commands as stdin
+// ("db", "set 87", "back", ...). Entirely non-blocking and polled from the
+// render loop: each call accepts pending clients, reads whatever bytes are
+// available (bounded per client) and returns complete lines. Any number of
+// clients may be connected; a partial line just waits in that client's
+// assembler.
+class ControlSocket {
+public:
+    explicit ControlSocket(const std::string& path);
+    ~ControlSocket();
+    
+    bool open();
+    void close();
+    bool isOpen() const { return listenFd_ >= 0; }
+    
+    // Append up to maxLines complete lines to `lines`; never blocks
+    size_t poll(std::vector<std::string>& lines, size_t maxLines = DEFAULT_MAX_LINES_PER_POLL);
+    
+    size_t getClientCount() const { return clients_.size(); }
+    const std::string& getPath() const { return path_; }
+    std::string getLastError() const { return lastError_; }
+    
+    static const size_t DEFAULT_MAX_LINES_PER_POLL = 4096;
+    static const size_t MAX_READ_PER_CLIENT = 64 * 1024;  // Bytes per poll
+    static const size_t MAX_CLIENTS = 64;
+    
+private:
+    std::string path_;
+    int listenFd_;
+    std::map<int, LineAssembler> clients_;
+    std::string lastError_;
+    
+    // Helper methods
+    void acceptClients();
+    bool readClient(int fd, LineAssembler& assembler);
+    
+    // Disable copy constructor and assignment operator
+    ControlSocket(const ControlSocket&) = delete;
+    ControlSocket& operator=(const ControlSocket&) = delete;
+};
+
+#endif // CONTROL_SOCKET_H
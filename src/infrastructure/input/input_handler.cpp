@@ -2,7 +2,7 @@
 #include <iostream>
 #include <unistd.h>
 
-InputHandler::InputHandler() {
+InputHandler::InputHandler() : endOfInput_(false) {
     FD_ZERO(&readfds_);
     FD_SET(STDIN_FILENO, &readfds_);
     timeout_.tv_sec = 0;
@@ -14,16 +14,30 @@ InputHandler::~InputHandler() {
 }
 
 bool InputHandler::hasInput() {
+    if (assembler_.hasLine()) {
+        return true;
+    }
+    
     fd_set temp_readfds = readfds_;
     struct timeval temp_timeout = timeout_;
     
-    return select(STDIN_FILENO + 1, &temp_readfds, NULL, NULL, &temp_timeout) > 0;
+    if (!endOfInput_ && select(STDIN_FILENO + 1, &temp_readfds, NULL, NULL, &temp_timeout) > 0) {
+        // Take whatever is there; never wait for the rest of the line
+        char buffer[1024];
+        ssize_t got = read(STDIN_FILENO, buffer, sizeof(buffer));
+        if (got > 0) {
+            assembler_.append(buffer, (size_t)got);
+        } else if (got == 0) {
+            endOfInput_ = true; // stdin closed (e.g. running as a service)
+        }
+    }
+    
+    return assembler_.hasLine();
 }
 
 int InputHandler::readIntValue() {
     int value = -1;
-    std::string line;
-    std::getline(std::cin, line);
+    std::string line = readStringValue();
     try { 
         value = std::stoi(line); 
     }
@@ -35,7 +49,7 @@ int InputHandler::readIntValue() {
 
 std::string InputHandler::readStringValue() {
     std::string line;
-    std::getline(std::cin, line);
+    assembler_.nextLine(line);
     return line;
 }
 
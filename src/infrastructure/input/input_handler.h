@@ -1,6 +1,7 @@
 #ifndef INPUT_HANDLER_H
 #define INPUT_HANDLER_H
 
+#include "infrastructure/input/line_assembler.h"
 #include <sys/select.h>
 #include <string>
 
@@ -9,7 +10,8 @@ public:
     InputHandler();
     ~InputHandler();
     
-    // Check for new input (non-blocking)
+    // Check for a complete input line (non-blocking; partial lines stay
+    // buffered instead of stalling the caller)
     bool hasInput();
     
     // Read integer value from stdin
@@ -24,6 +26,8 @@ public:
 private:
     fd_set readfds_;
     struct timeval timeout_;
+    LineAssembler assembler_;
+    bool endOfInput_;
 };
 
 #endif // INPUT_HANDLER_H
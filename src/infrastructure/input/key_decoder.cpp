@@ -0,0 +1,240 @@
+#include "key_decoder.h"
+#include <cstdlib>
+
+namespace {
+
+const char ESC = 0x1b;
+const char PASTE_START[] = "\033[200~";
+const char PASTE_END[] = "\033[201~";
+const size_t PASTE_END_LENGTH = sizeof(PASTE_END) - 1;
+const size_t PASTE_BURST_BYTES = 3;     // Printable bytes in one read that count as a paste
+const size_t MAX_SEQUENCE = 32;         // Longer "sequences" are garbage
+
+bool isPasteBurst(const char* data, size_t size) {
+    if (size < PASTE_BURST_BYTES || (unsigned char)data[0] < 32) {
+        return false;
+    }
+    for (size_t i = 0; i < size; i++) {
+        unsigned char byte = (unsigned char)data[i];
+        if ((byte < 32 && byte != '\r' && byte != '\n' && byte != '\t') || byte == 127) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Final byte of CSI/SS3 cursor keys ("ESC [ A", "ESC O H", "ESC [ 1 ; 5 C")
+bool cursorKey(char final, KeyEvent::Type& type) {
+    switch (final) {
+        case 'A': type = KeyEvent::UP; return true;
+        case 'B': type = KeyEvent::DOWN; return true;
+        case 'C': type = KeyEvent::RIGHT; return true;
+        case 'D': type = KeyEvent::LEFT; return true;
+        case 'H': type = KeyEvent::HOME; return true;
+        case 'F': type = KeyEvent::END; return true;
+        default: return false;
+    }
+}
+
+// "ESC [ <code> ~" editing keys (VT220 style, as sent by xterm and the console)
+bool tildeKey(int code, KeyEvent::Type& type) {
+    switch (code) {
+        case 1: case 7: type = KeyEvent::HOME; return true;
+        case 4: case 8: type = KeyEvent::END; return true;
+        case 3: type = KeyEvent::DELETE; return true;
+        case 5: type = KeyEvent::PAGE_UP; return true;
+        case 6: type = KeyEvent::PAGE_DOWN; return true;
+        default: return false;
+    }
+}
+
+} // namespace
+
+KeyDecoder::KeyDecoder()
+    : readPos_(0), lastAppendMs_(0), escapeSinceMs_(-1), inPaste_(false), afterCarriageReturn_(false) {
+}
+
+void KeyDecoder::append(const char* data, size_t size, long long nowMs) {
+    compact();
+    lastAppendMs_ = nowMs;
+
+    if (!inPaste_ && readPos_ == buffer_.size() && isPasteBurst(data, size)) {
+        // Frame it like a bracketed paste so it decodes the same way
+        buffer_.append(PASTE_START);
+        buffer_.append(data, size);
+        buffer_.append(PASTE_END);
+        return;
+    }
+    buffer_.append(data, size);
+}
+
+bool KeyDecoder::next(KeyEvent& event, long long nowMs) {
+    while (readPos_ < buffer_.size()) {
+        if (inPaste_) {
+            if (decodePaste(event)) {
+                return true;
+            }
+            if (inPaste_) {
+                return false; // Rest of the paste still to come
+            }
+            continue;         // Empty paste
+        }
+
+        unsigned char byte = (unsigned char)buffer_[readPos_];
+        if (byte == (unsigned char)ESC) {
+            if (escapeSinceMs_ < 0) {
+                escapeSinceMs_ = lastAppendMs_;
+            }
+            bool timedOut = nowMs - escapeSinceMs_ >= ESCAPE_TIMEOUT_MS;
+            bool consumed = false;
+            bool decoded = decodeEscape(event, timedOut, consumed);
+            if (!consumed) {
+                return false; // Wait for the rest of the sequence
+            }
+            escapeSinceMs_ = -1;
+            afterCarriageReturn_ = false;
+            if (decoded) {
+                return true;
+            }
+            continue;         // Swallowed, or the start of a paste
+        }
+
+        readPos_++;
+        if (byte == '\n' && afterCarriageReturn_) {
+            afterCarriageReturn_ = false;
+            continue;
+        }
+        afterCarriageReturn_ = byte == '\r';
+
+        event.text.clear();
+        event.character = (char)byte;
+        if (byte == '\r' || byte == '\n') {
+            event.type = KeyEvent::ENTER;
+        } else if (byte == 127 || byte == '\b') {
+            event.type = KeyEvent::BACKSPACE;
+        } else if (byte == '\t') {
+            event.type = KeyEvent::TAB;
+        } else if (byte < 32) {
+            continue;         // Other control keys have no meaning here
+        } else {
+            event.type = KeyEvent::CHARACTER;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool KeyDecoder::hasPendingEscape() const {
+    return !inPaste_ && readPos_ < buffer_.size() && buffer_[readPos_] == ESC;
+}
+
+void KeyDecoder::clear() {
+    buffer_.clear();
+    readPos_ = 0;
+    escapeSinceMs_ = -1;
+    inPaste_ = false;
+    afterCarriageReturn_ = false;
+}
+
+bool KeyDecoder::decodeEscape(KeyEvent& event, bool timedOut, bool& consumed) {
+    size_t available = buffer_.size() - readPos_;
+    event.text.clear();
+    event.character = ESC;
+
+    if (available == 1) {
+        // Escape key, or the first byte of a sequence still in flight
+        if (!timedOut) {
+            return false;
+        }
+        readPos_++;
+        consumed = true;
+        event.type = KeyEvent::ESCAPE;
+        return true;
+    }
+
+    char intro = buffer_[readPos_ + 1];
+    if (intro == '[') {
+        // CSI: parameter bytes 0x30-0x3F, intermediates 0x20-0x2F, final 0x40-0x7E
+        size_t pos = readPos_ + 2;
+        while (pos < buffer_.size() && buffer_[pos] >= 0x20 && buffer_[pos] <= 0x3f) {
+            pos++;
+        }
+        if (pos >= buffer_.size()) {
+            if (!timedOut && pos - readPos_ < MAX_SEQUENCE) {
+                return false;
+            }
+            readPos_ = buffer_.size(); // Never finished; drop it
+            consumed = true;
+            return false;
+        }
+
+        char final = buffer_[pos];
+        int code = std::atoi(buffer_.c_str() + readPos_ + 2);
+        consumed = true;
+        if (final < 0x40 || final > 0x7e) {
+            readPos_ = pos;            // Malformed; the stray byte decodes on its own
+            return false;
+        }
+        readPos_ = pos + 1;
+
+        if (final == '~' && code == 200) {
+            inPaste_ = true;
+            return false;
+        }
+        if (final == '~') {
+            return tildeKey(code, event.type);
+        }
+        return cursorKey(final, event.type);
+    }
+
+    if (intro == 'O') {
+        // SS3: cursor keys in application mode ("ESC O A")
+        if (available < 3) {
+            if (!timedOut) {
+                return false;
+            }
+            readPos_ += 2;
+            consumed = true;
+            return false;
+        }
+        char final = buffer_[readPos_ + 2];
+        readPos_ += 3;
+        consumed = true;
+        return cursorKey(final, event.type);
+    }
+
+    // Alt+key, or Escape pressed just before another key: Escape, then the key
+    readPos_++;
+    consumed = true;
+    event.type = KeyEvent::ESCAPE;
+    return true;
+}
+
+bool KeyDecoder::decodePaste(KeyEvent& event) {
+    size_t end = buffer_.find(PASTE_END, readPos_);
+    size_t length;
+    if (end != std::string::npos) {
+        length = end - readPos_;
+        inPaste_ = false;
+    } else if (buffer_.size() - readPos_ >= MAX_PASTE + PASTE_END_LENGTH) {
+        // Hand out a piece, keeping enough back for a split end marker
+        length = MAX_PASTE;
+    } else {
+        return false;
+    }
+
+    event.type = KeyEvent::PASTE;
+    event.character = 0;
+    event.text.assign(buffer_, readPos_, length);
+    readPos_ += length + (inPaste_ ? 0 : PASTE_END_LENGTH);
+    afterCarriageReturn_ = false;
+    return length > 0;
+}
+
+void KeyDecoder::compact() {
+    // Drop consumed bytes once they dominate, keeping appends amortized O(1)
+    if (readPos_ > 0 && readPos_ * 2 >= buffer_.size()) {
+        buffer_.erase(0, readPos_);
+        readPos_ = 0;
+    }
+}
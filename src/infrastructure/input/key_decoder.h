@@ -0,0 +1,77 @@
+#ifndef KEY_DECODER_H
+#define KEY_DECODER_H
+
+#include <string>
+#include <stddef.h>
+
+// One keystroke (or one paste) from a raw-mode terminal
+struct KeyEvent {
+    enum Type {
+        CHARACTER,   // Printable byte in character (UTF-8 bytes come one by one)
+        ENTER,
+        BACKSPACE,
+        TAB,
+        ESCAPE,
+        UP,
+        DOWN,
+        LEFT,
+        RIGHT,
+        HOME,
+        END,
+        DELETE,
+        PAGE_UP,
+        PAGE_DOWN,
+        PASTE        // Pasted text in text, newlines included
+    };
+
+    Type type;
+    char character;
+    std::string text;
+
+    KeyEvent() : type(CHARACTER), character(0) {}
+};
+
+// Turns the bytes of a non-canonical terminal into key events without ever
+// waiting for more input.
+//
+// - CSI (ESC [) and SS3 (ESC O) sequences become arrow, Home/End, Delete
+//   and Page keys; unknown sequences are swallowed whole.
+// - Bracketed paste (ESC [200~ ... ESC [201~) becomes one PASTE event, and
+//   so does a burst of several printable bytes arriving in one read from a
+//   terminal without bracketed paste - nobody types that fast.
+// - A sequence split across reads waits in the buffer. A lone ESC is the
+//   Escape key once ESCAPE_TIMEOUT_MS pass without a follow-up byte.
+// - "\r", "\n" and "\r\n" are one Enter; DEL (127) and ^H are Backspace.
+class KeyDecoder {
+public:
+    static const int ESCAPE_TIMEOUT_MS = 25;
+    static const size_t MAX_PASTE = 4096;   // Longer pastes come in pieces
+
+    KeyDecoder();
+
+    // Add the bytes of one read; nowMs times out a pending ESC
+    void append(const char* data, size_t size, long long nowMs);
+
+    // Pop the next complete event. False when the buffer is empty or ends
+    // in an unfinished sequence.
+    bool next(KeyEvent& event, long long nowMs);
+
+    // An ESC (or partial sequence) is waiting for its next byte or timeout
+    bool hasPendingEscape() const;
+    void clear();
+
+private:
+    std::string buffer_;
+    size_t readPos_;
+    long long lastAppendMs_;
+    long long escapeSinceMs_;   // Arrival of the pending ESC, -1 if none
+    bool inPaste_;
+    bool afterCarriageReturn_;  // Swallow the "\n" of a "\r\n" split across reads
+
+    // Helper methods
+    bool decodeEscape(KeyEvent& event, bool timedOut, bool& consumed);
+    bool decodePaste(KeyEvent& event);
+    void compact();
+};
+
+#endif // KEY_DECODER_H
@@ -0,0 +1,83 @@
+#include "line_assembler.h"
+
+LineAssembler::LineAssembler(size_t maxLineLength)
+    : readPos_(0), scanPos_(0), maxLineLength_(maxLineLength), droppedCount_(0), discarding_(false) {
+}
+
+void LineAssembler::append(const char* data, size_t size) {
+    compact();
+    buffer_.append(data, size);
+}
+
+bool LineAssembler::nextLine(std::string& line) {
+    while (true) {
+        size_t newline = buffer_.find('\n', scanPos_);
+        if (newline == std::string::npos) {
+            scanPos_ = buffer_.size();
+            
+            // A line that never ends must not grow the buffer forever
+            if (scanPos_ - readPos_ > maxLineLength_) {
+                if (!discarding_) droppedCount_++;
+                discarding_ = true;
+                readPos_ = scanPos_;
+            }
+            return false;
+        }
+        
+        size_t start = readPos_;
+        readPos_ = scanPos_ = newline + 1;
+        
+        if (discarding_) {
+            // Tail of an over-long line
+            discarding_ = false;
+            continue;
+        }
+        
+        size_t end = newline;
+        if (end > start && buffer_[end - 1] == '\r') end--;
+        if (end - start > maxLineLength_) {
+            // Arrived in one piece, but just as over-long
+            droppedCount_++;
+            continue;
+        }
+        line.assign(buffer_, start, end - start);
+        return true;
+    }
+}
+
+bool LineAssembler::hasLine() const {
+    size_t start = readPos_;
+    size_t newline = buffer_.find('\n', scanPos_);
+    if (newline != std::string::npos && discarding_) {
+        start = newline + 1;
+        newline = buffer_.find('\n', start); // First one ends the dropped line
+    }
+    
+    // Complete lines that are too long will be dropped as well
+    while (newline != std::string::npos) {
+        size_t end = newline;
+        if (end > start && buffer_[end - 1] == '\r') end--;
+        if (end - start <= maxLineLength_) {
+            return true;
+        }
+        start = newline + 1;
+        newline = buffer_.find('\n', start);
+    }
+    return false;
+}
+
+void LineAssembler::clear() {
+    buffer_.clear();
+    readPos_ = 0;
+    scanPos_ = 0;
+    discarding_ = false;
+}
+
+void LineAssembler::compact() {
+    // Drop consumed bytes once they dominate, keeping appends amortized O(1)
+    if (readPos_ > 0 && readPos_ * 2 >= buffer_.size()) {
+        buffer_.erase(0, readPos_);
+        scanPos_ -= readPos_;
+        readPos_ = 0;
+    }
+}
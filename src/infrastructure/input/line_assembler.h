@@ -0,0 +1,36 @@
+#ifndef LINE_ASSEMBLER_H
+#define LINE_ASSEMBLER_H
+
+#include <string>
+
+// Collects bytes from a non-blocking stream and hands out complete lines.
+// A partial line just stays buffered until the rest arrives, so the reader
+// never waits for a newline.
+class LineAssembler {
+public:
+    explicit LineAssembler(size_t maxLineLength = DEFAULT_MAX_LINE_LENGTH);
+    
+    // Add raw bytes (may contain any number of lines or a fragment)
+    void append(const char* data, size_t size);
+    
+    // Pop the next complete line without its "\n" / "\r\n"
+    bool nextLine(std::string& line);
+    
+    bool hasLine() const;
+    size_t getDroppedCount() const { return droppedCount_; }
+    void clear();
+    
+    static const size_t DEFAULT_MAX_LINE_LENGTH = 1024;
+    
+private:
+    std::string buffer_;
+    size_t readPos_;        // Start of the first unconsumed byte
+    size_t scanPos_;        // Everything before this has no newline
+    size_t maxLineLength_;
+    size_t droppedCount_;   // Over-long lines discarded
+    bool discarding_;       // Skipping the rest of an over-long line
+    
+    void compact();
+};
+
+#endif // LINE_ASSEMBLER_H
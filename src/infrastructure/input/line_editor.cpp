@@ -0,0 +1,91 @@
+#include "line_editor.h"
+
+LineEditor::LineEditor(std::ostream& echo) : echo_(echo), historyPos_(0) {
+}
+
+size_t LineEditor::handleKey(const KeyEvent& key, std::vector<std::string>& lines) {
+    size_t before = lines.size();
+    switch (key.type) {
+        case KeyEvent::CHARACTER:
+            insert(key.character);
+            break;
+        case KeyEvent::BACKSPACE:
+            erase();
+            break;
+        case KeyEvent::ENTER:
+            finish(lines);
+            break;
+        case KeyEvent::UP:
+            if (historyPos_ > 0) {
+                recall(historyPos_ - 1);
+            }
+            break;
+        case KeyEvent::DOWN:
+            if (historyPos_ < history_.size()) {
+                recall(historyPos_ + 1);
+            }
+            break;
+        case KeyEvent::PASTE:
+            for (size_t i = 0; i < key.text.size(); i++) {
+                char c = key.text[i];
+                if (c == '\n' || c == '\r') {
+                    // "\r\n" must not finish an extra empty line
+                    if (c == '\n' && i > 0 && key.text[i - 1] == '\r') {
+                        continue;
+                    }
+                    finish(lines);
+                } else if ((unsigned char)c >= 32 && c != 127) {
+                    insert(c);
+                }
+            }
+            break;
+        default:
+            break;
+    }
+    echo_.flush();
+    return lines.size() - before;
+}
+
+void LineEditor::clear() {
+    line_.clear();
+    historyPos_ = history_.size();
+}
+
+void LineEditor::insert(char c) {
+    if (line_.size() >= MAX_LINE_LENGTH) {
+        return;
+    }
+    line_ += c;
+    echo_ << c;
+}
+
+void LineEditor::erase() {
+    if (line_.empty()) {
+        return;
+    }
+    // Drop UTF-8 continuation bytes along with their lead byte
+    while (line_.size() > 1 && ((unsigned char)line_[line_.size() - 1] & 0xC0) == 0x80) {
+        line_.erase(line_.size() - 1);
+    }
+    line_.erase(line_.size() - 1);
+    echo_ << "\b \b";
+}
+
+void LineEditor::finish(std::vector<std::string>& lines) {
+    echo_ << "\n";
+    if (!line_.empty() && (history_.empty() || history_.back() != line_)) {
+        if (history_.size() >= MAX_HISTORY) {
+            history_.erase(history_.begin());
+        }
+        history_.push_back(line_);
+    }
+    lines.push_back(line_);
+    clear();
+}
+
+void LineEditor::recall(size_t position) {
+    historyPos_ = position;
+    line_ = position < history_.size() ? history_[position] : std::string();
+    // Back to column 0, clear the old text, show the recalled line
+    echo_ << "\r\033[K" << line_;
+}
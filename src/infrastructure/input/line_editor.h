@@ -0,0 +1,41 @@
+#ifndef LINE_EDITOR_H
+#define LINE_EDITOR_H
+
+#include "infrastructure/input/key_decoder.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+// The line editing a canonical-mode terminal used to do, for raw mode:
+// echo, Backspace (whole UTF-8 characters) and Up/Down through earlier
+// lines. Pasted text is typed in, and each newline in it finishes a line.
+class LineEditor {
+public:
+    static const size_t MAX_HISTORY = 32;
+    static const size_t MAX_LINE_LENGTH = 1024;
+
+    explicit LineEditor(std::ostream& echo);
+
+    // Apply one key; finished lines are appended to lines. Returns how many
+    // were added.
+    size_t handleKey(const KeyEvent& key, std::vector<std::string>& lines);
+
+    const std::string& getLine() const { return line_; }
+
+    // Forget the unfinished line (history stays)
+    void clear();
+
+private:
+    std::ostream& echo_;
+    std::string line_;
+    std::vector<std::string> history_;
+    size_t historyPos_;     // history_.size() when editing a new line
+
+    // Helper methods
+    void insert(char c);
+    void erase();
+    void finish(std::vector<std::string>& lines);
+    void recall(size_t position);
+};
+
+#endif // LINE_EDITOR_H
@@ -0,0 +1,226 @@
+#include "terminal_input.h"
+#include "shared/utils/monotonic_clock.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <poll.h>
+#include <signal.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace {
+
+const char BRACKETED_PASTE_ON[] = "\033[?2004h";
+const char BRACKETED_PASTE_OFF[] = "\033[?2004l";
+const int FATAL_SIGNALS[] = { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL };
+const size_t READ_CHUNK = 4096;
+const size_t MAX_READ_PER_POLL = 64 * 1024;
+
+// Shared with the signal handlers, which may only use async-signal-safe
+// calls (tcsetattr, write, raise)
+struct termios savedTermios;
+struct termios rawTermios;
+bool bracketedPaste = false;
+volatile sig_atomic_t rawActive = 0;
+volatile sig_atomic_t resumeRaw = 0;    // Raw mode was on when Ctrl-Z stopped us
+bool handlersInstalled = false;
+
+void writeAll(const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(STDOUT_FILENO, data, size);
+        if (written <= 0) {
+            if (written < 0 && errno == EINTR) continue;
+            return;
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+}
+
+void enterRawMode() {
+    tcsetattr(STDIN_FILENO, TCSANOW, &rawTermios);
+    if (bracketedPaste) {
+        writeAll(BRACKETED_PASTE_ON, sizeof(BRACKETED_PASTE_ON) - 1);
+    }
+    rawActive = 1;
+}
+
+void leaveRawMode() {
+    if (!rawActive) {
+        return;
+    }
+    rawActive = 0;
+    int savedErrno = errno;
+    if (bracketedPaste) {
+        writeAll(BRACKETED_PASTE_OFF, sizeof(BRACKETED_PASTE_OFF) - 1);
+    }
+    tcsetattr(STDIN_FILENO, TCSANOW, &savedTermios);
+    errno = savedErrno;
+}
+
+void restoreAtExit() {
+    resumeRaw = 0;
+    leaveRawMode();
+}
+
+void handleFatalSignal(int signo) {
+    // SA_RESETHAND already put back the default action, so this dies as it would have
+    leaveRawMode();
+    raise(signo);
+}
+
+void handleStop(int signo) {
+    resumeRaw = rawActive;
+    leaveRawMode();
+
+    // Stop for real with the default action, then take Ctrl-Z back on resume
+    signal(signo, SIG_DFL);
+    sigset_t unblock;
+    sigemptyset(&unblock);
+    sigaddset(&unblock, signo);
+    sigprocmask(SIG_UNBLOCK, &unblock, NULL);
+    raise(signo);
+    signal(signo, handleStop);
+}
+
+void handleContinue(int) {
+    // In the background, tcsetattr would stop us again with SIGTTOU
+    if (resumeRaw && tcgetpgrp(STDIN_FILENO) == getpgrp()) {
+        int savedErrno = errno;
+        resumeRaw = 0;
+        enterRawMode();
+        errno = savedErrno;
+    }
+}
+
+void installHandlers() {
+    if (handlersInstalled) {
+        return;
+    }
+    handlersInstalled = true;
+    atexit(restoreAtExit);
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    sigemptyset(&action.sa_mask);
+    action.sa_handler = handleFatalSignal;
+    action.sa_flags = SA_RESETHAND | SA_NODEFER;
+    for (size_t i = 0; i < sizeof(FATAL_SIGNALS) / sizeof(FATAL_SIGNALS[0]); i++) {
+        sigaction(FATAL_SIGNALS[i], &action, NULL);
+    }
+
+    action.sa_flags = SA_RESTART;
+    action.sa_handler = handleStop;
+    sigaction(SIGTSTP, &action, NULL);
+    action.sa_handler = handleContinue;
+    sigaction(SIGCONT, &action, NULL);
+}
+
+} // namespace
+
+TerminalInput::TerminalInput() : enabled_(false), endOfInput_(false) {
+}
+
+TerminalInput::~TerminalInput() {
+    restore();
+}
+
+bool TerminalInput::enable() {
+    if (enabled_) {
+        return true;
+    }
+    if (!isatty(STDIN_FILENO)) {
+        return false;
+    }
+    if (tcgetattr(STDIN_FILENO, &savedTermios) != 0) {
+        lastError_ = std::string("tcgetattr: ") + strerror(errno);
+        return false;
+    }
+
+    rawTermios = savedTermios;
+    rawTermios.c_lflag &= ~(ICANON | ECHO);
+    rawTermios.c_iflag &= ~(IXON | ICRNL);  // Enter arrives as "\r"; the decoder takes either
+    rawTermios.c_cc[VMIN] = 0;
+    rawTermios.c_cc[VTIME] = 0;
+    bracketedPaste = isatty(STDOUT_FILENO);
+
+    installHandlers();
+    enterRawMode();
+
+    struct termios applied;
+    if (tcgetattr(STDIN_FILENO, &applied) != 0 || (applied.c_lflag & (ICANON | ECHO)) != 0) {
+        leaveRawMode();
+        lastError_ = "terminal refused non-canonical mode";
+        return false;
+    }
+
+    decoder_.clear();
+    enabled_ = true;
+    endOfInput_ = false;
+    return true;
+}
+
+void TerminalInput::restore() {
+    if (!enabled_) {
+        return;
+    }
+    enabled_ = false;
+    resumeRaw = 0;
+    leaveRawMode();
+}
+
+bool TerminalInput::wait(int timeoutMs) {
+    if (!enabled_ || endOfInput_) {
+        if (timeoutMs > 0) {
+            usleep(timeoutMs * 1000);
+        }
+        return false;
+    }
+
+    bool pendingEscape = decoder_.hasPendingEscape();
+    if (pendingEscape && timeoutMs > KeyDecoder::ESCAPE_TIMEOUT_MS) {
+        timeoutMs = KeyDecoder::ESCAPE_TIMEOUT_MS;
+    }
+
+    struct pollfd pfd;
+    pfd.fd = STDIN_FILENO;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    int ready = ::poll(&pfd, 1, timeoutMs);
+    if (ready > 0 && (pfd.revents & (POLLHUP | POLLERR | POLLNVAL)) && !(pfd.revents & POLLIN)) {
+        endOfInput_ = true; // Terminal hung up
+        return false;
+    }
+    return ready > 0 || (ready == 0 && pendingEscape);
+}
+
+size_t TerminalInput::poll(std::vector<KeyEvent>& events) {
+    if (!enabled_) {
+        return 0;
+    }
+
+    // VMIN = VTIME = 0: read returns at once, with 0 bytes when nothing is there
+    char buffer[READ_CHUNK];
+    size_t total = 0;
+    long long now = MonotonicClock::nowMs();
+    while (!endOfInput_ && total < MAX_READ_PER_POLL) {
+        ssize_t got = read(STDIN_FILENO, buffer, sizeof(buffer));
+        if (got > 0) {
+            decoder_.append(buffer, (size_t)got, now);
+            total += (size_t)got;
+            if ((size_t)got < sizeof(buffer)) break;
+        } else {
+            if (got < 0 && errno != EINTR && errno != EAGAIN) {
+                endOfInput_ = true;
+            }
+            break;
+        }
+    }
+
+    size_t before = events.size();
+    KeyEvent event;
+    while (decoder_.next(event, now)) {
+        events.push_back(event);
+    }
+    return events.size() - before;
+}
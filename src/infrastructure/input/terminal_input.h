@@ -0,0 +1,51 @@
+#ifndef TERMINAL_INPUT_H
+#define TERMINAL_INPUT_H
+
+#include "infrastructure/input/key_decoder.h"
+#include <string>
+#include <vector>
+
+// Keystroke input from the controlling terminal. enable() turns off
+// canonical mode and echo on stdin, so every key arrives as soon as it is
+// pressed instead of after Enter, and turns on bracketed paste. Ctrl-C and
+// Ctrl-Z still send their signals (ISIG stays on); only flow control
+// (Ctrl-S/Ctrl-Q) is off, so a stray Ctrl-S can't freeze the console and
+// the render loop with it.
+//
+// The terminal goes back to how it was on restore(), on destruction, at
+// exit() and when the process dies of SIGSEGV, SIGABRT, SIGBUS, SIGFPE or
+// SIGILL (the handler restores, then re-raises). Ctrl-Z restores the shell's
+// settings before stopping, and raw mode comes back on SIGCONT if the
+// process is in the foreground again. Only one TerminalInput may be enabled
+// at a time.
+class TerminalInput {
+public:
+    TerminalInput();
+    ~TerminalInput();
+
+    // False, with nothing changed, when stdin is not a terminal
+    bool enable();
+    void restore();
+    bool isEnabled() const { return enabled_; }
+
+    // Block up to timeoutMs until a key is readable (or a lone Escape is due
+    // to time out). False on timeout, interruption or closed input.
+    bool wait(int timeoutMs);
+
+    // Read what has arrived and append the decoded events; never blocks
+    size_t poll(std::vector<KeyEvent>& events);
+
+    std::string getLastError() const { return lastError_; }
+
+private:
+    KeyDecoder decoder_;
+    bool enabled_;
+    bool endOfInput_;
+    std::string lastError_;
+
+    // Disable copy constructor and assignment operator
+    TerminalInput(const TerminalInput&) = delete;
+    TerminalInput& operator=(const TerminalInput&) = delete;
+};
+
+#endif // TERMINAL_INPUT_H
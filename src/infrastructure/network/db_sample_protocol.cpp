@@ -0,0 +1,47 @@
+#include "db_sample_protocol.h"
+
+namespace {
+
+const uint8_t MAGIC_0 = 'D';
+const uint8_t MAGIC_1 = 'B';
+
+} // namespace
+
+size_t DbSampleProtocol::encodePacket(uint8_t* out, size_t capacity, uint8_t channel, uint32_t sequence,
+                                      const uint16_t* samples, uint16_t count) {
+    size_t size = HEADER_SIZE + (size_t)count * 2;
+    if (size > capacity || size > MAX_PACKET_SIZE) {
+        return 0;
+    }
+
+    out[0] = MAGIC_0;
+    out[1] = MAGIC_1;
+    out[2] = VERSION;
+    out[3] = channel;
+    out[4] = (uint8_t)(sequence >> 24);
+    out[5] = (uint8_t)(sequence >> 16);
+    out[6] = (uint8_t)(sequence >> 8);
+    out[7] = (uint8_t)sequence;
+    out[8] = (uint8_t)(count >> 8);
+    out[9] = (uint8_t)count;
+
+    uint8_t* p = out + HEADER_SIZE;
+    for (uint16_t i = 0; i < count; i++) {
+        *p++ = (uint8_t)(samples[i] >> 8);
+        *p++ = (uint8_t)samples[i];
+    }
+    return size;
+}
+
+bool DbSampleProtocol::decodeHeader(const uint8_t* data, size_t size, Header& out) {
+    if (size < HEADER_SIZE || data[0] != MAGIC_0 || data[1] != MAGIC_1 || data[2] != VERSION) {
+        return false;
+    }
+
+    out.channel = data[3];
+    out.sequence = ((uint32_t)data[4] << 24) | ((uint32_t)data[5] << 16) |
+                   ((uint32_t)data[6] << 8) | data[7];
+    out.count = (uint16_t)((data[8] << 8) | data[9]);
+
+    return out.count <= MAX_SAMPLES_PER_PACKET && size == HEADER_SIZE + (size_t)out.count * 2;
+}
@@ -0,0 +1,43 @@
+#ifndef DB_SAMPLE_PROTOCOL_H
+#define DB_SAMPLE_PROTOCOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Datagram format for high-rate sound level samples (one UDP packet each):
+//
+//   magic "DB" | version | channel | sequence (u32) | count (u16) | count x u16
+//
+// All integers are big-endian. Samples are hundredths of a dB. The sequence
+// number increments per packet and channel so the receiver can count loss.
+// Encoding and decoding work on caller-provided buffers and never allocate.
+class DbSampleProtocol {
+public:
+    struct Header {
+        uint8_t channel;
+        uint32_t sequence;
+        uint16_t count;
+
+        Header() : channel(0), sequence(0), count(0) {}
+    };
+
+    // Returns the packet size, or 0 if it doesn't fit in `capacity`
+    static size_t encodePacket(uint8_t* out, size_t capacity, uint8_t channel, uint32_t sequence,
+                               const uint16_t* samples, uint16_t count);
+
+    // Validates magic, version and length; samples follow at HEADER_SIZE
+    static bool decodeHeader(const uint8_t* data, size_t size, Header& out);
+    static uint16_t sampleAt(const uint8_t* data, size_t index) {
+        const uint8_t* p = data + HEADER_SIZE + index * 2;
+        return (uint16_t)((p[0] << 8) | p[1]);
+    }
+
+    static const uint8_t VERSION = 1;
+    static const size_t HEADER_SIZE = 10;
+    static const size_t MAX_PACKET_SIZE = 1472;  // Fits a 1500-byte MTU
+    static const uint16_t MAX_SAMPLES_PER_PACKET = (MAX_PACKET_SIZE - HEADER_SIZE) / 2;
+    static const uint16_t MAX_CENTI_DB = 12000;
+    static const int DEFAULT_PORT = 7406;
+};
+
+#endif // DB_SAMPLE_PROTOCOL_H
@@ -0,0 +1,175 @@
+#include "db_sample_receiver.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <chrono>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+namespace {
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+long long nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+DbSampleReceiver::DbSampleReceiver(int port, DbSampleRing* ring)
+    : port_(port), ring_(ring), socketFd_(-1), running_(false), startedAtMs_(0),
+      packetCount_(0), sampleCount_(0), malformedCount_(0), lostPacketCount_(0) {
+    wakePipe_[0] = -1;
+    wakePipe_[1] = -1;
+    std::memset(nextSequence_, 0, sizeof(nextSequence_));
+    std::memset(channelSeen_, 0, sizeof(channelSeen_));
+}
+
+DbSampleReceiver::~DbSampleReceiver() {
+    stop();
+}
+
+bool DbSampleReceiver::start() {
+    if (running_) {
+        return true;
+    }
+    if (!ring_) {
+        lastError_ = "No sample ring";
+        return false;
+    }
+
+    socketFd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    if (socketFd_ < 0) {
+        lastError_ = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+
+    // Absorb bursts while the receive thread is descheduled
+    int bufferBytes = RECEIVE_BUFFER_BYTES;
+    setsockopt(socketFd_, SOL_SOCKET, SO_RCVBUF, &bufferBytes, sizeof(bufferBytes));
+
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port_);
+
+    if (bind(socketFd_, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        !setNonBlocking(socketFd_) || pipe(wakePipe_) != 0) {
+        lastError_ = std::string("Cannot bind UDP port ") + std::to_string(port_) + ": " + std::strerror(errno);
+        close(socketFd_);
+        socketFd_ = -1;
+        return false;
+    }
+
+    startedAtMs_ = nowMs();
+    running_ = true;
+    receiveThread_ = std::thread(&DbSampleReceiver::receiveLoop, this);
+
+    std::cout << "🎚️  dB sample receiver listening on UDP port " << port_ << std::endl;
+    return true;
+}
+
+void DbSampleReceiver::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    char wake = 1;
+    if (write(wakePipe_[1], &wake, 1) < 0) {
+        // Thread still exits on its next poll timeout
+    }
+
+    if (receiveThread_.joinable()) {
+        receiveThread_.join();
+    }
+
+    close(socketFd_);
+    close(wakePipe_[0]);
+    close(wakePipe_[1]);
+    socketFd_ = -1;
+    wakePipe_[0] = -1;
+    wakePipe_[1] = -1;
+}
+
+void DbSampleReceiver::receiveLoop() {
+    struct pollfd fds[2];
+    fds[0].fd = socketFd_;
+    fds[0].events = POLLIN;
+    fds[1].fd = wakePipe_[0];
+    fds[1].events = POLLIN;
+
+    while (running_) {
+        if (poll(fds, 2, 500) <= 0 || (fds[1].revents & POLLIN)) {
+            continue;
+        }
+
+        // Drain everything queued before sleeping again
+        while (running_) {
+            ssize_t size = recv(socketFd_, packet_, sizeof(packet_), 0);
+            if (size < 0) {
+                break;  // EAGAIN: queue empty
+            }
+            handlePacket((size_t)size);
+        }
+    }
+}
+
+void DbSampleReceiver::handlePacket(size_t size) {
+    DbSampleProtocol::Header header;
+    if (!DbSampleProtocol::decodeHeader(packet_, size, header)) {
+        malformedCount_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Count packets the sender numbered but we never saw; reordered or
+    // duplicate packets are accepted without moving the expectation back
+    if (channelSeen_[header.channel]) {
+        int32_t gap = (int32_t)(header.sequence - nextSequence_[header.channel]);
+        if (gap > 0) {
+            lostPacketCount_.fetch_add((unsigned long)gap, std::memory_order_relaxed);
+        }
+        if (gap >= 0) {
+            nextSequence_[header.channel] = header.sequence + 1;
+        }
+    } else {
+        channelSeen_[header.channel] = true;
+        nextSequence_[header.channel] = header.sequence + 1;
+    }
+
+    for (uint16_t i = 0; i < header.count; i++) {
+        uint16_t value = DbSampleProtocol::sampleAt(packet_, i);
+        if (value > DbSampleProtocol::MAX_CENTI_DB) {
+            value = DbSampleProtocol::MAX_CENTI_DB;
+        }
+        batch_[i] = DbSample(value, header.channel);
+    }
+    ring_->pushBatch(batch_, header.count);
+
+    packetCount_.fetch_add(1, std::memory_order_relaxed);
+    sampleCount_.fetch_add(header.count, std::memory_order_relaxed);
+}
+
+void DbSampleReceiver::printReport(std::ostream& out) const {
+    double seconds = running_ ? (nowMs() - startedAtMs_) / 1000.0 : 0.0;
+    unsigned long samples = getSampleCount();
+
+    out << "\033[1;36m🎚️  dB sample ingestion (UDP port " << port_ << ")\033[0m" << std::endl;
+    out << "  packets:  " << getPacketCount() << " (" << getLostPacketCount() << " lost, "
+        << getMalformedCount() << " malformed)" << std::endl;
+    out << "  samples:  " << samples;
+    if (seconds > 0) {
+        out << " (" << (unsigned long)(samples / seconds) << "/s average)";
+    }
+    out << std::endl;
+    out << "  ring:     " << ring_->size() << "/" << ring_->capacity() << " queued, "
+        << ring_->getDroppedCount() << " dropped when full" << std::endl;
+}
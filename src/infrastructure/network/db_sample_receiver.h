@@ -0,0 +1,66 @@
+#ifndef DB_SAMPLE_RECEIVER_H
+#define DB_SAMPLE_RECEIVER_H
+
+#include "infrastructure/network/db_sample_protocol.h"
+#include "shared/utils/db_sample.h"
+#include <ostream>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <stdint.h>
+
+// Receives DbSampleProtocol datagrams on a UDP port and pushes the samples
+// into a DbSampleRing (the ring is owned by the caller). Runs on its own
+// thread; the hot path reuses fixed buffers and never allocates or locks,
+// so the render thread only ever touches the ring.
+class DbSampleReceiver {
+public:
+    DbSampleReceiver(int port, DbSampleRing* ring);
+    ~DbSampleReceiver();
+
+    // Lifecycle
+    bool start();
+    void stop();
+
+    // Diagnostics
+    unsigned long getPacketCount() const { return packetCount_.load(); }
+    unsigned long getSampleCount() const { return sampleCount_.load(); }
+    unsigned long getMalformedCount() const { return malformedCount_.load(); }
+    unsigned long getLostPacketCount() const { return lostPacketCount_.load(); }
+    void printReport(std::ostream& out) const;
+    std::string getLastError() const { return lastError_; }
+
+    static const int RECEIVE_BUFFER_BYTES = 1024 * 1024;
+
+private:
+    int port_;
+    DbSampleRing* ring_;
+    int socketFd_;
+    int wakePipe_[2];
+    std::string lastError_;
+
+    std::thread receiveThread_;
+    std::atomic<bool> running_;
+    long long startedAtMs_;
+
+    // Receive thread state (only touched by the receive thread)
+    uint8_t packet_[DbSampleProtocol::MAX_PACKET_SIZE + 1];
+    DbSample batch_[DbSampleProtocol::MAX_SAMPLES_PER_PACKET];
+    uint32_t nextSequence_[256];
+    bool channelSeen_[256];
+
+    std::atomic<unsigned long> packetCount_;
+    std::atomic<unsigned long> sampleCount_;
+    std::atomic<unsigned long> malformedCount_;
+    std::atomic<unsigned long> lostPacketCount_;
+
+    // Helper methods
+    void receiveLoop();
+    void handlePacket(size_t size);
+
+    // Disable copy constructor and assignment operator
+    DbSampleReceiver(const DbSampleReceiver&) = delete;
+    DbSampleReceiver& operator=(const DbSampleReceiver&) = delete;
+};
+
+#endif // DB_SAMPLE_RECEIVER_H
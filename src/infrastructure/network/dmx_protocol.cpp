@@ -0,0 +1,241 @@
+#include "dmx_protocol.h"
+#include <cstring>
+
+namespace {
+
+const uint8_t ART_NET_ID[8] = { 'A', 'r', 't', '-', 'N', 'e', 't', 0 };
+const uint16_t OP_DMX = 0x5000;
+const uint16_t OP_SYNC = 0x5200;
+const uint8_t ART_NET_VERSION = 14;
+const size_t ART_DMX_HEADER = 18;
+const size_t ART_SYNC_SIZE = 14;
+
+const uint8_t ACN_ID[12] = { 'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0 };
+const uint32_t VECTOR_ROOT_DATA = 0x00000004;
+const uint32_t VECTOR_ROOT_EXTENDED = 0x00000008;
+const uint32_t VECTOR_FRAMING_DATA = 0x00000002;
+const uint32_t VECTOR_FRAMING_SYNC = 0x00000001;
+const uint8_t VECTOR_DMP_SET_PROPERTY = 0x02;
+const uint8_t DMP_ADDRESS_TYPE = 0xa1;
+const size_t SACN_ROOT_SIZE = 38;      // Up to and including the CID
+const size_t SACN_DATA_HEADER = 126;   // Up to and including the start code
+const size_t SACN_SYNC_SIZE = 49;
+const size_t SOURCE_NAME_SIZE = 64;
+const uint8_t SACN_DEFAULT_PRIORITY = 100;
+const uint8_t OPTION_PREVIEW = 0x80;
+const uint8_t OPTION_TERMINATED = 0x40;
+
+uint16_t readU16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+uint32_t readU32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+void putU16(uint8_t* p, uint16_t value) {
+    p[0] = (uint8_t)(value >> 8);
+    p[1] = (uint8_t)value;
+}
+
+void putU32(uint8_t* p, uint32_t value) {
+    putU16(p, (uint16_t)(value >> 16));
+    putU16(p + 2, (uint16_t)value);
+}
+
+// ACN PDU lengths count from the PDU's own flags field to the end of the packet
+void putFlagsAndLength(uint8_t* p, size_t pduSize) {
+    putU16(p, (uint16_t)(0x7000 | (pduSize & 0x0FFF)));
+}
+
+bool hasFlagsAndLength(const uint8_t* p, size_t pduSize) {
+    uint16_t value = readU16(p);
+    return (value & 0xF000) == 0x7000 && (value & 0x0FFF) == pduSize;
+}
+
+size_t putSacnRoot(uint8_t* out, size_t totalSize, uint32_t vector, const uint8_t* cid) {
+    putU16(out, 0x0010);          // Preamble size
+    putU16(out + 2, 0x0000);      // Post-amble size
+    std::memcpy(out + 4, ACN_ID, sizeof(ACN_ID));
+    putFlagsAndLength(out + 16, totalSize - 16);
+    putU32(out + 18, vector);
+    std::memcpy(out + 22, cid, DmxProtocol::CID_SIZE);
+    return SACN_ROOT_SIZE;
+}
+
+bool decodeArtNet(const uint8_t* buffer, size_t size, DmxProtocol::Packet& out) {
+    if (size < ART_SYNC_SIZE || std::memcmp(buffer, ART_NET_ID, sizeof(ART_NET_ID)) != 0 ||
+        buffer[11] < ART_NET_VERSION) {
+        return false;
+    }
+
+    uint16_t opcode = (uint16_t)(buffer[8] | (buffer[9] << 8));
+    if (opcode == OP_SYNC) {
+        out.kind = DmxProtocol::SYNC;
+        return true;
+    }
+    if (opcode != OP_DMX || size < ART_DMX_HEADER) {
+        return false;
+    }
+
+    uint16_t length = readU16(buffer + 16);
+    if (length < 2 || length > DmxProtocol::CHANNELS_PER_UNIVERSE || ART_DMX_HEADER + length > size) {
+        return false;
+    }
+    out.kind = DmxProtocol::DATA;
+    out.sequence = buffer[12];
+    out.universe = (uint16_t)(((buffer[15] & 0x7F) << 8) | buffer[14]);
+    out.data = buffer + ART_DMX_HEADER;
+    out.size = length;
+    out.priority = SACN_DEFAULT_PRIORITY;
+    out.syncAddress = 0;
+    return true;
+}
+
+bool decodeSacn(const uint8_t* buffer, size_t size, DmxProtocol::Packet& out) {
+    if (size < SACN_SYNC_SIZE || readU16(buffer) != 0x0010 ||
+        std::memcmp(buffer + 4, ACN_ID, sizeof(ACN_ID)) != 0 || !hasFlagsAndLength(buffer + 16, size - 16)) {
+        return false;
+    }
+
+    uint32_t rootVector = readU32(buffer + 18);
+    if (rootVector == VECTOR_ROOT_EXTENDED) {
+        if (!hasFlagsAndLength(buffer + 38, size - 38) || readU32(buffer + 40) != VECTOR_FRAMING_SYNC) {
+            return false;  // Universe discovery and the like
+        }
+        out.kind = DmxProtocol::SYNC;
+        out.sequence = buffer[44];
+        out.syncAddress = readU16(buffer + 45);
+        return true;
+    }
+    if (rootVector != VECTOR_ROOT_DATA || size < SACN_DATA_HEADER ||
+        !hasFlagsAndLength(buffer + 38, size - 38) || readU32(buffer + 40) != VECTOR_FRAMING_DATA ||
+        !hasFlagsAndLength(buffer + 115, size - 115) || buffer[117] != VECTOR_DMP_SET_PROPERTY ||
+        buffer[118] != DMP_ADDRESS_TYPE) {
+        return false;
+    }
+
+    uint8_t options = buffer[112];
+    uint16_t universe = readU16(buffer + 113);
+    uint16_t values = readU16(buffer + 123);   // Start code plus slots
+    if ((options & (OPTION_PREVIEW | OPTION_TERMINATED)) || universe == 0 || universe > DmxProtocol::MAX_SACN_UNIVERSE ||
+        values < 1 || values > DmxProtocol::CHANNELS_PER_UNIVERSE + 1 || SACN_DATA_HEADER - 1 + values != size ||
+        buffer[125] != 0) {
+        return false;
+    }
+    out.kind = DmxProtocol::DATA;
+    out.priority = buffer[108];
+    out.syncAddress = readU16(buffer + 109);
+    out.sequence = buffer[111];
+    out.universe = universe;
+    out.data = buffer + SACN_DATA_HEADER;
+    out.size = (uint16_t)(values - 1);
+    return true;
+}
+
+} // namespace
+
+bool DmxProtocol::decode(Protocol protocol, const uint8_t* buffer, size_t size, Packet& out) {
+    return protocol == ART_NET ? decodeArtNet(buffer, size, out) : decodeSacn(buffer, size, out);
+}
+
+size_t DmxProtocol::encodeArtDmx(uint8_t* out, size_t capacity, uint16_t universe, uint8_t sequence,
+                                 const uint8_t* slots, uint16_t count) {
+    // ArtDmx lengths are even; an odd count gets a zero pad slot
+    uint16_t length = (uint16_t)((count + 1) & ~1);
+    if (length < 2) {
+        length = 2;
+    }
+    size_t size = ART_DMX_HEADER + length;
+    if (length > CHANNELS_PER_UNIVERSE || size > capacity || universe > MAX_ART_NET_UNIVERSE) {
+        return 0;
+    }
+
+    std::memcpy(out, ART_NET_ID, sizeof(ART_NET_ID));
+    out[8] = (uint8_t)(OP_DMX & 0xFF);
+    out[9] = (uint8_t)(OP_DMX >> 8);
+    out[10] = 0;
+    out[11] = ART_NET_VERSION;
+    out[12] = sequence;
+    out[13] = 0;                        // Physical input port
+    out[14] = (uint8_t)(universe & 0xFF);
+    out[15] = (uint8_t)(universe >> 8);
+    putU16(out + 16, length);
+    std::memcpy(out + ART_DMX_HEADER, slots, count);
+    std::memset(out + ART_DMX_HEADER + count, 0, length - count);
+    return size;
+}
+
+size_t DmxProtocol::encodeArtSync(uint8_t* out, size_t capacity) {
+    if (capacity < ART_SYNC_SIZE) {
+        return 0;
+    }
+    std::memcpy(out, ART_NET_ID, sizeof(ART_NET_ID));
+    out[8] = (uint8_t)(OP_SYNC & 0xFF);
+    out[9] = (uint8_t)(OP_SYNC >> 8);
+    out[10] = 0;
+    out[11] = ART_NET_VERSION;
+    out[12] = 0;
+    out[13] = 0;
+    return ART_SYNC_SIZE;
+}
+
+size_t DmxProtocol::encodeSacnData(uint8_t* out, size_t capacity, const uint8_t* cid, const char* sourceName,
+                                   uint16_t universe, uint8_t sequence, uint16_t syncAddress,
+                                   const uint8_t* slots, uint16_t count) {
+    size_t size = SACN_DATA_HEADER + count;
+    if (count > CHANNELS_PER_UNIVERSE || size > capacity || universe == 0 || universe > MAX_SACN_UNIVERSE) {
+        return 0;
+    }
+
+    putSacnRoot(out, size, VECTOR_ROOT_DATA, cid);
+
+    putFlagsAndLength(out + 38, size - 38);
+    putU32(out + 40, VECTOR_FRAMING_DATA);
+    std::memset(out + 44, 0, SOURCE_NAME_SIZE);
+    std::strncpy((char*)out + 44, sourceName, SOURCE_NAME_SIZE - 1);
+    out[108] = SACN_DEFAULT_PRIORITY;
+    putU16(out + 109, syncAddress);
+    out[111] = sequence;
+    out[112] = 0;                       // Options
+    putU16(out + 113, universe);
+
+    putFlagsAndLength(out + 115, size - 115);
+    out[117] = VECTOR_DMP_SET_PROPERTY;
+    out[118] = DMP_ADDRESS_TYPE;
+    putU16(out + 119, 0);               // First property address
+    putU16(out + 121, 1);               // Address increment
+    putU16(out + 123, (uint16_t)(count + 1));
+    out[125] = 0;                       // DMX start code
+    std::memcpy(out + SACN_DATA_HEADER, slots, count);
+    return size;
+}
+
+size_t DmxProtocol::encodeSacnSync(uint8_t* out, size_t capacity, const uint8_t* cid, uint16_t syncAddress,
+                                   uint8_t sequence) {
+    if (capacity < SACN_SYNC_SIZE) {
+        return 0;
+    }
+    putSacnRoot(out, SACN_SYNC_SIZE, VECTOR_ROOT_EXTENDED, cid);
+    putFlagsAndLength(out + 38, SACN_SYNC_SIZE - 38);
+    putU32(out + 40, VECTOR_FRAMING_SYNC);
+    out[44] = sequence;
+    putU16(out + 45, syncAddress);
+    putU16(out + 47, 0);                // Reserved
+    return SACN_SYNC_SIZE;
+}
+
+uint32_t DmxProtocol::sacnMulticastAddress(uint16_t universe) {
+    return (239u << 24) | (255u << 16) | ((uint32_t)(universe >> 8) << 8) | (universe & 0xFF);
+}
+
+bool DmxProtocol::parseProtocol(const char* name, Protocol& out) {
+    if (std::strcmp(name, "artnet") == 0 || std::strcmp(name, "art-net") == 0) {
+        out = ART_NET;
+    } else if (std::strcmp(name, "sacn") == 0 || std::strcmp(name, "e131") == 0) {
+        out = SACN;
+    } else {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,76 @@
+#ifndef DMX_PROTOCOL_H
+#define DMX_PROTOCOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The two ways lighting desks send DMX over UDP, as far as a pixel display
+// needs them:
+//
+//   Art-Net 4 (port 6454): ArtDmx carries one universe, ArtSync tells all
+//   receivers to show what they got. Header "Art-Net\0", opcode little-endian,
+//   everything else big-endian. Universes are 15-bit port addresses.
+//
+//   E1.31 / sACN (port 5568, multicast 239.255.<hi>.<lo> per universe): a
+//   data packet is the root layer, framing layer (priority, sync address,
+//   sequence, options, universe 1-63999) and DMP layer with start code and
+//   slots. A universe sync packet (E1.31-2016) releases synchronized data.
+//
+// Decoding validates the headers and points Packet::data into the caller's
+// buffer; encoding writes into a caller-provided buffer. Neither allocates.
+class DmxProtocol {
+public:
+    enum Protocol {
+        ART_NET,
+        SACN
+    };
+
+    enum Kind {
+        DATA,    // DMX slots for one universe
+        SYNC     // Show the data received so far
+    };
+
+    struct Packet {
+        Kind kind;
+        uint16_t universe;     // DATA only
+        const uint8_t* data;   // Slot 1 onwards, in the decoded buffer
+        uint16_t size;         // Slot count, at most CHANNELS_PER_UNIVERSE
+        uint8_t sequence;      // 0 = not sequenced (Art-Net)
+        uint8_t priority;      // sACN only, 100 by default
+        uint16_t syncAddress;  // sACN: universe whose sync packet releases this data, 0 = none
+
+        Packet() : kind(DATA), universe(0), data(nullptr), size(0), sequence(0), priority(0), syncAddress(0) {}
+    };
+
+    // False for packets a display has no use for: other opcodes or vectors,
+    // non-zero start codes, sACN preview data and stream-terminated packets
+    static bool decode(Protocol protocol, const uint8_t* buffer, size_t size, Packet& out);
+
+    // Returns the packet size, or 0 if it doesn't fit in `capacity`
+    static size_t encodeArtDmx(uint8_t* out, size_t capacity, uint16_t universe, uint8_t sequence,
+                               const uint8_t* slots, uint16_t count);
+    static size_t encodeArtSync(uint8_t* out, size_t capacity);
+    static size_t encodeSacnData(uint8_t* out, size_t capacity, const uint8_t* cid, const char* sourceName,
+                                 uint16_t universe, uint8_t sequence, uint16_t syncAddress,
+                                 const uint8_t* slots, uint16_t count);
+    static size_t encodeSacnSync(uint8_t* out, size_t capacity, const uint8_t* cid, uint16_t syncAddress,
+                                 uint8_t sequence);
+
+    // 239.255.<hi>.<lo>, host byte order
+    static uint32_t sacnMulticastAddress(uint16_t universe);
+
+    // Port and first universe usually configured on each desk
+    static int defaultPort(Protocol protocol) { return protocol == ART_NET ? ART_NET_PORT : SACN_PORT; }
+    static int defaultFirstUniverse(Protocol protocol) { return protocol == ART_NET ? 0 : 1; }
+    static bool parseProtocol(const char* name, Protocol& out);
+
+    static const int ART_NET_PORT = 6454;
+    static const int SACN_PORT = 5568;
+    static const uint16_t CHANNELS_PER_UNIVERSE = 512;
+    static const uint16_t MAX_ART_NET_UNIVERSE = 32767;
+    static const uint16_t MAX_SACN_UNIVERSE = 63999;
+    static const size_t CID_SIZE = 16;
+    static const size_t MAX_PACKET_SIZE = 638;   // sACN data with 512 slots
+};
+
+#endif // DMX_PROTOCOL_H
@@ -0,0 +1,274 @@
+#include "dmx_receiver.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <netinet/in.h>
+
+DmxReceiver::DmxReceiver(DmxProtocol::Protocol protocol, int port, int firstUniverse, int universeCount, Clock* clock)
+    : protocol_(protocol), port_(port), firstUniverse_(firstUniverse), universeCount_(universeCount),
+      clock_(clock ? clock : Clock::monotonic()), socketFd_(-1), joinedGroups_(0),
+      lastSyncMs_(0), pendingSinceMs_(-1), arrived_(0), sequenced_(0), startedAtMs_(0),
+      packets_(0), frames_(0), syncs_(0), ignored_(0), unmapped_(0), outOfOrder_(0), largestBatch_(0) {
+    if (universeCount_ > 64) {
+        universeCount_ = 64;  // One bit each in arrived_
+    }
+    allUniverses_ = universeCount_ == 64 ? ~(uint64_t)0 : (((uint64_t)1 << universeCount_) - 1);
+
+    int buffers = BATCH_SIZE + universeCount_;
+    storage_.resize((size_t)buffers * BUFFER_SIZE);
+    free_.reserve(buffers);
+    for (int i = buffers - 1; i >= 0; i--) {
+        free_.push_back(i);
+    }
+    latest_.assign(universeCount_, -1);
+    latestSlots_.assign(universeCount_, nullptr);
+    latestSizes_.assign(universeCount_, 0);
+    lastSequence_.assign(universeCount_, 0);
+    std::memset(messages_, 0, sizeof(messages_));
+}
+
+DmxReceiver::~DmxReceiver() {
+    stop();
+}
+
+bool DmxReceiver::start() {
+    if (socketFd_ >= 0) {
+        return true;
+    }
+
+    socketFd_ = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (socketFd_ < 0) {
+        lastError_ = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+
+    // Visualizers on the same host may listen too; bursts of a whole frame
+    // arrive while the render loop waits for vsync
+    int enable = 1;
+    setsockopt(socketFd_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    int bufferBytes = RECEIVE_BUFFER_BYTES;
+    setsockopt(socketFd_, SOL_SOCKET, SO_RCVBUF, &bufferBytes, sizeof(bufferBytes));
+
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port_);
+    if (bind(socketFd_, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        lastError_ = std::string("Cannot bind UDP port ") + std::to_string(port_) + ": " + std::strerror(errno);
+        stop();
+        return false;
+    }
+
+    // sACN is multicast per universe; unicast senders work without joining.
+    // Linux allows 20 groups per socket (igmp_max_memberships), so further
+    // groups are held by extra sockets. This one still receives them all,
+    // since IP_MULTICAST_ALL is on by default.
+    if (protocol_ == DmxProtocol::SACN) {
+        int holder = socketFd_;
+        for (int i = 0; i < universeCount_; i++) {
+            struct ip_mreq group;
+            std::memset(&group, 0, sizeof(group));
+            group.imr_multiaddr.s_addr = htonl(DmxProtocol::sacnMulticastAddress((uint16_t)(firstUniverse_ + i)));
+            group.imr_interface.s_addr = htonl(INADDR_ANY);
+            bool joined = setsockopt(holder, IPPROTO_IP, IP_ADD_MEMBERSHIP, &group, sizeof(group)) == 0;
+            if (!joined && errno == ENOBUFS) {
+                holder = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+                if (holder < 0) {
+                    break;
+                }
+                groupFds_.push_back(holder);
+                joined = setsockopt(holder, IPPROTO_IP, IP_ADD_MEMBERSHIP, &group, sizeof(group)) == 0;
+            }
+            if (joined) {
+                joinedGroups_++;
+            }
+        }
+        if (joinedGroups_ < universeCount_) {
+            std::cerr << "⚠️  sACN: joined " << joinedGroups_ << " of " << universeCount_
+                      << " multicast groups; unicast still works" << std::endl;
+        }
+    }
+
+    startedAtMs_ = clock_->nowMs();
+    return true;
+}
+
+void DmxReceiver::stop() {
+    if (socketFd_ >= 0) {
+        close(socketFd_);  // Leaves the multicast groups too
+        socketFd_ = -1;
+        joinedGroups_ = 0;
+    }
+    for (size_t i = 0; i < groupFds_.size(); i++) {
+        close(groupFds_[i]);
+    }
+    groupFds_.clear();
+}
+
+void DmxReceiver::poll(Listener& listener) {
+    if (socketFd_ < 0) {
+        return;
+    }
+
+    // The pool always has BATCH_SIZE buffers free: the rest are held one per universe
+    for (int i = 0; i < BATCH_SIZE; i++) {
+        int buffer = free_.back();
+        free_.pop_back();
+        batchBuffers_[i] = buffer;
+        iovecs_[i].iov_base = bufferAt(buffer);
+        iovecs_[i].iov_len = BUFFER_SIZE;
+        messages_[i].msg_hdr.msg_iov = &iovecs_[i];
+        messages_[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    int received = recvmmsg(socketFd_, messages_, BATCH_SIZE, MSG_DONTWAIT, nullptr);
+    if (received < 0) {
+        received = 0;  // EAGAIN: nothing queued
+    }
+    long long now = clock_->nowMs();
+    int frameEnd = decodeBatch(received, now);
+
+    for (int i = 0; i < received; i++) {
+        if (i == frameEnd) {
+            present(listener);
+        }
+
+        const Entry& entry = entries_[i];
+        if (entry.index < 0) {
+            continue;
+        }
+        listener.onUniverse(entry.index, entry.slots, entry.size);
+        if (pendingSinceMs_ < 0) {
+            pendingSinceMs_ = now;
+        }
+
+        // Hold this buffer for the universe and release the one it replaces
+        int previous = latest_[entry.index];
+        if (previous >= 0) {
+            free_.push_back(previous);
+        }
+        latest_[entry.index] = entry.buffer;
+        latestSlots_[entry.index] = entry.slots;
+        latestSizes_[entry.index] = entry.size;
+        batchBuffers_[i] = -1;
+    }
+    if (frameEnd == received) {
+        present(listener);
+    }
+
+    for (int i = 0; i < BATCH_SIZE; i++) {
+        if (batchBuffers_[i] >= 0) {
+            free_.push_back(batchBuffers_[i]);
+        }
+    }
+
+    // Unsynced senders that only send what changed
+    bool synced = lastSyncMs_ > 0 && now - lastSyncMs_ < SYNC_TIMEOUT_MS;
+    if (!synced && pendingSinceMs_ >= 0 && now - pendingSinceMs_ >= FRAME_TIMEOUT_MS) {
+        present(listener);
+    }
+}
+
+const uint8_t* DmxReceiver::getLatest(int index, size_t& size) const {
+    if (index < 0 || index >= universeCount_) {
+        size = 0;
+        return nullptr;
+    }
+    size = latestSizes_[index];
+    return latestSlots_[index];
+}
+
+void DmxReceiver::printReport(std::ostream& out) const {
+    static const char* PROTOCOL_NAMES[] = { "Art-Net", "sACN" };
+    double seconds = (clock_->nowMs() - startedAtMs_) / 1000.0;
+    bool synced = lastSyncMs_ > 0 && clock_->nowMs() - lastSyncMs_ < SYNC_TIMEOUT_MS;
+
+    out << "\033[1;36m💡 " << PROTOCOL_NAMES[protocol_] << " on UDP port " << port_ << ", universes "
+        << firstUniverse_ << "-" << (firstUniverse_ + universeCount_ - 1) << "\033[0m" << std::endl;
+    out << "  packets:  " << packets_ << " (" << outOfOrder_ << " out of order, " << unmapped_ << " other universes, "
+        << ignored_ << " ignored), largest batch " << largestBatch_ << std::endl;
+    out << "  frames:   " << frames_;
+    if (seconds > 0) {
+        out << " (" << (int)(frames_ / seconds + 0.5) << "/s average)";
+    }
+    out << ", " << syncs_ << " syncs, " << (synced ? "synchronized" : "unsynchronized") << std::endl;
+}
+
+int DmxReceiver::decodeBatch(int received, long long now) {
+    int frameEnd = -1;
+    packets_ += received;
+    if (received > largestBatch_) {
+        largestBatch_ = received;
+    }
+
+    for (int i = 0; i < received; i++) {
+        Entry& entry = entries_[i];
+        entry.buffer = batchBuffers_[i];
+        entry.index = -1;
+
+        DmxProtocol::Packet packet;
+        if (!DmxProtocol::decode(protocol_, bufferAt(entry.buffer), messages_[i].msg_len, packet)) {
+            ignored_++;
+            continue;
+        }
+        if (packet.kind == DmxProtocol::SYNC) {
+            syncs_++;
+            lastSyncMs_ = now;
+            arrived_ = 0;
+            frameEnd = i + 1;
+            continue;
+        }
+
+        int index = (int)packet.universe - firstUniverse_;
+        if (index < 0 || index >= universeCount_) {
+            unmapped_++;
+            continue;
+        }
+        if (!isInOrder(index, packet.sequence)) {
+            outOfOrder_++;
+            continue;
+        }
+        entry.index = index;
+        entry.slots = packet.data;
+        entry.size = packet.size;
+
+        if (lastSyncMs_ > 0 && now - lastSyncMs_ < SYNC_TIMEOUT_MS) {
+            continue;  // The sync packet ends the frame
+        }
+        uint64_t bit = (uint64_t)1 << index;
+        if (arrived_ & bit) {
+            frameEnd = i;         // Repeated universe: a new frame started
+            arrived_ = 0;
+        }
+        arrived_ |= bit;
+        if (arrived_ == allUniverses_) {
+            frameEnd = i + 1;
+            arrived_ = 0;
+        }
+    }
+    return frameEnd;
+}
+
+bool DmxReceiver::isInOrder(int index, uint8_t sequence) {
+    // Art-Net uses 0 for "not sequenced"; E1.31 drops packets up to 20
+    // behind the last one and takes anything further back as a restart
+    if (protocol_ == DmxProtocol::ART_NET && sequence == 0) {
+        return true;
+    }
+    uint64_t bit = (uint64_t)1 << index;
+    int8_t behind = (int8_t)(sequence - lastSequence_[index]);
+    if ((sequenced_ & bit) && behind <= 0 && behind > -20) {
+        return false;
+    }
+    sequenced_ |= bit;
+    lastSequence_[index] = sequence;
+    return true;
+}
+
+void DmxReceiver::present(Listener& listener) {
+    listener.onFrame(*this);
+    frames_++;
+    pendingSinceMs_ = -1;
+}
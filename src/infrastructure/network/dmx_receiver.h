@@ -0,0 +1,129 @@
+#ifndef DMX_RECEIVER_H
+#define DMX_RECEIVER_H
+
+#include "infrastructure/network/dmx_protocol.h"
+#include "shared/utils/clock.h"
+#include <ostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+// Receives Art-Net or sACN universes on a UDP port, polled from the render
+// loop. Each poll() takes everything queued with one recvmmsg() into a
+// fixed buffer pool and hands the listener views into those buffers:
+//
+//   onUniverse()  slots of one mapped universe, to draw on the offscreen canvas
+//   onFrame()     the frame is complete, swap it onto the panel
+//
+// A frame ends at a sync packet (ArtSync, or an sACN sync packet). Without
+// syncs for SYNC_TIMEOUT_MS the receiver falls back to guessing: a frame
+// ends once every mapped universe has arrived, when a universe arrives a
+// second time, or FRAME_TIMEOUT_MS after the first data of a frame. When a
+// poll finds several frame ends, only the last one is reported, so a loop
+// that fell behind skips frames instead of swapping once per frame.
+//
+// The buffer holding each universe's latest data is kept back from the
+// pool until the next packet for that universe replaces it, so a listener
+// can redraw universes that a freshly swapped-in canvas missed without any
+// slot data being copied. Out-of-order packets (by sequence number) are
+// dropped; sACN priorities are not compared, so use one source per universe.
+class DmxReceiver {
+public:
+    class Listener {
+    public:
+        virtual ~Listener() {}
+        virtual void onUniverse(int index, const uint8_t* slots, size_t size) = 0;
+        virtual void onFrame(const DmxReceiver& receiver) = 0;
+    };
+
+    // Universes firstUniverse..firstUniverse+universeCount-1 map to indexes
+    // 0..universeCount-1; uses the monotonic clock unless given another
+    DmxReceiver(DmxProtocol::Protocol protocol, int port, int firstUniverse, int universeCount,
+                Clock* clock = nullptr);
+    ~DmxReceiver();
+
+    // Lifecycle; sACN joins each mapped universe's multicast group
+    bool start();
+    void stop();
+
+    // Receive what's queued and call the listener; never blocks except
+    // inside the listener
+    void poll(Listener& listener);
+
+    // Latest slots of a universe (nullptr before the first packet); valid
+    // until the next poll()
+    const uint8_t* getLatest(int index, size_t& size) const;
+
+    unsigned long getFrameCount() const { return frames_; }
+    unsigned long getPacketCount() const { return packets_; }
+    std::string getLastError() const { return lastError_; }
+    void printReport(std::ostream& out) const;
+
+    static const int BATCH_SIZE = 128;                // Datagrams per recvmmsg()
+    static const size_t BUFFER_SIZE = 640;            // Fits the largest sACN packet
+    static const int RECEIVE_BUFFER_BYTES = 1024 * 1024;
+    static const int SYNC_TIMEOUT_MS = 4000;          // Art-Net's limit for synchronous mode
+    static const int FRAME_TIMEOUT_MS = 50;
+
+private:
+    // A datagram of the current batch after decoding
+    struct Entry {
+        int buffer;
+        int index;         // Universe index, -1 for syncs and dropped packets
+        const uint8_t* slots;
+        uint16_t size;
+    };
+
+    DmxProtocol::Protocol protocol_;
+    int port_;
+    int firstUniverse_;
+    int universeCount_;
+    Clock* clock_;
+    int socketFd_;
+    std::vector<int> groupFds_;    // Hold multicast groups past the per-socket limit
+    int joinedGroups_;
+
+    // Buffer pool: BATCH_SIZE for receiving plus one held per universe
+    std::vector<uint8_t> storage_;
+    std::vector<int> free_;
+    std::vector<int> latest_;              // Buffer per universe index, -1 if none
+    std::vector<const uint8_t*> latestSlots_;
+    std::vector<uint16_t> latestSizes_;
+    std::vector<uint8_t> lastSequence_;
+    struct mmsghdr messages_[BATCH_SIZE];
+    struct iovec iovecs_[BATCH_SIZE];
+    int batchBuffers_[BATCH_SIZE];
+    Entry entries_[BATCH_SIZE];
+
+    // Frame state
+    long long lastSyncMs_;
+    long long pendingSinceMs_;     // First unshown data, -1 when none
+    uint64_t arrived_;             // Universes seen in the current unsynced frame
+    uint64_t allUniverses_;
+    uint64_t sequenced_;           // Universes with a sequence number to compare against
+
+    // Statistics
+    long long startedAtMs_;
+    unsigned long packets_;
+    unsigned long frames_;
+    unsigned long syncs_;
+    unsigned long ignored_;
+    unsigned long unmapped_;
+    unsigned long outOfOrder_;
+    int largestBatch_;
+    std::string lastError_;
+
+    // Helper methods
+    int decodeBatch(int received, long long now);
+    bool isInOrder(int index, uint8_t sequence);
+    void present(Listener& listener);
+    uint8_t* bufferAt(int buffer) { return &storage_[(size_t)buffer * BUFFER_SIZE]; }
+
+    // Disable copy constructor and assignment operator
+    DmxReceiver(const DmxReceiver&) = delete;
+    DmxReceiver& operator=(const DmxReceiver&) = delete;
+};
+
+#endif // DMX_RECEIVER_H
@@ -0,0 +1,407 @@
+#include "mqtt_client.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <unistd.h>
+#include <poll.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+namespace {
+
+const size_t OUTPUT_RESERVE = 4096;
+
+} // namespace
+
+MqttClient::MqttClient(const std::string& host, int port, const std::string& clientId, Clock* clock)
+    : host_(host), port_(port), clientId_(clientId), keepAliveSeconds_(DEFAULT_KEEP_ALIVE_SECONDS),
+      clock_(clock ? clock : Clock::monotonic()), state_(IDLE), socketFd_(-1), addressLength_(0),
+      resolved_(false), stateSinceMs_(0), retryAtMs_(0), backoffMs_(MIN_BACKOFF_MS), jitterSeed_(0),
+      lastSendMs_(0), lastReceiveMs_(0), input_(BUFFER_SIZE), inputSize_(0), skipRemaining_(0),
+      outputPos_(0), connects_(0), messages_(0), unmatched_(0), oversized_(0) {
+    std::memset(&address_, 0, sizeof(address_));
+    output_.reserve(OUTPUT_RESERVE);
+    jitterSeed_ = (unsigned int)getpid() ^ (unsigned int)clock_->nowMs();
+}
+
+MqttClient::~MqttClient() {
+    stop();
+}
+
+void MqttClient::setCredentials(const std::string& username, const std::string& password) {
+    username_ = username;
+    password_ = password;
+}
+
+void MqttClient::setKeepAlive(int seconds) {
+    keepAliveSeconds_ = std::max(1, std::min(seconds, 0xFFFF));
+}
+
+bool MqttClient::subscribe(const std::string& filter, MessageCallback callback) {
+    if (!MqttProtocol::isValidFilter(filter) || !callback) {
+        return false;
+    }
+    Subscription subscription;
+    subscription.filter = filter;
+    subscription.callback = callback;
+    subscriptions_.push_back(subscription);
+    return true;
+}
+
+void MqttClient::start() {
+    if (state_ != IDLE) {
+        return;
+    }
+    if (!resolve()) {
+        std::cerr << "⚠️  MQTT: " << lastError_ << ", will retry" << std::endl;
+    }
+    state_ = WAITING;
+    retryAtMs_ = clock_->nowMs();   // First attempt on the next poll
+    backoffMs_ = MIN_BACKOFF_MS;
+}
+
+void MqttClient::stop() {
+    if (state_ == CONNECTED) {
+        // Polite goodbye if the socket takes it right away
+        output_.erase(0, outputPos_);
+        outputPos_ = 0;
+        MqttProtocol::appendDisconnect(output_);
+        send(socketFd_, output_.data(), output_.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+    }
+    closeSocket();
+    state_ = IDLE;
+}
+
+void MqttClient::poll() {
+    long long now = clock_->nowMs();
+    switch (state_) {
+        case IDLE:
+            return;
+        case WAITING:
+            if (now < retryAtMs_) {
+                return;
+            }
+            beginConnect(now);
+            break;
+        case CONNECTING:
+            checkConnect(now);
+            break;
+        default:
+            break;
+    }
+    if (state_ != AWAITING_CONNACK && state_ != CONNECTED) {
+        return;
+    }
+
+    if (!flushOutput(now) || !readInput(now)) {
+        return;
+    }
+    if (state_ == AWAITING_CONNACK && now - stateSinceMs_ >= CONNECT_TIMEOUT_MS) {
+        fail("no CONNACK from " + host_, now);
+        return;
+    }
+    if (state_ == CONNECTED) {
+        long long keepAliveMs = keepAliveSeconds_ * 1000LL;
+        if (now - lastReceiveMs_ >= keepAliveMs * 3 / 2) {
+            fail("broker stopped answering", now);
+            return;
+        }
+        if (now - lastSendMs_ >= keepAliveMs && outputPos_ == output_.size()) {
+            MqttProtocol::appendPingReq(output_);
+        }
+    }
+    flushOutput(now);
+}
+
+void MqttClient::printReport(std::ostream& out) const {
+    static const char* STATE_NAMES[] = { "stopped", "waiting to retry", "connecting", "logging in", "connected" };
+    out << "📡 MQTT " << host_ << ":" << port_ << " - " << STATE_NAMES[state_] << std::endl;
+    out << "   " << subscriptions_.size() << " subscriptions, " << messages_ << " messages ("
+        << unmatched_ << " unmatched, " << oversized_ << " over " << BUFFER_SIZE / 1024 << " KB skipped), "
+        << connects_ << " connects" << std::endl;
+    if (!lastError_.empty()) {
+        out << "   Last error: " << lastError_ << std::endl;
+    }
+}
+
+bool MqttClient::parseAddress(const std::string& address, std::string& host, int& port) {
+    size_t colon = address.rfind(':');
+    if (colon == std::string::npos) {
+        host = address;
+        port = MqttProtocol::DEFAULT_PORT;
+    } else {
+        host = address.substr(0, colon);
+        port = std::atoi(address.c_str() + colon + 1);
+    }
+    return !host.empty() && port > 0 && port < 65536;
+}
+
+bool MqttClient::resolve() {
+    struct addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    struct addrinfo* results = nullptr;
+    std::string service = std::to_string(port_);
+    int error = getaddrinfo(host_.c_str(), service.c_str(), &hints, &results);
+    if (error != 0 || !results) {
+        lastError_ = "cannot resolve " + host_ + ": " + gai_strerror(error);
+        return false;
+    }
+    std::memcpy(&address_, results->ai_addr, results->ai_addrlen);
+    addressLength_ = results->ai_addrlen;
+    freeaddrinfo(results);
+    resolved_ = true;
+    return true;
+}
+
+void MqttClient::beginConnect(long long now) {
+    if (!resolved_ && !resolve()) {
+        fail(lastError_, now);
+        return;
+    }
+
+    socketFd_ = socket(address_.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (socketFd_ < 0) {
+        fail(std::string("socket: ") + strerror(errno), now);
+        return;
+    }
+    int noDelay = 1;
+    setsockopt(socketFd_, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+    stateSinceMs_ = now;
+    if (connect(socketFd_, (struct sockaddr*)&address_, addressLength_) == 0) {
+        sendSession(now);
+    } else if (errno == EINPROGRESS) {
+        state_ = CONNECTING;
+    } else {
+        fail(std::string("connect: ") + strerror(errno), now);
+    }
+}
+
+void MqttClient::checkConnect(long long now) {
+    struct pollfd pfd;
+    pfd.fd = socketFd_;
+    pfd.events = POLLOUT;
+    pfd.revents = 0;
+    if (::poll(&pfd, 1, 0) <= 0) {
+        if (now - stateSinceMs_ >= CONNECT_TIMEOUT_MS) {
+            fail("connect to " + host_ + " timed out", now);
+        }
+        return;
+    }
+
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if (getsockopt(socketFd_, SOL_SOCKET, SO_ERROR, &error, &length) != 0) {
+        error = errno;
+    }
+    if (error != 0) {
+        fail(std::string("connect: ") + strerror(error), now);
+        return;
+    }
+    sendSession(now);
+}
+
+void MqttClient::sendSession(long long now) {
+    // The spec lets SUBSCRIBE follow CONNECT without waiting for CONNACK
+    output_.clear();
+    outputPos_ = 0;
+    MqttProtocol::appendConnect(output_, clientId_, keepAliveSeconds_, username_, password_);
+    for (size_t i = 0; i < subscriptions_.size(); i++) {
+        MqttProtocol::appendSubscribe(output_, (uint16_t)(i + 1), subscriptions_[i].filter, 0);
+    }
+
+    inputSize_ = 0;
+    skipRemaining_ = 0;
+    state_ = AWAITING_CONNACK;
+    stateSinceMs_ = now;
+    lastSendMs_ = now;
+    lastReceiveMs_ = now;
+}
+
+bool MqttClient::flushOutput(long long now) {
+    while (outputPos_ < output_.size()) {
+        ssize_t sent = send(socketFd_, output_.data() + outputPos_, output_.size() - outputPos_,
+                            MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return true;  // Rest goes next frame
+            fail(std::string("send: ") + strerror(errno), now);
+            return false;
+        }
+        outputPos_ += (size_t)sent;
+        lastSendMs_ = now;
+    }
+    output_.clear();   // Keeps its capacity
+    outputPos_ = 0;
+    return true;
+}
+
+bool MqttClient::readInput(long long now) {
+    size_t total = 0;
+    while (total < MAX_READ_PER_POLL) {
+        ssize_t got = recv(socketFd_, &input_[inputSize_], input_.size() - inputSize_, MSG_DONTWAIT);
+        if (got > 0) {
+            inputSize_ += (size_t)got;
+            total += (size_t)got;
+            if (!processInput(now)) {
+                return false;
+            }
+            continue;
+        }
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true;
+        }
+        fail(got == 0 ? "broker closed the connection" : std::string("recv: ") + strerror(errno), now);
+        return false;
+    }
+    return true;
+}
+
+bool MqttClient::processInput(long long now) {
+    size_t offset = 0;
+    while (offset < inputSize_) {
+        if (skipRemaining_ > 0) {
+            size_t drop = std::min(skipRemaining_, inputSize_ - offset);
+            offset += drop;
+            skipRemaining_ -= drop;
+            continue;
+        }
+
+        size_t consumed = 0;
+        MqttProtocol::Packet packet;
+        MqttProtocol::ParseResult result = MqttProtocol::parsePacket(&input_[offset], inputSize_ - offset, consumed, packet);
+        if (result == MqttProtocol::PARSE_ERROR) {
+            fail("corrupt data from broker", now);
+            return false;
+        }
+        if (result == MqttProtocol::PARSE_INCOMPLETE) {
+            if (consumed > input_.size()) {
+                // Never fits; drop it as it streams past
+                oversized_++;
+                skipRemaining_ = consumed - (inputSize_ - offset);
+                offset = inputSize_;
+                lastReceiveMs_ = now;
+            }
+            break;
+        }
+
+        if (!handlePacket(packet, now)) {
+            return false;
+        }
+        offset += consumed;
+    }
+
+    // Keep the unfinished packet at the front
+    if (offset > 0) {
+        std::memmove(&input_[0], &input_[offset], inputSize_ - offset);
+        inputSize_ -= offset;
+    }
+    return true;
+}
+
+bool MqttClient::handlePacket(const MqttProtocol::Packet& packet, long long now) {
+    lastReceiveMs_ = now;
+
+    switch (packet.type) {
+        case MqttProtocol::CONNACK: {
+            int returnCode = -1;
+            if (!MqttProtocol::parseConnAck(packet, returnCode)) {
+                fail("corrupt CONNACK", now);
+                return false;
+            }
+            if (returnCode != MqttProtocol::CONNECT_ACCEPTED) {
+                fail(std::string("broker refused the connection: ") + MqttProtocol::describeConnectResult(returnCode), now);
+                return false;
+            }
+            state_ = CONNECTED;
+            stateSinceMs_ = now;
+            backoffMs_ = MIN_BACKOFF_MS;
+            connects_++;
+            std::cout << "🔗 Connected to MQTT broker " << host_ << ":" << port_ << std::endl;
+            return true;
+        }
+        case MqttProtocol::SUBACK: {
+            uint16_t packetId = 0;
+            bool granted = false;
+            if (MqttProtocol::parseSubAck(packet, packetId, granted) && !granted &&
+                packetId >= 1 && packetId <= subscriptions_.size()) {
+                std::cerr << "⚠️  MQTT broker refused subscription to " << subscriptions_[packetId - 1].filter << std::endl;
+            }
+            return true;
+        }
+        case MqttProtocol::PUBLISH: {
+            MqttProtocol::Publish publish;
+            if (!MqttProtocol::parsePublish(packet, publish)) {
+                fail("corrupt PUBLISH", now);
+                return false;
+            }
+            if (publish.qos == 1) {
+                MqttProtocol::appendPubAck(output_, publish.packetId);
+            }
+            dispatch(publish);
+            return true;
+        }
+        default:
+            return true;   // PINGRESP only proves the link is alive
+    }
+}
+
+void MqttClient::dispatch(const MqttProtocol::Publish& publish) {
+    messages_++;
+
+    Message message;
+    message.topic = publish.topic;
+    message.topicSize = publish.topicSize;
+    message.payload = publish.payload;
+    message.payloadSize = publish.payloadSize;
+    message.retained = publish.retained;
+
+    bool matched = false;
+    for (size_t i = 0; i < subscriptions_.size(); i++) {
+        if (MqttProtocol::topicMatches(subscriptions_[i].filter, publish.topic, publish.topicSize)) {
+            subscriptions_[i].callback(message);
+            matched = true;
+        }
+    }
+    if (!matched) {
+        unmatched_++;
+    }
+}
+
+void MqttClient::fail(const std::string& reason, long long now) {
+    bool wasConnected = state_ == CONNECTED;
+    closeSocket();
+
+    // +-25% so a fleet of displays doesn't retry in lockstep after a broker restart
+    int jitter = backoffMs_ / 4;
+    int delay = backoffMs_ - jitter + (jitter > 0 ? rand_r(&jitterSeed_) % (2 * jitter + 1) : 0);
+    retryAtMs_ = now + delay;
+    backoffMs_ = std::min(backoffMs_ * 2, MAX_BACKOFF_MS);
+    state_ = WAITING;
+
+    // Repeated failures for the same reason only print once
+    if (wasConnected || reason != lastError_) {
+        std::cerr << "⚠️  MQTT: " << reason << ", retrying in " << (delay + 500) / 1000 << " s" << std::endl;
+    }
+    lastError_ = reason;
+}
+
+void MqttClient::closeSocket() {
+    if (socketFd_ >= 0) {
+        close(socketFd_);
+        socketFd_ = -1;
+    }
+    output_.clear();
+    outputPos_ = 0;
+    inputSize_ = 0;
+    skipRemaining_ = 0;
+}
@@ -0,0 +1,142 @@
+#ifndef MQTT_CLIENT_H
+#define MQTT_CLIENT_H
+
+#include "infrastructure/network/mqtt_protocol.h"
+#include "shared/utils/clock.h"
+#include <ostream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <sys/socket.h>
+
+// MQTT 3.1.1 subscriber driven from the render loop. poll() advances a
+// non-blocking state machine and returns at once:
+//
+//   WAITING -> CONNECTING (TCP connect in flight) -> AWAITING_CONNACK -> CONNECTED
+//
+// CONNECT and every SUBSCRIBE go out together right after the TCP connect.
+// Any failure (refused CONNACK, closed socket, corrupt data, no traffic for
+// 1.5x the keep-alive) closes the socket and goes back to WAITING, with a
+// backoff that doubles from MIN_BACKOFF_MS to MAX_BACKOFF_MS (+-25% jitter)
+// and resets once a CONNACK is accepted.
+//
+// Messages are parsed in place in a fixed BUFFER_SIZE buffer and handed to
+// the callbacks of all matching subscriptions, so steady-state traffic
+// doesn't allocate. Bigger packets are skipped, not buffered. Subscriptions
+// use QoS 0; a QoS 1 message is acknowledged anyway.
+//
+// The broker's host name is looked up in start(), and again before each
+// retry while lookups fail; that is the only call that can block.
+class MqttClient {
+public:
+    enum State {
+        IDLE,               // Not started, or stopped
+        WAITING,            // Backing off before the next attempt
+        CONNECTING,
+        AWAITING_CONNACK,
+        CONNECTED
+    };
+
+    // Topic and payload point into the receive buffer and are only valid
+    // during the callback
+    struct Message {
+        const char* topic;
+        size_t topicSize;
+        const char* payload;
+        size_t payloadSize;
+        bool retained;
+    };
+    typedef std::function<void(const Message& message)> MessageCallback;
+
+    // Uses the monotonic clock unless given another (not owned)
+    MqttClient(const std::string& host, int port, const std::string& clientId, Clock* clock = nullptr);
+    ~MqttClient();
+
+    // Configuration (before start())
+    void setCredentials(const std::string& username, const std::string& password);
+    void setKeepAlive(int seconds);
+    bool subscribe(const std::string& filter, MessageCallback callback);  // False for a bad filter
+
+    // Lifecycle; callbacks run inside poll() on the caller's thread and must
+    // not call stop()
+    void start();
+    void stop();
+    void poll();
+
+    State getState() const { return state_; }
+    bool isConnected() const { return state_ == CONNECTED; }
+    unsigned long getMessageCount() const { return messages_; }
+    std::string getLastError() const { return lastError_; }
+    void printReport(std::ostream& out) const;
+
+    // Parse "host:port" (port optional)
+    static bool parseAddress(const std::string& address, std::string& host, int& port);
+
+    static const int DEFAULT_KEEP_ALIVE_SECONDS = 30;
+    static const int MIN_BACKOFF_MS = 1000;
+    static const int MAX_BACKOFF_MS = 60000;
+    static const int CONNECT_TIMEOUT_MS = 10000;       // TCP connect, then again for CONNACK
+    static const size_t BUFFER_SIZE = 16 * 1024;       // Largest packet handled
+    static const size_t MAX_READ_PER_POLL = 256 * 1024;
+
+private:
+    struct Subscription {
+        std::string filter;
+        MessageCallback callback;
+    };
+
+    std::string host_;
+    int port_;
+    std::string clientId_;
+    std::string username_;
+    std::string password_;
+    int keepAliveSeconds_;
+    Clock* clock_;
+    std::vector<Subscription> subscriptions_;
+
+    // Connection
+    State state_;
+    int socketFd_;
+    struct sockaddr_storage address_;
+    socklen_t addressLength_;
+    bool resolved_;
+    long long stateSinceMs_;
+    long long retryAtMs_;
+    int backoffMs_;
+    unsigned int jitterSeed_;
+    long long lastSendMs_;
+    long long lastReceiveMs_;
+
+    // Buffers, sized once
+    std::vector<char> input_;
+    size_t inputSize_;
+    size_t skipRemaining_;    // Rest of an oversized packet still to drop
+    std::string output_;
+    size_t outputPos_;
+
+    // Statistics
+    unsigned long connects_;
+    unsigned long messages_;
+    unsigned long unmatched_;
+    unsigned long oversized_;
+    std::string lastError_;
+
+    // Helper methods
+    bool resolve();
+    void beginConnect(long long now);
+    void checkConnect(long long now);
+    void sendSession(long long now);
+    bool flushOutput(long long now);
+    bool readInput(long long now);
+    bool processInput(long long now);
+    bool handlePacket(const MqttProtocol::Packet& packet, long long now);
+    void dispatch(const MqttProtocol::Publish& publish);
+    void fail(const std::string& reason, long long now);
+    void closeSocket();
+
+    // Disable copy constructor and assignment operator
+    MqttClient(const MqttClient&) = delete;
+    MqttClient& operator=(const MqttClient&) = delete;
+};
+
+#endif // MQTT_CLIENT_H
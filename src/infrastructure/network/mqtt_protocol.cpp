@@ -0,0 +1,267 @@
+#include "mqtt_protocol.h"
+#include <cstring>
+
+namespace {
+
+const uint8_t PROTOCOL_LEVEL = 4;   // MQTT 3.1.1
+const uint8_t FLAG_CLEAN_SESSION = 0x02;
+const uint8_t FLAG_PASSWORD = 0x40;
+const uint8_t FLAG_USERNAME = 0x80;
+
+uint16_t readU16(const char* data) {
+    return (uint16_t)(((unsigned char)data[0] << 8) | (unsigned char)data[1]);
+}
+
+void putU16(std::string& out, uint16_t value) {
+    out.push_back((char)(value >> 8));
+    out.push_back((char)value);
+}
+
+void putString(std::string& out, const std::string& value) {
+    size_t size = value.size() > 0xFFFF ? 0xFFFF : value.size();
+    putU16(out, (uint16_t)size);
+    out.append(value, 0, size);
+}
+
+void putFixedHeader(std::string& out, uint8_t type, uint8_t flags, size_t remainingLength) {
+    out.push_back((char)((type << 4) | flags));
+    do {
+        uint8_t digit = remainingLength % 128;
+        remainingLength /= 128;
+        if (remainingLength > 0) {
+            digit |= 0x80;
+        }
+        out.push_back((char)digit);
+    } while (remainingLength > 0);
+}
+
+size_t stringSize(const std::string& value) {
+    return 2 + (value.size() > 0xFFFF ? 0xFFFF : value.size());
+}
+
+} // namespace
+
+MqttProtocol::ParseResult MqttProtocol::parsePacket(const char* data, size_t size, size_t& consumed, Packet& out) {
+    consumed = 0;
+    if (size < 2) {
+        return PARSE_INCOMPLETE;
+    }
+
+    uint8_t type = (unsigned char)data[0] >> 4;
+    if (type == 0 || type == 15) {
+        return PARSE_ERROR; // Reserved
+    }
+
+    size_t length = 0;
+    size_t multiplier = 1;
+    size_t pos = 1;
+    while (true) {
+        if (pos >= size) {
+            return PARSE_INCOMPLETE;
+        }
+        if (pos >= MAX_HEADER_SIZE) {
+            return PARSE_ERROR;  // More than four length bytes
+        }
+        uint8_t digit = (unsigned char)data[pos++];
+        length += (digit & 0x7F) * multiplier;
+        if (!(digit & 0x80)) {
+            break;
+        }
+        multiplier *= 128;
+    }
+
+    consumed = pos + length;
+    if (size < consumed) {
+        return PARSE_INCOMPLETE;
+    }
+    out.type = type;
+    out.flags = (unsigned char)data[0] & 0x0F;
+    out.body = data + pos;
+    out.bodySize = length;
+    return PARSE_OK;
+}
+
+bool MqttProtocol::parsePublish(const Packet& packet, Publish& out) {
+    if (packet.type != PUBLISH || packet.bodySize < 2) {
+        return false;
+    }
+    out.qos = (packet.flags >> 1) & 0x03;
+    out.retained = (packet.flags & 0x01) != 0;
+    if (out.qos == 3) {
+        return false;
+    }
+
+    size_t topicSize = readU16(packet.body);
+    size_t pos = 2 + topicSize;
+    size_t idSize = out.qos > 0 ? 2 : 0;
+    if (topicSize == 0 || pos + idSize > packet.bodySize) {
+        return false;
+    }
+    out.topic = packet.body + 2;
+    out.topicSize = topicSize;
+    out.packetId = idSize ? readU16(packet.body + pos) : 0;
+    pos += idSize;
+    out.payload = packet.body + pos;
+    out.payloadSize = packet.bodySize - pos;
+    return true;
+}
+
+bool MqttProtocol::parseConnAck(const Packet& packet, int& returnCode) {
+    if (packet.type != CONNACK || packet.bodySize != 2) {
+        return false;
+    }
+    returnCode = (unsigned char)packet.body[1];
+    return true;
+}
+
+bool MqttProtocol::parseSubAck(const Packet& packet, uint16_t& packetId, bool& granted) {
+    if (packet.type != SUBACK || packet.bodySize < 3) {
+        return false;
+    }
+    packetId = readU16(packet.body);
+    granted = (unsigned char)packet.body[2] != 0x80;
+    return true;
+}
+
+void MqttProtocol::appendConnect(std::string& out, const std::string& clientId, int keepAliveSeconds,
+                                 const std::string& username, const std::string& password) {
+    uint8_t flags = FLAG_CLEAN_SESSION;
+    size_t length = 10 + stringSize(clientId);
+    if (!username.empty()) {
+        flags |= FLAG_USERNAME;
+        length += stringSize(username);
+        if (!password.empty()) {
+            flags |= FLAG_PASSWORD;
+            length += stringSize(password);
+        }
+    }
+
+    putFixedHeader(out, CONNECT, 0, length);
+    putString(out, "MQTT");
+    out.push_back((char)PROTOCOL_LEVEL);
+    out.push_back((char)flags);
+    putU16(out, (uint16_t)keepAliveSeconds);
+    putString(out, clientId);
+    if (flags & FLAG_USERNAME) {
+        putString(out, username);
+    }
+    if (flags & FLAG_PASSWORD) {
+        putString(out, password);
+    }
+}
+
+void MqttProtocol::appendSubscribe(std::string& out, uint16_t packetId, const std::string& filter, int qos) {
+    putFixedHeader(out, SUBSCRIBE, 0x02, 2 + stringSize(filter) + 1);
+    putU16(out, packetId);
+    putString(out, filter);
+    out.push_back((char)qos);
+}
+
+void MqttProtocol::appendPubAck(std::string& out, uint16_t packetId) {
+    putFixedHeader(out, PUBACK, 0, 2);
+    putU16(out, packetId);
+}
+
+void MqttProtocol::appendPingReq(std::string& out) {
+    putFixedHeader(out, PINGREQ, 0, 0);
+}
+
+void MqttProtocol::appendDisconnect(std::string& out) {
+    putFixedHeader(out, DISCONNECT, 0, 0);
+}
+
+void MqttProtocol::appendConnAck(std::string& out, int returnCode) {
+    putFixedHeader(out, CONNACK, 0, 2);
+    out.push_back(0);    // No session present
+    out.push_back((char)returnCode);
+}
+
+void MqttProtocol::appendSubAck(std::string& out, uint16_t packetId, int grantedQos) {
+    putFixedHeader(out, SUBACK, 0, 3);
+    putU16(out, packetId);
+    out.push_back((char)grantedQos);
+}
+
+void MqttProtocol::appendPingResp(std::string& out) {
+    putFixedHeader(out, PINGRESP, 0, 0);
+}
+
+void MqttProtocol::appendPublish(std::string& out, const std::string& topic, const char* payload, size_t payloadSize,
+                                 int qos, uint16_t packetId, bool retained) {
+    uint8_t flags = (uint8_t)((qos & 0x03) << 1) | (retained ? 0x01 : 0x00);
+    putFixedHeader(out, PUBLISH, flags, stringSize(topic) + (qos > 0 ? 2 : 0) + payloadSize);
+    putString(out, topic);
+    if (qos > 0) {
+        putU16(out, packetId);
+    }
+    out.append(payload, payloadSize);
+}
+
+bool MqttProtocol::topicMatches(const std::string& filter, const char* topic, size_t topicSize) {
+    // Wildcards at the top level don't reach broker topics like "$SYS/..."
+    if (topicSize > 0 && topic[0] == '$' && !filter.empty() && (filter[0] == '+' || filter[0] == '#')) {
+        return false;
+    }
+
+    size_t f = 0;
+    size_t t = 0;
+    while (true) {
+        if (f < filter.size() && filter[f] == '#') {
+            return true;
+        }
+
+        size_t filterEnd = filter.find('/', f);
+        if (filterEnd == std::string::npos) {
+            filterEnd = filter.size();
+        }
+        size_t topicEnd = t;
+        while (topicEnd < topicSize && topic[topicEnd] != '/') {
+            topicEnd++;
+        }
+
+        bool anyLevel = filterEnd - f == 1 && filter[f] == '+';
+        if (!anyLevel && (filterEnd - f != topicEnd - t || std::memcmp(filter.data() + f, topic + t, topicEnd - t) != 0)) {
+            return false;
+        }
+
+        bool lastFilterLevel = filterEnd == filter.size();
+        bool lastTopicLevel = topicEnd == topicSize;
+        if (lastFilterLevel || lastTopicLevel) {
+            // "a/#" also matches its parent "a"
+            return lastFilterLevel == lastTopicLevel || filter.compare(filterEnd, std::string::npos, "/#") == 0;
+        }
+        f = filterEnd + 1;
+        t = topicEnd + 1;
+    }
+}
+
+bool MqttProtocol::isValidFilter(const std::string& filter) {
+    if (filter.empty() || filter.size() > 0xFFFF) {
+        return false;
+    }
+    for (size_t i = 0; i < filter.size(); i++) {
+        char c = filter[i];
+        if (c != '+' && c != '#') {
+            continue;
+        }
+        // Wildcards fill a whole level, and "#" only the last one
+        bool levelStart = i == 0 || filter[i - 1] == '/';
+        bool levelEnd = i + 1 == filter.size() || filter[i + 1] == '/';
+        if (!levelStart || !levelEnd || (c == '#' && i + 1 != filter.size())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const char* MqttProtocol::describeConnectResult(int returnCode) {
+    switch (returnCode) {
+        case CONNECT_ACCEPTED: return "accepted";
+        case CONNECT_BAD_PROTOCOL: return "unsupported protocol version";
+        case CONNECT_ID_REJECTED: return "client ID rejected";
+        case CONNECT_UNAVAILABLE: return "server unavailable";
+        case CONNECT_BAD_CREDENTIALS: return "bad user name or password";
+        case CONNECT_NOT_AUTHORIZED: return "not authorized";
+        default: return "unknown refusal";
+    }
+}
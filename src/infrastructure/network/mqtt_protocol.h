@@ -0,0 +1,101 @@
+#ifndef MQTT_PROTOCOL_H
+#define MQTT_PROTOCOL_H
+
+#include <string>
+#include <stddef.h>
+#include <stdint.h>
+
+// The subset of MQTT 3.1.1 that MqttClient and tools/mqtt_stub_broker
+// speak: CONNECT/CONNACK, SUBSCRIBE/SUBACK, PUBLISH (QoS 0 and 1) with
+// PUBACK, PINGREQ/PINGRESP and DISCONNECT.
+//
+// A packet is one fixed-header byte (type << 4 | flags), the remaining
+// length as a 1-4 byte base-128 varint, then the body. Strings are
+// u16-length-prefixed, integers big-endian. Parsing never copies: Packet
+// and Publish point into the caller's buffer, so a client can handle
+// messages without allocating.
+class MqttProtocol {
+public:
+    enum PacketType {
+        CONNECT = 1,
+        CONNACK = 2,
+        PUBLISH = 3,
+        PUBACK = 4,
+        SUBSCRIBE = 8,
+        SUBACK = 9,
+        PINGREQ = 12,
+        PINGRESP = 13,
+        DISCONNECT = 14
+    };
+
+    enum ConnectResult {
+        CONNECT_ACCEPTED = 0,
+        CONNECT_BAD_PROTOCOL = 1,
+        CONNECT_ID_REJECTED = 2,
+        CONNECT_UNAVAILABLE = 3,
+        CONNECT_BAD_CREDENTIALS = 4,
+        CONNECT_NOT_AUTHORIZED = 5
+    };
+
+    struct Packet {
+        uint8_t type;
+        uint8_t flags;       // Low nibble of the fixed header
+        const char* body;
+        size_t bodySize;
+
+        Packet() : type(0), flags(0), body(nullptr), bodySize(0) {}
+    };
+
+    struct Publish {
+        const char* topic;
+        size_t topicSize;
+        const char* payload;
+        size_t payloadSize;
+        uint16_t packetId;   // 0 for QoS 0
+        int qos;
+        bool retained;
+
+        Publish() : topic(nullptr), topicSize(0), payload(nullptr), payloadSize(0), packetId(0), qos(0), retained(false) {}
+    };
+
+    enum ParseResult {
+        PARSE_OK,          // `out` holds a packet, `consumed` is its full size
+        PARSE_INCOMPLETE,  // Need more bytes; `consumed` is the full size once the header is in
+        PARSE_ERROR        // Stream is corrupt; drop the connection
+    };
+
+    // Split the first packet off the buffer. With the header complete but
+    // the body not, `consumed` still tells the full packet size, so readers
+    // can skip packets larger than their buffer.
+    static ParseResult parsePacket(const char* data, size_t size, size_t& consumed, Packet& out);
+    static bool parsePublish(const Packet& packet, Publish& out);
+    static bool parseConnAck(const Packet& packet, int& returnCode);
+    static bool parseSubAck(const Packet& packet, uint16_t& packetId, bool& granted);
+
+    // Client packets
+    static void appendConnect(std::string& out, const std::string& clientId, int keepAliveSeconds,
+                              const std::string& username = "", const std::string& password = "");
+    static void appendSubscribe(std::string& out, uint16_t packetId, const std::string& filter, int qos);
+    static void appendPubAck(std::string& out, uint16_t packetId);
+    static void appendPingReq(std::string& out);
+    static void appendDisconnect(std::string& out);
+
+    // Broker packets (for the stand-in broker)
+    static void appendConnAck(std::string& out, int returnCode);
+    static void appendSubAck(std::string& out, uint16_t packetId, int grantedQos);
+    static void appendPingResp(std::string& out);
+    static void appendPublish(std::string& out, const std::string& topic, const char* payload, size_t payloadSize,
+                              int qos = 0, uint16_t packetId = 0, bool retained = false);
+
+    // Topic filter match with "+" (one level) and "#" (all remaining levels)
+    static bool topicMatches(const std::string& filter, const char* topic, size_t topicSize);
+    static bool isValidFilter(const std::string& filter);
+
+    static const char* describeConnectResult(int returnCode);
+
+    static const size_t MAX_REMAINING_LENGTH = 268435455;
+    static const size_t MAX_HEADER_SIZE = 5;
+    static const int DEFAULT_PORT = 1883;
+};
+
+#endif // MQTT_PROTOCOL_H
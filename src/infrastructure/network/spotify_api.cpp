@@ -1,7 +1,8 @@
 #include "spotify_api.h"
+#include "shared/network/buffer_pool.h"
+#include "shared/utils/json_scanner.h"
 #include <iostream>
 #include <sstream>
-#include <regex>
 #include <cstdlib>
 
 // Simple base64 encoding function
@@ -94,7 +95,7 @@ bool SpotifyAPI::authenticate() {
     std::cout << "✅ Auth response received" << std::endl;
     
     // Extract access token from response
-    accessToken_ = extractJsonValue(response, "access_token");
+    accessToken_ = extractJsonValue(response, "access_token").str();
     if (accessToken_.empty()) {
         lastError_ = "Failed to extract access token from response";
         std::cerr << "❌ Auth response: " << response << std::endl;
@@ -132,7 +133,8 @@ SpotifyArtistStats SpotifyAPI::getArtistStats(const std::string& artistId) {
     
     // Get artist basic info
     std::string artistUrl = buildArtistUrl(artistId);
-    std::string artistResponse;
+    BufferPool::Buffer buffer = BufferPool::shared().acquire();
+    const std::string& artistResponse = buffer.str();
     
     std::map<std::string, std::string> headers;
     headers["Authorization"] = "Bearer " + accessToken_;
@@ -141,7 +143,7 @@ SpotifyArtistStats SpotifyAPI::getArtistStats(const std::string& artistId) {
     std::cout << "🔍 Making request to: " << artistUrl << std::endl;
     std::cout << "🔑 Using access token: " << accessToken_.substr(0, 20) << "..." << std::endl;
     
-    if (!networkHandler_.get(artistUrl, headers, artistResponse)) {
+    if (!networkHandler_.get(artistUrl, headers, buffer.str())) {
         stats.errorMessage = "Network error getting artist info: " + networkHandler_.getLastError();
         lastError_ = stats.errorMessage;
         std::cerr << "❌ HTTP Error: " << networkHandler_.getLastHttpCode() << std::endl;
@@ -151,25 +153,24 @@ SpotifyArtistStats SpotifyAPI::getArtistStats(const std::string& artistId) {
     
     // Parse artist response
     stats = parseArtistResponse(artistResponse);
+    stats.artistId = artistId;
     if (!stats.isValid) {
         lastError_ = stats.errorMessage;
         return stats;
     }
     
-    // Get artist albums for album count
+    // Get artist albums for album count (reusing the same pooled buffer)
     std::string albumsUrl = buildArtistAlbumsUrl(artistId);
-    std::string albumsResponse;
     
-    if (networkHandler_.get(albumsUrl, headers, albumsResponse)) {
-        stats = parseAlbumsResponse(albumsResponse, stats);
+    if (networkHandler_.get(albumsUrl, headers, buffer.str())) {
+        stats = parseAlbumsResponse(buffer.str(), stats);
     }
     
     // Get top tracks for top track info
     std::string topTracksUrl = buildArtistTopTracksUrl(artistId);
-    std::string topTracksResponse;
     
-    if (networkHandler_.get(topTracksUrl, headers, topTracksResponse)) {
-        stats = parseTopTracksResponse(topTracksResponse, stats);
+    if (networkHandler_.get(topTracksUrl, headers, buffer.str())) {
+        stats = parseTopTracksResponse(buffer.str(), stats);
     }
     
     return stats;
@@ -207,9 +208,10 @@ SpotifyArtistStats SpotifyAPI::parseArtistResponse(const std::string& jsonRespon
     }
     
     // Extract basic artist info
-    stats.name = extractJsonValue(jsonResponse, "name");
-    stats.popularity = parseIntValue(extractJsonValue(jsonResponse, "popularity"));
-    stats.genres = formatGenres(extractJsonValue(jsonResponse, "genres"));
+    stats.name = extractJsonValue(jsonResponse, "name").str();
+    stats.popularity = parseIntValue(JsonScanner::findValue(jsonResponse, "popularity"));
+    stats.genres = formatGenres(extractJsonValue(jsonResponse, "genres").str());
+    stats.imageUrl = extractSmallestImageUrl(jsonResponse);
     
     if (stats.name.empty()) {
         stats.errorMessage = "No artist data found in response";
@@ -222,20 +224,23 @@ SpotifyArtistStats SpotifyAPI::parseArtistResponse(const std::string& jsonRespon
 
 SpotifyArtistStats SpotifyAPI::parseAlbumsResponse(const std::string& jsonResponse, SpotifyArtistStats& stats) {
     // Count albums in the response
-    std::regex albumRegex("\"album_type\"\\s*:\\s*\"(album|single|compilation)\"");
-    std::sregex_iterator begin(jsonResponse.begin(), jsonResponse.end(), albumRegex);
-    std::sregex_iterator end;
-    
-    stats.albumCount = std::distance(begin, end);
+    stats.albumCount = 0;
+    size_t pos = 0;
+    while (pos < jsonResponse.size()) {
+        StringRef albumType = JsonScanner::findString(jsonResponse, "album_type", pos, &pos);
+        if (albumType.empty()) break;
+        if (albumType.equals("album") || albumType.equals("single") || albumType.equals("compilation")) {
+            stats.albumCount++;
+        }
+    }
     
     // Count total tracks across all albums
-    std::regex trackRegex("\"total_tracks\"\\s*:\\s*(\\d+)");
-    std::sregex_iterator trackBegin(jsonResponse.begin(), jsonResponse.end(), trackRegex);
-    std::sregex_iterator trackEnd;
-    
     stats.trackCount = 0;
-    for (auto it = trackBegin; it != trackEnd; ++it) {
-        stats.trackCount += parseIntValue((*it)[1].str());
+    pos = 0;
+    while (pos < jsonResponse.size()) {
+        StringRef tracks = JsonScanner::findNumber(jsonResponse, "total_tracks", pos, &pos);
+        if (tracks.empty()) break;
+        stats.trackCount += parseIntValue(tracks);
     }
     
     return stats;
@@ -243,49 +248,31 @@ SpotifyArtistStats SpotifyAPI::parseAlbumsResponse(const std::string& jsonRespon
 
 SpotifyArtistStats SpotifyAPI::parseTopTracksResponse(const std::string& jsonResponse, SpotifyArtistStats& stats) {
     // Extract the first (most popular) track name
-    stats.topTrack = extractJsonArrayValue(jsonResponse, "name", 0);
+    stats.topTrack = extractJsonArrayValue(jsonResponse, "name", 0).str();
     return stats;
 }
 
-std::string SpotifyAPI::extractJsonValue(const std::string& json, const std::string& key) {
-    std::string pattern = "\"" + key + "\"\\s*:\\s*\"([^\"]+)\"";
-    std::regex regex(pattern);
-    std::smatch match;
-    
-    if (std::regex_search(json, match, regex)) {
-        return match[1].str();
-    }
-    
-    return "";
+StringRef SpotifyAPI::extractJsonValue(const std::string& json, const char* key) {
+    return JsonScanner::findString(json, key);
 }
 
-std::string SpotifyAPI::extractJsonArrayValue(const std::string& json, const std::string& key, int index) {
-    std::string pattern = "\"" + key + "\"\\s*:\\s*\"([^\"]+)\"";
-    std::regex regex(pattern);
-    std::sregex_iterator begin(json.begin(), json.end(), regex);
-    std::sregex_iterator end;
-    
-    int count = 0;
-    for (auto it = begin; it != end && count <= index; ++it, ++count) {
+StringRef SpotifyAPI::extractJsonArrayValue(const std::string& json, const char* key, int index) {
+    size_t pos = 0;
+    for (int count = 0; count <= index; count++) {
+        StringRef value = JsonScanner::findString(json, key, pos, &pos);
+        if (value.empty()) {
+            break;
+        }
         if (count == index) {
-            return (*it)[1].str();
+            return value;
         }
     }
     
-    return "";
+    return StringRef();
 }
 
-int SpotifyAPI::parseIntValue(const std::string& value) {
-    if (value.empty()) {
-        return 0;
-    }
-    
-    try {
-        return std::stoi(value);
-    } catch (const std::exception& e) {
-        std::cerr << "Error parsing integer value '" << value << "': " << e.what() << std::endl;
-        return 0;
-    }
+int SpotifyAPI::parseIntValue(const StringRef& value) {
+    return (int)JsonScanner::parseLong(value);
 }
 
 std::string SpotifyAPI::formatGenres(const std::string& genresJson) {
@@ -296,3 +283,36 @@ std::string SpotifyAPI::formatGenres(const std::string& genresJson) {
     }
     return genresJson;
 }
+
+std::string SpotifyAPI::extractSmallestImageUrl(const std::string& json) {
+    // "images": [{"height": 640, "url": "...", "width": 640}, ...]
+    size_t pos = json.find("\"images\"");
+    if (pos == std::string::npos) {
+        return "";
+    }
+    size_t arrayEnd = json.find(']', pos);
+    if (arrayEnd == std::string::npos) {
+        return "";
+    }
+    
+    std::string smallestUrl;
+    long smallestWidth = 0;
+    while (true) {
+        size_t objectStart = json.find('{', pos);
+        if (objectStart == std::string::npos || objectStart > arrayEnd) break;
+        size_t objectEnd = json.find('}', objectStart);
+        if (objectEnd == std::string::npos || objectEnd > arrayEnd) break;
+        
+        std::string object = json.substr(objectStart, objectEnd - objectStart + 1);
+        StringRef url = JsonScanner::findString(object, "url");
+        long width = JsonScanner::parseLong(JsonScanner::findNumber(object, "width"));
+        if (!url.empty() && (smallestUrl.empty() || width < smallestWidth)) {
+            smallestUrl = url.str();
+            smallestWidth = width;
+        }
+        
+        pos = objectEnd + 1;
+    }
+    
+    return smallestUrl;
+}
@@ -2,9 +2,11 @@
 #define SPOTIFY_API_H
 
 #include "shared/network/network_handler.h"
+#include "shared/utils/string_ref.h"
 #include <string>
 
 struct SpotifyArtistStats {
+    std::string artistId;   // Artist the stats were fetched for
     std::string name;
     int popularity;
     int monthlyListeners;
@@ -12,6 +14,7 @@ struct SpotifyArtistStats {
     int trackCount;
     std::string topTrack;
     std::string genres;
+    std::string imageUrl;  // Smallest artist image
     bool isValid;
     std::string errorMessage;
     
@@ -49,10 +52,11 @@ private:
     SpotifyArtistStats parseArtistResponse(const std::string& jsonResponse);
     SpotifyArtistStats parseAlbumsResponse(const std::string& jsonResponse, SpotifyArtistStats& stats);
     SpotifyArtistStats parseTopTracksResponse(const std::string& jsonResponse, SpotifyArtistStats& stats);
-    std::string extractJsonValue(const std::string& json, const std::string& key);
-    std::string extractJsonArrayValue(const std::string& json, const std::string& key, int index = 0);
-    int parseIntValue(const std::string& value);
+    StringRef extractJsonValue(const std::string& json, const char* key);
+    StringRef extractJsonArrayValue(const std::string& json, const char* key, int index = 0);
+    int parseIntValue(const StringRef& value);
     std::string formatGenres(const std::string& genresJson);
+    std::string extractSmallestImageUrl(const std::string& json);
     
     // Disable copy constructor and assignment operator
     SpotifyAPI(const SpotifyAPI&) = delete;
@@ -0,0 +1,23 @@
+#include "stats_hub_api_fetcher.h"
+
+StatsHubApiFetcher::StatsHubApiFetcher()
+    : youtubeAPI_(new YouTubeAPI()), spotifyAPI_(new SpotifyAPI()) {
+}
+
+StatsHubApiFetcher::~StatsHubApiFetcher() {
+    delete youtubeAPI_;
+    delete spotifyAPI_;
+}
+
+YouTubeChannelStats StatsHubApiFetcher::fetchYouTube(const std::string& channel) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (channel[0] == '@') {
+        return youtubeAPI_->getChannelStatsByUsername(channel.substr(1));
+    }
+    return youtubeAPI_->getChannelStats(channel);
+}
+
+SpotifyArtistStats StatsHubApiFetcher::fetchSpotify(const std::string& artistId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return spotifyAPI_->getArtistStats(artistId);
+}
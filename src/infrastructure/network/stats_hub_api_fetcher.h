@@ -0,0 +1,31 @@
+#ifndef STATS_HUB_API_FETCHER_H
+#define STATS_HUB_API_FETCHER_H
+
+#include "infrastructure/network/youtube_api.h"
+#include "infrastructure/network/spotify_api.h"
+#include <string>
+#include <mutex>
+
+// Real upstream fetches for StatsHubServer. Owns one YouTube and one Spotify
+// API client and serializes calls into them, since neither is thread-safe
+// and the scheduler may run fetches on several workers. Must outlive the
+// server it is handed to.
+class StatsHubApiFetcher {
+public:
+    StatsHubApiFetcher();
+    ~StatsHubApiFetcher();
+    
+    YouTubeChannelStats fetchYouTube(const std::string& channel);  // ID or @handle
+    SpotifyArtistStats fetchSpotify(const std::string& artistId);
+    
+private:
+    YouTubeAPI* youtubeAPI_;
+    SpotifyAPI* spotifyAPI_;
+    std::mutex mutex_;
+    
+    // Disable copy constructor and assignment operator
+    StatsHubApiFetcher(const StatsHubApiFetcher&) = delete;
+    StatsHubApiFetcher& operator=(const StatsHubApiFetcher&) = delete;
+};
+
+#endif // STATS_HUB_API_FETCHER_H
@@ -0,0 +1,241 @@
+#include "stats_hub_client.h"
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+namespace {
+
+const int RECONNECT_DELAY_MS = 2000;
+
+void sleepInterruptible(const std::atomic<bool>& running, int milliseconds) {
+    for (int waited = 0; waited < milliseconds && running; waited += 100) {
+        usleep(100000);
+    }
+}
+
+} // namespace
+
+StatsHubClient::StatsHubClient(const std::string& host, int port)
+    : host_(host), port_(port), socketFd_(-1), running_(false), connected_(false) {
+}
+
+StatsHubClient::~StatsHubClient() {
+    stop();
+}
+
+void StatsHubClient::start() {
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    clientThread_ = std::thread(&StatsHubClient::clientLoop, this);
+}
+
+void StatsHubClient::stop() {
+    if (!running_) {
+        return;
+    }
+    
+    running_ = false;
+    {
+        // Unblock the reader
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (socketFd_ >= 0) {
+            shutdown(socketFd_, SHUT_RDWR);
+        }
+    }
+    if (clientThread_.joinable()) {
+        clientThread_.join();
+    }
+}
+
+bool StatsHubClient::isConnected() const {
+    return connected_.load();
+}
+
+void StatsHubClient::subscribeYouTube(const std::string& channelId, YouTubeCallback callback) {
+    std::string key = "youtube:" + channelId;
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscriptions_[key].onYouTube = callback;
+    sendMessage(StatsHubProtocol::MSG_SUBSCRIBE, key);
+}
+
+void StatsHubClient::subscribeSpotify(const std::string& artistId, SpotifyCallback callback) {
+    std::string key = "spotify:" + artistId;
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscriptions_[key].onSpotify = callback;
+    sendMessage(StatsHubProtocol::MSG_SUBSCRIBE, key);
+}
+
+void StatsHubClient::unsubscribe(const std::string& key) {
+    // Wait out a callback in flight, unless this is that callback
+    std::unique_lock<std::mutex> callbackLock(callbackMutex_, std::defer_lock);
+    if (std::this_thread::get_id() != clientThread_.get_id()) {
+        callbackLock.lock();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (subscriptions_.erase(key)) {
+        sendMessage(StatsHubProtocol::MSG_UNSUBSCRIBE, key);
+    }
+}
+
+void StatsHubClient::requestRefresh(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sendMessage(StatsHubProtocol::MSG_REFRESH, key);
+}
+
+bool StatsHubClient::parseAddress(const std::string& address, std::string& host, int& port) {
+    size_t colon = address.rfind(':');
+    if (colon == std::string::npos) {
+        host = address;
+        port = StatsHubProtocol::DEFAULT_PORT;
+    } else {
+        host = address.substr(0, colon);
+        port = std::atoi(address.c_str() + colon + 1);
+    }
+    return !host.empty() && port > 0 && port < 65536;
+}
+
+void StatsHubClient::clientLoop() {
+    while (running_) {
+        int fd = connectToHub();
+        if (fd < 0) {
+            sleepInterruptible(running_, RECONNECT_DELAY_MS);
+            continue;
+        }
+        
+        {
+            // Re-subscribe everything on the fresh connection
+            std::lock_guard<std::mutex> lock(mutex_);
+            socketFd_ = fd;
+            connected_ = true;
+            for (std::map<std::string, Subscription>::const_iterator it = subscriptions_.begin();
+                 it != subscriptions_.end(); ++it) {
+                sendMessage(StatsHubProtocol::MSG_SUBSCRIBE, it->first);
+            }
+        }
+        std::cout << "🔗 Connected to stats hub " << host_ << ":" << port_ << std::endl;
+        
+        readMessages(fd);
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            socketFd_ = -1;
+            connected_ = false;
+        }
+        close(fd);
+        
+        if (running_) {
+            std::cerr << "⚠️  Lost connection to stats hub, reconnecting..." << std::endl;
+            sleepInterruptible(running_, RECONNECT_DELAY_MS);
+        }
+    }
+}
+
+int StatsHubClient::connectToHub() {
+    struct addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    
+    struct addrinfo* results = nullptr;
+    std::string service = std::to_string(port_);
+    if (getaddrinfo(host_.c_str(), service.c_str(), &hints, &results) != 0) {
+        return -1;
+    }
+    
+    int fd = -1;
+    for (struct addrinfo* ai = results; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) continue;
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) break;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(results);
+    
+    if (fd >= 0) {
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    }
+    return fd;
+}
+
+void StatsHubClient::readMessages(int fd) {
+    std::string input;
+    char buffer[4096];
+    
+    while (running_) {
+        ssize_t got = recv(fd, buffer, sizeof(buffer), 0);
+        if (got <= 0) {
+            if (got < 0 && errno == EINTR) continue;
+            return;
+        }
+        input.append(buffer, (size_t)got);
+        
+        size_t offset = 0;
+        StatsHubProtocol::Message message;
+        StatsHubProtocol::ParseResult result;
+        while ((result = StatsHubProtocol::parseMessage(input, offset, message)) == StatsHubProtocol::PARSE_OK) {
+            dispatch(message);
+        }
+        if (result == StatsHubProtocol::PARSE_ERROR) {
+            std::cerr << "❌ Corrupt data from stats hub" << std::endl;
+            return;
+        }
+        input.erase(0, offset);
+    }
+}
+
+void StatsHubClient::dispatch(const StatsHubProtocol::Message& message) {
+    // Callbacks run without mutex_ so they may call back into the client,
+    // but under callbackMutex_ so unsubscribe can wait for them
+    std::lock_guard<std::mutex> callbackLock(callbackMutex_);
+    Subscription subscription;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::map<std::string, Subscription>::const_iterator it = subscriptions_.find(message.key);
+        if (it == subscriptions_.end()) {
+            return; // Unsubscribed while the update was in flight
+        }
+        subscription = it->second;
+    }
+    
+    if (message.type == StatsHubProtocol::MSG_YOUTUBE_STATS && subscription.onYouTube) {
+        YouTubeChannelStats stats;
+        if (StatsHubProtocol::decodeYouTubeStats(message.payload, stats)) {
+            subscription.onYouTube(stats);
+        }
+    } else if (message.type == StatsHubProtocol::MSG_SPOTIFY_STATS && subscription.onSpotify) {
+        SpotifyArtistStats stats;
+        if (StatsHubProtocol::decodeSpotifyStats(message.payload, stats)) {
+            stats.artistId = message.key.substr(message.key.find(':') + 1);  // Not repeated in the payload
+            subscription.onSpotify(stats);
+        }
+    }
+}
+
+void StatsHubClient::sendMessage(uint8_t type, const std::string& key) {
+    if (socketFd_ < 0) {
+        return; // Sent on (re)connect instead
+    }
+    
+    std::string frame;
+    StatsHubProtocol::appendMessage(frame, type, key);
+    size_t sent = 0;
+    while (sent < frame.size()) {
+        ssize_t n = send(socketFd_, frame.data() + sent, frame.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            shutdown(socketFd_, SHUT_RDWR); // Reader notices and reconnects
+            return;
+        }
+        sent += (size_t)n;
+    }
+}
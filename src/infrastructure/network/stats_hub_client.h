@@ -0,0 +1,70 @@
+#ifndef STATS_HUB_CLIENT_H
+#define STATS_HUB_CLIENT_H
+
+#include "infrastructure/network/stats_hub_protocol.h"
+#include <string>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <functional>
+
+// Display side of the stats fan-out: receives stats from a StatsHubServer
+// instead of calling the YouTube/Spotify APIs directly. Reconnects on its
+// own and re-sends all subscriptions after every reconnect.
+class StatsHubClient {
+public:
+    typedef std::function<void(const YouTubeChannelStats& stats)> YouTubeCallback;
+    typedef std::function<void(const SpotifyArtistStats& stats)> SpotifyCallback;
+    
+    StatsHubClient(const std::string& host, int port);
+    ~StatsHubClient();
+    
+    // Lifecycle (connection and reads run on their own thread)
+    void start();
+    void stop();
+    bool isConnected() const;
+    
+    // Subscriptions; callbacks run on the client thread. Once unsubscribe
+    // returns, the key's callback is not running and will not run again, so
+    // whatever it captured can go away.
+    void subscribeYouTube(const std::string& channelId, YouTubeCallback callback);
+    void subscribeSpotify(const std::string& artistId, SpotifyCallback callback);
+    void unsubscribe(const std::string& key);
+    
+    // Ask the hub for fresh data (coalesced across the fleet by the hub)
+    void requestRefresh(const std::string& key);
+    
+    // Parse "host:port" (port optional)
+    static bool parseAddress(const std::string& address, std::string& host, int& port);
+    
+private:
+    struct Subscription {
+        YouTubeCallback onYouTube;
+        SpotifyCallback onSpotify;
+    };
+    
+    std::string host_;
+    int port_;
+    int socketFd_;
+    std::map<std::string, Subscription> subscriptions_;
+    mutable std::mutex mutex_;
+    std::mutex callbackMutex_;  // Held while a callback runs; taken before mutex_
+    
+    std::thread clientThread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> connected_;
+    
+    // Helper methods
+    void clientLoop();
+    int connectToHub();
+    void readMessages(int fd);
+    void dispatch(const StatsHubProtocol::Message& message);
+    void sendMessage(uint8_t type, const std::string& key);  // Called with mutex_ held
+    
+    // Disable copy constructor and assignment operator
+    StatsHubClient(const StatsHubClient&) = delete;
+    StatsHubClient& operator=(const StatsHubClient&) = delete;
+};
+
+#endif // STATS_HUB_CLIENT_H
@@ -0,0 +1,170 @@
+#include "stats_hub_protocol.h"
+
+namespace {
+
+const uint8_t MAGIC_0 = 'S';
+const uint8_t MAGIC_1 = 'H';
+
+void putU16(std::string& out, uint16_t value) {
+    out.push_back((char)(value >> 8));
+    out.push_back((char)value);
+}
+
+void putU32(std::string& out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out.push_back((char)(value >> shift));
+    }
+}
+
+void putI64(std::string& out, long long value) {
+    uint64_t bits = (uint64_t)value;
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        out.push_back((char)(bits >> shift));
+    }
+}
+
+void putString(std::string& out, const std::string& value) {
+    size_t size = value.size() > 0xFFFF ? 0xFFFF : value.size();
+    putU16(out, (uint16_t)size);
+    out.append(value, 0, size);
+}
+
+uint32_t readBigEndian(const std::string& in, size_t pos, int bytes) {
+    uint32_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value = (value << 8) | (unsigned char)in[pos + i];
+    }
+    return value;
+}
+
+// Sequential reader; any overrun flips ok to false and yields zeros
+class PayloadReader {
+public:
+    explicit PayloadReader(const std::string& in) : in_(in), pos_(0), ok_(true) {}
+    
+    long long i64() {
+        if (!require(8)) return 0;
+        uint64_t bits = ((uint64_t)readBigEndian(in_, pos_, 4) << 32) | readBigEndian(in_, pos_ + 4, 4);
+        pos_ += 8;
+        return (long long)bits;
+    }
+    
+    std::string str() {
+        if (!require(2)) return "";
+        size_t size = readBigEndian(in_, pos_, 2);
+        pos_ += 2;
+        if (!require(size)) return "";
+        std::string value = in_.substr(pos_, size);
+        pos_ += size;
+        return value;
+    }
+    
+    bool ok() const { return ok_; }
+    
+private:
+    bool require(size_t bytes) {
+        if (!ok_ || in_.size() - pos_ < bytes) {
+            ok_ = false;
+        }
+        return ok_;
+    }
+    
+    const std::string& in_;
+    size_t pos_;
+    bool ok_;
+};
+
+} // namespace
+
+void StatsHubProtocol::appendMessage(std::string& out, uint8_t type, const std::string& key,
+                                     const std::string& payload) {
+    out.push_back((char)MAGIC_0);
+    out.push_back((char)MAGIC_1);
+    out.push_back((char)VERSION);
+    out.push_back((char)type);
+    putU16(out, (uint16_t)key.size());
+    putU32(out, (uint32_t)payload.size());
+    out += key;
+    out += payload;
+}
+
+StatsHubProtocol::ParseResult StatsHubProtocol::parseMessage(const std::string& buffer, size_t& offset,
+                                                             Message& out) {
+    if (buffer.size() - offset < HEADER_SIZE) {
+        return PARSE_INCOMPLETE;
+    }
+    
+    if ((uint8_t)buffer[offset] != MAGIC_0 || (uint8_t)buffer[offset + 1] != MAGIC_1 ||
+        (uint8_t)buffer[offset + 2] != VERSION) {
+        return PARSE_ERROR;
+    }
+    
+    size_t keySize = readBigEndian(buffer, offset + 4, 2);
+    size_t payloadSize = readBigEndian(buffer, offset + 6, 4);
+    if (keySize > MAX_KEY_SIZE || payloadSize > MAX_PAYLOAD_SIZE) {
+        return PARSE_ERROR;
+    }
+    
+    size_t total = HEADER_SIZE + keySize + payloadSize;
+    if (buffer.size() - offset < total) {
+        return PARSE_INCOMPLETE;
+    }
+    
+    out.type = (uint8_t)buffer[offset + 3];
+    out.key.assign(buffer, offset + HEADER_SIZE, keySize);
+    out.payload.assign(buffer, offset + HEADER_SIZE + keySize, payloadSize);
+    offset += total;
+    return PARSE_OK;
+}
+
+std::string StatsHubProtocol::encodeYouTubeStats(const YouTubeChannelStats& stats) {
+    std::string out;
+    putI64(out, stats.isValid ? 1 : 0);
+    putI64(out, stats.subscriberCount);
+    putI64(out, stats.viewCount);
+    putI64(out, stats.videoCount);
+    putString(out, stats.channelId);
+    putString(out, stats.errorMessage);
+    return out;
+}
+
+bool StatsHubProtocol::decodeYouTubeStats(const std::string& payload, YouTubeChannelStats& stats) {
+    PayloadReader reader(payload);
+    stats.isValid = reader.i64() != 0;
+    stats.subscriberCount = (long)reader.i64();
+    stats.viewCount = (long)reader.i64();
+    stats.videoCount = (long)reader.i64();
+    stats.channelId = reader.str();
+    stats.errorMessage = reader.str();
+    return reader.ok();
+}
+
+std::string StatsHubProtocol::encodeSpotifyStats(const SpotifyArtistStats& stats) {
+    std::string out;
+    putI64(out, stats.isValid ? 1 : 0);
+    putI64(out, stats.popularity);
+    putI64(out, stats.monthlyListeners);
+    putI64(out, stats.albumCount);
+    putI64(out, stats.trackCount);
+    putString(out, stats.name);
+    putString(out, stats.topTrack);
+    putString(out, stats.genres);
+    putString(out, stats.imageUrl);
+    putString(out, stats.errorMessage);
+    return out;
+}
+
+bool StatsHubProtocol::decodeSpotifyStats(const std::string& payload, SpotifyArtistStats& stats) {
+    PayloadReader reader(payload);
+    stats.isValid = reader.i64() != 0;
+    stats.popularity = (int)reader.i64();
+    stats.monthlyListeners = (int)reader.i64();
+    stats.albumCount = (int)reader.i64();
+    stats.trackCount = (int)reader.i64();
+    stats.name = reader.str();
+    stats.topTrack = reader.str();
+    stats.genres = reader.str();
+    stats.imageUrl = reader.str();
+    stats.errorMessage = reader.str();
+    return reader.ok();
+}
@@ -0,0 +1,59 @@
+#ifndef STATS_HUB_PROTOCOL_H
+#define STATS_HUB_PROTOCOL_H
+
+#include "infrastructure/network/youtube_api.h"
+#include "infrastructure/network/spotify_api.h"
+#include <string>
+#include <stdint.h>
+
+// Wire format shared by StatsHubServer and StatsHubClient.
+//
+// Every message is a 10-byte header followed by the key and the payload:
+//
+//   magic "SH" | version | type | key length (u16) | payload length (u32)
+//
+// All integers are big-endian. Keys use the fetch scheduler's naming
+// ("youtube:<channel>", "spotify:<artist>"). Stats payloads are a fixed
+// sequence of i64 numbers and u16-length-prefixed strings.
+class StatsHubProtocol {
+public:
+    enum MessageType {
+        MSG_SUBSCRIBE = 1,      // client -> hub: send me updates for key
+        MSG_UNSUBSCRIBE = 2,    // client -> hub
+        MSG_REFRESH = 3,        // client -> hub: user asked for fresh data
+        MSG_YOUTUBE_STATS = 4,  // hub -> client
+        MSG_SPOTIFY_STATS = 5   // hub -> client
+    };
+    
+    struct Message {
+        uint8_t type;
+        std::string key;
+        std::string payload;
+        
+        Message() : type(0) {}
+    };
+    
+    enum ParseResult {
+        PARSE_OK,          // `out` holds a message, `offset` moved past it
+        PARSE_INCOMPLETE,  // Need more bytes
+        PARSE_ERROR        // Stream is corrupt; drop the connection
+    };
+    
+    static void appendMessage(std::string& out, uint8_t type, const std::string& key,
+                              const std::string& payload = "");
+    static ParseResult parseMessage(const std::string& buffer, size_t& offset, Message& out);
+    
+    // Stats payloads
+    static std::string encodeYouTubeStats(const YouTubeChannelStats& stats);
+    static bool decodeYouTubeStats(const std::string& payload, YouTubeChannelStats& stats);
+    static std::string encodeSpotifyStats(const SpotifyArtistStats& stats);
+    static bool decodeSpotifyStats(const std::string& payload, SpotifyArtistStats& stats);
+    
+    static const uint8_t VERSION = 1;
+    static const size_t HEADER_SIZE = 10;
+    static const size_t MAX_KEY_SIZE = 256;
+    static const size_t MAX_PAYLOAD_SIZE = 64 * 1024;
+    static const int DEFAULT_PORT = 7405;
+};
+
+#endif // STATS_HUB_PROTOCOL_H
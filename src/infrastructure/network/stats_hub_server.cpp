@@ -0,0 +1,353 @@
+#include "stats_hub_server.h"
+#include "infrastructure/config/config.h"
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+namespace {
+
+const char* YOUTUBE_PREFIX = "youtube:";
+const char* SPOTIFY_PREFIX = "spotify:";
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+bool hasPrefix(const std::string& value, const char* prefix) {
+    return value.compare(0, strlen(prefix), prefix) == 0 && value.size() > strlen(prefix);
+}
+
+} // namespace
+
+StatsHubServer::StatsHubServer(int port, FetchScheduler* scheduler, YouTubeFetch fetchYouTube, SpotifyFetch fetchSpotify)
+    : port_(port), scheduler_(scheduler), fetchYouTube_(fetchYouTube), fetchSpotify_(fetchSpotify),
+      listenFd_(-1), running_(false), fetchCount_(0), publishCount_(0),
+      droppedClientCount_(0) {
+    wakePipe_[0] = -1;
+    wakePipe_[1] = -1;
+}
+
+StatsHubServer::~StatsHubServer() {
+    stop();
+}
+
+bool StatsHubServer::start() {
+    if (running_) {
+        return true;
+    }
+    
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        lastError_ = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+    
+    int reuse = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port_);
+    
+    if (bind(listenFd_, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(listenFd_, 64) != 0 || !setNonBlocking(listenFd_) || pipe(wakePipe_) != 0) {
+        lastError_ = std::string("Cannot listen on port ") + std::to_string(port_) + ": " + std::strerror(errno);
+        close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+    setNonBlocking(wakePipe_[0]);
+    
+    running_ = true;
+    serverThread_ = std::thread(&StatsHubServer::serverLoop, this);
+    
+    std::cout << "📡 Stats hub listening on port " << port_ << std::endl;
+    return true;
+}
+
+void StatsHubServer::stop() {
+    if (!running_) {
+        return;
+    }
+    
+    running_ = false;
+    wake();
+    if (serverThread_.joinable()) {
+        serverThread_.join();
+    }
+    
+    // Stop fetching; removeSource waits for a fetch in flight, which may
+    // still publish, so mutex_ must not be held here
+    std::set<std::string> sources;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sources.swap(sources_);
+    }
+    for (std::set<std::string>::const_iterator it = sources.begin(); it != sources.end(); ++it) {
+        scheduler_->removeSource(schedulerKey(*it));
+    }
+    
+    close(listenFd_);
+    close(wakePipe_[0]);
+    close(wakePipe_[1]);
+    listenFd_ = -1;
+    wakePipe_[0] = -1;
+    wakePipe_[1] = -1;
+}
+
+void StatsHubServer::addYouTubeChannel(const std::string& channelId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ensureSource(YOUTUBE_PREFIX + channelId);
+}
+
+void StatsHubServer::addSpotifyArtist(const std::string& artistId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ensureSource(SPOTIFY_PREFIX + artistId);
+}
+
+size_t StatsHubServer::getClientCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return clients_.size();
+}
+
+unsigned long StatsHubServer::getFetchCount() const {
+    return fetchCount_.load();
+}
+
+unsigned long StatsHubServer::getPublishCount() const {
+    return publishCount_.load();
+}
+
+unsigned long StatsHubServer::getDroppedClientCount() const {
+    return droppedClientCount_.load();
+}
+
+std::string StatsHubServer::getLastError() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lastError_;
+}
+
+void StatsHubServer::serverLoop() {
+    std::vector<struct pollfd> fds;
+    
+    while (running_) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            fds.resize(2 + clients_.size());
+            size_t i = 2;
+            for (std::map<int, Client>::const_iterator it = clients_.begin(); it != clients_.end(); ++it, ++i) {
+                fds[i].fd = it->first;
+                fds[i].events = POLLIN | (it->second.output.empty() ? 0 : POLLOUT);
+                fds[i].revents = 0;
+            }
+        }
+        fds[0].fd = listenFd_;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = wakePipe_[0];
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+        
+        if (poll(&fds[0], fds.size(), 1000) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        
+        if (fds[1].revents & POLLIN) {
+            char drain[64];
+            while (read(wakePipe_[0], drain, sizeof(drain)) > 0) {
+            }
+        }
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        for (size_t i = 2; i < fds.size(); i++) {
+            std::map<int, Client>::iterator it = clients_.find(fds[i].fd);
+            if (it == clients_.end()) continue;
+            
+            bool closed = it->second.stalled;
+            if (!closed && (fds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                closed = readClient(it->second);
+            }
+            // Publishes may have queued output since poll; always try to flush
+            if (!closed) {
+                closed = flushClient(it->second);
+            }
+            if (closed) {
+                close(it->first);
+                clients_.erase(it);
+            }
+        }
+        
+        if (fds[0].revents & POLLIN) {
+            int fd;
+            while ((fd = accept(listenFd_, nullptr, nullptr)) >= 0) {
+                setNonBlocking(fd);
+                int noDelay = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+                clients_[fd].fd = fd;
+            }
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::map<int, Client>::const_iterator it = clients_.begin(); it != clients_.end(); ++it) {
+        close(it->first);
+    }
+    clients_.clear();
+}
+
+bool StatsHubServer::readClient(Client& client) {
+    char buffer[4096];
+    ssize_t got;
+    while ((got = read(client.fd, buffer, sizeof(buffer))) > 0) {
+        client.input.append(buffer, (size_t)got);
+    }
+    bool closed = got == 0 || (got < 0 && errno != EAGAIN && errno != EWOULDBLOCK);
+    
+    size_t offset = 0;
+    StatsHubProtocol::Message message;
+    StatsHubProtocol::ParseResult result;
+    while ((result = StatsHubProtocol::parseMessage(client.input, offset, message)) == StatsHubProtocol::PARSE_OK) {
+        handleMessage(client, message);
+    }
+    client.input.erase(0, offset);
+    
+    return closed || result == StatsHubProtocol::PARSE_ERROR;
+}
+
+bool StatsHubServer::flushClient(Client& client) {
+    while (!client.output.empty()) {
+        ssize_t sent = send(client.fd, client.output.data(), client.output.size(), MSG_NOSIGNAL);
+        if (sent < 0) {
+            return errno != EAGAIN && errno != EWOULDBLOCK;
+        }
+        client.output.erase(0, (size_t)sent);
+    }
+    return false;
+}
+
+void StatsHubServer::handleMessage(Client& client, const StatsHubProtocol::Message& message) {
+    switch (message.type) {
+        case StatsHubProtocol::MSG_SUBSCRIBE: {
+            if (!ensureSource(message.key)) {
+                return;
+            }
+            client.keys.insert(message.key);
+            // Late joiners get the current value right away
+            std::map<std::string, std::string>::const_iterator cached = latest_.find(message.key);
+            if (cached != latest_.end()) {
+                client.output += cached->second;
+            }
+            break;
+        }
+        case StatsHubProtocol::MSG_UNSUBSCRIBE:
+            client.keys.erase(message.key);
+            break;
+        case StatsHubProtocol::MSG_REFRESH:
+            if (sources_.count(message.key)) {
+                // Coalesces with any fetch already queued for this key
+                scheduler_->requestRefresh(schedulerKey(message.key), FetchScheduler::PRIORITY_USER);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void StatsHubServer::wake() {
+    char wake = 1;
+    if (write(wakePipe_[1], &wake, 1) < 0) {
+        // Pipe full means a wake-up is already pending
+    }
+}
+
+bool StatsHubServer::ensureSource(const std::string& key) {
+    if (sources_.count(key)) {
+        return true;
+    }
+    
+    int intervalMs;
+    if (hasPrefix(key, YOUTUBE_PREFIX)) {
+        intervalMs = Config::YOUTUBE_REFRESH_INTERVAL_MS;
+    } else if (hasPrefix(key, SPOTIFY_PREFIX)) {
+        intervalMs = Config::SPOTIFY_REFRESH_INTERVAL_MS;
+    } else {
+        return false;
+    }
+    
+    if (sources_.size() >= MAX_SOURCES) {
+        lastError_ = "Source limit reached, ignoring " + key;
+        std::cerr << "⚠️  " << lastError_ << std::endl;
+        return false;
+    }
+    
+    sources_.insert(key);
+    scheduler_->addSource(schedulerKey(key), intervalMs, Config::REFRESH_JITTER_MS, [this, key]() {
+        fetchAndPublish(key);
+    });
+    // First fetch right away rather than after a full interval
+    scheduler_->requestRefresh(schedulerKey(key), FetchScheduler::PRIORITY_BACKGROUND);
+    return true;
+}
+
+void StatsHubServer::fetchAndPublish(const std::string& key) {
+    std::string message;
+    bool valid;
+    if (hasPrefix(key, YOUTUBE_PREFIX)) {
+        YouTubeChannelStats stats = fetchYouTube_(key.substr(strlen(YOUTUBE_PREFIX)));
+        valid = stats.isValid;
+        StatsHubProtocol::appendMessage(message, StatsHubProtocol::MSG_YOUTUBE_STATS, key,
+                                        StatsHubProtocol::encodeYouTubeStats(stats));
+    } else {
+        SpotifyArtistStats stats = fetchSpotify_(key.substr(strlen(SPOTIFY_PREFIX)));
+        valid = stats.isValid;
+        StatsHubProtocol::appendMessage(message, StatsHubProtocol::MSG_SPOTIFY_STATS, key,
+                                        StatsHubProtocol::encodeSpotifyStats(stats));
+    }
+    fetchCount_++;
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (valid) {
+        latest_[key] = message;
+    } else if (latest_.count(key)) {
+        return; // Transient failure: clients keep showing the last good result
+    }
+    // A key that never fetched successfully still reports its error to
+    // current subscribers (e.g. a mistyped ID), but the error isn't cached
+    publish(key, message);
+}
+
+void StatsHubServer::publish(const std::string& key, const std::string& message) {
+    for (std::map<int, Client>::iterator it = clients_.begin(); it != clients_.end(); ++it) {
+        Client& client = it->second;
+        if (!client.keys.count(key) || client.stalled) continue;
+        if (client.output.size() + message.size() > MAX_CLIENT_BACKLOG) {
+            // Stalled client: everything queued is stale by now, so let it
+            // reconnect and resubscribe rather than feed it old updates
+            client.stalled = true;
+            client.output.clear();
+            droppedClientCount_++;
+            std::cerr << "⚠️  Dropping stats hub client that stopped reading" << std::endl;
+            continue;
+        }
+        client.output += message;
+        publishCount_++;
+    }
+    
+    wake();
+}
+
+std::string StatsHubServer::schedulerKey(const std::string& key) {
+    return "hub:" + key;
+}
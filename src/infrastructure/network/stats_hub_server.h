@@ -0,0 +1,106 @@
+#ifndef STATS_HUB_SERVER_H
+#define STATS_HUB_SERVER_H
+
+#include "infrastructure/network/stats_hub_protocol.h"
+#include "infrastructure/network/youtube_api.h"
+#include "infrastructure/network/spotify_api.h"
+#include "shared/network/fetch_scheduler.h"
+#include <string>
+#include <map>
+#include <set>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <atomic>
+
+// Hub side of the stats fan-out. Fetches every configured (or subscribed)
+// channel and artist once per interval through the shared fetch scheduler
+// and pushes each result to all interested clients over TCP, so upstream
+// API traffic stays the same no matter how many displays are connected.
+//
+// New subscribers get the latest cached result immediately. A client's
+// refresh request becomes a user-priority refresh on the scheduler, so
+// simultaneous refreshes from the whole fleet coalesce into one fetch.
+// A client that stops reading is disconnected once MAX_CLIENT_BACKLOG is
+// queued for it; on reconnect it resubscribes and gets current values.
+// Failed fetches are not cached, so nobody is handed an error in place of
+// the last good result.
+//
+// The upstream fetch itself is supplied by the owner: StatsHubApiFetcher
+// wraps the real API clients, tools/stats_hub_probe passes a stub.
+class StatsHubServer {
+public:
+    // Called on the scheduler's worker thread, one source at a time per key
+    typedef std::function<YouTubeChannelStats(const std::string& channel)> YouTubeFetch;  // ID or @handle
+    typedef std::function<SpotifyArtistStats(const std::string& artistId)> SpotifyFetch;
+    
+    StatsHubServer(int port, FetchScheduler* scheduler, YouTubeFetch fetchYouTube, SpotifyFetch fetchSpotify);
+    ~StatsHubServer();
+    
+    // Lifecycle (the socket loop runs on its own thread)
+    bool start();
+    void stop();
+    
+    // Sources fetched regardless of subscribers
+    void addYouTubeChannel(const std::string& channelId);
+    void addSpotifyArtist(const std::string& artistId);
+    
+    // Diagnostics
+    size_t getClientCount() const;
+    unsigned long getFetchCount() const;
+    unsigned long getPublishCount() const;
+    unsigned long getDroppedClientCount() const;
+    std::string getLastError() const;
+    
+    static const size_t MAX_SOURCES = 64;
+    static const size_t MAX_CLIENT_BACKLOG = 1024 * 1024;  // Clients past this are disconnected
+    
+private:
+    struct Client {
+        int fd;
+        std::string input;
+        std::string output;
+        std::set<std::string> keys;
+        bool stalled;   // Over MAX_CLIENT_BACKLOG; closed by the server thread
+        
+        Client() : fd(-1), stalled(false) {}
+    };
+    
+    int port_;
+    FetchScheduler* scheduler_;
+    YouTubeFetch fetchYouTube_;
+    SpotifyFetch fetchSpotify_;
+    
+    int listenFd_;
+    int wakePipe_[2];
+    std::map<int, Client> clients_;
+    std::map<std::string, std::string> latest_;  // key -> last successful encoded message
+    std::set<std::string> sources_;
+    std::string lastError_;
+    mutable std::mutex mutex_;
+    
+    std::thread serverThread_;
+    std::atomic<bool> running_;
+    std::atomic<unsigned long> fetchCount_;
+    std::atomic<unsigned long> publishCount_;
+    std::atomic<unsigned long> droppedClientCount_;
+    
+    // Socket loop (clients_ is only modified on the server thread)
+    void serverLoop();
+    bool readClient(Client& client);
+    bool flushClient(Client& client);
+    void handleMessage(Client& client, const StatsHubProtocol::Message& message);
+    void wake();
+    
+    // Fetching (called with mutex_ held unless noted)
+    bool ensureSource(const std::string& key);
+    void fetchAndPublish(const std::string& key);  // Scheduler thread, no lock held
+    void publish(const std::string& key, const std::string& message);
+    static std::string schedulerKey(const std::string& key);
+    
+    // Disable copy constructor and assignment operator
+    StatsHubServer(const StatsHubServer&) = delete;
+    StatsHubServer& operator=(const StatsHubServer&) = delete;
+};
+
+#endif // STATS_HUB_SERVER_H
@@ -0,0 +1,390 @@
+#include "sync_node.h"
+#include "shared/utils/monotonic_clock.h"
+#include <iostream>
+#include <random>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#include <unistd.h>
+#include <poll.h>
+#include <netdb.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+SyncNode::SyncNode(Role role, const std::string& host, int port, const std::string& name, SyncClock* clock)
+    : role_(role), host_(host), port_(port), name_(name.substr(0, SyncProtocol::NAME_SIZE)), clock_(clock),
+      nodeId_(0), socketFd_(-1), running_(false), frameCount_(0), frameOffsetTotalUs_(0), unmatchedReports_(0),
+      sequence_(0), pingsSent_(0), pongsReceived_(0), lastPongMs_(0), malformed_(0) {
+    wakePipe_[0] = -1;
+    wakePipe_[1] = -1;
+}
+
+SyncNode::~SyncNode() {
+    stop();
+}
+
+bool SyncNode::start() {
+    if (running_) {
+        return true;
+    }
+
+    socketFd_ = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (socketFd_ < 0) {
+        lastError_ = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+
+    if (role_ == LEADER) {
+        struct sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        addr.sin_port = htons((uint16_t)port_);
+        if (bind(socketFd_, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+            lastError_ = std::string("Cannot bind UDP port ") + std::to_string(port_) + ": " + std::strerror(errno);
+            stop();
+            return false;
+        }
+    } else {
+        // Connected, so only the leader's answers arrive
+        struct addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_DGRAM;
+        struct addrinfo* results = nullptr;
+        std::string service = std::to_string(port_);
+        int error = getaddrinfo(host_.c_str(), service.c_str(), &hints, &results);
+        if (error != 0) {
+            lastError_ = host_ + ": " + gai_strerror(error);
+            stop();
+            return false;
+        }
+        bool connected = connect(socketFd_, results->ai_addr, results->ai_addrlen) == 0;
+        freeaddrinfo(results);
+        if (!connected) {
+            lastError_ = std::string("connect: ") + std::strerror(errno);
+            stop();
+            return false;
+        }
+        std::random_device random;
+        nodeId_ = random();
+    }
+
+    if (pipe(wakePipe_) != 0) {
+        lastError_ = std::string("pipe: ") + std::strerror(errno);
+        stop();
+        return false;
+    }
+
+    running_ = true;
+    if (role_ == LEADER) {
+        clock_->lead();
+        thread_ = std::thread(&SyncNode::leaderLoop, this);
+        std::cout << "🔗 Leading displays in sync on UDP port " << port_ << std::endl;
+    } else {
+        thread_ = std::thread(&SyncNode::followerLoop, this);
+        std::cout << "🔗 Following the sync leader at " << host_ << ":" << port_ << std::endl;
+    }
+    return true;
+}
+
+void SyncNode::stop() {
+    if (running_) {
+        running_ = false;
+        char wake = 1;
+        if (write(wakePipe_[1], &wake, 1) < 0) {
+            // Thread still exits on its next poll timeout
+        }
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    if (socketFd_ >= 0) {
+        close(socketFd_);
+        socketFd_ = -1;
+    }
+    for (int i = 0; i < 2; i++) {
+        if (wakePipe_[i] >= 0) {
+            close(wakePipe_[i]);
+            wakePipe_[i] = -1;
+        }
+    }
+}
+
+void SyncNode::frameShown() {
+    long long tick = clock_->getTick();
+    if (tick <= 0) {
+        return;
+    }
+    long long offsetUs = clock_->sharedNowUs() - clock_->getTickStartUs();
+    if (offsetUs > INT_MAX) {
+        offsetUs = INT_MAX;
+    } else if (offsetUs < INT_MIN) {
+        offsetUs = INT_MIN;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Frame& frame = frames_[tick % FRAME_HISTORY];
+    frame.tick = tick;
+    frame.offsetUs = (int)offsetUs;
+    lastFrame_ = frame;
+    frameCount_++;
+    frameOffsetTotalUs_ += offsetUs;
+}
+
+void SyncNode::beginEpoch() {
+    if (role_ != LEADER) {
+        return;
+    }
+    clock_->beginEpoch(EPOCH_LEAD_MS * 1000LL);
+    long long startUs = 0;
+    uint32_t epoch = clock_->getAnnouncedEpoch(startUs);
+    std::cout << "🔗 Epoch " << epoch << " starts on every display in " << EPOCH_LEAD_MS << " ms" << std::endl;
+}
+
+void SyncNode::leaderLoop() {
+    struct pollfd fds[2];
+    fds[0].fd = socketFd_;
+    fds[0].events = POLLIN;
+    fds[1].fd = wakePipe_[0];
+    fds[1].events = POLLIN;
+    uint8_t packet[SyncProtocol::MAX_PACKET_SIZE + 1];
+
+    while (running_) {
+        if (poll(fds, 2, 500) <= 0 || (fds[1].revents & POLLIN)) {
+            continue;
+        }
+
+        // Drain everything queued before sleeping again
+        while (running_) {
+            struct sockaddr_in from;
+            socklen_t fromSize = sizeof(from);
+            ssize_t size = recvfrom(socketFd_, packet, sizeof(packet), 0, (struct sockaddr*)&from, &fromSize);
+            long long receiveUs = clock_->sharedNowUs();
+            if (size < 0) {
+                break;  // EAGAIN: queue empty
+            }
+            answerPing(packet, (size_t)size, from, receiveUs);
+        }
+    }
+}
+
+void SyncNode::answerPing(const uint8_t* packet, size_t size, const struct sockaddr_in& from, long long receiveUs) {
+    SyncProtocol::Ping ping;
+    if (!SyncProtocol::decodePing(packet, size, ping)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        malformed_++;
+        return;
+    }
+
+    SyncProtocol::Pong pong;
+    pong.sequence = ping.sequence;
+    pong.originUs = ping.originUs;
+    pong.receiveUs = receiveUs;
+    pong.tickUs = (uint32_t)clock_->getTickUs();
+    long long epochStartUs = 0;
+    pong.epoch = clock_->getAnnouncedEpoch(epochStartUs);
+    pong.epochStartUs = epochStartUs;
+    uint8_t answer[SyncProtocol::MAX_PACKET_SIZE];
+    pong.transmitUs = clock_->sharedNowUs();
+    size_t answerSize = SyncProtocol::encodePong(answer, sizeof(answer), pong);
+    sendto(socketFd_, answer, answerSize, 0, (const struct sockaddr*)&from, sizeof(from));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<uint32_t, Follower>::iterator it = followers_.find(ping.nodeId);
+    if (it == followers_.end()) {
+        if ((int)followers_.size() >= MAX_FOLLOWERS) {
+            return;
+        }
+        Follower follower;
+        follower.name = ping.name[0] ? ping.name : "follower";
+        follower.reportTick = -1;
+        follower.reportOffsetUs = 0;
+        follower.skewCount = 0;
+        follower.skewTotalUs = 0;
+        follower.skewWorstUs = 0;
+        follower.lastSkewUs = 0;
+        it = followers_.insert(std::make_pair(ping.nodeId, follower)).first;
+        std::cout << "🔗 " << follower.name << " (" << inet_ntoa(from.sin_addr) << ") is following" << std::endl;
+    }
+    Follower& follower = it->second;
+    follower.address = from;
+    follower.lastSeenMs = MonotonicClock::nowMs();
+    follower.uncertaintyUs = ping.uncertaintyUs;
+    follower.epoch = ping.epoch;
+    if (ping.reportTick > 0 && ping.reportTick != follower.reportTick) {
+        if (follower.reportTick > 0) {
+            recordSkew(follower, follower.reportTick, follower.reportOffsetUs);
+        }
+        follower.reportTick = ping.reportTick;
+        follower.reportOffsetUs = ping.reportOffsetUs;
+    }
+}
+
+void SyncNode::recordSkew(Follower& follower, long long tick, int offsetUs) {
+    // Only ticks this display drew too can be compared
+    const Frame& frame = frames_[tick % FRAME_HISTORY];
+    if (frame.tick != tick) {
+        unmatchedReports_++;
+        return;
+    }
+    int skewUs = offsetUs - frame.offsetUs;
+    long long absoluteUs = skewUs < 0 ? -(long long)skewUs : skewUs;
+    follower.skewCount++;
+    follower.skewTotalUs += absoluteUs;
+    if (absoluteUs > follower.skewWorstUs) {
+        follower.skewWorstUs = absoluteUs;
+    }
+    follower.lastSkewUs = skewUs;
+}
+
+void SyncNode::followerLoop() {
+    struct pollfd fds[2];
+    fds[0].fd = socketFd_;
+    fds[0].events = POLLIN;
+    fds[1].fd = wakePipe_[0];
+    fds[1].events = POLLIN;
+    uint8_t packet[SyncProtocol::MAX_PACKET_SIZE + 1];
+    long long nextPingMs = 0;
+
+    while (running_) {
+        long long nowMs = MonotonicClock::nowMs();
+        if (nowMs >= nextPingMs) {
+            sendPing();
+            bool settling = pongsReceived_ < (unsigned long)FAST_PINGS;
+            nextPingMs = nowMs + (settling ? FAST_PING_INTERVAL_MS : PING_INTERVAL_MS);
+        }
+
+        if (poll(fds, 2, (int)(nextPingMs - nowMs)) <= 0 || (fds[1].revents & POLLIN)) {
+            continue;
+        }
+        while (running_) {
+            ssize_t size = recv(socketFd_, packet, sizeof(packet), 0);
+            long long returnUs = clock_->localNowUs();
+            if (size < 0) {
+                break;  // EAGAIN, or ECONNREFUSED while the leader is away
+            }
+            handlePong(packet, (size_t)size, returnUs);
+        }
+    }
+}
+
+void SyncNode::sendPing() {
+    SyncProtocol::Ping ping;
+    ping.nodeId = nodeId_;
+    ping.sequence = ++sequence_;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ping.reportTick = lastFrame_.tick;
+        ping.reportOffsetUs = lastFrame_.offsetUs;
+    }
+    ping.uncertaintyUs = (uint32_t)clock_->getUncertaintyUs();
+    ping.epoch = clock_->getEpoch();
+    std::strncpy(ping.name, name_.c_str(), SyncProtocol::NAME_SIZE);
+    ping.name[SyncProtocol::NAME_SIZE] = '\0';
+
+    uint8_t packet[SyncProtocol::MAX_PACKET_SIZE];
+    ping.originUs = clock_->localNowUs();
+    size_t size = SyncProtocol::encodePing(packet, sizeof(packet), ping);
+    if (send(socketFd_, packet, size, 0) == (ssize_t)size) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pingsSent_++;
+    }
+}
+
+void SyncNode::handlePong(const uint8_t* packet, size_t size, long long returnUs) {
+    SyncProtocol::Pong pong;
+    if (!SyncProtocol::decodePong(packet, size, pong)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        malformed_++;
+        return;
+    }
+
+    bool firstPong = pongsReceived_ == 0;
+    clock_->setTickUs(pong.tickUs);
+    clock_->addSample(pong.originUs, pong.receiveUs, pong.transmitUs, returnUs);
+    clock_->setEpoch(pong.epoch, pong.epochStartUs);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pongsReceived_++;
+        lastPongMs_ = MonotonicClock::nowMs();
+    }
+    if (firstPong) {
+        std::cout << "🔗 In sync with the leader at " << host_ << ":" << port_ << ", tick "
+                  << (pong.tickUs / 1000.0) << " ms" << std::endl;
+    }
+}
+
+void SyncNode::printReport(std::ostream& out) const {
+    long long startUs = 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t epoch = clock_->getAnnouncedEpoch(startUs);
+
+    if (role_ == LEADER) {
+        out << "\033[1;36m🔗 Sync leader on UDP port " << port_ << ": tick " << (clock_->getTickUs() / 1000.0)
+            << " ms, epoch " << epoch << "\033[0m" << std::endl;
+    } else {
+        out << "\033[1;36m🔗 Following " << host_ << ":" << port_ << ": tick " << (clock_->getTickUs() / 1000.0)
+            << " ms, epoch " << epoch << "\033[0m" << std::endl;
+        long long offsetUs = clock_->getOffsetUs();
+        out << "  clock:    " << (clock_->isLocked() ? "locked" : "not locked yet") << ", offset "
+            << (offsetUs >= 0 ? "+" : "") << offsetUs << " µs (±" << clock_->getUncertaintyUs() << " µs), "
+            << clock_->getSampleCount() << " samples, " << clock_->getStepCount() << " steps" << std::endl;
+        out << "  pings:    " << pingsSent_ << " sent, " << pongsReceived_ << " answered";
+        if (pongsReceived_ > 0) {
+            out << ", last answer " << (MonotonicClock::nowMs() - lastPongMs_) << " ms ago";
+        }
+        out << std::endl;
+    }
+
+    out << "  frames:   " << frameCount_ << " shown";
+    if (frameCount_ > 0) {
+        out << ", swapped " << (frameOffsetTotalUs_ / (long long)frameCount_) << " µs after the tick on average";
+    }
+    out << std::endl;
+    if (malformed_ > 0) {
+        out << "  ignored:  " << malformed_ << " malformed packets" << std::endl;
+    }
+
+    if (role_ != LEADER) {
+        return;
+    }
+    if (followers_.empty()) {
+        out << "  \033[0;33m💡 No followers yet (start them with --sync-follow <this host>:" << port_ << ")\033[0m" << std::endl;
+        return;
+    }
+    long long nowMs = MonotonicClock::nowMs();
+    for (std::map<uint32_t, Follower>::const_iterator it = followers_.begin(); it != followers_.end(); ++it) {
+        const Follower& follower = it->second;
+        out << "  " << follower.name << " (" << inet_ntoa(follower.address.sin_addr) << "): ";
+        if (follower.skewCount > 0) {
+            out << "skew " << (follower.skewTotalUs / (long long)follower.skewCount) << " µs average, "
+                << follower.skewWorstUs << " µs worst, last " << (follower.lastSkewUs >= 0 ? "+" : "")
+                << follower.lastSkewUs << " µs over " << follower.skewCount << " frames";
+        } else {
+            out << "no frames compared yet";
+        }
+        out << "; clock ±" << follower.uncertaintyUs << " µs, epoch " << follower.epoch;
+        if (nowMs - follower.lastSeenMs > FOLLOWER_TIMEOUT_MS) {
+            out << ", \033[0;31msilent for " << (nowMs - follower.lastSeenMs) / 1000 << " s\033[0m";
+        }
+        out << std::endl;
+    }
+    if (unmatchedReports_ > 0) {
+        out << "  " << unmatchedReports_ << " follower frames fell on ticks this display skipped" << std::endl;
+    }
+}
+
+bool SyncNode::parseAddress(const std::string& address, std::string& host, int& port) {
+    size_t colon = address.rfind(':');
+    if (colon == std::string::npos) {
+        host = address;
+        port = SyncProtocol::DEFAULT_PORT;
+    } else {
+        host = address.substr(0, colon);
+        port = std::atoi(address.c_str() + colon + 1);
+    }
+    return !host.empty() && port > 0 && port < 65536;
+}
@@ -0,0 +1,137 @@
+#ifndef SYNC_NODE_H
+#define SYNC_NODE_H
+
+#include "infrastructure/network/sync_protocol.h"
+#include "shared/utils/sync_clock.h"
+#include <ostream>
+#include <string>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <stdint.h>
+#include <netinet/in.h>
+
+// Keeps several displays' SyncClocks on one timebase over UDP.
+//
+// The leader listens on a port. Each follower pings it every
+// PING_INTERVAL_MS (faster until its clock has settled) and the answer
+// carries the leader's receive and transmit times, its tick length and its
+// current epoch; the timestamps let the follower take the network delay
+// out of the offset, which a plain broadcast of the leader's time couldn't.
+// New epochs are announced EPOCH_LEAD_MS ahead, more than a ping interval,
+// so every follower knows one before it starts.
+//
+// Both sides report each frame they swap in with frameShown(). Followers
+// send their latest frame along with their pings; the leader compares it
+// with its own frame of the same tick once the next ping shows up, when it
+// has surely drawn that tick too. That gives the skew between the displays
+// as each of them measures it on the shared timebase.
+class SyncNode {
+public:
+    enum Role {
+        LEADER,
+        FOLLOWER
+    };
+
+    // Leader: `host` is ignored and `port` is listened on. Follower: pings
+    // the leader at host:port. `name` identifies a follower in the leader's
+    // report. The clock is not owned.
+    SyncNode(Role role, const std::string& host, int port, const std::string& name, SyncClock* clock);
+    ~SyncNode();
+
+    // Lifecycle
+    bool start();
+    void stop();
+
+    // Render thread: the frame of the clock's current tick is on the panel
+    void frameShown();
+
+    // Leader: restart blinking and text rotation on every display
+    void beginEpoch();
+
+    Role getRole() const { return role_; }
+    void printReport(std::ostream& out) const;
+    std::string getLastError() const { return lastError_; }
+
+    // "host" or "host:port" of the leader
+    static bool parseAddress(const std::string& address, std::string& host, int& port);
+
+    static const int PING_INTERVAL_MS = 250;
+    static const int FAST_PING_INTERVAL_MS = 50;   // Until FAST_PINGS answers have come in
+    static const int FAST_PINGS = 20;
+    static const int EPOCH_LEAD_MS = 500;
+    static const int FOLLOWER_TIMEOUT_MS = 5000;   // Reported as silent after this
+    static const int MAX_FOLLOWERS = 64;
+    static const int FRAME_HISTORY = 1024;         // Leader frames kept for comparison (ticks)
+
+private:
+    // A frame as frameShown() saw it
+    struct Frame {
+        long long tick;
+        int offsetUs;    // Shared time after the tick's start
+
+        Frame() : tick(-1), offsetUs(0) {}
+    };
+
+    // Leader's view of one follower
+    struct Follower {
+        std::string name;
+        struct sockaddr_in address;
+        long long lastSeenMs;
+        long long reportTick;      // Latest frame, compared at the next ping
+        int reportOffsetUs;
+        uint32_t uncertaintyUs;
+        uint32_t epoch;
+        unsigned long skewCount;
+        long long skewTotalUs;     // Absolute values
+        long long skewWorstUs;
+        int lastSkewUs;
+    };
+
+    Role role_;
+    std::string host_;
+    int port_;
+    std::string name_;
+    SyncClock* clock_;
+    uint32_t nodeId_;
+    int socketFd_;
+    int wakePipe_[2];
+    std::string lastError_;
+
+    std::thread thread_;
+    std::atomic<bool> running_;
+
+    // Frames, from the render thread
+    mutable std::mutex mutex_;
+    Frame frames_[FRAME_HISTORY];
+    Frame lastFrame_;
+    unsigned long frameCount_;
+    long long frameOffsetTotalUs_;
+
+    // Leader state (under mutex_)
+    std::map<uint32_t, Follower> followers_;
+    unsigned long unmatchedReports_;
+
+    // Follower state (network thread; counters under mutex_)
+    uint32_t sequence_;
+    unsigned long pingsSent_;
+    unsigned long pongsReceived_;
+    long long lastPongMs_;
+
+    unsigned long malformed_;
+
+    // Helper methods
+    void leaderLoop();
+    void followerLoop();
+    void answerPing(const uint8_t* packet, size_t size, const struct sockaddr_in& from, long long receiveUs);
+    void sendPing();
+    void handlePong(const uint8_t* packet, size_t size, long long returnUs);
+    void recordSkew(Follower& follower, long long tick, int offsetUs);
+
+    // Disable copy constructor and assignment operator
+    SyncNode(const SyncNode&) = delete;
+    SyncNode& operator=(const SyncNode&) = delete;
+};
+
+#endif // SYNC_NODE_H
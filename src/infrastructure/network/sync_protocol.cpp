@@ -0,0 +1,116 @@
+#include "sync_protocol.h"
+#include <cstring>
+
+namespace {
+
+const uint8_t MAGIC_0 = 'L';
+const uint8_t MAGIC_1 = 'S';
+const uint8_t TYPE_PING = 1;
+const uint8_t TYPE_PONG = 2;
+
+uint8_t* putU32(uint8_t* p, uint32_t value) {
+    p[0] = (uint8_t)(value >> 24);
+    p[1] = (uint8_t)(value >> 16);
+    p[2] = (uint8_t)(value >> 8);
+    p[3] = (uint8_t)value;
+    return p + 4;
+}
+
+uint8_t* putI64(uint8_t* p, int64_t value) {
+    p = putU32(p, (uint32_t)((uint64_t)value >> 32));
+    return putU32(p, (uint32_t)value);
+}
+
+uint32_t getU32(const uint8_t*& p) {
+    uint32_t value = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    p += 4;
+    return value;
+}
+
+int64_t getI64(const uint8_t*& p) {
+    uint64_t high = getU32(p);
+    return (int64_t)((high << 32) | getU32(p));
+}
+
+uint8_t* putHeader(uint8_t* out, uint8_t type) {
+    out[0] = MAGIC_0;
+    out[1] = MAGIC_1;
+    out[2] = SyncProtocol::VERSION;
+    out[3] = type;
+    return out + 4;
+}
+
+bool checkHeader(const uint8_t* data, size_t size, uint8_t type, size_t expectedSize) {
+    return size == expectedSize && data[0] == MAGIC_0 && data[1] == MAGIC_1 &&
+           data[2] == SyncProtocol::VERSION && data[3] == type;
+}
+
+} // namespace
+
+size_t SyncProtocol::encodePing(uint8_t* out, size_t capacity, const Ping& ping) {
+    if (capacity < PING_SIZE) {
+        return 0;
+    }
+
+    uint8_t* p = putHeader(out, TYPE_PING);
+    p = putU32(p, ping.nodeId);
+    p = putU32(p, ping.sequence);
+    p = putI64(p, ping.originUs);
+    p = putI64(p, ping.reportTick);
+    p = putU32(p, (uint32_t)ping.reportOffsetUs);
+    p = putU32(p, ping.uncertaintyUs);
+    p = putU32(p, ping.epoch);
+    std::memset(p, 0, NAME_SIZE);
+    std::memcpy(p, ping.name, strnlen(ping.name, NAME_SIZE));
+    return PING_SIZE;
+}
+
+size_t SyncProtocol::encodePong(uint8_t* out, size_t capacity, const Pong& pong) {
+    if (capacity < PONG_SIZE) {
+        return 0;
+    }
+
+    uint8_t* p = putHeader(out, TYPE_PONG);
+    p = putU32(p, pong.sequence);
+    p = putI64(p, pong.originUs);
+    p = putI64(p, pong.receiveUs);
+    p = putI64(p, pong.transmitUs);
+    p = putU32(p, pong.tickUs);
+    p = putU32(p, pong.epoch);
+    putI64(p, pong.epochStartUs);
+    return PONG_SIZE;
+}
+
+bool SyncProtocol::decodePing(const uint8_t* data, size_t size, Ping& out) {
+    if (!checkHeader(data, size, TYPE_PING, PING_SIZE)) {
+        return false;
+    }
+
+    const uint8_t* p = data + 4;
+    out.nodeId = getU32(p);
+    out.sequence = getU32(p);
+    out.originUs = getI64(p);
+    out.reportTick = getI64(p);
+    out.reportOffsetUs = (int32_t)getU32(p);
+    out.uncertaintyUs = getU32(p);
+    out.epoch = getU32(p);
+    std::memcpy(out.name, p, NAME_SIZE);
+    out.name[NAME_SIZE] = '\0';
+    return true;
+}
+
+bool SyncProtocol::decodePong(const uint8_t* data, size_t size, Pong& out) {
+    if (!checkHeader(data, size, TYPE_PONG, PONG_SIZE)) {
+        return false;
+    }
+
+    const uint8_t* p = data + 4;
+    out.sequence = getU32(p);
+    out.originUs = getI64(p);
+    out.receiveUs = getI64(p);
+    out.transmitUs = getI64(p);
+    out.tickUs = getU32(p);
+    out.epoch = getU32(p);
+    out.epochStartUs = getI64(p);
+    return out.tickUs > 0;
+}
@@ -0,0 +1,67 @@
+#ifndef SYNC_PROTOCOL_H
+#define SYNC_PROTOCOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Datagrams between displays that run in sync (see SyncNode). A follower
+// pings the leader; the leader answers with its timebase and the current
+// state epoch:
+//
+//   PING  "LS" | version | 1 | node id (u32) | sequence (u32) | origin (i64)
+//         | report tick (i64) | report offset (i32) | uncertainty (u32)
+//         | epoch (u32) | name (16 bytes, NUL-padded)
+//   PONG  "LS" | version | 2 | sequence (u32) | origin (i64) | receive (i64)
+//         | transmit (i64) | tick (u32) | epoch (u32) | epoch start (i64)
+//
+// Times are microseconds, big-endian. Origin is the follower's clock when
+// it sent the ping, receive and transmit are the leader's clock, as in NTP.
+// The report is the follower's latest frame: its tick and how long after
+// the tick it was swapped in, on the shared timebase. Encoding and decoding
+// work on caller-provided buffers and never allocate.
+class SyncProtocol {
+public:
+    struct Ping {
+        uint32_t nodeId;           // Random per process
+        uint32_t sequence;
+        int64_t originUs;
+        int64_t reportTick;        // -1 before the first frame
+        int32_t reportOffsetUs;
+        uint32_t uncertaintyUs;    // Follower's clock error bound
+        uint32_t epoch;
+        char name[17];
+
+        Ping() : nodeId(0), sequence(0), originUs(0), reportTick(-1), reportOffsetUs(0), uncertaintyUs(0), epoch(0) {
+            name[0] = '\0';
+        }
+    };
+
+    struct Pong {
+        uint32_t sequence;
+        int64_t originUs;
+        int64_t receiveUs;
+        int64_t transmitUs;
+        uint32_t tickUs;
+        uint32_t epoch;
+        int64_t epochStartUs;      // May lie ahead: the epoch is announced early
+
+        Pong() : sequence(0), originUs(0), receiveUs(0), transmitUs(0), tickUs(0), epoch(0), epochStartUs(0) {}
+    };
+
+    // Return the packet size, or 0 if it doesn't fit in `capacity`
+    static size_t encodePing(uint8_t* out, size_t capacity, const Ping& ping);
+    static size_t encodePong(uint8_t* out, size_t capacity, const Pong& pong);
+
+    // Validate magic, version, type and length
+    static bool decodePing(const uint8_t* data, size_t size, Ping& out);
+    static bool decodePong(const uint8_t* data, size_t size, Pong& out);
+
+    static const uint8_t VERSION = 1;
+    static const size_t NAME_SIZE = 16;
+    static const size_t PING_SIZE = 56;
+    static const size_t PONG_SIZE = 48;
+    static const size_t MAX_PACKET_SIZE = 56;
+    static const int DEFAULT_PORT = 7407;
+};
+
+#endif // SYNC_PROTOCOL_H
@@ -0,0 +1,479 @@
+#include "websub_receiver.h"
+#include "shared/utils/sha1.h"
+#include <iostream>
+#include <sstream>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <ctime>
+#include <random>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+const char* WebSubReceiver::DEFAULT_HUB_URL = "https://pubsubhubbub.appspot.com/subscribe";
+
+namespace {
+
+const size_t MAX_REQUEST_SIZE = 64 * 1024;
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+long long nowSeconds() {
+    return (long long)time(nullptr);
+}
+
+} // namespace
+
+WebSubReceiver::WebSubReceiver(const std::string& callbackUrl, int listenPort, const std::string& hubUrl)
+    : callbackUrl_(callbackUrl), hubUrl_(hubUrl), listenPort_(listenPort), listenFd_(-1),
+      running_(false), notificationCount_(0), rejectedCount_(0) {
+    wakePipe_[0] = -1;
+    wakePipe_[1] = -1;
+    networkHandler_.setTimeout(10);
+}
+
+WebSubReceiver::~WebSubReceiver() {
+    stop();
+}
+
+bool WebSubReceiver::start() {
+    if (running_) {
+        return true;
+    }
+
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        lastError_ = std::string("socket: ") + std::strerror(errno);
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)listenPort_);
+
+    if (bind(listenFd_, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(listenFd_, 16) != 0 || !setNonBlocking(listenFd_) || pipe(wakePipe_) != 0) {
+        lastError_ = std::string("Cannot listen on port ") + std::to_string(listenPort_) + ": " + std::strerror(errno);
+        close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+
+    running_ = true;
+    serverThread_ = std::thread(&WebSubReceiver::serverLoop, this);
+
+    std::cout << "📡 WebSub callback listening on port " << listenPort_ << std::endl;
+    return true;
+}
+
+void WebSubReceiver::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    char wake = 1;
+    if (write(wakePipe_[1], &wake, 1) < 0) {
+        // Thread still exits on its next poll timeout
+    }
+
+    if (serverThread_.joinable()) {
+        serverThread_.join();
+    }
+
+    close(listenFd_);
+    close(wakePipe_[0]);
+    close(wakePipe_[1]);
+    listenFd_ = -1;
+    wakePipe_[0] = -1;
+    wakePipe_[1] = -1;
+}
+
+bool WebSubReceiver::subscribe(const std::string& channelId, NotificationCallback onNotify) {
+    if (channelId.empty()) {
+        return false;
+    }
+
+    std::string secret;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Subscription& subscription = subscriptions_[channelId];
+        subscription.onNotify = onNotify;
+        subscription.requestedAt = nowSeconds();
+        if (subscription.secret.empty()) {
+            subscription.secret = generateSecret();
+        }
+        secret = subscription.secret;
+    }
+
+    // Form-encoded subscription request; the hub verifies it asynchronously
+    // and signs every notification with the secret
+    std::string form = "hub.callback=" + urlEncode(callbackUrl_) +
+                       "&hub.topic=" + urlEncode(buildTopicUrl(channelId)) +
+                       "&hub.verify=async" +
+                       "&hub.mode=subscribe" +
+                       "&hub.lease_seconds=" + std::to_string(DEFAULT_LEASE_SECONDS) +
+                       "&hub.secret=" + urlEncode(secret);
+
+    std::map<std::string, std::string> headers;
+    headers["Content-Type"] = "application/x-www-form-urlencoded";
+
+    std::lock_guard<std::mutex> networkLock(networkMutex_);
+    std::string response;
+    std::cout << "📡 Subscribing to WebSub feed for " << channelId << std::endl;
+
+    if (!networkHandler_.post(hubUrl_, headers, form, response)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        lastError_ = "WebSub subscribe failed: " + networkHandler_.getLastError();
+        std::cerr << "❌ " << lastError_ << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool WebSubReceiver::isSubscribed(const std::string& channelId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return subscriptions_.find(channelId) != subscriptions_.end();
+}
+
+bool WebSubReceiver::isVerified(const std::string& channelId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::map<std::string, Subscription>::const_iterator it = subscriptions_.find(channelId);
+    return it != subscriptions_.end() && it->second.verified && it->second.leaseExpiry > nowSeconds();
+}
+
+bool WebSubReceiver::needsRenewal(const std::string& channelId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::map<std::string, Subscription>::const_iterator it = subscriptions_.find(channelId);
+    if (it == subscriptions_.end()) {
+        return true;
+    }
+
+    long long now = nowSeconds();
+    if (!it->second.verified) {
+        // Pending: retry if the hub never came back to verify
+        return now - it->second.requestedAt > 3600;
+    }
+
+    // Renew during the last tenth of the lease
+    return it->second.leaseExpiry - now < DEFAULT_LEASE_SECONDS / 10;
+}
+
+unsigned long WebSubReceiver::getNotificationCount() const {
+    return notificationCount_.load();
+}
+
+unsigned long WebSubReceiver::getRejectedCount() const {
+    return rejectedCount_.load();
+}
+
+std::string WebSubReceiver::getLastError() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lastError_;
+}
+
+void WebSubReceiver::serverLoop() {
+    std::vector<Client> clients;
+
+    while (running_) {
+        std::vector<struct pollfd> fds(2 + clients.size());
+        fds[0].fd = listenFd_;
+        fds[0].events = POLLIN;
+        fds[1].fd = wakePipe_[0];
+        fds[1].events = POLLIN;
+        for (size_t i = 0; i < clients.size(); i++) {
+            fds[2 + i].fd = clients[i].fd;
+            fds[2 + i].events = POLLIN;
+        }
+
+        if (poll(&fds[0], fds.size(), 1000) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        // Service existing clients first (indices shift once we erase)
+        for (size_t i = clients.size(); i-- > 0;) {
+            if (!(fds[2 + i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                continue;
+            }
+            if (handleClientData(clients[i])) {
+                close(clients[i].fd);
+                clients.erase(clients.begin() + i);
+            }
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int fd;
+            while ((fd = accept(listenFd_, nullptr, nullptr)) >= 0) {
+                setNonBlocking(fd);
+                Client client;
+                client.fd = fd;
+                clients.push_back(client);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < clients.size(); i++) {
+        close(clients[i].fd);
+    }
+}
+
+bool WebSubReceiver::handleClientData(Client& client) {
+    char buffer[4096];
+    ssize_t got;
+    while ((got = read(client.fd, buffer, sizeof(buffer))) > 0) {
+        client.request.append(buffer, (size_t)got);
+        if (client.request.size() > MAX_REQUEST_SIZE) {
+            std::string response = buildResponse(413, "Payload Too Large", "");
+            ssize_t ignored = write(client.fd, response.data(), response.size());
+            (void)ignored;
+            return true;
+        }
+    }
+    if (got == 0 || (got < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+        return true; // Peer closed or error
+    }
+
+    // Wait for the full header block
+    size_t headerEnd = client.request.find("\r\n\r\n");
+    if (headerEnd == std::string::npos) {
+        return false;
+    }
+
+    // Request line: METHOD TARGET VERSION
+    std::istringstream lines(client.request.substr(0, headerEnd));
+    std::string requestLine;
+    std::getline(lines, requestLine);
+    std::istringstream requestParts(requestLine);
+    std::string method, target;
+    requestParts >> method >> target;
+
+    size_t contentLength = 0;
+    std::string signature;
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.size() > 15 && strncasecmp(line.c_str(), "content-length:", 15) == 0) {
+            contentLength = (size_t)std::strtoul(line.c_str() + 15, nullptr, 10);
+        } else if (line.size() > 16 && strncasecmp(line.c_str(), "x-hub-signature:", 16) == 0) {
+            size_t start = line.find_first_not_of(" \t", 16);
+            size_t end = line.find_last_not_of(" \t\r");
+            if (start != std::string::npos && end >= start) {
+                signature = line.substr(start, end - start + 1);
+            }
+        }
+    }
+
+    size_t bodyStart = headerEnd + 4;
+    if (client.request.size() - bodyStart < contentLength) {
+        return false; // Body still arriving
+    }
+
+    std::string response = handleRequest(method, target, client.request.substr(bodyStart, contentLength), signature);
+    ssize_t ignored = write(client.fd, response.data(), response.size());
+    (void)ignored;
+    return true;
+}
+
+std::string WebSubReceiver::handleRequest(const std::string& method, const std::string& target,
+                                          const std::string& body, const std::string& signature) {
+    size_t queryStart = target.find('?');
+    std::string query = queryStart == std::string::npos ? "" : target.substr(queryStart + 1);
+
+    if (method == "GET") {
+        return handleVerification(parseQuery(query));
+    }
+    if (method == "POST") {
+        return handleNotification(body, signature);
+    }
+    return buildResponse(405, "Method Not Allowed", "");
+}
+
+std::string WebSubReceiver::handleVerification(const std::map<std::string, std::string>& params) {
+    std::map<std::string, std::string>::const_iterator mode = params.find("hub.mode");
+    std::map<std::string, std::string>::const_iterator topic = params.find("hub.topic");
+    std::map<std::string, std::string>::const_iterator challenge = params.find("hub.challenge");
+    if (mode == params.end() || topic == params.end()) {
+        return buildResponse(400, "Bad Request", "");
+    }
+
+    std::string channelId = channelFromTopic(topic->second);
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<std::string, Subscription>::iterator it = subscriptions_.find(channelId);
+
+    if (mode->second == "subscribe") {
+        // Only confirm topics we actually asked for
+        if (it == subscriptions_.end() || challenge == params.end()) {
+            return buildResponse(404, "Not Found", "");
+        }
+
+        long long lease = DEFAULT_LEASE_SECONDS;
+        std::map<std::string, std::string>::const_iterator leaseParam = params.find("hub.lease_seconds");
+        if (leaseParam != params.end() && std::atoll(leaseParam->second.c_str()) > 0) {
+            lease = std::atoll(leaseParam->second.c_str());
+        }
+
+        it->second.verified = true;
+        it->second.leaseExpiry = nowSeconds() + lease;
+        std::cout << "✅ WebSub subscription verified for " << channelId << std::endl;
+        return buildResponse(200, "OK", challenge->second);
+    }
+
+    if (mode->second == "unsubscribe") {
+        if (it != subscriptions_.end() || challenge == params.end()) {
+            return buildResponse(404, "Not Found", "");
+        }
+        return buildResponse(200, "OK", challenge->second);
+    }
+
+    if (mode->second == "denied" && it != subscriptions_.end()) {
+        it->second.verified = false;
+        lastError_ = "WebSub subscription denied for " + channelId;
+        std::cerr << "❌ " << lastError_ << std::endl;
+    }
+    return buildResponse(200, "OK", "");
+}
+
+std::string WebSubReceiver::handleNotification(const std::string& body, const std::string& signature) {
+    // Atom entry: <yt:channelId>UC...</yt:channelId>; deleted entries only
+    // carry the feed link, which includes channel_id=
+    std::string channelId;
+    size_t start = body.find("<yt:channelId>");
+    if (start != std::string::npos) {
+        start += 14;
+        size_t end = body.find("</yt:channelId>", start);
+        if (end != std::string::npos) {
+            channelId = body.substr(start, end - start);
+        }
+    } else {
+        channelId = channelFromTopic(body);
+    }
+
+    NotificationCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::map<std::string, Subscription>::iterator it = subscriptions_.find(channelId);
+        if (it == subscriptions_.end()) {
+            return buildResponse(200, "OK", ""); // Not ours; acknowledge anyway
+        }
+
+        // Only the hub knows the secret; anything else is acknowledged and
+        // ignored, so a forger can't tell whether it got through
+        if (signature.compare(0, 5, "sha1=") != 0 ||
+            !Sha1::equalsConstantTime(signature.substr(5), Sha1::hmacHex(it->second.secret, body))) {
+            rejectedCount_++;
+            return buildResponse(200, "OK", "");
+        }
+        callback = it->second.onNotify;
+    }
+
+    notificationCount_++;
+    std::cout << "🔔 WebSub notification for " << channelId << std::endl;
+    if (callback) {
+        callback(channelId);
+    }
+    return buildResponse(200, "OK", "");
+}
+
+std::string WebSubReceiver::generateSecret() {
+    static const char* hex = "0123456789abcdef";
+    std::random_device random;
+    std::string secret;
+    for (int i = 0; i < 8; i++) {
+        uint32_t bits = random();
+        for (int j = 0; j < 8; j++) {
+            secret += hex[(bits >> (j * 4)) & 0x0F];
+        }
+    }
+    return secret;
+}
+
+std::string WebSubReceiver::buildTopicUrl(const std::string& channelId) {
+    return "https://www.youtube.com/xml/feeds/videos.xml?channel_id=" + channelId;
+}
+
+std::string WebSubReceiver::channelFromTopic(const std::string& topic) {
+    size_t start = topic.find("channel_id=");
+    if (start == std::string::npos) {
+        return "";
+    }
+    start += 11;
+
+    size_t end = start;
+    while (end < topic.size() && (isalnum((unsigned char)topic[end]) || topic[end] == '_' || topic[end] == '-')) {
+        end++;
+    }
+    return topic.substr(start, end - start);
+}
+
+std::map<std::string, std::string> WebSubReceiver::parseQuery(const std::string& query) {
+    std::map<std::string, std::string> params;
+    size_t pos = 0;
+    while (pos <= query.size()) {
+        size_t end = query.find('&', pos);
+        if (end == std::string::npos) end = query.size();
+
+        std::string pair = query.substr(pos, end - pos);
+        size_t eq = pair.find('=');
+        if (eq != std::string::npos) {
+            params[urlDecode(pair.substr(0, eq))] = urlDecode(pair.substr(eq + 1));
+        }
+        pos = end + 1;
+    }
+    return params;
+}
+
+std::string WebSubReceiver::urlEncode(const std::string& value) {
+    static const char* hex = "0123456789ABCDEF";
+    std::string result;
+    for (size_t i = 0; i < value.size(); i++) {
+        unsigned char c = (unsigned char)value[i];
+        if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+            result += (char)c;
+        } else {
+            result += '%';
+            result += hex[c >> 4];
+            result += hex[c & 0x0F];
+        }
+    }
+    return result;
+}
+
+std::string WebSubReceiver::urlDecode(const std::string& value) {
+    std::string result;
+    for (size_t i = 0; i < value.size(); i++) {
+        if (value[i] == '+') {
+            result += ' ';
+        } else if (value[i] == '%' && i + 2 < value.size()) {
+            result += (char)std::strtol(value.substr(i + 1, 2).c_str(), nullptr, 16);
+            i += 2;
+        } else {
+            result += value[i];
+        }
+    }
+    return result;
+}
+
+std::string WebSubReceiver::buildResponse(int code, const std::string& status, const std::string& body) {
+    std::ostringstream response;
+    response << "HTTP/1.1 " << code << " " << status << "\r\n"
+             << "Content-Type: text/plain\r\n"
+             << "Content-Length: " << body.size() << "\r\n"
+             << "Connection: close\r\n\r\n"
+             << body;
+    return response.str();
+}
@@ -0,0 +1,108 @@
+#ifndef WEBSUB_RECEIVER_H
+#define WEBSUB_RECEIVER_H
+
+#include "shared/network/network_handler.h"
+#include <string>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <atomic>
+
+// Push notifications for YouTube uploads via WebSub (PubSubHubbub).
+//
+// Runs a tiny HTTP server that answers the hub's subscription verification
+// (GET with hub.challenge) and receives Atom notifications (POST). Each
+// notification for a subscribed channel invokes that channel's callback,
+// which is expected to trigger a targeted stats refresh.
+//
+// The port has to be reachable by the hub, so anyone can post to it. Every
+// subscription therefore gets a random hub.secret, and only notifications
+// whose X-Hub-Signature is the HMAC-SHA1 of the body under that secret are
+// acted on. Others are acknowledged, as WebSub asks, and ignored.
+class WebSubReceiver {
+public:
+    typedef std::function<void(const std::string& channelId)> NotificationCallback;
+
+    WebSubReceiver(const std::string& callbackUrl, int listenPort,
+                   const std::string& hubUrl = DEFAULT_HUB_URL);
+    ~WebSubReceiver();
+
+    // Lifecycle (the HTTP server runs on its own thread)
+    bool start();
+    void stop();
+
+    // Ask the hub to push updates for channelId. Blocks on the hub request,
+    // so call it from a background thread (e.g. a fetch job).
+    bool subscribe(const std::string& channelId, NotificationCallback onNotify);
+
+    // Subscription state
+    bool isSubscribed(const std::string& channelId) const;
+    bool isVerified(const std::string& channelId) const;
+    bool needsRenewal(const std::string& channelId) const;
+
+    // Diagnostics
+    unsigned long getNotificationCount() const;
+    unsigned long getRejectedCount() const;    // Unsigned or badly signed
+    std::string getLastError() const;
+
+    static const char* DEFAULT_HUB_URL;
+    static const int DEFAULT_LEASE_SECONDS = 432000; // 5 days
+
+private:
+    struct Subscription {
+        NotificationCallback onNotify;
+        std::string secret;    // Kept across renewals
+        bool verified;
+        long long requestedAt; // Unix seconds of the last hub request
+        long long leaseExpiry; // Unix seconds, 0 until verified
+
+        Subscription() : verified(false), requestedAt(0), leaseExpiry(0) {}
+    };
+
+    struct Client {
+        int fd;
+        std::string request;
+    };
+
+    std::string callbackUrl_;
+    std::string hubUrl_;
+    int listenPort_;
+    int listenFd_;
+    int wakePipe_[2];
+
+    std::map<std::string, Subscription> subscriptions_;
+    NetworkHandler networkHandler_;
+    std::string lastError_;
+    mutable std::mutex mutex_;
+    std::mutex networkMutex_;  // Serializes hub requests
+
+    std::thread serverThread_;
+    std::atomic<bool> running_;
+    std::atomic<unsigned long> notificationCount_;
+    std::atomic<unsigned long> rejectedCount_;
+
+    // HTTP server
+    void serverLoop();
+    bool handleClientData(Client& client);
+    std::string handleRequest(const std::string& method, const std::string& target,
+                              const std::string& body, const std::string& signature);
+    std::string handleVerification(const std::map<std::string, std::string>& params);
+    std::string handleNotification(const std::string& body, const std::string& signature);
+
+    // Helper methods
+    static std::string generateSecret();
+    static std::string buildTopicUrl(const std::string& channelId);
+    static std::string channelFromTopic(const std::string& topic);
+    static std::map<std::string, std::string> parseQuery(const std::string& query);
+    static std::string urlEncode(const std::string& value);
+    static std::string urlDecode(const std::string& value);
+    static std::string buildResponse(int code, const std::string& status, const std::string& body);
+
+    // Disable copy constructor and assignment operator
+    WebSubReceiver(const WebSubReceiver&) = delete;
+    WebSubReceiver& operator=(const WebSubReceiver&) = delete;
+};
+
+#endif // WEBSUB_RECEIVER_H
@@ -1,7 +1,8 @@
 #include "youtube_api.h"
+#include "shared/network/buffer_pool.h"
+#include "shared/utils/json_scanner.h"
 #include <iostream>
 #include <sstream>
-#include <regex>
 #include <cstdlib>
 
 YouTubeAPI::YouTubeAPI() {
@@ -47,9 +48,10 @@ YouTubeChannelStats YouTubeAPI::getChannelStats(const std::string& channelId) {
     }
     
     std::string url = buildChannelStatsUrl(channelId);
-    std::string response;
+    BufferPool::Buffer buffer = BufferPool::shared().acquire();
+    const std::string& response = buffer.str();
     
-    if (!networkHandler_.get(url, response)) {
+    if (!networkHandler_.get(url, buffer.str())) {
         stats.errorMessage = "Network error: " + networkHandler_.getLastError();
         lastError_ = stats.errorMessage;
         return stats;
@@ -96,9 +98,10 @@ YouTubeChannelStats YouTubeAPI::getChannelStatsByUsername(const std::string& use
     
     // First, search for the channel using the username
     std::string searchUrl = buildChannelSearchUrl(username);
-    std::string searchResponse;
+    BufferPool::Buffer searchBuffer = BufferPool::shared().acquire();
+    const std::string& searchResponse = searchBuffer.str();
     
-    if (!networkHandler_.get(searchUrl, searchResponse)) {
+    if (!networkHandler_.get(searchUrl, searchBuffer.str())) {
         stats.errorMessage = "Network error searching for channel: " + networkHandler_.getLastError();
         lastError_ = stats.errorMessage;
         return stats;
@@ -111,6 +114,7 @@ YouTubeChannelStats YouTubeAPI::getChannelStatsByUsername(const std::string& use
         lastError_ = stats.errorMessage;
         return stats;
     }
+    searchBuffer.release();
     
     // Now get the channel stats using the channel ID
     return getChannelStats(channelId);
@@ -145,16 +149,17 @@ YouTubeChannelStats YouTubeAPI::parseChannelStatsResponse(const std::string& jso
         return stats;
     }
     
-    // Extract statistics
-    std::string subscriberCountStr = extractJsonValue(jsonResponse, "subscriberCount");
-    std::string viewCountStr = extractJsonValue(jsonResponse, "viewCount");
-    std::string videoCountStr = extractJsonValue(jsonResponse, "videoCount");
+    // Extract statistics (views into the response buffer, no copies)
+    StringRef subscriberCountStr = extractJsonValue(jsonResponse, "subscriberCount");
+    StringRef viewCountStr = extractJsonValue(jsonResponse, "viewCount");
+    StringRef videoCountStr = extractJsonValue(jsonResponse, "videoCount");
     
     if (subscriberCountStr.empty() && viewCountStr.empty() && videoCountStr.empty()) {
         stats.errorMessage = "No statistics found in response";
         return stats;
     }
     
+    stats.channelId = JsonScanner::findString(jsonResponse, "id").str();
     stats.subscriberCount = parseLongValue(subscriberCountStr);
     stats.viewCount = parseLongValue(viewCountStr);
     stats.videoCount = parseLongValue(videoCountStr);
@@ -165,46 +170,14 @@ YouTubeChannelStats YouTubeAPI::parseChannelStatsResponse(const std::string& jso
 
 std::string YouTubeAPI::extractChannelIdFromSearch(const std::string& jsonResponse) {
     // Look for the first channel in the search results
-    std::string pattern = "\"channelId\"\\s*:\\s*\"([^\"]+)\"";
-    std::regex regex(pattern);
-    std::smatch match;
-    
-    if (std::regex_search(jsonResponse, match, regex)) {
-        return match[1].str();
-    }
-    
-    return "";
+    return JsonScanner::findString(jsonResponse, "channelId").str();
 }
 
-std::string YouTubeAPI::extractJsonValue(const std::string& json, const std::string& key) {
-    std::string pattern = "\"" + key + "\"\\s*:\\s*\"([^\"]+)\"";
-    std::regex regex(pattern);
-    std::smatch match;
-    
-    if (std::regex_search(json, match, regex)) {
-        return match[1].str();
-    }
-    
-    // Try without quotes (for numbers)
-    pattern = "\"" + key + "\"\\s*:\\s*([0-9]+)";
-    regex = std::regex(pattern);
-    
-    if (std::regex_search(json, match, regex)) {
-        return match[1].str();
-    }
-    
-    return "";
+StringRef YouTubeAPI::extractJsonValue(const std::string& json, const char* key) {
+    // Quoted value first, then unquoted (for numbers)
+    return JsonScanner::findValue(json, key);
 }
 
-long YouTubeAPI::parseLongValue(const std::string& value) {
-    if (value.empty()) {
-        return 0;
-    }
-    
-    try {
-        return std::stol(value);
-    } catch (const std::exception& e) {
-        std::cerr << "Error parsing value '" << value << "': " << e.what() << std::endl;
-        return 0;
-    }
+long YouTubeAPI::parseLongValue(const StringRef& value) {
+    return JsonScanner::parseLong(value);
 }
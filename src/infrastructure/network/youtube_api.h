@@ -2,9 +2,11 @@
 #define YOUTUBE_API_H
 
 #include "shared/network/network_handler.h"
+#include "shared/utils/string_ref.h"
 #include <string>
 
 struct YouTubeChannelStats {
+    std::string channelId;  // Resolved UC... ID (also for @username lookups)
     long subscriberCount;
     long viewCount;
     long videoCount;
@@ -40,8 +42,8 @@ private:
     std::string buildChannelSearchUrl(const std::string& username);
     YouTubeChannelStats parseChannelStatsResponse(const std::string& jsonResponse);
     std::string extractChannelIdFromSearch(const std::string& jsonResponse);
-    std::string extractJsonValue(const std::string& json, const std::string& key);
-    long parseLongValue(const std::string& value);
+    StringRef extractJsonValue(const std::string& json, const char* key);
+    long parseLongValue(const StringRef& value);
     
     // Disable copy constructor and assignment operator
     YouTubeAPI(const YouTubeAPI&) = delete;
@@ -0,0 +1,211 @@
+#include "animation_file.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+const char MAGIC[4] = { 'L', 'M', 'A', 'N' };
+
+void putU16(uint8_t* p, uint16_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+}
+
+void putU32(uint8_t* p, uint32_t value) {
+    putU16(p, (uint16_t)value);
+    putU16(p + 2, (uint16_t)(value >> 16));
+}
+
+void putU64(uint8_t* p, uint64_t value) {
+    putU32(p, (uint32_t)value);
+    putU32(p + 4, (uint32_t)(value >> 32));
+}
+
+uint16_t readU16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+uint32_t readU32(const uint8_t* p) {
+    return readU16(p) | ((uint32_t)readU16(p + 2) << 16);
+}
+
+uint64_t readU64(const uint8_t* p) {
+    return readU32(p) | ((uint64_t)readU32(p + 4) << 32);
+}
+
+} // namespace
+
+AnimationWriter::AnimationWriter(const std::string& path, int width, int height, bool loop)
+    : path_(path), tempPath_(path + ".tmp"), width_(width), height_(height), loop_(loop), file_(nullptr), merged_(0) {
+}
+
+AnimationWriter::~AnimationWriter() {
+    if (file_) {
+        fclose(file_);
+        unlink(tempPath_.c_str());
+    }
+}
+
+bool AnimationWriter::open() {
+    if (width_ <= 0 || height_ <= 0 || width_ > 0xFFFF || height_ > 0xFFFF) {
+        return fail("bad frame size");
+    }
+    file_ = fopen(tempPath_.c_str(), "wb");
+    if (!file_) {
+        return fail(tempPath_ + ": " + strerror(errno));
+    }
+    // The header is filled in by finish()
+    uint8_t header[AnimationFile::HEADER_SIZE] = { 0 };
+    if (fwrite(header, sizeof(header), 1, file_) != 1) {
+        return fail(std::string("write: ") + strerror(errno));
+    }
+    return true;
+}
+
+bool AnimationWriter::addFrame(const uint8_t* pixels, uint32_t delayMs) {
+    if (!file_) {
+        return false;
+    }
+    if (delayMs < AnimationFile::MIN_DELAY_MS) {
+        delayMs = AnimationFile::MIN_DELAY_MS;
+    }
+
+    size_t frameSize = (size_t)width_ * height_ * 3;
+    if (!delays_.empty() && std::memcmp(&previous_[0], pixels, frameSize) == 0) {
+        delays_.back() += delayMs;
+        merged_++;
+        return true;
+    }
+    if (fwrite(pixels, frameSize, 1, file_) != 1) {
+        return fail(std::string("write: ") + strerror(errno));
+    }
+    previous_.assign(pixels, pixels + frameSize);
+    delays_.push_back(delayMs);
+    return true;
+}
+
+bool AnimationWriter::finish() {
+    if (!file_) {
+        return false;
+    }
+    if (delays_.empty()) {
+        return fail("no frames");
+    }
+
+    std::vector<uint8_t> index(delays_.size() * 4);
+    for (size_t i = 0; i < delays_.size(); i++) {
+        putU32(&index[i * 4], delays_[i]);
+    }
+    if (fwrite(&index[0], index.size(), 1, file_) != 1) {
+        return fail(std::string("write: ") + strerror(errno));
+    }
+
+    uint8_t header[AnimationFile::HEADER_SIZE] = { 0 };
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    putU16(header + 4, (uint16_t)AnimationFile::VERSION);
+    putU16(header + 6, loop_ ? AnimationFile::FLAG_LOOP : 0);
+    putU16(header + 8, (uint16_t)width_);
+    putU16(header + 10, (uint16_t)height_);
+    putU32(header + 12, (uint32_t)delays_.size());
+    putU64(header + 16, AnimationFile::HEADER_SIZE + delays_.size() * (uint64_t)width_ * height_ * 3);
+    if (fseek(file_, 0, SEEK_SET) != 0 || fwrite(header, sizeof(header), 1, file_) != 1 || fflush(file_) != 0) {
+        return fail(std::string("write: ") + strerror(errno));
+    }
+
+    // Replace rather than overwrite: a player may have the old file mapped
+    fclose(file_);
+    file_ = nullptr;
+    if (rename(tempPath_.c_str(), path_.c_str()) != 0) {
+        lastError_ = path_ + ": " + strerror(errno);
+        unlink(tempPath_.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool AnimationWriter::fail(const std::string& reason) {
+    lastError_ = reason;
+    if (file_) {
+        fclose(file_);
+        file_ = nullptr;
+        unlink(tempPath_.c_str());
+    }
+    return false;
+}
+
+AnimationFile::AnimationFile()
+    : mapping_(MAP_FAILED), mappingSize_(0), frames_(nullptr), index_(nullptr), frameSize_(0),
+      width_(0), height_(0), frameCount_(0), loop_(false), durationMs_(0) {
+}
+
+AnimationFile::~AnimationFile() {
+    close();
+}
+
+bool AnimationFile::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return fail(path + ": " + strerror(errno));
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < HEADER_SIZE) {
+        ::close(fd);
+        return fail(path + ": not an animation file");
+    }
+    mappingSize_ = (size_t)st.st_size;
+    mapping_ = mmap(nullptr, mappingSize_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);   // The mapping keeps the file
+    if (mapping_ == MAP_FAILED) {
+        return fail(path + ": mmap: " + strerror(errno));
+    }
+
+    const uint8_t* header = static_cast<const uint8_t*>(mapping_);
+    if (std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0 || readU16(header + 4) != VERSION) {
+        return fail(path + ": not an animation file, or from another version");
+    }
+    width_ = readU16(header + 8);
+    height_ = readU16(header + 10);
+    frameCount_ = (int)readU32(header + 12);
+    loop_ = (readU16(header + 6) & FLAG_LOOP) != 0;
+    frameSize_ = (size_t)width_ * height_ * 3;
+    uint64_t indexOffset = readU64(header + 16);
+    if (width_ == 0 || height_ == 0 || frameCount_ <= 0 ||
+        indexOffset != HEADER_SIZE + (uint64_t)frameCount_ * frameSize_ ||
+        indexOffset + (uint64_t)frameCount_ * 4 > mappingSize_) {
+        return fail(path + ": truncated or corrupt");
+    }
+    frames_ = header + HEADER_SIZE;
+    index_ = header + indexOffset;
+
+    durationMs_ = 0;
+    for (int i = 0; i < frameCount_; i++) {
+        durationMs_ += getDelayMs(i);
+    }
+    return true;
+}
+
+void AnimationFile::close() {
+    if (mapping_ != MAP_FAILED) {
+        munmap(mapping_, mappingSize_);
+        mapping_ = MAP_FAILED;
+    }
+    frames_ = nullptr;
+    index_ = nullptr;
+    frameCount_ = 0;
+}
+
+uint32_t AnimationFile::getDelayMs(int index) const {
+    uint32_t delayMs = readU32(index_ + (size_t)index * 4);
+    return delayMs < MIN_DELAY_MS ? MIN_DELAY_MS : delayMs;
+}
+
+bool AnimationFile::fail(const std::string& reason) {
+    lastError_ = reason;
+    close();
+    return false;
+}
@@ -0,0 +1,110 @@
+#ifndef ANIMATION_FILE_H
+#define ANIMATION_FILE_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+// Pre-rendered animations (tools/animation_render) for the anim app.
+//
+// Frames are stored uncompressed so playback never decodes anything: a
+// reader maps the file and hands out pointers straight into it. Layout,
+// all integers little-endian:
+//
+//   0   "LMAN"         magic
+//   4   u16 version    1
+//   6   u16 flags      bit 0: loop
+//   8   u16 width, u16 height
+//   12  u32 frame count
+//   16  u64 index offset
+//   24  u64 reserved
+//   32  frames         width * height * 3 bytes each, packed RGB row by row
+//   ... index          u32 delay in milliseconds per frame
+//
+// The writer merges a frame identical to the one before into that frame's
+// delay, so idle screens with long holds cost one frame each.
+class AnimationWriter {
+public:
+    AnimationWriter(const std::string& path, int width, int height, bool loop);
+    ~AnimationWriter();
+
+    bool open();
+    // `pixels` is width * height * 3 bytes
+    bool addFrame(const uint8_t* pixels, uint32_t delayMs);
+    // Write the index and move the file into place
+    bool finish();
+
+    size_t getFrameCount() const { return delays_.size(); }
+    unsigned long getMergedCount() const { return merged_; }
+    std::string getLastError() const { return lastError_; }
+
+private:
+    std::string path_;
+    std::string tempPath_;
+    int width_;
+    int height_;
+    bool loop_;
+    FILE* file_;
+    std::vector<uint8_t> previous_;
+    std::vector<uint32_t> delays_;
+    unsigned long merged_;
+    std::string lastError_;
+
+    // Helper methods
+    bool fail(const std::string& reason);
+
+    // Disable copy constructor and assignment operator
+    AnimationWriter(const AnimationWriter&) = delete;
+    AnimationWriter& operator=(const AnimationWriter&) = delete;
+};
+
+class AnimationFile {
+public:
+    AnimationFile();
+    ~AnimationFile();
+
+    // Map the file read-only and check its header and index
+    bool open(const std::string& path);
+    void close();
+
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    int getFrameCount() const { return frameCount_; }
+    bool isLooping() const { return loop_; }
+    long long getDurationMs() const { return durationMs_; }
+
+    // Packed RGB of frame `index`, valid until close()
+    const uint8_t* getFrame(int index) const { return frames_ + (size_t)index * frameSize_; }
+    uint32_t getDelayMs(int index) const;
+
+    std::string getLastError() const { return lastError_; }
+
+    static const uint32_t VERSION = 1;
+    static const size_t HEADER_SIZE = 32;
+    static const uint16_t FLAG_LOOP = 1;
+    static const uint32_t MIN_DELAY_MS = 1;
+
+private:
+    void* mapping_;
+    size_t mappingSize_;
+    const uint8_t* frames_;
+    const uint8_t* index_;
+    size_t frameSize_;
+    int width_;
+    int height_;
+    int frameCount_;
+    bool loop_;
+    long long durationMs_;
+    std::string lastError_;
+
+    // Helper methods
+    bool fail(const std::string& reason);
+
+    // Disable copy constructor and assignment operator
+    AnimationFile(const AnimationFile&) = delete;
+    AnimationFile& operator=(const AnimationFile&) = delete;
+};
+
+#endif // ANIMATION_FILE_H
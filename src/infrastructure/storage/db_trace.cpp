@@ -0,0 +1,152 @@
+#include "db_trace.h"
+#include "infrastructure/config/config.h"
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+
+namespace {
+
+const size_t WRITE_BUFFER_SIZE = 65536;
+const char* FORMAT_LINE = "# dB trace v1: <ms> <dB> [channel]\n";
+
+} // namespace
+
+DbTraceWriter::DbTraceWriter() : file_(nullptr), startMs_(0) {
+}
+
+DbTraceWriter::~DbTraceWriter() {
+    close();
+}
+
+bool DbTraceWriter::open(const std::string& path, long long startMs) {
+    close();
+    file_ = fopen(path.c_str(), "w");
+    if (!file_) {
+        lastError_ = "Cannot create " + path + ": " + std::strerror(errno);
+        return false;
+    }
+    // Readings can arrive thousands of times a second; write in large blocks
+    setvbuf(file_, nullptr, _IOFBF, WRITE_BUFFER_SIZE);
+    fputs(FORMAT_LINE, file_);
+    startMs_ = startMs;
+    return true;
+}
+
+void DbTraceWriter::append(long long nowMs, const DbSample& sample) {
+    if (!file_) {
+        return;
+    }
+    unsigned whole = sample.centiDb / 100;
+    unsigned hundredths = sample.centiDb % 100;
+    if (sample.channel == 0) {
+        fprintf(file_, "%lld %u.%02u\n", nowMs - startMs_, whole, hundredths);
+    } else {
+        fprintf(file_, "%lld %u.%02u %u\n", nowMs - startMs_, whole, hundredths, (unsigned)sample.channel);
+    }
+}
+
+void DbTraceWriter::close() {
+    if (file_) {
+        fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+DbTraceReader::DbTraceReader()
+    : file_(nullptr), line_(0), lastTimeMs_(0), finished_(true), hasPending_(false) {
+}
+
+DbTraceReader::~DbTraceReader() {
+    close();
+}
+
+bool DbTraceReader::open(const std::string& path) {
+    close();
+    file_ = fopen(path.c_str(), "r");
+    if (!file_) {
+        lastError_ = "Cannot open " + path + ": " + std::strerror(errno);
+        return false;
+    }
+    line_ = 0;
+    lastTimeMs_ = 0;
+    finished_ = false;
+    hasPending_ = false;
+    lastError_.clear();
+    return true;
+}
+
+void DbTraceReader::close() {
+    if (file_) {
+        fclose(file_);
+        file_ = nullptr;
+    }
+    finished_ = true;
+    hasPending_ = false;
+}
+
+bool DbTraceReader::next(DbTraceRecord& out) {
+    char buffer[256];
+    while (!finished_ && fgets(buffer, sizeof(buffer), file_)) {
+        line_++;
+        buffer[std::strcspn(buffer, "\r\n")] = '\0';
+        char* cursor = buffer;
+        while (*cursor == ' ' || *cursor == '\t') {
+            cursor++;
+        }
+        if (*cursor == '#' || *cursor == '\0') {
+            continue;
+        }
+
+        char* end;
+        long long timeMs = std::strtoll(cursor, &end, 10);
+        bool valid = end != cursor;
+        cursor = end;
+        double db = std::strtod(cursor, &end);
+        valid = valid && end != cursor;
+        cursor = end;
+        long channel = std::strtol(cursor, &end, 10);
+        if (end == cursor) {
+            channel = 0;
+        }
+        cursor = end;
+        while (*cursor == ' ' || *cursor == '\t') {
+            cursor++;
+        }
+
+        if (!valid || *cursor != '\0' || channel < 0 || channel > 255 || timeMs < lastTimeMs_ ||
+            db < Config::MIN_DB_VALUE || db > Config::MAX_DB_VALUE) {
+            lastError_ = "Malformed trace line " + std::to_string(line_) + ": " + buffer;
+            finished_ = true;
+            return false;
+        }
+
+        lastTimeMs_ = timeMs;
+        out.timeMs = timeMs;
+        out.sample = DbSample((uint16_t)(db * 100.0 + 0.5), (uint8_t)channel);
+        return true;
+    }
+
+    if (!finished_ && ferror(file_)) {
+        lastError_ = std::string("Trace read failed: ") + std::strerror(errno);
+    }
+    finished_ = true;
+    return false;
+}
+
+size_t DbTraceReader::feedUntil(long long nowMs, DbSampleRing& ring) {
+    size_t pushed = 0;
+    while (true) {
+        if (!hasPending_) {
+            if (!next(pending_)) {
+                break;
+            }
+            hasPending_ = true;
+        }
+        if (pending_.timeMs > nowMs || !ring.push(pending_.sample)) {
+            break;
+        }
+        hasPending_ = false;
+        pushed++;
+    }
+    return pushed;
+}
@@ -0,0 +1,86 @@
+#ifndef DB_TRACE_H
+#define DB_TRACE_H
+
+#include "shared/utils/db_sample.h"
+#include <string>
+#include <cstdio>
+
+// dB traces: the readings a meter received, with the time each arrived,
+// for replaying field recordings in virtual time (tools/db_trace_replay).
+// Plain text, one reading per line, so traces can also be written by hand
+// or converted from other logs:
+//
+//   # dB trace v1: <ms> <dB> [channel]
+//   0 61.25
+//   10 61.40 1
+//
+// Times are milliseconds from the start of the trace and must not go
+// backwards. The channel defaults to 0. Blank lines and lines starting
+// with '#' are skipped.
+struct DbTraceRecord {
+    long long timeMs;
+    DbSample sample;
+
+    DbTraceRecord() : timeMs(0) {}
+};
+
+class DbTraceWriter {
+public:
+    DbTraceWriter();
+    ~DbTraceWriter();
+
+    // Truncates the file and writes the format line; times are taken
+    // relative to startMs
+    bool open(const std::string& path, long long startMs);
+    void append(long long nowMs, const DbSample& sample);
+    void close();
+
+    bool isOpen() const { return file_ != nullptr; }
+    std::string getLastError() const { return lastError_; }
+
+private:
+    FILE* file_;
+    long long startMs_;
+    std::string lastError_;
+
+    // Disable copy constructor and assignment operator
+    DbTraceWriter(const DbTraceWriter&) = delete;
+    DbTraceWriter& operator=(const DbTraceWriter&) = delete;
+};
+
+class DbTraceReader {
+public:
+    DbTraceReader();
+    ~DbTraceReader();
+
+    bool open(const std::string& path);
+    void close();
+
+    // Next reading; false at the end of the trace or on a malformed line
+    // (getLastError() tells which)
+    bool next(DbTraceRecord& out);
+
+    // Replay source: pushes every reading due at or before nowMs into the
+    // ring. Returns the number pushed. A reading that doesn't fit waits for
+    // the next call.
+    size_t feedUntil(long long nowMs, DbSampleRing& ring);
+    bool isFinished() const { return finished_ && !hasPending_; }
+
+    size_t getLineNumber() const { return line_; }
+    std::string getLastError() const { return lastError_; }
+
+private:
+    FILE* file_;
+    size_t line_;
+    long long lastTimeMs_;
+    bool finished_;
+    bool hasPending_;
+    DbTraceRecord pending_;
+    std::string lastError_;
+
+    // Disable copy constructor and assignment operator
+    DbTraceReader(const DbTraceReader&) = delete;
+    DbTraceReader& operator=(const DbTraceReader&) = delete;
+};
+
+#endif // DB_TRACE_H
@@ -0,0 +1,274 @@
+#include "exposure_log.h"
+#include "shared/utils/file_utils.h"
+#include <iostream>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+const uint32_t LOG_MAGIC = 0x31505845; // "EXP1"
+const uint16_t LOG_VERSION = 1;
+const size_t HEADER_PAGE = 4096;
+const size_t SEGMENT_BYTES = ExposureLog::SEGMENT_RECORDS * sizeof(ExposureRecord);
+const long long MAX_DAY_SECONDS = 25 * 3600;  // Days with a DST change are 23 or 25 hours
+
+static_assert(sizeof(ExposureRecord) == 16, "exposure records are 16 bytes on disk");
+static_assert(sizeof(ExposureLogHeader) == 64, "exposure log header is 64 bytes on disk");
+static_assert(SEGMENT_BYTES % 4096 == 0, "segments must stay page aligned");
+
+// FNV-1a over the fields that are written once, at creation
+uint32_t headerChecksum(const ExposureLogHeader& header) {
+    uint32_t hash = 2166136261u;
+    const uint8_t* bytes = (const uint8_t*)&header;
+    for (size_t i = 0; i < offsetof(ExposureLogHeader, committed); i++) {
+        if (i >= offsetof(ExposureLogHeader, checksum) && i < offsetof(ExposureLogHeader, dayStart)) {
+            continue;
+        }
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+bool isValidHeader(const ExposureLogHeader& header) {
+    return header.magic == LOG_MAGIC && header.version == LOG_VERSION &&
+           header.recordSize == sizeof(ExposureRecord) && header.dataOffset == HEADER_PAGE &&
+           header.checksum == headerChecksum(header);
+}
+
+// Records past a torn write or an unwritten page read as zeros
+bool isValidRecord(const ExposureRecord& record, long long dayStart) {
+    return record.timestamp >= dayStart && record.timestamp < dayStart + MAX_DAY_SECONDS;
+}
+
+} // namespace
+
+ExposureLog::ExposureLog(const std::string& directory)
+    : directory_(directory), fd_(-1), header_(nullptr), segment_(nullptr), segmentIndex_(0), dayEnd_(0) {
+}
+
+ExposureLog::~ExposureLog() {
+    close();
+}
+
+bool ExposureLog::append(const ExposureRecord& record) {
+    if (!header_ || record.timestamp >= dayEnd_ || record.timestamp < header_->dayStart) {
+        if (!openDay(record.timestamp)) {
+            return false;
+        }
+    }
+
+    uint32_t committed = header_->committed;
+    uint32_t index = committed / SEGMENT_RECORDS;
+    if (!segment_ || index != segmentIndex_) {
+        if (!mapSegment(index)) {
+            return false;
+        }
+    }
+
+    // Write the record, then commit it by updating the header
+    segment_[committed % SEGMENT_RECORDS] = record;
+    __atomic_store_n(&header_->committed, committed + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+void ExposureLog::flush() {
+    if (segment_) {
+        msync(segment_, SEGMENT_BYTES, MS_ASYNC);
+    }
+    if (header_) {
+        msync(header_, HEADER_PAGE, MS_ASYNC);
+    }
+}
+
+void ExposureLog::close() {
+    flush();
+    unmapSegment();
+    if (header_) {
+        munmap(header_, HEADER_PAGE);
+        header_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+uint32_t ExposureLog::getRecordCount() const {
+    return header_ ? __atomic_load_n(&header_->committed, __ATOMIC_ACQUIRE) : 0;
+}
+
+bool ExposureLog::openDay(long long unixTime) {
+    close();
+
+    long long dayStart = localDayStart(unixTime);
+    dayEnd_ = localDayStart(dayStart + MAX_DAY_SECONDS + 3600);
+
+    time_t day = (time_t)dayStart;
+    struct tm local;
+    localtime_r(&day, &local);
+    char name[32];
+    strftime(name, sizeof(name), "exposure-%Y%m%d.log", &local);
+    path_ = directory_ + "/" + name;
+
+    if (!FileUtils::makeDirectories(directory_)) {
+        lastError_ = "Cannot create directory " + directory_ + ": " + std::strerror(errno);
+        return false;
+    }
+
+    fd_ = open(path_.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd_ < 0) {
+        lastError_ = "Cannot open " + path_ + ": " + std::strerror(errno);
+        return false;
+    }
+
+    struct stat st;
+    bool fresh = fstat(fd_, &st) != 0 || (size_t)st.st_size < HEADER_PAGE;
+    if (!fresh) {
+        ExposureLogHeader existing;
+        if (pread(fd_, &existing, sizeof(existing), 0) != (ssize_t)sizeof(existing) ||
+            !isValidHeader(existing) || existing.dayStart != dayStart) {
+            // Keep the damaged file for inspection and start over
+            std::cerr << "⚠️  Setting aside invalid exposure log " << path_ << std::endl;
+            ::close(fd_);
+            rename(path_.c_str(), (path_ + ".bad").c_str());
+            fd_ = open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (fd_ < 0) {
+                lastError_ = "Cannot create " + path_ + ": " + std::strerror(errno);
+                return false;
+            }
+            fresh = true;
+        }
+    }
+
+    if (fresh && ftruncate(fd_, HEADER_PAGE) != 0) {
+        lastError_ = "Cannot size " + path_ + ": " + std::strerror(errno);
+        close();
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, HEADER_PAGE, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapped == MAP_FAILED) {
+        lastError_ = "Cannot map " + path_ + ": " + std::strerror(errno);
+        close();
+        return false;
+    }
+    header_ = (ExposureLogHeader*)mapped;
+
+    if (fresh) {
+        std::memset(header_, 0, sizeof(ExposureLogHeader));
+        header_->magic = LOG_MAGIC;
+        header_->version = LOG_VERSION;
+        header_->recordSize = sizeof(ExposureRecord);
+        header_->dataOffset = HEADER_PAGE;
+        header_->dayStart = dayStart;
+        header_->createdAt = (int64_t)time(nullptr);
+        header_->checksum = headerChecksum(*header_);
+        msync(header_, HEADER_PAGE, MS_SYNC);
+    } else {
+        // Drop committed records that never reached the disk (power loss)
+        size_t capacity = (fstat(fd_, &st) == 0 && (size_t)st.st_size > HEADER_PAGE)
+                              ? ((size_t)st.st_size - HEADER_PAGE) / sizeof(ExposureRecord) : 0;
+        uint32_t committed = header_->committed;
+        if (committed > capacity) {
+            committed = (uint32_t)capacity;
+        }
+        while (committed > 0) {
+            ExposureRecord last;
+            off_t offset = HEADER_PAGE + (off_t)(committed - 1) * sizeof(ExposureRecord);
+            if (pread(fd_, &last, sizeof(last), offset) == (ssize_t)sizeof(last) && isValidRecord(last, dayStart)) {
+                break;
+            }
+            committed--;
+        }
+        header_->committed = committed;
+    }
+
+    segment_ = nullptr;
+    segmentIndex_ = 0;
+    std::cout << "📝 Exposure log " << path_ << " (" << header_->committed << " records)" << std::endl;
+    return true;
+}
+
+bool ExposureLog::mapSegment(uint32_t index) {
+    unmapSegment();
+
+    off_t offset = HEADER_PAGE + (off_t)index * SEGMENT_BYTES;
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+        lastError_ = "Cannot stat " + path_ + ": " + std::strerror(errno);
+        return false;
+    }
+    if (st.st_size < offset + (off_t)SEGMENT_BYTES && ftruncate(fd_, offset + SEGMENT_BYTES) != 0) {
+        lastError_ = "Cannot grow " + path_ + ": " + std::strerror(errno);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, SEGMENT_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, offset);
+    if (mapped == MAP_FAILED) {
+        lastError_ = "Cannot map segment of " + path_ + ": " + std::strerror(errno);
+        return false;
+    }
+
+    segment_ = (ExposureRecord*)mapped;
+    segmentIndex_ = index;
+    return true;
+}
+
+void ExposureLog::unmapSegment() {
+    if (segment_) {
+        munmap(segment_, SEGMENT_BYTES);
+        segment_ = nullptr;
+    }
+}
+
+bool ExposureLog::readFile(const std::string& path, ExposureLogHeader& header,
+                           std::vector<ExposureRecord>& records, std::string& error) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = std::string("Cannot open: ") + std::strerror(errno);
+        return false;
+    }
+
+    if (pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) || !isValidHeader(header)) {
+        error = "Not an exposure log (or damaged header)";
+        ::close(fd);
+        return false;
+    }
+
+    uint32_t committed = __atomic_load_n(&header.committed, __ATOMIC_ACQUIRE);
+    records.resize(committed);
+    ssize_t bytes = committed > 0 ? pread(fd, &records[0], committed * sizeof(ExposureRecord), header.dataOffset) : 0;
+    ::close(fd);
+    if (bytes < 0) {
+        error = std::string("Cannot read: ") + std::strerror(errno);
+        return false;
+    }
+
+    // Stop at the end of the file or the first record that never made it to disk
+    size_t valid = (size_t)bytes / sizeof(ExposureRecord);
+    for (size_t i = 0; i < valid; i++) {
+        if (!isValidRecord(records[i], header.dayStart)) {
+            valid = i;
+            break;
+        }
+    }
+    records.resize(valid);
+    return true;
+}
+
+long long ExposureLog::localDayStart(long long unixTime) {
+    time_t t = (time_t)unixTime;
+    struct tm local;
+    localtime_r(&t, &local);
+    local.tm_hour = 0;
+    local.tm_min = 0;
+    local.tm_sec = 0;
+    local.tm_isdst = -1;  // Let mktime work out DST for midnight
+    return (long long)mktime(&local);
+}
@@ -0,0 +1,94 @@
+#ifndef EXPOSURE_LOG_H
+#define EXPOSURE_LOG_H
+
+#include <string>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+// One second of one meter channel (16 bytes, host byte order)
+struct ExposureRecord {
+    uint32_t timestamp;  // Unix seconds
+    uint16_t leq;        // centi-dB: energy average over the second
+    uint16_t max;        // centi-dB
+    uint16_t min;        // centi-dB
+    uint16_t readings;   // Readings aggregated (saturates)
+    uint8_t channel;
+    uint8_t flags;       // Reserved, 0
+    uint16_t reserved;
+};
+
+// File header in the first page (64 bytes used)
+struct ExposureLogHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+    uint32_t dataOffset;      // Records start here (page aligned)
+    uint32_t checksum;        // Over the other fields that never change
+    int64_t dayStart;         // Local midnight, Unix seconds
+    int64_t createdAt;
+    uint32_t committed;       // Records fully written; updated after each record
+    uint32_t reserved[7];
+};
+
+// Append-only compliance log of per-second exposure records, one file per
+// local day (exposure-YYYYMMDD.log in the given directory):
+//
+//   header page | record | record | ...
+//
+// Records are written through a memory-mapped 64 KB segment, so an append
+// is a memcpy. The file grows one segment at a time and only the current
+// segment is mapped. An append writes the record first and then bumps
+// `committed` in the header, so a crash leaves at worst one torn record past
+// the committed count. Readers also stop at the first record outside the
+// file's day, which covers pages the kernel wrote back out of order before
+// a power loss. The static header fields carry a checksum, so a file whose
+// creation was cut short is set aside instead of appended to.
+class ExposureLog {
+public:
+    explicit ExposureLog(const std::string& directory);
+    ~ExposureLog();
+
+    // Appends go to the file of the record's local day; crossing midnight
+    // rotates to a new file
+    bool append(const ExposureRecord& record);
+
+    // Ask the kernel to write mapped pages back (non-blocking)
+    void flush();
+    void close();
+
+    bool isOpen() const { return header_ != nullptr; }
+    const std::string& getPath() const { return path_; }
+    uint32_t getRecordCount() const;
+    std::string getLastError() const { return lastError_; }
+
+    // Validated records of one log file, for export
+    static bool readFile(const std::string& path, ExposureLogHeader& header,
+                         std::vector<ExposureRecord>& records, std::string& error);
+
+    // Local midnight at or before unixTime
+    static long long localDayStart(long long unixTime);
+
+    static const size_t SEGMENT_RECORDS = 4096;
+
+private:
+    std::string directory_;
+    std::string path_;
+    std::string lastError_;
+    int fd_;
+    ExposureLogHeader* header_;  // Mapped header page
+    ExposureRecord* segment_;    // Mapped segment (nullptr until the first append)
+    uint32_t segmentIndex_;
+    long long dayEnd_;
+
+    // Helper methods
+    bool openDay(long long unixTime);
+    bool mapSegment(uint32_t index);
+    void unmapSegment();
+
+    // Disable copy constructor and assignment operator
+    ExposureLog(const ExposureLog&) = delete;
+    ExposureLog& operator=(const ExposureLog&) = delete;
+};
+
+#endif // EXPOSURE_LOG_H
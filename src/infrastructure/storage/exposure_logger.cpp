@@ -0,0 +1,229 @@
+#include "exposure_logger.h"
+#include "shared/dsp/level_ballistics.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+const int DRAIN_INTERVAL_MS = 100;
+const int GRACE_SECONDS = 2;        // A quiet channel's last second is written after this
+const int SYNC_INTERVAL_MS = 5000;  // Background write-back of mapped pages
+
+long long nowUnixMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+uint16_t energyToCentiDb(double energy) {
+    double centiDb = energy > 1.0 ? 1000.0 * std::log10(energy) : 0.0;
+    return centiDb < 12000.0 ? (uint16_t)(centiDb + 0.5) : 12000;
+}
+
+} // namespace
+
+ExposureLogger::ExposureLogger(const std::string& directory)
+    : directory_(directory), log_(directory), ring_(RING_CAPACITY), running_(false),
+      doseDayStart_(0), appendFailed_(false), recordCount_(0) {
+    for (int c = 0; c < MAX_CHANNELS; c++) {
+        seconds_[c].second = -1;
+        niosh_[c] = NoiseDosimeter(NoiseDosimeter::STANDARD_NIOSH);
+        snapshot_[c] = ChannelDose();
+        snapshot_[c].active = false;
+    }
+}
+
+ExposureLogger::~ExposureLogger() {
+    stop();
+}
+
+bool ExposureLogger::start() {
+    if (running_) {
+        return true;
+    }
+
+    running_ = true;
+    writerThread_ = std::thread(&ExposureLogger::writerLoop, this);
+
+    std::cout << "📝 Exposure logging to " << directory_ << std::endl;
+    return true;
+}
+
+void ExposureLogger::stop() {
+    if (!running_) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        running_ = false;
+    }
+    wakeCondition_.notify_all();
+
+    if (writerThread_.joinable()) {
+        writerThread_.join();
+    }
+}
+
+bool ExposureLogger::push(int channel, double levelDb) {
+    if (channel < 0 || channel >= MAX_CHANNELS) {
+        return false;
+    }
+
+    ExposureReading reading;
+    reading.unixMs = nowUnixMs();
+    double centiDb = levelDb * 100.0 + 0.5;
+    reading.centiDb = centiDb <= 0.0 ? 0 : centiDb >= 12000.0 ? 12000 : (uint16_t)centiDb;
+    reading.channel = (uint8_t)channel;
+    return ring_.push(reading);
+}
+
+std::string ExposureLogger::getLastError() const {
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    return lastError_;
+}
+
+void ExposureLogger::writerLoop() {
+    long long lastSyncMs = nowUnixMs();
+
+    while (running_) {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wakeCondition_.wait_for(lock, std::chrono::milliseconds(DRAIN_INTERVAL_MS));
+        }
+
+        drainRing();
+
+        long long now = nowUnixMs();
+        writeStaleSeconds(now / 1000 - GRACE_SECONDS);
+        if (now - lastSyncMs >= SYNC_INTERVAL_MS) {
+            log_.flush();
+            lastSyncMs = now;
+        }
+    }
+
+    // Write out everything still pending
+    drainRing();
+    writeStaleSeconds(nowUnixMs() / 1000 + 1);
+    log_.close();
+}
+
+void ExposureLogger::drainRing() {
+    ExposureReading reading;
+    while (ring_.pop(reading)) {
+        addReading(reading);
+    }
+}
+
+void ExposureLogger::addReading(const ExposureReading& reading) {
+    Second& current = seconds_[reading.channel];
+    long long second = reading.unixMs / 1000;
+    if (current.second != second) {
+        writeSecond(reading.channel);
+        current.second = second;
+        current.energy = 0.0;
+        current.max = 0;
+        current.min = 0xFFFF;
+        current.readings = 0;
+    }
+
+    current.energy += LevelBallistics::energyFromCentiDb(reading.centiDb);
+    if (reading.centiDb > current.max) {
+        current.max = reading.centiDb;
+    }
+    if (reading.centiDb < current.min) {
+        current.min = reading.centiDb;
+    }
+    current.readings++;
+}
+
+void ExposureLogger::writeStaleSeconds(long long beforeSecond) {
+    for (int c = 0; c < MAX_CHANNELS; c++) {
+        if (seconds_[c].second >= 0 && seconds_[c].second < beforeSecond) {
+            writeSecond(c);
+        }
+    }
+}
+
+void ExposureLogger::writeSecond(int channel) {
+    Second& current = seconds_[channel];
+    if (current.second < 0 || current.readings == 0) {
+        return;
+    }
+
+    ExposureRecord record;
+    record.timestamp = (uint32_t)current.second;
+    record.leq = energyToCentiDb(current.energy / current.readings);
+    record.max = current.max;
+    record.min = current.min;
+    record.readings = current.readings < 0xFFFF ? (uint16_t)current.readings : 0xFFFF;
+    record.channel = (uint8_t)channel;
+    record.flags = 0;
+    record.reserved = 0;
+    current.second = -1;
+
+    bool appended = log_.append(record);
+    if (!appended && !appendFailed_) {
+        std::cerr << "\033[0;31m❌ Exposure log: " << log_.getLastError() << "\033[0m" << std::endl;
+    }
+    appendFailed_ = !appended;
+
+    // Doses are per local day
+    long long dayStart = ExposureLog::localDayStart(record.timestamp);
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    if (dayStart != doseDayStart_) {
+        for (int c = 0; c < MAX_CHANNELS; c++) {
+            osha_[c].reset();
+            niosh_[c].reset();
+            snapshot_[c].active = false;
+        }
+        doseDayStart_ = dayStart;
+    }
+    osha_[channel].addLevel(record.leq / 100.0, 1.0);
+    niosh_[channel].addLevel(record.leq / 100.0, 1.0);
+
+    ChannelDose& dose = snapshot_[channel];
+    dose.active = true;
+    dose.lastLeq = record.leq;
+    dose.oshaPercent = osha_[channel].getDosePercent();
+    dose.oshaTwa = osha_[channel].getTwa();
+    dose.nioshPercent = niosh_[channel].getDosePercent();
+    dose.nioshTwa = niosh_[channel].getTwa();
+    dose.seconds = osha_[channel].getSeconds();
+    if (appended) {
+        recordCount_++;
+        logPath_ = log_.getPath();
+    } else {
+        lastError_ = log_.getLastError();
+    }
+}
+
+void ExposureLogger::printReport(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+
+    out << "\033[1;36m📝 Noise exposure (" << directory_ << ")\033[0m" << std::endl;
+    out << "  log:      " << (logPath_.empty() ? "(nothing written yet)" : logPath_) << ", "
+        << recordCount_ << " records since start" << std::endl;
+    out << "  ring:     " << ring_.getDroppedCount() << " readings dropped when full" << std::endl;
+    if (!lastError_.empty()) {
+        out << "  \033[0;31merror:    " << lastError_ << "\033[0m" << std::endl;
+    }
+
+    std::ios::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(1);
+    for (int c = 0; c < MAX_CHANNELS; c++) {
+        const ChannelDose& dose = snapshot_[c];
+        if (!dose.active) {
+            continue;
+        }
+        int minutes = (int)(dose.seconds / 60.0);
+        out << "  ch" << std::left << std::setw(7) << c << std::right << dose.lastLeq / 100.0
+            << " dB last second, " << minutes / 60 << "h"
+            << std::setw(2) << std::setfill('0') << minutes % 60 << std::setfill(' ') << "m logged: "
+            << NoiseDosimeter::name(NoiseDosimeter::STANDARD_OSHA) << " " << dose.oshaPercent << "% (TWA "
+            << dose.oshaTwa << "), " << NoiseDosimeter::name(NoiseDosimeter::STANDARD_NIOSH) << " "
+            << dose.nioshPercent << "% (TWA " << dose.nioshTwa << ")" << std::endl;
+    }
+    out.flags(flags);
+}
@@ -0,0 +1,109 @@
+#ifndef EXPOSURE_LOGGER_H
+#define EXPOSURE_LOGGER_H
+
+#include "infrastructure/storage/exposure_log.h"
+#include "shared/dsp/noise_dosimeter.h"
+#include "shared/utils/spsc_ring.h"
+#include <ostream>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <stdint.h>
+
+// One displayed level, timestamped by the render thread
+struct ExposureReading {
+    int64_t unixMs;
+    uint16_t centiDb;
+    uint8_t channel;
+};
+
+// Per-second exposure logging behind the dB meter.
+//
+// The render thread pushes levels into a lock-free ring and never waits:
+// when the writer falls behind, readings are dropped and counted. A writer
+// thread drains the ring every 100 ms, folds each channel's readings into
+// one record per wall-clock second (energy-average Leq, max, min), appends
+// it to the ExposureLog and adds it to that channel's OSHA and NIOSH dose.
+// A second is written once a later one starts, or after a short grace
+// period when readings stop.
+//
+// Memory stays fixed after start(): the ring, one mapped log segment and
+// per-channel state, about 200 KB in total.
+class ExposureLogger {
+public:
+    static const int MAX_CHANNELS = 16;
+    static const size_t RING_CAPACITY = 8192;
+
+    explicit ExposureLogger(const std::string& directory);
+    ~ExposureLogger();
+
+    // Lifecycle
+    bool start();
+    void stop();
+
+    // Render thread only; never blocks
+    bool push(int channel, double levelDb);
+
+    // Today's dose per channel since start (the export tool recomputes the
+    // whole day from the log)
+    void printReport(std::ostream& out) const;
+    std::string getLastError() const;
+
+private:
+    // A channel's readings within the current second
+    struct Second {
+        long long second;  // Unix seconds, -1 when empty
+        double energy;
+        uint16_t max;
+        uint16_t min;
+        uint32_t readings;
+    };
+
+    // Copied out for printReport under snapshotMutex_
+    struct ChannelDose {
+        bool active;
+        uint16_t lastLeq;
+        double oshaPercent;
+        double oshaTwa;
+        double nioshPercent;
+        double nioshTwa;
+        double seconds;
+    };
+
+    std::string directory_;
+    ExposureLog log_;
+    SpscRing<ExposureReading> ring_;
+
+    std::thread writerThread_;
+    std::atomic<bool> running_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
+
+    // Writer thread state
+    Second seconds_[MAX_CHANNELS];
+    NoiseDosimeter osha_[MAX_CHANNELS];
+    NoiseDosimeter niosh_[MAX_CHANNELS];
+    long long doseDayStart_;
+    bool appendFailed_;
+
+    mutable std::mutex snapshotMutex_;
+    ChannelDose snapshot_[MAX_CHANNELS];
+    unsigned long recordCount_;
+    std::string logPath_;
+    std::string lastError_;
+
+    // Helper methods
+    void writerLoop();
+    void drainRing();
+    void addReading(const ExposureReading& reading);
+    void writeSecond(int channel);
+    void writeStaleSeconds(long long beforeSecond);
+
+    // Disable copy constructor and assignment operator
+    ExposureLogger(const ExposureLogger&) = delete;
+    ExposureLogger& operator=(const ExposureLogger&) = delete;
+};
+
+#endif // EXPOSURE_LOGGER_H
@@ -0,0 +1,327 @@
+#include "file_data_source.h"
+#include "shared/utils/monotonic_clock.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+
+namespace {
+
+const uint32_t WATCH_EVENTS = IN_CLOSE_WRITE | IN_MOVED_TO;
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+size_t skipSpace(const char* data, size_t size, size_t pos) {
+    while (pos < size && isSpace(data[pos])) {
+        pos++;
+    }
+    return pos;
+}
+
+// Position of the quote closing the string that starts after `pos`, or `size`
+size_t findStringEnd(const char* data, size_t size, size_t pos) {
+    while (pos < size && data[pos] != '"') {
+        pos += data[pos] == '\\' ? 2 : 1;
+    }
+    return pos < size ? pos : size;
+}
+
+// Position just past the object or array starting at `pos`, or `size`
+size_t skipNested(const char* data, size_t size, size_t pos) {
+    int depth = 0;
+    while (pos < size) {
+        char c = data[pos++];
+        if (c == '"') {
+            pos = findStringEnd(data, size, pos) + 1;
+        } else if (c == '{' || c == '[') {
+            depth++;
+        } else if ((c == '}' || c == ']') && --depth == 0) {
+            return pos;
+        }
+    }
+    return size;
+}
+
+StringRef trim(const char* begin, const char* end) {
+    while (begin < end && isSpace(*begin)) {
+        begin++;
+    }
+    while (end > begin && isSpace(end[-1])) {
+        end--;
+    }
+    return StringRef(begin, end - begin);
+}
+
+} // namespace
+
+FileDataSource::FileDataSource(const std::string& path, ValueCallback callback)
+    : path_(path), callback_(callback), inotifyFd_(-1), watchFd_(-1),
+      loads_(0), failures_(0), pairs_(0), lastLoadUs_(0) {
+    size_t slash = path_.rfind('/');
+    if (slash == std::string::npos) {
+        directory_ = ".";
+        name_ = path_;
+    } else {
+        directory_ = slash == 0 ? "/" : path_.substr(0, slash);
+        name_ = path_.substr(slash + 1);
+    }
+}
+
+FileDataSource::~FileDataSource() {
+    stop();
+}
+
+bool FileDataSource::start() {
+    if (inotifyFd_ >= 0) {
+        return true;
+    }
+    if (name_.empty()) {
+        lastError_ = "no file name in " + path_;
+        return false;
+    }
+
+    inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd_ < 0) {
+        lastError_ = std::string("inotify: ") + std::strerror(errno);
+        return false;
+    }
+    watchFd_ = inotify_add_watch(inotifyFd_, directory_.c_str(), WATCH_EVENTS);
+    if (watchFd_ < 0) {
+        lastError_ = "cannot watch " + directory_ + ": " + std::strerror(errno);
+        stop();
+        return false;
+    }
+
+    // Watch first, then load, so a write in between isn't missed
+    load();
+    return true;
+}
+
+void FileDataSource::stop() {
+    if (inotifyFd_ >= 0) {
+        close(inotifyFd_);  // Drops the watch too
+        inotifyFd_ = -1;
+        watchFd_ = -1;
+    }
+}
+
+bool FileDataSource::poll() {
+    if (inotifyFd_ < 0 || !drainEvents()) {
+        return false;
+    }
+    return load();
+}
+
+void FileDataSource::printReport(std::ostream& out) const {
+    out << "📄 Data file " << path_ << " - " << (watchFd_ >= 0 ? "watching" : "not watching") << std::endl;
+    out << "   " << loads_ << " loads (" << failures_ << " failed), " << pairs_ << " values, last parse "
+        << lastLoadUs_ << " µs" << std::endl;
+    if (!lastError_.empty()) {
+        out << "   Last error: " << lastError_ << std::endl;
+    }
+}
+
+bool FileDataSource::drainEvents() {
+    bool changed = false;
+    while (true) {
+        ssize_t received = read(inotifyFd_, events_, sizeof(events_));
+        if (received <= 0) {
+            break;  // EAGAIN once drained
+        }
+
+        for (ssize_t pos = 0; pos < received; ) {
+            const struct inotify_event* event = (const struct inotify_event*)(events_ + pos);
+            pos += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                changed = true;  // Events were lost; reload to be safe
+            } else if (event->mask & IN_IGNORED) {
+                watchFd_ = -1;
+                fail("directory " + directory_ + " went away");
+            } else if (event->len > 0 && name_ == event->name) {
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
+bool FileDataSource::load() {
+    int fd = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        if (errno != ENOENT) {
+            fail(std::string("cannot open: ") + std::strerror(errno));
+        }
+        return false;  // Not written yet
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        close(fd);
+        fail("not a regular file");
+        return false;
+    }
+    size_t size = (size_t)info.st_size;
+    if (size > MAX_FILE_SIZE) {
+        close(fd);
+        fail("larger than " + std::to_string(MAX_FILE_SIZE / 1024) + " KB");
+        return false;
+    }
+
+    // Copy rather than map: a writer truncating the file in place would make
+    // a mapping fault mid-parse, while a short read just ends the contents
+    long long startUs = MonotonicClock::nowUs();
+    contents_.resize(size);
+    size_t got = 0;
+    while (got < size) {
+        ssize_t n = pread(fd, &contents_[got], size - got, (off_t)got);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            close(fd);
+            fail(std::string("read: ") + std::strerror(errno));
+            return false;
+        }
+        if (n == 0) {
+            break;  // Shrunk since fstat
+        }
+        got += (size_t)n;
+    }
+    close(fd);
+
+    bool ok = true;
+    size_t pairs = 0;
+    if (got > 0) {
+        ok = parse(&contents_[0], got, [this, &pairs](const StringRef& key, const StringRef& value) {
+            pairs++;
+            callback_(key, value);
+        });
+    }
+
+    lastLoadUs_ = MonotonicClock::nowUs() - startUs;
+    loads_++;
+    pairs_ += pairs;
+    if (!ok) {
+        fail("malformed after " + std::to_string(pairs) + " values");
+    } else {
+        lastError_.clear();
+    }
+    return true;
+}
+
+void FileDataSource::fail(const std::string& reason) {
+    failures_++;
+
+    // A writer stuck producing the same bad file only prints once
+    if (reason != lastError_) {
+        std::cerr << "⚠️  Data file " << path_ << ": " << reason << std::endl;
+    }
+    lastError_ = reason;
+}
+
+bool FileDataSource::parse(const char* data, size_t size, const ValueCallback& callback) {
+    // Editors on Windows like to start files with a UTF-8 byte order mark
+    if (size >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0) {
+        data += 3;
+        size -= 3;
+    }
+    size_t start = skipSpace(data, size, 0);
+    if (start < size && data[start] == '{') {
+        return parseJson(data + start, size - start, callback);
+    }
+    return parseLines(data, size, callback);
+}
+
+bool FileDataSource::parseJson(const char* data, size_t size, const ValueCallback& callback) {
+    size_t pos = 1;  // Past "{"
+    while (true) {
+        pos = skipSpace(data, size, pos);
+        if (pos < size && data[pos] == '}') {
+            return true;  // Empty object or trailing ","
+        }
+        if (pos >= size || data[pos] != '"') {
+            return false;
+        }
+        size_t keyStart = pos + 1;
+        size_t keyEnd = findStringEnd(data, size, keyStart);
+        pos = skipSpace(data, size, keyEnd + 1);
+        if (keyEnd >= size || pos >= size || data[pos] != ':') {
+            return false;
+        }
+        pos = skipSpace(data, size, pos + 1);
+        if (pos >= size) {
+            return false;
+        }
+
+        StringRef key(data + keyStart, keyEnd - keyStart);
+        if (data[pos] == '"') {
+            size_t valueEnd = findStringEnd(data, size, pos + 1);
+            if (valueEnd >= size) {
+                return false;
+            }
+            callback(key, StringRef(data + pos + 1, valueEnd - pos - 1));
+            pos = valueEnd + 1;
+        } else if (data[pos] == '{' || data[pos] == '[') {
+            pos = skipNested(data, size, pos);
+        } else {
+            // Number, true, false or null
+            size_t valueEnd = pos;
+            while (valueEnd < size && data[valueEnd] != ',' && data[valueEnd] != '}' && !isSpace(data[valueEnd])) {
+                valueEnd++;
+            }
+            StringRef value(data + pos, valueEnd - pos);
+            if (!value.equals("null")) {
+                callback(key, value);
+            }
+            pos = valueEnd;
+        }
+
+        pos = skipSpace(data, size, pos);
+        if (pos >= size) {
+            return false;
+        }
+        if (data[pos] == '}') {
+            return true;
+        }
+        if (data[pos] != ',') {
+            return false;
+        }
+        pos++;
+    }
+}
+
+bool FileDataSource::parseLines(const char* data, size_t size, const ValueCallback& callback) {
+    const char* end = data + size;
+    const char* line = data;
+    while (line < end) {
+        const char* lineEnd = (const char*)std::memchr(line, '\n', end - line);
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+
+        StringRef text = trim(line, lineEnd);
+        line = lineEnd + 1;
+        if (text.empty() || text.data[0] == '#') {
+            continue;
+        }
+
+        const char* comma = (const char*)std::memchr(text.data, ',', text.size);
+        if (!comma) {
+            return false;
+        }
+        StringRef key = trim(text.data, comma);
+        StringRef value = trim(comma + 1, text.data + text.size);
+        if (value.size >= 2 && value.data[0] == '"' && value.data[value.size - 1] == '"') {
+            value = StringRef(value.data + 1, value.size - 2);
+        }
+        if (key.empty()) {
+            return false;
+        }
+        callback(key, value);
+    }
+    return true;
+}
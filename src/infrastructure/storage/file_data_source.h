@@ -0,0 +1,87 @@
+#ifndef FILE_DATA_SOURCE_H
+#define FILE_DATA_SOURCE_H
+
+#include "shared/utils/string_ref.h"
+#include <ostream>
+#include <string>
+#include <vector>
+#include <functional>
+
+// Key/value data file, re-read as soon as a writer finishes with it.
+//
+// inotify watches the file's directory rather than the file itself, so the
+// watch survives the file being replaced by rename (FileUtils::writeFileAtomic)
+// and picks the file up if it doesn't exist yet. A close after writing or a
+// rename onto the path marks it changed; poll() drains the events without
+// blocking and loads the file at most once per call.
+//
+// A load reads the file into a buffer that is kept between loads and hands
+// each pair to the callback as views into it. Two formats are accepted:
+//
+//   {"db": 72.5, "db1": 68, "news": "Doors open at 8"}   flat JSON object
+//   db,72.5                                              key,value lines
+//
+// JSON is recognised by a leading "{". Nested objects and arrays are
+// skipped; string escapes are passed through undecoded. In the line format
+// blank lines and lines starting with "#" are ignored and a value may be
+// quoted.
+//
+// Writers should still replace the file rather than rewrite it in place, or
+// a load can see half-written contents; the next close reloads it.
+class FileDataSource {
+public:
+    typedef std::function<void(const StringRef& key, const StringRef& value)> ValueCallback;
+
+    FileDataSource(const std::string& path, ValueCallback callback);
+    ~FileDataSource();
+
+    // Lifecycle; start() also loads the file if it exists
+    bool start();
+    void stop();
+
+    // Load the file if it changed since the last call; never blocks.
+    // True when it was loaded.
+    bool poll();
+
+    unsigned long getLoadCount() const { return loads_; }
+    std::string getLastError() const { return lastError_; }
+    void printReport(std::ostream& out) const;
+
+    // Parse a whole buffer; false (after any pairs before the error) if it's
+    // malformed
+    static bool parse(const char* data, size_t size, const ValueCallback& callback);
+
+    static const size_t MAX_FILE_SIZE = 1024 * 1024;
+    static const size_t EVENT_BUFFER_SIZE = 4096;
+
+private:
+    std::string path_;
+    std::string directory_;
+    std::string name_;
+    ValueCallback callback_;
+
+    int inotifyFd_;
+    int watchFd_;
+    char events_[EVENT_BUFFER_SIZE];
+    std::vector<char> contents_;  // Reused by every load, at most MAX_FILE_SIZE
+
+    // Statistics
+    unsigned long loads_;
+    unsigned long failures_;
+    unsigned long pairs_;
+    long long lastLoadUs_;     // Parse time of the last load
+    std::string lastError_;
+
+    // Helper methods
+    bool drainEvents();
+    bool load();
+    void fail(const std::string& reason);
+    static bool parseJson(const char* data, size_t size, const ValueCallback& callback);
+    static bool parseLines(const char* data, size_t size, const ValueCallback& callback);
+
+    // Disable copy constructor and assignment operator
+    FileDataSource(const FileDataSource&) = delete;
+    FileDataSource& operator=(const FileDataSource&) = delete;
+};
+
+#endif // FILE_DATA_SOURCE_H
@@ -0,0 +1,528 @@
+#include "timeseries_store.h"
+#include "shared/utils/file_utils.h"
+#include <iostream>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+const uint32_t SEGMENT_MAGIC = 0x31535354; // "TSS1"
+const uint16_t SEGMENT_VERSION = 1;
+const size_t MAX_ENCODED_POINT = 20;       // Two 10-byte varints
+
+// On-disk segment header (64 bytes, host byte order). usedBytes is the only
+// commit point: a point exists once it is covered by usedBytes. The fields
+// after it only cache the end of the series and are rebuilt from the points
+// when the segment is opened, so a crash between the writes loses nothing.
+struct SegmentHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;
+    uint32_t count;          // Points in the segment, including the first
+    uint32_t usedBytes;      // Header + encoded points; written last (commit)
+    int64_t firstTimestamp;
+    int64_t firstValue;
+    int64_t lastTimestamp;
+    int64_t lastValue;
+    int64_t lastDelta;       // Previous timestamp delta (for delta-of-delta)
+    int64_t reserved;
+};
+
+uint64_t zigzagEncode(int64_t value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+int64_t zigzagDecode(uint64_t value) {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+size_t writeVarint(uint8_t* out, uint64_t value) {
+    size_t len = 0;
+    while (value >= 0x80) {
+        out[len++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[len++] = (uint8_t)value;
+    return len;
+}
+
+bool readVarint(const uint8_t* data, size_t end, size_t& pos, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < end; shift += 7) {
+        uint8_t byte = data[pos++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Rebuild the cached fields of a header from the committed points in `data`.
+// A point that doesn't decode (left by an older version) ends the segment.
+// Returns false if the segment was never committed.
+bool recoverHeader(const uint8_t* data, size_t size, SegmentHeader& header) {
+    size_t end = std::min((size_t)header.usedBytes, size);
+    if (header.headerSize != sizeof(SegmentHeader) || end < sizeof(SegmentHeader)) {
+        return false;
+    }
+
+    size_t pos = header.headerSize;
+    uint32_t count = 1;
+    int64_t timestamp = header.firstTimestamp;
+    int64_t value = header.firstValue;
+    int64_t delta = 0;
+    while (pos < end) {
+        size_t start = pos;
+        uint64_t dod, valueDelta;
+        if (!readVarint(data, end, pos, dod) || !readVarint(data, end, pos, valueDelta)) {
+            end = start;
+            break;
+        }
+        delta += zigzagDecode(dod);
+        timestamp += delta;
+        value += zigzagDecode(valueDelta);
+        count++;
+    }
+
+    header.usedBytes = (uint32_t)end;
+    header.count = count;
+    header.lastTimestamp = timestamp;
+    header.lastValue = value;
+    header.lastDelta = delta;
+    return true;
+}
+
+} // namespace
+
+TimeSeriesStore::TimeSeriesStore(const std::string& directory, size_t segmentSize)
+    : directory_(directory), segmentSize_(segmentSize), heartbeatSeconds_(DEFAULT_HEARTBEAT_SECONDS) {
+    if (segmentSize_ < sizeof(SegmentHeader) + MAX_ENCODED_POINT) {
+        segmentSize_ = DEFAULT_SEGMENT_SIZE;
+    }
+}
+
+TimeSeriesStore::~TimeSeriesStore() {
+    for (std::map<std::string, Series*>::iterator it = series_.begin(); it != series_.end(); ++it) {
+        unmapActiveSegment(*it->second);
+        delete it->second;
+    }
+}
+
+bool TimeSeriesStore::append(const std::string& metric, long long timestamp, long long value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Series* series = openSeries(metric, true);
+    if (!series) {
+        return false;
+    }
+
+    if (!series->active) {
+        return rollover(*series, timestamp, value);
+    }
+
+    SegmentHeader* header = (SegmentHeader*)series->active;
+    if (timestamp < header->lastTimestamp) {
+        lastError_ = "Timestamp older than last sample for " + metric;
+        return false;
+    }
+
+    // Unchanged values are only re-recorded once per heartbeat
+    if (value == header->lastValue && timestamp - header->lastTimestamp < heartbeatSeconds_) {
+        return true;
+    }
+
+    int64_t delta = timestamp - header->lastTimestamp;
+    uint8_t encoded[MAX_ENCODED_POINT];
+    size_t len = writeVarint(encoded, zigzagEncode(delta - header->lastDelta));
+    len += writeVarint(encoded + len, zigzagEncode(value - header->lastValue));
+
+    if (header->usedBytes + len > segmentSize_) {
+        return rollover(*series, timestamp, value);
+    }
+
+    // Write the point, then commit it by moving usedBytes past it
+    std::memcpy(series->active + header->usedBytes, encoded, len);
+    __atomic_store_n(&header->usedBytes, header->usedBytes + (uint32_t)len, __ATOMIC_RELEASE);
+    header->lastDelta = delta;
+    header->lastTimestamp = timestamp;
+    header->lastValue = value;
+    header->count++;
+    msync(series->active, segmentSize_, MS_ASYNC);
+
+    series->segments.back().lastTimestamp = timestamp;
+    return true;
+}
+
+bool TimeSeriesStore::query(const std::string& metric, long long from, long long to, std::vector<Point>& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Series* series = openSeries(metric, false);
+    if (!series || series->segments.empty()) {
+        return false;
+    }
+
+    // Binary search for the first segment that can hold `from`
+    size_t last = series->segments.size() - 1;
+    for (size_t i = findSegment(*series, from); i <= last; i++) {
+        const SegmentInfo& info = series->segments[i];
+        if (info.firstTimestamp > to) break;
+        if (info.lastTimestamp < from) continue;
+
+        const uint8_t* mapped = (i == last) ? series->active : nullptr;
+        if (!decodeSegment(info, mapped, from, to, out)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool TimeSeriesStore::queryDownsampled(const std::string& metric, long long from, long long to,
+                                       int bucketSeconds, std::vector<Bucket>& out) {
+    if (bucketSeconds <= 0) {
+        return false;
+    }
+
+    std::vector<Point> points;
+    if (!query(metric, from, to, points)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < points.size(); i++) {
+        const Point& p = points[i];
+        long long start = p.timestamp - (((p.timestamp % bucketSeconds) + bucketSeconds) % bucketSeconds);
+
+        if (out.empty() || out.back().startTime != start) {
+            Bucket bucket;
+            bucket.startTime = start;
+            bucket.minValue = p.value;
+            bucket.maxValue = p.value;
+            bucket.lastValue = p.value;
+            bucket.meanValue = (double)p.value;
+            bucket.count = 1;
+            out.push_back(bucket);
+            continue;
+        }
+
+        Bucket& bucket = out.back();
+        bucket.minValue = std::min(bucket.minValue, p.value);
+        bucket.maxValue = std::max(bucket.maxValue, p.value);
+        bucket.lastValue = p.value;
+        bucket.count++;
+        bucket.meanValue += ((double)p.value - bucket.meanValue) / bucket.count;
+    }
+
+    return true;
+}
+
+bool TimeSeriesStore::getLatest(const std::string& metric, Point& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Series* series = openSeries(metric, false);
+    if (!series || !series->active) {
+        return false;
+    }
+
+    const SegmentHeader* header = (const SegmentHeader*)series->active;
+    out = Point(header->lastTimestamp, header->lastValue);
+    return true;
+}
+
+bool TimeSeriesStore::getValueAt(const std::string& metric, long long timestamp, Point& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Series* series = openSeries(metric, false);
+    if (!series || series->segments.empty() || series->segments[0].firstTimestamp > timestamp) {
+        return false;
+    }
+
+    size_t index = findSegment(*series, timestamp);
+    const uint8_t* mapped = (index == series->segments.size() - 1) ? series->active : nullptr;
+
+    std::vector<Point> points;
+    if (!decodeSegment(series->segments[index], mapped, LLONG_MIN, timestamp, points) || points.empty()) {
+        return false;
+    }
+
+    out = points.back();
+    return true;
+}
+
+bool TimeSeriesStore::getChange(const std::string& metric, long long windowSeconds, long long& change) {
+    Point latest;
+    if (!getLatest(metric, latest)) {
+        return false;
+    }
+
+    Point baseline;
+    if (!getValueAt(metric, latest.timestamp - windowSeconds, baseline)) {
+        return false; // History does not reach back far enough yet
+    }
+
+    change = latest.value - baseline.value;
+    return true;
+}
+
+void TimeSeriesStore::setHeartbeat(long long seconds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    heartbeatSeconds_ = seconds > 0 ? seconds : 0;
+}
+
+size_t TimeSeriesStore::getDiskUsage(const std::string& metric) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Series* series = openSeries(metric, false);
+    return series ? series->segments.size() * segmentSize_ : 0;
+}
+
+std::string TimeSeriesStore::getLastError() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lastError_;
+}
+
+TimeSeriesStore::Series* TimeSeriesStore::openSeries(const std::string& metric, bool create) {
+    std::map<std::string, Series*>::iterator it = series_.find(metric);
+    if (it != series_.end()) {
+        return it->second;
+    }
+
+    std::string path = directory_ + "/" + sanitizeName(metric);
+    DIR* dir = opendir(path.c_str());
+    if (!dir) {
+        if (!create) {
+            return nullptr;
+        }
+        if (!FileUtils::makeDirectories(path)) {
+            lastError_ = "Cannot create directory " + path + ": " + std::strerror(errno);
+            return nullptr;
+        }
+        dir = opendir(path.c_str());
+        if (!dir) {
+            lastError_ = "Cannot open directory " + path;
+            return nullptr;
+        }
+    }
+
+    // Segment files are named by sequence number so they sort by time
+    std::vector<std::string> names;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        std::string name = entry->d_name;
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".seg") == 0) {
+            names.push_back(name);
+        }
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+
+    Series* series = new Series();
+    series->directory = path;
+
+    std::vector<uint8_t> data(segmentSize_);
+    SegmentHeader tail;
+    std::memset(&tail, 0, sizeof(tail));
+    for (size_t i = 0; i < names.size(); i++) {
+        std::string segmentPath = path + "/" + names[i];
+        int fd = open(segmentPath.c_str(), O_RDONLY);
+        if (fd < 0) continue;
+
+        // The last point is found by walking the committed ones
+        ssize_t got = pread(fd, &data[0], segmentSize_, 0);
+        close(fd);
+        SegmentHeader header;
+        if (got >= (ssize_t)sizeof(header)) {
+            std::memcpy(&header, &data[0], sizeof(header));
+        }
+        if (got < (ssize_t)sizeof(header) || header.magic != SEGMENT_MAGIC ||
+            !recoverHeader(&data[0], (size_t)got, header)) {
+            std::cerr << "⚠️  Skipping invalid segment " << segmentPath << std::endl;
+            continue;
+        }
+
+        SegmentInfo info;
+        info.path = segmentPath;
+        info.firstTimestamp = header.firstTimestamp;
+        info.lastTimestamp = header.lastTimestamp;
+        series->segments.push_back(info);
+        series->nextSequence = std::max(series->nextSequence, std::atoi(names[i].c_str()) + 1);
+        tail = header;
+    }
+
+    // Keep the tail segment mapped for appends, with its cached fields
+    // matching the committed points
+    if (!series->segments.empty() && mapActiveSegment(*series, series->segments.back().path, false, 0, 0)) {
+        SegmentHeader* header = (SegmentHeader*)series->active;
+        header->count = tail.count;
+        header->lastTimestamp = tail.lastTimestamp;
+        header->lastValue = tail.lastValue;
+        header->lastDelta = tail.lastDelta;
+        header->usedBytes = tail.usedBytes;
+    }
+
+    series_[metric] = series;
+    return series;
+}
+
+bool TimeSeriesStore::mapActiveSegment(Series& series, const std::string& path, bool create,
+                                       long long timestamp, long long value) {
+    int fd = open(path.c_str(), create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0644);
+    if (fd < 0) {
+        lastError_ = "Cannot open segment " + path + ": " + std::strerror(errno);
+        return false;
+    }
+
+    if (create && ftruncate(fd, segmentSize_) != 0) {
+        lastError_ = "Cannot size segment " + path + ": " + std::strerror(errno);
+        close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, segmentSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        lastError_ = "Cannot map segment " + path + ": " + std::strerror(errno);
+        close(fd);
+        return false;
+    }
+
+    series.active = (uint8_t*)mapped;
+    series.activeFd = fd;
+
+    if (create) {
+        SegmentHeader* header = (SegmentHeader*)series.active;
+        std::memset(header, 0, sizeof(SegmentHeader));
+        header->magic = SEGMENT_MAGIC;
+        header->version = SEGMENT_VERSION;
+        header->headerSize = sizeof(SegmentHeader);
+        header->firstTimestamp = timestamp;
+        header->firstValue = value;
+        header->lastTimestamp = timestamp;
+        header->lastValue = value;
+        header->lastDelta = 0;
+        header->count = 1;
+        // A segment without usedBytes is skipped on open
+        __atomic_store_n(&header->usedBytes, (uint32_t)sizeof(SegmentHeader), __ATOMIC_RELEASE);
+        msync(series.active, segmentSize_, MS_SYNC);
+    }
+
+    return true;
+}
+
+void TimeSeriesStore::unmapActiveSegment(Series& series) {
+    if (series.active) {
+        munmap(series.active, segmentSize_);
+        series.active = nullptr;
+    }
+    if (series.activeFd >= 0) {
+        close(series.activeFd);
+        series.activeFd = -1;
+    }
+}
+
+bool TimeSeriesStore::rollover(Series& series, long long timestamp, long long value) {
+    unmapActiveSegment(series);
+
+    char name[32];
+    snprintf(name, sizeof(name), "%08d.seg", series.nextSequence++);
+    std::string path = series.directory + "/" + name;
+
+    if (!mapActiveSegment(series, path, true, timestamp, value)) {
+        return false;
+    }
+
+    SegmentInfo info;
+    info.path = path;
+    info.firstTimestamp = timestamp;
+    info.lastTimestamp = timestamp;
+    series.segments.push_back(info);
+    return true;
+}
+
+size_t TimeSeriesStore::findSegment(const Series& series, long long timestamp) const {
+    // Last segment whose first timestamp is <= timestamp (or the first one)
+    size_t lo = 0;
+    size_t hi = series.segments.size();
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (series.segments[mid].firstTimestamp <= timestamp) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo > 0 ? lo - 1 : 0;
+}
+
+bool TimeSeriesStore::decodeSegment(const SegmentInfo& info, const uint8_t* mapped, long long from, long long to,
+                                    std::vector<Point>& out) {
+    void* temporary = nullptr;
+    if (!mapped) {
+        int fd = open(info.path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            lastError_ = "Cannot open segment " + info.path;
+            return false;
+        }
+        temporary = mmap(nullptr, segmentSize_, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (temporary == MAP_FAILED) {
+            lastError_ = "Cannot map segment " + info.path;
+            return false;
+        }
+        mapped = (const uint8_t*)temporary;
+    }
+
+    const SegmentHeader* header = (const SegmentHeader*)mapped;
+    size_t end = std::min((size_t)__atomic_load_n(&header->usedBytes, __ATOMIC_ACQUIRE), segmentSize_);
+    size_t pos = header->headerSize;
+
+    long long timestamp = header->firstTimestamp;
+    long long value = header->firstValue;
+    long long delta = 0;
+    bool ok = true;
+
+    // The first point is in the header; the rest run up to the commit point
+    while (timestamp <= to) {
+        if (timestamp >= from) {
+            out.push_back(Point(timestamp, value));
+        }
+        if (pos >= end) {
+            break;
+        }
+
+        uint64_t dod, valueDelta;
+        if (!readVarint(mapped, end, pos, dod) || !readVarint(mapped, end, pos, valueDelta)) {
+            lastError_ = "Corrupt segment " + info.path;
+            ok = false;
+            break;
+        }
+        delta += zigzagDecode(dod);
+        timestamp += delta;
+        value += zigzagDecode(valueDelta);
+    }
+
+    if (temporary) {
+        munmap(temporary, segmentSize_);
+    }
+    return ok;
+}
+
+std::string TimeSeriesStore::sanitizeName(const std::string& metric) const {
+    std::string name = metric;
+    for (size_t i = 0; i < name.size(); i++) {
+        char c = name[i];
+        bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                    c == '.' || c == '-' || c == '_';
+        if (!safe || (i == 0 && c == '.')) {
+            name[i] = '_';
+        }
+    }
+    return name;
+}
@@ -0,0 +1,106 @@
+#ifndef TIMESERIES_STORE_H
+#define TIMESERIES_STORE_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <stdint.h>
+
+// Append-only on-disk store for fetched statistics (subscribers, views,
+// popularity, ...). Each metric lives in its own directory of fixed-size,
+// memory-mapped segment files:
+//
+//   header | point 2 | point 3 | ...   (first point is kept in the header)
+//
+// Points are encoded as zigzag varints: delta-of-delta for the timestamp and
+// delta for the value, so regular polls of a slowly changing counter cost
+// about two bytes each. Unchanged values are only re-recorded once per
+// heartbeat, which keeps a metric at a few KB per month.
+class TimeSeriesStore {
+public:
+    struct Point {
+        long long timestamp;  // Unix seconds
+        long long value;
+
+        Point(long long t = 0, long long v = 0) : timestamp(t), value(v) {}
+    };
+
+    struct Bucket {
+        long long startTime;
+        long long minValue;
+        long long maxValue;
+        long long lastValue;
+        double meanValue;
+        int count;
+    };
+
+    TimeSeriesStore(const std::string& directory, size_t segmentSize = DEFAULT_SEGMENT_SIZE);
+    ~TimeSeriesStore();
+
+    // Append a sample. Timestamps must not go backwards for a metric.
+    bool append(const std::string& metric, long long timestamp, long long value);
+
+    // Points with from <= timestamp <= to, in time order
+    bool query(const std::string& metric, long long from, long long to, std::vector<Point>& out);
+
+    // Aggregate points into fixed buckets aligned to bucketSeconds
+    bool queryDownsampled(const std::string& metric, long long from, long long to,
+                          int bucketSeconds, std::vector<Bucket>& out);
+
+    // Latest value and the last value recorded at or before `timestamp`
+    bool getLatest(const std::string& metric, Point& out);
+    bool getValueAt(const std::string& metric, long long timestamp, Point& out);
+
+    // Change of the latest value over the trailing window ("+N in 24h").
+    // Returns false until the series covers the whole window.
+    bool getChange(const std::string& metric, long long windowSeconds, long long& change);
+
+    // Configuration
+    void setHeartbeat(long long seconds);
+    size_t getDiskUsage(const std::string& metric);
+    std::string getLastError() const;
+
+    static const size_t DEFAULT_SEGMENT_SIZE = 4096;
+    static const long long DEFAULT_HEARTBEAT_SECONDS = 3600;
+
+private:
+    struct SegmentInfo {
+        std::string path;
+        long long firstTimestamp;
+        long long lastTimestamp;
+    };
+
+    struct Series {
+        std::string directory;
+        std::vector<SegmentInfo> segments;  // Sorted by time
+        uint8_t* active;                    // Mapped tail segment (nullptr if none)
+        int activeFd;
+        int nextSequence;
+
+        Series() : active(nullptr), activeFd(-1), nextSequence(1) {}
+    };
+
+    std::string directory_;
+    size_t segmentSize_;
+    long long heartbeatSeconds_;
+    std::map<std::string, Series*> series_;
+    std::string lastError_;
+    mutable std::mutex mutex_;
+
+    // Helper methods (called with mutex_ held)
+    Series* openSeries(const std::string& metric, bool create);
+    bool mapActiveSegment(Series& series, const std::string& path, bool create, long long timestamp, long long value);
+    void unmapActiveSegment(Series& series);
+    bool rollover(Series& series, long long timestamp, long long value);
+    size_t findSegment(const Series& series, long long timestamp) const;
+    bool decodeSegment(const SegmentInfo& info, const uint8_t* mapped, long long from, long long to,
+                       std::vector<Point>& out);
+    std::string sanitizeName(const std::string& metric) const;
+
+    // Disable copy constructor and assignment operator
+    TimeSeriesStore(const TimeSeriesStore&) = delete;
+    TimeSeriesStore& operator=(const TimeSeriesStore&) = delete;
+};
+
+#endif // TIMESERIES_STORE_H
@@ -0,0 +1,146 @@
+#include "animation_app.h"
+#include "shared/utils/monotonic_clock.h"
+#include <iostream>
+#include <unistd.h>
+
+AnimationApp::AnimationApp(RGBMatrix* matrix, int brightnessLevel)
+    : matrix_(matrix), display_(nullptr), brightnessLevel_(brightnessLevel), isRunning_(false),
+      frame_(0), dueUs_(0), finished_(false), shown_(0), skipped_(0), lateTotalUs_(0), lateWorstUs_(0) {
+    if (matrix_) {
+        display_ = new AnimationDisplay(matrix_, brightnessLevel_);
+    }
+}
+
+AnimationApp::~AnimationApp() {
+    cleanup();
+    if (display_) {
+        delete display_;
+        display_ = nullptr;
+    }
+}
+
+bool AnimationApp::initialize() {
+    if (!matrix_) {
+        std::cerr << "\033[0;31m❌ Matrix not provided\033[0m" << std::endl;
+        return false;
+    }
+    if (path_.empty()) {
+        std::cerr << "\033[0;31m❌ No animation; start with --animation <file> (see tools/animation_render)\033[0m" << std::endl;
+        return false;
+    }
+    
+    // Map the file again on every visit, so a re-rendered file is picked up
+    cleanup();
+    if (!animation_.open(path_)) {
+        std::cerr << "\033[0;31m❌ " << animation_.getLastError() << "\033[0m" << std::endl;
+        return false;
+    }
+    if (animation_.getWidth() != matrix_->width() || animation_.getHeight() != matrix_->height()) {
+        std::cerr << "\033[0;31m❌ " << path_ << " was rendered for " << animation_.getWidth() << "x" << animation_.getHeight()
+                  << ", the panel is " << matrix_->width() << "x" << matrix_->height() << "\033[0m" << std::endl;
+        animation_.close();
+        return false;
+    }
+    display_->load(&animation_);
+    
+    frame_ = 0;
+    dueUs_ = MonotonicClock::nowUs();
+    finished_ = false;
+    shown_ = 0;
+    skipped_ = 0;
+    lateTotalUs_ = 0;
+    lateWorstUs_ = 0;
+    
+    isRunning_ = true;
+    printStartupInfo();
+    
+    return true;
+}
+
+void AnimationApp::update() {
+    if (!isRunning_ || finished_) {
+        return;
+    }
+    
+    long long waitUs = dueUs_ - MonotonicClock::nowUs();
+    if (waitUs > LOOP_SLACK_MS * 1000LL) {
+        return;
+    }
+    if (waitUs > 0) {
+        usleep((useconds_t)waitUs);
+    }
+    
+    long long lateUs = MonotonicClock::nowUs() - dueUs_;
+    lateTotalUs_ += lateUs;
+    if (lateUs > lateWorstUs_) {
+        lateWorstUs_ = lateUs;
+    }
+    display_->show(frame_);
+    shown_++;
+    advance();
+    
+    // Skip frames that are over already rather than play catch-up; the
+    // last frame of a one-shot animation is always shown
+    long long nowUs = MonotonicClock::nowUs();
+    int lastFrame = animation_.getFrameCount() - 1;
+    while (!finished_ && (animation_.isLooping() || frame_ < lastFrame) &&
+           dueUs_ + animation_.getDelayMs(frame_) * 1000LL <= nowUs) {
+        skipped_++;
+        advance();
+    }
+}
+
+void AnimationApp::cleanup() {
+    if (isRunning_ && matrix_) {
+        display_->release();
+        matrix_->Clear();
+        // Don't delete matrix_ - it's managed by the main app
+    }
+    animation_.close();
+    
+    isRunning_ = false;
+}
+
+void AnimationApp::setBrightness(int brightnessLevel) {
+    if (brightnessLevel >= Config::MIN_BRIGHTNESS && brightnessLevel <= Config::MAX_BRIGHTNESS) {
+        brightnessLevel_ = brightnessLevel;
+        if (display_) {
+            display_->setBrightness(brightnessLevel);
+        }
+    }
+}
+
+void AnimationApp::printReport(std::ostream& out) const {
+    if (!isRunning_) {
+        out << "\033[0;33m💡 Switch to the anim app to play " << (path_.empty() ? "an animation" : path_) << "\033[0m" << std::endl;
+        return;
+    }
+    out << "\033[1;36m🎞️  " << path_ << "\033[0m" << std::endl;
+    out << "  frames:   " << shown_ << " shown, " << skipped_ << " skipped" << (finished_ ? ", finished" : "") << std::endl;
+    if (shown_ > 0) {
+        out << "  late:     " << (lateTotalUs_ / (long long)shown_) << " µs average, " << lateWorstUs_ << " µs worst" << std::endl;
+    }
+}
+
+void AnimationApp::advance() {
+    dueUs_ += animation_.getDelayMs(frame_) * 1000LL;
+    if (++frame_ < animation_.getFrameCount()) {
+        return;
+    }
+    if (animation_.isLooping()) {
+        frame_ = 0;
+    } else {
+        // The last frame stays up
+        frame_--;
+        finished_ = true;
+    }
+}
+
+void AnimationApp::printStartupInfo() {
+    std::cout << "\033[1;36m🎞️  Animation - " << path_ << "\033[0m" << std::endl;
+    std::cout << "\033[0;33m💡 Brightness:\033[0m " << brightnessLevel_ << "/10 (" << (brightnessLevel_ * 10) << "%)" << std::endl;
+    std::cout << "\033[0;32m🎬 " << animation_.getFrameCount() << " frames, " << (animation_.getDurationMs() / 1000.0) << " s"
+              << (animation_.isLooping() ? " looped" : " once") << ", " << display_->getPreloadedCount() << " preloaded\033[0m" << std::endl;
+    std::cout << "\033[0;31m⚠️  Type 'back' to return to main menu\033[0m" << std::endl;
+    std::cout << std::endl;
+}
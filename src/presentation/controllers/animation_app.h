@@ -0,0 +1,67 @@
+#ifndef ANIMATION_APP_H
+#define ANIMATION_APP_H
+
+#include "presentation/displays/animation_display.h"
+#include "infrastructure/storage/animation_file.h"
+#include "infrastructure/config/config.h"
+#include "led-matrix.h"
+#include <ostream>
+#include <string>
+
+// Plays an animation pre-rendered by tools/animation_render, for intros and
+// idle screens. Each frame is swapped in when its time comes, counted from
+// when the animation started so delays never add up to drift. A frame due
+// before the next pass of the main loop is waited for here rather than
+// shown a loop late; frames that are already over when the app gets to
+// them are skipped. Animations rendered with --once hold their last frame.
+class AnimationApp {
+public:
+    AnimationApp(RGBMatrix* matrix, int brightnessLevel = Config::DEFAULT_BRIGHTNESS);
+    ~AnimationApp();
+    
+    // Animation file (from --animation)
+    void setFile(const std::string& path) { path_ = path; }
+    
+    // Initialize the application (maps the file, preloads frames)
+    bool initialize();
+    
+    // Update methods (called by main app)
+    void update();
+    
+    // Cleanup resources
+    void cleanup();
+    
+    // Configuration
+    void setBrightness(int brightnessLevel);
+    
+    // Frames shown and skipped since the app was switched to
+    void printReport(std::ostream& out) const;
+    
+    static const int LOOP_SLACK_MS = 10;   // The main loop's frame delay
+    
+private:
+    RGBMatrix* matrix_;
+    AnimationDisplay* display_;
+    AnimationFile animation_;
+    std::string path_;
+    
+    int brightnessLevel_;
+    bool isRunning_;
+    
+    // Playback state
+    int frame_;              // Next frame to show
+    long long dueUs_;        // When it is due (MonotonicClock)
+    bool finished_;
+    
+    // Statistics
+    unsigned long shown_;
+    unsigned long skipped_;
+    long long lateTotalUs_;
+    long long lateWorstUs_;
+    
+    // Helper methods
+    void advance();
+    void printStartupInfo();
+};
+
+#endif // ANIMATION_APP_H
@@ -1,10 +1,29 @@
 #include "db_color_calculator.h"
+#include <cstdio>
+
+bool DbColorCalculator::parseThresholds(const std::string& text, Thresholds& out) {
+    Thresholds parsed;
+    char extra;
+    if (sscanf(text.c_str(), "%d/%d/%d%c", &parsed.yellow, &parsed.orange, &parsed.red, &extra) != 3) {
+        return false;
+    }
+    if (parsed.yellow < Config::MIN_DB_VALUE || parsed.yellow >= parsed.orange ||
+        parsed.orange >= parsed.red || parsed.red > Config::MAX_DB_VALUE) {
+        return false;
+    }
+    out = parsed;
+    return true;
+}
 
 ColorUtils::Color DbColorCalculator::getBorderColor(int dbValue) {
+    return getBorderColor(dbValue, Thresholds());
+}
+
+ColorUtils::Color DbColorCalculator::getBorderColor(int dbValue, const Thresholds& thresholds) {
     // Define transition zones (5dB before each threshold)
-    const int GREEN_TO_YELLOW_START = YELLOW_THRESHOLD - 5;  // 75dB
-    const int YELLOW_TO_ORANGE_START = ORANGE_THRESHOLD - 5; // 85dB  
-    const int ORANGE_TO_RED_START = RED_THRESHOLD - 5;       // 90dB
+    const int GREEN_TO_YELLOW_START = thresholds.yellow - 5;  // 75dB
+    const int YELLOW_TO_ORANGE_START = thresholds.orange - 5; // 85dB  
+    const int ORANGE_TO_RED_START = thresholds.red - 5;       // 90dB
     
     // Define colors
     ColorUtils::Color grey(Config::Colors::BORDER_GREY_R, Config::Colors::BORDER_GREY_G, Config::Colors::BORDER_GREY_B);
@@ -16,25 +35,25 @@ ColorUtils::Color DbColorCalculator::getBorderColor(int dbValue) {
         // Pure grey (below 75dB)
         return grey;
         
-    } else if (dbValue < YELLOW_THRESHOLD) {
+    } else if (dbValue < thresholds.yellow) {
         // Transition from grey to yellow (75-79dB)
-        return getTransitionColor(dbValue, GREEN_TO_YELLOW_START, YELLOW_THRESHOLD, grey, yellow);
+        return getTransitionColor(dbValue, GREEN_TO_YELLOW_START, thresholds.yellow, grey, yellow);
         
     } else if (dbValue < YELLOW_TO_ORANGE_START) {
         // Pure yellow (80-84dB)
         return yellow;
         
-    } else if (dbValue < ORANGE_THRESHOLD) {
+    } else if (dbValue < thresholds.orange) {
         // Transition from yellow to orange (85-89dB)
-        return getTransitionColor(dbValue, YELLOW_TO_ORANGE_START, ORANGE_THRESHOLD, yellow, orange);
+        return getTransitionColor(dbValue, YELLOW_TO_ORANGE_START, thresholds.orange, yellow, orange);
         
     } else if (dbValue < ORANGE_TO_RED_START) {
         // Pure orange (90-89dB)
         return orange;
         
-    } else if (dbValue < RED_THRESHOLD) {
+    } else if (dbValue < thresholds.red) {
         // Transition from orange to red (90-94dB)
-        return getTransitionColor(dbValue, ORANGE_TO_RED_START, RED_THRESHOLD, orange, red);
+        return getTransitionColor(dbValue, ORANGE_TO_RED_START, thresholds.red, orange, red);
         
     } else {
         // Pure red (95dB+)
@@ -53,16 +72,31 @@ ColorUtils::Color DbColorCalculator::getProgressBarColor(int dbValue, int segmen
     }
 }
 
+int DbColorCalculator::getSegment(int dbValue, const Thresholds& thresholds) {
+    if (dbValue >= thresholds.red) {
+        return 2;
+    }
+    return dbValue >= thresholds.yellow ? 1 : 0;
+}
+
 bool DbColorCalculator::shouldBlink(int dbValue) {
-    return dbValue >= YELLOW_THRESHOLD;
+    return shouldBlink(dbValue, Thresholds());
+}
+
+bool DbColorCalculator::shouldBlink(int dbValue, const Thresholds& thresholds) {
+    return dbValue >= thresholds.yellow;
 }
 
 int DbColorCalculator::getBlinkDuration(int dbValue) {
-    if (dbValue >= YELLOW_THRESHOLD && dbValue < ORANGE_THRESHOLD) {
+    return getBlinkDuration(dbValue, Thresholds());
+}
+
+int DbColorCalculator::getBlinkDuration(int dbValue, const Thresholds& thresholds) {
+    if (dbValue >= thresholds.yellow && dbValue < thresholds.orange) {
         return Config::BLINK_DURATION_SLOW / 1000;    // 80-89dB: slow fade (500ms)
-    } else if (dbValue >= ORANGE_THRESHOLD && dbValue < RED_THRESHOLD) {
+    } else if (dbValue >= thresholds.orange && dbValue < thresholds.red) {
         return Config::BLINK_DURATION_MEDIUM / 1000;  // 90-94dB: medium flash (250ms)
-    } else if (dbValue >= RED_THRESHOLD) {
+    } else if (dbValue >= thresholds.red) {
         return Config::BLINK_DURATION_FAST / 1000;    // 95dB+: fast flash (100ms)
     }
     return Config::BLINK_DURATION_DEFAULT / 1000;     // Default (200ms)
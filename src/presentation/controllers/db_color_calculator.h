@@ -3,6 +3,7 @@
 
 #include "shared/utils/color_utils.h"
 #include "infrastructure/config/config.h"
+#include <string>
 
 class DbColorCalculator {
 public:
@@ -11,17 +12,35 @@ public:
     static const int ORANGE_THRESHOLD = 90;
     static const int RED_THRESHOLD = 95;
     
+    // Per-channel thresholds (e.g. a quieter limit for one venue zone)
+    struct Thresholds {
+        int yellow;
+        int orange;
+        int red;
+        
+        Thresholds() : yellow(YELLOW_THRESHOLD), orange(ORANGE_THRESHOLD), red(RED_THRESHOLD) {}
+    };
+    
+    // Parse "yellow/orange/red", e.g. "75/85/90"; thresholds must increase
+    static bool parseThresholds(const std::string& text, Thresholds& out);
+    
     // Calculate border color based on dB value
     static ColorUtils::Color getBorderColor(int dbValue);
+    static ColorUtils::Color getBorderColor(int dbValue, const Thresholds& thresholds);
     
     // Calculate progress bar colors based on dB value
     static ColorUtils::Color getProgressBarColor(int dbValue, int segment);
     
+    // Progress bar segment a level falls in: 0 green, 1 yellow, 2 red
+    static int getSegment(int dbValue, const Thresholds& thresholds);
+    
     // Check if border should blink
     static bool shouldBlink(int dbValue);
+    static bool shouldBlink(int dbValue, const Thresholds& thresholds);
     
     // Get blink duration based on dB value
     static int getBlinkDuration(int dbValue);
+    static int getBlinkDuration(int dbValue, const Thresholds& thresholds);
     
 private:
     // Helper methods for color transitions
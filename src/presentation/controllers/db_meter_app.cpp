@@ -1,14 +1,53 @@
 #include "db_meter_app.h"
 #include "db_color_calculator.h"
 #include <iostream>
+#include <cstdio>
+#include <cmath>
 #include <signal.h>
 
 // Interrupt handling is managed by the main app
 
-DbMeterApp::DbMeterApp(RGBMatrix* matrix, int brightnessLevel) 
-    : matrix_(matrix), display_(nullptr), 
-      blinkManager_(nullptr), currentDbValue_(Config::DEFAULT_DB_VALUE), 
-      brightnessLevel_(brightnessLevel), isRunning_(false) {
+namespace {
+
+// Drain consumer: every sample feeds both the frame summary and its channel
+// (and the trace, when recording)
+struct MeterFeed {
+    DbSampleSummary& summary;
+    MultiChannelMeter& meter;
+    DbTraceWriter* trace;
+    long long nowMs;
+    
+    MeterFeed(DbSampleSummary& s, MultiChannelMeter& m, DbTraceWriter* t, long long now)
+        : summary(s), meter(m), trace(t), nowMs(now) {}
+    
+    void operator()(const DbSample& sample) {
+        summary(sample);
+        meter.addReading(sample.channel, sample.centiDb);
+        if (trace) {
+            trace->append(nowMs, sample);
+        }
+    }
+};
+
+int roundDb(double value) {
+    int rounded = (int)(value + 0.5);
+    if (rounded < Config::MIN_DB_VALUE) rounded = Config::MIN_DB_VALUE;
+    if (rounded > Config::MAX_DB_VALUE) rounded = Config::MAX_DB_VALUE;
+    return rounded;
+}
+
+} // namespace
+
+DbMeterApp::DbMeterApp(RGBMatrix* matrix, int brightnessLevel, Clock* clock) 
+    : matrix_(matrix), clock_(clock ? clock : Clock::monotonic()), blinkClock_(clock_), display_(nullptr), 
+      blinkManager_(nullptr), 
+      brightnessLevel_(brightnessLevel), isRunning_(false), sampleRing_(nullptr), exposureLogger_(nullptr),
+      traceWriter_(nullptr), lastStepMs_(clock_->nowMs()),
+      peakHolds_(MultiChannelMeter::MAX_CHANNELS, PeakHold(Config::PEAK_HOLD_MS, Config::PEAK_DECAY_DB_PER_SECOND)),
+      history_(Config::DB_HISTORY_COLUMNS, Config::DB_HISTORY_SLICE_MS),
+      hasMetrics_(false), page_(PAGE_LIVE), pageShownAtMs_(0), hasBeat_(false) {
+    meter_.reset(Config::DEFAULT_DB_VALUE);
+    snprintf(unitLabel_, sizeof(unitLabel_), "dB");
 }
 
 DbMeterApp::~DbMeterApp() {
@@ -23,35 +62,227 @@ bool DbMeterApp::initialize() {
     
     // Create components
     display_ = new DbDisplay(matrix_, brightnessLevel_);
-    blinkManager_ = new BlinkManager();
+    start();
     
     // Interrupt handlers are managed by the main app
     
-    isRunning_ = true;
     printStartupInfo();
     
     return true;
 }
 
+bool DbMeterApp::initialize(Canvas* canvas) {
+    if (!canvas) {
+        return false;
+    }
+    
+    display_ = new DbDisplay(canvas, brightnessLevel_);
+    start();
+    return true;
+}
+
+void DbMeterApp::start() {
+    display_->setHistory(&history_);
+    blinkManager_ = new BlinkManager(blinkClock_);
+    isRunning_ = true;
+}
+
 void DbMeterApp::update() {
     if (!isRunning_) {
         return;
     }
     
+    long long now = clock_->nowMs();
+    int channels = meter_.getChannelCount();
+    for (int c = 0; c < channels; c++) {
+        peakHolds_[c].update(meter_.getLevelDb(c), now);
+    }
+    
+    updatePageRotation();
+    bool livePage = !hasMetrics_ || page_ == PAGE_LIVE;
+    if (livePage && channels > 1) {
+        updateChannels(now);
+        return;
+    }
+    
+    int dbValue = currentPageValue();
+    
+    // Peak marker belongs to the live level only
+    int peakHoldValue = livePage ? roundDb(peakHolds_[0].getValue(now)) : -1;
+    
     // Get blink duration based on dB level
-    int blinkDuration = DbColorCalculator::getBlinkDuration(currentDbValue_);
+    int blinkDuration = DbColorCalculator::getBlinkDuration(dbValue, thresholds_[0]);
     
     // Update blink state with duration
     bool currentBlinkState = blinkManager_->updateBlinkState(blinkDuration);
+    currentBlinkState = applyBeatPulse(now, currentBlinkState);
     
     // Update display with current blink state
-    display_->update(currentDbValue_, currentBlinkState);
+    display_->update(dbValue, currentBlinkState, unitLabel_, peakHoldValue, thresholds_[0]);
+}
+
+void DbMeterApp::updateChannels(long long nowMs) {
+    int channels = meter_.getChannelCount();
+    for (int c = 0; c < channels; c++) {
+        channelLevels_[c].value = roundDb(meter_.getLevelDb(c));
+        channelLevels_[c].peakHoldValue = roundDb(peakHolds_[c].getValue(nowMs));
+        channelLevels_[c].thresholds = thresholds_[c];
+    }
+    
+    // Border and blinking follow the loudest channel
+    int loudest = meter_.getLoudestChannel();
+    int blinkDuration = DbColorCalculator::getBlinkDuration(channelLevels_[loudest].value, thresholds_[loudest]);
+    bool currentBlinkState = blinkManager_->updateBlinkState(blinkDuration);
+    currentBlinkState = applyBeatPulse(nowMs, currentBlinkState);
+    
+    display_->updateChannels(channelLevels_, channels, loudest, currentBlinkState);
 }
 
-void DbMeterApp::updateValue(int newValue) {
+void DbMeterApp::updateValue(int newValue, int channel) {
     if (newValue >= 0 && newValue <= 120) {
-        currentDbValue_ = newValue;
+        meter_.addReading(channel, (uint16_t)(newValue * 100));
+        if (traceWriter_ && channel >= 0 && channel < MultiChannelMeter::MAX_CHANNELS) {
+            traceWriter_->append(clock_->nowMs(), DbSample((uint16_t)(newValue * 100), (uint8_t)channel));
+        }
+    }
+}
+
+void DbMeterApp::setSampleRing(DbSampleRing* ring) {
+    sampleRing_ = ring;
+}
+
+size_t DbMeterApp::ingestSamples() {
+    size_t count = 0;
+    long long now = clock_->nowMs();
+    if (sampleRing_) {
+        DbSampleSummary summary;
+        MeterFeed consumer(summary, meter_, traceWriter_, now);
+        count = sampleRing_->drain(consumer);
+        if (count > 0) {
+            lastFrame_ = summary;
+        }
+    }
+    
+    // One SIMD pass over all channels with the real elapsed time
+    meter_.advance((now - lastStepMs_) / 1000.0);
+    lastStepMs_ = now;
+    history_.addLevel(meter_.getLevelDb(0), now);
+    
+    if (exposureLogger_) {
+        int channels = meter_.getChannelCount();
+        for (int c = 0; c < channels; c++) {
+            exposureLogger_->push(c, meter_.getLevelDb(c));
+        }
+    }
+    return count;
+}
+
+void DbMeterApp::setExposureLogger(ExposureLogger* logger) {
+    exposureLogger_ = logger;
+}
+
+void DbMeterApp::setTraceWriter(DbTraceWriter* writer) {
+    traceWriter_ = writer;
+}
+
+void DbMeterApp::setBlinkClock(Clock* clock) {
+    blinkClock_ = clock ? clock : clock_;
+}
+
+void DbMeterApp::setLevelMetrics(const LevelMetrics& metrics) {
+    metrics_ = metrics;
+    hasMetrics_ = true;
+}
+
+void DbMeterApp::setBeatState(const BeatState& beat) {
+    beat_ = beat;
+    hasBeat_ = true;
+}
+
+bool DbMeterApp::applyBeatPulse(long long nowMs, bool blinkState) {
+    long long sinceBeatMs = nowMs - beat_.lastBeatMs;
+    if (!hasBeat_ || sinceBeatMs > Config::BEAT_TIMEOUT_MS) {
+        display_->setBorderPulse(100);
+        return blinkState;
+    }
+    if (sinceBeatMs < 0) {
+        sinceBeatMs = 0;
+    }
+    
+    // Full color on the beat, fading toward the floor; the pulse replaces
+    // the blink so the two don't fight
+    double fade = std::exp(-(double)sinceBeatMs / Config::BEAT_PULSE_MS);
+    int floor = Config::BEAT_PULSE_FLOOR_PERCENT;
+    display_->setBorderPulse(floor + (int)((100 - floor) * fade + 0.5));
+    return true;
+}
+
+void DbMeterApp::nextPage() {
+    if (!hasMetrics_) {
+        return;
+    }
+    page_ = (page_ + 1) % PAGE_COUNT;
+    pageShownAtMs_ = clock_->nowMs();
+}
+
+void DbMeterApp::setTimeWeighting(LevelBallistics::Mode mode, bool alreadyApplied) {
+    meter_.setMode(mode);
+    meter_.setBypass(alreadyApplied);
+}
+
+void DbMeterApp::setChannelThresholds(int channel, const DbColorCalculator::Thresholds& thresholds) {
+    if (channel >= 0 && channel < MultiChannelMeter::MAX_CHANNELS) {
+        thresholds_[channel] = thresholds;
+    }
+}
+
+void DbMeterApp::updatePageRotation() {
+    if (!hasMetrics_) {
+        return;
+    }
+    
+    long long now = clock_->nowMs();
+    if (now - pageShownAtMs_ >= Config::DB_PAGE_INTERVAL_MS) {
+        nextPage();
+    }
+}
+
+int DbMeterApp::currentPageValue() {
+    char w = metrics_.weighting;
+    double value = meter_.getLevelDb(0);
+    
+    switch (hasMetrics_ ? page_ : PAGE_LIVE) {
+        case PAGE_LEQ_1M:
+            value = metrics_.leq1m;
+            snprintf(unitLabel_, sizeof(unitLabel_), "L%ceq1m", w);
+            break;
+        case PAGE_LEQ_15M:
+            value = metrics_.leq15m;
+            snprintf(unitLabel_, sizeof(unitLabel_), "L%ceq15m", w);
+            break;
+        case PAGE_LEQ_1H:
+            value = metrics_.leq1h;
+            snprintf(unitLabel_, sizeof(unitLabel_), "L%ceq1h", w);
+            break;
+        case PAGE_LMAX:
+            value = metrics_.lmax;
+            snprintf(unitLabel_, sizeof(unitLabel_), "L%c%cmax", w, metrics_.timeWeighting);
+            break;
+        case PAGE_LPEAK:
+            value = metrics_.lpeak;
+            snprintf(unitLabel_, sizeof(unitLabel_), "LCpk");
+            break;
+        default:
+            // Live level; weighted audio shows its weighting ("dBA")
+            if (hasMetrics_ && w != 'Z') {
+                snprintf(unitLabel_, sizeof(unitLabel_), "dB%c", w);
+            } else {
+                snprintf(unitLabel_, sizeof(unitLabel_), "dB");
+            }
+            break;
     }
+    
+    return roundDb(value);
 }
 
 void DbMeterApp::cleanup() {
@@ -86,6 +317,9 @@ void DbMeterApp::printStartupInfo() {
     std::cout << "\033[1;36m🎵 dB Meter Application - Audio Level Monitor\033[0m" << std::endl;
     std::cout << "\033[0;33m💡 Brightness:\033[0m " << brightnessLevel_ << "/10 (" << (brightnessLevel_ * 10) << "%)" << std::endl;
     std::cout << "\033[0;32m📊 Enter dB values (0-120) and press Enter:\033[0m" << std::endl;
+    if (hasMetrics_) {
+        std::cout << "\033[0;32m📈 'p' shows the next Leq/Lmax/Lpeak page, 'r' resets them\033[0m" << std::endl;
+    }
     std::cout << "\033[0;31m⚠️  Type 'back' to return to main menu\033[0m" << std::endl;
     std::cout << std::endl;
 }
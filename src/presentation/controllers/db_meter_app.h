@@ -5,20 +5,75 @@
 #include "infrastructure/input/input_handler.h"
 #include "shared/utils/blink_manager.h"
 #include "infrastructure/config/config.h"
+#include "shared/utils/db_sample.h"
+#include "shared/dsp/level_integrator.h"
+#include "shared/dsp/level_ballistics.h"
+#include "shared/dsp/multi_channel_meter.h"
+#include "shared/dsp/peak_hold.h"
+#include "shared/dsp/level_history.h"
+#include "shared/dsp/beat_tracker.h"
+#include "presentation/controllers/db_color_calculator.h"
+#include "infrastructure/storage/exposure_logger.h"
+#include "infrastructure/storage/db_trace.h"
+#include "shared/utils/clock.h"
 #include "led-matrix.h"
+#include <vector>
 #include <unistd.h>
 
 class DbMeterApp {
 public:
-    DbMeterApp(RGBMatrix* matrix, int brightnessLevel = Config::DEFAULT_BRIGHTNESS);
+    // All timing (ballistics, peak hold, pages, blinking) reads `clock`,
+    // the monotonic clock by default; replay passes a VirtualClock
+    DbMeterApp(RGBMatrix* matrix, int brightnessLevel = Config::DEFAULT_BRIGHTNESS, Clock* clock = nullptr);
     ~DbMeterApp();
     
     // Initialize the application
     bool initialize();
+    // Headless: render into `canvas` instead of the matrix (trace replay)
+    bool initialize(Canvas* canvas);
     
     // Update methods (called by main app)
     void update();
-    void updateValue(int newValue);
+    void updateValue(int newValue, int channel = 0);
+    
+    // High-rate sample feed (ring is owned by the main app). Each sample's
+    // channel selects its bar; with more than one channel the live page
+    // shows one bar per channel.
+    void setSampleRing(DbSampleRing* ring);
+    // Call once per frame, ring or not: drains the ring and advances the
+    // meter ballistics by the time since the last call
+    size_t ingestSamples();
+    const DbSampleSummary& getLastFrameSummary() const { return lastFrame_; }
+    
+    // Integrated levels from audio input. Once set, the display rotates
+    // through the live level and the Leq/Lmax/Lpeak pages.
+    void setLevelMetrics(const LevelMetrics& metrics);
+    void nextPage();
+    
+    // Latest beat from audio input (--beat-border), with its time on the
+    // app clock. While beats keep coming, the border flashes on each one
+    // and fades between them instead of blinking.
+    void setBeatState(const BeatState& beat);
+    
+    // Fast/Slow/Impulse time weighting of incoming readings (default Fast),
+    // stepped by elapsed monotonic time. Audio input weights each PCM sample
+    // in its capture thread, so its readings pass alreadyApplied = true.
+    void setTimeWeighting(LevelBallistics::Mode mode, bool alreadyApplied = false);
+    
+    // Per-second exposure logging of every channel's displayed level
+    // (logger is owned by the main app; pushes never block)
+    void setExposureLogger(ExposureLogger* logger);
+    
+    // Record every reading the meter receives as a dB trace (writer is
+    // owned by the main app)
+    void setTraceWriter(DbTraceWriter* writer);
+    
+    // Blink on another clock than the app's (a SyncClock, so the border
+    // blinks in step with other displays); call before initialize()
+    void setBlinkClock(Clock* clock);
+    
+    // Color thresholds for one channel (default 80/90/95 dB)
+    void setChannelThresholds(int channel, const DbColorCalculator::Thresholds& thresholds);
     
     // Cleanup resources
     void cleanup();
@@ -28,13 +83,55 @@ public:
     
 private:
     RGBMatrix* matrix_;
+    Clock* clock_;
+    Clock* blinkClock_;
     DbDisplay* display_;
     BlinkManager* blinkManager_;
     
-    int currentDbValue_;
     int brightnessLevel_;
     bool isRunning_;
     
+    // Sample ingestion
+    DbSampleRing* sampleRing_;
+    DbSampleSummary lastFrame_;
+    ExposureLogger* exposureLogger_;
+    DbTraceWriter* traceWriter_;
+    
+    // Channel levels (channel 0 alone is the classic single bar)
+    MultiChannelMeter meter_;
+    long long lastStepMs_;
+    std::vector<PeakHold> peakHolds_;
+    LevelHistory history_;  // Channel 0, for the scrolling graph
+    DbColorCalculator::Thresholds thresholds_[MultiChannelMeter::MAX_CHANNELS];
+    DbDisplay::ChannelLevel channelLevels_[MultiChannelMeter::MAX_CHANNELS];
+    
+    // Metric pages
+    enum Page {
+        PAGE_LIVE,
+        PAGE_LEQ_1M,
+        PAGE_LEQ_15M,
+        PAGE_LEQ_1H,
+        PAGE_LMAX,
+        PAGE_LPEAK,
+        PAGE_COUNT
+    };
+    bool hasMetrics_;
+    LevelMetrics metrics_;
+    int page_;
+    long long pageShownAtMs_;
+    char unitLabel_[16];
+    
+    // Beat pulse
+    bool hasBeat_;
+    BeatState beat_;
+    
+    // Helper methods
+    void start();
+    int currentPageValue();
+    void updatePageRotation();
+    void updateChannels(long long nowMs);
+    bool applyBeatPulse(long long nowMs, bool blinkState);
+    
     // Matrix configuration
     void printStartupInfo();
 };
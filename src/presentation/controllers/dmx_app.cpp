@@ -0,0 +1,97 @@
+#include "dmx_app.h"
+#include <iostream>
+
+DmxApp::DmxApp(RGBMatrix* matrix, int brightnessLevel)
+    : matrix_(matrix), display_(nullptr), receiver_(nullptr), protocol_(DmxProtocol::ART_NET),
+      brightnessLevel_(brightnessLevel), isRunning_(false) {
+}
+
+DmxApp::~DmxApp() {
+    cleanup();
+}
+
+void DmxApp::configure(DmxProtocol::Protocol protocol, const DmxRenderer::Layout& layout) {
+    protocol_ = protocol;
+    layout_ = layout;
+}
+
+bool DmxApp::initialize() {
+    if (!matrix_) {
+        std::cerr << "\033[0;31m❌ Matrix not provided\033[0m" << std::endl;
+        return false;
+    }
+    
+    // Switching back in reuses nothing from the last visit
+    cleanup();
+    display_ = new DmxDisplay(matrix_, layout_, brightnessLevel_);
+    receiver_ = new DmxReceiver(protocol_, DmxProtocol::defaultPort(protocol_), layout_.firstUniverse,
+                                display_->getUniverseCount());
+    if (!receiver_->start()) {
+        std::cerr << "\033[0;31m❌ " << receiver_->getLastError() << "\033[0m" << std::endl;
+        cleanup();
+        return false;
+    }
+    
+    isRunning_ = true;
+    printStartupInfo();
+    
+    return true;
+}
+
+void DmxApp::update() {
+    if (!isRunning_) {
+        return;
+    }
+    
+    // Draws and swaps inside the display as packets and frame ends come in
+    receiver_->poll(*display_);
+}
+
+void DmxApp::cleanup() {
+    if (isRunning_ && matrix_) {
+        matrix_->Clear();
+        // Don't delete matrix_ - it's managed by the main app
+    }
+    
+    if (receiver_) {
+        receiver_->stop();
+        delete receiver_;
+        receiver_ = nullptr;
+    }
+    if (display_) {
+        delete display_;
+        display_ = nullptr;
+    }
+    
+    isRunning_ = false;
+}
+
+void DmxApp::setBrightness(int brightnessLevel) {
+    if (brightnessLevel >= Config::MIN_BRIGHTNESS && brightnessLevel <= Config::MAX_BRIGHTNESS) {
+        brightnessLevel_ = brightnessLevel;
+        if (display_) {
+            display_->setBrightness(brightnessLevel);
+        }
+    }
+}
+
+void DmxApp::printReport(std::ostream& out) const {
+    if (receiver_) {
+        receiver_->printReport(out);
+    } else {
+        out << "\033[0;33m💡 Switch to the dmx app to receive DMX\033[0m" << std::endl;
+    }
+}
+
+void DmxApp::printStartupInfo() {
+    const char* protocolName = protocol_ == DmxProtocol::ART_NET ? "Art-Net" : "sACN (E1.31)";
+    int universes = display_->getUniverseCount();
+    std::cout << "\033[1;36m💡 DMX pixel mapping - " << protocolName << " on UDP port "
+              << DmxProtocol::defaultPort(protocol_) << "\033[0m" << std::endl;
+    std::cout << "\033[0;33m💡 Brightness:\033[0m " << brightnessLevel_ << "/10 (" << (brightnessLevel_ * 10) << "%)" << std::endl;
+    std::cout << "\033[0;32m🎛️  Universes " << layout_.firstUniverse << "-" << (layout_.firstUniverse + universes - 1)
+              << ", " << layout_.pixelsPerUniverse << " RGB pixels each" << (layout_.snake ? ", serpentine rows" : "")
+              << "\033[0m" << std::endl;
+    std::cout << "\033[0;31m⚠️  Type 'back' to return to main menu\033[0m" << std::endl;
+    std::cout << std::endl;
+}
@@ -0,0 +1,51 @@
+#ifndef DMX_APP_H
+#define DMX_APP_H
+
+#include "presentation/displays/dmx_display.h"
+#include "infrastructure/network/dmx_receiver.h"
+#include "infrastructure/network/dmx_protocol.h"
+#include "infrastructure/display/dmx_renderer.h"
+#include "infrastructure/config/config.h"
+#include "led-matrix.h"
+#include <ostream>
+
+// Shows the matrix as a DMX pixel fixture for a lighting desk (Art-Net or
+// sACN). The receiver only listens while the app is showing; update()
+// drains what arrived since the last frame and swaps in completed frames.
+class DmxApp {
+public:
+    DmxApp(RGBMatrix* matrix, int brightnessLevel = Config::DEFAULT_BRIGHTNESS);
+    ~DmxApp();
+    
+    // Protocol and universe layout (validated by the main app)
+    void configure(DmxProtocol::Protocol protocol, const DmxRenderer::Layout& layout);
+    
+    // Initialize the application (binds the UDP port)
+    bool initialize();
+    
+    // Update methods (called by main app)
+    void update();
+    
+    // Cleanup resources
+    void cleanup();
+    
+    // Configuration
+    void setBrightness(int brightnessLevel);
+    
+    // Packet and frame counts while the app is showing
+    void printReport(std::ostream& out) const;
+    
+private:
+    RGBMatrix* matrix_;
+    DmxDisplay* display_;
+    DmxReceiver* receiver_;
+    
+    DmxProtocol::Protocol protocol_;
+    DmxRenderer::Layout layout_;
+    int brightnessLevel_;
+    bool isRunning_;
+    
+    void printStartupInfo();
+};
+
+#endif // DMX_APP_H
@@ -0,0 +1,88 @@
+#include "spectrum_app.h"
+#include "shared/utils/monotonic_clock.h"
+#include <iostream>
+#include <cstring>
+
+SpectrumApp::SpectrumApp(RGBMatrix* matrix, int brightnessLevel)
+    : matrix_(matrix), display_(nullptr), audioSource_(nullptr),
+      brightnessLevel_(brightnessLevel), isRunning_(false) {
+    std::memset(columns_, 0, sizeof(columns_));
+}
+
+SpectrumApp::~SpectrumApp() {
+    cleanup();
+}
+
+void SpectrumApp::setAudioSource(AudioLevelSource* source) {
+    audioSource_ = source;
+}
+
+bool SpectrumApp::initialize() {
+    if (!matrix_) {
+        std::cerr << "\033[0;31m❌ Matrix not provided\033[0m" << std::endl;
+        return false;
+    }
+    if (!audioSource_) {
+        std::cerr << "\033[0;31m❌ The spectrum needs audio input (--audio <source>)\033[0m" << std::endl;
+        return false;
+    }
+    
+    // Switching back in reuses nothing from the last visit
+    cleanup();
+    display_ = new SpectrumDisplay(matrix_, brightnessLevel_);
+    
+    std::memset(columns_, 0, sizeof(columns_));
+    audioSource_->setSpectrumEnabled(true);
+    
+    isRunning_ = true;
+    printStartupInfo();
+    
+    return true;
+}
+
+void SpectrumApp::update() {
+    if (!isRunning_) {
+        return;
+    }
+    
+    // Redraw every frame so peak markers keep falling between spectra
+    audioSource_->getSpectrum(columns_);
+    display_->update(columns_, MonotonicClock::nowMs());
+}
+
+void SpectrumApp::cleanup() {
+    // The source may already be gone when the main app shuts down, but by
+    // then this app was cleaned up on leaving it
+    if (isRunning_) {
+        audioSource_->setSpectrumEnabled(false);
+        if (matrix_) {
+            matrix_->Clear();
+            // Don't delete matrix_ - it's managed by the main app
+        }
+    }
+    
+    if (display_) {
+        delete display_;
+        display_ = nullptr;
+    }
+    
+    isRunning_ = false;
+}
+
+void SpectrumApp::setBrightness(int brightnessLevel) {
+    if (brightnessLevel >= Config::MIN_BRIGHTNESS && brightnessLevel <= Config::MAX_BRIGHTNESS) {
+        brightnessLevel_ = brightnessLevel;
+        if (display_) {
+            display_->setBrightness(brightnessLevel);
+        }
+    }
+}
+
+void SpectrumApp::printStartupInfo() {
+    std::cout << "\033[1;36m📊 Spectrum Analyzer - " << Config::SPECTRUM_COLUMNS << " log-frequency bands\033[0m" << std::endl;
+    std::cout << "\033[0;33m💡 Brightness:\033[0m " << brightnessLevel_ << "/10 (" << (brightnessLevel_ * 10) << "%)" << std::endl;
+    std::cout << "\033[0;32m🎤 Bars show " << Config::SPECTRUM_FLOOR_DB << "-" << (Config::SPECTRUM_FLOOR_DB + Config::SPECTRUM_RANGE_DB)
+              << " dB per band, " << Config::SPECTRUM_RATE << " spectra/s\033[0m" << std::endl;
+    std::cout << "\033[0;31m⚠️  Type 'back' to return to main menu\033[0m" << std::endl;
+    std::cout << std::endl;
+}
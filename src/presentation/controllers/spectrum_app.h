@@ -0,0 +1,45 @@
+#ifndef SPECTRUM_APP_H
+#define SPECTRUM_APP_H
+
+#include "presentation/displays/spectrum_display.h"
+#include "infrastructure/audio/audio_level_source.h"
+#include "infrastructure/config/config.h"
+#include "led-matrix.h"
+
+// Spectrum analyzer on the audio input the dB meter uses (--audio). The
+// capture thread computes the spectra while this app is showing; update()
+// only copies the latest band levels and draws them.
+class SpectrumApp {
+public:
+    SpectrumApp(RGBMatrix* matrix, int brightnessLevel = Config::DEFAULT_BRIGHTNESS);
+    ~SpectrumApp();
+    
+    // Audio source is owned by the main app; without one initialize() fails
+    void setAudioSource(AudioLevelSource* source);
+    
+    // Initialize the application
+    bool initialize();
+    
+    // Update methods (called by main app)
+    void update();
+    
+    // Cleanup resources (also stops the spectrum work in the capture thread)
+    void cleanup();
+    
+    // Configuration
+    void setBrightness(int brightnessLevel);
+    
+private:
+    RGBMatrix* matrix_;
+    SpectrumDisplay* display_;
+    AudioLevelSource* audioSource_;
+    
+    int brightnessLevel_;
+    bool isRunning_;
+    
+    float columns_[Config::SPECTRUM_COLUMNS];
+    
+    void printStartupInfo();
+};
+
+#endif // SPECTRUM_APP_H
@@ -4,19 +4,27 @@
 #include <signal.h>
 #include <sstream>
 #include <iomanip>
+#include <ctime>
 
 using namespace rgb_matrix;
 
-SpotifyApp::SpotifyApp(RGBMatrix* matrix, int brightnessLevel) 
+SpotifyApp::SpotifyApp(RGBMatrix* matrix, int brightnessLevel, FetchScheduler* scheduler,
+                       TimeSeriesStore* statsStore) 
     : matrix_(matrix), display_(nullptr), 
       isRunning_(false), artistName_(""), popularity_(0), monthlyListeners_(0), 
       albumCount_(0), trackCount_(0), topTrack_(""), genres_(""),
       brightnessLevel_(brightnessLevel), spotifyAPI_(new SpotifyAPI()),
-      artistId_("6m4ysuZf9XxRhqeujYp5ti"), isLoading_(false), hasError_(false), rotatingText_(nullptr) {
+      artistId_("6m4ysuZf9XxRhqeujYp5ti"), isLoading_(false), hasError_(false), rotatingText_(nullptr),
+      scheduler_(scheduler), hasPendingResult_(false), hasPendingIcon_(false), hubClient_(nullptr),
+      artCache_(new AlbumArtCache(Config::ARTWORK_DIRECTORY, Config::ARTWORK_ICON_SIZE, Config::ARTWORK_COLOR_BITS)),
+      statsStore_(statsStore),
+      hasPopularityTrend_(false), popularityTrend_(0) {
 }
 
 SpotifyApp::~SpotifyApp() {
     cleanup();
+    delete spotifyAPI_;
+    delete artCache_;
 }
 
 bool SpotifyApp::initialize() {
@@ -24,8 +32,8 @@ bool SpotifyApp::initialize() {
     display_ = new SpotifyDisplay(matrix_, brightnessLevel_);
     rotatingText_ = new RotatingText();
     
-    // Check if API is configured
-    if (!spotifyAPI_->isConfigured()) {
+    // Check if API is configured (the hub holds the credentials in hub client mode)
+    if (!hubClient_ && !spotifyAPI_->isConfigured()) {
         setErrorState("API credentials not configured");
         std::cerr << "Spotify API not configured. Set SPOTIFY_CLIENT_ID and SPOTIFY_CLIENT_SECRET environment variables." << std::endl;
     } else {
@@ -49,6 +57,9 @@ void SpotifyApp::update() {
         return;
     }
     
+    // Pick up any result delivered by the background scheduler
+    deliverPendingResult();
+    
     // Update rotating text
     rotatingText_->update();
     
@@ -62,6 +73,9 @@ void SpotifyApp::updateValue(int newValue) {
 }
 
 void SpotifyApp::cleanup() {
+    // Stop background fetches; the app can be started again later
+    unregisterSource();
+    
     if (display_) {
         delete display_;
         display_ = nullptr;
@@ -72,11 +86,6 @@ void SpotifyApp::cleanup() {
         rotatingText_ = nullptr;
     }
     
-    if (spotifyAPI_) {
-        delete spotifyAPI_;
-        spotifyAPI_ = nullptr;
-    }
-    
     isRunning_ = false;
 }
 
@@ -115,23 +124,195 @@ void SpotifyApp::refreshData() {
         return;
     }
     
+    if (hubClient_) {
+        // The hub fetches; repeated requests coalesce there across the fleet
+        registerSource();
+        hubClient_->requestRefresh(sourceKey_);
+        setLoadingState();
+        return;
+    }
+    
     if (!spotifyAPI_->isConfigured()) {
         setErrorState("API credentials not configured");
         return;
     }
     
-    setLoadingState();
+    if (!scheduler_) {
+        // No scheduler - fetch synchronously
+        setLoadingState();
+        std::cout << "🔍 Fetching data for artist ID: " << artistId_ << std::endl;
+        SpotifyArtistStats stats = spotifyAPI_->getArtistStats(artistId_);
+        RgbImage icon = loadArtwork(stats);
+        applyStats(stats);
+        if (display_ && !icon.empty()) {
+            display_->setIcon(icon);
+        }
+        return;
+    }
     
-    // Make API call
-    std::cout << "🔍 Fetching data for artist ID: " << artistId_ << std::endl;
-    SpotifyArtistStats stats = spotifyAPI_->getArtistStats(artistId_);
+    // Queue a user-priority fetch; repeated requests join the one in flight
+    registerSource();
+    if (scheduler_->requestRefresh(sourceKey_, FetchScheduler::PRIORITY_USER)) {
+        setLoadingState();
+    } else {
+        std::cout << "⏳ Refresh already in progress..." << std::endl;
+    }
+}
+
+void SpotifyApp::registerSource() {
+    std::string key = "spotify:" + artistId_;
+    
+    if (hubClient_) {
+        if (key == sourceKey_) return;
+        
+        unregisterSource();
+        sourceKey_ = key;
+        
+        // Artwork is still fetched locally (CDN, not API quota), on the
+        // scheduler like any other fetch of this app
+        if (scheduler_) {
+            artworkKey_ = "spotify-art:" + artistId_;
+            scheduler_->addSource(artworkKey_, 0, 0, [this]() { loadHubArtwork(); });
+        }
+        
+        // Updates arrive on the hub client thread, which must not block:
+        // the stats go through the mailbox and the artwork load is queued
+        hubClient_->subscribeSpotify(artistId_, [this](const SpotifyArtistStats& stats) {
+            {
+                std::lock_guard<std::mutex> lock(resultMutex_);
+                pendingStats_ = stats;
+                hasPendingResult_ = true;
+                artworkStats_ = stats;
+            }
+            if (scheduler_ && stats.isValid && !stats.imageUrl.empty()) {
+                scheduler_->requestRefresh(artworkKey_, FetchScheduler::PRIORITY_USER);
+            }
+        });
+        return;
+    }
+    
+    if (!scheduler_) return;
     
+    if (key == sourceKey_ && scheduler_->hasSource(key)) {
+        return;
+    }
+    
+    unregisterSource();
+    sourceKey_ = key;
+    
+    // The job runs on the scheduler thread and only touches the mailbox
+    std::string artistId = artistId_;
+    scheduler_->addSource(sourceKey_, Config::SPOTIFY_REFRESH_INTERVAL_MS, Config::REFRESH_JITTER_MS,
+                          [this, artistId]() {
+        std::cout << "🔍 Fetching data for artist ID: " << artistId << std::endl;
+        SpotifyArtistStats stats = spotifyAPI_->getArtistStats(artistId);
+        RgbImage icon = loadArtwork(stats);
+        
+        std::lock_guard<std::mutex> lock(resultMutex_);
+        pendingStats_ = stats;
+        hasPendingResult_ = true;
+        pendingIcon_ = icon;
+        hasPendingIcon_ = true;
+    });
+}
+
+void SpotifyApp::setHubClient(StatsHubClient* hubClient) {
+    hubClient_ = hubClient;
+}
+
+void SpotifyApp::unregisterSource() {
+    if (sourceKey_.empty()) return;
+    
+    if (hubClient_) {
+        hubClient_->unsubscribe(sourceKey_);
+        if (!artworkKey_.empty()) {
+            scheduler_->removeSource(artworkKey_);
+            artworkKey_.clear();
+        }
+    } else if (scheduler_) {
+        scheduler_->removeSource(sourceKey_);
+    } else {
+        return;
+    }
+    sourceKey_.clear();
+    
+    // Drop any result that belongs to the old source
+    std::lock_guard<std::mutex> lock(resultMutex_);
+    hasPendingResult_ = false;
+    hasPendingIcon_ = false;
+}
+
+void SpotifyApp::deliverPendingResult() {
+    SpotifyArtistStats stats;
+    RgbImage icon;
+    bool hasStats;
+    bool hasIcon;
+    {
+        std::lock_guard<std::mutex> lock(resultMutex_);
+        hasStats = hasPendingResult_;
+        hasIcon = hasPendingIcon_;
+        if (hasStats) stats = pendingStats_;
+        if (hasIcon) icon = pendingIcon_;
+        hasPendingResult_ = false;
+        hasPendingIcon_ = false;
+    }
+    
+    // Hub mode without a scheduler: nowhere to queue the artwork, so load
+    // it here like the synchronous fetch does
+    if (hasStats && hubClient_ && !scheduler_) {
+        icon = loadArtwork(stats);
+        hasIcon = true;
+    }
+    
+    if (hasStats) {
+        applyStats(stats);
+    }
+    if (hasIcon && display_ && !icon.empty()) {
+        display_->setIcon(icon);
+    }
+}
+
+void SpotifyApp::loadHubArtwork() {
+    // Scheduler thread. A hub update that arrives while this runs is
+    // coalesced into it, so go again if the image changed meanwhile
+    SpotifyArtistStats stats;
+    {
+        std::lock_guard<std::mutex> lock(resultMutex_);
+        stats = artworkStats_;
+    }
+    
+    for (;;) {
+        RgbImage icon = loadArtwork(stats);
+        
+        std::lock_guard<std::mutex> lock(resultMutex_);
+        if (artworkStats_.imageUrl == stats.imageUrl) {
+            pendingIcon_ = icon;
+            hasPendingIcon_ = true;
+            return;
+        }
+        stats = artworkStats_;
+    }
+}
+
+RgbImage SpotifyApp::loadArtwork(const SpotifyArtistStats& stats) {
+    // Only downloads and decodes the first time a URL is seen
+    RgbImage icon;
+    if (stats.isValid && !stats.imageUrl.empty() && !artCache_->getIcon(stats.imageUrl, icon)) {
+        std::cerr << "⚠️  Artwork unavailable: " << artCache_->getLastError() << std::endl;
+    }
+    return icon;
+}
+
+void SpotifyApp::applyStats(const SpotifyArtistStats& stats) {
     if (stats.isValid) {
         setDataState(stats);
         std::cout << "✅ Data refreshed successfully!" << std::endl;
-    } else {
+    } else if (isLoading_ || hasError_) {
         setErrorState(stats.errorMessage);
         std::cerr << "❌ Error refreshing data: " << stats.errorMessage << std::endl;
+    } else {
+        // Background poll failed - keep showing the last good data
+        std::cerr << "⚠️  Background refresh failed: " << stats.errorMessage << std::endl;
     }
 }
 
@@ -189,6 +370,10 @@ void SpotifyApp::updateRotatingText() {
         if (popularity_ > 0) {
             rotatingText_->addText("Popularity: " + std::to_string(popularity_));
         }
+        if (hasPopularityTrend_ && popularityTrend_ != 0) {
+            std::string sign = popularityTrend_ > 0 ? "+" : "";
+            rotatingText_->addText("Pop " + sign + std::to_string(popularityTrend_) + " 24h");
+        }
         if (albumCount_ > 0) {
             rotatingText_->addText(std::to_string(albumCount_) + " Albums");
         }
@@ -229,10 +414,26 @@ void SpotifyApp::setDataState(const SpotifyArtistStats& stats) {
     trackCount_ = stats.trackCount;
     topTrack_ = stats.topTrack;
     genres_ = stats.genres;
+    recordStats(stats);
     
     updateRotatingText();
 }
 
+void SpotifyApp::recordStats(const SpotifyArtistStats& stats) {
+    if (!statsStore_ || stats.artistId.empty()) return;
+    
+    // Keep the history and refresh the 24h trend shown in the rotation.
+    // Keyed by the artist the stats were fetched for, not artistId_: that
+    // changes with every keystroke while a fetch may still be arriving.
+    std::string prefix = "spotify." + stats.artistId + ".";
+    long long now = (long long)time(nullptr);
+    statsStore_->append(prefix + "popularity", now, stats.popularity);
+    statsStore_->append(prefix + "albums", now, stats.albumCount);
+    statsStore_->append(prefix + "tracks", now, stats.trackCount);
+    
+    hasPopularityTrend_ = statsStore_->getChange(prefix + "popularity", Config::TREND_WINDOW_SECONDS, popularityTrend_);
+}
+
 std::string SpotifyApp::formatNumber(int number) const {
     if (number >= 1000000) {
         return std::to_string(number / 1000000) + "M";
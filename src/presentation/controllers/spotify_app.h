@@ -5,11 +5,17 @@
 #include "infrastructure/input/input_handler.h"
 #include "shared/utils/rotating_text.h"
 #include "infrastructure/network/spotify_api.h"
+#include "shared/network/fetch_scheduler.h"
+#include "infrastructure/storage/timeseries_store.h"
+#include "infrastructure/image/album_art_cache.h"
+#include "infrastructure/network/stats_hub_client.h"
 #include <string>
+#include <mutex>
 
 class SpotifyApp {
 public:
-    SpotifyApp(RGBMatrix* matrix, int brightnessLevel = 5);
+    SpotifyApp(RGBMatrix* matrix, int brightnessLevel = 5, FetchScheduler* scheduler = nullptr,
+               TimeSeriesStore* statsStore = nullptr);
     ~SpotifyApp();
     
     // Application lifecycle
@@ -27,6 +33,10 @@ public:
     void refreshData();
     void handleKeyboardInput(char key);
     
+    // Optional hub client mode: stats come from a StatsHubServer instead of
+    // the API (client is owned by the main app)
+    void setHubClient(StatsHubClient* hubClient);
+    
 private:
     // Components
     RGBMatrix* matrix_;
@@ -53,12 +63,42 @@ private:
     // Components
     RotatingText* rotatingText_;
     
+    // Background fetching (scheduler is owned by the main app)
+    FetchScheduler* scheduler_;
+    std::string sourceKey_;
+    std::mutex resultMutex_;
+    bool hasPendingResult_;
+    SpotifyArtistStats pendingStats_;
+    bool hasPendingIcon_;
+    RgbImage pendingIcon_;
+    StatsHubClient* hubClient_;
+    
+    // Hub mode: artwork for hub results is loaded by a scheduler job, not on
+    // the hub client thread
+    std::string artworkKey_;
+    SpotifyArtistStats artworkStats_;  // Newest hub result, under resultMutex_
+    
+    // Artwork icons, decoded once per image URL
+    AlbumArtCache* artCache_;
+    
+    // Metric history (store is owned by the main app)
+    TimeSeriesStore* statsStore_;
+    bool hasPopularityTrend_;
+    long long popularityTrend_;
+    
     // Helper methods
+    void registerSource();
+    void unregisterSource();
+    void deliverPendingResult();
+    void applyStats(const SpotifyArtistStats& stats);
+    RgbImage loadArtwork(const SpotifyArtistStats& stats);
+    void loadHubArtwork();
     void setupMatrixOptions(RGBMatrix::Options& options, RuntimeOptions& runtimeOpt);
     void updateRotatingText();
     void setLoadingState();
     void setErrorState(const std::string& error);
     void setDataState(const SpotifyArtistStats& stats);
+    void recordStats(const SpotifyArtistStats& stats);
     std::string formatNumber(int number) const;
 };
 
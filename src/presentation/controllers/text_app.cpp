@@ -0,0 +1,119 @@
+#include "text_app.h"
+#include <iostream>
+#include <cstring>
+
+namespace {
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+} // namespace
+
+TextApp::TextApp(RGBMatrix* matrix, int brightnessLevel, Clock* clock)
+    : matrix_(matrix), display_(nullptr), rotatingText_(new RotatingText(clock)),
+      brightnessLevel_(brightnessLevel), isRunning_(false) {
+    rotatingText_->setRotationInterval(Config::TEXT_ROTATION_MS);
+}
+
+TextApp::~TextApp() {
+    cleanup();
+    delete rotatingText_;
+}
+
+void TextApp::setText(const char* topic, size_t topicSize, const char* text, size_t textSize) {
+    while (textSize > 0 && isSpace(text[0])) {
+        text++;
+        textSize--;
+    }
+    while (textSize > 0 && isSpace(text[textSize - 1])) {
+        textSize--;
+    }
+    if (textSize > (size_t)Config::TEXT_MAX_LENGTH) {
+        textSize = Config::TEXT_MAX_LENGTH;
+    }
+    
+    for (size_t i = 0; i < topics_.size(); i++) {
+        if (topics_[i].size() == topicSize && std::memcmp(topics_[i].data(), topic, topicSize) == 0) {
+            rotatingText_->setText(i, text, textSize);
+            return;
+        }
+    }
+    
+    if (topics_.size() >= (size_t)Config::TEXT_TOPICS) {
+        return;
+    }
+    topics_.push_back(std::string(topic, topicSize));
+    rotatingText_->addText(std::string(text, textSize));
+    
+    if (isRunning_ && !rotatingText_->isEnabled()) {
+        rotatingText_->start();
+    }
+}
+
+bool TextApp::initialize() {
+    if (!matrix_) {
+        std::cerr << "\033[0;31m❌ Matrix not provided\033[0m" << std::endl;
+        return false;
+    }
+    
+    // Switching back in reuses nothing from the last visit
+    cleanup();
+    display_ = new TextDisplay(matrix_, brightnessLevel_);
+    rotatingText_->reset();
+    rotatingText_->start();
+    
+    isRunning_ = true;
+    printStartupInfo();
+    
+    return true;
+}
+
+void TextApp::update() {
+    if (!isRunning_) {
+        return;
+    }
+    
+    rotatingText_->update();
+    display_->update(rotatingText_->hasTexts() ? rotatingText_->getCurrentText() : "--");
+}
+
+void TextApp::cleanup() {
+    if (isRunning_ && matrix_) {
+        matrix_->Clear();
+        // Don't delete matrix_ - it's managed by the main app
+    }
+    
+    if (display_) {
+        delete display_;
+        display_ = nullptr;
+    }
+    
+    rotatingText_->stop();
+    isRunning_ = false;
+}
+
+void TextApp::setBrightness(int brightnessLevel) {
+    if (brightnessLevel >= Config::MIN_BRIGHTNESS && brightnessLevel <= Config::MAX_BRIGHTNESS) {
+        brightnessLevel_ = brightnessLevel;
+        if (display_) {
+            display_->setBrightness(brightnessLevel);
+        }
+    }
+}
+
+void TextApp::printStartupInfo() {
+    std::cout << "\033[1;36m💬 Text from MQTT and the data file - one topic every " << Config::TEXT_ROTATION_MS / 1000 << " s\033[0m" << std::endl;
+    std::cout << "\033[0;33m💡 Brightness:\033[0m " << brightnessLevel_ << "/10 (" << (brightnessLevel_ * 10) << "%)" << std::endl;
+    if (topics_.empty()) {
+        std::cout << "\033[0;33m⏳ No text received yet (use --mqtt-text <topics> or --data-file <file>)\033[0m" << std::endl;
+    } else {
+        std::cout << "\033[0;32m📋 " << topics_.size() << " topics:\033[0m";
+        for (size_t i = 0; i < topics_.size(); i++) {
+            std::cout << " " << topics_[i];
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "\033[0;31m⚠️  Type 'back' to return to main menu\033[0m" << std::endl;
+    std::cout << std::endl;
+}
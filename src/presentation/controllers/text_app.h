@@ -0,0 +1,52 @@
+#ifndef TEXT_APP_H
+#define TEXT_APP_H
+
+#include "presentation/displays/text_display.h"
+#include "shared/utils/rotating_text.h"
+#include "infrastructure/config/config.h"
+#include "led-matrix.h"
+#include <string>
+#include <vector>
+
+// Shows the latest text published on each --mqtt-text topic or written under
+// each --data-file key, one at a time. Texts arrive whether or not the app
+// is showing. The first Config::TEXT_TOPICS topics each get a slot; later
+// ones are ignored.
+class TextApp {
+public:
+    // Texts rotate on `clock`, the monotonic clock by default; a SyncClock
+    // keeps the rotation in step with other displays
+    TextApp(RGBMatrix* matrix, int brightnessLevel = Config::DEFAULT_BRIGHTNESS, Clock* clock = nullptr);
+    ~TextApp();
+    
+    // Latest text for a topic (surrounding whitespace trimmed). Reuses the
+    // topic's slot, so it only allocates when a text outgrows the longest
+    // one so far.
+    void setText(const char* topic, size_t topicSize, const char* text, size_t textSize);
+    
+    // Initialize the application
+    bool initialize();
+    
+    // Update methods (called by main app)
+    void update();
+    
+    // Cleanup resources
+    void cleanup();
+    
+    // Configuration
+    void setBrightness(int brightnessLevel);
+    
+private:
+    RGBMatrix* matrix_;
+    TextDisplay* display_;
+    RotatingText* rotatingText_;
+    
+    int brightnessLevel_;
+    bool isRunning_;
+    
+    std::vector<std::string> topics_;   // Slot order is rotation order
+    
+    void printStartupInfo();
+};
+
+#endif // TEXT_APP_H
@@ -4,18 +4,24 @@
 #include <signal.h>
 #include <sstream>
 #include <iomanip>
+#include <ctime>
 
 using namespace rgb_matrix;
 
-YoutubeApp::YoutubeApp(RGBMatrix* matrix, int brightnessLevel) 
+YoutubeApp::YoutubeApp(RGBMatrix* matrix, int brightnessLevel, FetchScheduler* scheduler,
+                       TimeSeriesStore* statsStore) 
     : matrix_(matrix), display_(nullptr), 
       isRunning_(false), currentSubscriberCount_(0), currentViewCount_(0), currentVideoCount_(0),
       brightnessLevel_(brightnessLevel), youtubeAPI_(new YouTubeAPI()),
-      channelId_("@being_jay_thakur"), isLoading_(false), hasError_(false), rotatingText_(nullptr) {
+      channelId_("@being_jay_thakur"), isLoading_(false), hasError_(false), rotatingText_(nullptr),
+      scheduler_(scheduler), hasPendingResult_(false), pushReceiver_(nullptr), hubClient_(nullptr),
+      statsStore_(statsStore),
+      hasSubscriberTrend_(false), subscriberTrend_(0), hasViewTrend_(false), viewTrend_(0) {
 }
 
 YoutubeApp::~YoutubeApp() {
     cleanup();
+    delete youtubeAPI_;
 }
 
 bool YoutubeApp::initialize() {
@@ -23,8 +29,8 @@ bool YoutubeApp::initialize() {
     display_ = new YoutubeDisplay(matrix_, brightnessLevel_);
     rotatingText_ = new RotatingText();
     
-    // Check if API is configured
-    if (!youtubeAPI_->isConfigured()) {
+    // Check if API is configured (the hub holds the key in hub client mode)
+    if (!hubClient_ && !youtubeAPI_->isConfigured()) {
         setErrorState("API key not configured");
         std::cerr << "YouTube API not configured. Set YOUTUBE_API_KEY environment variable." << std::endl;
     } else {
@@ -48,6 +54,9 @@ void YoutubeApp::update() {
         return;
     }
     
+    // Pick up any result delivered by the background scheduler
+    deliverPendingResult();
+    
     // Update rotating text
     rotatingText_->update();
     
@@ -61,6 +70,9 @@ void YoutubeApp::updateValue(int newValue) {
 }
 
 void YoutubeApp::cleanup() {
+    // Stop background fetches; the app can be started again later
+    unregisterSource();
+    
     if (display_) {
         delete display_;
         display_ = nullptr;
@@ -71,11 +83,6 @@ void YoutubeApp::cleanup() {
         rotatingText_ = nullptr;
     }
     
-    if (youtubeAPI_) {
-        delete youtubeAPI_;
-        youtubeAPI_ = nullptr;
-    }
-    
     isRunning_ = false;
 }
 
@@ -114,34 +121,165 @@ void YoutubeApp::refreshData() {
         return;
     }
     
+    if (hubClient_) {
+        // The hub fetches; repeated requests coalesce there across the fleet
+        registerSource();
+        hubClient_->requestRefresh(sourceKey_);
+        setLoadingState();
+        return;
+    }
+    
     if (!youtubeAPI_->isConfigured()) {
         setErrorState("API key not configured");
         return;
     }
     
-    setLoadingState();
+    if (!scheduler_) {
+        // No scheduler - fetch synchronously
+        setLoadingState();
+        applyStats(fetchStats(channelId_));
+        return;
+    }
     
-    // Make API call - check if it's a username (starts with @) or channel ID
+    // Queue a user-priority fetch; repeated requests join the one in flight
+    registerSource();
+    if (scheduler_->requestRefresh(sourceKey_, FetchScheduler::PRIORITY_USER)) {
+        setLoadingState();
+    } else {
+        std::cout << "⏳ Refresh already in progress..." << std::endl;
+    }
+}
+
+void YoutubeApp::registerSource() {
+    std::string key = "youtube:" + channelId_;
+    
+    if (hubClient_) {
+        if (key == sourceKey_) return;
+        
+        unregisterSource();
+        sourceKey_ = key;
+        
+        // Updates arrive on the hub client thread and go through the mailbox
+        hubClient_->subscribeYouTube(channelId_, [this](const YouTubeChannelStats& stats) {
+            std::lock_guard<std::mutex> lock(resultMutex_);
+            pendingStats_ = stats;
+            hasPendingResult_ = true;
+        });
+        return;
+    }
+    
+    if (!scheduler_) return;
+    
+    if (key == sourceKey_ && scheduler_->hasSource(key)) {
+        return;
+    }
+    
+    unregisterSource();
+    sourceKey_ = key;
+    
+    // The job runs on the scheduler thread and only touches the mailbox
+    std::string channelId = channelId_;
+    std::string sourceKey = sourceKey_;
+    scheduler_->addSource(sourceKey_, Config::YOUTUBE_REFRESH_INTERVAL_MS, Config::REFRESH_JITTER_MS,
+                          [this, channelId, sourceKey]() {
+        YouTubeChannelStats stats = fetchStats(channelId);
+        if (stats.isValid) {
+            updatePushSubscription(sourceKey, stats.channelId);
+        }
+        
+        std::lock_guard<std::mutex> lock(resultMutex_);
+        pendingStats_ = stats;
+        hasPendingResult_ = true;
+    });
+}
+
+void YoutubeApp::setPushReceiver(WebSubReceiver* receiver) {
+    pushReceiver_ = receiver;
+}
+
+void YoutubeApp::updatePushSubscription(const std::string& sourceKey, const std::string& channelId) {
+    // Runs on the scheduler thread, so the blocking hub request is fine here
+    if (!pushReceiver_ || channelId.empty()) return;
+    
+    if (pushReceiver_->needsRenewal(channelId)) {
+        FetchScheduler* scheduler = scheduler_;
+        pushReceiver_->subscribe(channelId, [scheduler, sourceKey](const std::string&) {
+            // New upload - targeted refresh of just this channel
+            scheduler->requestRefresh(sourceKey, FetchScheduler::PRIORITY_BACKGROUND);
+        });
+    }
+    
+    // Once the hub has verified us, polling is only a long-interval fallback
+    if (pushReceiver_->isVerified(channelId)) {
+        scheduler_->setInterval(sourceKey, Config::YOUTUBE_PUSH_FALLBACK_INTERVAL_MS, Config::REFRESH_JITTER_MS);
+    } else {
+        scheduler_->setInterval(sourceKey, Config::YOUTUBE_REFRESH_INTERVAL_MS, Config::REFRESH_JITTER_MS);
+    }
+}
+
+void YoutubeApp::setHubClient(StatsHubClient* hubClient) {
+    hubClient_ = hubClient;
+}
+
+void YoutubeApp::unregisterSource() {
+    if (sourceKey_.empty()) return;
+    
+    if (hubClient_) {
+        hubClient_->unsubscribe(sourceKey_);
+    } else if (scheduler_) {
+        scheduler_->removeSource(sourceKey_);
+    } else {
+        return;
+    }
+    sourceKey_.clear();
+    
+    // Drop any result that belongs to the old source
+    std::lock_guard<std::mutex> lock(resultMutex_);
+    hasPendingResult_ = false;
+}
+
+YouTubeChannelStats YoutubeApp::fetchStats(const std::string& channelId) {
+    // Check if it's a username (starts with @) or channel ID
     YouTubeChannelStats stats;
-    if (channelId_.empty()) {
+    if (channelId.empty()) {
         stats.errorMessage = "No channel ID set";
-    } else if (channelId_[0] == '@') {
+    } else if (channelId[0] == '@') {
         // It's a username, remove the @ and use getChannelStatsByUsername
-        std::string username = channelId_.substr(1); // Remove the @
+        std::string username = channelId.substr(1); // Remove the @
         std::cout << "🔍 Looking up username: " << username << std::endl;
         stats = youtubeAPI_->getChannelStatsByUsername(username);
     } else {
         // It's a channel ID, use getChannelStats
-        std::cout << "🔍 Looking up channel ID: " << channelId_ << std::endl;
-        stats = youtubeAPI_->getChannelStats(channelId_);
+        std::cout << "🔍 Looking up channel ID: " << channelId << std::endl;
+        stats = youtubeAPI_->getChannelStats(channelId);
+    }
+    return stats;
+}
+
+void YoutubeApp::deliverPendingResult() {
+    YouTubeChannelStats stats;
+    {
+        std::lock_guard<std::mutex> lock(resultMutex_);
+        if (!hasPendingResult_) {
+            return;
+        }
+        stats = pendingStats_;
+        hasPendingResult_ = false;
     }
     
+    applyStats(stats);
+}
+
+void YoutubeApp::applyStats(const YouTubeChannelStats& stats) {
     if (stats.isValid) {
         setDataState(stats);
         std::cout << "✅ Data refreshed successfully!" << std::endl;
-    } else {
+    } else if (isLoading_ || hasError_) {
         setErrorState(stats.errorMessage);
         std::cerr << "❌ Error refreshing data: " << stats.errorMessage << std::endl;
+    } else {
+        // Background poll failed - keep showing the last good data
+        std::cerr << "⚠️  Background refresh failed: " << stats.errorMessage << std::endl;
     }
 }
 
@@ -194,7 +332,13 @@ void YoutubeApp::updateRotatingText() {
     } else {
         // Add formatted data
         rotatingText_->addText(formatNumber(currentSubscriberCount_) + " Subs");
+        if (hasSubscriberTrend_) {
+            rotatingText_->addText(formatChange(subscriberTrend_) + " Subs 24h");
+        }
         rotatingText_->addText(formatNumber(currentViewCount_) + " Views");
+        if (hasViewTrend_) {
+            rotatingText_->addText(formatChange(viewTrend_) + " Views 24h");
+        }
         rotatingText_->addText(formatNumber(currentVideoCount_) + " Videos");
     }
     
@@ -223,10 +367,27 @@ void YoutubeApp::setDataState(const YouTubeChannelStats& stats) {
     currentSubscriberCount_ = stats.subscriberCount;
     currentViewCount_ = stats.viewCount;
     currentVideoCount_ = stats.videoCount;
+    recordStats(stats);
     
     updateRotatingText();
 }
 
+void YoutubeApp::recordStats(const YouTubeChannelStats& stats) {
+    if (!statsStore_ || stats.channelId.empty()) return;
+    
+    // Keep the history and refresh the 24h trends shown in the rotation.
+    // Keyed by the resolved channel, not channelId_: that changes with every
+    // keystroke while a fetch for the previous ID may still be arriving.
+    std::string prefix = "youtube." + stats.channelId + ".";
+    long long now = (long long)time(nullptr);
+    statsStore_->append(prefix + "subscribers", now, stats.subscriberCount);
+    statsStore_->append(prefix + "views", now, stats.viewCount);
+    statsStore_->append(prefix + "videos", now, stats.videoCount);
+    
+    hasSubscriberTrend_ = statsStore_->getChange(prefix + "subscribers", Config::TREND_WINDOW_SECONDS, subscriberTrend_);
+    hasViewTrend_ = statsStore_->getChange(prefix + "views", Config::TREND_WINDOW_SECONDS, viewTrend_);
+}
+
 std::string YoutubeApp::formatNumber(long number) const {
     if (number >= 1000000000) {
         return std::to_string(number / 1000000000) + "B";
@@ -238,3 +399,8 @@ std::string YoutubeApp::formatNumber(long number) const {
         return std::to_string(number);
     }
 }
+
+std::string YoutubeApp::formatChange(long long change) const {
+    std::string sign = change < 0 ? "-" : "+";
+    return sign + formatNumber((long)(change < 0 ? -change : change));
+}
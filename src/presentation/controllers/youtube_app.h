@@ -5,11 +5,17 @@
 #include "infrastructure/input/input_handler.h"
 #include "shared/utils/rotating_text.h"
 #include "infrastructure/network/youtube_api.h"
+#include "shared/network/fetch_scheduler.h"
+#include "infrastructure/storage/timeseries_store.h"
+#include "infrastructure/network/websub_receiver.h"
+#include "infrastructure/network/stats_hub_client.h"
 #include <string>
+#include <mutex>
 
 class YoutubeApp {
 public:
-    YoutubeApp(RGBMatrix* matrix, int brightnessLevel = 5);
+    YoutubeApp(RGBMatrix* matrix, int brightnessLevel = 5, FetchScheduler* scheduler = nullptr,
+               TimeSeriesStore* statsStore = nullptr);
     ~YoutubeApp();
     
     // Application lifecycle
@@ -27,6 +33,13 @@ public:
     void refreshData();
     void handleKeyboardInput(char key);
     
+    // Optional WebSub push mode (receiver is owned by the main app)
+    void setPushReceiver(WebSubReceiver* receiver);
+    
+    // Optional hub client mode: stats come from a StatsHubServer instead of
+    // the API (client is owned by the main app)
+    void setHubClient(StatsHubClient* hubClient);
+    
 private:
     // Components
     RGBMatrix* matrix_;
@@ -49,13 +62,38 @@ private:
     // Components
     RotatingText* rotatingText_;
     
+    // Background fetching (scheduler is owned by the main app)
+    FetchScheduler* scheduler_;
+    std::string sourceKey_;
+    std::mutex resultMutex_;
+    bool hasPendingResult_;
+    YouTubeChannelStats pendingStats_;
+    
+    WebSubReceiver* pushReceiver_;
+    StatsHubClient* hubClient_;
+    
+    // Metric history (store is owned by the main app)
+    TimeSeriesStore* statsStore_;
+    bool hasSubscriberTrend_;
+    long long subscriberTrend_;
+    bool hasViewTrend_;
+    long long viewTrend_;
+    
     // Helper methods
+    void registerSource();
+    void unregisterSource();
+    YouTubeChannelStats fetchStats(const std::string& channelId);
+    void updatePushSubscription(const std::string& sourceKey, const std::string& channelId);
+    void deliverPendingResult();
+    void applyStats(const YouTubeChannelStats& stats);
     void setupMatrixOptions(RGBMatrix::Options& options, RuntimeOptions& runtimeOpt);
     void updateRotatingText();
     void setLoadingState();
     void setErrorState(const std::string& error);
     void setDataState(const YouTubeChannelStats& stats);
+    void recordStats(const YouTubeChannelStats& stats);
     std::string formatNumber(long number) const;
+    std::string formatChange(long long change) const;
 };
 
 #endif // YOUTUBE_APP_H
@@ -0,0 +1,74 @@
+#include "animation_display.h"
+
+AnimationDisplay::AnimationDisplay(RGBMatrix* matrix, int brightnessLevel)
+    : matrix_(matrix), animation_(nullptr), preloaded_(0), visible_(nullptr), brightnessLevel_(brightnessLevel) {
+    spare_[0] = matrix_->CreateFrameCanvas();
+    spare_[1] = matrix_->CreateFrameCanvas();
+    updateScale();
+}
+
+AnimationDisplay::~AnimationDisplay() {
+    // FrameCanvases are managed by the matrix, no need to delete
+}
+
+void AnimationDisplay::load(const AnimationFile* animation) {
+    animation_ = animation;
+    preloaded_ = animation->getFrameCount() < MAX_PRELOADED_FRAMES ? animation->getFrameCount() : MAX_PRELOADED_FRAMES;
+    while ((int)canvases_.size() < preloaded_) {
+        canvases_.push_back(matrix_->CreateFrameCanvas());
+    }
+    for (int i = 0; i < preloaded_; i++) {
+        draw(canvases_[i], animation->getFrame(i));
+    }
+}
+
+void AnimationDisplay::show(int index) {
+    FrameCanvas* canvas;
+    if (index < preloaded_) {
+        canvas = canvases_[index];
+    } else {
+        // Never the one on screen
+        canvas = visible_ == spare_[0] ? spare_[1] : spare_[0];
+        draw(canvas, animation_->getFrame(index));
+    }
+    
+    // Whatever comes back stays as it is: it's either preloaded or spare
+    matrix_->SwapOnVSync(canvas);
+    visible_ = canvas;
+}
+
+void AnimationDisplay::release() {
+    FrameCanvas* blank = visible_ == spare_[0] ? spare_[1] : spare_[0];
+    blank->Clear();
+    matrix_->SwapOnVSync(blank);
+    visible_ = blank;
+    animation_ = nullptr;
+}
+
+void AnimationDisplay::setBrightness(int brightnessLevel) {
+    if (brightnessLevel >= Config::MIN_BRIGHTNESS && brightnessLevel <= Config::MAX_BRIGHTNESS) {
+        brightnessLevel_ = brightnessLevel;
+        updateScale();
+        // The preloaded frames were drawn at the old brightness
+        if (animation_) {
+            load(animation_);
+        }
+    }
+}
+
+void AnimationDisplay::draw(FrameCanvas* canvas, const uint8_t* pixels) {
+    int width = animation_->getWidth();
+    int height = animation_->getHeight();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++, pixels += 3) {
+            canvas->SetPixel(x, y, scale_[pixels[0]], scale_[pixels[1]], scale_[pixels[2]]);
+        }
+    }
+}
+
+void AnimationDisplay::updateScale() {
+    int brightnessScale = (brightnessLevel_ * 255) / Config::MAX_BRIGHTNESS;
+    for (int i = 0; i < 256; i++) {
+        scale_[i] = (uint8_t)((i * brightnessScale) / 255);
+    }
+}
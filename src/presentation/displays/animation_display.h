@@ -0,0 +1,60 @@
+#ifndef ANIMATION_DISPLAY_H
+#define ANIMATION_DISPLAY_H
+
+#include "led-matrix.h"
+#include "infrastructure/config/config.h"
+#include "infrastructure/storage/animation_file.h"
+#include <vector>
+
+using namespace rgb_matrix;
+
+// Shows frames of a pre-rendered animation.
+//
+// load() draws up to MAX_PRELOADED_FRAMES frames into canvases of their
+// own, so showing one of them is just a SwapOnVSync, however much work
+// went into rendering it. Longer animations stream the remaining frames
+// from the mapped file through two spare canvases, one SetPixel per LED.
+// The matrix owns its canvases until it is deleted, so the pool only ever
+// grows and is reused by every later load().
+class AnimationDisplay {
+public:
+    AnimationDisplay(RGBMatrix* matrix, int brightnessLevel = Config::DEFAULT_BRIGHTNESS);
+    ~AnimationDisplay();
+    
+    // Preload the animation's frames; it must match the panel size
+    void load(const AnimationFile* animation);
+    int getPreloadedCount() const { return preloaded_; }
+    
+    // Swap frame `index` in on the next vsync
+    void show(int index);
+    
+    // Put a blank spare canvas on screen, so the next app never draws over
+    // a preloaded frame
+    void release();
+    
+    // Utility methods
+    void setBrightness(int brightnessLevel);
+    
+    static const int MAX_PRELOADED_FRAMES = 240;  // About 100 KB of matrix memory each at 96x48
+    
+private:
+    // Member variables
+    RGBMatrix* matrix_;
+    const AnimationFile* animation_;
+    std::vector<FrameCanvas*> canvases_;  // Preloaded frames, in order
+    int preloaded_;
+    FrameCanvas* spare_[2];               // For streamed frames
+    FrameCanvas* visible_;
+    int brightnessLevel_;
+    uint8_t scale_[256];
+    
+    // Helper methods
+    void draw(FrameCanvas* canvas, const uint8_t* pixels);
+    void updateScale();
+    
+    // Disable copy constructor and assignment operator
+    AnimationDisplay(const AnimationDisplay&) = delete;
+    AnimationDisplay& operator=(const AnimationDisplay&) = delete;
+};
+
+#endif // ANIMATION_DISPLAY_H
@@ -4,40 +4,135 @@
 #include <cstring>
 
 DbDisplay::DbDisplay(RGBMatrix* matrix, int brightnessLevel) 
-    : matrix_(matrix), brightnessLevel_(brightnessLevel), fontsLoaded_(false), borderEnabled_(true) {
+    : matrix_(matrix), brightnessLevel_(brightnessLevel), fontsLoaded_(false), borderEnabled_(true),
+      borderPulse_(100), history_(nullptr) {
     offscreen_ = matrix_->CreateFrameCanvas();
-    brightnessScale_ = (brightnessLevel * 255) / Config::MAX_BRIGHTNESS;
+    canvas_ = offscreen_;
+    initialize();
+}
+
+DbDisplay::DbDisplay(Canvas* canvas, int brightnessLevel)
+    : matrix_(nullptr), offscreen_(nullptr), canvas_(canvas), brightnessLevel_(brightnessLevel),
+      fontsLoaded_(false), borderEnabled_(true), borderPulse_(100), history_(nullptr) {
+    initialize();
+}
+
+void DbDisplay::initialize() {
+    brightnessScale_ = (brightnessLevel_ * 255) / Config::MAX_BRIGHTNESS;
     loadFonts();
+    
+    // History graph between the top-aligned bar and the bottom padding
+    int inset = Config::BORDER_THICKNESS + Config::PADDING;
+    int graphRows = canvas_->height() - 2 * inset - Config::COMPONENT_HEIGHT - Config::TEXT_SPACING;
+    if (graphRows >= Config::DB_HISTORY_MIN_ROWS) {
+        historyGraph_.resize(canvas_->width() - 2 * inset, graphRows);
+    }
 }
 
 DbDisplay::~DbDisplay() {
     // FrameCanvas is managed by the matrix, no need to delete
 }
 
-void DbDisplay::update(int dbValue, bool blinkState) {
+void DbDisplay::update(int dbValue, bool blinkState, const char* unitLabel, int peakHoldValue,
+                       const DbColorCalculator::Thresholds& thresholds) {
     int componentStartY = getComponentStartY();
     
     // Clear and redraw everything
-    clearAndRedraw(dbValue, componentStartY);
+    clearAndRedraw(dbValue, peakHoldValue, componentStartY, unitLabel, thresholds);
+    drawHistory(componentStartY, thresholds);
     
     // Draw border if enabled
-    if (borderEnabled_) {
-        bool shouldShowBorder = !DbColorCalculator::shouldBlink(dbValue) || blinkState;
-        ColorUtils::Color borderColor = DbColorCalculator::getBorderColor(dbValue);
-        borderRenderer_.drawBorder(offscreen_, borderColor, shouldShowBorder);
+    drawBorder(dbValue, blinkState, thresholds);
+    
+    // Swap the offscreen canvas with the visible one (double buffering)
+    present();
+}
+
+void DbDisplay::updateChannels(const ChannelLevel* channels, int count, int loudest, bool blinkState) {
+    if (count <= 0) {
+        return;
+    }
+    
+    canvas_->Clear();
+    
+    int inset = Config::BORDER_THICKNESS + Config::PADDING;
+    int areaWidth = canvas_->width() - 2 * inset;
+    int barsTopY = inset;
+    int barsBottomY = canvas_->height() - inset;
+    
+    // Caption with the loudest channel, e.g. "98 dB ch2"
+    if (fontsLoaded_) {
+        int textR = scaleBrightness(Config::Colors::TEXT_R);
+        int textG = scaleBrightness(Config::Colors::TEXT_G);
+        int textB = scaleBrightness(Config::Colors::TEXT_B);
+        rgb_matrix::Color white(textR, textG, textB);
+        
+        char caption[32];
+        snprintf(caption, sizeof(caption), "%d dB ch%d", channels[loudest].value, loudest);
+        rgb_matrix::DrawText(canvas_, smallFont_, inset, inset + smallFont_.height(), white, caption);
+        barsTopY += smallFont_.height() + 2;  // 2px spacing
+    }
+    
+    // Equal columns with 1px gaps
+    int gap = count > 1 ? 1 : 0;
+    int barWidth = (areaWidth - gap * (count - 1)) / count;
+    if (barWidth < 1) {
+        barWidth = 1;
+        gap = 0;
+    }
+    for (int i = 0; i < count; i++) {
+        drawChannelBar(inset + i * (barWidth + gap), barsTopY, barWidth, barsBottomY - barsTopY, channels[i]);
     }
     
+    drawBorder(channels[loudest].value, blinkState, channels[loudest].thresholds);
+    
     // Swap the offscreen canvas with the visible one (double buffering)
-    offscreen_ = matrix_->SwapOnVSync(offscreen_);
+    present();
+}
+
+void DbDisplay::present() {
+    if (matrix_) {
+        offscreen_ = matrix_->SwapOnVSync(offscreen_);
+        canvas_ = offscreen_;
+    }
 }
 
-void DbDisplay::clearAndRedraw(int dbValue, int componentStartY) {
-    offscreen_->Clear();
-    drawText(dbValue, componentStartY);
-    drawProgressBar(dbValue, componentStartY);
+void DbDisplay::setHistory(const LevelHistory* history) {
+    history_ = history;
 }
 
-void DbDisplay::drawText(int dbValue, int componentStartY) {
+void DbDisplay::drawHistory(int componentStartY, const DbColorCalculator::Thresholds& thresholds) {
+    if (!showsHistory()) {
+        return;
+    }
+    
+    // Renders only the columns of newly closed slices, then copies the graph
+    historyGraph_.sync(*history_, thresholds, brightnessScale_);
+    int graphY = componentStartY + Config::COMPONENT_HEIGHT + Config::TEXT_SPACING;
+    historyGraph_.draw(canvas_, Config::BORDER_THICKNESS + Config::PADDING, graphY);
+}
+
+void DbDisplay::drawBorder(int dbValue, bool blinkState, const DbColorCalculator::Thresholds& thresholds) {
+    if (borderEnabled_) {
+        bool shouldShowBorder = !DbColorCalculator::shouldBlink(dbValue, thresholds) || blinkState;
+        ColorUtils::Color borderColor = DbColorCalculator::getBorderColor(dbValue, thresholds);
+        if (borderPulse_ < 100) {
+            borderColor.r = borderColor.r * borderPulse_ / 100;
+            borderColor.g = borderColor.g * borderPulse_ / 100;
+            borderColor.b = borderColor.b * borderPulse_ / 100;
+        }
+        borderRenderer_.drawBorder(canvas_, borderColor, shouldShowBorder);
+    }
+}
+
+void DbDisplay::clearAndRedraw(int dbValue, int peakHoldValue, int componentStartY, const char* unitLabel,
+                               const DbColorCalculator::Thresholds& thresholds) {
+    canvas_->Clear();
+    drawText(dbValue, componentStartY, unitLabel);
+    drawProgressBar(dbValue, peakHoldValue, componentStartY, thresholds);
+}
+
+void DbDisplay::drawText(int dbValue, int componentStartY, const char* unitLabel) {
     if (!fontsLoaded_) return;
     
     // Apply brightness scaling to text colors
@@ -52,21 +147,22 @@ void DbDisplay::drawText(int dbValue, int componentStartY) {
     // Draw large dB number
     char dbBuf[8];
     snprintf(dbBuf, sizeof(dbBuf), "%d", dbValue);
-    rgb_matrix::DrawText(offscreen_, largeFont_, textX, componentStartY + largeFont_.height(), white, dbBuf);
+    rgb_matrix::DrawText(canvas_, largeFont_, textX, componentStartY + largeFont_.height(), white, dbBuf);
     
-    // Draw small "dB" unit right after the number
+    // Draw small unit label right after the number
     int unitX = textX + largeFont_.CharacterWidth('0') * strlen(dbBuf) + 2; // 2px spacing
-    rgb_matrix::DrawText(offscreen_, smallFont_, unitX, componentStartY + largeFont_.height(), white, "dB");
+    rgb_matrix::DrawText(canvas_, smallFont_, unitX, componentStartY + largeFont_.height(), white, unitLabel);
 }
 
-void DbDisplay::drawProgressBar(int dbValue, int componentStartY) {
+void DbDisplay::drawProgressBar(int dbValue, int peakHoldValue, int componentStartY,
+                                const DbColorCalculator::Thresholds& thresholds) {
     int startY = componentStartY + 15 + Config::TEXT_SPACING; // below text with spacing
     int startX = Config::BORDER_THICKNESS + Config::PADDING;
-    int meterWidth = offscreen_->width() - 2 * Config::BORDER_THICKNESS - 2 * Config::PADDING;
+    int meterWidth = canvas_->width() - 2 * Config::BORDER_THICKNESS - 2 * Config::PADDING;
     
     // Calculate segment positions (assuming 120dB max)
-    int greenEnd = (DbColorCalculator::YELLOW_THRESHOLD * meterWidth) / Config::MAX_DB_VALUE;
-    int yellowEnd = (DbColorCalculator::RED_THRESHOLD * meterWidth) / Config::MAX_DB_VALUE;
+    int greenEnd = (thresholds.yellow * meterWidth) / Config::MAX_DB_VALUE;
+    int yellowEnd = (thresholds.red * meterWidth) / Config::MAX_DB_VALUE;
     int totalFill = (dbValue * meterWidth) / Config::MAX_DB_VALUE;
     
     // Draw green segment (0-80dB)
@@ -94,22 +190,84 @@ void DbDisplay::drawProgressBar(int dbValue, int componentStartY) {
         int redB = scaleBrightness(Config::Colors::RED_B);
         drawBarSegment(startX + yellowEnd, startY, totalFill - yellowEnd, redR, redG, redB);
     }
+    
+    // Draw peak-hold marker (one column in the text color)
+    if (peakHoldValue >= 0) {
+        int peakX = (peakHoldValue * meterWidth) / Config::MAX_DB_VALUE;
+        if (peakX >= meterWidth) peakX = meterWidth - 1;
+        int textR = scaleBrightness(Config::Colors::TEXT_R);
+        int textG = scaleBrightness(Config::Colors::TEXT_G);
+        int textB = scaleBrightness(Config::Colors::TEXT_B);
+        drawBarSegment(startX + peakX, startY, 1, textR, textG, textB);
+    }
 }
 
 void DbDisplay::drawBarSegment(int startX, int startY, int width, int r, int g, int b) {
     for (int x = startX; x < startX + width; x++) {
         for (int h = 0; h < Config::PROGRESS_BAR_HEIGHT; h++) {
-            offscreen_->SetPixel(x, startY + h, r, g, b);
+            canvas_->SetPixel(x, startY + h, r, g, b);
+        }
+    }
+}
+
+void DbDisplay::drawChannelBar(int startX, int topY, int width, int height, const ChannelLevel& channel) {
+    int bottomY = topY + height;  // one past the last row
+    
+    // Same segments as the horizontal bar, growing upwards
+    int greenEnd = (channel.thresholds.yellow * height) / Config::MAX_DB_VALUE;
+    int yellowEnd = (channel.thresholds.red * height) / Config::MAX_DB_VALUE;
+    int totalFill = (channel.value * height) / Config::MAX_DB_VALUE;
+    if (totalFill > height) totalFill = height;
+    
+    int greenFill = (totalFill > greenEnd) ? greenEnd : totalFill;
+    fillRect(startX, bottomY - greenFill, width, greenFill,
+             scaleBrightness(Config::Colors::GREEN_R), scaleBrightness(Config::Colors::GREEN_G),
+             scaleBrightness(Config::Colors::GREEN_B));
+    
+    if (totalFill > greenEnd) {
+        int yellowFill = (totalFill > yellowEnd) ? yellowEnd : totalFill;
+        fillRect(startX, bottomY - yellowFill, width, yellowFill - greenEnd,
+                 scaleBrightness(Config::Colors::YELLOW_R), scaleBrightness(Config::Colors::YELLOW_G),
+                 scaleBrightness(Config::Colors::YELLOW_B));
+    }
+    
+    if (totalFill > yellowEnd) {
+        fillRect(startX, bottomY - totalFill, width, totalFill - yellowEnd,
+                 scaleBrightness(Config::Colors::RED_R), scaleBrightness(Config::Colors::RED_G),
+                 scaleBrightness(Config::Colors::RED_B));
+    }
+    
+    // Peak-hold marker (one row in the text color)
+    if (channel.peakHoldValue >= 0) {
+        int peakRow = (channel.peakHoldValue * height) / Config::MAX_DB_VALUE;
+        if (peakRow >= height) peakRow = height - 1;
+        fillRect(startX, bottomY - 1 - peakRow, width, 1,
+                 scaleBrightness(Config::Colors::TEXT_R), scaleBrightness(Config::Colors::TEXT_G),
+                 scaleBrightness(Config::Colors::TEXT_B));
+    }
+}
+
+void DbDisplay::fillRect(int startX, int startY, int width, int height, int r, int g, int b) {
+    for (int y = startY; y < startY + height; y++) {
+        for (int x = startX; x < startX + width; x++) {
+            canvas_->SetPixel(x, y, r, g, b);
         }
     }
 }
 
 
 int DbDisplay::getComponentStartY() const {
-    int rows = offscreen_->height();
+    if (showsHistory()) {
+        return Config::BORDER_THICKNESS + Config::PADDING;
+    }
+    int rows = canvas_->height();
     return (rows - Config::COMPONENT_HEIGHT) / 2;
 }
 
+bool DbDisplay::showsHistory() const {
+    return history_ && historyGraph_.getHeight() > 0;
+}
+
 
 void DbDisplay::enableBorder(bool enable) {
     borderEnabled_ = enable;
@@ -123,6 +281,10 @@ bool DbDisplay::isBorderEnabled() const {
     return borderEnabled_;
 }
 
+void DbDisplay::setBorderPulse(int percent) {
+    borderPulse_ = percent < 0 ? 0 : percent > 100 ? 100 : percent;
+}
+
 int DbDisplay::scaleBrightness(int color) const {
     return (color * brightnessScale_) / 255;
 }
@@ -6,21 +6,51 @@
 #include "infrastructure/config/config.h"
 #include "shared/utils/color_utils.h"
 #include "infrastructure/display/border_renderer.h"
+#include "presentation/controllers/db_color_calculator.h"
+#include "presentation/displays/db_history_graph.h"
+#include "shared/dsp/level_history.h"
 #include <string>
 
 using namespace rgb_matrix;
 
 class DbDisplay {
 public:
+    // One bar of the multi-channel view
+    struct ChannelLevel {
+        int value;
+        int peakHoldValue;  // -1 for no marker
+        DbColorCalculator::Thresholds thresholds;
+        
+        ChannelLevel() : value(0), peakHoldValue(-1) {}
+    };
+    
     DbDisplay(RGBMatrix* matrix, int brightnessLevel = Config::DEFAULT_BRIGHTNESS);
+    // Headless: draws every frame into `canvas` (not owned), e.g. a
+    // MemoryCanvas for trace replay
+    DbDisplay(Canvas* canvas, int brightnessLevel = Config::DEFAULT_BRIGHTNESS);
     ~DbDisplay();
     
-    // Main display update method
-    void update(int dbValue, bool blinkState);
+    // Main display update method; unitLabel follows the number (e.g. "dBA",
+    // "LAeq1m") so integrator pages reuse the same layout. A non-negative
+    // peakHoldValue draws a marker on the bar at that level.
+    void update(int dbValue, bool blinkState, const char* unitLabel = "dB", int peakHoldValue = -1,
+                const DbColorCalculator::Thresholds& thresholds = DbColorCalculator::Thresholds());
+    
+    // Multi-channel view: one vertical bar per channel, colored with that
+    // channel's thresholds, under a caption with the loudest channel. The
+    // border follows the loudest channel.
+    void updateChannels(const ChannelLevel* channels, int count, int loudest, bool blinkState);
+    
+    // Scrolling level history under the number (not owned). When the panel
+    // has room for the graph, the number and bar move to the top.
+    void setHistory(const LevelHistory* history);
     
     // Utility methods
     void setBrightness(int brightnessLevel);
     
+    // Border intensity in percent of its threshold color (beat pulse)
+    void setBorderPulse(int percent);
+    
     // Border control
     void enableBorder(bool enable = true);
     void disableBorder();
@@ -28,26 +58,39 @@ public:
     
 private:
     // Drawing methods
-    void clearAndRedraw(int dbValue, int componentStartY);
-    void drawText(int dbValue, int componentStartY);
-    void drawProgressBar(int dbValue, int componentStartY);
+    void clearAndRedraw(int dbValue, int peakHoldValue, int componentStartY, const char* unitLabel,
+                        const DbColorCalculator::Thresholds& thresholds);
+    void drawText(int dbValue, int componentStartY, const char* unitLabel);
+    void drawProgressBar(int dbValue, int peakHoldValue, int componentStartY,
+                         const DbColorCalculator::Thresholds& thresholds);
     void drawBarSegment(int startX, int startY, int width, int r, int g, int b);
+    void drawChannelBar(int startX, int topY, int width, int height, const ChannelLevel& channel);
+    void fillRect(int startX, int startY, int width, int height, int r, int g, int b);
+    void drawBorder(int dbValue, bool blinkState, const DbColorCalculator::Thresholds& thresholds);
+    void drawHistory(int componentStartY, const DbColorCalculator::Thresholds& thresholds);
     
     // Helper methods
+    void initialize();
+    void present();
     int getComponentStartY() const;
+    bool showsHistory() const;
     int scaleBrightness(int color) const;
     void loadFonts();
     
     // Member variables
     RGBMatrix* matrix_;
     FrameCanvas* offscreen_;
+    Canvas* canvas_;  // Drawing target: offscreen_, or the headless canvas
     int brightnessLevel_;
     int brightnessScale_;
     bool fontsLoaded_;
     bool borderEnabled_;
+    int borderPulse_;
     
     // Components
     BorderRenderer borderRenderer_;
+    DbHistoryGraph historyGraph_;
+    const LevelHistory* history_;
     
     // Fonts (cached for performance)
     rgb_matrix::Font largeFont_;
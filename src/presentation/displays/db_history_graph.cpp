@@ -0,0 +1,104 @@
+#include "db_history_graph.h"
+
+DbHistoryGraph::DbHistoryGraph()
+    : width_(0), height_(0), floorDb_(Config::DB_HISTORY_FLOOR_DB), ceilingDb_(Config::MAX_DB_VALUE),
+      newest_(0), filled_(0), syncedSequence_(0), brightnessScale_(-1) {
+}
+
+void DbHistoryGraph::resize(int width, int height) {
+    width_ = width > 0 ? width : 0;
+    height_ = height > 0 ? height : 0;
+    pixels_.assign((size_t)width_ * height_ * 3, 0);
+    tops_.assign(width_, height_);
+    brightnessScale_ = -1;  // Redraw on the next sync
+    clear();
+}
+
+void DbHistoryGraph::setRange(double floorDb, double ceilingDb) {
+    if (ceilingDb > floorDb) {
+        floorDb_ = floorDb;
+        ceilingDb_ = ceilingDb;
+        brightnessScale_ = -1;  // Redraw on the next sync
+    }
+}
+
+void DbHistoryGraph::sync(const LevelHistory& history, const DbColorCalculator::Thresholds& thresholds,
+                          int brightnessScale) {
+    if (width_ == 0 || height_ == 0) {
+        return;
+    }
+
+    unsigned long fresh = history.getSequence() - syncedSequence_;
+    syncedSequence_ = history.getSequence();
+
+    bool restyled = brightnessScale != brightnessScale_ || thresholds.yellow != thresholds_.yellow ||
+                    thresholds.orange != thresholds_.orange || thresholds.red != thresholds_.red;
+    int columns = (int)fresh;
+    if (restyled || fresh >= (unsigned long)width_) {
+        thresholds_ = thresholds;
+        brightnessScale_ = brightnessScale;
+        clear();
+        columns = history.getCount() < width_ ? history.getCount() : width_;
+    }
+
+    // Oldest first, each into the column after the current newest
+    for (int age = columns - 1; age >= 0; age--) {
+        newest_ = (newest_ + 1) % width_;
+        renderColumn(newest_, history.getSlice(age));
+        if (filled_ < width_) {
+            filled_++;
+        }
+    }
+}
+
+void DbHistoryGraph::draw(Canvas* canvas, int x, int y) const {
+    // Newest at the right edge, older columns to its left
+    for (int i = 0; i < filled_; i++) {
+        int column = newest_ - i;
+        if (column < 0) {
+            column += width_;
+        }
+        int screenX = x + width_ - 1 - i;
+        const uint8_t* pixels = &pixels_[(size_t)column * height_ * 3];
+        for (int row = tops_[column]; row < height_; row++) {
+            canvas->SetPixel(screenX, y + row, pixels[row * 3], pixels[row * 3 + 1], pixels[row * 3 + 2]);
+        }
+    }
+}
+
+void DbHistoryGraph::clear() {
+    newest_ = width_ > 0 ? width_ - 1 : 0;
+    filled_ = 0;
+}
+
+void DbHistoryGraph::renderColumn(int column, const LevelHistory::Slice& slice) {
+    int segment = DbColorCalculator::getSegment((int)(slice.maxDb + 0.5f), thresholds_);
+    ColorUtils::Color color = DbColorCalculator::getProgressBarColor((int)(slice.maxDb + 0.5f), segment);
+    int r = (color.r * brightnessScale_) / 255;
+    int g = (color.g * brightnessScale_) / 255;
+    int b = (color.b * brightnessScale_) / 255;
+
+    int meanRows = levelToRows(slice.meanDb);
+    int maxRows = levelToRows(slice.maxDb);
+    if (maxRows < meanRows) {
+        maxRows = meanRows;
+    }
+
+    // Rows count from the top; the bar grows up from the bottom, and
+    // draw() skips the rows above it
+    uint8_t* pixels = &pixels_[(size_t)column * height_ * 3];
+    for (int row = height_ - maxRows; row < height_; row++) {
+        bool dim = row < height_ - meanRows;
+        pixels[row * 3] = (uint8_t)(dim ? r / 3 : r);
+        pixels[row * 3 + 1] = (uint8_t)(dim ? g / 3 : g);
+        pixels[row * 3 + 2] = (uint8_t)(dim ? b / 3 : b);
+    }
+    tops_[column] = height_ - maxRows;
+}
+
+int DbHistoryGraph::levelToRows(double db) const {
+    int rows = (int)((db - floorDb_) * height_ / (ceilingDb_ - floorDb_) + 0.5);
+    if (rows < 0) return 0;
+    if (rows > height_) return height_;
+    return rows;
+}
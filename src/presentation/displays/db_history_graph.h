@@ -0,0 +1,62 @@
+#ifndef DB_HISTORY_GRAPH_H
+#define DB_HISTORY_GRAPH_H
+
+#include "led-matrix.h"
+#include "presentation/controllers/db_color_calculator.h"
+#include "shared/dsp/level_history.h"
+#include <vector>
+#include <stdint.h>
+
+using namespace rgb_matrix;
+
+// Scrolling bar graph of a LevelHistory, one pixel column per slice, with
+// the newest slice at the right. Each column is a bar up to the slice's
+// mean, then a dimmer bar up to its max, in the bar color of its max
+// (DbColorCalculator).
+//
+// Rendered columns are kept in a ring of pixel columns. A new slice
+// advances the ring by one and renders only that column, so scrolling
+// costs O(height) per slice rather than a redraw of every column. Only a
+// change of thresholds or brightness, or a jump of a whole graph width,
+// redraws everything. draw() copies the lit pixels to the canvas.
+class DbHistoryGraph {
+public:
+    DbHistoryGraph();
+
+    // Graph size in pixels; clears the graph
+    void resize(int width, int height);
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+
+    // Levels at the bottom and top rows
+    void setRange(double floorDb, double ceilingDb);
+
+    // Renders the slices closed since the last sync (usually none or one)
+    void sync(const LevelHistory& history, const DbColorCalculator::Thresholds& thresholds, int brightnessScale);
+
+    // Top-left corner at (x, y)
+    void draw(Canvas* canvas, int x, int y) const;
+
+private:
+    int width_;
+    int height_;
+    double floorDb_;
+    double ceilingDb_;
+
+    // Column-major RGB, height_ * 3 bytes per column
+    std::vector<uint8_t> pixels_;
+    std::vector<int> tops_;     // First lit row per column (height_ if none)
+    int newest_;                // Ring column of the newest slice
+    int filled_;                // Columns holding a slice
+
+    unsigned long syncedSequence_;
+    DbColorCalculator::Thresholds thresholds_;
+    int brightnessScale_;
+
+    // Helper methods
+    void clear();
+    void renderColumn(int column, const LevelHistory::Slice& slice);
+    int levelToRows(double db) const;
+};
+
+#endif // DB_HISTORY_GRAPH_H
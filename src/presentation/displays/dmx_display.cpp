@@ -0,0 +1,67 @@
+#include "dmx_display.h"
+
+DmxDisplay::DmxDisplay(RGBMatrix* matrix, const DmxRenderer::Layout& layout, int brightnessLevel)
+    : matrix_(matrix), offscreen_(0), brightnessLevel_(brightnessLevel),
+      renderer_(matrix->width(), matrix->height(), layout) {
+    canvases_[0] = matrix_->CreateFrameCanvas();
+    canvases_[1] = nullptr;
+    renderer_.setBrightness((brightnessLevel * 255) / Config::MAX_BRIGHTNESS);
+
+    versions_.assign(renderer_.getUniverseCount(), 0);
+    drawn_[0].assign(renderer_.getUniverseCount(), 0);
+    drawn_[1].assign(renderer_.getUniverseCount(), 0);
+}
+
+DmxDisplay::~DmxDisplay() {
+    // FrameCanvas is managed by the matrix, no need to delete
+}
+
+void DmxDisplay::onUniverse(int index, const uint8_t* slots, size_t size) {
+    renderer_.drawUniverse(canvases_[offscreen_], index, slots, size);
+    drawn_[offscreen_][index] = ++versions_[index];
+}
+
+void DmxDisplay::onFrame(const DmxReceiver& receiver) {
+    // Brightness changes leave both canvases stale
+    for (size_t i = 0; i < versions_.size(); i++) {
+        size_t size = 0;
+        const uint8_t* slots = receiver.getLatest((int)i, size);
+        if (slots && drawn_[offscreen_][i] != versions_[i]) {
+            renderer_.drawUniverse(canvases_[offscreen_], (int)i, slots, size);
+            drawn_[offscreen_][i] = versions_[i];
+        }
+    }
+
+    // Swap the offscreen canvas with the visible one (double buffering)
+    FrameCanvas* previous = matrix_->SwapOnVSync(canvases_[offscreen_]);
+    int next = 1 - offscreen_;
+    if (canvases_[next] != previous) {
+        // The first swap hands back the canvas the last app drew on
+        canvases_[next] = previous;
+        previous->Clear();
+        drawn_[next].assign(versions_.size(), 0);
+    }
+    offscreen_ = next;
+
+    // Catch the new offscreen canvas up with the frame just shown
+    for (size_t i = 0; i < versions_.size(); i++) {
+        if (drawn_[offscreen_][i] == versions_[i]) {
+            continue;
+        }
+        size_t size = 0;
+        const uint8_t* slots = receiver.getLatest((int)i, size);
+        if (slots) {
+            renderer_.drawUniverse(canvases_[offscreen_], (int)i, slots, size);
+        }
+        drawn_[offscreen_][i] = versions_[i];
+    }
+}
+
+void DmxDisplay::setBrightness(int brightnessLevel) {
+    if (brightnessLevel >= Config::MIN_BRIGHTNESS && brightnessLevel <= Config::MAX_BRIGHTNESS) {
+        brightnessLevel_ = brightnessLevel;
+        renderer_.setBrightness((brightnessLevel * 255) / Config::MAX_BRIGHTNESS);
+        drawn_[0].assign(versions_.size(), 0);
+        drawn_[1].assign(versions_.size(), 0);
+    }
+}
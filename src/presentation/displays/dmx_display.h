@@ -0,0 +1,48 @@
+#ifndef DMX_DISPLAY_H
+#define DMX_DISPLAY_H
+
+#include "led-matrix.h"
+#include "infrastructure/config/config.h"
+#include "infrastructure/display/dmx_renderer.h"
+#include "infrastructure/network/dmx_receiver.h"
+#include <vector>
+
+using namespace rgb_matrix;
+
+// Draws DMX universes on the offscreen canvas as they arrive and swaps it
+// in when the receiver reports a complete frame.
+//
+// The matrix alternates between two canvases, so after a swap the new
+// offscreen canvas lacks whatever the last frame changed. Each canvas
+// remembers which version of each universe it shows; after a swap the
+// universes it missed are redrawn from the receiver's held buffers.
+class DmxDisplay : public DmxReceiver::Listener {
+public:
+    DmxDisplay(RGBMatrix* matrix, const DmxRenderer::Layout& layout, int brightnessLevel = Config::DEFAULT_BRIGHTNESS);
+    ~DmxDisplay();
+
+    int getUniverseCount() const { return renderer_.getUniverseCount(); }
+
+    // DmxReceiver::Listener
+    virtual void onUniverse(int index, const uint8_t* slots, size_t size);
+    virtual void onFrame(const DmxReceiver& receiver);
+
+    // Utility methods
+    void setBrightness(int brightnessLevel);
+
+private:
+    // Member variables
+    RGBMatrix* matrix_;
+    FrameCanvas* canvases_[2];     // Offscreen one first; the other is learned on the first swap
+    int offscreen_;                // Index into canvases_
+    int brightnessLevel_;
+
+    // Components
+    DmxRenderer renderer_;
+
+    // Universe versions: received, and shown on each canvas
+    std::vector<unsigned long> versions_;
+    std::vector<unsigned long> drawn_[2];
+};
+
+#endif // DMX_DISPLAY_H
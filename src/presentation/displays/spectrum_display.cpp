@@ -0,0 +1,28 @@
+#include "spectrum_display.h"
+
+SpectrumDisplay::SpectrumDisplay(RGBMatrix* matrix, int brightnessLevel)
+    : matrix_(matrix), brightnessLevel_(brightnessLevel), renderer_(Config::SPECTRUM_COLUMNS) {
+    offscreen_ = matrix_->CreateFrameCanvas();
+    brightnessScale_ = (brightnessLevel * 255) / Config::MAX_BRIGHTNESS;
+}
+
+SpectrumDisplay::~SpectrumDisplay() {
+    // FrameCanvas is managed by the matrix, no need to delete
+}
+
+void SpectrumDisplay::update(const float* columnsDb, long long nowMs) {
+    renderer_.update(columnsDb, nowMs);
+    
+    offscreen_->Clear();
+    renderer_.draw(offscreen_, brightnessScale_);
+    
+    // Swap the offscreen canvas with the visible one (double buffering)
+    offscreen_ = matrix_->SwapOnVSync(offscreen_);
+}
+
+void SpectrumDisplay::setBrightness(int brightnessLevel) {
+    if (brightnessLevel >= Config::MIN_BRIGHTNESS && brightnessLevel <= Config::MAX_BRIGHTNESS) {
+        brightnessLevel_ = brightnessLevel;
+        brightnessScale_ = (brightnessLevel * 255) / Config::MAX_BRIGHTNESS;
+    }
+}
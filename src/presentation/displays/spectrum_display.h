@@ -0,0 +1,32 @@
+#ifndef SPECTRUM_DISPLAY_H
+#define SPECTRUM_DISPLAY_H
+
+#include "led-matrix.h"
+#include "infrastructure/config/config.h"
+#include "infrastructure/display/spectrum_renderer.h"
+
+using namespace rgb_matrix;
+
+class SpectrumDisplay {
+public:
+    SpectrumDisplay(RGBMatrix* matrix, int brightnessLevel = Config::DEFAULT_BRIGHTNESS);
+    ~SpectrumDisplay();
+    
+    // Full-panel bars, one column per band
+    void update(const float* columnsDb, long long nowMs);
+    
+    // Utility methods
+    void setBrightness(int brightnessLevel);
+    
+private:
+    // Member variables
+    RGBMatrix* matrix_;
+    FrameCanvas* offscreen_;
+    int brightnessLevel_;
+    int brightnessScale_;
+    
+    // Components
+    SpectrumRenderer renderer_;
+};
+
+#endif // SPECTRUM_DISPLAY_H
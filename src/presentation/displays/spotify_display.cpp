@@ -30,7 +30,8 @@ void SpotifyDisplay::clearAndRedraw(const std::string& text) {
     int screenHeight = offscreen_->height();
     
     // Calculate total height of the unit (icon + gap + text)
-    int iconHeight = 13; // Spotify icon height
+    bool hasIcon = !scaledIcon_.empty();
+    int iconHeight = hasIcon ? scaledIcon_.height : 13; // Artwork or Spotify icon height
     int gap = 2; // Gap between icon and text
     int textHeight = mediumFont_.height(); // Text height
     int totalUnitHeight = iconHeight + gap + textHeight;
@@ -38,11 +39,15 @@ void SpotifyDisplay::clearAndRedraw(const std::string& text) {
     // Center the entire unit vertically
     int unitStartY = (screenHeight - totalUnitHeight) / 2;
     
-    // Draw Spotify logo
-    int iconWidth = 18; // Spotify icon width
+    // Draw artwork if we have it, otherwise the Spotify logo
+    int iconWidth = hasIcon ? scaledIcon_.width : 18; // Spotify icon width
     int iconStartX = centerX - iconWidth / 2;
     int iconY = unitStartY;
-    drawSpotifyLogo(iconStartX, iconY);
+    if (hasIcon) {
+        drawIcon(iconStartX, iconY);
+    } else {
+        drawSpotifyLogo(iconStartX, iconY);
+    }
     
     // Draw text below with gap
     int textY = iconY + iconHeight + gap;
@@ -101,6 +106,16 @@ void SpotifyDisplay::drawSpotifyLogo(int startX, int startY) {
     }
 }
 
+void SpotifyDisplay::drawIcon(int startX, int startY) {
+    // Icon is already resampled, dithered and brightness-scaled
+    for (int y = 0; y < scaledIcon_.height; y++) {
+        for (int x = 0; x < scaledIcon_.width; x++) {
+            const uint8_t* px = scaledIcon_.at(x, y);
+            offscreen_->SetPixel(startX + x, startY + y, px[0], px[1], px[2]);
+        }
+    }
+}
+
 void SpotifyDisplay::drawText(const std::string& text, int centerX, int startY) {
     if (!fontsLoaded_ || text.empty()) return;
     
@@ -122,6 +137,19 @@ void SpotifyDisplay::setBrightness(int brightnessLevel) {
     if (brightnessLevel >= Config::MIN_BRIGHTNESS && brightnessLevel <= Config::MAX_BRIGHTNESS) {
         brightnessLevel_ = brightnessLevel;
         brightnessScale_ = (brightnessLevel * 255) / Config::MAX_BRIGHTNESS;
+        updateScaledIcon();
+    }
+}
+
+void SpotifyDisplay::setIcon(const RgbImage& icon) {
+    icon_ = icon;
+    updateScaledIcon();
+}
+
+void SpotifyDisplay::updateScaledIcon() {
+    scaledIcon_ = icon_;
+    for (size_t i = 0; i < scaledIcon_.pixels.size(); i++) {
+        scaledIcon_.pixels[i] = (uint8_t)scaleBrightness(scaledIcon_.pixels[i]);
     }
 }
 
@@ -4,6 +4,7 @@
 #include "led-matrix.h"
 #include "graphics.h"
 #include "infrastructure/config/config.h"
+#include "infrastructure/image/rgb_image.h"
 #include <string>
 
 using namespace rgb_matrix;
@@ -19,16 +20,21 @@ public:
     // Utility methods
     void setBrightness(int brightnessLevel);
     
+    // Artwork icon shown instead of the logo (empty image restores the logo)
+    void setIcon(const RgbImage& icon);
+    
 private:
     // Drawing methods
     void clearAndRedraw(const std::string& text);
     void drawSpotifyLogo(int startX, int startY);
+    void drawIcon(int startX, int startY);
     void drawText(const std::string& text, int centerX, int startY);
     
     // Helper methods
     int scaleBrightness(int color) const;
     void loadFonts();
     std::string formatNumber(int number) const;
+    void updateScaledIcon();
     
     // Member variables
     RGBMatrix* matrix_;
@@ -36,6 +42,10 @@ private:
     int brightnessLevel_;
     int brightnessScale_;
     
+    // Artwork, plus a brightness-scaled copy so a frame is just a blit
+    RgbImage icon_;
+    RgbImage scaledIcon_;
+    
     // Fonts (cached for performance)
     rgb_matrix::Font largeFont_;
     rgb_matrix::Font mediumFont_;
@@ -0,0 +1,367 @@
+#include "beat_tracker.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+const int BANDS = 24;
+const double BAND_MIN_HZ = 40.0;
+const double BAND_MAX_HZ = 16000.0;
+const double LOW_BAND_HZ = 250.0;         // Kick and bass, for the beat phase
+const double COMPRESSION = 1000.0;       // log(1 + C * amplitude) per band
+const double STATS_SECONDS = 1.0;        // Flux mean/deviation time constant
+const double ONSET_MEAN_RATIO = 1.25;
+const double ONSET_DEVIATIONS = 2.0;
+const double ONSET_MIN_FLUX = 1.0;
+const double REFRACTORY_SECONDS = 0.1;
+const double MIN_BPM = 60.0;
+const double MAX_BPM = 180.0;
+const double PRIOR_BPM = 120.0;
+const double PRIOR_OCTAVES = 1.0;        // Standard deviation of the prior
+const double MEMORY_SECONDS = 4.0;
+const double LOCK_CONFIDENCE = 0.25;
+const double ACTIVE_SECONDS = 2.0;       // Unlock when onsets stop this long
+const double PHASE_TOLERANCE = 0.15;     // Fraction of a beat period
+const double PHASE_SWITCH_RATIO = 1.5;
+
+} // namespace
+
+BeatTracker::BeatTracker()
+    : fft_(FFT_SIZE), hopsPerSecond_(HOPS_PER_SECOND), hop_(1), sinceHop_(0), writePos_(0),
+      magnitudeScale_(1.0f), history_(FFT_SIZE, 0.0f), window_(FFT_SIZE), frame_(FFT_SIZE),
+      power_(FFT_SIZE / 2 + 1), lowBands_(0), hopIndex_(0), fluxMean_(0.0), fluxDeviation_(0.0),
+      lastOnsetHop_(0), minLag_(1), maxLag_(1), strengthMean_(0.0), energy_(0.0), decay_(0.0),
+      periodHops_(0.0), confidence_(0.0), nextBeatHop_(0.0), lastBeatHop_(0), position_(0),
+      beatPosition_(0), onsets_(0), beats_(0) {
+    // Periodic Hann window; the scale turns a bin back into the amplitude
+    // of a sine
+    double windowSum = 0.0;
+    for (size_t i = 0; i < FFT_SIZE; i++) {
+        window_[i] = (float)(0.5 - 0.5 * std::cos(2.0 * M_PI * (double)i / (double)FFT_SIZE));
+        windowSum += window_[i];
+    }
+    magnitudeScale_ = (float)(2.0 / windowSum);
+    prepare(48000.0);
+}
+
+void BeatTracker::prepare(double sampleRate) {
+    hop_ = (size_t)(sampleRate / HOPS_PER_SECOND + 0.5);
+    if (hop_ == 0) {
+        hop_ = 1;
+    }
+    hopsPerSecond_ = sampleRate / (double)hop_;
+
+    // Bands from BAND_MIN_HZ up, with at least one bin each
+    double binHz = sampleRate / (double)FFT_SIZE;
+    double maxHz = std::min(BAND_MAX_HZ, 0.45 * sampleRate);
+    double ratio = std::pow(maxHz / BAND_MIN_HZ, 1.0 / BANDS);
+    int lastBin = (int)(FFT_SIZE / 2);
+    bandFirst_.clear();
+    bandLast_.clear();
+    int next = 1;
+    for (int b = 0; b < BANDS && next <= lastBin; b++) {
+        int last = (int)(BAND_MIN_HZ * std::pow(ratio, b + 1) / binHz + 0.5);
+        if (last < next) {
+            continue;
+        }
+        bandFirst_.push_back(next);
+        bandLast_.push_back(std::min(last, lastBin));
+        next = last + 1;
+    }
+    previous_.assign(bandFirst_.size(), 0.0f);
+    lowBands_ = 0;
+    while (lowBands_ < bandLast_.size() && (bandLast_[lowBands_] + 0.5) * binHz <= LOW_BAND_HZ) {
+        lowBands_++;
+    }
+
+    minLag_ = (int)std::floor(60.0 * hopsPerSecond_ / MAX_BPM);
+    maxLag_ = (int)std::ceil(60.0 * hopsPerSecond_ / MIN_BPM);
+    if (minLag_ < 2) {
+        minLag_ = 2;
+    }
+    if (maxLag_ < minLag_) {
+        maxLag_ = minLag_;
+    }
+    envelope_.assign(2 * maxLag_ + 2, 0.0f);
+    correlation_.assign(2 * maxLag_ - minLag_ + 3, 0.0);
+
+    prior_.assign(maxLag_ + 1, 0.0);
+    for (int lag = minLag_; lag <= maxLag_; lag++) {
+        double octaves = std::log2(60.0 * hopsPerSecond_ / lag / PRIOR_BPM) / PRIOR_OCTAVES;
+        prior_[lag] = std::exp(-0.5 * octaves * octaves);
+    }
+    decay_ = std::exp(-1.0 / (MEMORY_SECONDS * hopsPerSecond_));
+
+    reset();
+}
+
+void BeatTracker::reset() {
+    std::memset(&history_[0], 0, history_.size() * sizeof(float));
+    std::memset(&previous_[0], 0, previous_.size() * sizeof(float));
+    std::memset(&envelope_[0], 0, envelope_.size() * sizeof(float));
+    std::memset(&correlation_[0], 0, correlation_.size() * sizeof(double));
+    sinceHop_ = 0;
+    writePos_ = 0;
+    hopIndex_ = 0;
+    fluxMean_ = 0.0;
+    fluxDeviation_ = 0.0;
+    lastOnsetHop_ = -(long long)(ACTIVE_SECONDS * hopsPerSecond_) - 1;
+    std::memset(phase_, 0, sizeof(phase_));
+    strengthDelay_[0] = 0.0;
+    strengthDelay_[1] = 0.0;
+    strengthMean_ = 0.0;
+    energy_ = 0.0;
+    periodHops_ = 0.0;
+    confidence_ = 0.0;
+    nextBeatHop_ = 0.0;
+    lastBeatHop_ = lastOnsetHop_;
+    position_ = 0;
+    beatPosition_ = 0;
+    onsets_ = 0;
+    beats_ = 0;
+}
+
+size_t BeatTracker::process(const float* samples, size_t count) {
+    size_t beats = 0;
+    size_t mask = FFT_SIZE - 1;
+
+    while (count > 0) {
+        // Copy up to the next hop (and at most to the end of the history)
+        size_t chunk = hop_ - sinceHop_;
+        if (chunk > count) {
+            chunk = count;
+        }
+        if (chunk > FFT_SIZE - writePos_) {
+            chunk = FFT_SIZE - writePos_;
+        }
+        std::memcpy(&history_[writePos_], samples, chunk * sizeof(float));
+        writePos_ = (writePos_ + chunk) & mask;
+        sinceHop_ += chunk;
+        position_ += chunk;
+        samples += chunk;
+        count -= chunk;
+
+        if (sinceHop_ == hop_) {
+            sinceHop_ = 0;
+            if (analyzeHop()) {
+                beatPosition_ = position_;
+                beats_++;
+                beats++;
+            }
+        }
+    }
+    return beats;
+}
+
+bool BeatTracker::analyzeHop() {
+    // Oldest sample first
+    size_t tail = FFT_SIZE - writePos_;
+    for (size_t i = 0; i < tail; i++) {
+        frame_[i] = history_[writePos_ + i] * window_[i];
+    }
+    for (size_t i = tail; i < FFT_SIZE; i++) {
+        frame_[i] = history_[i - tail] * window_[i];
+    }
+    fft_.powerSpectrum(&frame_[0], &power_[0]);
+
+    // Rectified rise of the log-compressed band magnitudes. Log-spaced
+    // bands keep broadband hats and snares from outweighing a kick that
+    // only moves a few low bins.
+    float gain = (float)COMPRESSION * magnitudeScale_;
+    float flux = 0.0f;
+    float lowFlux = 0.0f;
+    for (size_t b = 0; b < previous_.size(); b++) {
+        if (b == lowBands_) {
+            lowFlux = flux;
+        }
+        float power = 0.0f;
+        for (int k = bandFirst_[b]; k <= bandLast_[b]; k++) {
+            power += power_[k];
+        }
+        float magnitude = std::log1p(gain * std::sqrt(power));
+        float rise = magnitude - previous_[b];
+        if (rise > 0.0f) {
+            flux += rise;
+        }
+        previous_[b] = magnitude;
+    }
+
+    double strength = flux > fluxMean_ ? flux - fluxMean_ : 0.0;
+    bool onset = detectOnset(flux);
+    updateTempo(strength);
+
+    long long now = hopIndex_++;
+    if (!isLocked()) {
+        std::memset(phase_, 0, sizeof(phase_));
+        if (onset) {
+            lastBeatHop_ = now;
+            nextBeatHop_ = now + periodHops_;
+        }
+        return onset;
+    }
+
+    bool beat = false;
+    double tolerance = PHASE_TOLERANCE * periodHops_;
+    if (onset && now >= nextBeatHop_ - tolerance && now - lastBeatHop_ >= periodHops_ / 2) {
+        // On (or just before) the predicted beat: fire now and re-phase
+        beat = true;
+        lastBeatHop_ = now;
+        nextBeatHop_ = now + periodHops_;
+    } else if (onset && now - lastBeatHop_ <= tolerance) {
+        // Just after a predicted beat: move the clock half way to the onset
+        nextBeatHop_ += 0.5 * (double)(now - lastBeatHop_);
+    } else if (now >= nextBeatHop_) {
+        beat = true;
+        lastBeatHop_ = now;
+        nextBeatHop_ += periodHops_;
+        if (nextBeatHop_ <= now) {
+            nextBeatHop_ = now + periodHops_;
+        }
+    }
+
+    accumulatePhase(now, lowFlux);
+    if (beat) {
+        alignPhase(now);
+    }
+    return beat;
+}
+
+void BeatTracker::accumulatePhase(long long now, double lowFlux) {
+    double beats = (double)(now - lastBeatHop_) / periodHops_;
+    int bin = (int)((beats - std::floor(beats)) * PHASE_BINS);
+    if (bin >= PHASE_BINS) {
+        bin = PHASE_BINS - 1;
+    }
+    for (int i = 0; i < PHASE_BINS; i++) {
+        phase_[i] *= decay_;
+    }
+    phase_[bin] += lowFlux;
+}
+
+void BeatTracker::alignPhase(long long now) {
+    // Offbeats (hi-hats, syncopation) also repeat every period, so the
+    // onsets alone can lock the clock half a beat off. Kick and bass mark
+    // the beat more reliably: move the clock when their flux clearly
+    // gathers at another phase.
+    int best = 0;
+    double bestEnergy = 0.0;
+    double onBeat = 0.0;
+    for (int i = 0; i < PHASE_BINS; i++) {
+        double energy = phase_[(i + PHASE_BINS - 1) % PHASE_BINS] + phase_[i] + phase_[(i + 1) % PHASE_BINS];
+        if (i == 0) {
+            onBeat = energy;
+        }
+        if (energy > bestEnergy) {
+            bestEnergy = energy;
+            best = i;
+        }
+    }
+    if (best == 0 || bestEnergy <= PHASE_SWITCH_RATIO * onBeat) {
+        return;
+    }
+
+    double shift = best * periodHops_ / PHASE_BINS;
+    if (shift < periodHops_ / 2) {
+        // Too close to the beat just shown; let the next one come late
+        shift += periodHops_;
+    }
+    nextBeatHop_ = now + shift;
+    std::rotate(phase_, phase_ + best, phase_ + PHASE_BINS);
+}
+
+bool BeatTracker::detectOnset(double flux) {
+    double threshold = ONSET_MEAN_RATIO * fluxMean_ + ONSET_DEVIATIONS * fluxDeviation_ + ONSET_MIN_FLUX;
+    double refractory = REFRACTORY_SECONDS * hopsPerSecond_;
+    bool onset = hopIndex_ > 0 && flux > threshold && (double)(hopIndex_ - lastOnsetHop_) >= refractory;
+    if (onset) {
+        lastOnsetHop_ = hopIndex_;
+        onsets_++;
+    }
+
+    double alpha = 1.0 / (STATS_SECONDS * hopsPerSecond_);
+    if (hopIndex_ == 0) {
+        // Nothing to compare the first hop against
+        fluxMean_ = 0.0;
+    } else {
+        fluxDeviation_ += alpha * (std::fabs(flux - fluxMean_) - fluxDeviation_);
+        fluxMean_ += alpha * (flux - fluxMean_);
+    }
+    return onset;
+}
+
+void BeatTracker::updateTempo(double rawStrength) {
+    // A [1 2 1] / 4 smoothing spreads each onset over neighbouring lags, so
+    // periods between two whole hops still correlate
+    double smoothed = 0.25 * (rawStrength + 2.0 * strengthDelay_[0] + strengthDelay_[1]);
+    strengthDelay_[1] = strengthDelay_[0];
+    strengthDelay_[0] = rawStrength;
+
+    // Without its mean, a steady but aperiodic envelope (noise, crowd)
+    // correlates at no lag instead of at all of them
+    strengthMean_ += (smoothed - strengthMean_) / (STATS_SECONDS * hopsPerSecond_);
+    double strength = smoothed - strengthMean_;
+
+    int size = (int)envelope_.size();
+    int current = (int)(hopIndex_ % size);
+    envelope_[current] = (float)strength;
+
+    // One multiply-add per lag, whatever the tempo
+    for (int lag = minLag_ - 1; lag <= 2 * maxLag_ + 1; lag++) {
+        int index = current - lag;
+        if (index < 0) {
+            index += size;
+        }
+        double& value = correlation_[lag - minLag_ + 1];
+        value = decay_ * value + strength * envelope_[index];
+    }
+    energy_ = decay_ * energy_ + strength * strength;
+
+    // Score each lag by the correlation around it plus around twice it (a
+    // real beat repeats there too); summing three lags keeps periods that
+    // fall between whole hops from losing to their multiples
+    int best = minLag_;
+    double bestScore = -1.0;
+    for (int lag = minLag_; lag <= maxLag_; lag++) {
+        const double* around = &correlation_[lag - minLag_];
+        const double* twice = &correlation_[2 * lag - minLag_];
+        double score = (around[0] + around[1] + around[2] + 0.5 * (twice[0] + twice[1] + twice[2])) * prior_[lag];
+        if (score > bestScore) {
+            bestScore = score;
+            best = lag;
+        }
+    }
+    if (best > minLag_ && correlation_[best - minLag_] > correlation_[best - minLag_ + 1]) {
+        best--;
+    } else if (best < maxLag_ && correlation_[best - minLag_ + 2] > correlation_[best - minLag_ + 1]) {
+        best++;
+    }
+
+    // Parabolic interpolation for a fractional period
+    double before = correlation_[best - minLag_];
+    double peak = correlation_[best - minLag_ + 1];
+    double after = correlation_[best - minLag_ + 2];
+    double curvature = before - 2.0 * peak + after;
+    double offset = curvature < 0.0 ? 0.5 * (before - after) / curvature : 0.0;
+    if (offset > 0.5) {
+        offset = 0.5;
+    } else if (offset < -0.5) {
+        offset = -0.5;
+    }
+    periodHops_ = best + offset;
+    confidence_ = energy_ > 0.0 ? peak / energy_ : 0.0;
+    if (confidence_ < 0.0) {
+        confidence_ = 0.0;
+    } else if (confidence_ > 1.0) {
+        confidence_ = 1.0;
+    }
+}
+
+bool BeatTracker::isLocked() const {
+    return confidence_ >= LOCK_CONFIDENCE && hopIndex_ >= 2 * maxLag_ &&
+           (double)(hopIndex_ - lastOnsetHop_) < ACTIVE_SECONDS * hopsPerSecond_;
+}
+
+double BeatTracker::getTempoBpm() const {
+    return isLocked() && periodHops_ > 0.0 ? 60.0 * hopsPerSecond_ / periodHops_ : 0.0;
+}
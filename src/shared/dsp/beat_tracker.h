@@ -0,0 +1,116 @@
+#ifndef BEAT_TRACKER_H
+#define BEAT_TRACKER_H
+
+#include "shared/dsp/fft.h"
+#include <vector>
+#include <stddef.h>
+
+// Latest beat for the render thread, with the beat time on the monotonic
+// clock
+struct BeatState {
+    long long lastBeatMs;
+    double bpm;          // 0 while the tempo isn't locked (beats are onsets)
+    double confidence;   // 0..1
+    unsigned long beats;
+
+    BeatState() : lastBeatMs(0), bpm(0.0), confidence(0.0), beats(0) {}
+};
+
+// Onset detection and tempo tracking on a stream of float samples, in
+// fixed-cost hops of about 10 ms.
+//
+// Each hop:
+// - Window the latest FFT_SIZE samples and sum their spectrum into 24
+//   log-spaced bands.
+// - Spectral flux is the summed rise of the log-compressed band magnitudes
+//   since the previous hop.
+// - An onset is flux well above its running mean and deviation, outside a
+//   100 ms refractory time. Detection is causal, with no look-ahead.
+// - The flux above its mean feeds an exponentially decaying
+//   autocorrelation (about 4 s of memory), one multiply-add per lag.
+// - The tempo is the 60-180 BPM lag that correlates best, together with
+//   twice that lag, under a log-tempo prior centered on 120 BPM.
+//
+// Once the tempo is confident and onsets keep coming, beats follow a beat
+// clock. An onset near the predicted time fires the beat at once and
+// re-phases the clock; otherwise the beat fires on time. The clock moves
+// to whichever phase collects the most kick and bass flux, so hi-hats on
+// the offbeats don't capture it. Before the tempo locks, every onset counts
+// as a beat.
+class BeatTracker {
+public:
+    static const size_t FFT_SIZE = 1024;
+    static const int HOPS_PER_SECOND = 100;
+
+    BeatTracker();
+
+    void prepare(double sampleRate);
+    void reset();
+
+    // Returns the number of beats in these samples (almost always 0 or 1)
+    size_t process(const float* samples, size_t count);
+
+    // Samples processed since the end of the hop that fired the last beat
+    unsigned long long getSamplesSinceBeat() const { return position_ - beatPosition_; }
+    double getTempoBpm() const;     // 0 until locked
+    double getConfidence() const { return confidence_; }
+    bool isLocked() const;
+    unsigned long getOnsetCount() const { return onsets_; }
+    unsigned long getBeatCount() const { return beats_; }
+    size_t getHop() const { return hop_; }
+
+private:
+    RealFft fft_;
+    double hopsPerSecond_;
+    size_t hop_;
+    size_t sinceHop_;
+    size_t writePos_;
+    float magnitudeScale_;
+
+    std::vector<float> history_;     // Circular, FFT_SIZE samples
+    std::vector<float> window_;
+    std::vector<float> frame_;
+    std::vector<float> power_;
+    std::vector<int> bandFirst_;     // FFT bins of each band
+    std::vector<int> bandLast_;
+    size_t lowBands_;                // Bands below LOW_BAND_HZ
+    std::vector<float> previous_;    // Compressed band magnitudes of the last hop
+
+    // Onsets
+    long long hopIndex_;
+    double fluxMean_;
+    double fluxDeviation_;
+    long long lastOnsetHop_;
+
+    // Tempo: decaying autocorrelation of the onset envelope
+    int minLag_;
+    int maxLag_;
+    double strengthDelay_[2];
+    double strengthMean_;
+    std::vector<float> envelope_;      // Circular, longer than 2 * maxLag_ + 1
+    std::vector<double> correlation_;  // Lags minLag_ - 1 .. 2 * maxLag_ + 1
+    std::vector<double> prior_;
+    double energy_;                    // Lag 0
+    double decay_;
+    double periodHops_;
+    double confidence_;
+
+    // Beat clock, and the low-band flux at each phase of it
+    static const int PHASE_BINS = 16;
+    double phase_[PHASE_BINS];
+    double nextBeatHop_;
+    long long lastBeatHop_;
+    unsigned long long position_;
+    unsigned long long beatPosition_;
+    unsigned long onsets_;
+    unsigned long beats_;
+
+    // Helper methods
+    bool analyzeHop();
+    bool detectOnset(double flux);
+    void updateTempo(double rawStrength);
+    void accumulatePhase(long long now, double lowFlux);
+    void alignPhase(long long now);
+};
+
+#endif // BEAT_TRACKER_H
@@ -0,0 +1,77 @@
+#include "biquad_cascade.h"
+#include <cmath>
+#include <complex>
+
+BiquadCascade::BiquadCascade() : count_(0) {
+    reset();
+}
+
+void BiquadCascade::clear() {
+    count_ = 0;
+    reset();
+}
+
+bool BiquadCascade::addSection(const Biquad& section) {
+    if (count_ >= MAX_SECTIONS) {
+        return false;
+    }
+    sections_[count_++] = section;
+    return true;
+}
+
+void BiquadCascade::scale(double gain) {
+    if (count_ == 0) {
+        addSection(Biquad());
+    }
+    sections_[0].b0 *= gain;
+    sections_[0].b1 *= gain;
+    sections_[0].b2 *= gain;
+}
+
+void BiquadCascade::reset() {
+    for (size_t s = 0; s < MAX_SECTIONS; s++) {
+        state_[s][0] = 0.0;
+        state_[s][1] = 0.0;
+    }
+}
+
+void BiquadCascade::process(const float* in, float* out, size_t count) {
+    if (count_ == 0) {
+        if (in != out) {
+            for (size_t i = 0; i < count; i++) {
+                out[i] = in[i];
+            }
+        }
+        return;
+    }
+
+    const float* src = in;
+    for (size_t s = 0; s < count_; s++) {
+        const Biquad& q = sections_[s];
+        double z1 = state_[s][0];
+        double z2 = state_[s][1];
+        for (size_t i = 0; i < count; i++) {
+            double x = src[i];
+            double y = q.b0 * x + z1;
+            z1 = q.b1 * x - q.a1 * y + z2;
+            z2 = q.b2 * x - q.a2 * y;
+            out[i] = (float)y;
+        }
+        state_[s][0] = z1;
+        state_[s][1] = z2;
+        src = out;
+    }
+}
+
+double BiquadCascade::magnitudeDb(double frequency, double sampleRate) const {
+    const double pi = 3.14159265358979323846;
+    std::complex<double> z1 = std::polar(1.0, -2.0 * pi * frequency / sampleRate);
+    std::complex<double> z2 = z1 * z1;
+
+    std::complex<double> response(1.0, 0.0);
+    for (size_t s = 0; s < count_; s++) {
+        const Biquad& q = sections_[s];
+        response *= (q.b0 + q.b1 * z1 + q.b2 * z2) / (1.0 + q.a1 * z1 + q.a2 * z2);
+    }
+    return 20.0 * std::log10(std::abs(response));
+}
@@ -0,0 +1,46 @@
+#ifndef BIQUAD_CASCADE_H
+#define BIQUAD_CASCADE_H
+
+#include <stddef.h>
+
+// Second-order IIR section, normalized so a0 = 1:
+//   y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+struct Biquad {
+    double b0, b1, b2, a1, a2;
+
+    Biquad() : b0(1.0), b1(0.0), b2(0.0), a1(0.0), a2(0.0) {}
+    Biquad(double nb0, double nb1, double nb2, double na1, double na2)
+        : b0(nb0), b1(nb1), b2(nb2), a1(na1), a2(na2) {}
+};
+
+// A short chain of biquads run block by block. Each section filters the
+// whole block before the next one starts, so its coefficients and state
+// stay in registers for the inner loop. State is kept in double precision
+// (transposed direct form II): weighting filters put poles within a few
+// hertz of DC, where single precision visibly drifts.
+class BiquadCascade {
+public:
+    BiquadCascade();
+
+    // Design
+    void clear();
+    bool addSection(const Biquad& section);
+    void scale(double gain);
+    size_t getSectionCount() const { return count_; }
+
+    // Filtering (in and out may be the same buffer)
+    void reset();
+    void process(const float* in, float* out, size_t count);
+
+    // Response of the designed chain, for checks and diagnostics
+    double magnitudeDb(double frequency, double sampleRate) const;
+
+    static const size_t MAX_SECTIONS = 4;
+
+private:
+    Biquad sections_[MAX_SECTIONS];
+    double state_[MAX_SECTIONS][2];
+    size_t count_;
+};
+
+#endif // BIQUAD_CASCADE_H
@@ -0,0 +1,205 @@
+#include "fft.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// One radix-4 butterfly on element q of the four quarters, forward sign:
+//   y0 = (a + c) + (b + d)         y1 = w1 * ((a - c) - j(b - d))
+//   y2 = w2 * ((a + c) - (b + d))  y3 = w3 * ((a - c) + j(b - d))
+inline void butterfly4(const float* xr, const float* xi, float* yr, float* yi,
+                       size_t in, size_t quarter, size_t out, size_t s, const float* w) {
+    float ar = xr[in], ai = xi[in];
+    float br = xr[in + quarter], bi = xi[in + quarter];
+    float cr = xr[in + 2 * quarter], ci = xi[in + 2 * quarter];
+    float dr = xr[in + 3 * quarter], di = xi[in + 3 * quarter];
+
+    float apcR = ar + cr, apcI = ai + ci;
+    float amcR = ar - cr, amcI = ai - ci;
+    float bpdR = br + dr, bpdI = bi + di;
+    float bmdR = br - dr, bmdI = bi - di;
+
+    float t1R = amcR + bmdI, t1I = amcI - bmdR;
+    float t2R = apcR - bpdR, t2I = apcI - bpdI;
+    float t3R = amcR - bmdI, t3I = amcI + bmdR;
+
+    yr[out] = apcR + bpdR;
+    yi[out] = apcI + bpdI;
+    yr[out + s] = t1R * w[0] - t1I * w[1];
+    yi[out + s] = t1R * w[1] + t1I * w[0];
+    yr[out + 2 * s] = t2R * w[2] - t2I * w[3];
+    yi[out + 2 * s] = t2R * w[3] + t2I * w[2];
+    yr[out + 3 * s] = t3R * w[4] - t3I * w[5];
+    yi[out + 3 * s] = t3R * w[5] + t3I * w[4];
+}
+
+} // namespace
+
+Fft::Fft(size_t size) : size_(size), workRe_(size), workIm_(size) {
+    // Stage twiddles in the order forward() consumes them
+    for (size_t n = size_; n >= 4; n /= 4) {
+        size_t m = n / 4;
+        for (size_t p = 0; p < m; p++) {
+            for (int k = 1; k <= 3; k++) {
+                double angle = -2.0 * M_PI * (double)(k * p) / (double)n;
+                twiddles_.push_back((float)std::cos(angle));
+                twiddles_.push_back((float)std::sin(angle));
+            }
+        }
+    }
+}
+
+void Fft::forward(float* re, float* im) {
+    float* xr = re;
+    float* xi = im;
+    float* yr = &workRe_[0];
+    float* yi = &workIm_[0];
+    const float* w = twiddles_.empty() ? nullptr : &twiddles_[0];
+
+    size_t n = size_;
+    size_t s = 1;  // Stride: number of interleaved sub-transforms
+    while (n >= 4) {
+        size_t m = n / 4;
+        size_t quarter = s * m;
+        for (size_t p = 0; p < m; p++, w += 6) {
+            size_t in = s * p;
+            size_t out = 4 * s * p;
+            size_t q = 0;
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+            if (s >= 4) {
+                float32x4_t w1r = vdupq_n_f32(w[0]), w1i = vdupq_n_f32(w[1]);
+                float32x4_t w2r = vdupq_n_f32(w[2]), w2i = vdupq_n_f32(w[3]);
+                float32x4_t w3r = vdupq_n_f32(w[4]), w3i = vdupq_n_f32(w[5]);
+                for (; q + 4 <= s; q += 4) {
+                    size_t i = in + q;
+                    float32x4_t ar = vld1q_f32(xr + i), ai = vld1q_f32(xi + i);
+                    float32x4_t br = vld1q_f32(xr + i + quarter), bi = vld1q_f32(xi + i + quarter);
+                    float32x4_t cr = vld1q_f32(xr + i + 2 * quarter), ci = vld1q_f32(xi + i + 2 * quarter);
+                    float32x4_t dr = vld1q_f32(xr + i + 3 * quarter), di = vld1q_f32(xi + i + 3 * quarter);
+
+                    float32x4_t apcR = vaddq_f32(ar, cr), apcI = vaddq_f32(ai, ci);
+                    float32x4_t amcR = vsubq_f32(ar, cr), amcI = vsubq_f32(ai, ci);
+                    float32x4_t bpdR = vaddq_f32(br, dr), bpdI = vaddq_f32(bi, di);
+                    float32x4_t bmdR = vsubq_f32(br, dr), bmdI = vsubq_f32(bi, di);
+
+                    float32x4_t t1R = vaddq_f32(amcR, bmdI), t1I = vsubq_f32(amcI, bmdR);
+                    float32x4_t t2R = vsubq_f32(apcR, bpdR), t2I = vsubq_f32(apcI, bpdI);
+                    float32x4_t t3R = vsubq_f32(amcR, bmdI), t3I = vaddq_f32(amcI, bmdR);
+
+                    size_t o = out + q;
+                    vst1q_f32(yr + o, vaddq_f32(apcR, bpdR));
+                    vst1q_f32(yi + o, vaddq_f32(apcI, bpdI));
+                    vst1q_f32(yr + o + s, vmlsq_f32(vmulq_f32(t1R, w1r), t1I, w1i));
+                    vst1q_f32(yi + o + s, vmlaq_f32(vmulq_f32(t1R, w1i), t1I, w1r));
+                    vst1q_f32(yr + o + 2 * s, vmlsq_f32(vmulq_f32(t2R, w2r), t2I, w2i));
+                    vst1q_f32(yi + o + 2 * s, vmlaq_f32(vmulq_f32(t2R, w2i), t2I, w2r));
+                    vst1q_f32(yr + o + 3 * s, vmlsq_f32(vmulq_f32(t3R, w3r), t3I, w3i));
+                    vst1q_f32(yi + o + 3 * s, vmlaq_f32(vmulq_f32(t3R, w3i), t3I, w3r));
+                }
+            }
+#elif defined(__SSE2__)
+            if (s >= 4) {
+                __m128 w1r = _mm_set1_ps(w[0]), w1i = _mm_set1_ps(w[1]);
+                __m128 w2r = _mm_set1_ps(w[2]), w2i = _mm_set1_ps(w[3]);
+                __m128 w3r = _mm_set1_ps(w[4]), w3i = _mm_set1_ps(w[5]);
+                for (; q + 4 <= s; q += 4) {
+                    size_t i = in + q;
+                    __m128 ar = _mm_loadu_ps(xr + i), ai = _mm_loadu_ps(xi + i);
+                    __m128 br = _mm_loadu_ps(xr + i + quarter), bi = _mm_loadu_ps(xi + i + quarter);
+                    __m128 cr = _mm_loadu_ps(xr + i + 2 * quarter), ci = _mm_loadu_ps(xi + i + 2 * quarter);
+                    __m128 dr = _mm_loadu_ps(xr + i + 3 * quarter), di = _mm_loadu_ps(xi + i + 3 * quarter);
+
+                    __m128 apcR = _mm_add_ps(ar, cr), apcI = _mm_add_ps(ai, ci);
+                    __m128 amcR = _mm_sub_ps(ar, cr), amcI = _mm_sub_ps(ai, ci);
+                    __m128 bpdR = _mm_add_ps(br, dr), bpdI = _mm_add_ps(bi, di);
+                    __m128 bmdR = _mm_sub_ps(br, dr), bmdI = _mm_sub_ps(bi, di);
+
+                    __m128 t1R = _mm_add_ps(amcR, bmdI), t1I = _mm_sub_ps(amcI, bmdR);
+                    __m128 t2R = _mm_sub_ps(apcR, bpdR), t2I = _mm_sub_ps(apcI, bpdI);
+                    __m128 t3R = _mm_sub_ps(amcR, bmdI), t3I = _mm_add_ps(amcI, bmdR);
+
+                    size_t o = out + q;
+                    _mm_storeu_ps(yr + o, _mm_add_ps(apcR, bpdR));
+                    _mm_storeu_ps(yi + o, _mm_add_ps(apcI, bpdI));
+                    _mm_storeu_ps(yr + o + s, _mm_sub_ps(_mm_mul_ps(t1R, w1r), _mm_mul_ps(t1I, w1i)));
+                    _mm_storeu_ps(yi + o + s, _mm_add_ps(_mm_mul_ps(t1R, w1i), _mm_mul_ps(t1I, w1r)));
+                    _mm_storeu_ps(yr + o + 2 * s, _mm_sub_ps(_mm_mul_ps(t2R, w2r), _mm_mul_ps(t2I, w2i)));
+                    _mm_storeu_ps(yi + o + 2 * s, _mm_add_ps(_mm_mul_ps(t2R, w2i), _mm_mul_ps(t2I, w2r)));
+                    _mm_storeu_ps(yr + o + 3 * s, _mm_sub_ps(_mm_mul_ps(t3R, w3r), _mm_mul_ps(t3I, w3i)));
+                    _mm_storeu_ps(yi + o + 3 * s, _mm_add_ps(_mm_mul_ps(t3R, w3i), _mm_mul_ps(t3I, w3r)));
+                }
+            }
+#endif
+
+            for (; q < s; q++) {
+                butterfly4(xr, xi, yr, yi, in + q, quarter, out + q, s, w);
+            }
+        }
+
+        std::swap(xr, yr);
+        std::swap(xi, yi);
+        n = m;
+        s *= 4;
+    }
+
+    // Odd power of two: one last radix-2 stage (its twiddle is 1)
+    if (n == 2) {
+        for (size_t q = 0; q < s; q++) {
+            float ar = xr[q], ai = xi[q];
+            float br = xr[q + s], bi = xi[q + s];
+            yr[q] = ar + br;
+            yi[q] = ai + bi;
+            yr[q + s] = ar - br;
+            yi[q + s] = ai - bi;
+        }
+        std::swap(xr, yr);
+        std::swap(xi, yi);
+    }
+
+    if (xr != re) {
+        std::memcpy(re, xr, size_ * sizeof(float));
+        std::memcpy(im, xi, size_ * sizeof(float));
+    }
+}
+
+RealFft::RealFft(size_t size)
+    : size_(size), fft_(size / 2), re_(size / 2), im_(size / 2), cos_(size / 2), sin_(size / 2) {
+    for (size_t k = 0; k < size_ / 2; k++) {
+        double angle = 2.0 * M_PI * (double)k / (double)size_;
+        cos_[k] = (float)std::cos(angle);
+        sin_[k] = (float)std::sin(angle);
+    }
+}
+
+void RealFft::powerSpectrum(const float* input, float* power) {
+    size_t half = size_ / 2;
+    for (size_t n = 0; n < half; n++) {
+        re_[n] = input[2 * n];
+        im_[n] = input[2 * n + 1];
+    }
+    fft_.forward(&re_[0], &im_[0]);
+
+    // Z = FFT(even + j*odd); X[k] = E[k] + e^(-j2pik/N) * O[k] with
+    // E = (Z[k] + conj(Z[half-k])) / 2 and O = (Z[k] - conj(Z[half-k])) / 2j
+    power[0] = (re_[0] + im_[0]) * (re_[0] + im_[0]);
+    power[half] = (re_[0] - im_[0]) * (re_[0] - im_[0]);
+    for (size_t k = 1; k < half; k++) {
+        float ar = re_[k], ai = im_[k];
+        float br = re_[half - k], bi = im_[half - k];
+        float eR = 0.5f * (ar + br);
+        float eI = 0.5f * (ai - bi);
+        float oR = 0.5f * (ai + bi);
+        float oI = -0.5f * (ar - br);
+        float xR = eR + cos_[k] * oR + sin_[k] * oI;
+        float xI = eI + cos_[k] * oI - sin_[k] * oR;
+        power[k] = xR * xR + xI * xI;
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include <vector>
+#include <stddef.h>
+
+// Forward complex FFT for power-of-two sizes, on split real/imaginary
+// arrays.
+//
+// Stockham autosort, radix 4, with one radix-2 stage when log2(size) is
+// odd. Each stage reads one buffer and writes the other, so there is no
+// bit-reversal pass. Every stage after the first walks memory in unit
+// stride, four lanes at a time with SSE2/NEON. Twiddles are precomputed
+// per stage and laid out in the order the stage reads them. No allocation
+// after construction.
+class Fft {
+public:
+    explicit Fft(size_t size);
+
+    // In place; re and im hold size values each
+    void forward(float* re, float* im);
+
+    size_t getSize() const { return size_; }
+
+private:
+    size_t size_;
+    std::vector<float> twiddles_;  // Per stage and p: w1, w2, w3 as (re, im)
+    std::vector<float> workRe_;
+    std::vector<float> workIm_;
+};
+
+// Power spectrum of a real signal: one complex FFT of half the size on the
+// even/odd samples, then a split pass that separates the two halves.
+class RealFft {
+public:
+    explicit RealFft(size_t size);
+
+    // input: size samples; power: size / 2 + 1 bins of |X[k]|^2
+    void powerSpectrum(const float* input, float* power);
+
+    size_t getSize() const { return size_; }
+
+private:
+    size_t size_;
+    Fft fft_;
+    std::vector<float> re_;
+    std::vector<float> im_;
+    std::vector<float> cos_;
+    std::vector<float> sin_;
+};
+
+#endif // FFT_H
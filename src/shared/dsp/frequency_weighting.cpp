@@ -0,0 +1,81 @@
+#include "frequency_weighting.h"
+#include <cmath>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+// IEC 61672-1 pole frequencies (Hz)
+const double F1 = 20.598997;
+const double F2 = 107.65265;
+const double F3 = 737.86223;
+const double F4 = 12194.217;
+
+// Bilinear transform of (B2 s^2 + B1 s + B0) / (A2 s^2 + A1 s + A0)
+Biquad bilinear(double B2, double B1, double B0, double A2, double A1, double A0, double sampleRate) {
+    double k = 2.0 * sampleRate;
+    double k2 = k * k;
+    double a0 = A2 * k2 + A1 * k + A0;
+    return Biquad((B2 * k2 + B1 * k + B0) / a0,
+                  2.0 * (B0 - B2 * k2) / a0,
+                  (B2 * k2 - B1 * k + B0) / a0,
+                  2.0 * (A0 - A2 * k2) / a0,
+                  (A2 * k2 - A1 * k + A0) / a0);
+}
+
+} // namespace
+
+bool FrequencyWeighting::design(Type type, double sampleRate, BiquadCascade& out) {
+    out.clear();
+    if (type == WEIGHTING_Z) {
+        return true;
+    }
+    if (sampleRate <= 0.0) {
+        return false;
+    }
+
+    double w1 = 2.0 * PI * F1;
+
+    // s^2 / (s + w1)^2: the double high-pass pole shared by A and C
+    out.addSection(bilinear(1.0, 0.0, 0.0, 1.0, 2.0 * w1, w1 * w1, sampleRate));
+
+    if (type == WEIGHTING_A) {
+        // s^2 / ((s + w2)(s + w3))
+        double w2 = 2.0 * PI * F2;
+        double w3 = 2.0 * PI * F3;
+        out.addSection(bilinear(1.0, 0.0, 0.0, 1.0, w2 + w3, w2 * w3, sampleRate));
+    }
+
+    // 1 / (s + w4)^2: the double low-pass pole shared by A and C. It is
+    // prewarped so the bilinear transform doesn't pull it noticeably lower;
+    // at rates below 24.4 kHz it lies above Nyquist and is left out.
+    if (sampleRate > 2.0 * F4) {
+        double w4 = 2.0 * sampleRate * std::tan(PI * F4 / sampleRate);
+        out.addSection(bilinear(0.0, 0.0, 1.0, 1.0, 2.0 * w4, w4 * w4, sampleRate));
+    }
+
+    out.scale(std::pow(10.0, -out.magnitudeDb(1000.0, sampleRate) / 20.0));
+    out.reset();
+    return true;
+}
+
+bool FrequencyWeighting::parse(const std::string& name, Type& out) {
+    if (name == "A" || name == "a") {
+        out = WEIGHTING_A;
+    } else if (name == "C" || name == "c") {
+        out = WEIGHTING_C;
+    } else if (name == "Z" || name == "z") {
+        out = WEIGHTING_Z;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+char FrequencyWeighting::letter(Type type) {
+    switch (type) {
+        case WEIGHTING_A: return 'A';
+        case WEIGHTING_C: return 'C';
+        default: return 'Z';
+    }
+}
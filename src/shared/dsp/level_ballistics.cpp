@@ -0,0 +1,94 @@
+#include "level_ballistics.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+const uint16_t MAX_CENTI_DB = 12000;
+const double IMPULSE_DECAY_SECONDS = 1.5;
+
+std::vector<double> buildEnergyTable() {
+    std::vector<double> table(MAX_CENTI_DB + 1);
+    for (size_t i = 0; i < table.size(); i++) {
+        table[i] = std::pow(10.0, i / 1000.0);
+    }
+    return table;
+}
+
+} // namespace
+
+LevelBallistics::LevelBallistics()
+    : mode_(MODE_FAST), average_(0.0), y_(0.0), coefficient_(0.0), decay_(0.0) {
+}
+
+void LevelBallistics::setMode(Mode mode) {
+    mode_ = mode;
+}
+
+void LevelBallistics::prepare(double sampleRate) {
+    setStep(sampleRate > 0.0 ? 1.0 / sampleRate : 0.0);
+}
+
+void LevelBallistics::setStep(double dtSeconds) {
+    coefficients(mode_, dtSeconds, coefficient_, decay_);
+}
+
+void LevelBallistics::coefficients(Mode mode, double dtSeconds, double& coefficient, double& decay) {
+    if (dtSeconds <= 0.0) {
+        // No time has passed: hold everything
+        coefficient = 0.0;
+        decay = 1.0;
+        return;
+    }
+
+    double tauSeconds = mode == MODE_SLOW ? 1.0 : (mode == MODE_IMPULSE ? 0.035 : 0.125);
+    coefficient = 1.0 - std::exp(-dtSeconds / tauSeconds);
+    decay = mode == MODE_IMPULSE ? std::exp(-dtSeconds / IMPULSE_DECAY_SECONDS) : 0.0;
+}
+
+double LevelBallistics::processBlock(const float* x, size_t count) {
+    double average = average_;
+    double y = y_;
+    double peak = y;
+    const double coefficient = coefficient_;
+    const double decay = decay_;
+
+    for (size_t i = 0; i < count; i++) {
+        average += coefficient * ((double)x[i] * x[i] - average);
+        double held = y * decay;
+        y = average > held ? average : held;
+        if (y > peak) {
+            peak = y;
+        }
+    }
+
+    average_ = average;
+    y_ = y;
+    return peak;
+}
+
+bool LevelBallistics::parse(const std::string& name, Mode& out) {
+    if (name == "fast" || name == "F" || name == "f") {
+        out = MODE_FAST;
+    } else if (name == "slow" || name == "S" || name == "s") {
+        out = MODE_SLOW;
+    } else if (name == "impulse" || name == "I" || name == "i") {
+        out = MODE_IMPULSE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+char LevelBallistics::letter(Mode mode) {
+    switch (mode) {
+        case MODE_SLOW: return 'S';
+        case MODE_IMPULSE: return 'I';
+        default: return 'F';
+    }
+}
+
+double LevelBallistics::energyFromCentiDb(uint16_t centiDb) {
+    static const std::vector<double> table = buildEnergyTable();
+    return table[centiDb <= MAX_CENTI_DB ? centiDb : MAX_CENTI_DB];
+}
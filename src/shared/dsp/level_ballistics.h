@@ -0,0 +1,71 @@
+#ifndef LEVEL_BALLISTICS_H
+#define LEVEL_BALLISTICS_H
+
+#include <string>
+#include <stddef.h>
+#include <stdint.h>
+
+// Sound level meter time weighting (IEC 61672 Fast/Slow, plus the classic
+// Impulse detector), as a one-pole average of the mean square:
+//
+//   avg += a * (x^2 - avg),   a = 1 - exp(-dt / tau)
+//
+// Fast and Slow use tau = 125 ms and 1 s. Impulse averages with 35 ms and
+// follows that with a peak detector that falls with a 1.5 s time constant,
+// y = max(avg, y * exp(-dt / 1.5 s)). For Fast/Slow the decay factor is 0, so
+// the same two lines run for every mode: a few multiply-adds per sample,
+// whatever the rate.
+//
+// Two ways to drive it:
+//  - audio at a fixed rate: prepare(sampleRate) once, then processBlock()
+//  - irregular level readings: setStep(dt) with the measured elapsed time,
+//    then step() for each reading (as mean squares, see energyFromCentiDb)
+class LevelBallistics {
+public:
+    enum Mode {
+        MODE_FAST,
+        MODE_SLOW,
+        MODE_IMPULSE
+    };
+
+    LevelBallistics();
+
+    void setMode(Mode mode);
+    Mode getMode() const { return mode_; }
+    void reset(double meanSquare = 0.0) { average_ = y_ = meanSquare; }
+
+    // Fixed-rate use: squares each sample, returns the highest weighted mean
+    // square reached within the block
+    void prepare(double sampleRate);
+    double processBlock(const float* x, size_t count);
+
+    // Irregular use: coefficients for readings dtSeconds apart
+    void setStep(double dtSeconds);
+    void step(double meanSquare) {
+        average_ += coefficient_ * (meanSquare - average_);
+        double held = y_ * decay_;
+        y_ = average_ > held ? average_ : held;
+    }
+
+    double getMeanSquare() const { return y_; }
+
+    // Filter coefficients for one step of dtSeconds (shared with the
+    // multi-channel meter)
+    static void coefficients(Mode mode, double dtSeconds, double& coefficient, double& decay);
+
+    // "fast", "slow" or "impulse" (or F/S/I)
+    static bool parse(const std::string& name, Mode& out);
+    static char letter(Mode mode);
+
+    // 10^(dB/10) for a DbSample value, from a table built on first use
+    static double energyFromCentiDb(uint16_t centiDb);
+
+private:
+    Mode mode_;
+    double average_;
+    double y_;
+    double coefficient_;
+    double decay_;
+};
+
+#endif // LEVEL_BALLISTICS_H
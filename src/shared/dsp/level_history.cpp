@@ -0,0 +1,72 @@
+#include "level_history.h"
+#include <cmath>
+
+LevelHistory::LevelHistory(int capacity, int sliceMs)
+    : slices_(capacity > 0 ? capacity : 1), sliceMs_(sliceMs > 0 ? sliceMs : 1), head_(0), count_(0), sequence_(0),
+      sliceEndMs_(-1), sumEnergy_(0.0), maxDb_(0.0), levels_(0), lastDb_(0.0) {
+}
+
+int LevelHistory::addLevel(double db, long long nowMs) {
+    if (sliceEndMs_ < 0) {
+        sliceEndMs_ = nowMs + sliceMs_;
+    }
+
+    int closed = 0;
+    while (nowMs >= sliceEndMs_) {
+        if (levels_ > 0) {
+            push(maxDb_, 10.0 * std::log10(sumEnergy_ / levels_));
+            sumEnergy_ = 0.0;
+            levels_ = 0;
+        } else {
+            push(lastDb_, lastDb_);
+        }
+        sliceEndMs_ += sliceMs_;
+        closed++;
+
+        // After a long stall, skip straight to the current slice
+        if (closed >= getCapacity()) {
+            long long behind = (nowMs - sliceEndMs_) / sliceMs_;
+            if (behind > 0) {
+                sliceEndMs_ += behind * sliceMs_;
+            }
+        }
+    }
+
+    if (levels_ == 0 || db > maxDb_) {
+        maxDb_ = db;
+    }
+    sumEnergy_ += std::pow(10.0, db / 10.0);
+    levels_++;
+    lastDb_ = db;
+    return closed;
+}
+
+void LevelHistory::reset() {
+    head_ = 0;
+    count_ = 0;
+    sliceEndMs_ = -1;
+    sumEnergy_ = 0.0;
+    levels_ = 0;
+    // Renderers see a whole ring of new slices and redraw
+    sequence_ += getCapacity();
+}
+
+const LevelHistory::Slice& LevelHistory::getSlice(int age) const {
+    int capacity = getCapacity();
+    int index = head_ - 1 - age;
+    if (index < 0) {
+        index += capacity;
+    }
+    return slices_[index];
+}
+
+void LevelHistory::push(double maxDb, double meanDb) {
+    Slice& slice = slices_[head_];
+    slice.maxDb = (float)maxDb;
+    slice.meanDb = (float)meanDb;
+    head_ = (head_ + 1) % getCapacity();
+    if (count_ < getCapacity()) {
+        count_++;
+    }
+    sequence_++;
+}
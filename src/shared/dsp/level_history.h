@@ -0,0 +1,51 @@
+#ifndef LEVEL_HISTORY_H
+#define LEVEL_HISTORY_H
+
+#include <vector>
+
+// Recent level history as a fixed ring of time slices, one per graph
+// column. Levels added during a slice are reduced to its max and its
+// energy mean (Leq) in dB. A slice closes when the next one's time comes.
+// Slices that pass with no level repeat the last level, so the graph
+// keeps scrolling in real time. Nothing allocates after construction.
+class LevelHistory {
+public:
+    struct Slice {
+        float maxDb;
+        float meanDb;
+
+        Slice() : maxDb(0.0f), meanDb(0.0f) {}
+    };
+
+    LevelHistory(int capacity, int sliceMs);
+
+    // Returns the number of slices closed by this call
+    int addLevel(double db, long long nowMs);
+    void reset();
+
+    int getCapacity() const { return (int)slices_.size(); }
+    int getCount() const { return count_; }
+    const Slice& getSlice(int age) const;  // 0 is the newest; age < getCount()
+
+    // Total slices closed so far, so a renderer can tell how many are new
+    unsigned long getSequence() const { return sequence_; }
+
+private:
+    std::vector<Slice> slices_;
+    int sliceMs_;
+    int head_;      // Next slot to write
+    int count_;
+    unsigned long sequence_;
+
+    // Open slice
+    long long sliceEndMs_;
+    double sumEnergy_;
+    double maxDb_;
+    int levels_;
+    double lastDb_;
+
+    // Helper methods
+    void push(double maxDb, double meanDb);
+};
+
+#endif // LEVEL_HISTORY_H
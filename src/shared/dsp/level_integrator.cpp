@@ -0,0 +1,104 @@
+#include "level_integrator.h"
+#include "shared/dsp/level_kernels.h"
+#include <cmath>
+
+LevelIntegrator::LevelIntegrator() {
+    reset();
+}
+
+void LevelIntegrator::reset() {
+    for (int i = 0; i < HISTORY_SECONDS; i++) {
+        history_[i] = 0.0;
+    }
+    historyPos_ = 0;
+    historyCount_ = 0;
+    currentEnergy_ = 0.0;
+    currentSeconds_ = 0.0;
+    sum1m_ = sum15m_ = sum1h_ = 0.0;
+    lastTimeWeighted_ = 0.0;
+    maxTimeWeighted_ = 0.0;
+    peak_ = 0.0f;
+    totalSeconds_ = 0.0;
+}
+
+void LevelIntegrator::addWindow(double meanSquare, double seconds) {
+    totalSeconds_ += seconds;
+
+    // Split the window across second boundaries
+    while (seconds > 0.0) {
+        double take = 1.0 - currentSeconds_;
+        if (take > seconds) {
+            take = seconds;
+        }
+        currentEnergy_ += meanSquare * take;
+        currentSeconds_ += take;
+        seconds -= take;
+        if (currentSeconds_ >= 1.0 - 1e-9) {
+            completeSecond();
+        }
+    }
+}
+
+void LevelIntegrator::addTimeWeighted(double meanSquare) {
+    lastTimeWeighted_ = meanSquare;
+    if (meanSquare > maxTimeWeighted_) {
+        maxTimeWeighted_ = meanSquare;
+    }
+}
+
+void LevelIntegrator::addPeak(float peakAbs) {
+    if (peakAbs > peak_) {
+        peak_ = peakAbs;
+    }
+}
+
+void LevelIntegrator::completeSecond() {
+    history_[historyPos_] = currentEnergy_;
+    historyPos_ = (historyPos_ + 1) % HISTORY_SECONDS;
+    if (historyCount_ < HISTORY_SECONDS) {
+        historyCount_++;
+    }
+    currentEnergy_ = 0.0;
+    currentSeconds_ = 0.0;
+
+    // Newest first, so each shorter sum is a prefix of the longer one
+    sum1m_ = sum15m_ = sum1h_ = 0.0;
+    int index = historyPos_;
+    for (int age = 0; age < historyCount_; age++) {
+        index = index == 0 ? HISTORY_SECONDS - 1 : index - 1;
+        sum1h_ += history_[index];
+        if (age == 59) {
+            sum1m_ = sum1h_;
+        }
+        if (age == 899) {
+            sum15m_ = sum1h_;
+        }
+    }
+    if (historyCount_ < 60) {
+        sum1m_ = sum1h_;
+    }
+    if (historyCount_ < 900) {
+        sum15m_ = sum1h_;
+    }
+}
+
+double LevelIntegrator::leq(double completedEnergy, int completedSeconds, double calibrationDb) const {
+    double seconds = completedSeconds + currentSeconds_;
+    if (seconds <= 0.0) {
+        return 0.0;
+    }
+    return LevelKernels::meanSquareToDb((completedEnergy + currentEnergy_) / seconds, calibrationDb);
+}
+
+void LevelIntegrator::getMetrics(double calibrationDb, LevelMetrics& out) const {
+    int seconds1m = historyCount_ < 60 ? historyCount_ : 60;
+    int seconds15m = historyCount_ < 900 ? historyCount_ : 900;
+
+    out.level = LevelKernels::meanSquareToDb(lastTimeWeighted_, calibrationDb);
+    out.leq1m = leq(sum1m_, seconds1m, calibrationDb);
+    out.leq15m = leq(sum15m_, seconds15m, calibrationDb);
+    out.leq1h = leq(sum1h_, historyCount_, calibrationDb);
+    out.lmax = LevelKernels::meanSquareToDb(maxTimeWeighted_, calibrationDb);
+    out.lpeak = LevelKernels::meanSquareToDb((double)peak_ * peak_, calibrationDb);
+    out.seconds = totalSeconds_;
+}
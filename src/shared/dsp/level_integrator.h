@@ -0,0 +1,64 @@
+#ifndef LEVEL_INTEGRATOR_H
+#define LEVEL_INTEGRATOR_H
+
+#include <stddef.h>
+
+// Snapshot of the integrated levels, in dB SPL
+struct LevelMetrics {
+    char weighting;   // 'A', 'C' or 'Z' (Lpeak is always C-weighted)
+    char timeWeighting; // 'F', 'S' or 'I'
+    double level;     // Current time-weighted level
+    double leq1m;     // Equivalent continuous level over the last minute
+    double leq15m;    // ... last 15 minutes
+    double leq1h;     // ... last hour
+    double lmax;      // Highest time-weighted level since reset (e.g. LAFmax)
+    double lpeak;     // Highest instantaneous C-weighted sample since reset
+    double seconds;   // Audio integrated since reset (Leq windows are partial before they fill)
+
+    LevelMetrics() : weighting('Z'), timeWeighting('F'), level(0), leq1m(0), leq15m(0), leq1h(0), lmax(0), lpeak(0), seconds(0) {}
+};
+
+// Running Leq/Lmax/Lpeak integrators fed with weighted mean squares.
+//
+// Energy is binned per second into an hour-long ring; the three Leq sums are
+// recomputed from the ring as each second completes, so they can't drift
+// the way add-and-subtract running sums do, at a cost of a few thousand
+// additions per second.
+class LevelIntegrator {
+public:
+    LevelIntegrator();
+
+    void reset();
+
+    // meanSquare of a window of `seconds` (full scale = 1.0)
+    void addWindow(double meanSquare, double seconds);
+    // Highest time-weighted mean square (LevelBallistics) within a window;
+    // Lmax is the maximum of the time-weighted level, as IEC 61672 defines it
+    void addTimeWeighted(double meanSquare);
+    // Largest absolute (C-weighted) sample seen in a block
+    void addPeak(float peakAbs);
+
+    void getMetrics(double calibrationDb, LevelMetrics& out) const;
+
+    static const int HISTORY_SECONDS = 3600;
+
+private:
+    double history_[HISTORY_SECONDS];  // Energy (mean square x seconds) per second
+    int historyPos_;
+    int historyCount_;
+
+    double currentEnergy_;   // Partial second
+    double currentSeconds_;
+    double sum1m_, sum15m_, sum1h_;
+
+    double lastTimeWeighted_;
+    double maxTimeWeighted_;
+    float peak_;
+    double totalSeconds_;
+
+    // Helper methods
+    void completeSecond();
+    double leq(double completedEnergy, int completedSeconds, double calibrationDb) const;
+};
+
+#endif // LEVEL_INTEGRATOR_H
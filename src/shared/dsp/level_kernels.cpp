@@ -0,0 +1,119 @@
+#include "level_kernels.h"
+#include <cmath>
+#include <algorithm>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const float PCM_SCALE = 1.0f / 32768.0f;
+
+} // namespace
+
+void LevelKernels::deinterleaveToFloat(const int16_t* in, size_t frames, int stride, int offset, float* out) {
+    size_t i = 0;
+    if (stride == 1) {
+        // Mono: straight widening conversion, 8 samples per step
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        for (; i + 8 <= frames; i += 8) {
+            int16x8_t pcm = vld1q_s16(in + i);
+            vst1q_f32(out + i,     vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(pcm))),  PCM_SCALE));
+            vst1q_f32(out + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(pcm))), PCM_SCALE));
+        }
+#elif defined(__SSE2__)
+        const __m128 scale = _mm_set1_ps(PCM_SCALE);
+        for (; i + 8 <= frames; i += 8) {
+            __m128i pcm = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            // Sign-extend by placing each sample in the high half, then shifting down
+            __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(pcm, pcm), 16);
+            __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(pcm, pcm), 16);
+            _mm_storeu_ps(out + i,     _mm_mul_ps(_mm_cvtepi32_ps(low),  scale));
+            _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+        }
+#endif
+    }
+
+    for (; i < frames; i++) {
+        out[i] = in[i * stride + offset] * PCM_SCALE;
+    }
+}
+
+float LevelKernels::sumSquares(const float* x, size_t count) {
+    size_t i = 0;
+    float sum = 0.0f;
+
+    // Two independent accumulators hide the multiply-add latency
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    for (; i + 8 <= count; i += 8) {
+        float32x4_t a = vld1q_f32(x + i);
+        float32x4_t b = vld1q_f32(x + i + 4);
+        acc0 = vmlaq_f32(acc0, a, a);
+        acc1 = vmlaq_f32(acc1, b, b);
+    }
+    float32x4_t acc = vaddq_f32(acc0, acc1);
+    float lanes[4];
+    vst1q_f32(lanes, acc);
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(__SSE2__)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for (; i + 8 <= count; i += 8) {
+        __m128 a = _mm_loadu_ps(x + i);
+        __m128 b = _mm_loadu_ps(x + i + 4);
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(a, a));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(b, b));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, _mm_add_ps(acc0, acc1));
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#endif
+
+    for (; i < count; i++) {
+        sum += x[i] * x[i];
+    }
+    return sum;
+}
+
+float LevelKernels::peakAbs(const float* x, size_t count) {
+    size_t i = 0;
+    float peak = 0.0f;
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (; i + 4 <= count; i += 4) {
+        acc = vmaxq_f32(acc, vabsq_f32(vld1q_f32(x + i)));
+    }
+    float lanes[4];
+    vst1q_f32(lanes, acc);
+    peak = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+#elif defined(__SSE2__)
+    // Clearing the sign bit is |x|
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 acc = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        acc = _mm_max_ps(acc, _mm_and_ps(_mm_loadu_ps(x + i), absMask));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    peak = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+#endif
+
+    for (; i < count; i++) {
+        peak = std::max(peak, std::fabs(x[i]));
+    }
+    return peak;
+}
+
+double LevelKernels::meanSquareToDb(double meanSquare, double calibrationDb) {
+    if (meanSquare <= 0.0) {
+        return 0.0;
+    }
+    double db = 10.0 * std::log10(meanSquare) + calibrationDb;
+    return db > 0.0 ? db : 0.0;
+}
@@ -0,0 +1,26 @@
+#ifndef LEVEL_KERNELS_H
+#define LEVEL_KERNELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Inner loops of the audio level path, vectorized with NEON on the Pi and
+// SSE2 on x86 (scalar elsewhere). All of them work on caller-owned buffers
+// and never allocate.
+class LevelKernels {
+public:
+    // out[i] = in[i * stride + offset] / 32768, i.e. one channel of
+    // interleaved 16-bit PCM as floats in [-1, 1)
+    static void deinterleaveToFloat(const int16_t* in, size_t frames, int stride, int offset, float* out);
+
+    // Sum of x[i]^2 (single-precision; callers accumulate blocks in double)
+    static float sumSquares(const float* x, size_t count);
+
+    // max |x[i]|
+    static float peakAbs(const float* x, size_t count);
+
+    // 10 * log10(meanSquare) + calibrationDb, floored at 0 dB for silence
+    static double meanSquareToDb(double meanSquare, double calibrationDb);
+};
+
+#endif // LEVEL_KERNELS_H
@@ -0,0 +1,137 @@
+#include "multi_channel_meter.h"
+#include <cmath>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static_assert(MultiChannelMeter::MAX_CHANNELS % 4 == 0, "channels are processed four lanes at a time");
+
+MultiChannelMeter::MultiChannelMeter()
+    : mode_(LevelBallistics::MODE_FAST), bypass_(false), channelCount_(1) {
+    reset(0.0);
+}
+
+void MultiChannelMeter::setMode(LevelBallistics::Mode mode) {
+    mode_ = mode;
+}
+
+void MultiChannelMeter::setBypass(bool bypass) {
+    bypass_ = bypass;
+}
+
+void MultiChannelMeter::reset(double db) {
+    float energy = (float)LevelBallistics::energyFromCentiDb((uint16_t)(db * 100.0 + 0.5));
+    for (int c = 0; c < MAX_CHANNELS; c++) {
+        float start = c == 0 ? energy : 0.0f;
+        sum_[c] = 0.0f;
+        count_[c] = 0.0f;
+        max_[c] = 0.0f;
+        target_[c] = start;
+        average_[c] = start;
+        level_[c] = start;
+    }
+    channelCount_ = 1;
+}
+
+void MultiChannelMeter::advance(double dtSeconds) {
+    double coefficient = 1.0;
+    double decay = 0.0;
+    if (!bypass_) {
+        LevelBallistics::coefficients(mode_, dtSeconds, coefficient, decay);
+    }
+
+    // Only the lanes in use, rounded up to whole vectors
+    int lanes = (channelCount_ + 3) & ~3;
+    int c = 0;
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t coefficientV = vdupq_n_f32((float)coefficient);
+    const float32x4_t decayV = vdupq_n_f32((float)decay);
+    for (; c < lanes; c += 4) {
+        float32x4_t count = vld1q_f32(count_ + c);
+        uint32x4_t has = vcgtq_f32(count, zero);
+
+        float32x4_t frame;
+        if (bypass_) {
+            frame = vld1q_f32(max_ + c);
+        } else {
+            // No vector divide on ARMv7: reciprocal estimate plus two Newton steps
+            float32x4_t divisor = vmaxq_f32(count, one);
+            float32x4_t reciprocal = vrecpeq_f32(divisor);
+            reciprocal = vmulq_f32(vrecpsq_f32(divisor, reciprocal), reciprocal);
+            reciprocal = vmulq_f32(vrecpsq_f32(divisor, reciprocal), reciprocal);
+            frame = vmulq_f32(vld1q_f32(sum_ + c), reciprocal);
+        }
+
+        float32x4_t target = vbslq_f32(has, frame, vld1q_f32(target_ + c));
+        float32x4_t average = vld1q_f32(average_ + c);
+        average = vmlaq_f32(average, coefficientV, vsubq_f32(target, average));
+        float32x4_t level = vmaxq_f32(average, vmulq_f32(vld1q_f32(level_ + c), decayV));
+
+        vst1q_f32(target_ + c, target);
+        vst1q_f32(average_ + c, average);
+        vst1q_f32(level_ + c, level);
+        vst1q_f32(sum_ + c, zero);
+        vst1q_f32(count_ + c, zero);
+        vst1q_f32(max_ + c, zero);
+    }
+#elif defined(__SSE2__)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 coefficientV = _mm_set1_ps((float)coefficient);
+    const __m128 decayV = _mm_set1_ps((float)decay);
+    for (; c < lanes; c += 4) {
+        __m128 count = _mm_load_ps(count_ + c);
+        __m128 has = _mm_cmpgt_ps(count, zero);
+
+        __m128 frame = bypass_ ? _mm_load_ps(max_ + c)
+                               : _mm_div_ps(_mm_load_ps(sum_ + c), _mm_max_ps(count, one));
+
+        __m128 target = _mm_or_ps(_mm_and_ps(has, frame), _mm_andnot_ps(has, _mm_load_ps(target_ + c)));
+        __m128 average = _mm_load_ps(average_ + c);
+        average = _mm_add_ps(average, _mm_mul_ps(coefficientV, _mm_sub_ps(target, average)));
+        __m128 level = _mm_max_ps(average, _mm_mul_ps(_mm_load_ps(level_ + c), decayV));
+
+        _mm_store_ps(target_ + c, target);
+        _mm_store_ps(average_ + c, average);
+        _mm_store_ps(level_ + c, level);
+        _mm_store_ps(sum_ + c, zero);
+        _mm_store_ps(count_ + c, zero);
+        _mm_store_ps(max_ + c, zero);
+    }
+#endif
+
+    for (; c < lanes; c++) {
+        if (count_[c] > 0.0f) {
+            target_[c] = bypass_ ? max_[c] : sum_[c] / count_[c];
+        }
+        average_[c] += (float)coefficient * (target_[c] - average_[c]);
+        float held = level_[c] * (float)decay;
+        level_[c] = average_[c] > held ? average_[c] : held;
+        sum_[c] = 0.0f;
+        count_[c] = 0.0f;
+        max_[c] = 0.0f;
+    }
+}
+
+double MultiChannelMeter::getLevelDb(int channel) const {
+    if (channel < 0 || channel >= MAX_CHANNELS) {
+        return 0.0;
+    }
+    return level_[channel] > 1.0f ? 10.0 * std::log10(level_[channel]) : 0.0;
+}
+
+int MultiChannelMeter::getLoudestChannel() const {
+    int loudest = 0;
+    for (int c = 1; c < channelCount_; c++) {
+        if (level_[c] > level_[loudest]) {
+            loudest = c;
+        }
+    }
+    return loudest;
+}
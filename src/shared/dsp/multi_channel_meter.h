@@ -0,0 +1,70 @@
+#ifndef MULTI_CHANNEL_METER_H
+#define MULTI_CHANNEL_METER_H
+
+#include "shared/dsp/level_ballistics.h"
+#include <stdint.h>
+
+// Time-weighted levels for up to MAX_CHANNELS meter channels (stereo input,
+// venue zones), stored as structure-of-arrays so the per-frame ballistics
+// step updates every channel in one SIMD pass.
+//
+// Readings are binned per channel as they're drained: an energy sum, count
+// and maximum, constant time each. advance() turns each channel's bin into
+// one target, which is the mean energy of its readings or the previous
+// target if none arrived. It then steps the Fast/Slow/Impulse filter by the
+// elapsed time. For frames much shorter than the time constant, averaging
+// the energy first gives the same result as stepping every reading, and
+// keeps the energy of short spikes.
+class MultiChannelMeter {
+public:
+    static const int MAX_CHANNELS = 16;
+
+    MultiChannelMeter();
+
+    void setMode(LevelBallistics::Mode mode);
+    // Readings that are already time-weighted (audio input) skip the filter;
+    // each frame shows its loudest reading instead
+    void setBypass(bool bypass);
+    bool isBypassed() const { return bypass_; }
+
+    // Starts channel 0 at db and the others silent; forgets the channel count
+    void reset(double db);
+
+    void addReading(int channel, uint16_t centiDb) {
+        if (channel < 0 || channel >= MAX_CHANNELS) {
+            return;
+        }
+        float energy = (float)LevelBallistics::energyFromCentiDb(centiDb);
+        sum_[channel] += energy;
+        count_[channel] += 1.0f;
+        if (energy > max_[channel]) {
+            max_[channel] = energy;
+        }
+        if (channel >= channelCount_) {
+            channelCount_ = channel + 1;
+        }
+    }
+
+    // Consumes the binned readings and advances every channel
+    void advance(double dtSeconds);
+
+    // Channels seen so far (highest channel number + 1, at least 1)
+    int getChannelCount() const { return channelCount_; }
+    double getLevelDb(int channel) const;
+    int getLoudestChannel() const;
+
+private:
+    LevelBallistics::Mode mode_;
+    bool bypass_;
+    int channelCount_;
+
+    // One lane per channel
+    alignas(16) float sum_[MAX_CHANNELS];
+    alignas(16) float count_[MAX_CHANNELS];
+    alignas(16) float max_[MAX_CHANNELS];
+    alignas(16) float target_[MAX_CHANNELS];
+    alignas(16) float average_[MAX_CHANNELS];
+    alignas(16) float level_[MAX_CHANNELS];
+};
+
+#endif // MULTI_CHANNEL_METER_H
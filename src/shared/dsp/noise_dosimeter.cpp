@@ -0,0 +1,44 @@
+#include "noise_dosimeter.h"
+#include <cmath>
+
+namespace {
+
+const double REFERENCE_SECONDS = 8.0 * 3600.0;
+
+} // namespace
+
+NoiseDosimeter::NoiseDosimeter(Standard standard) : standard_(standard), dose_(0.0), seconds_(0.0) {
+    if (standard == STANDARD_NIOSH) {
+        criterionDb_ = 85.0;
+        exchangeRateDb_ = 3.0;
+    } else {
+        criterionDb_ = 90.0;
+        exchangeRateDb_ = 5.0;
+    }
+    thresholdDb_ = 80.0;
+}
+
+void NoiseDosimeter::reset() {
+    dose_ = 0.0;
+    seconds_ = 0.0;
+}
+
+void NoiseDosimeter::addLevel(double levelDb, double seconds) {
+    seconds_ += seconds;
+    if (levelDb < thresholdDb_) {
+        return;
+    }
+    // seconds / T(L) with T(L) = 8 h / 2^((L - criterion) / exchange rate)
+    dose_ += seconds * std::pow(2.0, (levelDb - criterionDb_) / exchangeRateDb_) / REFERENCE_SECONDS;
+}
+
+double NoiseDosimeter::getTwa() const {
+    if (dose_ <= 0.0) {
+        return 0.0;
+    }
+    return criterionDb_ + exchangeRateDb_ * std::log2(dose_);
+}
+
+const char* NoiseDosimeter::name(Standard standard) {
+    return standard == STANDARD_NIOSH ? "NIOSH" : "OSHA";
+}
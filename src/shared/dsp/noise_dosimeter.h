@@ -0,0 +1,45 @@
+#ifndef NOISE_DOSIMETER_H
+#define NOISE_DOSIMETER_H
+
+// Occupational noise dose per OSHA (29 CFR 1910.95) or the NIOSH REL.
+//
+// The allowed time at level L halves with every exchange-rate step above
+// the criterion level:
+//
+//   T(L) = 8 h / 2^((L - criterion) / exchangeRate)
+//
+// and the dose is the sum of exposure time over allowed time, in percent.
+// Levels below the threshold don't count. The TWA is the steady 8-hour
+// level that would give the same dose.
+//
+//   OSHA:  criterion 90 dBA, exchange rate 5 dB, threshold 80 dBA
+//   NIOSH: criterion 85 dBA, exchange rate 3 dB, threshold 80 dBA
+class NoiseDosimeter {
+public:
+    enum Standard {
+        STANDARD_OSHA,
+        STANDARD_NIOSH
+    };
+
+    explicit NoiseDosimeter(Standard standard = STANDARD_OSHA);
+
+    void reset();
+    void addLevel(double levelDb, double seconds);
+
+    double getDosePercent() const { return dose_ * 100.0; }
+    double getTwa() const;  // 0 while the dose is 0
+    double getSeconds() const { return seconds_; }
+    Standard getStandard() const { return standard_; }
+
+    static const char* name(Standard standard);
+
+private:
+    Standard standard_;
+    double criterionDb_;
+    double exchangeRateDb_;
+    double thresholdDb_;
+    double dose_;     // Fraction of the allowed daily dose
+    double seconds_;  // Time added since reset
+};
+
+#endif // NOISE_DOSIMETER_H
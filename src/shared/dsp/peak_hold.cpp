@@ -0,0 +1,21 @@
+#include "peak_hold.h"
+
+PeakHold::PeakHold(int holdMs, double decayDbPerSecond)
+    : holdMs_(holdMs), decayDbPerMs_(decayDbPerSecond / 1000.0), value_(0.0), heldAtMs_(0) {
+}
+
+void PeakHold::update(double level, long long nowMs) {
+    if (level >= getValue(nowMs)) {
+        value_ = level;
+        heldAtMs_ = nowMs;
+    }
+}
+
+double PeakHold::getValue(long long nowMs) const {
+    long long decayingMs = nowMs - heldAtMs_ - holdMs_;
+    if (decayingMs <= 0) {
+        return value_;
+    }
+    double value = value_ - decayingMs * decayDbPerMs_;
+    return value > 0.0 ? value : 0.0;
+}
@@ -0,0 +1,23 @@
+#ifndef PEAK_HOLD_H
+#define PEAK_HOLD_H
+
+// Peak marker for a level bar: jumps up to any higher level, holds it for
+// holdMs, then falls at a fixed rate until a new level catches it. Both
+// update() and getValue() are constant time and take the current time from
+// the caller (a monotonic clock), so the decay is independent of frame rate.
+class PeakHold {
+public:
+    PeakHold(int holdMs, double decayDbPerSecond);
+
+    void update(double level, long long nowMs);
+    double getValue(long long nowMs) const;
+    void reset() { value_ = 0.0; heldAtMs_ = 0; }
+
+private:
+    int holdMs_;
+    double decayDbPerMs_;
+    double value_;
+    long long heldAtMs_;
+};
+
+#endif // PEAK_HOLD_H
@@ -0,0 +1,143 @@
+#include "spectrum_analyzer.h"
+#include <cmath>
+#include <cstring>
+
+SpectrumAnalyzer::SpectrumAnalyzer(size_t fftSize, int columns)
+    : fft_(fftSize), columns_(columns), mask_(fftSize - 1), hop_(fftSize), sinceSpectrum_(0), writePos_(0),
+      minHz_(40.0), maxHz_(16000.0), scale_(1.0), calibrationDb_(0.0),
+      history_(fftSize, 0.0f), window_(fftSize), frame_(fftSize), power_(fftSize / 2 + 1),
+      bandFirst_(columns, 0), bandCount_(columns, 0), bandOffset_(columns, 0) {
+    // Periodic Hann window
+    double windowEnergy = 0.0;
+    for (size_t i = 0; i < fftSize; i++) {
+        window_[i] = (float)(0.5 - 0.5 * std::cos(2.0 * M_PI * (double)i / (double)fftSize));
+        windowEnergy += (double)window_[i] * window_[i];
+    }
+    // Parseval with the window's energy: one-sided bins (counted twice)
+    // back to the mean square of the signal
+    scale_ = 2.0 / ((double)fftSize * windowEnergy);
+}
+
+void SpectrumAnalyzer::prepare(double sampleRate, int spectraPerSecond, double minHz, double maxHz) {
+    size_t size = fft_.getSize();
+    hop_ = spectraPerSecond > 0 ? (size_t)(sampleRate / spectraPerSecond) : size;
+    if (hop_ == 0) {
+        hop_ = 1;
+    }
+
+    double binHz = sampleRate / (double)size;
+    if (maxHz > 0.45 * sampleRate) {
+        maxHz = 0.45 * sampleRate;
+    }
+    if (minHz < binHz) {
+        minHz = binHz;
+    }
+    minHz_ = minHz;
+    maxHz_ = maxHz;
+
+    bandWeights_.clear();
+    int lastBin = (int)(size / 2);
+    double ratio = std::pow(maxHz / minHz, 1.0 / columns_);
+    for (int c = 0; c < columns_; c++) {
+        double low = minHz * std::pow(ratio, c);
+        double high = low * ratio;
+        bandOffset_[c] = (int)bandWeights_.size();
+
+        if (high - low < binHz) {
+            // Narrower than a bin: interpolate between the nearest two
+            double position = std::sqrt(low * high) / binHz;
+            int bin = (int)position;
+            double fraction = position - bin;
+            bandFirst_[c] = bin;
+            bandCount_[c] = bin < lastBin ? 2 : 1;
+            bandWeights_.push_back((float)(1.0 - fraction));
+            if (bin < lastBin) {
+                bandWeights_.push_back((float)fraction);
+            }
+        } else {
+            // Bin k covers (k - 0.5) to (k + 0.5) bin widths; weight by overlap
+            int first = (int)(low / binHz + 0.5);
+            int last = (int)(high / binHz + 0.5);
+            if (last > lastBin) {
+                last = lastBin;
+            }
+            bandFirst_[c] = first;
+            bandCount_[c] = last - first + 1;
+            for (int k = first; k <= last; k++) {
+                double binLow = (k - 0.5) * binHz;
+                double binHigh = (k + 0.5) * binHz;
+                double overlap = (high < binHigh ? high : binHigh) - (low > binLow ? low : binLow);
+                bandWeights_.push_back(overlap > 0.0 ? (float)(overlap / binHz) : 0.0f);
+            }
+        }
+    }
+
+    reset();
+}
+
+void SpectrumAnalyzer::reset() {
+    std::memset(&history_[0], 0, history_.size() * sizeof(float));
+    writePos_ = 0;
+    sinceSpectrum_ = 0;
+}
+
+size_t SpectrumAnalyzer::process(const float* samples, size_t count, float* columnsDb) {
+    size_t spectra = 0;
+    size_t size = history_.size();
+
+    while (count > 0) {
+        // Copy up to the next spectrum (and at most to the end of the history)
+        size_t chunk = hop_ - sinceSpectrum_;
+        if (chunk > count) {
+            chunk = count;
+        }
+        if (chunk > size - writePos_) {
+            chunk = size - writePos_;
+        }
+        std::memcpy(&history_[writePos_], samples, chunk * sizeof(float));
+        writePos_ = (writePos_ + chunk) & mask_;
+        sinceSpectrum_ += chunk;
+        samples += chunk;
+        count -= chunk;
+
+        if (sinceSpectrum_ == hop_) {
+            analyze(columnsDb, spectra > 0);
+            sinceSpectrum_ = 0;
+            spectra++;
+        }
+    }
+    return spectra;
+}
+
+void SpectrumAnalyzer::analyze(float* columnsDb, bool combine) {
+    // Oldest sample first
+    size_t size = history_.size();
+    size_t tail = size - writePos_;
+    for (size_t i = 0; i < tail; i++) {
+        frame_[i] = history_[writePos_ + i] * window_[i];
+    }
+    for (size_t i = tail; i < size; i++) {
+        frame_[i] = history_[i - tail] * window_[i];
+    }
+
+    fft_.powerSpectrum(&frame_[0], &power_[0]);
+
+    for (int c = 0; c < columns_; c++) {
+        const float* weights = &bandWeights_[bandOffset_[c]];
+        const float* power = &power_[bandFirst_[c]];
+        double energy = 0.0;
+        for (int i = 0; i < bandCount_[c]; i++) {
+            energy += (double)weights[i] * power[i];
+        }
+        energy *= scale_;
+        float db = (float)(10.0 * std::log10(energy > 1e-20 ? energy : 1e-20) + calibrationDb_);
+        if (!combine || db > columnsDb[c]) {
+            columnsDb[c] = db;
+        }
+    }
+}
+
+double SpectrumAnalyzer::getColumnFrequency(int column) const {
+    double ratio = std::pow(maxHz_ / minHz_, 1.0 / columns_);
+    return minHz_ * std::pow(ratio, column + 0.5);
+}
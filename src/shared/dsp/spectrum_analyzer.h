@@ -0,0 +1,67 @@
+#ifndef SPECTRUM_ANALYZER_H
+#define SPECTRUM_ANALYZER_H
+
+#include "shared/dsp/fft.h"
+#include <vector>
+#include <stddef.h>
+
+// Turns a stream of float samples into log-frequency band levels, one value
+// per display column.
+//
+// Samples go into a history of fftSize samples (a power of two). Every hop
+// samples (sample rate / spectra per second), the latest history is
+// Hann-windowed and transformed. Bin power is then summed into columns with log-spaced edges
+// between minHz and maxHz. Bins that straddle a column edge are split by
+// overlap. Columns narrower than one bin take the power interpolated
+// between the two nearest bins, so low notes don't read quieter just
+// because their columns are narrow. Levels are in dB like the meter: a
+// full-scale sine's band reads calibration - 3 dB.
+class SpectrumAnalyzer {
+public:
+    static const size_t DEFAULT_FFT_SIZE = 2048;
+
+    SpectrumAnalyzer(size_t fftSize = DEFAULT_FFT_SIZE, int columns = 96);
+
+    // maxHz is capped just below Nyquist
+    void prepare(double sampleRate, int spectraPerSecond, double minHz = 40.0, double maxHz = 16000.0);
+    void setCalibrationDb(double calibrationDb) { calibrationDb_ = calibrationDb; }
+    void reset();
+
+    // Returns the number of spectra completed; columnsDb (getColumns()
+    // values) gets each column's highest level over them
+    size_t process(const float* samples, size_t count, float* columnsDb);
+
+    int getColumns() const { return columns_; }
+    size_t getFftSize() const { return fft_.getSize(); }
+    size_t getHop() const { return hop_; }
+    double getColumnFrequency(int column) const;  // Geometric center, Hz
+
+private:
+    RealFft fft_;
+    int columns_;
+    size_t mask_;
+    size_t hop_;
+    size_t sinceSpectrum_;
+    size_t writePos_;
+    double minHz_;
+    double maxHz_;
+    double scale_;          // Bin power to mean square
+    double calibrationDb_;
+
+    std::vector<float> history_;  // Circular, fftSize samples
+    std::vector<float> window_;
+    std::vector<float> frame_;
+    std::vector<float> power_;
+
+    // Column c sums bandWeights_[bandOffset_[c] + i] * power_[bandFirst_[c] + i]
+    // for i < bandCount_[c]
+    std::vector<int> bandFirst_;
+    std::vector<int> bandCount_;
+    std::vector<int> bandOffset_;
+    std::vector<float> bandWeights_;
+
+    // Helper methods
+    void analyze(float* columnsDb, bool combine);
+};
+
+#endif // SPECTRUM_ANALYZER_H
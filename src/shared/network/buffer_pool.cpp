@@ -0,0 +1,118 @@
+#include "buffer_pool.h"
+
+std::atomic<unsigned long> BufferPool::bufferGrowthCount_(0);
+
+BufferPool::Buffer::Buffer() : pool_(nullptr), storage_(new std::string()) {
+}
+
+BufferPool::Buffer::Buffer(BufferPool* pool, std::string* storage) : pool_(pool), storage_(storage) {
+}
+
+BufferPool::Buffer::Buffer(Buffer&& other) : pool_(other.pool_), storage_(other.storage_) {
+    other.pool_ = nullptr;
+    other.storage_ = nullptr;
+}
+
+BufferPool::Buffer& BufferPool::Buffer::operator=(Buffer&& other) {
+    if (this != &other) {
+        release();
+        pool_ = other.pool_;
+        storage_ = other.storage_;
+        other.pool_ = nullptr;
+        other.storage_ = nullptr;
+    }
+    return *this;
+}
+
+BufferPool::Buffer::~Buffer() {
+    release();
+}
+
+void BufferPool::Buffer::release() {
+    if (!storage_) return;
+    
+    if (pool_) {
+        pool_->recycle(storage_);
+    } else {
+        delete storage_;
+    }
+    pool_ = nullptr;
+    storage_ = nullptr;
+}
+
+BufferPool::BufferPool(size_t maxPooled, size_t initialCapacity)
+    : maxPooled_(maxPooled), initialCapacity_(initialCapacity) {
+}
+
+BufferPool::~BufferPool() {
+    for (size_t i = 0; i < free_.size(); i++) {
+        delete free_[i];
+    }
+}
+
+BufferPool::Buffer BufferPool::acquire(size_t sizeHint) {
+    std::string* storage = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty()) {
+            storage = free_.back();
+            free_.pop_back();
+        }
+    }
+    
+    size_t wanted = sizeHint > initialCapacity_ ? sizeHint : initialCapacity_;
+    if (!storage) {
+        storage = new std::string();
+        storage->reserve(wanted);
+        recordBufferGrowth();
+    } else if (storage->capacity() < wanted) {
+        storage->reserve(wanted);
+        recordBufferGrowth();
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        checkedOut_.insert(storage);
+    }
+    return Buffer(this, storage);
+}
+
+BufferPool& BufferPool::shared() {
+    static BufferPool pool;
+    return pool;
+}
+
+void BufferPool::recordBufferGrowth() {
+    bufferGrowthCount_++;
+}
+
+unsigned long BufferPool::getBufferGrowthCount() {
+    return bufferGrowthCount_.load();
+}
+
+void BufferPool::resetBufferGrowthCount() {
+    bufferGrowthCount_ = 0;
+}
+
+bool BufferPool::owns(const std::string* storage) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return checkedOut_.count(storage) != 0;
+}
+
+size_t BufferPool::getPooledCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return free_.size();
+}
+
+void BufferPool::recycle(std::string* storage) {
+    // Keep the capacity, drop the contents
+    storage->clear();
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    checkedOut_.erase(storage);
+    if (free_.size() < maxPooled_) {
+        free_.push_back(storage);
+    } else {
+        delete storage;
+    }
+}
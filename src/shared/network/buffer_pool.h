@@ -0,0 +1,80 @@
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <string>
+#include <vector>
+#include <set>
+#include <mutex>
+#include <atomic>
+
+// Pool of reusable response buffers. Buffers keep their capacity when they are
+// returned, so steady-state requests append into already-reserved memory.
+class BufferPool {
+public:
+    // Move-only handle; the buffer goes back to the pool when the handle dies
+    class Buffer {
+    public:
+        Buffer();
+        Buffer(Buffer&& other);
+        Buffer& operator=(Buffer&& other);
+        ~Buffer();
+        
+        std::string& str() { return *storage_; }
+        const std::string& str() const { return *storage_; }
+        const char* data() const { return storage_->data(); }
+        size_t size() const { return storage_->size(); }
+        
+        // Return the buffer to the pool early
+        void release();
+        
+    private:
+        friend class BufferPool;
+        Buffer(BufferPool* pool, std::string* storage);
+        
+        BufferPool* pool_;
+        std::string* storage_;
+        
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+    };
+    
+    BufferPool(size_t maxPooled = 8, size_t initialCapacity = 16 * 1024);
+    ~BufferPool();
+    
+    // Get an empty buffer with at least sizeHint bytes reserved
+    Buffer acquire(size_t sizeHint = 0);
+    
+    // Process-wide pool used by the API clients
+    static BufferPool& shared();
+    
+    // True while storage is checked out of this pool through a Buffer
+    bool owns(const std::string* storage) const;
+    
+    // Counts pooled buffer growths: fresh buffers, reservations and every
+    // capacity growth the network layer sees while a response comes into a
+    // pooled buffer. Plain response strings and other heap allocations aren't
+    // counted; 0 per refresh means every response fit in memory reserved on
+    // an earlier one.
+    static void recordBufferGrowth();
+    static unsigned long getBufferGrowthCount();
+    static void resetBufferGrowthCount();
+    
+    size_t getPooledCount() const;
+    
+private:
+    void recycle(std::string* storage);
+    
+    std::vector<std::string*> free_;
+    std::set<const std::string*> checkedOut_;
+    mutable std::mutex mutex_;
+    size_t maxPooled_;
+    size_t initialCapacity_;
+    
+    static std::atomic<unsigned long> bufferGrowthCount_;
+    
+    // Disable copy constructor and assignment operator
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+};
+
+#endif // BUFFER_POOL_H
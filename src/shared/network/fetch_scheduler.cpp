@@ -0,0 +1,249 @@
+#include "fetch_scheduler.h"
+
+FetchScheduler::FetchScheduler(int workerCount)
+    : workerCount_(workerCount > 0 ? workerCount : 1), running_(false),
+      random_(std::random_device()()), completedCount_(0), coalescedCount_(0) {
+}
+
+FetchScheduler::~FetchScheduler() {
+    stop();
+}
+
+void FetchScheduler::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return;
+    }
+
+    running_ = true;
+    for (int i = 0; i < workerCount_; i++) {
+        workers_.push_back(std::thread(&FetchScheduler::workerLoop, this));
+    }
+}
+
+void FetchScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+
+    wakeCondition_.notify_all();
+    for (size_t i = 0; i < workers_.size(); i++) {
+        if (workers_[i].joinable()) {
+            workers_[i].join();
+        }
+    }
+    workers_.clear();
+}
+
+bool FetchScheduler::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+}
+
+void FetchScheduler::addSource(const std::string& key, int intervalMs, int jitterMs, FetchJob job) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Source& source = sources_[key];
+    source.job = job;
+    source.intervalMs = intervalMs;
+    source.jitterMs = jitterMs > 0 ? jitterMs : 0;
+    scheduleNext(key, source, Clock::now());
+
+    wakeCondition_.notify_one();
+}
+
+void FetchScheduler::removeSource(const std::string& key) {
+    // Must not be called from inside a fetch job (the worker would wait on itself)
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    std::map<std::string, Source>::iterator it = sources_.find(key);
+    if (it == sources_.end()) {
+        return;
+    }
+
+    while (it->second.inFlight) {
+        idleCondition_.wait(lock);
+        it = sources_.find(key);
+        if (it == sources_.end()) {
+            return;
+        }
+    }
+
+    // Heap and queue entries for the key become stale and are skipped lazily
+    sources_.erase(it);
+}
+
+void FetchScheduler::setInterval(const std::string& key, int intervalMs, int jitterMs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::map<std::string, Source>::iterator it = sources_.find(key);
+    if (it == sources_.end()) {
+        return;
+    }
+
+    it->second.intervalMs = intervalMs;
+    it->second.jitterMs = jitterMs > 0 ? jitterMs : 0;
+    if (!it->second.inFlight) {
+        scheduleNext(key, it->second, Clock::now());
+        wakeCondition_.notify_one();
+    }
+}
+
+bool FetchScheduler::hasSource(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sources_.find(key) != sources_.end();
+}
+
+size_t FetchScheduler::getSourceCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sources_.size();
+}
+
+bool FetchScheduler::requestRefresh(const std::string& key, Priority priority) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::map<std::string, Source>::iterator it = sources_.find(key);
+    if (it == sources_.end()) {
+        return false;
+    }
+
+    Source& source = it->second;
+    if (source.inFlight || source.queued) {
+        // Single-flight: the pending fetch will deliver the fresh result
+        coalescedCount_++;
+        return false;
+    }
+
+    if (priority == PRIORITY_USER) {
+        source.queued = true;
+        userQueue_.push_back(key);
+    } else {
+        DueEntry entry;
+        entry.due = Clock::now();
+        entry.key = key;
+        entry.generation = ++source.generation;
+        dueHeap_.push(entry);
+    }
+
+    wakeCondition_.notify_one();
+    return true;
+}
+
+bool FetchScheduler::isInFlight(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::map<std::string, Source>::const_iterator it = sources_.find(key);
+    return it != sources_.end() && (it->second.inFlight || it->second.queued);
+}
+
+unsigned long FetchScheduler::getCompletedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return completedCount_;
+}
+
+unsigned long FetchScheduler::getCoalescedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return coalescedCount_;
+}
+
+void FetchScheduler::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        std::string key;
+        FetchJob job;
+        if (!popNextJob(key, job, lock)) {
+            return; // Stopped
+        }
+
+        // Run the fetch without holding the lock
+        lock.unlock();
+        if (job) {
+            job();
+        }
+        lock.lock();
+
+        completedCount_++;
+        std::map<std::string, Source>::iterator it = sources_.find(key);
+        if (it != sources_.end()) {
+            it->second.inFlight = false;
+            // Background polling restarts from the completed fetch
+            scheduleNext(key, it->second, Clock::now());
+        }
+        idleCondition_.notify_all();
+    }
+}
+
+void FetchScheduler::scheduleNext(const std::string& key, Source& source, Clock::time_point from) {
+    // Bump the generation so any older heap entry for this key is ignored
+    source.generation++;
+
+    if (source.intervalMs <= 0) {
+        return;
+    }
+
+    int delayMs = source.intervalMs;
+    if (source.jitterMs > 0) {
+        std::uniform_int_distribution<int> jitter(-source.jitterMs, source.jitterMs);
+        delayMs += jitter(random_);
+        if (delayMs < 0) delayMs = 0;
+    }
+
+    DueEntry entry;
+    entry.due = from + std::chrono::milliseconds(delayMs);
+    entry.key = key;
+    entry.generation = source.generation;
+    source.nextDue = entry.due;
+    dueHeap_.push(entry);
+}
+
+bool FetchScheduler::popNextJob(std::string& key, FetchJob& job, std::unique_lock<std::mutex>& lock) {
+    while (running_) {
+        // User-initiated refreshes always go first
+        if (!userQueue_.empty()) {
+            key = userQueue_.front();
+            userQueue_.pop_front();
+
+            std::map<std::string, Source>::iterator it = sources_.find(key);
+            if (it == sources_.end() || !it->second.queued) {
+                continue; // Source was removed
+            }
+
+            it->second.queued = false;
+            it->second.inFlight = true;
+            job = it->second.job;
+            return true;
+        }
+
+        if (dueHeap_.empty()) {
+            wakeCondition_.wait(lock);
+            continue;
+        }
+
+        const DueEntry& top = dueHeap_.top();
+        std::map<std::string, Source>::iterator it = sources_.find(top.key);
+        if (it == sources_.end() || it->second.generation != top.generation ||
+            it->second.inFlight || it->second.queued) {
+            dueHeap_.pop(); // Stale entry
+            continue;
+        }
+
+        Clock::time_point due = top.due;
+        if (due > Clock::now()) {
+            wakeCondition_.wait_until(lock, due);
+            continue;
+        }
+
+        key = top.key;
+        dueHeap_.pop();
+        it->second.inFlight = true;
+        job = it->second.job;
+        return true;
+    }
+
+    return false;
+}
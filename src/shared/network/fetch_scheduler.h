@@ -0,0 +1,107 @@
+#ifndef FETCH_SCHEDULER_H
+#define FETCH_SCHEDULER_H
+
+#include <string>
+#include <map>
+#include <deque>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <random>
+#include <chrono>
+
+// Owns every background data source (YouTube channels, Spotify artists, ...)
+// and runs their fetch jobs on a worker thread so rendering never blocks.
+//
+// - Each source is polled on its own interval with +/- jitter.
+// - Refresh requests for a key that is already queued or in flight are
+//   coalesced into that single fetch (single-flight).
+// - User-initiated refreshes jump ahead of due background polls.
+class FetchScheduler {
+public:
+    enum Priority {
+        PRIORITY_BACKGROUND = 0,
+        PRIORITY_USER = 1
+    };
+
+    // Fetch job for one source. Runs on the worker thread; it is responsible
+    // for handing its result back to the owner (e.g. via a mailbox).
+    typedef std::function<void()> FetchJob;
+
+    FetchScheduler(int workerCount = 1);
+    ~FetchScheduler();
+
+    // Lifecycle
+    void start();
+    void stop();
+    bool isRunning() const;
+
+    // Source registration. intervalMs <= 0 disables background polling for
+    // the source, leaving only explicit refresh requests.
+    void addSource(const std::string& key, int intervalMs, int jitterMs, FetchJob job);
+    void removeSource(const std::string& key); // Waits for an in-flight fetch of key
+    void setInterval(const std::string& key, int intervalMs, int jitterMs);
+    bool hasSource(const std::string& key) const;
+    size_t getSourceCount() const;
+
+    // Request a fetch now. Returns false if the request was coalesced into a
+    // fetch that is already queued or in flight (or the key is unknown).
+    bool requestRefresh(const std::string& key, Priority priority = PRIORITY_USER);
+    bool isInFlight(const std::string& key) const;
+
+    // Counters (for diagnostics and simulation)
+    unsigned long getCompletedCount() const;
+    unsigned long getCoalescedCount() const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Source {
+        FetchJob job;
+        int intervalMs;
+        int jitterMs;
+        Clock::time_point nextDue;
+        unsigned long generation;  // Invalidates stale heap entries
+        bool queued;               // Waiting in the user queue
+        bool inFlight;
+
+        Source() : intervalMs(0), jitterMs(0), generation(0), queued(false), inFlight(false) {}
+    };
+
+    struct DueEntry {
+        Clock::time_point due;
+        std::string key;
+        unsigned long generation;
+
+        bool operator>(const DueEntry& other) const { return due > other.due; }
+    };
+
+    std::map<std::string, Source> sources_;
+    std::deque<std::string> userQueue_;
+    std::priority_queue<DueEntry, std::vector<DueEntry>, std::greater<DueEntry> > dueHeap_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wakeCondition_;
+    std::condition_variable idleCondition_;
+    std::vector<std::thread> workers_;
+    int workerCount_;
+    bool running_;
+    std::mt19937 random_;
+
+    unsigned long completedCount_;
+    unsigned long coalescedCount_;
+
+    // Helper methods (called with mutex_ held unless noted)
+    void workerLoop();
+    void scheduleNext(const std::string& key, Source& source, Clock::time_point from);
+    bool popNextJob(std::string& key, FetchJob& job, std::unique_lock<std::mutex>& lock);
+
+    // Disable copy constructor and assignment operator
+    FetchScheduler(const FetchScheduler&) = delete;
+    FetchScheduler& operator=(const FetchScheduler&) = delete;
+};
+
+#endif // FETCH_SCHEDULER_H
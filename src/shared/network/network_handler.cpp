@@ -1,13 +1,18 @@
 #include "network_handler.h"
+#include "buffer_pool.h"
+#include "network_stats.h"
 #include <curl/curl.h>
 #include <iostream>
 #include <sstream>
+#include <cstdlib>
+#include <strings.h>
 
 class NetworkHandler::Impl {
 public:
     CURL* curl_;
     std::string lastError_;
     int lastHttpCode_;
+    RequestTiming lastTiming_;
     int timeoutSeconds_;
     std::string userAgent_;
     
@@ -36,11 +41,120 @@ public:
         curl_easy_setopt(curl_, CURLOPT_SSL_VERIFYHOST, 2L);
     }
     
-    static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* userp) {
+    // Where the write/header callbacks put the body. Growth is only counted
+    // for pooled buffers; plain strings callers pass in aren't the pool's
+    struct ResponseSink {
+        std::string* response;
+        bool pooled;
+    };
+    
+    static size_t WriteCallback(void* contents, size_t size, size_t nmemb, ResponseSink* sink) {
         size_t totalSize = size * nmemb;
+        std::string* userp = sink->response;
+        size_t capacityBefore = userp->capacity();
         userp->append((char*)contents, totalSize);
+        if (sink->pooled && userp->capacity() != capacityBefore) {
+            BufferPool::recordBufferGrowth();
+        }
         return totalSize;
     }
+    
+    // Reserve the response buffer up front when the server sends Content-Length
+    static size_t HeaderCallback(char* buffer, size_t size, size_t nitems, ResponseSink* sink) {
+        size_t totalSize = size * nitems;
+        static const char kContentLength[] = "content-length:";
+        const size_t prefixLen = sizeof(kContentLength) - 1;
+        
+        if (totalSize > prefixLen && strncasecmp(buffer, kContentLength, prefixLen) == 0) {
+            std::string value(buffer + prefixLen, totalSize - prefixLen);
+            long long length = std::atoll(value.c_str());
+            std::string* userp = sink->response;
+            if (length > 0 && (size_t)length > userp->capacity()) {
+                userp->reserve((size_t)length);
+                if (sink->pooled) {
+                    BufferPool::recordBufferGrowth();
+                }
+            }
+        }
+        return totalSize;
+    }
+    
+    // Shared tail of every request: hook up the response buffer, perform the
+    // transfer, record its timing and translate curl/HTTP failures into lastError_
+    bool perform(const std::string& url, std::string& response) {
+        bool ok = performTransfer(response);
+        captureTiming(ok);
+        NetworkStats::shared().record(url, lastTiming_);
+        return ok;
+    }
+    
+    bool performTransfer(std::string& response) {
+        ResponseSink sink;
+        sink.response = &response;
+        sink.pooled = BufferPool::shared().owns(&response);
+        
+        curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, WriteCallback);
+        curl_easy_setopt(curl_, CURLOPT_WRITEDATA, &sink);
+        curl_easy_setopt(curl_, CURLOPT_HEADERFUNCTION, HeaderCallback);
+        curl_easy_setopt(curl_, CURLOPT_HEADERDATA, &sink);
+        
+        // Perform the request
+        CURLcode res = curl_easy_perform(curl_);
+        
+        if (res != CURLE_OK) {
+            lastError_ = curl_easy_strerror(res);
+            return false;
+        }
+        
+        // Get HTTP response code
+        long httpCode = 0;
+        curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &httpCode);
+        lastHttpCode_ = (int)httpCode;
+        
+        // Check for HTTP errors
+        if (lastHttpCode_ >= 400) {
+            lastError_ = "HTTP " + std::to_string(lastHttpCode_);
+            return false;
+        }
+        
+        return true;
+    }
+    
+    void captureTiming(bool ok) {
+        // curl reports cumulative seconds since the start of the transfer
+        double lookup = 0, connect = 0, appConnect = 0, startTransfer = 0, total = 0;
+        curl_easy_getinfo(curl_, CURLINFO_NAMELOOKUP_TIME, &lookup);
+        curl_easy_getinfo(curl_, CURLINFO_CONNECT_TIME, &connect);
+        curl_easy_getinfo(curl_, CURLINFO_APPCONNECT_TIME, &appConnect);
+        curl_easy_getinfo(curl_, CURLINFO_STARTTRANSFER_TIME, &startTransfer);
+        curl_easy_getinfo(curl_, CURLINFO_TOTAL_TIME, &total);
+        
+        curl_off_t down = 0, up = 0;
+        long newConnections = 0, responseCode = 0;
+        curl_easy_getinfo(curl_, CURLINFO_SIZE_DOWNLOAD_T, &down);
+        curl_easy_getinfo(curl_, CURLINFO_SIZE_UPLOAD_T, &up);
+        curl_easy_getinfo(curl_, CURLINFO_NUM_CONNECTS, &newConnections);
+        curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &responseCode);
+        
+        // APPCONNECT is 0 without TLS; the request goes out after whichever
+        // handshake finished last
+        double handshakeDone = appConnect > connect ? appConnect : connect;
+        
+        RequestTiming& timing = lastTiming_;
+        timing.dnsMs = lookup * 1000.0;
+        timing.connectMs = (connect > lookup ? connect - lookup : 0) * 1000.0;
+        timing.tlsMs = (appConnect > connect ? appConnect - connect : 0) * 1000.0;
+        timing.ttfbMs = (startTransfer > handshakeDone ? startTransfer - handshakeDone : 0) * 1000.0;
+        timing.transferMs = (total > startTransfer ? total - startTransfer : 0) * 1000.0;
+        timing.totalMs = total * 1000.0;
+        timing.bytesDown = (long long)down;
+        timing.bytesUp = (long long)up;
+        // A request that failed before connecting (DNS, refused) made no new
+        // connection either; only one that got a response can have reused one
+        timing.connectionReused = newConnections == 0 && responseCode > 0;
+        timing.ok = ok;
+        timing.httpCode = (int)responseCode;  // 0 when no response came back
+    }
 };
 
 NetworkHandler::NetworkHandler() : impl_(new Impl()) {
@@ -71,10 +185,6 @@ bool NetworkHandler::get(const std::string& url, const std::map<std::string, std
     // Set URL
     curl_easy_setopt(impl_->curl_, CURLOPT_URL, url.c_str());
     
-    // Set write callback
-    curl_easy_setopt(impl_->curl_, CURLOPT_WRITEFUNCTION, Impl::WriteCallback);
-    curl_easy_setopt(impl_->curl_, CURLOPT_WRITEDATA, &response);
-    
     // Set headers if provided
     struct curl_slist* headerList = nullptr;
     if (!headers.empty()) {
@@ -86,28 +196,14 @@ bool NetworkHandler::get(const std::string& url, const std::map<std::string, std
     }
     
     // Perform the request
-    CURLcode res = curl_easy_perform(impl_->curl_);
+    bool ok = impl_->perform(url, response);
     
     // Clean up headers
     if (headerList) {
         curl_slist_free_all(headerList);
     }
     
-    if (res != CURLE_OK) {
-        impl_->lastError_ = curl_easy_strerror(res);
-        return false;
-    }
-    
-    // Get HTTP response code
-    curl_easy_getinfo(impl_->curl_, CURLINFO_RESPONSE_CODE, &impl_->lastHttpCode_);
-    
-    // Check for HTTP errors
-    if (impl_->lastHttpCode_ >= 400) {
-        impl_->lastError_ = "HTTP " + std::to_string(impl_->lastHttpCode_);
-        return false;
-    }
-    
-    return true;
+    return ok;
 }
 
 bool NetworkHandler::post(const std::string& url, const std::map<std::string, std::string>& headers, const std::string& data, std::string& response) {
@@ -131,10 +227,6 @@ bool NetworkHandler::post(const std::string& url, const std::map<std::string, st
     curl_easy_setopt(impl_->curl_, CURLOPT_POSTFIELDS, data.c_str());
     curl_easy_setopt(impl_->curl_, CURLOPT_POSTFIELDSIZE, data.length());
     
-    // Set write callback
-    curl_easy_setopt(impl_->curl_, CURLOPT_WRITEFUNCTION, Impl::WriteCallback);
-    curl_easy_setopt(impl_->curl_, CURLOPT_WRITEDATA, &response);
-    
     // Set headers
     struct curl_slist* headerList = nullptr;
     if (!headers.empty()) {
@@ -146,28 +238,14 @@ bool NetworkHandler::post(const std::string& url, const std::map<std::string, st
     }
     
     // Perform the request
-    CURLcode res = curl_easy_perform(impl_->curl_);
+    bool ok = impl_->perform(url, response);
     
     // Clean up headers
     if (headerList) {
         curl_slist_free_all(headerList);
     }
     
-    if (res != CURLE_OK) {
-        impl_->lastError_ = curl_easy_strerror(res);
-        return false;
-    }
-    
-    // Get HTTP response code
-    curl_easy_getinfo(impl_->curl_, CURLINFO_RESPONSE_CODE, &impl_->lastHttpCode_);
-    
-    // Check for HTTP errors
-    if (impl_->lastHttpCode_ >= 400) {
-        impl_->lastError_ = "HTTP " + std::to_string(impl_->lastHttpCode_);
-        return false;
-    }
-    
-    return true;
+    return ok;
 }
 
 void NetworkHandler::setTimeout(int timeoutSeconds) {
@@ -191,3 +269,7 @@ std::string NetworkHandler::getLastError() const {
 int NetworkHandler::getLastHttpCode() const {
     return impl_->lastHttpCode_;
 }
+
+RequestTiming NetworkHandler::getLastTiming() const {
+    return impl_->lastTiming_;
+}
@@ -1,6 +1,7 @@
 #ifndef NETWORK_HANDLER_H
 #define NETWORK_HANDLER_H
 
+#include "shared/network/network_stats.h"
 #include <string>
 #include <map>
 
@@ -22,6 +23,9 @@ public:
     std::string getLastError() const;
     int getLastHttpCode() const;
     
+    // Phase timings of the last request (also aggregated in NetworkStats)
+    RequestTiming getLastTiming() const;
+    
 private:
     class Impl;
     Impl* impl_;
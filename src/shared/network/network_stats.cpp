@@ -0,0 +1,140 @@
+#include "network_stats.h"
+#include <iomanip>
+#include <cstring>
+#include <cmath>
+
+namespace {
+
+const char* PHASE_NAMES[] = { "dns", "connect", "tls", "ttfb", "transfer", "total" };
+
+} // namespace
+
+NetworkStats::Histogram::Histogram() : count(0), sumMs(0), maxMs(0) {
+    memset(buckets, 0, sizeof(buckets));
+}
+
+void NetworkStats::Histogram::add(double ms) {
+    if (ms < 0) ms = 0;
+    
+    int bucket = 0;
+    if (ms >= 1.0) {
+        bucket = 1 + (int)std::floor(std::log2(ms));
+        if (bucket >= BUCKET_COUNT) bucket = BUCKET_COUNT - 1;
+    }
+    
+    buckets[bucket]++;
+    count++;
+    sumMs += ms;
+    if (ms > maxMs) maxMs = ms;
+}
+
+double NetworkStats::Histogram::percentile(double fraction) const {
+    if (count == 0) return 0.0;
+    
+    unsigned long target = (unsigned long)std::ceil(fraction * count);
+    unsigned long seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += buckets[i];
+        if (seen >= target) {
+            // Never report more than the worst sample we actually saw
+            double upper = i == 0 ? 1.0 : std::ldexp(1.0, i);
+            return upper < maxMs ? upper : maxMs;
+        }
+    }
+    return maxMs;
+}
+
+NetworkStats& NetworkStats::shared() {
+    static NetworkStats instance;
+    return instance;
+}
+
+void NetworkStats::record(const std::string& url, const RequestTiming& timing) {
+    std::string endpoint = endpointFromUrl(url);
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    EndpointStats& stats = endpoints_[endpoint];
+    stats.requests++;
+    if (!timing.ok) stats.failures++;
+    if (timing.connectionReused) stats.reused++;
+    stats.bytesDown += timing.bytesDown;
+    stats.bytesUp += timing.bytesUp;
+    
+    // Connection phases only mean something when a new connection was made
+    if (!timing.connectionReused) {
+        stats.phases[PHASE_DNS].add(timing.dnsMs);
+        stats.phases[PHASE_CONNECT].add(timing.connectMs);
+        stats.phases[PHASE_TLS].add(timing.tlsMs);
+    }
+    stats.phases[PHASE_TTFB].add(timing.ttfbMs);
+    stats.phases[PHASE_TRANSFER].add(timing.transferMs);
+    stats.phases[PHASE_TOTAL].add(timing.totalMs);
+}
+
+void NetworkStats::printReport(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (endpoints_.empty()) {
+        out << "📶 No network requests recorded yet" << std::endl;
+        return;
+    }
+    
+    std::ios::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(1);
+    
+    for (std::map<std::string, EndpointStats>::const_iterator it = endpoints_.begin(); it != endpoints_.end(); ++it) {
+        const EndpointStats& stats = it->second;
+        out << "\033[1;36m📶 " << it->first << "\033[0m" << std::endl;
+        out << "   requests " << stats.requests << ", failed " << stats.failures
+            << ", reused " << stats.reused << " (" << (stats.requests ? 100 * stats.reused / stats.requests : 0) << "%)"
+            << ", down " << stats.bytesDown / 1024 << " KB, up " << stats.bytesUp / 1024 << " KB" << std::endl;
+        out << "   phase        n     mean      p50      p90      p99      max  (ms)" << std::endl;
+        
+        for (int p = 0; p < PHASE_COUNT; p++) {
+            const Histogram& h = stats.phases[p];
+            out << "   " << std::left << std::setw(9) << PHASE_NAMES[p] << std::right
+                << std::setw(5) << h.count
+                << std::setw(9) << h.mean()
+                << std::setw(9) << h.percentile(0.50)
+                << std::setw(9) << h.percentile(0.90)
+                << std::setw(9) << h.percentile(0.99)
+                << std::setw(9) << h.maxMs << std::endl;
+        }
+    }
+    
+    out.flags(flags);
+}
+
+void NetworkStats::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    endpoints_.clear();
+}
+
+std::string NetworkStats::endpointFromUrl(const std::string& url) {
+    // Drop scheme and query: "https://host/a/b?x=1" -> "host/a/b"
+    size_t start = url.find("://");
+    start = start == std::string::npos ? 0 : start + 3;
+    size_t end = url.find_first_of("?#", start);
+    std::string path = url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+    
+    // Fold per-resource segments (channel/artist IDs, @handles)
+    std::string endpoint;
+    size_t pos = 0;
+    bool first = true;
+    while (pos <= path.size()) {
+        size_t slash = path.find('/', pos);
+        if (slash == std::string::npos) slash = path.size();
+        std::string segment = path.substr(pos, slash - pos);
+        
+        if (!first) endpoint += '/';
+        if (!first && (segment.size() >= 16 || (!segment.empty() && segment[0] == '@'))) {
+            endpoint += "{id}";
+        } else {
+            endpoint += segment;
+        }
+        
+        first = false;
+        pos = slash + 1;
+    }
+    return endpoint;
+}
@@ -0,0 +1,82 @@
+#ifndef NETWORK_STATS_H
+#define NETWORK_STATS_H
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <ostream>
+
+// Timing breakdown of one HTTP request. Phase durations are in milliseconds
+// and derived from curl's cumulative timers (name lookup, connect, TLS
+// handshake, first byte, total).
+struct RequestTiming {
+    double dnsMs;        // Name resolution
+    double connectMs;    // TCP connect
+    double tlsMs;        // TLS handshake (0 on plain HTTP or reused connections)
+    double ttfbMs;       // Request sent until first response byte (server time)
+    double transferMs;   // First byte until done
+    double totalMs;
+    long long bytesDown;
+    long long bytesUp;
+    bool connectionReused;
+    bool ok;
+    int httpCode;
+    
+    RequestTiming() : dnsMs(0), connectMs(0), tlsMs(0), ttfbMs(0), transferMs(0), totalMs(0),
+                      bytesDown(0), bytesUp(0), connectionReused(false), ok(false), httpCode(0) {}
+};
+
+// Process-wide per-endpoint request statistics with log2 latency histograms,
+// printed by the "netstats" command. Endpoints are host + path with
+// ID-like path segments folded into "{id}", so every channel or artist
+// lookup lands in the same row.
+class NetworkStats {
+public:
+    static NetworkStats& shared();
+    
+    void record(const std::string& url, const RequestTiming& timing);
+    void printReport(std::ostream& out) const;
+    void reset();
+    
+    static std::string endpointFromUrl(const std::string& url);
+    
+    // Bucket i holds samples in [2^(i-1), 2^i) ms; bucket 0 is < 1 ms
+    static const int BUCKET_COUNT = 18;
+    
+private:
+    enum Phase { PHASE_DNS, PHASE_CONNECT, PHASE_TLS, PHASE_TTFB, PHASE_TRANSFER, PHASE_TOTAL, PHASE_COUNT };
+    
+    struct Histogram {
+        unsigned long buckets[BUCKET_COUNT];
+        unsigned long count;
+        double sumMs;
+        double maxMs;
+        
+        Histogram();
+        void add(double ms);
+        double percentile(double fraction) const;  // Upper bound of the bucket
+        double mean() const { return count ? sumMs / count : 0.0; }
+    };
+    
+    struct EndpointStats {
+        unsigned long requests;
+        unsigned long failures;
+        unsigned long reused;
+        long long bytesDown;
+        long long bytesUp;
+        Histogram phases[PHASE_COUNT];
+        
+        EndpointStats() : requests(0), failures(0), reused(0), bytesDown(0), bytesUp(0) {}
+    };
+    
+    std::map<std::string, EndpointStats> endpoints_;
+    mutable std::mutex mutex_;
+    
+    NetworkStats() {}
+    
+    // Disable copy constructor and assignment operator
+    NetworkStats(const NetworkStats&) = delete;
+    NetworkStats& operator=(const NetworkStats&) = delete;
+};
+
+#endif // NETWORK_STATS_H
@@ -1,8 +1,7 @@
 #include "blink_manager.h"
-#include <chrono>
-#include <ctime>
 
-BlinkManager::BlinkManager() : currentState_(true), previousState_(false), lastToggleTime_(0) {
+BlinkManager::BlinkManager(Clock* clock)
+    : clock_(clock ? clock : Clock::monotonic()), currentState_(true), previousState_(false), lastToggleTime_(0) {
 }
 
 BlinkManager::~BlinkManager() {
@@ -11,9 +10,20 @@ BlinkManager::~BlinkManager() {
 
 bool BlinkManager::updateBlinkState(int durationMs) {
     // Get current time in milliseconds
-    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count();
+    long long now = clock_->nowMs();
+    
+    // Displays in sync count periods from the shared epoch, so they all
+    // blink together: on in even periods, off in odd ones
+    long long epochStartMs;
+    if (clock_->getEpochStartMs(epochStartMs) && durationMs > 0 && now >= epochStartMs) {
+        bool state = ((now - epochStartMs) / durationMs) % 2 == 0;
+        if (state != currentState_) {
+            previousState_ = currentState_;
+            currentState_ = state;
+            lastToggleTime_ = now;
+        }
+        return currentState_;
+    }
     
     // Toggle state based on provided duration
     if (now - lastToggleTime_ >= durationMs) {
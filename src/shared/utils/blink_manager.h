@@ -1,9 +1,12 @@
 #ifndef BLINK_MANAGER_H
 #define BLINK_MANAGER_H
 
+#include "shared/utils/clock.h"
+
 class BlinkManager {
 public:
-    BlinkManager();
+    // Uses the monotonic clock unless given another (not owned)
+    explicit BlinkManager(Clock* clock = nullptr);
     ~BlinkManager();
     
     // Update blink state and return current state
@@ -19,6 +22,7 @@ public:
     void reset();
     
 private:
+    Clock* clock_;
     bool currentState_;
     bool previousState_;
     long long lastToggleTime_;
@@ -0,0 +1,47 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include "shared/utils/monotonic_clock.h"
+
+// Injectable time source for code that animates or meters. Live code uses
+// Clock::monotonic() (MonotonicClock). Trace replay and checks pass a
+// VirtualClock, which they step themselves, so hours of input can run in
+// seconds and produce the same frames every time.
+class Clock {
+public:
+    virtual ~Clock() {}
+    virtual long long nowMs() const = 0;
+
+    // Displays running in sync (see SyncClock) share an epoch: blinking and
+    // text rotation count from its start, so they agree on the phase and
+    // not just on the time. A local clock has none.
+    virtual bool getEpochStartMs(long long& /*startMs*/) const { return false; }
+
+    // Shared MonotonicClock instance; never deleted
+    static Clock* monotonic();
+};
+
+class SteadyClock : public Clock {
+public:
+    virtual long long nowMs() const { return MonotonicClock::nowMs(); }
+};
+
+// Stands still until the owner moves it
+class VirtualClock : public Clock {
+public:
+    explicit VirtualClock(long long startMs = 0) : nowMs_(startMs) {}
+
+    virtual long long nowMs() const { return nowMs_; }
+    void setMs(long long ms) { nowMs_ = ms; }
+    void advanceMs(long long ms) { nowMs_ += ms; }
+
+private:
+    long long nowMs_;
+};
+
+inline Clock* Clock::monotonic() {
+    static SteadyClock clock;
+    return &clock;
+}
+
+#endif // CLOCK_H
@@ -0,0 +1,41 @@
+#ifndef DB_SAMPLE_H
+#define DB_SAMPLE_H
+
+#include "shared/utils/spsc_ring.h"
+#include <stdint.h>
+
+// One sound level reading in hundredths of a dB (0..12000)
+struct DbSample {
+    uint16_t centiDb;
+    uint8_t channel;
+    uint8_t reserved;
+
+    DbSample() : centiDb(0), channel(0), reserved(0) {}
+    DbSample(uint16_t value, uint8_t ch) : centiDb(value), channel(ch), reserved(0) {}
+};
+
+typedef SpscRing<DbSample> DbSampleRing;
+
+// Per-frame reduction of everything drained from the ring
+// (usable directly as the ring's drain consumer)
+struct DbSampleSummary {
+    uint16_t latest;
+    uint16_t max;
+    uint64_t sum;
+    uint32_t count;
+
+    DbSampleSummary() : latest(0), max(0), sum(0), count(0) {}
+
+    void operator()(const DbSample& sample) {
+        latest = sample.centiDb;
+        if (sample.centiDb > max) {
+            max = sample.centiDb;
+        }
+        sum += sample.centiDb;
+        count++;
+    }
+
+    double getMeanCentiDb() const { return count ? (double)sum / count : 0.0; }
+};
+
+#endif // DB_SAMPLE_H
@@ -0,0 +1,54 @@
+#include "file_utils.h"
+#include <cstdio>
+#include <cerrno>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+
+bool FileUtils::makeDirectories(const std::string& path) {
+    std::string current;
+    for (size_t i = 0; i <= path.size(); i++) {
+        if (i == path.size() || path[i] == '/') {
+            if (!current.empty() && mkdir(current.c_str(), 0755) != 0 && errno != EEXIST) {
+                return false;
+            }
+        }
+        if (i < path.size()) {
+            current += path[i];
+        }
+    }
+    return true;
+}
+
+bool FileUtils::writeFileAtomic(const std::string& path, const std::string& data) {
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath.c_str(), std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        file.write(data.data(), data.size());
+        if (!file) {
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+    
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool FileUtils::readFile(const std::string& path, std::string& data) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    data = contents.str();
+    return true;
+}
@@ -0,0 +1,19 @@
+#ifndef FILE_UTILS_H
+#define FILE_UTILS_H
+
+#include <string>
+
+class FileUtils {
+public:
+    // mkdir -p; true if the directory exists afterwards (errno set on failure)
+    static bool makeDirectories(const std::string& path);
+    
+    // Write a whole file via a temporary and rename, so readers never see
+    // a partially written file
+    static bool writeFileAtomic(const std::string& path, const std::string& data);
+    
+    // Read a whole file into `data`
+    static bool readFile(const std::string& path, std::string& data);
+};
+
+#endif // FILE_UTILS_H
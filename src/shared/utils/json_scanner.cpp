@@ -0,0 +1,88 @@
+#include "json_scanner.h"
+#include <cstring>
+#include <cstdlib>
+
+static bool isJsonSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+StringRef JsonScanner::findString(const std::string& json, const char* key, size_t from, size_t* next) {
+    return find(json, key, true, from, next);
+}
+
+StringRef JsonScanner::findNumber(const std::string& json, const char* key, size_t from, size_t* next) {
+    return find(json, key, false, from, next);
+}
+
+StringRef JsonScanner::findValue(const std::string& json, const char* key) {
+    StringRef value = findString(json, key);
+    if (value.empty()) {
+        value = findNumber(json, key);
+    }
+    return value;
+}
+
+long JsonScanner::parseLong(const StringRef& value) {
+    if (value.empty()) {
+        return 0;
+    }
+    
+    // Values are followed by a delimiter inside a NUL-terminated std::string,
+    // so strtol stops at the end of the number without needing a copy
+    char* end = nullptr;
+    long result = std::strtol(value.data, &end, 10);
+    if (end == value.data || end > value.data + value.size) {
+        return 0;
+    }
+    return result;
+}
+
+StringRef JsonScanner::find(const std::string& json, const char* key, bool quoted, size_t from, size_t* next) {
+    const char* data = json.data();
+    const size_t size = json.size();
+    const size_t keyLen = std::strlen(key);
+    
+    size_t pos = from;
+    while (pos < size) {
+        // Locate the next "key" occurrence
+        pos = json.find(key, pos, keyLen);
+        if (pos == std::string::npos) {
+            break;
+        }
+        
+        size_t keyStart = pos;
+        size_t keyEnd = pos + keyLen;
+        pos = keyEnd;
+        
+        // Must be a complete quoted key, not a substring of another one
+        if (keyStart == 0 || data[keyStart - 1] != '"' || keyEnd >= size || data[keyEnd] != '"') {
+            continue;
+        }
+        
+        // Skip "\s*:\s*"
+        size_t i = keyEnd + 1;
+        while (i < size && isJsonSpace(data[i])) i++;
+        if (i >= size || data[i] != ':') continue;
+        i++;
+        while (i < size && isJsonSpace(data[i])) i++;
+        if (i >= size) break;
+        
+        size_t valueStart = i;
+        if (quoted) {
+            if (data[i] != '"') continue;
+            valueStart = ++i;
+            while (i < size && data[i] != '"') i++;
+            if (i >= size || i == valueStart) continue; // Unterminated or empty
+            if (next) *next = i + 1;
+        } else {
+            while (i < size && data[i] >= '0' && data[i] <= '9') i++;
+            if (i == valueStart) continue;
+            if (next) *next = i;
+        }
+        
+        return StringRef(data + valueStart, i - valueStart);
+    }
+    
+    if (next) *next = size;
+    return StringRef();
+}
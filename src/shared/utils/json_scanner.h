@@ -0,0 +1,32 @@
+#ifndef JSON_SCANNER_H
+#define JSON_SCANNER_H
+
+#include "shared/utils/string_ref.h"
+#include <string>
+
+// Minimal key/value scanner for API responses. Results point into the
+// scanned buffer instead of copying, so they stay valid only as long as the
+// buffer does.
+class JsonScanner {
+public:
+    // Find "key": "value" starting at offset `from`. On success `next` (if
+    // given) receives the offset just past the match.
+    static StringRef findString(const std::string& json, const char* key,
+                                size_t from = 0, size_t* next = nullptr);
+    
+    // Find "key": 123 (unquoted integer)
+    static StringRef findNumber(const std::string& json, const char* key,
+                                size_t from = 0, size_t* next = nullptr);
+    
+    // Quoted string first, then unquoted integer
+    static StringRef findValue(const std::string& json, const char* key);
+    
+    // Parse an integer view without copying (0 if empty or invalid)
+    static long parseLong(const StringRef& value);
+    
+private:
+    static StringRef find(const std::string& json, const char* key, bool quoted,
+                          size_t from, size_t* next);
+};
+
+#endif // JSON_SCANNER_H
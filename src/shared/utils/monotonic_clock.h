@@ -0,0 +1,22 @@
+#ifndef MONOTONIC_CLOCK_H
+#define MONOTONIC_CLOCK_H
+
+#include <chrono>
+
+// Time for animation and metering. Unlike the wall clock it never jumps
+// when NTP adjusts the time, and unlike frame counts it doesn't depend on
+// how fast the render loop happens to run.
+class MonotonicClock {
+public:
+    static long long nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static long long nowUs() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+#endif // MONOTONIC_CLOCK_H
@@ -1,8 +1,7 @@
 #include "rotating_text.h"
-#include <chrono>
 
-RotatingText::RotatingText() 
-    : currentIndex_(0), rotationIntervalMs_(3000), enabled_(false), lastRotationTime_(0) {
+RotatingText::RotatingText(Clock* clock)
+    : clock_(clock ? clock : Clock::monotonic()), currentIndex_(0), rotationIntervalMs_(3000), enabled_(false), lastRotationTime_(0) {
 }
 
 RotatingText::~RotatingText() {
@@ -13,6 +12,12 @@ void RotatingText::addText(const std::string& text) {
     texts_.push_back(text);
 }
 
+void RotatingText::setText(size_t index, const char* text, size_t size) {
+    if (index < texts_.size()) {
+        texts_[index].assign(text, size);
+    }
+}
+
 void RotatingText::clearTexts() {
     texts_.clear();
     currentIndex_ = 0;
@@ -66,6 +71,15 @@ void RotatingText::update() {
     }
     
     long long currentTime = getCurrentTimeMs();
+    
+    // Displays in sync show the text the shared epoch is up to
+    long long epochStartMs;
+    if (clock_->getEpochStartMs(epochStartMs) && rotationIntervalMs_ > 0 && currentTime >= epochStartMs) {
+        currentIndex_ = (size_t)(((currentTime - epochStartMs) / rotationIntervalMs_) % (long long)texts_.size());
+        lastRotationTime_ = currentTime;
+        return;
+    }
+    
     if (currentTime - lastRotationTime_ >= rotationIntervalMs_) {
         rotateToNext();
         lastRotationTime_ = currentTime;
@@ -77,7 +91,5 @@ void RotatingText::rotateToNext() {
 }
 
 long long RotatingText::getCurrentTimeMs() const {
-    return std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count();
+    return clock_->nowMs();
 }
@@ -1,17 +1,19 @@
 #ifndef ROTATING_TEXT_H
 #define ROTATING_TEXT_H
 
+#include "shared/utils/clock.h"
 #include <vector>
 #include <string>
-#include <chrono>
 
 class RotatingText {
 public:
-    RotatingText();
+    // Uses the monotonic clock unless given another (not owned)
+    explicit RotatingText(Clock* clock = nullptr);
     ~RotatingText();
     
     // Configuration
     void addText(const std::string& text);
+    void setText(size_t index, const char* text, size_t size);  // In place; keeps the capacity
     void clearTexts();
     void setRotationInterval(int intervalMs);
     void setEnabled(bool enabled);
@@ -25,11 +27,13 @@ public:
     std::string getCurrentText() const;
     bool isEnabled() const;
     bool hasTexts() const;
+    size_t getTextCount() const { return texts_.size(); }
     
     // Update method (call this in your main loop)
     void update();
     
 private:
+    Clock* clock_;
     std::vector<std::string> texts_;
     size_t currentIndex_;
     int rotationIntervalMs_;
@@ -0,0 +1,132 @@
+#include "sha1.h"
+#include <cstring>
+
+namespace {
+
+const size_t BLOCK_SIZE = 64;
+
+uint32_t rotateLeft(uint32_t value, int bits) {
+    return (value << bits) | (value >> (32 - bits));
+}
+
+void processBlock(uint32_t state[5], const uint8_t* block) {
+    uint32_t w[80];
+    for (int i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)block[i * 4] << 24) | ((uint32_t)block[i * 4 + 1] << 16) |
+               ((uint32_t)block[i * 4 + 2] << 8) | (uint32_t)block[i * 4 + 3];
+    }
+    for (int i = 16; i < 80; i++) {
+        w[i] = rotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+    for (int i = 0; i < 80; i++) {
+        uint32_t f, k;
+        if (i < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5A827999;
+        } else if (i < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ED9EBA1;
+        } else if (i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8F1BBCDC;
+        } else {
+            f = b ^ c ^ d;
+            k = 0xCA62C1D6;
+        }
+        uint32_t temp = rotateLeft(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = rotateLeft(b, 30);
+        b = a;
+        a = temp;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+}
+
+} // namespace
+
+void Sha1::digest(const void* data, size_t size, uint8_t out[DIGEST_SIZE]) {
+    uint32_t state[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    const uint8_t* bytes = (const uint8_t*)data;
+
+    size_t whole = size - size % BLOCK_SIZE;
+    for (size_t offset = 0; offset < whole; offset += BLOCK_SIZE) {
+        processBlock(state, bytes + offset);
+    }
+
+    // Padding: 0x80, zeros, then the length in bits (big-endian); one or two blocks
+    uint8_t tail[BLOCK_SIZE * 2];
+    size_t remaining = size - whole;
+    std::memset(tail, 0, sizeof(tail));
+    std::memcpy(tail, bytes + whole, remaining);
+    tail[remaining] = 0x80;
+    size_t tailSize = remaining + 9 <= BLOCK_SIZE ? BLOCK_SIZE : BLOCK_SIZE * 2;
+    uint64_t bits = (uint64_t)size * 8;
+    for (int i = 0; i < 8; i++) {
+        tail[tailSize - 1 - i] = (uint8_t)(bits >> (i * 8));
+    }
+    for (size_t offset = 0; offset < tailSize; offset += BLOCK_SIZE) {
+        processBlock(state, tail + offset);
+    }
+
+    for (int i = 0; i < 5; i++) {
+        out[i * 4] = (uint8_t)(state[i] >> 24);
+        out[i * 4 + 1] = (uint8_t)(state[i] >> 16);
+        out[i * 4 + 2] = (uint8_t)(state[i] >> 8);
+        out[i * 4 + 3] = (uint8_t)state[i];
+    }
+}
+
+std::string Sha1::hmacHex(const std::string& key, const std::string& message) {
+    // Keys longer than a block are hashed first
+    uint8_t keyBlock[BLOCK_SIZE];
+    std::memset(keyBlock, 0, sizeof(keyBlock));
+    if (key.size() > BLOCK_SIZE) {
+        digest(key.data(), key.size(), keyBlock);
+    } else {
+        std::memcpy(keyBlock, key.data(), key.size());
+    }
+
+    std::string inner(BLOCK_SIZE, '\0');
+    std::string outer(BLOCK_SIZE + DIGEST_SIZE, '\0');
+    for (size_t i = 0; i < BLOCK_SIZE; i++) {
+        inner[i] = (char)(keyBlock[i] ^ 0x36);
+        outer[i] = (char)(keyBlock[i] ^ 0x5C);
+    }
+    inner += message;
+
+    uint8_t innerDigest[DIGEST_SIZE];
+    digest(inner.data(), inner.size(), innerDigest);
+    std::memcpy(&outer[BLOCK_SIZE], innerDigest, DIGEST_SIZE);
+
+    uint8_t mac[DIGEST_SIZE];
+    digest(outer.data(), outer.size(), mac);
+
+    static const char* hex = "0123456789abcdef";
+    std::string result;
+    for (size_t i = 0; i < DIGEST_SIZE; i++) {
+        result += hex[mac[i] >> 4];
+        result += hex[mac[i] & 0x0F];
+    }
+    return result;
+}
+
+bool Sha1::equalsConstantTime(const std::string& a, const std::string& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+
+    unsigned char difference = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        // Folds ASCII letters to lowercase; hex digits are all that is compared
+        difference |= (unsigned char)((a[i] | 0x20) ^ (b[i] | 0x20));
+    }
+    return difference == 0;
+}
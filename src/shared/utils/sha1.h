@@ -0,0 +1,25 @@
+#ifndef SHA1_H
+#define SHA1_H
+
+#include <string>
+#include <stddef.h>
+#include <stdint.h>
+
+// SHA-1 and HMAC-SHA1, for checking WebSub's X-Hub-Signature without
+// linking a crypto library. Not for anything that needs collision
+// resistance.
+class Sha1 {
+public:
+    static const size_t DIGEST_SIZE = 20;
+
+    static void digest(const void* data, size_t size, uint8_t out[DIGEST_SIZE]);
+
+    // Lowercase hex HMAC-SHA1 of `message` under `key`
+    static std::string hmacHex(const std::string& key, const std::string& message);
+
+    // Case-insensitive comparison that takes the same time wherever the
+    // strings differ, so a forger can't learn a signature byte by byte
+    static bool equalsConstantTime(const std::string& a, const std::string& b);
+};
+
+#endif // SHA1_H
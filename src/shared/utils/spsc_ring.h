@@ -0,0 +1,122 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <vector>
+#include <stddef.h>
+
+// Lock-free single-producer/single-consumer ring buffer.
+//
+// Exactly one thread may push and exactly one other thread may pop/drain.
+// Storage is allocated once in the constructor (capacity is rounded up to a
+// power of two), so neither side allocates afterwards. A full ring rejects
+// new items instead of overwriting unread ones; rejected items are counted.
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity)
+        : buffer_(roundUpPowerOfTwo(capacity)), mask_(buffer_.size() - 1),
+          head_(0), cachedTail_(0), dropped_(0), tail_(0), cachedHead_(0) {
+    }
+
+    // Producer side
+    bool push(const T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - cachedTail_ > mask_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head - cachedTail_ > mask_) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        buffer_[head & mask_] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pushes as many items as fit with a single publish; returns that count
+    size_t pushBatch(const T* items, size_t count) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t space = buffer_.size() - (head - cachedTail_);
+        if (space < count) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            space = buffer_.size() - (head - cachedTail_);
+        }
+        size_t accepted = count < space ? count : space;
+        for (size_t i = 0; i < accepted; i++) {
+            buffer_[(head + i) & mask_] = items[i];
+        }
+        head_.store(head + accepted, std::memory_order_release);
+        if (accepted < count) {
+            dropped_.fetch_add(count - accepted, std::memory_order_relaxed);
+        }
+        return accepted;
+    }
+
+    // Consumer side
+    bool pop(T& out) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == cachedHead_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail == cachedHead_) {
+                return false;
+            }
+        }
+        out = buffer_[tail & mask_];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Hands every item available right now to consumer(item), then releases
+    // them all at once. Items pushed while draining wait for the next call.
+    template <typename Consumer>
+    size_t drain(Consumer& consumer) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        cachedHead_ = head_.load(std::memory_order_acquire);
+        size_t count = cachedHead_ - tail;
+        for (size_t i = 0; i < count; i++) {
+            consumer(buffer_[(tail + i) & mask_]);
+        }
+        tail_.store(cachedHead_, std::memory_order_release);
+        return count;
+    }
+
+    // Approximate when called concurrently with the other side
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    size_t capacity() const { return buffer_.size(); }
+    unsigned long getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    static size_t roundUpPowerOfTwo(size_t value) {
+        size_t size = 2;
+        while (size < value) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    std::vector<T> buffer_;
+    size_t mask_;
+
+    // Producer and consumer indices sit on separate cache lines so the two
+    // threads don't invalidate each other's line on every item
+    char padProducer_[CACHE_LINE_SIZE];
+    std::atomic<size_t> head_;
+    size_t cachedTail_;  // Producer's last view of tail_
+    std::atomic<unsigned long> dropped_;
+
+    char padConsumer_[CACHE_LINE_SIZE];
+    std::atomic<size_t> tail_;
+    size_t cachedHead_;  // Consumer's last view of head_
+    char padEnd_[CACHE_LINE_SIZE];
+
+    // Disable copy constructor and assignment operator
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+};
+
+#endif // SPSC_RING_H
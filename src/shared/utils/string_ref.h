@@ -0,0 +1,25 @@
+#ifndef STRING_REF_H
+#define STRING_REF_H
+
+#include <string>
+#include <cstring>
+
+// Non-owning view into a character buffer (e.g. a pooled response buffer).
+// Only valid while the underlying buffer is alive and unchanged.
+struct StringRef {
+    const char* data;
+    size_t size;
+    
+    StringRef() : data(nullptr), size(0) {}
+    StringRef(const char* d, size_t s) : data(d), size(s) {}
+    
+    bool empty() const { return size == 0; }
+    std::string str() const { return data ? std::string(data, size) : std::string(); }
+    
+    bool equals(const char* text) const {
+        size_t len = std::strlen(text);
+        return len == size && (size == 0 || std::memcmp(data, text, size) == 0);
+    }
+};
+
+#endif // STRING_REF_H
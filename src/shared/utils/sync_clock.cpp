@@ -0,0 +1,189 @@
+#include "sync_clock.h"
+
+SyncClock::SyncClock(int tickMs, TimeSource localUs)
+    : localUs_(localUs), leader_(false), locked_(false), tickUs_(tickMs * 1000LL),
+      anchorLocalUs_(0), anchorOffsetUs_(0), targetOffsetUs_(0), uncertaintyUs_(0),
+      sampleCount_(0), totalSamples_(0), steps_(0),
+      epoch_(0), epochStartUs_(0), pendingEpoch_(0), pendingStartUs_(0), tick_(0), tickStartUs_(0) {
+}
+
+void SyncClock::lead() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    leader_ = true;
+    locked_ = true;
+    anchorOffsetUs_ = 0;
+    targetOffsetUs_ = 0;
+    uncertaintyUs_ = 0;
+    epoch_ = 1;
+    epochStartUs_ = alignToTickLocked(localUs_());
+    pendingEpoch_ = 0;
+}
+
+void SyncClock::beginEpoch(long long delayUs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    long long localNow = localUs_();
+    uint32_t latest = pendingEpoch_ != 0 ? pendingEpoch_ : epoch_;
+    pendingEpoch_ = latest + 1;
+    pendingStartUs_ = alignToTickLocked(localNow + offsetAtLocked(localNow) + delayUs);
+}
+
+void SyncClock::addSample(long long originUs, long long receiveUs, long long transmitUs, long long returnUs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (leader_) {
+        return;
+    }
+
+    // Round trip without the leader's turnaround, and the offset that puts
+    // the leader's timestamps midway between ours
+    Sample& sample = samples_[totalSamples_ % FILTER_SAMPLES];
+    sample.delayUs = (returnUs - originUs) - (transmitUs - receiveUs);
+    if (sample.delayUs < 0) {
+        sample.delayUs = 0;
+    }
+    sample.offsetUs = ((receiveUs - originUs) + (transmitUs - returnUs)) / 2;
+    totalSamples_++;
+    if (sampleCount_ < FILTER_SAMPLES) {
+        sampleCount_++;
+    }
+
+    const Sample* best = &samples_[0];
+    for (int i = 1; i < sampleCount_; i++) {
+        if (samples_[i].delayUs < best->delayUs) {
+            best = &samples_[i];
+        }
+    }
+
+    long long localNow = localUs_();
+    long long currentUs = offsetAtLocked(localNow);
+    long long errorUs = best->offsetUs - currentUs;
+    if (!locked_ || errorUs > STEP_US || errorUs < -STEP_US) {
+        currentUs = best->offsetUs;
+        locked_ = true;
+        steps_++;
+    }
+    anchorLocalUs_ = localNow;
+    anchorOffsetUs_ = currentUs;
+    targetOffsetUs_ = best->offsetUs;
+    uncertaintyUs_ = best->delayUs / 2;
+}
+
+void SyncClock::setTickUs(long long tickUs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tickUs > 0) {
+        tickUs_ = tickUs;
+    }
+}
+
+void SyncClock::setEpoch(uint32_t epoch, long long startUs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (epoch == 0 || epoch == epoch_ || (epoch == pendingEpoch_ && startUs == pendingStartUs_)) {
+        return;
+    }
+    // Any other number is news, including a restarted leader counting from 1
+    pendingEpoch_ = epoch;
+    pendingStartUs_ = startUs;
+}
+
+long long SyncClock::sharedNowUs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    long long localNow = localUs_();
+    return localNow + offsetAtLocked(localNow);
+}
+
+long long SyncClock::nextTick() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    long long localNow = localUs_();
+    long long sharedNow = localNow + offsetAtLocked(localNow);
+
+    // Never the same tick twice when a correction moves the clock back
+    long long tick = sharedNow / tickUs_ + 1;
+    if (tick == tick_) {
+        tick++;
+    }
+    tick_ = tick;
+    tickStartUs_ = tick * tickUs_;
+
+    if (pendingEpoch_ != 0 && pendingStartUs_ <= tickStartUs_) {
+        epoch_ = pendingEpoch_;
+        epochStartUs_ = pendingStartUs_;
+        pendingEpoch_ = 0;
+    }
+    return localNow + (tickStartUs_ - sharedNow);
+}
+
+long long SyncClock::nowMs() const {
+    if (tick_ > 0) {
+        return tickStartUs_ / 1000;
+    }
+    return sharedNowUs() / 1000;
+}
+
+bool SyncClock::getEpochStartMs(long long& startMs) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!locked_ || epoch_ == 0) {
+        return false;
+    }
+    startMs = epochStartUs_ / 1000;
+    return true;
+}
+
+bool SyncClock::isLocked() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return locked_;
+}
+
+long long SyncClock::getTickUs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tickUs_;
+}
+
+long long SyncClock::getOffsetUs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return offsetAtLocked(localUs_());
+}
+
+long long SyncClock::getUncertaintyUs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return uncertaintyUs_;
+}
+
+uint32_t SyncClock::getEpoch() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return epoch_;
+}
+
+uint32_t SyncClock::getAnnouncedEpoch(long long& startUs) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pendingEpoch_ != 0) {
+        startUs = pendingStartUs_;
+        return pendingEpoch_;
+    }
+    startUs = epochStartUs_;
+    return epoch_;
+}
+
+unsigned long SyncClock::getSampleCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return totalSamples_;
+}
+
+unsigned long SyncClock::getStepCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return steps_;
+}
+
+long long SyncClock::offsetAtLocked(long long localUs) const {
+    long long deltaUs = targetOffsetUs_ - anchorOffsetUs_;
+    long long maxMoveUs = (localUs - anchorLocalUs_) * SLEW_PPM / 1000000;
+    if (deltaUs > maxMoveUs) {
+        return anchorOffsetUs_ + maxMoveUs;
+    }
+    if (deltaUs < -maxMoveUs) {
+        return anchorOffsetUs_ - maxMoveUs;
+    }
+    return targetOffsetUs_;
+}
+
+long long SyncClock::alignToTickLocked(long long sharedUs) const {
+    return (sharedUs + tickUs_ - 1) / tickUs_ * tickUs_;
+}
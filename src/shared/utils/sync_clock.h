@@ -0,0 +1,117 @@
+#ifndef SYNC_CLOCK_H
+#define SYNC_CLOCK_H
+
+#include "shared/utils/clock.h"
+#include "shared/utils/monotonic_clock.h"
+#include <mutex>
+#include <stdint.h>
+
+// Animation clock shared by displays in one room (see SyncNode).
+//
+// The leader's monotonic clock is the timebase. A follower estimates its
+// offset from ping exchanges: of the last FILTER_SAMPLES, the one with the
+// shortest round trip is trusted, since queueing only ever adds delay, and
+// half its round trip bounds the error. The first estimate and any error
+// over STEP_US are stepped to; smaller corrections are slewed in at
+// SLEW_PPM so animations never visibly jump.
+//
+// Time is cut into ticks on the shared timebase. The render loop sleeps
+// until nextTick() and draws; until the next call, nowMs() is the time of
+// that tick, so every display computes its blink phase and text rotation
+// for exactly the same instant and they can only differ by a whole frame
+// if their clocks are a tick apart. Epochs restart those phases: the
+// leader announces each one ahead of its start and it takes effect on the
+// first tick at or after it.
+//
+// The network thread feeds samples and epochs; the render thread reads.
+class SyncClock : public Clock {
+public:
+    // Local time in microseconds; tests and tools/sync_probe pass a skewed one
+    typedef long long (*TimeSource)();
+
+    explicit SyncClock(int tickMs, TimeSource localUs = &MonotonicClock::nowUs);
+
+    // Leader: the local clock is the timebase, and epoch 1 starts now
+    void lead();
+    // Leader: announce the next epoch, starting `delayUs` from now
+    void beginEpoch(long long delayUs);
+
+    // Follower: one ping exchange; origin and return on the local clock,
+    // receive and transmit on the leader's
+    void addSample(long long originUs, long long receiveUs, long long transmitUs, long long returnUs);
+    // Follower: the leader's tick length and epoch, as its answers report them
+    void setTickUs(long long tickUs);
+    void setEpoch(uint32_t epoch, long long startUs);
+
+    long long localNowUs() const { return localUs_(); }
+    long long sharedNowUs() const;
+
+    // Render thread: local time at which the next tick starts; the
+    // animation time becomes that tick's
+    long long nextTick();
+    long long getTick() const { return tick_; }
+    long long getTickStartUs() const { return tickStartUs_; }
+
+    // Clock: the current tick's time once ticking, shared time before
+    virtual long long nowMs() const;
+    virtual bool getEpochStartMs(long long& startMs) const;
+
+    // Diagnostics
+    bool isLeader() const { return leader_; }
+    bool isLocked() const;
+    long long getTickUs() const;
+    long long getOffsetUs() const;          // Shared minus local
+    long long getUncertaintyUs() const;     // Half the best round trip
+    uint32_t getEpoch() const;
+    // The newest epoch, which may not have started yet
+    uint32_t getAnnouncedEpoch(long long& startUs) const;
+    unsigned long getSampleCount() const;
+    unsigned long getStepCount() const;
+
+    static const int FILTER_SAMPLES = 8;
+    static const long long STEP_US = 50000;
+    static const long long SLEW_PPM = 20000;  // 2%: 1 ms of error is gone in 50 ms
+
+private:
+    struct Sample {
+        long long offsetUs;
+        long long delayUs;
+    };
+
+    TimeSource localUs_;
+    mutable std::mutex mutex_;
+    bool leader_;
+    bool locked_;
+    long long tickUs_;
+
+    // Offset discipline: slews from anchorOffsetUs_ (at anchorLocalUs_)
+    // towards targetOffsetUs_
+    long long anchorLocalUs_;
+    long long anchorOffsetUs_;
+    long long targetOffsetUs_;
+    long long uncertaintyUs_;
+    Sample samples_[FILTER_SAMPLES];
+    int sampleCount_;
+    unsigned long totalSamples_;
+    unsigned long steps_;
+
+    // Epochs; the pending one takes over at its start
+    uint32_t epoch_;
+    long long epochStartUs_;
+    uint32_t pendingEpoch_;
+    long long pendingStartUs_;
+
+    // Render thread only
+    long long tick_;
+    long long tickStartUs_;
+
+    // Helper methods (mutex held)
+    long long offsetAtLocked(long long localUs) const;
+    long long alignToTickLocked(long long sharedUs) const;
+
+    // Disable copy constructor and assignment operator
+    SyncClock(const SyncClock&) = delete;
+    SyncClock& operator=(const SyncClock&) = delete;
+};
+
+#endif // SYNC_CLOCK_H
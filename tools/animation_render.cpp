@@ -0,0 +1,249 @@
+// Pre-renders animations for the anim app (see AnimationFile).
+//
+// Frames come from PPM images (P6, as written by spectrum_render --frames,
+// ImageMagick or ffmpeg), either as files or as a stream on stdin, or from
+// a built-in generator: "plasma", a looping idle screen that is far too
+// expensive to compute per LED on the Pi at full rate, and "wipe", a short
+// intro that ends on a held frame. The tool reports the render time per
+// frame that playback no longer pays.
+//
+//   animation_render --pattern plasma --frames 240 -o idle.anim
+//   animation_render --pattern wipe --once -o intro.anim
+//   animation_render --delay 40 -o spectrum.anim /tmp/frames/frame-*.ppm
+//   ffmpeg -i intro.gif -vf scale=96:48 -f image2pipe -vcodec ppm - | animation_render --once -o intro.anim -
+
+#include "infrastructure/storage/animation_file.h"
+#include "shared/utils/monotonic_clock.h"
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+namespace {
+
+struct Options {
+    std::string output;
+    std::vector<std::string> inputs;   // PPM files, "-" for stdin
+    std::string pattern;
+    int frames;
+    int delayMs;
+    bool once;
+    int width;
+    int height;
+
+    Options() : frames(120), delayMs(33), once(false), width(96), height(48) {}
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " -o <file> [options] [ppm files | -]\n\n";
+    std::cout << "  -o <file>                 Animation file to write\n";
+    std::cout << "  --pattern <plasma|wipe>   Built-in animation instead of PPM input\n";
+    std::cout << "  --frames <n>              Frames of a built-in animation (default: 120)\n";
+    std::cout << "  --size <w>x<h>            Size of a built-in animation (default: 96x48)\n";
+    std::cout << "  --delay <ms>              Time per frame (default: 33)\n";
+    std::cout << "  --once                    Play once and hold the last frame (default: loop)\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "-o") == 0 && hasValue) {
+            options.output = argv[++i];
+        } else if (strcmp(argv[i], "--pattern") == 0 && hasValue) {
+            options.pattern = argv[++i];
+        } else if (strcmp(argv[i], "--frames") == 0 && hasValue) {
+            options.frames = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--size") == 0 && hasValue) {
+            if (sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2) {
+                return false;
+            }
+        } else if (strcmp(argv[i], "--delay") == 0 && hasValue) {
+            options.delayMs = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--once") == 0) {
+            options.once = true;
+        } else if (argv[i][0] != '-' || strcmp(argv[i], "-") == 0) {
+            options.inputs.push_back(argv[i]);
+        } else {
+            return false;
+        }
+    }
+    bool validPattern = options.pattern.empty() || options.pattern == "plasma" || options.pattern == "wipe";
+    return !options.output.empty() && validPattern && options.pattern.empty() != options.inputs.empty() &&
+           options.frames > 0 && options.delayMs > 0 && options.width > 0 && options.height > 0;
+}
+
+// Header field of a PPM: a number after whitespace and comments
+bool readPpmNumber(FILE* in, int& value) {
+    int c = fgetc(in);
+    while (c == '#' || c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+        if (c == '#') {
+            while (c != '\n' && c != EOF) {
+                c = fgetc(in);
+            }
+        }
+        c = fgetc(in);
+    }
+    if (c < '0' || c > '9') {
+        return false;
+    }
+    value = 0;
+    while (c >= '0' && c <= '9') {
+        value = value * 10 + (c - '0');
+        c = fgetc(in);
+    }
+    return true;   // The single whitespace after the number is consumed
+}
+
+// Next binary PPM from `in`; false at the end or on anything else
+bool readPpm(FILE* in, int& width, int& height, std::vector<uint8_t>& pixels) {
+    int maxValue = 0;
+    if (fgetc(in) != 'P' || fgetc(in) != '6' || !readPpmNumber(in, width) || !readPpmNumber(in, height) ||
+        !readPpmNumber(in, maxValue) || maxValue != 255 || width <= 0 || height <= 0) {
+        return false;
+    }
+    pixels.resize((size_t)width * height * 3);
+    return fread(&pixels[0], pixels.size(), 1, in) == 1;
+}
+
+// Sum of sines per LED; colors cycle once per animation so it loops cleanly
+void drawPlasma(int frame, int frames, int width, int height, uint8_t* pixels) {
+    const double twoPi = 6.283185307179586;
+    double t = twoPi * frame / frames;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++, pixels += 3) {
+            double u = (double)x / width;
+            double v = (double)y / height;
+            double value = std::sin(u * 10 + t) + std::sin((v * 8 + t) * 1.5) +
+                           std::sin((u + v) * 6 - 2 * t) +
+                           std::sin(std::sqrt((u - 0.5) * (u - 0.5) * 90 + (v - 0.5) * (v - 0.5) * 90) - t);
+            double phase = value * 0.8 + t;
+            pixels[0] = (uint8_t)(127.5 + 127.5 * std::sin(phase));
+            pixels[1] = (uint8_t)(127.5 + 127.5 * std::sin(phase + twoPi / 3));
+            pixels[2] = (uint8_t)(127.5 + 127.5 * std::sin(phase + 2 * twoPi / 3));
+        }
+    }
+}
+
+// A diagonal band sweeps across, leaving the panel blue behind it
+void drawWipe(int frame, int frames, int width, int height, uint8_t* pixels) {
+    double edge = (double)(frame + 1) / frames * (width + height + 16);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++, pixels += 3) {
+            double distance = edge - (x + y);
+            if (distance < 0) {
+                pixels[0] = pixels[1] = pixels[2] = 0;
+            } else if (distance < 16) {
+                uint8_t level = (uint8_t)(255 - distance * 12);
+                pixels[0] = level;
+                pixels[1] = level;
+                pixels[2] = 255;
+            } else {
+                pixels[0] = 0;
+                pixels[1] = 40;
+                pixels[2] = 160;
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<uint8_t> pixels;
+    AnimationWriter* writer = nullptr;
+    long long renderUs = 0;
+    int rendered = 0;
+
+    if (!options.pattern.empty()) {
+        writer = new AnimationWriter(options.output, options.width, options.height, !options.once);
+        if (!writer->open()) {
+            std::cerr << "❌ " << writer->getLastError() << std::endl;
+            delete writer;   // Removes the partial file
+            return 1;
+        }
+        pixels.resize((size_t)options.width * options.height * 3);
+        for (int i = 0; i < options.frames; i++) {
+            long long startUs = MonotonicClock::nowUs();
+            if (options.pattern == "plasma") {
+                drawPlasma(i, options.frames, options.width, options.height, &pixels[0]);
+            } else {
+                drawWipe(i, options.frames, options.width, options.height, &pixels[0]);
+            }
+            renderUs += MonotonicClock::nowUs() - startUs;
+            rendered++;
+            if (!writer->addFrame(&pixels[0], (uint32_t)options.delayMs)) {
+                std::cerr << "❌ " << writer->getLastError() << std::endl;
+                delete writer;   // Removes the partial file
+                return 1;
+            }
+        }
+    } else {
+        for (size_t i = 0; i < options.inputs.size(); i++) {
+            bool fromStdin = options.inputs[i] == "-";
+            FILE* in = fromStdin ? stdin : fopen(options.inputs[i].c_str(), "rb");
+            if (!in) {
+                std::cerr << "❌ Cannot open " << options.inputs[i] << std::endl;
+                delete writer;   // Removes the partial file
+                return 1;
+            }
+            int width = 0;
+            int height = 0;
+            int framesInInput = 0;
+            while (readPpm(in, width, height, pixels)) {
+                if (!writer) {
+                    writer = new AnimationWriter(options.output, width, height, !options.once);
+                    if (!writer->open()) {
+                        std::cerr << "❌ " << writer->getLastError() << std::endl;
+                        delete writer;   // Removes the partial file
+                        return 1;
+                    }
+                    options.width = width;
+                    options.height = height;
+                } else if (width != options.width || height != options.height) {
+                    std::cerr << "❌ " << options.inputs[i] << " is " << width << "x" << height << ", earlier frames are "
+                              << options.width << "x" << options.height << std::endl;
+                    delete writer;   // Removes the partial file
+                    return 1;
+                }
+                if (!writer->addFrame(&pixels[0], (uint32_t)options.delayMs)) {
+                    std::cerr << "❌ " << writer->getLastError() << std::endl;
+                    delete writer;   // Removes the partial file
+                    return 1;
+                }
+                framesInInput++;
+                rendered++;
+            }
+            if (!fromStdin) {
+                fclose(in);
+            }
+            if (framesInInput == 0) {
+                std::cerr << "❌ No binary PPM (P6, 8 bits) in " << options.inputs[i] << std::endl;
+                delete writer;   // Removes the partial file
+                return 1;
+            }
+        }
+    }
+
+    if (!writer->finish()) {
+        std::cerr << "❌ " << writer->getLastError() << std::endl;
+        delete writer;   // Removes the partial file
+        return 1;
+    }
+    std::cout << "✅ Wrote " << options.output << ": " << options.width << "x" << options.height << ", "
+              << writer->getFrameCount() << " frames (" << writer->getMergedCount() << " repeats merged), "
+              << (rendered * (long long)options.delayMs / 1000.0) << " s " << (options.once ? "once" : "looped") << std::endl;
+    if (!options.pattern.empty()) {
+        std::cout << "  render:   " << (renderUs / rendered) << " µs per frame, done once here instead of on every playback"
+                  << std::endl;
+    }
+    delete writer;
+    return 0;
+}
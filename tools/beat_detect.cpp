@@ -0,0 +1,152 @@
+// Headless run of the beat tracker behind --beat-border (see BeatTracker).
+//
+// Reads a WAV file (or raw s16le PCM) as fast as possible and feeds channel
+// 0 through the same BeatTracker the audio source uses, in the same block
+// size. Prints the tempo it settles on, how long it took to lock and the
+// time per hop. With --expect-bpm it exits with status 2 unless the final
+// tempo is within 2% of the given one, so WAVs of known tempo double as
+// regression checks.
+//
+//   beat_detect song.wav --beats
+//   beat_detect click-120.wav --expect-bpm 120
+
+#include "infrastructure/audio/pcm_source.h"
+#include "infrastructure/config/config.h"
+#include "shared/dsp/beat_tracker.h"
+#include "shared/dsp/level_kernels.h"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+namespace {
+
+const size_t BLOCK_FRAMES = 1024;
+const double BPM_TOLERANCE = 0.02;
+
+struct Options {
+    std::string input;
+    int rawRate;
+    int rawChannels;
+    bool printBeats;
+    double expectedBpm;
+
+    Options() : rawRate(Config::DEFAULT_AUDIO_SAMPLE_RATE), rawChannels(1), printBeats(false), expectedBpm(0.0) {}
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " <wav or raw PCM> [options]\n\n";
+    std::cout << "  --rate <hz>         Sample rate of raw PCM (default: " << Config::DEFAULT_AUDIO_SAMPLE_RATE << ")\n";
+    std::cout << "  --channels <n>      Channels of raw PCM (default: 1)\n";
+    std::cout << "  --beats             Print the time of every beat\n";
+    std::cout << "  --expect-bpm <bpm>  Exit with status 2 unless the tempo is within 2%\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--rate") == 0 && hasValue) {
+            options.rawRate = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--channels") == 0 && hasValue) {
+            options.rawChannels = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--beats") == 0) {
+            options.printBeats = true;
+        } else if (strcmp(argv[i], "--expect-bpm") == 0 && hasValue) {
+            options.expectedBpm = std::atof(argv[++i]);
+        } else if (argv[i][0] != '-' && options.input.empty()) {
+            options.input = argv[i];
+        } else {
+            return false;
+        }
+    }
+    return !options.input.empty() && options.rawRate > 0 && options.rawChannels > 0 &&
+           options.rawChannels <= PcmSource::MAX_CHANNELS && options.expectedBpm >= 0.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    PcmSource source(options.input, options.rawRate, options.rawChannels);
+    if (!source.open()) {
+        std::cerr << "❌ " << source.getLastError() << std::endl;
+        return 1;
+    }
+
+    BeatTracker tracker;
+    tracker.prepare(source.getSampleRate());
+    double sampleRate = source.getSampleRate();
+
+    std::cout << "🥁 " << options.input << ": " << source.getSampleRate() << " Hz, " << source.getChannels()
+              << " ch; FFT " << BeatTracker::FFT_SIZE << ", hop " << tracker.getHop() << " samples" << std::endl;
+
+    std::vector<int16_t> pcm(BLOCK_FRAMES * source.getChannels());
+    std::vector<float> samples(BLOCK_FRAMES);
+
+    typedef std::chrono::steady_clock Clock;
+    double trackSeconds = 0.0;
+    unsigned long long frames = 0;
+    double lockedAt = -1.0;
+
+    while (true) {
+        long count = source.readFrames(&pcm[0], BLOCK_FRAMES);
+        if (count < 0) {
+            if (source.getLastError() != "End of input") {
+                std::cerr << "❌ " << source.getLastError() << std::endl;
+            }
+            break;
+        }
+        if (count == 0) {
+            continue;
+        }
+        frames += (unsigned long long)count;
+        LevelKernels::deinterleaveToFloat(&pcm[0], (size_t)count, source.getChannels(), 0, &samples[0]);
+
+        Clock::time_point start = Clock::now();
+        size_t beats = tracker.process(&samples[0], (size_t)count);
+        trackSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+        if (lockedAt < 0.0 && tracker.isLocked()) {
+            lockedAt = frames / sampleRate;
+        } else if (!tracker.isLocked()) {
+            lockedAt = -1.0;
+        }
+        if (beats > 0 && options.printBeats) {
+            double beatSeconds = (frames - tracker.getSamplesSinceBeat()) / sampleRate;
+            printf("  beat %lu at %8.3f s  %6.1f BPM  confidence %.2f\n", tracker.getBeatCount(), beatSeconds,
+                   tracker.getTempoBpm(), tracker.getConfidence());
+        }
+    }
+
+    if (frames == 0) {
+        std::cerr << "❌ No audio in " << options.input << std::endl;
+        return 1;
+    }
+
+    double audioSeconds = frames / sampleRate;
+    double hops = std::max(1.0, std::floor((double)frames / tracker.getHop()));
+    double bpm = tracker.getTempoBpm();
+    printf("⏱️  %.1f s of audio in %.3f s (%.0fx real time), %.2f us per hop\n", audioSeconds, trackSeconds,
+           trackSeconds > 0.0 ? audioSeconds / trackSeconds : 0.0, trackSeconds * 1e6 / hops);
+    printf("🎯 %lu onsets, %lu beats", tracker.getOnsetCount(), tracker.getBeatCount());
+    if (bpm > 0.0) {
+        printf("; tempo %.1f BPM (confidence %.2f), locked since %.1f s\n", bpm, tracker.getConfidence(), lockedAt);
+    } else {
+        printf("; no steady tempo (confidence %.2f)\n", tracker.getConfidence());
+    }
+
+    if (options.expectedBpm > 0.0 && std::fabs(bpm - options.expectedBpm) > BPM_TOLERANCE * options.expectedBpm) {
+        std::cerr << "❌ Expected " << options.expectedBpm << " BPM" << std::endl;
+        return 2;
+    }
+    return 0;
+}
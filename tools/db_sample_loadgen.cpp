@@ -0,0 +1,151 @@
+// Load generator for the UDP dB sample feed (see DbSampleProtocol).
+//
+// Sends a synthetic sound level (slow swell plus short spikes) at a fixed
+// sample rate, or as fast as the socket allows with --rate 0, and prints the
+// achieved rate every second. Compare with the display's "ingest" command
+// to see what the receiver sustained and whether anything was dropped.
+
+#include "infrastructure/network/db_sample_protocol.h"
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+namespace {
+
+struct Options {
+    std::string host;
+    int port;
+    long rate;        // Samples per second, 0 = unthrottled
+    int batch;        // Samples per packet
+    int seconds;
+    int channel;
+
+    Options() : host("127.0.0.1"), port(DbSampleProtocol::DEFAULT_PORT), rate(10000),
+                batch(64), seconds(10), channel(0) {}
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n\n";
+    std::cout << "  --host <ip>       Receiver address (default: 127.0.0.1)\n";
+    std::cout << "  --port <port>     Receiver UDP port (default: " << DbSampleProtocol::DEFAULT_PORT << ")\n";
+    std::cout << "  --rate <n>        Samples per second, 0 = as fast as possible (default: 10000)\n";
+    std::cout << "  --batch <n>       Samples per packet, 1-" << DbSampleProtocol::MAX_SAMPLES_PER_PACKET << " (default: 64)\n";
+    std::cout << "  --seconds <n>     Run time (default: 10)\n";
+    std::cout << "  --channel <n>     Channel number 0-255 (default: 0)\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--host") == 0 && hasValue) {
+            options.host = argv[++i];
+        } else if (strcmp(argv[i], "--port") == 0 && hasValue) {
+            options.port = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rate") == 0 && hasValue) {
+            options.rate = std::atol(argv[++i]);
+        } else if (strcmp(argv[i], "--batch") == 0 && hasValue) {
+            options.batch = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            options.seconds = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--channel") == 0 && hasValue) {
+            options.channel = std::atoi(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    return options.batch >= 1 && options.batch <= DbSampleProtocol::MAX_SAMPLES_PER_PACKET &&
+           options.rate >= 0 && options.seconds > 0 && options.channel >= 0 && options.channel <= 255;
+}
+
+// 60 dB +/- 15 dB swell every 4 seconds of samples, with a 110 dB spike
+// one sample in 997 (a peak that plain "latest value" display would miss)
+uint16_t syntheticSample(unsigned long index, long rate) {
+    if (index % 997 == 0) {
+        return 11000;
+    }
+    double period = (rate > 0 ? rate : 100000) * 4.0;
+    double db = 60.0 + 15.0 * std::sin(2.0 * M_PI * (double)(index % (unsigned long)period) / period);
+    return (uint16_t)(db * 100.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)options.port);
+    if (fd < 0 || inet_pton(AF_INET, options.host.c_str(), &addr.sin_addr) != 1) {
+        std::cerr << "❌ Invalid receiver address: " << options.host << std::endl;
+        return 1;
+    }
+
+    std::cout << "🚀 Sending " << (options.rate ? std::to_string(options.rate) + " samples/s" : std::string("unthrottled"))
+              << " in packets of " << options.batch << " to " << options.host << ":" << options.port << std::endl;
+
+    uint16_t samples[DbSampleProtocol::MAX_SAMPLES_PER_PACKET];
+    uint8_t packet[DbSampleProtocol::MAX_PACKET_SIZE];
+    unsigned long sent = 0;
+    unsigned long failedSends = 0;
+    unsigned long sentAtLastReport = 0;
+    uint32_t sequence = 0;
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    Clock::time_point end = start + std::chrono::seconds(options.seconds);
+    Clock::time_point nextReport = start + std::chrono::seconds(1);
+
+    while (true) {
+        Clock::time_point now = Clock::now();
+        if (now >= end) {
+            break;
+        }
+
+        if (now >= nextReport) {
+            std::cout << "  " << (sent - sentAtLastReport) << " samples/s" << std::endl;
+            sentAtLastReport = sent;
+            nextReport += std::chrono::seconds(1);
+        }
+
+        // Pace against the schedule rather than sleeping per packet, so
+        // sleep granularity doesn't cap the rate
+        if (options.rate > 0) {
+            double elapsed = std::chrono::duration<double>(now - start).count();
+            if (sent >= (unsigned long)(elapsed * options.rate)) {
+                std::this_thread::sleep_for(std::chrono::microseconds(500));
+                continue;
+            }
+        }
+
+        for (int i = 0; i < options.batch; i++) {
+            samples[i] = syntheticSample(sent + i, options.rate);
+        }
+        size_t size = DbSampleProtocol::encodePacket(packet, sizeof(packet), (uint8_t)options.channel,
+                                                     sequence++, samples, (uint16_t)options.batch);
+        if (sendto(fd, packet, size, 0, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+            failedSends++;
+        }
+        sent += options.batch;
+    }
+
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << "✅ Sent " << sent << " samples in " << sequence << " packets ("
+              << (unsigned long)(sent / elapsed) << " samples/s, " << failedSends << " send errors)" << std::endl;
+
+    close(fd);
+    return 0;
+}
@@ -0,0 +1,204 @@
+// Replays a dB trace (see DbTrace) through the dB meter app and its display
+// in virtual time, as fast as the CPU allows.
+//
+// The virtual clock steps one frame at a time. Before each frame, the
+// readings due by then go into the sample ring as if they had just
+// arrived. The app then ingests and renders into a MemoryCanvas exactly as
+// on the panel. Every frame is hashed. The same trace and options always
+// give the same final hash, so a recorded field trace becomes a regression
+// check, and the time per frame measures render CPU at scale.
+//
+//   db_trace_replay field.trace
+//   db_trace_replay field.trace --hashes frames.txt --expect 9c1e0d4f7a2b3c11
+
+#include "presentation/controllers/db_meter_app.h"
+#include "infrastructure/display/memory_canvas.h"
+#include "infrastructure/storage/db_trace.h"
+#include "shared/utils/clock.h"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+namespace {
+
+const int PANEL_WIDTH = 96;
+const int PANEL_HEIGHT = 48;
+
+struct Options {
+    std::string trace;
+    int fps;
+    std::string timeWeighting;
+    bool alreadyWeighted;
+    std::vector<std::string> thresholds;
+    std::string hashesPath;
+    std::string expectedHash;
+
+    Options() : fps(100), timeWeighting("fast"), alreadyWeighted(false) {}
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " <trace> [options]\n\n";
+    std::cout << "  --fps <n>                Virtual frames per second (default: 100, like the render loop)\n";
+    std::cout << "  --time-weighting <mode>  fast, slow or impulse (default: fast)\n";
+    std::cout << "  --audio-weighted         Readings are already time-weighted (recorded from --audio)\n";
+    std::cout << "  --channel-thresholds <list> Yellow/orange/red dB per channel, comma-separated\n";
+    std::cout << "  --hashes <file>          Write '<frame> <ms> <hash>' for every frame\n";
+    std::cout << "  --expect <hash>          Exit with status 2 unless the final hash matches\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--fps") == 0 && hasValue) {
+            options.fps = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--time-weighting") == 0 && hasValue) {
+            options.timeWeighting = argv[++i];
+        } else if (strcmp(argv[i], "--audio-weighted") == 0) {
+            options.alreadyWeighted = true;
+        } else if (strcmp(argv[i], "--channel-thresholds") == 0 && hasValue) {
+            std::string list = argv[++i];
+            size_t start = 0;
+            while (start <= list.size()) {
+                size_t comma = list.find(',', start);
+                if (comma == std::string::npos) {
+                    comma = list.size();
+                }
+                options.thresholds.push_back(list.substr(start, comma - start));
+                start = comma + 1;
+            }
+        } else if (strcmp(argv[i], "--hashes") == 0 && hasValue) {
+            options.hashesPath = argv[++i];
+        } else if (strcmp(argv[i], "--expect") == 0 && hasValue) {
+            options.expectedHash = argv[++i];
+        } else if (argv[i][0] != '-' && options.trace.empty()) {
+            options.trace = argv[i];
+        } else {
+            return false;
+        }
+    }
+    return !options.trace.empty() && options.fps > 0 && options.fps <= 1000;
+}
+
+// FNV-1a over 64-bit words; the canvas size is a multiple of 8 bytes
+uint64_t hashCanvas(const MemoryCanvas& canvas, uint64_t hash) {
+    const uint8_t* pixels = canvas.getPixel(0, 0);
+    size_t size = (size_t)canvas.width() * canvas.height() * 3;
+    for (size_t i = 0; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, pixels + i, sizeof(word));
+        hash = (hash ^ word) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    LevelBallistics::Mode mode;
+    if (!LevelBallistics::parse(options.timeWeighting, mode)) {
+        std::cerr << "❌ Unknown time weighting: " << options.timeWeighting << std::endl;
+        return 1;
+    }
+
+    DbTraceReader reader;
+    if (!reader.open(options.trace)) {
+        std::cerr << "❌ " << reader.getLastError() << std::endl;
+        return 1;
+    }
+
+    FILE* hashes = nullptr;
+    if (!options.hashesPath.empty()) {
+        hashes = fopen(options.hashesPath.c_str(), "w");
+        if (!hashes) {
+            std::cerr << "❌ Cannot create " << options.hashesPath << std::endl;
+            return 1;
+        }
+    }
+
+    VirtualClock clock(0);
+    MemoryCanvas canvas(PANEL_WIDTH, PANEL_HEIGHT);
+    DbSampleRing ring(Config::SAMPLE_RING_CAPACITY);
+    DbMeterApp app(nullptr, Config::DEFAULT_BRIGHTNESS, &clock);
+    app.setTimeWeighting(mode, options.alreadyWeighted);
+    for (size_t i = 0; i < options.thresholds.size(); i++) {
+        DbColorCalculator::Thresholds parsed;
+        if (!DbColorCalculator::parseThresholds(options.thresholds[i], parsed)) {
+            std::cerr << "❌ Invalid thresholds for channel " << i << ": " << options.thresholds[i] << std::endl;
+            return 1;
+        }
+        app.setChannelThresholds((int)i, parsed);
+    }
+    app.setSampleRing(&ring);
+    app.initialize(&canvas);
+
+    typedef std::chrono::steady_clock WallClock;
+    std::vector<float> frameUs;
+    uint64_t traceHash = 14695981039346656037ULL;
+    unsigned long long samples = 0;
+    WallClock::time_point started = WallClock::now();
+
+    // Frame n runs at n * 1000 / fps ms, computed exactly so long traces
+    // don't drift
+    for (long long frame = 0; !reader.isFinished(); frame++) {
+        long long nowMs = frame * 1000 / options.fps;
+        clock.setMs(nowMs);
+
+        WallClock::time_point frameStart = WallClock::now();
+        samples += reader.feedUntil(nowMs, ring);
+        app.ingestSamples();
+        app.update();
+        frameUs.push_back(std::chrono::duration<float, std::micro>(WallClock::now() - frameStart).count());
+
+        uint64_t frameHash = hashCanvas(canvas, 14695981039346656037ULL);
+        traceHash = (traceHash ^ frameHash) * 1099511628211ULL;
+        if (hashes) {
+            fprintf(hashes, "%lld %lld %016llx\n", frame, nowMs, (unsigned long long)frameHash);
+        }
+    }
+    double wallSeconds = std::chrono::duration<double>(WallClock::now() - started).count();
+
+    if (hashes) {
+        fclose(hashes);
+    }
+    if (!reader.getLastError().empty()) {
+        std::cerr << "❌ " << reader.getLastError() << std::endl;
+        return 1;
+    }
+    if (frameUs.empty()) {
+        std::cerr << "❌ Empty trace" << std::endl;
+        return 1;
+    }
+
+    size_t frames = frameUs.size();
+    double virtualSeconds = (double)(frames - 1) / options.fps;
+    double sum = 0.0;
+    for (size_t i = 0; i < frames; i++) {
+        sum += frameUs[i];
+    }
+    std::sort(frameUs.begin(), frameUs.end());
+
+    char hashText[17];
+    snprintf(hashText, sizeof(hashText), "%016llx", (unsigned long long)traceHash);
+    printf("📼 %s: %llu readings, %zu frames, %.1f s of virtual time\n", options.trace.c_str(), samples, frames,
+           virtualSeconds);
+    printf("⏱️  %.2f s wall (%.0fx real time); frame mean %.1f us, p50 %.1f us, p99 %.1f us, max %.1f us\n",
+           wallSeconds, wallSeconds > 0.0 ? virtualSeconds / wallSeconds : 0.0, sum / frames,
+           frameUs[frames / 2], frameUs[frames * 99 / 100], frameUs[frames - 1]);
+    printf("🔑 Final hash %s\n", hashText);
+
+    if (!options.expectedHash.empty() && options.expectedHash != hashText) {
+        std::cerr << "❌ Expected " << options.expectedHash << std::endl;
+        return 2;
+    }
+    return 0;
+}
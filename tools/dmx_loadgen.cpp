@@ -0,0 +1,336 @@
+// Packet generator for the dmx app (Art-Net or sACN, see DmxProtocol).
+//
+// Sends a moving test pattern over every universe of the layout at a fixed
+// frame rate, each frame as one sendmmsg() batch ending with a sync packet
+// (unless --no-sync), and prints the achieved frame and packet rate every
+// second. Point it at a display showing the dmx app, or run it with
+// --check to receive on loopback in the same process: a 10 ms poll loop
+// stands in for the render loop, and every frame it would swap in is
+// checked for tearing (pixels from more than one sent frame) and timed
+// from its sync packet.
+//
+//   dmx_loadgen --host 192.168.1.50 --fps 44
+//   dmx_loadgen --protocol sacn --layout 1/96/snake --fps 60 --check
+
+#include "infrastructure/network/dmx_protocol.h"
+#include "infrastructure/network/dmx_receiver.h"
+#include "infrastructure/display/dmx_renderer.h"
+#include "infrastructure/display/memory_canvas.h"
+#include "shared/utils/monotonic_clock.h"
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+namespace {
+
+const int CHECK_POLL_MS = 10;   // The main loop's frame delay
+
+struct Options {
+    DmxProtocol::Protocol protocol;
+    std::string host;
+    int port;              // 0 = the protocol's
+    int fps;
+    int seconds;
+    std::string layout;    // Empty = the protocol's first universe, 170 pixels
+    int width;
+    int height;
+    bool sync;
+    bool multicast;
+    bool check;
+
+    Options() : protocol(DmxProtocol::ART_NET), host("127.0.0.1"), port(0), fps(40), seconds(10),
+                width(96), height(48), sync(true), multicast(false), check(false) {}
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n\n";
+    std::cout << "  --protocol <artnet|sacn>  Protocol (default: artnet)\n";
+    std::cout << "  --host <ip>               Display address (default: 127.0.0.1)\n";
+    std::cout << "  --port <port>             UDP port (default: 6454 Art-Net, 5568 sACN)\n";
+    std::cout << "  --fps <n>                 Frames per second (default: 40)\n";
+    std::cout << "  --seconds <n>             Run time (default: 10)\n";
+    std::cout << "  --layout <layout>         first[/pixels per universe][/snake], as --dmx-layout\n";
+    std::cout << "  --size <w>x<h>            Canvas size (default: 96x48)\n";
+    std::cout << "  --no-sync                 Don't send sync packets\n";
+    std::cout << "  --multicast               sACN: send each universe to its multicast group\n";
+    std::cout << "  --check                   Receive on loopback and check every shown frame\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--protocol") == 0 && hasValue) {
+            if (!DmxProtocol::parseProtocol(argv[++i], options.protocol)) {
+                return false;
+            }
+        } else if (strcmp(argv[i], "--host") == 0 && hasValue) {
+            options.host = argv[++i];
+        } else if (strcmp(argv[i], "--port") == 0 && hasValue) {
+            options.port = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--fps") == 0 && hasValue) {
+            options.fps = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            options.seconds = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--layout") == 0 && hasValue) {
+            options.layout = argv[++i];
+        } else if (strcmp(argv[i], "--size") == 0 && hasValue) {
+            if (sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2) {
+                return false;
+            }
+        } else if (strcmp(argv[i], "--no-sync") == 0) {
+            options.sync = false;
+        } else if (strcmp(argv[i], "--multicast") == 0) {
+            options.multicast = true;
+        } else if (strcmp(argv[i], "--check") == 0) {
+            options.check = true;
+        } else {
+            return false;
+        }
+    }
+    return options.fps > 0 && options.seconds > 0 && options.width > 0 && options.height > 0 &&
+           options.width * options.height <= DmxRenderer::MAX_UNIVERSES * DmxRenderer::MAX_PIXELS_PER_UNIVERSE;
+}
+
+// Red moves right, green grows downwards, blue holds the frame number so
+// --check can tell frames apart in every pixel
+void patternPixel(unsigned long frame, int x, int y, uint8_t* rgb) {
+    rgb[0] = (uint8_t)(x * 8 + frame * 4);
+    rgb[1] = (uint8_t)(y * 5);
+    rgb[2] = (uint8_t)frame;
+}
+
+// Pixel coordinates of a universe slot, as the display maps them
+void pixelAt(const DmxRenderer::Layout& layout, int width, int index, int pixel, int& x, int& y) {
+    int number = index * layout.pixelsPerUniverse + pixel;
+    y = number / width;
+    x = number % width;
+    if (layout.snake && (y & 1)) {
+        x = width - 1 - x;
+    }
+}
+
+// Stands in for DmxDisplay: draws into a MemoryCanvas and checks each frame
+class FrameChecker : public DmxReceiver::Listener {
+public:
+    FrameChecker(int width, int height, const DmxRenderer::Layout& layout, const std::atomic<long long>* sentUs)
+        : canvas_(width, height), renderer_(width, height, layout), sentUs_(sentUs),
+          frames_(0), torn_(0), latencyTotalUs_(0), latencyMaxUs_(0) {}
+
+    virtual void onUniverse(int index, const uint8_t* slots, size_t size) {
+        renderer_.drawUniverse(&canvas_, index, slots, size);
+    }
+
+    virtual void onFrame(const DmxReceiver& receiver) {
+        (void)receiver;
+        uint8_t frame = canvas_.getPixel(0, 0)[2];
+        for (int y = 0; y < canvas_.height(); y++) {
+            for (int x = 0; x < canvas_.width(); x++) {
+                if (canvas_.getPixel(x, y)[2] != frame) {
+                    torn_++;
+                    y = canvas_.height();
+                    break;
+                }
+            }
+        }
+
+        long long latency = MonotonicClock::nowUs() - sentUs_[frame].load();
+        latencyTotalUs_ += latency;
+        if (latency > latencyMaxUs_) {
+            latencyMaxUs_ = latency;
+        }
+        frames_++;
+    }
+
+    void printSummary(double seconds) const {
+        std::cout << "🔎 Shown " << frames_ << " frames (" << (int)(frames_ / seconds + 0.5) << "/s), "
+                  << torn_ << " torn; sync to swap " << (frames_ ? latencyTotalUs_ / frames_ : 0)
+                  << " µs average, " << latencyMaxUs_ << " µs worst" << std::endl;
+    }
+
+    unsigned long getTornCount() const { return torn_; }
+
+private:
+    MemoryCanvas canvas_;
+    DmxRenderer renderer_;
+    const std::atomic<long long>* sentUs_;
+    unsigned long frames_;
+    unsigned long torn_;
+    long long latencyTotalUs_;
+    long long latencyMaxUs_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    DmxRenderer::Layout layout;
+    layout.firstUniverse = DmxProtocol::defaultFirstUniverse(options.protocol);
+    if (!options.layout.empty() && !DmxRenderer::parseLayout(options.layout, layout)) {
+        std::cerr << "❌ Invalid layout: " << options.layout << std::endl;
+        return 1;
+    }
+    int universes = DmxRenderer::countUniverses(options.width, options.height, layout);
+    int port = options.port > 0 ? options.port : DmxProtocol::defaultPort(options.protocol);
+
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in target;
+    std::memset(&target, 0, sizeof(target));
+    target.sin_family = AF_INET;
+    target.sin_port = htons((uint16_t)port);
+    if (fd < 0 || inet_pton(AF_INET, options.host.c_str(), &target.sin_addr) != 1) {
+        std::cerr << "❌ Invalid display address: " << options.host << std::endl;
+        return 1;
+    }
+    int enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_BROADCAST, &enable, sizeof(enable));
+
+    // One buffer and address per universe plus the sync packet, built per frame
+    int packets = universes + (options.sync ? 1 : 0);
+    std::vector<uint8_t> buffers((size_t)packets * DmxProtocol::MAX_PACKET_SIZE);
+    std::vector<struct sockaddr_in> addresses(packets, target);
+    std::vector<struct iovec> iovecs(packets);
+    std::vector<struct mmsghdr> messages(packets);
+    std::memset(&messages[0], 0, sizeof(struct mmsghdr) * packets);
+    for (int i = 0; i < packets; i++) {
+        if (options.multicast && options.protocol == DmxProtocol::SACN) {
+            uint16_t universe = (uint16_t)(i < universes ? layout.firstUniverse + i : layout.firstUniverse);
+            addresses[i].sin_addr.s_addr = htonl(DmxProtocol::sacnMulticastAddress(universe));
+        }
+        iovecs[i].iov_base = &buffers[(size_t)i * DmxProtocol::MAX_PACKET_SIZE];
+        messages[i].msg_hdr.msg_iov = &iovecs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+        messages[i].msg_hdr.msg_name = &addresses[i];
+        messages[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    }
+
+    // --check listens before the first frame goes out
+    std::atomic<long long> sentUs[256];
+    for (int i = 0; i < 256; i++) {
+        sentUs[i] = 0;
+    }
+    DmxReceiver* receiver = nullptr;
+    if (options.check) {
+        receiver = new DmxReceiver(options.protocol, port, layout.firstUniverse, universes);
+        if (!receiver->start()) {
+            std::cerr << "❌ " << receiver->getLastError() << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "🚀 Sending " << options.width << "x" << options.height << " at " << options.fps << " fps as "
+              << universes << " universes from " << layout.firstUniverse << (options.sync ? " plus sync" : "")
+              << " to " << options.host << ":" << port << std::endl;
+
+    std::atomic<bool> sending(true);
+    std::atomic<unsigned long> framesSent(0);
+    std::atomic<unsigned long> failedSends(0);
+    std::thread sender([&]() {
+        const uint8_t cid[DmxProtocol::CID_SIZE] = { 'l', 'e', 'd', '-', 'm', 'a', 't', 'r', 'i', 'x', '-', 'g', 'e', 'n', 0, 1 };
+        uint8_t slots[DmxProtocol::CHANNELS_PER_UNIVERSE];
+        typedef std::chrono::steady_clock SteadyClock;
+        SteadyClock::time_point start = SteadyClock::now();
+        std::chrono::nanoseconds interval(1000000000LL / options.fps);
+        unsigned long frame = 0;
+
+        while (sending) {
+            for (int i = 0; i < universes; i++) {
+                int count = layout.pixelsPerUniverse;
+                if (count > options.width * options.height - i * layout.pixelsPerUniverse) {
+                    count = options.width * options.height - i * layout.pixelsPerUniverse;
+                }
+                for (int p = 0; p < count; p++) {
+                    int x = 0;
+                    int y = 0;
+                    pixelAt(layout, options.width, i, p, x, y);
+                    patternPixel(frame, x, y, slots + p * 3);
+                }
+
+                uint16_t universe = (uint16_t)(layout.firstUniverse + i);
+                uint8_t sequence = (uint8_t)(frame % 255 + 1);
+                uint8_t* out = (uint8_t*)iovecs[i].iov_base;
+                iovecs[i].iov_len = options.protocol == DmxProtocol::ART_NET
+                    ? DmxProtocol::encodeArtDmx(out, DmxProtocol::MAX_PACKET_SIZE, universe, sequence, slots, (uint16_t)(count * 3))
+                    : DmxProtocol::encodeSacnData(out, DmxProtocol::MAX_PACKET_SIZE, cid, "dmx_loadgen", universe, sequence,
+                                                  options.sync ? (uint16_t)layout.firstUniverse : 0, slots, (uint16_t)(count * 3));
+            }
+            if (options.sync) {
+                uint8_t* out = (uint8_t*)iovecs[universes].iov_base;
+                iovecs[universes].iov_len = options.protocol == DmxProtocol::ART_NET
+                    ? DmxProtocol::encodeArtSync(out, DmxProtocol::MAX_PACKET_SIZE)
+                    : DmxProtocol::encodeSacnSync(out, DmxProtocol::MAX_PACKET_SIZE, cid, (uint16_t)layout.firstUniverse,
+                                                  (uint8_t)frame);
+            }
+
+            sentUs[frame & 0xFF] = MonotonicClock::nowUs();
+            int sent = 0;
+            while (sent < packets) {
+                int result = sendmmsg(fd, &messages[sent], packets - sent, 0);
+                if (result <= 0) {
+                    failedSends += packets - sent;
+                    break;
+                }
+                sent += result;
+            }
+            frame++;
+            framesSent = frame;
+
+            std::this_thread::sleep_until(start + interval * frame);
+        }
+    });
+
+    FrameChecker* checker = nullptr;
+    if (receiver) {
+        checker = new FrameChecker(options.width, options.height, layout, sentUs);
+    }
+
+    long long startMs = MonotonicClock::nowMs();
+    long long endMs = startMs + options.seconds * 1000LL;
+    long long nextReportMs = startMs + 1000;
+    unsigned long framesAtLastReport = 0;
+    while (MonotonicClock::nowMs() < endMs) {
+        if (receiver) {
+            receiver->poll(*checker);
+            usleep(CHECK_POLL_MS * 1000);
+        } else {
+            usleep(20000);
+        }
+
+        if (MonotonicClock::nowMs() >= nextReportMs) {
+            unsigned long frames = framesSent;
+            std::cout << "  " << (frames - framesAtLastReport) << " frames/s, "
+                      << (frames - framesAtLastReport) * packets << " packets/s" << std::endl;
+            framesAtLastReport = frames;
+            nextReportMs += 1000;
+        }
+    }
+    sending = false;
+    sender.join();
+
+    double elapsed = (MonotonicClock::nowMs() - startMs) / 1000.0;
+    std::cout << "✅ Sent " << framesSent << " frames in " << framesSent * packets << " packets ("
+              << (int)(framesSent / elapsed + 0.5) << " fps, " << failedSends << " send errors)" << std::endl;
+
+    int status = 0;
+    if (receiver) {
+        receiver->printReport(std::cout);
+        checker->printSummary(elapsed);
+        status = checker->getTornCount() == 0 ? 0 : 2;
+        delete checker;
+        delete receiver;
+    }
+    close(fd);
+    return status;
+}
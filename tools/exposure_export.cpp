@@ -0,0 +1,112 @@
+// Exports exposure logs (see ExposureLog) to CSV.
+//
+// Each record becomes one row with its local time and the running OSHA and
+// NIOSH dose of its channel for that day, recomputed from the logged Leq so
+// the result covers the whole day even across display restarts. A dose
+// summary per file and channel goes to stderr.
+//
+//   exposure_export data/exposure/exposure-20260101.log > day.csv
+//   exposure_export -o week.csv data/exposure/*.log
+
+#include "infrastructure/storage/exposure_log.h"
+#include "shared/dsp/noise_dosimeter.h"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace {
+
+const int MAX_CHANNELS = 256;
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [-o <file.csv>] <exposure log>...\n\n";
+    std::cout << "  -o, --output <file>  Write CSV here instead of stdout\n";
+}
+
+bool exportFile(const std::string& path, std::ostream& out) {
+    ExposureLogHeader header;
+    std::vector<ExposureRecord> records;
+    std::string error;
+    if (!ExposureLog::readFile(path, header, records, error)) {
+        std::cerr << "❌ " << path << ": " << error << std::endl;
+        return false;
+    }
+
+    std::vector<NoiseDosimeter> osha(MAX_CHANNELS, NoiseDosimeter(NoiseDosimeter::STANDARD_OSHA));
+    std::vector<NoiseDosimeter> niosh(MAX_CHANNELS, NoiseDosimeter(NoiseDosimeter::STANDARD_NIOSH));
+    std::vector<bool> seen(MAX_CHANNELS, false);
+
+    char line[160];
+    for (size_t i = 0; i < records.size(); i++) {
+        const ExposureRecord& record = records[i];
+        double leq = record.leq / 100.0;
+        osha[record.channel].addLevel(leq, 1.0);
+        niosh[record.channel].addLevel(leq, 1.0);
+        seen[record.channel] = true;
+
+        time_t timestamp = (time_t)record.timestamp;
+        struct tm local;
+        localtime_r(&timestamp, &local);
+        char time[32];
+        strftime(time, sizeof(time), "%Y-%m-%d %H:%M:%S", &local);
+
+        snprintf(line, sizeof(line), "%s,%u,%u,%.2f,%.2f,%.2f,%u,%.3f,%.3f",
+                 time, record.timestamp, record.channel, leq, record.max / 100.0, record.min / 100.0,
+                 record.readings, osha[record.channel].getDosePercent(), niosh[record.channel].getDosePercent());
+        out << line << '\n';
+    }
+
+    std::cerr << "📄 " << path << ": " << records.size() << " records" << std::endl;
+    for (int c = 0; c < MAX_CHANNELS; c++) {
+        if (!seen[c]) {
+            continue;
+        }
+        snprintf(line, sizeof(line), "   ch%d: %.0f s logged, OSHA %.1f%% (TWA %.1f dB), NIOSH %.1f%% (TWA %.1f dB)",
+                 c, osha[c].getSeconds(), osha[c].getDosePercent(), osha[c].getTwa(),
+                 niosh[c].getDosePercent(), niosh[c].getTwa());
+        std::cerr << line << std::endl;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string outputPath;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0) && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (argv[i][0] == '-') {
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            inputs.push_back(argv[i]);
+        }
+    }
+    if (inputs.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath.c_str());
+        if (!file) {
+            std::cerr << "❌ Cannot write " << outputPath << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+
+    out << "time,unix_time,channel,leq_db,max_db,min_db,readings,osha_dose_pct,niosh_dose_pct\n";
+    int failed = 0;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        if (!exportFile(inputs[i], out)) {
+            failed++;
+        }
+    }
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,277 @@
+// Simulation of the background fetch scheduler (see FetchScheduler) with
+// thousands of sources against a stub server.
+//
+// Every source polls the stub, which takes --latency-ms per request and
+// counts how many fetches of each key run at the same time. Meanwhile a
+// simulated user mashes 'r' on random keys: each burst sends --presses
+// user refreshes for one key back to back. At the end the tool checks that
+// no key was ever fetched twice at once (single-flight), that every key was
+// polled within its interval plus jitter and --slack-ms once it was first
+// polled, and reports how long user refreshes waited for a worker. All
+// sources register at once, so the first round is a burst: its length is
+// reported separately and jitter spreads the rounds after it.
+//
+//   fetch_scheduler_sim --keys 5000 --interval-ms 5000 --seconds 20
+//   fetch_scheduler_sim --keys 2000 --latency-ms 3 --workers 1    # Too slow: fails
+
+#include "shared/network/fetch_scheduler.h"
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <random>
+#include <cstring>
+#include <cstdlib>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct Options {
+    int keys;
+    int intervalMs;
+    int jitterMs;
+    int latencyMs;      // Stub server time per request
+    int workers;
+    int seconds;
+    int burstMs;        // Time between user refresh bursts, 0 = none
+    int presses;        // User refreshes per burst
+    int slackMs;        // Allowed lateness of a background poll
+
+    Options() : keys(2000), intervalMs(5000), jitterMs(500), latencyMs(1), workers(4), seconds(20),
+                burstMs(50), presses(5), slackMs(250) {}
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n\n";
+    std::cout << "  --keys <n>          Sources to register (default: 2000)\n";
+    std::cout << "  --interval-ms <ms>  Poll interval per source (default: 5000)\n";
+    std::cout << "  --jitter-ms <ms>    Poll jitter, +/- (default: 500)\n";
+    std::cout << "  --latency-ms <ms>   Stub server time per request (default: 1)\n";
+    std::cout << "  --workers <n>       Scheduler worker threads (default: 4)\n";
+    std::cout << "  --seconds <n>       Run time (default: 20)\n";
+    std::cout << "  --burst-ms <ms>     Time between user refresh bursts, 0 = none (default: 50)\n";
+    std::cout << "  --presses <n>       User refreshes per burst (default: 5)\n";
+    std::cout << "  --slack-ms <ms>     Allowed lateness of a background poll (default: 250)\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--keys") == 0 && hasValue) {
+            options.keys = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--interval-ms") == 0 && hasValue) {
+            options.intervalMs = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--jitter-ms") == 0 && hasValue) {
+            options.jitterMs = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--latency-ms") == 0 && hasValue) {
+            options.latencyMs = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--workers") == 0 && hasValue) {
+            options.workers = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            options.seconds = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--burst-ms") == 0 && hasValue) {
+            options.burstMs = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--presses") == 0 && hasValue) {
+            options.presses = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--slack-ms") == 0 && hasValue) {
+            options.slackMs = std::atoi(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    return options.keys > 0 && options.intervalMs > 0 && options.jitterMs >= 0 && options.latencyMs >= 0 &&
+           options.workers > 0 && options.seconds > 0 && options.burstMs >= 0 && options.presses > 0 &&
+           options.slackMs >= 0;
+}
+
+long long elapsedUs(Clock::time_point since) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - since).count();
+}
+
+// Stand-in for the YouTube/Spotify APIs; records what the scheduler did to it
+class StubServer {
+public:
+    StubServer(int keys, int latencyMs, Clock::time_point start)
+        : latencyMs_(latencyMs), start_(start), inFlight_(keys), firstRoundUs_(0), lastStartUs_(keys),
+          worstGapUs_(keys), userRequestUs_(keys), requests_(0), overlaps_(0), userFetches_(0), userWaitTotalUs_(0),
+          userWaitWorstUs_(0) {
+        for (int i = 0; i < keys; i++) {
+            inFlight_[i] = 0;
+            lastStartUs_[i] = -1;
+            worstGapUs_[i] = 0;
+            userRequestUs_[i] = -1;
+        }
+    }
+
+    // Runs on a scheduler worker
+    void fetch(int key) {
+        long long nowUs = elapsedUs(start_);
+        if (inFlight_[key].fetch_add(1) != 0) {
+            overlaps_++;
+        }
+        requests_++;
+
+        if (lastStartUs_[key] >= 0) {
+            long long gapUs = nowUs - lastStartUs_[key];
+            if (gapUs > worstGapUs_[key]) {
+                worstGapUs_[key] = gapUs;
+            }
+        } else {
+            firstRoundUs_ = nowUs;    // Every key's first poll is in the first round
+        }
+        lastStartUs_[key] = nowUs;
+
+        long long requestedUs = userRequestUs_[key].exchange(-1);
+        if (requestedUs >= 0) {
+            long long waitUs = nowUs - requestedUs;
+            userFetches_++;
+            userWaitTotalUs_ += waitUs;
+            long long worstUs = userWaitWorstUs_.load();
+            while (waitUs > worstUs && !userWaitWorstUs_.compare_exchange_weak(worstUs, waitUs)) {
+            }
+        }
+
+        if (latencyMs_ > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(latencyMs_));
+        }
+        inFlight_[key]--;
+    }
+
+    // Called before each user refresh of `key`; only the first press that
+    // has no fetch pending is timed. Returns that press's time, or -1.
+    long long userPressed(int key) {
+        long long noneUs = -1;
+        long long nowUs = elapsedUs(start_);
+        return userRequestUs_[key].compare_exchange_strong(noneUs, nowUs) ? nowUs : -1;
+    }
+
+    // The timed press was coalesced into a fetch that had already started
+    void userCoalesced(int key, long long pressedUs) {
+        userRequestUs_[key].compare_exchange_strong(pressedUs, -1);
+    }
+
+    // Worst gap between polls of any key, counting the time since the last
+    // poll up to `endUs` too, so a key that stopped being polled shows up.
+    // A key that was never polled counts from the start.
+    long long worstGapUs(long long endUs) const {
+        long long worstUs = 0;
+        for (size_t i = 0; i < lastStartUs_.size(); i++) {
+            if (lastStartUs_[i] < 0) {
+                return endUs;
+            }
+            long long gapUs = worstGapUs_[i] > endUs - lastStartUs_[i] ? worstGapUs_[i] : endUs - lastStartUs_[i];
+            if (gapUs > worstUs) {
+                worstUs = gapUs;
+            }
+        }
+        return worstUs;
+    }
+
+    long long getFirstRoundUs() const { return firstRoundUs_; }
+    unsigned long getRequests() const { return requests_; }
+    unsigned long getOverlaps() const { return overlaps_; }
+    unsigned long getUserFetches() const { return userFetches_; }
+    long long getUserWaitAverageUs() const { return userFetches_ ? userWaitTotalUs_ / (long long)userFetches_ : 0; }
+    long long getUserWaitWorstUs() const { return userWaitWorstUs_; }
+
+private:
+    int latencyMs_;
+    Clock::time_point start_;
+    std::vector<std::atomic<int> > inFlight_;
+    std::atomic<long long> firstRoundUs_;     // Last first poll of any key
+    std::vector<long long> lastStartUs_;      // Only touched by the key's single fetch, -1 before it
+    std::vector<long long> worstGapUs_;
+    std::vector<std::atomic<long long> > userRequestUs_;
+    std::atomic<unsigned long> requests_;
+    std::atomic<unsigned long> overlaps_;
+    std::atomic<unsigned long> userFetches_;
+    std::atomic<long long> userWaitTotalUs_;
+    std::atomic<long long> userWaitWorstUs_;
+};
+
+std::string sourceKey(int key) {
+    return "sim:" + std::to_string(key);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout << "🚀 " << options.keys << " sources every " << options.intervalMs << " ms +/- " << options.jitterMs
+              << " ms, " << options.latencyMs << " ms per request, " << options.workers << " worker(s)" << std::endl;
+
+    Clock::time_point start = Clock::now();
+    StubServer server(options.keys, options.latencyMs, start);
+    FetchScheduler scheduler(options.workers);
+    for (int i = 0; i < options.keys; i++) {
+        StubServer* stub = &server;
+        scheduler.addSource(sourceKey(i), options.intervalMs, options.jitterMs, [stub, i]() { stub->fetch(i); });
+    }
+    scheduler.start();
+
+    // The user: bursts of refreshes for one key, as when 'r' is held down
+    std::mt19937 random(std::random_device{}());
+    std::uniform_int_distribution<int> pickKey(0, options.keys - 1);
+    unsigned long presses = 0;
+    unsigned long queued = 0;
+    Clock::time_point end = start + std::chrono::seconds(options.seconds);
+    while (Clock::now() < end) {
+        if (options.burstMs == 0) {
+            std::this_thread::sleep_until(end);
+            break;
+        }
+        int key = pickKey(random);
+        for (int i = 0; i < options.presses; i++) {
+            // Timed first: the fetch can start before requestRefresh returns
+            long long pressedUs = server.userPressed(key);
+            if (scheduler.requestRefresh(sourceKey(key), FetchScheduler::PRIORITY_USER)) {
+                queued++;
+            } else if (pressedUs >= 0) {
+                server.userCoalesced(key, pressedUs);
+            }
+            presses++;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.burstMs));
+    }
+    long long endUs = elapsedUs(start);
+    scheduler.stop();
+
+    long long allowedGapUs = (options.intervalMs + options.jitterMs + options.slackMs) * 1000LL;
+    long long worstGapUs = server.worstGapUs(endUs);
+    double seconds = endUs / 1000000.0;
+
+    std::cout << "  requests:  " << server.getRequests() << " (" << (unsigned long)(server.getRequests() / seconds)
+              << "/s, " << (unsigned long)(options.keys * 1000.0 / options.intervalMs) << "/s expected)" << std::endl;
+    std::cout << "  user:      " << presses << " presses, " << queued << " fetches queued, "
+              << scheduler.getCoalescedCount() << " coalesced" << std::endl;
+    std::cout << "  user wait: " << server.getUserWaitAverageUs() << " µs average, " << server.getUserWaitWorstUs()
+              << " µs worst over " << server.getUserFetches() << " fetches" << std::endl;
+    std::cout << "  first round: every source polled by " << server.getFirstRoundUs() / 1000 << " ms" << std::endl;
+    std::cout << "  poll gap:  " << worstGapUs / 1000 << " ms worst, " << allowedGapUs / 1000 << " ms allowed" << std::endl;
+
+    bool passed = true;
+    if (server.getOverlaps() > 0) {
+        std::cerr << "❌ " << server.getOverlaps() << " fetches ran while the same key was in flight" << std::endl;
+        passed = false;
+    }
+    if (worstGapUs > allowedGapUs) {
+        std::cerr << "❌ A source went " << worstGapUs / 1000 << " ms without a poll" << std::endl;
+        passed = false;
+    }
+    if (queued + scheduler.getCoalescedCount() != presses) {
+        std::cerr << "❌ " << presses - queued - scheduler.getCoalescedCount() << " refreshes were neither queued nor coalesced"
+                  << std::endl;
+        passed = false;
+    }
+    if (passed) {
+        std::cout << "✅ Single-flight held and every source was polled on time" << std::endl;
+    }
+    return passed ? 0 : 1;
+}
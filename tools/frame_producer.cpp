@@ -0,0 +1,264 @@
+// Frame producer for the display daemon (see SharedFrameBuffer).
+//
+// Draws a moving test pattern straight into the daemon's shared frame
+// buffer at a fixed frame rate, or with --stdin copies raw RGB frames
+// (width * height * 3 bytes each) from standard input, so any renderer that
+// can write rawvideo drives the panel. If the daemon isn't running yet, or
+// restarts with a different panel size, the producer waits and attaches
+// again. With --check it creates a private segment instead and runs a
+// stand-in daemon in-process that checks every frame it takes for tearing
+// and times it from its publish.
+//
+//   frame_producer --fps 60
+//   ffmpeg -re -i clip.mp4 -vf scale=96:48 -f rawvideo -pix_fmt rgb24 - | frame_producer --stdin
+//   frame_producer --check --fps 120
+
+#include "infrastructure/display/shared_frame_buffer.h"
+#include "shared/utils/monotonic_clock.h"
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace {
+
+const int CHECK_SWAP_MS = 5;      // Stand-in for waiting on vsync
+const int ATTACH_RETRY_MS = 1000;
+
+struct Options {
+    std::string segment;
+    int fps;
+    int seconds;         // 0 = until the input ends or Ctrl+C
+    bool fromStdin;
+    bool check;
+    int width;           // --check only; otherwise the daemon's
+    int height;
+
+    Options() : segment(SharedFrameBuffer::DEFAULT_NAME), fps(60), seconds(0), fromStdin(false), check(false),
+                width(96), height(48) {}
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n\n";
+    std::cout << "  --shm <name>              Shared memory segment (default: " << SharedFrameBuffer::DEFAULT_NAME << ")\n";
+    std::cout << "  --fps <n>                 Frames per second for the test pattern (default: 60)\n";
+    std::cout << "  --seconds <n>             Run time (default: until stopped; 10 with --check)\n";
+    std::cout << "  --stdin                   Publish raw RGB frames read from stdin as they arrive\n";
+    std::cout << "  --check                   Run a stand-in daemon in-process and check every frame\n";
+    std::cout << "  --size <w>x<h>            Frame size for --check (default: 96x48)\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--shm") == 0 && hasValue) {
+            options.segment = argv[++i];
+        } else if (strcmp(argv[i], "--fps") == 0 && hasValue) {
+            options.fps = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            options.seconds = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--stdin") == 0) {
+            options.fromStdin = true;
+        } else if (strcmp(argv[i], "--check") == 0) {
+            options.check = true;
+        } else if (strcmp(argv[i], "--size") == 0 && hasValue) {
+            if (sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    if (options.check && options.seconds == 0) {
+        options.seconds = 10;
+    }
+    return options.fps > 0 && options.seconds >= 0 && options.width > 0 && options.height > 0 &&
+           !(options.check && options.fromStdin);
+}
+
+// Red moves right, green grows downwards, blue holds the frame number so
+// --check can tell frames apart in every pixel
+void drawPattern(unsigned long frame, int width, int height, uint8_t* pixels) {
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++, pixels += 3) {
+            pixels[0] = (uint8_t)(x * 8 + frame * 4);
+            pixels[1] = (uint8_t)(y * 5);
+            pixels[2] = (uint8_t)frame;
+        }
+    }
+}
+
+// Fill a whole frame from stdin; false at the end of the input
+bool readFrame(uint8_t* pixels, size_t size) {
+    size_t filled = 0;
+    while (filled < size) {
+        ssize_t result = read(STDIN_FILENO, pixels + filled, size - filled);
+        if (result <= 0) {
+            return false;
+        }
+        filled += (size_t)result;
+    }
+    return true;
+}
+
+// Stands in for DisplayDaemon::run(): takes the newest frame, checks it and
+// "swaps" it in
+class FrameChecker {
+public:
+    explicit FrameChecker(SharedFrameBuffer* frames)
+        : frames_(frames), running_(true), framesTaken_(0), torn_(0), reordered_(0),
+          latencyTotalUs_(0), latencyMaxUs_(0), thread_(&FrameChecker::run, this) {}
+
+    void stop() {
+        running_ = false;
+        thread_.join();
+    }
+
+    void printSummary(double seconds) const {
+        std::cout << "🔎 Took " << framesTaken_ << " frames (" << (int)(framesTaken_ / seconds + 0.5) << "/s), "
+                  << torn_ << " torn, " << reordered_ << " out of order; publish to take "
+                  << (framesTaken_ ? latencyTotalUs_ / (long long)framesTaken_ : 0) << " µs average, "
+                  << latencyMaxUs_ << " µs worst" << std::endl;
+    }
+
+    bool passed() const { return torn_ == 0 && reordered_ == 0; }
+
+private:
+    void run() {
+        int lastFrame = -1;
+        while (running_) {
+            uint32_t doorbell = frames_->getDoorbell();
+            const uint8_t* pixels = frames_->acquire();
+            if (!pixels) {
+                frames_->waitForFrame(doorbell, 100);
+                continue;
+            }
+
+            long long latency = MonotonicClock::nowUs() - frames_->getFrameTimeUs();
+            latencyTotalUs_ += latency;
+            if (latency > latencyMaxUs_) {
+                latencyMaxUs_ = latency;
+            }
+
+            uint8_t frame = pixels[2];
+            for (size_t i = 2; i < frames_->getFrameSize(); i += 3) {
+                if (pixels[i] != frame) {
+                    torn_++;
+                    break;
+                }
+            }
+            // Frames only move forwards (modulo 256)
+            if (lastFrame >= 0 && (uint8_t)(frame - lastFrame) >= 128) {
+                reordered_++;
+            }
+            lastFrame = frame;
+            framesTaken_++;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(CHECK_SWAP_MS));
+        }
+    }
+
+    SharedFrameBuffer* frames_;
+    std::atomic<bool> running_;
+    unsigned long framesTaken_;
+    unsigned long torn_;
+    unsigned long reordered_;
+    long long latencyTotalUs_;
+    long long latencyMaxUs_;
+    std::thread thread_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // --check uses its own segment so it never disturbs a running daemon
+    SharedFrameBuffer daemonSide(options.segment + "-check-" + std::to_string(getpid()));
+    FrameChecker* checker = nullptr;
+    if (options.check) {
+        if (!daemonSide.create(options.width, options.height)) {
+            std::cerr << "❌ " << daemonSide.getLastError() << std::endl;
+            return 1;
+        }
+        options.segment += "-check-" + std::to_string(getpid());
+        checker = new FrameChecker(&daemonSide);
+    }
+
+    SharedFrameBuffer frames(options.segment);
+    typedef std::chrono::steady_clock SteadyClock;
+    std::chrono::nanoseconds interval(1000000000LL / options.fps);
+    SteadyClock::time_point start = SteadyClock::now();
+    long long startMs = MonotonicClock::nowMs();
+    long long endMs = options.seconds > 0 ? startMs + options.seconds * 1000LL : 0;
+    long long nextCheckMs = 0;
+    unsigned long frame = 0;
+    bool waiting = false;
+
+    while (endMs == 0 || MonotonicClock::nowMs() < endMs) {
+        // (Re)attach when there's no daemon yet or it replaced the segment
+        long long nowMs = MonotonicClock::nowMs();
+        if (nowMs >= nextCheckMs) {
+            nextCheckMs = nowMs + ATTACH_RETRY_MS;
+            if (frames.isOrphaned()) {
+                std::cout << "🔌 Display daemon replaced the frame buffer, attaching again" << std::endl;
+                frames.close();
+            }
+            if (!frames.getBackBuffer()) {
+                if (!frames.attach()) {
+                    if (!waiting) {
+                        std::cout << "⏳ Waiting to attach: " << frames.getLastError() << std::endl;
+                        waiting = true;
+                    }
+                    usleep(ATTACH_RETRY_MS * 1000);
+                    continue;
+                }
+                waiting = false;
+                // Don't rush out the frames missed while waiting
+                start = SteadyClock::now() - interval * frame;
+                std::cout << "🚀 Publishing " << frames.getWidth() << "x" << frames.getHeight() << " frames to /dev/shm"
+                          << options.segment << (options.fromStdin ? " from stdin" : "") << std::endl;
+            }
+        }
+
+        // Draw in place: the back slot is the daemon's next frame
+        uint8_t* pixels = frames.getBackBuffer();
+        if (options.fromStdin) {
+            if (!readFrame(pixels, frames.getFrameSize())) {
+                break;
+            }
+        } else {
+            drawPattern(frame, frames.getWidth(), frames.getHeight(), pixels);
+        }
+        frames.publish();
+        frame++;
+
+        if (!options.fromStdin) {
+            std::this_thread::sleep_until(start + interval * frame);
+        }
+    }
+
+    double elapsed = (MonotonicClock::nowMs() - startMs) / 1000.0;
+    std::cout << "✅ Published " << frame << " frames (" << (int)(frame / elapsed + 0.5) << " fps)" << std::endl;
+
+    int status = 0;
+    if (checker) {
+        checker->stop();
+        daemonSide.printReport(std::cout);
+        checker->printSummary(elapsed);
+        status = checker->passed() ? 0 : 2;
+        delete checker;
+        frames.close();
+        shm_unlink(options.segment.c_str());
+    }
+    return status;
+}
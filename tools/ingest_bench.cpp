@@ -0,0 +1,289 @@
+// Ingest benchmark for the UDP dB sample path (see DbSampleReceiver).
+//
+// Starts a receiver and a drain thread that empties the ring --drain-hz
+// times a second into a DbSampleSummary, as the dB app's frame loop does,
+// then runs tools/db_sample_loadgen against it. After --warmup seconds the
+// tool measures for --seconds: samples/s received and drained, ring drops,
+// packets lost in the kernel (sequence gaps) and every malloc made by the
+// process in that window. The steady state is supposed to allocate
+// nothing, so any allocation fails the run.
+//
+//   ingest_bench
+//   ingest_bench --rate 1000000 --batch 731
+//   ingest_bench --rate 0 --seconds 5      # Unthrottled: expect ring drops
+
+#include "infrastructure/network/db_sample_receiver.h"
+#include "infrastructure/config/config.h"
+#include "shared/utils/db_sample.h"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+
+// Allocation counting: glibc's malloc entry points, wrapped. operator new
+// goes through malloc, so this catches C++ allocations too.
+#ifdef __GLIBC__
+#define COUNTS_ALLOCATIONS 1
+
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* pointer, size_t size);
+
+namespace {
+std::atomic<bool> countingAllocations(false);
+std::atomic<unsigned long> allocationCount(0);
+}
+
+extern "C" void* malloc(size_t size) {
+    if (countingAllocations.load(std::memory_order_relaxed)) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) {
+    if (countingAllocations.load(std::memory_order_relaxed)) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* pointer, size_t size) {
+    if (countingAllocations.load(std::memory_order_relaxed)) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return __libc_realloc(pointer, size);
+}
+#else
+#define COUNTS_ALLOCATIONS 0
+
+namespace {
+std::atomic<bool> countingAllocations(false);
+std::atomic<unsigned long> allocationCount(0);
+}
+#endif
+
+namespace {
+
+struct Options {
+    std::string loadgen;
+    int port;
+    long rate;          // Passed to loadgen, 0 = unthrottled
+    int batch;
+    int warmupSeconds;
+    int seconds;
+    int drainHz;
+
+    Options() : port(DbSampleProtocol::DEFAULT_PORT + 100), rate(1000000), batch(64), warmupSeconds(1),
+                seconds(5), drainHz(60) {}
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n\n";
+    std::cout << "  --loadgen <path>    Load generator (default: db_sample_loadgen next to this tool)\n";
+    std::cout << "  --port <port>       UDP port on this machine (default: " << DbSampleProtocol::DEFAULT_PORT + 100 << ")\n";
+    std::cout << "  --rate <n>          Samples per second, 0 = as fast as possible (default: 1000000)\n";
+    std::cout << "  --batch <n>         Samples per packet, 1-" << DbSampleProtocol::MAX_SAMPLES_PER_PACKET << " (default: 64)\n";
+    std::cout << "  --warmup <s>        Time before measuring (default: 1)\n";
+    std::cout << "  --seconds <n>       Measured time (default: 5)\n";
+    std::cout << "  --drain-hz <n>      Ring drains per second, like display frames (default: 60)\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--loadgen") == 0 && hasValue) {
+            options.loadgen = argv[++i];
+        } else if (strcmp(argv[i], "--port") == 0 && hasValue) {
+            options.port = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rate") == 0 && hasValue) {
+            options.rate = std::atol(argv[++i]);
+        } else if (strcmp(argv[i], "--batch") == 0 && hasValue) {
+            options.batch = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--warmup") == 0 && hasValue) {
+            options.warmupSeconds = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            options.seconds = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--drain-hz") == 0 && hasValue) {
+            options.drainHz = std::atoi(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    if (options.loadgen.empty()) {
+        std::string self = argv[0];
+        size_t slash = self.rfind('/');
+        options.loadgen = (slash == std::string::npos ? std::string(".") : self.substr(0, slash)) + "/db_sample_loadgen";
+    }
+    return options.port > 0 && options.port < 65536 && options.rate >= 0 && options.batch >= 1 &&
+           options.batch <= DbSampleProtocol::MAX_SAMPLES_PER_PACKET && options.warmupSeconds >= 0 &&
+           options.seconds > 0 && options.drainHz > 0;
+}
+
+// Counters at one point in time
+struct Snapshot {
+    unsigned long received;
+    unsigned long drained;
+    unsigned long dropped;
+    unsigned long lostPackets;
+    unsigned long malformed;
+};
+
+// Stand-in for the frame loop: drain everything queued, then wait a frame
+class Drainer {
+public:
+    Drainer(DbSampleRing* ring, int drainHz) : ring_(ring), periodUs_(1000000 / drainHz), running_(false),
+                                                drained_(0), maxPerDrain_(0) {}
+
+    void start() {
+        running_ = true;
+        thread_ = std::thread(&Drainer::run, this);
+    }
+
+    void stop() {
+        running_ = false;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    unsigned long getDrained() const { return drained_.load(); }
+    unsigned long getMaxPerDrain() const { return maxPerDrain_.load(); }
+    void resetMaxPerDrain() { maxPerDrain_ = 0; }
+
+private:
+    DbSampleRing* ring_;
+    int periodUs_;
+    std::atomic<bool> running_;
+    std::atomic<unsigned long> drained_;
+    std::atomic<unsigned long> maxPerDrain_;
+    std::thread thread_;
+
+    void run() {
+        while (running_) {
+            DbSampleSummary summary;
+            size_t count = ring_->drain(summary);
+            drained_ += count;
+            if (count > maxPerDrain_) {
+                maxPerDrain_ = count;
+            }
+            usleep((useconds_t)periodUs_);
+        }
+    }
+};
+
+Snapshot takeSnapshot(const DbSampleReceiver& receiver, const DbSampleRing& ring, const Drainer& drainer) {
+    Snapshot snapshot;
+    snapshot.received = receiver.getSampleCount();
+    snapshot.drained = drainer.getDrained();
+    snapshot.dropped = ring.getDroppedCount();
+    snapshot.lostPackets = receiver.getLostPacketCount();
+    snapshot.malformed = receiver.getMalformedCount();
+    return snapshot;
+}
+
+pid_t startLoadgen(const Options& options) {
+    std::string port = std::to_string(options.port);
+    std::string rate = std::to_string(options.rate);
+    std::string batch = std::to_string(options.batch);
+    std::string seconds = std::to_string(options.warmupSeconds + options.seconds + 1);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        // Its per-second rate lines would interleave with the report
+        int devNull = open("/dev/null", O_WRONLY);
+        if (devNull >= 0) {
+            dup2(devNull, STDOUT_FILENO);
+        }
+        execl(options.loadgen.c_str(), options.loadgen.c_str(), "--port", port.c_str(), "--rate", rate.c_str(),
+              "--batch", batch.c_str(), "--seconds", seconds.c_str(), (char*)nullptr);
+        _exit(127);
+    }
+    return pid;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (access(options.loadgen.c_str(), X_OK) != 0) {
+        std::cerr << "❌ Cannot run " << options.loadgen << " (make tools, or pass --loadgen)" << std::endl;
+        return 1;
+    }
+
+    DbSampleRing ring(Config::SAMPLE_RING_CAPACITY);
+    DbSampleReceiver receiver(options.port, &ring);
+    if (!receiver.start()) {
+        std::cerr << "❌ " << receiver.getLastError() << std::endl;
+        return 1;
+    }
+    Drainer drainer(&ring, options.drainHz);
+    drainer.start();
+
+    std::cout << "🚀 " << (options.rate ? std::to_string(options.rate) + " samples/s" : std::string("unthrottled"))
+              << " in packets of " << options.batch << ", ring of " << ring.capacity() << ", drained "
+              << options.drainHz << " times/s" << std::endl;
+
+    pid_t loadgen = startLoadgen(options);
+    if (loadgen < 0) {
+        std::cerr << "❌ Cannot start " << options.loadgen << std::endl;
+        return 1;
+    }
+
+    // Steady-state window: nothing in here may allocate, including this thread
+    std::this_thread::sleep_for(std::chrono::seconds(options.warmupSeconds));
+    drainer.resetMaxPerDrain();
+    Snapshot before = takeSnapshot(receiver, ring, drainer);
+    countingAllocations = true;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::seconds(options.seconds));
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    countingAllocations = false;
+    Snapshot after = takeSnapshot(receiver, ring, drainer);
+    unsigned long allocations = allocationCount.load();
+
+    int status = 0;
+    waitpid(loadgen, &status, 0);
+    drainer.stop();
+    receiver.stop();
+
+    unsigned long received = after.received - before.received;
+    unsigned long drained = after.drained - before.drained;
+    std::cout << "  received:    " << (unsigned long)(received / elapsed) << " samples/s (" << received << " in "
+              << options.seconds << " s)" << std::endl;
+    std::cout << "  drained:     " << (unsigned long)(drained / elapsed) << " samples/s, up to "
+              << drainer.getMaxPerDrain() << " per drain" << std::endl;
+    std::cout << "  ring drops:  " << after.dropped - before.dropped << std::endl;
+    std::cout << "  lost:        " << after.lostPackets - before.lostPackets << " packets (sequence gaps), "
+              << after.malformed - before.malformed << " malformed" << std::endl;
+
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        std::cerr << "❌ " << options.loadgen << " failed" << std::endl;
+        return 1;
+    }
+    if (received == 0) {
+        std::cerr << "❌ Nothing arrived on UDP port " << options.port << std::endl;
+        return 1;
+    }
+    if (!COUNTS_ALLOCATIONS) {
+        std::cout << "⚠️  Allocations not counted (needs glibc)" << std::endl;
+        return 0;
+    }
+    std::cout << "  allocations: " << allocations << " in the measured window" << std::endl;
+    if (allocations > 0) {
+        std::cerr << "❌ The ingest path allocated in steady state" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ Steady-state ingest made no allocations" << std::endl;
+    return 0;
+}
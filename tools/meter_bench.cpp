@@ -0,0 +1,144 @@
+// Cost of the multi-channel dB meter (see MultiChannelMeter) for 1 to 16
+// channels.
+//
+// Every frame feeds --readings readings to each channel and then advances
+// the meter once, as DbMeterApp does when it drains the sample ring. For
+// each channel count the tool prints the time per frame, the time per
+// channel per reading (binning plus that reading's share of the advance),
+// and the advance pass on its own. Run it on the target to see what the
+// SIMD pass buys: build it once as is and once with -U__SSE2__ added to
+// CXXFLAGS (x86) for the scalar fallback.
+//
+//   meter_bench
+//   meter_bench --mode impulse --readings 4 --frames 500000
+
+#include "shared/dsp/multi_channel_meter.h"
+#include "shared/dsp/level_ballistics.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const double FRAME_SECONDS = 1.0 / 60.0;
+const int PATTERN = 1024;  // Distinct readings cycled through
+
+struct Options {
+    int frames;
+    int readings;       // Per channel per frame
+    LevelBallistics::Mode mode;
+    bool bypass;
+
+    Options() : frames(1000000), readings(1), mode(LevelBallistics::MODE_FAST), bypass(false) {}
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n\n";
+    std::cout << "  --frames <n>        Frames per channel count (default: 1000000)\n";
+    std::cout << "  --readings <n>      Readings per channel per frame (default: 1)\n";
+    std::cout << "  --mode <m>          fast, slow or impulse (default: fast)\n";
+    std::cout << "  --bypass            Frame maximum instead of the filter, as for audio input\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--frames") == 0 && hasValue) {
+            options.frames = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--readings") == 0 && hasValue) {
+            options.readings = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--mode") == 0 && hasValue) {
+            if (!LevelBallistics::parse(argv[++i], options.mode)) {
+                return false;
+            }
+        } else if (strcmp(argv[i], "--bypass") == 0) {
+            options.bypass = true;
+        } else {
+            return false;
+        }
+    }
+    return options.frames > 0 && options.readings > 0;
+}
+
+const char* simdPath() {
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    return "NEON";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+double elapsedNs(Clock::time_point since) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - since).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Readings between 60 and 90 dB so every bin sees varying energy
+    std::vector<uint16_t> pattern(PATTERN);
+    for (int i = 0; i < PATTERN; i++) {
+        pattern[i] = (uint16_t)(6000 + (i * 2971) % 3000);
+    }
+
+    std::cout << "🚀 " << simdPath() << " path, " << options.frames << " frames, " << options.readings
+              << " reading(s) per channel per frame, mode " << LevelBallistics::letter(options.mode)
+              << (options.bypass ? " (bypass)" : "") << std::endl;
+    std::cout << "  channels   ns/frame   ns/channel/reading   advance ns/frame" << std::endl;
+
+    double sink = 0.0;
+    std::cout << std::fixed << std::setprecision(1);
+    for (int channels = 1; channels <= MultiChannelMeter::MAX_CHANNELS; channels++) {
+        MultiChannelMeter meter;
+        meter.setMode(options.mode);
+        meter.setBypass(options.bypass);
+        meter.reset(60.0);
+
+        int next = 0;
+        Clock::time_point start = Clock::now();
+        for (int frame = 0; frame < options.frames; frame++) {
+            for (int r = 0; r < options.readings; r++) {
+                for (int c = 0; c < channels; c++) {
+                    meter.addReading(c, pattern[next]);
+                    next = (next + 1) & (PATTERN - 1);
+                }
+            }
+            meter.advance(FRAME_SECONDS);
+        }
+        double totalNs = elapsedNs(start);
+        sink += meter.getLevelDb(channels - 1);
+
+        // The advance pass alone, with the same channel count in use
+        start = Clock::now();
+        for (int frame = 0; frame < options.frames; frame++) {
+            meter.advance(FRAME_SECONDS);
+        }
+        double advanceNs = elapsedNs(start);
+        sink += meter.getLevelDb(0);
+
+        std::cout << "  " << std::setw(8) << channels
+                  << std::setw(11) << totalNs / options.frames
+                  << std::setw(21) << totalNs / ((double)options.frames * channels * options.readings)
+                  << std::setw(19) << advanceNs / options.frames << std::endl;
+    }
+
+    // Keeps the meter work from being optimized away
+    if (sink != sink) {
+        std::cerr << "❌ Meter produced NaN" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,365 @@
+// Stand-in MQTT broker for testing --mqtt without a real one (see MqttClient).
+//
+// Accepts any CONNECT (or refuses all with --refuse), grants every
+// SUBSCRIBE, answers pings and forwards published messages to the clients
+// whose filters match. Messages come from stdin as "topic payload" lines,
+// and with --rate also from a synthetic sound level on --topic. Prints the
+// publish rate every second.
+//
+// --drop-every closes each client after that many messages and --qos 1
+// sends QoS 1, to exercise the client's reconnect backoff and PUBACKs.
+//
+//   mqtt_stub_broker --port 1883
+//   echo "signs/lobby Welcome" | mqtt_stub_broker --rate 1000 --drop-every 5000
+
+#include "infrastructure/network/mqtt_protocol.h"
+#include "infrastructure/input/line_assembler.h"
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+namespace {
+
+const size_t MAX_STDIN_LINE = 256 * 1024;   // Room for payloads over the client's buffer
+
+volatile sig_atomic_t stopRequested = 0;
+
+void handleSignal(int) {
+    stopRequested = 1;
+}
+
+struct Options {
+    int port;
+    long rate;          // Synthetic messages per second, 0 = none
+    std::string topic;
+    int seconds;        // 0 = until Ctrl-C
+    long dropEvery;     // Close a client after this many messages, 0 = never
+    int refuseCode;     // CONNACK return code
+    int qos;
+
+    Options() : port(MqttProtocol::DEFAULT_PORT), rate(0), topic("noise/level"), seconds(0),
+                dropEvery(0), refuseCode(0), qos(0) {}
+};
+
+struct Client {
+    int fd;
+    bool connected;
+    std::string input;
+    std::vector<std::string> filters;
+    long sent;
+    uint16_t nextPacketId;
+
+    explicit Client(int clientFd) : fd(clientFd), connected(false), sent(0), nextPacketId(1) {}
+};
+
+struct Counters {
+    unsigned long published;
+    unsigned long pubAcks;
+    unsigned long pings;
+    unsigned long connects;
+    unsigned long drops;
+
+    Counters() : published(0), pubAcks(0), pings(0), connects(0), drops(0) {}
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n\n";
+    std::cout << "  --port <port>       TCP port (default: " << MqttProtocol::DEFAULT_PORT << ")\n";
+    std::cout << "  --rate <n>          Synthetic dB messages per second on --topic (default: 0)\n";
+    std::cout << "  --topic <topic>     Topic for synthetic messages (default: noise/level)\n";
+    std::cout << "  --seconds <n>       Run time, 0 = until Ctrl-C (default: 0)\n";
+    std::cout << "  --drop-every <n>    Close each client after n messages (default: never)\n";
+    std::cout << "  --refuse <code>     Refuse every CONNECT with this CONNACK code (1-5)\n";
+    std::cout << "  --qos <0|1>         QoS of forwarded messages (default: 0)\n";
+    std::cout << "\nLines on stdin (\"topic payload\") are published as well.\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--port") == 0 && hasValue) {
+            options.port = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--rate") == 0 && hasValue) {
+            options.rate = std::atol(argv[++i]);
+        } else if (strcmp(argv[i], "--topic") == 0 && hasValue) {
+            options.topic = argv[++i];
+        } else if (strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            options.seconds = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--drop-every") == 0 && hasValue) {
+            options.dropEvery = std::atol(argv[++i]);
+        } else if (strcmp(argv[i], "--refuse") == 0 && hasValue) {
+            options.refuseCode = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--qos") == 0 && hasValue) {
+            options.qos = std::atoi(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    return options.port > 0 && options.port < 65536 && options.rate >= 0 && options.seconds >= 0 &&
+           options.dropEvery >= 0 && options.refuseCode >= 0 && options.refuseCode <= 5 &&
+           (options.qos == 0 || options.qos == 1) && !options.topic.empty();
+}
+
+int openListener(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port);
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 16) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        sent += (size_t)n;
+    }
+    return true;
+}
+
+// Answers the client's packets; false when it should be dropped
+bool handleClientInput(Client& client, const Options& options, Counters& counters) {
+    std::string reply;
+    size_t offset = 0;
+    while (true) {
+        size_t consumed = 0;
+        MqttProtocol::Packet packet;
+        MqttProtocol::ParseResult result = MqttProtocol::parsePacket(client.input.data() + offset,
+                                                                     client.input.size() - offset, consumed, packet);
+        if (result == MqttProtocol::PARSE_ERROR) {
+            return false;
+        }
+        if (result == MqttProtocol::PARSE_INCOMPLETE) {
+            break;
+        }
+        offset += consumed;
+
+        if (packet.type == MqttProtocol::CONNECT) {
+            MqttProtocol::appendConnAck(reply, options.refuseCode);
+            if (options.refuseCode != 0) {
+                sendAll(client.fd, reply);
+                return false;
+            }
+            client.connected = true;
+            counters.connects++;
+        } else if (packet.type == MqttProtocol::SUBSCRIBE && packet.bodySize >= 5) {
+            uint16_t packetId = (uint16_t)(((unsigned char)packet.body[0] << 8) | (unsigned char)packet.body[1]);
+            size_t length = ((unsigned char)packet.body[2] << 8) | (unsigned char)packet.body[3];
+            if (4 + length > packet.bodySize) {
+                return false;
+            }
+            client.filters.push_back(std::string(packet.body + 4, length));
+            MqttProtocol::appendSubAck(reply, packetId, options.qos);
+            std::cout << "📥 Client " << client.fd << " subscribed to " << client.filters.back() << std::endl;
+        } else if (packet.type == MqttProtocol::PINGREQ) {
+            MqttProtocol::appendPingResp(reply);
+            counters.pings++;
+        } else if (packet.type == MqttProtocol::PUBACK) {
+            counters.pubAcks++;
+        } else if (packet.type == MqttProtocol::DISCONNECT) {
+            return false;
+        }
+    }
+    client.input.erase(0, offset);
+    return reply.empty() || sendAll(client.fd, reply);
+}
+
+// 60 dB +/- 15 dB swell every 4 seconds
+std::string syntheticPayload(unsigned long index, long rate) {
+    double period = rate * 4.0;
+    double db = 60.0 + 15.0 * std::sin(2.0 * M_PI * (double)(index % (unsigned long)period) / period);
+    char text[16];
+    snprintf(text, sizeof(text), "%.1f", db);
+    return text;
+}
+
+void closeClient(std::vector<Client>& clients, size_t index) {
+    close(clients[index].fd);
+    clients.erase(clients.begin() + index);
+}
+
+// Forward to every matching client; drops clients that fail or hit --drop-every
+void publish(std::vector<Client>& clients, const std::string& topic, const std::string& payload,
+             const Options& options, Counters& counters) {
+    for (size_t i = 0; i < clients.size();) {
+        Client& client = clients[i];
+        bool matches = false;
+        for (size_t f = 0; f < client.filters.size() && !matches; f++) {
+            matches = MqttProtocol::topicMatches(client.filters[f], topic.data(), topic.size());
+        }
+        if (!client.connected || !matches) {
+            i++;
+            continue;
+        }
+
+        std::string packet;
+        uint16_t packetId = 0;
+        if (options.qos > 0) {
+            packetId = client.nextPacketId++;
+            if (client.nextPacketId == 0) client.nextPacketId = 1;
+        }
+        MqttProtocol::appendPublish(packet, topic, payload.data(), payload.size(), options.qos, packetId);
+        if (!sendAll(client.fd, packet)) {
+            closeClient(clients, i);
+            continue;
+        }
+        counters.published++;
+        if (options.dropEvery > 0 && ++client.sent >= options.dropEvery) {
+            counters.drops++;
+            closeClient(clients, i);
+            continue;
+        }
+        i++;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    int listenFd = openListener(options.port);
+    if (listenFd < 0) {
+        std::cerr << "❌ Cannot listen on port " << options.port << ": " << strerror(errno) << std::endl;
+        return 1;
+    }
+    signal(SIGINT, handleSignal);
+    signal(SIGTERM, handleSignal);
+    std::cout << "📡 Stub broker on port " << options.port;
+    if (options.rate > 0) {
+        std::cout << ", " << options.rate << " msg/s on " << options.topic;
+    }
+    std::cout << std::endl;
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    Clock::time_point lastReport = start;
+    unsigned long synthetic = 0;
+    unsigned long lastPublished = 0;
+    bool stdinOpen = true;
+    LineAssembler stdinLines(MAX_STDIN_LINE);
+    std::vector<Client> clients;
+    Counters counters;
+
+    while (!stopRequested) {
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        if (options.seconds > 0 && elapsed >= options.seconds) {
+            break;
+        }
+
+        std::vector<struct pollfd> fds;
+        struct pollfd pfd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        pfd.fd = listenFd;
+        fds.push_back(pfd);
+        pfd.fd = stdinOpen ? STDIN_FILENO : -1;
+        fds.push_back(pfd);
+        for (size_t i = 0; i < clients.size(); i++) {
+            pfd.fd = clients[i].fd;
+            fds.push_back(pfd);
+        }
+        if (::poll(&fds[0], fds.size(), options.rate > 0 ? 1 : 100) < 0 && errno != EINTR) {
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int fd = accept(listenFd, NULL, NULL);
+            if (fd >= 0) {
+                clients.push_back(Client(fd));
+            }
+        }
+
+        // Client packets (indexes shift as clients go away, so walk backwards)
+        for (size_t i = fds.size(); i-- > 2;) {
+            if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                continue;
+            }
+            size_t index = i - 2;
+            char buffer[4096];
+            ssize_t got = recv(clients[index].fd, buffer, sizeof(buffer), 0);
+            if (got <= 0) {
+                closeClient(clients, index);
+                continue;
+            }
+            clients[index].input.append(buffer, (size_t)got);
+            if (!handleClientInput(clients[index], options, counters)) {
+                closeClient(clients, index);
+            }
+        }
+
+        // "topic payload" lines from stdin
+        if (stdinOpen && (fds[1].revents & (POLLIN | POLLHUP))) {
+            char buffer[4096];
+            ssize_t got = read(STDIN_FILENO, buffer, sizeof(buffer));
+            if (got <= 0) {
+                stdinOpen = false;
+            } else {
+                stdinLines.append(buffer, (size_t)got);
+            }
+            std::string line;
+            while (stdinLines.nextLine(line)) {
+                size_t space = line.find(' ');
+                if (space != std::string::npos && space > 0) {
+                    publish(clients, line.substr(0, space), line.substr(space + 1), options, counters);
+                }
+            }
+        }
+
+        // Synthetic messages due by now
+        if (options.rate > 0) {
+            unsigned long due = (unsigned long)(elapsed * options.rate);
+            for (; synthetic < due; synthetic++) {
+                publish(clients, options.topic, syntheticPayload(synthetic, options.rate), options, counters);
+            }
+        }
+
+        Clock::time_point now = Clock::now();
+        if (now - lastReport >= std::chrono::seconds(1)) {
+            double seconds = std::chrono::duration<double>(now - lastReport).count();
+            printf("⏱️  %.0f msg/s, %zu clients, %lu published, %lu PUBACKs, %lu pings, %lu connects, %lu drops\n",
+                   (counters.published - lastPublished) / seconds, clients.size(), counters.published,
+                   counters.pubAcks, counters.pings, counters.connects, counters.drops);
+            fflush(stdout);
+            lastPublished = counters.published;
+            lastReport = now;
+        }
+    }
+
+    for (size_t i = 0; i < clients.size(); i++) {
+        close(clients[i].fd);
+    }
+    close(listenFd);
+    printf("✅ %lu messages published, %lu connects\n", counters.published, counters.connects);
+    return 0;
+}
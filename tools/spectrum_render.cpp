@@ -0,0 +1,178 @@
+// Headless run of the spectrum analyzer app's pipeline (see SpectrumApp).
+//
+// Reads a WAV file (or raw s16le PCM) as fast as possible. Each hop of
+// channel 0 goes through the same SpectrumAnalyzer and SpectrumRenderer the
+// display uses, drawn onto a MemoryCanvas the size of the panel. The tool
+// reports analyzer and render time per spectrum, can write every frame as a
+// PPM image, and prints the last frame as text.
+//
+//   spectrum_render music.wav
+//   spectrum_render music.wav --frames /tmp/frames --scale 8
+//   ffmpeg -framerate 60 -i /tmp/frames/frame-%05d.ppm spectrum.mp4
+
+#include "infrastructure/audio/pcm_source.h"
+#include "infrastructure/display/memory_canvas.h"
+#include "infrastructure/display/spectrum_renderer.h"
+#include "infrastructure/config/config.h"
+#include "shared/dsp/spectrum_analyzer.h"
+#include "shared/dsp/level_kernels.h"
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+namespace {
+
+const int PANEL_WIDTH = 96;
+const int PANEL_HEIGHT = 48;
+
+struct Options {
+    std::string input;
+    int rawRate;
+    int rawChannels;
+    double calibrationDb;
+    std::string framesDirectory;
+    int scale;
+
+    Options() : rawRate(Config::DEFAULT_AUDIO_SAMPLE_RATE), rawChannels(1),
+                calibrationDb(Config::DEFAULT_AUDIO_CALIBRATION_DB), scale(1) {}
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " <wav or raw PCM> [options]\n\n";
+    std::cout << "  --rate <hz>         Sample rate of raw PCM (default: " << Config::DEFAULT_AUDIO_SAMPLE_RATE << ")\n";
+    std::cout << "  --channels <n>      Channels of raw PCM (default: 1)\n";
+    std::cout << "  --calibration <dB>  dB SPL of a full-scale RMS signal (default: " << Config::DEFAULT_AUDIO_CALIBRATION_DB << ")\n";
+    std::cout << "  --frames <dir>      Write every frame as <dir>/frame-NNNNN.ppm\n";
+    std::cout << "  --scale <n>         Pixels per LED in written frames (default: 1)\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--rate") == 0 && hasValue) {
+            options.rawRate = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--channels") == 0 && hasValue) {
+            options.rawChannels = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--calibration") == 0 && hasValue) {
+            options.calibrationDb = std::atof(argv[++i]);
+        } else if (strcmp(argv[i], "--frames") == 0 && hasValue) {
+            options.framesDirectory = argv[++i];
+        } else if (strcmp(argv[i], "--scale") == 0 && hasValue) {
+            options.scale = std::atoi(argv[++i]);
+        } else if (argv[i][0] != '-' && options.input.empty()) {
+            options.input = argv[i];
+        } else {
+            return false;
+        }
+    }
+    return !options.input.empty() && options.rawRate > 0 && options.rawChannels > 0 &&
+           options.rawChannels <= PcmSource::MAX_CHANNELS && options.scale > 0;
+}
+
+// Bars as '#', peak markers as '^', two panel rows per text line
+void printCanvas(const MemoryCanvas& canvas) {
+    for (int y = 0; y < canvas.height(); y += 2) {
+        std::string line;
+        for (int x = 0; x < canvas.width(); x++) {
+            const uint8_t* top = canvas.getPixel(x, y);
+            const uint8_t* bottom = canvas.getPixel(x, y + 1);
+            bool marker = (top[0] && top[1] && top[2]) || (bottom[0] && bottom[1] && bottom[2]);
+            bool lit = top[0] || top[1] || top[2] || bottom[0] || bottom[1] || bottom[2];
+            line += marker ? '^' : lit ? '#' : ' ';
+        }
+        std::cout << "|" << line << "|" << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    PcmSource source(options.input, options.rawRate, options.rawChannels);
+    if (!source.open()) {
+        std::cerr << "❌ " << source.getLastError() << std::endl;
+        return 1;
+    }
+
+    SpectrumAnalyzer analyzer(SpectrumAnalyzer::DEFAULT_FFT_SIZE, Config::SPECTRUM_COLUMNS);
+    analyzer.prepare(source.getSampleRate(), Config::SPECTRUM_RATE);
+    analyzer.setCalibrationDb(options.calibrationDb);
+    SpectrumRenderer renderer(Config::SPECTRUM_COLUMNS);
+    MemoryCanvas canvas(PANEL_WIDTH, PANEL_HEIGHT);
+
+    std::cout << "📊 " << options.input << ": " << source.getSampleRate() << " Hz, " << source.getChannels()
+              << " ch; FFT " << analyzer.getFftSize() << ", hop " << analyzer.getHop() << " samples ("
+              << Config::SPECTRUM_RATE << " spectra/s)" << std::endl;
+
+    // Read a hop at a time, so most reads complete exactly one spectrum
+    size_t hop = analyzer.getHop();
+    std::vector<int16_t> pcm(hop * source.getChannels());
+    std::vector<float> samples(hop);
+    float columns[Config::SPECTRUM_COLUMNS];
+
+    typedef std::chrono::steady_clock Clock;
+    double analyzeSeconds = 0.0;
+    double renderSeconds = 0.0;
+    unsigned long spectra = 0;
+    unsigned long long frames = 0;
+    char path[512];
+
+    while (true) {
+        long count = source.readFrames(&pcm[0], hop);
+        if (count < 0) {
+            if (source.getLastError() != "End of input") {
+                std::cerr << "❌ " << source.getLastError() << std::endl;
+            }
+            break;
+        }
+        if (count == 0) {
+            continue;
+        }
+        frames += (unsigned long long)count;
+        LevelKernels::deinterleaveToFloat(&pcm[0], (size_t)count, source.getChannels(), 0, &samples[0]);
+
+        Clock::time_point start = Clock::now();
+        size_t produced = analyzer.process(&samples[0], (size_t)count, columns);
+        Clock::time_point analyzed = Clock::now();
+        analyzeSeconds += std::chrono::duration<double>(analyzed - start).count();
+        if (produced == 0) {
+            continue;
+        }
+
+        // Audio time, not wall time, drives the bar and marker ballistics
+        long long audioMs = (long long)(frames * 1000 / source.getSampleRate());
+        renderer.update(columns, audioMs);
+        canvas.Clear();
+        renderer.draw(&canvas, 255);
+        renderSeconds += std::chrono::duration<double>(Clock::now() - analyzed).count();
+
+        if (!options.framesDirectory.empty()) {
+            snprintf(path, sizeof(path), "%s/frame-%05lu.ppm", options.framesDirectory.c_str(), spectra);
+            if (!canvas.writePpm(path, options.scale)) {
+                std::cerr << "❌ Cannot write " << path << std::endl;
+                return 1;
+            }
+        }
+        spectra++;
+    }
+
+    if (spectra == 0) {
+        std::cerr << "❌ Input shorter than one hop" << std::endl;
+        return 1;
+    }
+
+    printCanvas(canvas);
+    double audioSeconds = (double)frames / source.getSampleRate();
+    printf("✅ %lu spectra from %.1f s of audio: analyzer %.1f us, render %.1f us per spectrum (%.0f spectra/s)\n",
+           spectra, audioSeconds, analyzeSeconds * 1e6 / spectra, renderSeconds * 1e6 / spectra,
+           spectra / (analyzeSeconds + renderSeconds));
+    return 0;
+}
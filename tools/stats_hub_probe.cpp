@@ -0,0 +1,346 @@
+// Fan-out check for the stats hub (see StatsHubServer): upstream API traffic
+// must not grow with the number of connected displays.
+//
+// Runs a hub whose fetches go to a stub that takes --fetch-ms and counts
+// calls, then rounds of 1, 2, 4, ... --clients client processes. In every
+// round each client subscribes to all --sources keys and waits for the
+// cached values; once all of them are in, every client asks for a refresh
+// of every key at the same moment and waits for the fresh values. The hub
+// should answer a round with exactly one fetch per source however many
+// clients there are: subscribing is served from its cache and the
+// simultaneous refreshes coalesce in the fetch scheduler.
+//
+//   stats_hub_probe
+//   stats_hub_probe --clients 64 --sources 8 --fetch-ms 500
+
+#include "infrastructure/network/stats_hub_server.h"
+#include "infrastructure/network/stats_hub_client.h"
+#include "shared/network/fetch_scheduler.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+
+namespace {
+
+const int WAIT_MS = 10000;  // For a client's values, and for all clients to be ready
+
+struct Options {
+    int port;
+    int clients;      // Largest round
+    int sources;
+    int fetchMs;      // Stub upstream time per fetch
+
+    // Client process (started by the probe itself)
+    bool client;
+    int readyFd;
+    int goFd;
+
+    Options() : port(StatsHubProtocol::DEFAULT_PORT), clients(16), sources(4), fetchMs(300),
+                client(false), readyFd(-1), goFd(-1) {}
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n\n";
+    std::cout << "  --port <port>       Hub port on this machine (default: " << StatsHubProtocol::DEFAULT_PORT << ")\n";
+    std::cout << "  --clients <n>       Client processes in the largest round (default: 16)\n";
+    std::cout << "  --sources <n>       Keys every client subscribes to, half YouTube, half Spotify (default: 4)\n";
+    std::cout << "  --fetch-ms <ms>     Stub upstream time per fetch (default: 300)\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--port") == 0 && hasValue) {
+            options.port = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--clients") == 0 && hasValue) {
+            options.clients = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sources") == 0 && hasValue) {
+            options.sources = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--fetch-ms") == 0 && hasValue) {
+            options.fetchMs = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--client") == 0) {
+            options.client = true;
+        } else if (strcmp(argv[i], "--ready-fd") == 0 && hasValue) {
+            options.readyFd = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--go-fd") == 0 && hasValue) {
+            options.goFd = std::atoi(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    return options.port > 0 && options.port < 65536 && options.clients > 0 && options.sources > 0 &&
+           options.fetchMs >= 0 && (!options.client || (options.readyFd >= 0 && options.goFd >= 0));
+}
+
+std::string sourceId(int index) {
+    return "probe-" + std::to_string(index);
+}
+
+// Even sources are YouTube channels, odd ones Spotify artists
+std::string sourceKey(int index) {
+    return (index % 2 == 0 ? "youtube:" : "spotify:") + sourceId(index);
+}
+
+// Stand-in for the YouTube/Spotify APIs. Every fetch returns a new
+// generation number so clients can tell a fresh value from the cached one.
+class StubUpstream {
+public:
+    StubUpstream(int fetchMs) : fetchMs_(fetchMs), fetches_(0) {}
+
+    YouTubeChannelStats fetchYouTube(const std::string& channel) {
+        YouTubeChannelStats stats;
+        stats.channelId = channel;
+        stats.subscriberCount = fetch();
+        stats.isValid = true;
+        return stats;
+    }
+
+    SpotifyArtistStats fetchSpotify(const std::string& artistId) {
+        SpotifyArtistStats stats;
+        stats.artistId = artistId;
+        stats.name = artistId;
+        stats.monthlyListeners = (int)fetch();
+        stats.isValid = true;
+        return stats;
+    }
+
+    unsigned long getFetches() const { return fetches_.load(); }
+
+private:
+    int fetchMs_;
+    std::atomic<unsigned long> fetches_;
+
+    long fetch() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(fetchMs_));
+        return (long)++fetches_;
+    }
+};
+
+// Latest generation per source, as seen by one client
+class Received {
+public:
+    Received(int sources) : generations_(sources, 0) {}
+
+    void update(int index, long generation) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generations_[index] = generation;
+        changed_.notify_all();
+    }
+
+    // Wait until every source is newer than `than`; returns the generations seen
+    bool waitNewer(const std::vector<long>& than, std::vector<long>& seen) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        bool newer = changed_.wait_for(lock, std::chrono::milliseconds(WAIT_MS), [this, &than]() {
+            for (size_t i = 0; i < generations_.size(); i++) {
+                if (generations_[i] <= than[i]) return false;
+            }
+            return true;
+        });
+        seen = generations_;
+        return newer;
+    }
+
+private:
+    std::vector<long> generations_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+};
+
+// One display: subscribe, report ready, refresh everything on "go"
+int runClient(const Options& options) {
+    Received received(options.sources);
+    StatsHubClient client("127.0.0.1", options.port);
+    for (int i = 0; i < options.sources; i++) {
+        Received* target = &received;
+        if (i % 2 == 0) {
+            client.subscribeYouTube(sourceId(i), [target, i](const YouTubeChannelStats& stats) {
+                target->update(i, stats.subscriberCount);
+            });
+        } else {
+            client.subscribeSpotify(sourceId(i), [target, i](const SpotifyArtistStats& stats) {
+                target->update(i, stats.monthlyListeners);
+            });
+        }
+    }
+    client.start();
+
+    std::vector<long> cached;
+    if (!received.waitNewer(std::vector<long>(options.sources, 0), cached)) {
+        std::cerr << "❌ Client " << getpid() << " did not get the cached values" << std::endl;
+        return 1;
+    }
+    char ready = 1;
+    if (write(options.readyFd, &ready, 1) != 1) {
+        return 1;
+    }
+
+    // The probe closes the other end once every client is ready
+    char go;
+    while (read(options.goFd, &go, 1) < 0 && errno == EINTR) {
+    }
+    for (int i = 0; i < options.sources; i++) {
+        client.requestRefresh(sourceKey(i));
+    }
+
+    std::vector<long> fresh;
+    if (!received.waitNewer(cached, fresh)) {
+        std::cerr << "❌ Client " << getpid() << " did not get fresh values after its refresh" << std::endl;
+        return 1;
+    }
+    client.stop();
+    return 0;
+}
+
+pid_t spawnClient(const Options& options, int readyFd, int goFd) {
+    std::string port = std::to_string(options.port);
+    std::string sources = std::to_string(options.sources);
+    std::string ready = std::to_string(readyFd);
+    std::string go = std::to_string(goFd);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        // Keep the clients' connection messages out of the report
+        int devNull = open("/dev/null", O_WRONLY);
+        if (devNull >= 0) {
+            dup2(devNull, STDOUT_FILENO);
+        }
+        execl("/proc/self/exe", "stats_hub_probe", "--client", "--port", port.c_str(), "--sources", sources.c_str(),
+              "--ready-fd", ready.c_str(), "--go-fd", go.c_str(), (char*)nullptr);
+        _exit(127);
+    }
+    return pid;
+}
+
+// One round of `clients` processes. Returns false if any client failed.
+bool runRound(const Options& options, int clients) {
+    int readyPipe[2];
+    int goPipe[2];
+    if (pipe(readyPipe) != 0 || pipe(goPipe) != 0) {
+        std::cerr << "❌ pipe: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    // Clients only get their ends; "go" is the probe closing its write end
+    fcntl(readyPipe[0], F_SETFD, FD_CLOEXEC);
+    fcntl(goPipe[1], F_SETFD, FD_CLOEXEC);
+
+    std::vector<pid_t> pids;
+    for (int i = 0; i < clients; i++) {
+        pid_t pid = spawnClient(options, readyPipe[1], goPipe[0]);
+        if (pid < 0) {
+            std::cerr << "❌ fork: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        pids.push_back(pid);
+    }
+    close(readyPipe[1]);
+    close(goPipe[0]);
+
+    int ready = 0;
+    while (ready < (int)pids.size()) {
+        struct pollfd pfd;
+        pfd.fd = readyPipe[0];
+        pfd.events = POLLIN;
+        if (poll(&pfd, 1, WAIT_MS) <= 0) break;
+        char buffer[64];
+        ssize_t got = read(readyPipe[0], buffer, sizeof(buffer));
+        if (got <= 0) break;
+        ready += (int)got;
+    }
+    close(goPipe[1]);
+    close(readyPipe[0]);
+
+    bool passed = ready == clients;
+    for (size_t i = 0; i < pids.size(); i++) {
+        int status = 0;
+        waitpid(pids[i], &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            passed = false;
+        }
+    }
+    return passed;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (options.client) {
+        return runClient(options);
+    }
+
+    StubUpstream upstream(options.fetchMs);
+    StubUpstream* stub = &upstream;
+    FetchScheduler scheduler(2);
+    StatsHubServer server(options.port, &scheduler,
+        [stub](const std::string& channel) { return stub->fetchYouTube(channel); },
+        [stub](const std::string& artistId) { return stub->fetchSpotify(artistId); });
+    for (int i = 0; i < options.sources; i++) {
+        if (i % 2 == 0) {
+            server.addYouTubeChannel(sourceId(i));
+        } else {
+            server.addSpotifyArtist(sourceId(i));
+        }
+    }
+    scheduler.start();
+    if (!server.start()) {
+        std::cerr << "❌ " << server.getLastError() << std::endl;
+        return 1;
+    }
+
+    // Let the first fetch of every source land in the hub's cache
+    for (int waitedMs = 0; server.getFetchCount() < (unsigned long)options.sources && waitedMs < WAIT_MS; waitedMs += 10) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (server.getFetchCount() < (unsigned long)options.sources) {
+        std::cerr << "❌ The hub did not fetch every source on startup" << std::endl;
+        return 1;
+    }
+
+    std::cout << "🚀 " << options.sources << " sources, " << options.fetchMs << " ms per upstream fetch, up to "
+              << options.clients << " clients" << std::endl;
+
+    bool passed = true;
+    for (int clients = 1; ; clients = clients * 2 < options.clients ? clients * 2 : options.clients) {
+        unsigned long fetchesBefore = upstream.getFetches();
+        unsigned long publishesBefore = server.getPublishCount();
+        bool roundPassed = runRound(options, clients);
+        unsigned long fetches = upstream.getFetches() - fetchesBefore;
+        unsigned long publishes = server.getPublishCount() - publishesBefore;
+
+        std::cout << "  " << clients << " client(s): " << fetches << " upstream fetches, " << publishes
+                  << " updates published" << std::endl;
+        if (!roundPassed) {
+            std::cerr << "❌ Not every client got its values with " << clients << " client(s)" << std::endl;
+            passed = false;
+        }
+        if (fetches != (unsigned long)options.sources) {
+            std::cerr << "❌ Expected " << options.sources << " upstream fetches (one per source), got " << fetches
+                      << std::endl;
+            passed = false;
+        }
+        if (clients == options.clients) break;
+    }
+
+    server.stop();
+    scheduler.stop();
+    if (passed) {
+        std::cout << "✅ Upstream fetches stayed at one per source per round regardless of client count" << std::endl;
+    }
+    return passed ? 0 : 1;
+}
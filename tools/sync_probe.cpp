@@ -0,0 +1,201 @@
+// Display stand-in for checking displays in sync (see SyncNode) without
+// panels, e.g. several processes on one machine.
+//
+// Each probe runs the render loop of a display: it sleeps until the next
+// shared tick, blinks and rotates texts on its SyncClock, "swaps" on the
+// next refresh of a simulated panel with a random refresh phase, and
+// reports the frame. Since processes on one machine share a clock, a
+// follower can give its own clock an offset and a drift so there is
+// something to discipline. --trace writes a line whenever the blink state
+// or text changes; the traces of all probes should be identical. The
+// leader prints the skew of every follower when it stops.
+//
+//   sync_probe --lead 7407 --resync 10 --trace leader.txt &
+//   sync_probe --follow 127.0.0.1:7407 --offset-ms 5000 --drift-ppm 80 --trace a.txt &
+//   sync_probe --follow 127.0.0.1:7407 --offset-ms -3000 --drift-ppm -50 --trace b.txt
+//   diff leader.txt a.txt && diff leader.txt b.txt
+
+#include "infrastructure/network/sync_node.h"
+#include "infrastructure/config/config.h"
+#include "shared/utils/blink_manager.h"
+#include "shared/utils/rotating_text.h"
+#include "shared/utils/monotonic_clock.h"
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <cstring>
+#include <cstdlib>
+#include <csignal>
+#include <unistd.h>
+
+namespace {
+
+const int BLINK_MS = 250;
+const int TEXT_MS = 1000;
+const int TEXTS = 4;
+
+volatile sig_atomic_t stopRequested = 0;
+
+void requestStop(int) {
+    stopRequested = 1;
+}
+
+struct Options {
+    int leadPort;
+    std::string leader;
+    std::string name;
+    int seconds;
+    long long offsetMs;
+    long long driftPpm;
+    int refreshHz;       // Simulated panel refresh, 0 = swap at once
+    int resyncSeconds;   // Leader: new epoch this often, 0 = never
+    std::string trace;
+
+    Options() : leadPort(0), name("probe-" + std::to_string(getpid())), seconds(20), offsetMs(0), driftPpm(0),
+                refreshHz(200), resyncSeconds(0) {}
+};
+
+// The probe's local clock: the monotonic clock moved by --offset-ms and
+// running --drift-ppm fast
+long long startUs = 0;
+long long offsetUs = 0;
+long long driftPpm = 0;
+
+long long skewedNowUs() {
+    long long realUs = MonotonicClock::nowUs();
+    return realUs + offsetUs + (realUs - startUs) * driftPpm / 1000000;
+}
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " (--lead <port> | --follow <host:port>) [options]\n\n";
+    std::cout << "  --lead <port>             Act as the leader on this UDP port\n";
+    std::cout << "  --follow <host:port>      Follow a leader (port " << SyncProtocol::DEFAULT_PORT << " by default)\n";
+    std::cout << "  --name <name>             Name in the leader's report (default: probe-<pid>)\n";
+    std::cout << "  --seconds <n>             Run time (default: 20)\n";
+    std::cout << "  --offset-ms <ms>          Offset of this probe's clock (default: 0)\n";
+    std::cout << "  --drift-ppm <ppm>         Rate error of this probe's clock (default: 0)\n";
+    std::cout << "  --refresh <hz>            Simulated panel refresh rate, 0 to swap at once (default: 200)\n";
+    std::cout << "  --resync <s>              Leader: start a new epoch every s seconds\n";
+    std::cout << "  --trace <file>            Write blink and text changes by tick\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--lead") == 0 && hasValue) {
+            options.leadPort = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--follow") == 0 && hasValue) {
+            options.leader = argv[++i];
+        } else if (strcmp(argv[i], "--name") == 0 && hasValue) {
+            options.name = argv[++i];
+        } else if (strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            options.seconds = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--offset-ms") == 0 && hasValue) {
+            options.offsetMs = std::atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--drift-ppm") == 0 && hasValue) {
+            options.driftPpm = std::atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--refresh") == 0 && hasValue) {
+            options.refreshHz = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--resync") == 0 && hasValue) {
+            options.resyncSeconds = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--trace") == 0 && hasValue) {
+            options.trace = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return (options.leadPort > 0) != !options.leader.empty() && options.leadPort < 65536 && options.seconds > 0 &&
+           options.refreshHz >= 0 && options.resyncSeconds >= 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string host;
+    int port = options.leadPort;
+    if (!options.leader.empty() && !SyncNode::parseAddress(options.leader, host, port)) {
+        std::cerr << "❌ Invalid leader address: " << options.leader << std::endl;
+        return 1;
+    }
+    std::ofstream trace;
+    if (!options.trace.empty()) {
+        trace.open(options.trace.c_str());
+        if (!trace) {
+            std::cerr << "❌ Cannot write " << options.trace << std::endl;
+            return 1;
+        }
+    }
+
+    startUs = MonotonicClock::nowUs();
+    offsetUs = options.offsetMs * 1000;
+    driftPpm = options.driftPpm;
+    SyncClock clock(Config::SYNC_TICK_MS, &skewedNowUs);
+    SyncNode node(options.leadPort > 0 ? SyncNode::LEADER : SyncNode::FOLLOWER, host, port, options.name, &clock);
+    if (!node.start()) {
+        std::cerr << "❌ " << node.getLastError() << std::endl;
+        return 1;
+    }
+
+    BlinkManager blink(&clock);
+    RotatingText texts(&clock);
+    for (int i = 0; i < TEXTS; i++) {
+        texts.addText(std::to_string(i));
+    }
+    texts.setRotationInterval(TEXT_MS);
+    texts.start();
+
+    // Each panel refreshes on its own, at a phase of its own
+    std::random_device random;
+    long long refreshUs = options.refreshHz > 0 ? 1000000 / options.refreshHz : 0;
+    long long refreshPhaseUs = refreshUs > 0 ? random() % refreshUs : 0;
+
+    signal(SIGINT, requestStop);
+    signal(SIGTERM, requestStop);
+    long long endUs = startUs + options.seconds * 1000000LL;
+    long long nextResyncUs = startUs + options.resyncSeconds * 1000000LL;
+    bool blinkState = false;
+    std::string text;
+    bool traced = false;
+
+    while (!stopRequested && MonotonicClock::nowUs() < endUs) {
+        long long deadlineUs = clock.nextTick();
+        for (long long remainingUs = deadlineUs - skewedNowUs(); remainingUs > 0; remainingUs = deadlineUs - skewedNowUs()) {
+            usleep((useconds_t)remainingUs);
+        }
+
+        // Draw: only what a display in sync would show
+        bool state = blink.updateBlinkState(BLINK_MS);
+        texts.update();
+        long long epochStartMs = 0;
+        bool synced = clock.getEpochStartMs(epochStartMs);
+        if (trace.is_open() && synced && (!traced || state != blinkState || texts.getCurrentText() != text)) {
+            trace << clock.getTick() << " epoch " << clock.getEpoch() << " blink " << (state ? "on" : "off")
+                  << " text " << texts.getCurrentText() << "\n";
+            traced = true;
+        }
+        blinkState = state;
+        text = texts.getCurrentText();
+
+        // Swap on the panel's next refresh
+        if (refreshUs > 0) {
+            long long nowUs = MonotonicClock::nowUs();
+            usleep((useconds_t)(refreshUs - (nowUs - refreshPhaseUs) % refreshUs));
+        }
+        node.frameShown();
+
+        if (options.resyncSeconds > 0 && MonotonicClock::nowUs() >= nextResyncUs) {
+            node.beginEpoch();
+            nextResyncUs += options.resyncSeconds * 1000000LL;
+        }
+    }
+
+    node.printReport(std::cout);
+    node.stop();
+    return 0;
+}
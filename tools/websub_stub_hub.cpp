@@ -0,0 +1,463 @@
+// Stand-in WebSub hub for testing push mode end to end without YouTube's
+// hub (see WebSubReceiver).
+//
+// Accepts subscription requests on --port, answers 202 and then verifies
+// each one like a real hub: a GET to the callback with a random
+// hub.challenge that has to come back as the body. Every channel ID read
+// from stdin ("*" for all) is pushed to the verified subscribers of that
+// channel as an Atom entry, signed with the subscriber's hub.secret in
+// X-Hub-Signature. With --every the hub also pushes to all of them on a
+// timer. --forge sends an unsigned and a wrongly signed copy of every
+// push as well; the display should count them as ignored in `netstats`
+// and refresh only once per push.
+//
+//   websub_stub_hub --port 8086 &
+//   led_matrix_apps --websub-callback http://127.0.0.1:8085/ --websub-hub http://127.0.0.1:8086/subscribe
+//   echo UCxxxxxxxxxxxxxxxxxxxxxx | websub_stub_hub --port 8086 --forge
+
+#include "infrastructure/input/line_assembler.h"
+#include "shared/utils/sha1.h"
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+
+namespace {
+
+const size_t MAX_REQUEST_SIZE = 64 * 1024;
+const int IO_TIMEOUT_SECONDS = 5;
+
+volatile sig_atomic_t stopRequested = 0;
+
+void handleSignal(int) {
+    stopRequested = 1;
+}
+
+struct Options {
+    int port;
+    int everySeconds;   // Push to every subscriber this often, 0 = only from stdin
+    bool forge;         // Also send unsigned and badly signed copies
+    int seconds;        // 0 = until Ctrl-C
+
+    Options() : port(8086), everySeconds(0), forge(false), seconds(0) {}
+};
+
+struct Subscriber {
+    std::string callback;
+    std::string topic;
+    std::string secret;
+    bool verified;
+};
+
+struct Counters {
+    unsigned long subscribeRequests;
+    unsigned long verified;
+    unsigned long pushes;
+    unsigned long forged;
+    unsigned long failed;
+
+    Counters() : subscribeRequests(0), verified(0), pushes(0), forged(0), failed(0) {}
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n\n";
+    std::cout << "  --port <port>       TCP port for subscription requests (default: 8086)\n";
+    std::cout << "  --every <s>         Push to every subscriber every s seconds (default: 0 = never)\n";
+    std::cout << "  --forge             Also send an unsigned and a badly signed copy of each push\n";
+    std::cout << "  --seconds <n>       Run time, 0 = until Ctrl-C (default: 0)\n";
+    std::cout << "\nChannel IDs on stdin (\"*\" for all) are pushed to their subscribers.\n";
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--port") == 0 && hasValue) {
+            options.port = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--every") == 0 && hasValue) {
+            options.everySeconds = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--forge") == 0) {
+            options.forge = true;
+        } else if (strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            options.seconds = std::atoi(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    return options.port > 0 && options.port < 65536 && options.everySeconds >= 0 && options.seconds >= 0;
+}
+
+int openListener(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port);
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 16) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void setTimeouts(int fd) {
+    struct timeval timeout;
+    timeout.tv_sec = IO_TIMEOUT_SECONDS;
+    timeout.tv_usec = 0;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+}
+
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        sent += (size_t)n;
+    }
+    return true;
+}
+
+std::string urlEncode(const std::string& value) {
+    static const char* hex = "0123456789ABCDEF";
+    std::string result;
+    for (size_t i = 0; i < value.size(); i++) {
+        unsigned char c = (unsigned char)value[i];
+        if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+            result += (char)c;
+        } else {
+            result += '%';
+            result += hex[c >> 4];
+            result += hex[c & 0x0F];
+        }
+    }
+    return result;
+}
+
+std::string urlDecode(const std::string& value) {
+    std::string result;
+    for (size_t i = 0; i < value.size(); i++) {
+        if (value[i] == '+') {
+            result += ' ';
+        } else if (value[i] == '%' && i + 2 < value.size()) {
+            result += (char)std::strtol(value.substr(i + 1, 2).c_str(), nullptr, 16);
+            i += 2;
+        } else {
+            result += value[i];
+        }
+    }
+    return result;
+}
+
+std::map<std::string, std::string> parseForm(const std::string& form) {
+    std::map<std::string, std::string> params;
+    std::istringstream pairs(form);
+    std::string pair;
+    while (std::getline(pairs, pair, '&')) {
+        size_t eq = pair.find('=');
+        if (eq != std::string::npos) {
+            params[urlDecode(pair.substr(0, eq))] = urlDecode(pair.substr(eq + 1));
+        }
+    }
+    return params;
+}
+
+// Read one HTTP message (headers plus Content-Length body, or up to close)
+bool readMessage(int fd, std::string& head, std::string& body) {
+    std::string data;
+    char buffer[4096];
+    size_t headerEnd = std::string::npos;
+    size_t contentLength = std::string::npos;
+    while (data.size() < MAX_REQUEST_SIZE) {
+        if (headerEnd != std::string::npos && contentLength != std::string::npos &&
+            data.size() >= headerEnd + 4 + contentLength) {
+            break;
+        }
+        ssize_t got = recv(fd, buffer, sizeof(buffer), 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) break;
+        data.append(buffer, (size_t)got);
+
+        if (headerEnd == std::string::npos && (headerEnd = data.find("\r\n\r\n")) != std::string::npos) {
+            std::string lower = data.substr(0, headerEnd);
+            for (size_t i = 0; i < lower.size(); i++) {
+                lower[i] = (char)tolower((unsigned char)lower[i]);
+            }
+            size_t field = lower.find("\r\ncontent-length:");
+            if (field != std::string::npos) {
+                contentLength = (size_t)std::strtoul(lower.c_str() + field + 17, nullptr, 10);
+            }
+        }
+    }
+    if (headerEnd == std::string::npos) {
+        return false;
+    }
+    head = data.substr(0, headerEnd);
+    body = data.substr(headerEnd + 4, contentLength);
+    return true;
+}
+
+// Blocking HTTP/1.0 request to an http:// URL; returns the status code, or 0
+int httpRequest(const std::string& method, const std::string& url, const std::string& headers,
+                const std::string& requestBody, std::string& responseBody) {
+    if (url.compare(0, 7, "http://") != 0) {
+        return 0;
+    }
+    size_t pathStart = url.find('/', 7);
+    std::string authority = url.substr(7, pathStart == std::string::npos ? std::string::npos : pathStart - 7);
+    std::string path = pathStart == std::string::npos ? "/" : url.substr(pathStart);
+    size_t colon = authority.rfind(':');
+    std::string host = colon == std::string::npos ? authority : authority.substr(0, colon);
+    std::string port = colon == std::string::npos ? "80" : authority.substr(colon + 1);
+
+    struct addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &result) != 0 || !result) {
+        return 0;
+    }
+    int fd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+    bool connected = fd >= 0 && connect(fd, result->ai_addr, result->ai_addrlen) == 0;
+    freeaddrinfo(result);
+    if (!connected) {
+        if (fd >= 0) close(fd);
+        return 0;
+    }
+    setTimeouts(fd);
+
+    std::ostringstream request;
+    request << method << " " << path << " HTTP/1.0\r\n"
+            << "Host: " << authority << "\r\n"
+            << headers
+            << "Content-Length: " << requestBody.size() << "\r\n"
+            << "Connection: close\r\n\r\n"
+            << requestBody;
+    std::string head;
+    int status = 0;
+    if (sendAll(fd, request.str()) && readMessage(fd, head, responseBody)) {
+        size_t space = head.find(' ');
+        status = space == std::string::npos ? 0 : std::atoi(head.c_str() + space + 1);
+    }
+    close(fd);
+    return status;
+}
+
+std::string channelFromTopic(const std::string& topic) {
+    size_t start = topic.find("channel_id=");
+    return start == std::string::npos ? "" : topic.substr(start + 11);
+}
+
+// GET the callback with a challenge, as the hub does after a request
+void verify(Subscriber& subscriber, const std::string& mode, const std::string& lease, std::mt19937& random,
+            Counters& counters) {
+    std::string challenge = std::to_string(random()) + std::to_string(random());
+    std::string url = subscriber.callback + (subscriber.callback.find('?') == std::string::npos ? "?" : "&") +
+                      "hub.mode=" + mode + "&hub.topic=" + urlEncode(subscriber.topic) +
+                      "&hub.challenge=" + challenge + "&hub.lease_seconds=" + lease;
+    std::string body;
+    int status = httpRequest("GET", url, "", "", body);
+    subscriber.verified = mode == "subscribe" && status >= 200 && status < 300 && body == challenge;
+    if (subscriber.verified) {
+        counters.verified++;
+        std::cout << "✅ Verified " << channelFromTopic(subscriber.topic) << " for " << subscriber.callback
+                  << (subscriber.secret.empty() ? " (no secret)" : "") << std::endl;
+    } else if (mode == "subscribe") {
+        std::cerr << "❌ Verification of " << subscriber.callback << " failed (HTTP " << status << ")" << std::endl;
+    }
+}
+
+void handleSubscribeRequest(int fd, std::vector<Subscriber>& subscribers, std::mt19937& random,
+                            Counters& counters) {
+    setTimeouts(fd);
+    std::string head, body;
+    if (!readMessage(fd, head, body)) {
+        close(fd);
+        return;
+    }
+    std::map<std::string, std::string> form = parseForm(body);
+    std::string mode = form["hub.mode"];
+    if (head.compare(0, 5, "POST ") != 0 || form["hub.callback"].empty() || form["hub.topic"].empty() ||
+        (mode != "subscribe" && mode != "unsubscribe")) {
+        sendAll(fd, "HTTP/1.0 400 Bad Request\r\nContent-Length: 0\r\n\r\n");
+        close(fd);
+        return;
+    }
+
+    // Accept first, verify after: the subscriber is still waiting for this answer
+    sendAll(fd, "HTTP/1.0 202 Accepted\r\nContent-Length: 0\r\n\r\n");
+    close(fd);
+    counters.subscribeRequests++;
+
+    Subscriber* subscriber = nullptr;
+    for (size_t i = 0; i < subscribers.size(); i++) {
+        if (subscribers[i].callback == form["hub.callback"] && subscribers[i].topic == form["hub.topic"]) {
+            subscriber = &subscribers[i];
+        }
+    }
+    if (!subscriber) {
+        subscribers.push_back(Subscriber());
+        subscriber = &subscribers.back();
+        subscriber->callback = form["hub.callback"];
+        subscriber->topic = form["hub.topic"];
+    }
+    subscriber->secret = form["hub.secret"];
+    subscriber->verified = false;
+    std::string lease = form["hub.lease_seconds"].empty() ? "432000" : form["hub.lease_seconds"];
+    verify(*subscriber, mode, lease, random, counters);
+}
+
+std::string buildEntry(const std::string& channelId, unsigned long videoNumber) {
+    std::ostringstream entry;
+    entry << "<?xml version='1.0' encoding='UTF-8'?>\n"
+          << "<feed xmlns:yt=\"http://www.youtube.com/xml/schemas/2015\" xmlns=\"http://www.w3.org/2005/Atom\">\n"
+          << "  <link rel=\"hub\" href=\"http://pubsubhubbub.appspot.com\"/>\n"
+          << "  <link rel=\"self\" href=\"https://www.youtube.com/xml/feeds/videos.xml?channel_id=" << channelId << "\"/>\n"
+          << "  <entry>\n"
+          << "    <yt:videoId>stub" << videoNumber << "</yt:videoId>\n"
+          << "    <yt:channelId>" << channelId << "</yt:channelId>\n"
+          << "    <title>Stub upload " << videoNumber << "</title>\n"
+          << "  </entry>\n"
+          << "</feed>\n";
+    return entry.str();
+}
+
+bool postEntry(const Subscriber& subscriber, const std::string& entry, const std::string& signature) {
+    std::string headers = "Content-Type: application/atom+xml\r\n";
+    if (!signature.empty()) {
+        headers += "X-Hub-Signature: " + signature + "\r\n";
+    }
+    std::string response;
+    int status = httpRequest("POST", subscriber.callback, headers, entry, response);
+    return status >= 200 && status < 300;
+}
+
+void push(std::vector<Subscriber>& subscribers, const std::string& channelId, const Options& options,
+          Counters& counters) {
+    for (size_t i = 0; i < subscribers.size(); i++) {
+        Subscriber& subscriber = subscribers[i];
+        std::string topicChannel = channelFromTopic(subscriber.topic);
+        if (!subscriber.verified || (channelId != "*" && channelId != topicChannel)) {
+            continue;
+        }
+
+        std::string entry = buildEntry(topicChannel, counters.pushes + 1);
+        std::string signature = subscriber.secret.empty() ? "" : "sha1=" + Sha1::hmacHex(subscriber.secret, entry);
+        if (options.forge) {
+            postEntry(subscriber, entry, "");
+            postEntry(subscriber, entry, "sha1=" + Sha1::hmacHex("not-the-secret", entry));
+            counters.forged += 2;
+        }
+        if (postEntry(subscriber, entry, signature)) {
+            counters.pushes++;
+            std::cout << "🔔 Pushed an upload of " << topicChannel << " to " << subscriber.callback << std::endl;
+        } else {
+            counters.failed++;
+            std::cerr << "❌ Push to " << subscriber.callback << " failed" << std::endl;
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    int listenFd = openListener(options.port);
+    if (listenFd < 0) {
+        std::cerr << "❌ Cannot listen on port " << options.port << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    signal(SIGINT, handleSignal);
+    signal(SIGTERM, handleSignal);
+    signal(SIGPIPE, SIG_IGN);
+    std::cout << "📡 Stub WebSub hub on http://127.0.0.1:" << options.port << "/subscribe" << std::endl;
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    Clock::time_point nextPush = start + std::chrono::seconds(options.everySeconds);
+    std::mt19937 random(std::random_device{}());
+    std::vector<Subscriber> subscribers;
+    Counters counters;
+    LineAssembler stdinLines;
+    bool stdinOpen = true;
+
+    while (!stopRequested) {
+        Clock::time_point now = Clock::now();
+        if (options.seconds > 0 && now - start >= std::chrono::seconds(options.seconds)) {
+            break;
+        }
+
+        struct pollfd fds[2];
+        fds[0].fd = listenFd;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = stdinOpen ? STDIN_FILENO : -1;
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+        if (poll(fds, 2, 100) < 0 && errno != EINTR) {
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd >= 0) {
+                handleSubscribeRequest(fd, subscribers, random, counters);
+            }
+        }
+
+        if (stdinOpen && (fds[1].revents & (POLLIN | POLLHUP))) {
+            char buffer[4096];
+            ssize_t got = read(STDIN_FILENO, buffer, sizeof(buffer));
+            if (got <= 0) {
+                stdinOpen = false;
+            } else {
+                stdinLines.append(buffer, (size_t)got);
+            }
+            std::string line;
+            while (stdinLines.nextLine(line)) {
+                if (!line.empty()) {
+                    push(subscribers, line, options, counters);
+                }
+            }
+        }
+
+        if (options.everySeconds > 0 && Clock::now() >= nextPush) {
+            push(subscribers, "*", options, counters);
+            nextPush += std::chrono::seconds(options.everySeconds);
+        }
+    }
+
+    std::cout << "✅ " << counters.subscribeRequests << " subscription requests, " << counters.verified
+              << " verified, " << counters.pushes << " pushes (" << counters.failed << " failed), "
+              << counters.forged << " forged copies" << std::endl;
+    close(listenFd);
+    return 0;
+}
@@ -0,0 +1,262 @@
+// Conformance and speed check for the A and C weighting filters (see
+// FrequencyWeighting).
+//
+// For every sample rate the tool designs both weightings and compares the
+// designed response (BiquadCascade::magnitudeDb) at each one-third-octave
+// frequency from 10 Hz to 20 kHz with the IEC 61672-1:2013 table, against
+// the Class 1 acceptance limits. Frequencies at or above Nyquist are
+// skipped. It then filters noise through each cascade in --block sized
+// blocks and reports samples per second. Exits 1 if any frequency is
+// outside its limits.
+//
+//   weighting_check
+//   weighting_check --rates 44100,48000,96000 --block 64 --verbose
+
+#include "shared/dsp/frequency_weighting.h"
+#include "shared/dsp/biquad_cascade.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <cstdlib>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const double NO_LIMIT = -1000.0;  // "minus infinity" in the table
+
+// IEC 61672-1:2013, Table 3: weightings at the nominal frequencies and the
+// Class 1 acceptance limits around them
+struct TableRow {
+    const char* nominal;
+    double aDb;
+    double cDb;
+    double upperDb;
+    double lowerDb;
+};
+
+const TableRow IEC_TABLE[] = {
+    { "10",    -70.4, -14.3, 3.0, NO_LIMIT },
+    { "12.5",  -63.4, -11.2, 2.5, NO_LIMIT },
+    { "16",    -56.7,  -8.5, 2.0,  -4.0 },
+    { "20",    -50.5,  -6.2, 2.0,  -2.0 },
+    { "25",    -44.7,  -4.4, 2.0,  -1.5 },
+    { "31.5",  -39.4,  -3.0, 1.5,  -1.5 },
+    { "40",    -34.6,  -2.0, 1.0,  -1.0 },
+    { "50",    -30.2,  -1.3, 1.0,  -1.0 },
+    { "63",    -26.2,  -0.8, 1.0,  -1.0 },
+    { "80",    -22.5,  -0.5, 1.0,  -1.0 },
+    { "100",   -19.1,  -0.3, 1.0,  -1.0 },
+    { "125",   -16.1,  -0.2, 1.0,  -1.0 },
+    { "160",   -13.4,  -0.1, 1.0,  -1.0 },
+    { "200",   -10.9,   0.0, 1.0,  -1.0 },
+    { "250",    -8.6,   0.0, 1.0,  -1.0 },
+    { "315",    -6.6,   0.0, 1.0,  -1.0 },
+    { "400",    -4.8,   0.0, 1.0,  -1.0 },
+    { "500",    -3.2,   0.0, 1.0,  -1.0 },
+    { "630",    -1.9,   0.0, 1.0,  -1.0 },
+    { "800",    -0.8,   0.0, 1.0,  -1.0 },
+    { "1000",    0.0,   0.0, 0.7,  -0.7 },
+    { "1250",    0.6,   0.0, 1.0,  -1.0 },
+    { "1600",    1.0,  -0.1, 1.0,  -1.0 },
+    { "2000",    1.2,  -0.2, 1.0,  -1.0 },
+    { "2500",    1.3,  -0.3, 1.0,  -1.0 },
+    { "3150",    1.2,  -0.5, 1.0,  -1.0 },
+    { "4000",    1.0,  -0.8, 1.0,  -1.0 },
+    { "5000",    0.5,  -1.3, 1.5,  -1.5 },
+    { "6300",   -0.1,  -2.0, 1.5,  -2.0 },
+    { "8000",   -1.1,  -3.0, 1.5,  -2.5 },
+    { "10000",  -2.5,  -4.4, 2.0,  -3.0 },
+    { "12500",  -4.3,  -6.2, 2.0,  -5.0 },
+    { "16000",  -6.6,  -8.5, 2.5, -16.0 },
+    { "20000",  -9.3, -11.2, 3.0, NO_LIMIT },
+};
+const int TABLE_ROWS = sizeof(IEC_TABLE) / sizeof(IEC_TABLE[0]);
+
+struct Options {
+    std::vector<double> rates;
+    int block;
+    int samples;        // Per throughput run
+    bool verbose;       // Print every frequency, not just failures
+
+    Options() : block(256), samples(20000000), verbose(false) {}
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n\n";
+    std::cout << "  --rates <r,r,...>   Sample rates to check (default: 48000,44100)\n";
+    std::cout << "  --block <n>         Samples per process() call (default: 256)\n";
+    std::cout << "  --samples <n>       Samples per throughput run (default: 20000000)\n";
+    std::cout << "  --verbose           Print the response at every frequency\n";
+}
+
+bool parseRates(const std::string& list, std::vector<double>& rates) {
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t comma = list.find(',', start);
+        if (comma == std::string::npos) comma = list.size();
+        double rate = std::atof(list.substr(start, comma - start).c_str());
+        if (rate <= 0.0) {
+            return false;
+        }
+        rates.push_back(rate);
+        start = comma + 1;
+    }
+    return !rates.empty();
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--rates") == 0 && hasValue) {
+            if (!parseRates(argv[++i], options.rates)) {
+                return false;
+            }
+        } else if (strcmp(argv[i], "--block") == 0 && hasValue) {
+            options.block = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--samples") == 0 && hasValue) {
+            options.samples = std::atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            options.verbose = true;
+        } else {
+            return false;
+        }
+    }
+    if (options.rates.empty()) {
+        options.rates.push_back(48000.0);
+        options.rates.push_back(44100.0);
+    }
+    return options.block > 0 && options.samples > 0;
+}
+
+// The table is defined at the exact base-ten frequencies, 1 kHz * 10^(n/10)
+double exactFrequency(int row) {
+    return 1000.0 * std::pow(10.0, (row - 20) / 10.0);
+}
+
+// Returns the number of frequencies outside the Class 1 limits
+int checkResponse(FrequencyWeighting::Type type, double sampleRate, const BiquadCascade& cascade, bool verbose) {
+    int failures = 0;
+    double tightestMargin = 1e9;  // Distance to the nearer limit
+    const char* tightestAt = "";
+
+    for (int row = 0; row < TABLE_ROWS; row++) {
+        const TableRow& entry = IEC_TABLE[row];
+        double frequency = exactFrequency(row);
+        if (frequency >= sampleRate / 2.0) {
+            continue;
+        }
+
+        double expected = type == FrequencyWeighting::WEIGHTING_A ? entry.aDb : entry.cDb;
+        double actual = cascade.magnitudeDb(frequency, sampleRate);
+        double error = actual - expected;
+        bool inside = error <= entry.upperDb && (entry.lowerDb == NO_LIMIT || error >= entry.lowerDb);
+
+        double margin = entry.upperDb - error;
+        if (entry.lowerDb != NO_LIMIT && error - entry.lowerDb < margin) {
+            margin = error - entry.lowerDb;
+        }
+        if (margin < tightestMargin) {
+            tightestMargin = margin;
+            tightestAt = entry.nominal;
+        }
+        if (!inside) {
+            failures++;
+        }
+        if (verbose || !inside) {
+            std::cout << "    " << std::setw(7) << entry.nominal << " Hz  table " << std::setw(6) << expected
+                      << "  design " << std::setw(7) << actual << "  error " << std::setw(6) << error
+                      << "  limits +" << entry.upperDb << "/";
+            if (entry.lowerDb == NO_LIMIT) {
+                std::cout << "-inf";
+            } else {
+                std::cout << entry.lowerDb;
+            }
+            std::cout << (inside ? "" : "  ❌") << std::endl;
+        }
+    }
+
+    std::cout << "  " << FrequencyWeighting::letter(type) << "-weighting: " << (failures == 0 ? "✅ " : "❌ ")
+              << failures << " outside Class 1, tightest margin " << tightestMargin << " dB at " << tightestAt
+              << " Hz" << std::endl;
+    return failures;
+}
+
+double samplesPerSecond(BiquadCascade& cascade, const std::vector<float>& noise, int block, int samples) {
+    std::vector<float> buffer(block);
+    cascade.reset();
+
+    size_t position = 0;
+    double sink = 0.0;
+    Clock::time_point start = Clock::now();
+    for (int done = 0; done < samples; done += block) {
+        if (position + block > noise.size()) {
+            position = 0;
+        }
+        cascade.process(&noise[position], &buffer[0], block);
+        sink += buffer[block - 1];
+        position += block;
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Keeps the filtering from being optimized away
+    if (sink != sink) {
+        std::cerr << "⚠️  Filter output went NaN" << std::endl;
+    }
+    return seconds > 0.0 ? samples / seconds : 0.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // A second of white noise at -20 dBFS RMS, reused for every run
+    std::vector<float> noise(48000);
+    std::mt19937 random(1);
+    std::normal_distribution<float> gaussian(0.0f, 0.1f);
+    for (size_t i = 0; i < noise.size(); i++) {
+        noise[i] = gaussian(random);
+    }
+
+    const FrequencyWeighting::Type types[] = { FrequencyWeighting::WEIGHTING_A, FrequencyWeighting::WEIGHTING_C };
+    int failures = 0;
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (size_t r = 0; r < options.rates.size(); r++) {
+        double sampleRate = options.rates[r];
+        std::cout << "\033[1;36m🎚️  " << std::setprecision(0) << sampleRate << " Hz\033[0m" << std::setprecision(2)
+                  << std::endl;
+
+        for (int t = 0; t < 2; t++) {
+            BiquadCascade cascade;
+            if (!FrequencyWeighting::design(types[t], sampleRate, cascade)) {
+                std::cerr << "❌ Cannot design " << FrequencyWeighting::letter(types[t]) << "-weighting at "
+                          << sampleRate << " Hz" << std::endl;
+                return 1;
+            }
+            failures += checkResponse(types[t], sampleRate, cascade, options.verbose);
+
+            double rate = samplesPerSecond(cascade, noise, options.block, options.samples);
+            std::cout << "    " << cascade.getSectionCount() << " sections, " << std::setprecision(1)
+                      << rate / 1e6 << "M samples/s in blocks of " << options.block << " ("
+                      << rate / sampleRate << "x real time)" << std::setprecision(2) << std::endl;
+        }
+    }
+
+    if (failures > 0) {
+        std::cerr << "❌ " << failures << " frequencies outside the Class 1 limits" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ A and C weighting within IEC 61672-1 Class 1 at every rate" << std::endl;
+    return 0;
+}